@@ -9,6 +9,9 @@
  *
  *  Revision 1.0, 15.09.2015-13 17:03:39
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Added connection pool hits/misses.
  */
 
 #include <gtk/gtk.h>
@@ -23,6 +26,8 @@ CNetConnStat::CNetConnStat() :
 	m_pIOCount(0),
 	m_pIOFailCount(0),
 	m_pPoolCount(0),
+	m_pConnPoolHit(0),
+	m_pConnPoolMiss(0),
 	m_pLabel(0)
 {
 }
@@ -51,6 +56,12 @@ void CNetConnStat::clear()
 	if ( m_pPoolCount )  {
 		gtk_label_set_text(GTK_LABEL(m_pPoolCount), "");
 	}
+	if ( m_pConnPoolHit )  {
+		gtk_label_set_text(GTK_LABEL(m_pConnPoolHit), "");
+	}
+	if ( m_pConnPoolMiss )  {
+		gtk_label_set_text(GTK_LABEL(m_pConnPoolMiss), "");
+	}
 }
 
 GtkWidget* CNetConnStat::create(const char* strTitle)
@@ -63,7 +74,9 @@ GtkWidget* CNetConnStat::create(const char* strTitle)
 		{	"Received Packets:",		&m_pRecvCount			},
 		{	"Sent Packets:",			&m_pSendCount			},
 		{	"I/O Request Fails:",		&m_pIOFailCount			},
-		{	"Worker Pool Threads:",		&m_pPoolCount			}
+		{	"Worker Pool Threads:",		&m_pPoolCount			},
+		{	"Connection Pool Hits:",	&m_pConnPoolHit			},
+		{	"Connection Pool Misses:",	&m_pConnPoolMiss		}
 	};
 
 	shell_assert(m_pLabel == 0);
@@ -116,6 +129,12 @@ void CNetConnStat::update(const tcpconn_stat_t* pStat)
 
 	snprintf(strTmp, sizeof(strTmp), "%d", counter_get(pStat->worker));
 	gtk_label_set_text(GTK_LABEL(m_pPoolCount), strTmp);
+
+	snprintf(strTmp, sizeof(strTmp), "%d", counter_get(pStat->pool_hit));
+	gtk_label_set_text(GTK_LABEL(m_pConnPoolHit), strTmp);
+
+	snprintf(strTmp, sizeof(strTmp), "%d", counter_get(pStat->pool_miss));
+	gtk_label_set_text(GTK_LABEL(m_pConnPoolMiss), strTmp);
 }
 
 void CNetConnStat::setLabel(const char* strLabel)
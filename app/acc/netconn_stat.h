@@ -9,6 +9,9 @@
  *
  *  Revision 1.0, 15.09.2015-13 16:49:24
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Added connection pool hits/misses.
  */
 
 #ifndef __NETCONN_STAT_H_INCLUDED__
@@ -37,6 +40,8 @@ class CNetConnStat
 		GtkWidget*		m_pIOCount;
 		GtkWidget*		m_pIOFailCount;
 		GtkWidget*		m_pPoolCount;
+		GtkWidget*		m_pConnPoolHit;
+		GtkWidget*		m_pConnPoolMiss;
 
 		GtkWidget*		m_pLabel;
 
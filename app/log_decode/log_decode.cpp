@@ -0,0 +1,567 @@
+/*
+ *  Carbon Framework
+ *  Logger flight recorder decoder
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 08:14:52
+ *      Initial revision.
+ *
+ *  Usage:
+ *  	log_decode <recorder_file>
+ *
+ *  Decode the logger flight recorder file (or its dump) to the logger text
+ *  output. Records of all threads are merged by the timestamp and written
+ *  to the stdout, the statistics are written to the stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <errno.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "shell/defines.h"
+#include "shell/tstring.h"
+#include "shell/tstdio.h"
+#include "shell/logger/flight_recorder.h"
+
+/*
+ * Decoded record reference
+ */
+typedef struct
+{
+	uint64_t				time;				/* Record timestamp, nanoseconds */
+	size_t					seq;				/* Record sequence within the file */
+	const flr_ring_t*		pRing;				/* Record thread ring */
+	const flr_record_t*		pRecord;			/* Record header */
+} decode_item_t;
+
+/*
+ * Recorded arguments reader
+ */
+class CArgReader
+{
+	protected:
+		const uint8_t*		m_p;				/* Next argument */
+		const uint8_t*		m_pEnd;				/* Arguments end */
+		const uint8_t*		m_arArg;			/* Argument types */
+		size_t				m_nArgs;			/* Argument count */
+		size_t				m_index;			/* Next argument index */
+
+	public:
+		CArgReader(const uint8_t* p, const uint8_t* pEnd, const uint8_t* arArg, size_t nArgs) :
+			m_p(p),
+			m_pEnd(pEnd),
+			m_arArg(arArg),
+			m_nArgs(nArgs),
+			m_index(0)
+		{
+		}
+
+	public:
+		boolean_t isAvail() const { return m_index < m_nArgs; }
+		uint8_t getType() const { return m_arArg[m_index]; }
+		const uint8_t* getPos() const { return m_p; }
+
+		boolean_t getValue(uint64_t* pValue) {
+			if ( !isAvail() || m_arArg[m_index] == FLR_ARG_STRING || (m_pEnd-m_p) < 8 )  {
+				return FALSE;
+			}
+			_tmemcpy(pValue, m_p, sizeof(*pValue));
+			m_p += sizeof(*pValue);
+			m_index++;
+			return TRUE;
+		}
+
+		boolean_t getString(std::string* pString) {
+			uint32_t	length;
+
+			if ( !isAvail() || m_arArg[m_index] != FLR_ARG_STRING || (m_pEnd-m_p) < 4 )  {
+				return FALSE;
+			}
+			_tmemcpy(&length, m_p, sizeof(length));
+			if ( length > FLR_ARG_STRING_MAX || (size_t)(m_pEnd-m_p) < sizeof(length)+length )  {
+				return FALSE;
+			}
+			pString->assign((const char*)m_p+sizeof(length), length);
+			m_p += sizeof(length)+length;
+			m_index++;
+			return TRUE;
+		}
+
+		void skipAll() {
+			while ( isAvail() )  {
+				uint64_t		value;
+				std::string		s;
+
+				if ( !(getType() == FLR_ARG_STRING ? getString(&s) : getValue(&value)) )  {
+					m_nArgs = m_index;
+				}
+			}
+		}
+};
+
+static const flr_header_t*	g_pHeader = nullptr;
+
+/*
+ * Get a recorded string
+ *
+ * 		id		string Id
+ *
+ * Return: string or nullptr
+ */
+static const char* getString(uint32_t id)
+{
+	const char*		strStrings = (const char*)(g_pHeader+1);
+
+	if ( id == 0 || id >= g_pHeader->nStringUsed || id >= g_pHeader->nStringSize )  {
+		return nullptr;
+	}
+
+	return &strStrings[id];
+}
+
+/*
+ * Format the user message by the recorded arguments (printf() rules)
+ *
+ * 		strMessage		message format
+ * 		reader			recorded arguments
+ *
+ * Return: formatted message
+ */
+static std::string formatMessage(const char* strMessage, CArgReader& reader)
+{
+	std::string		strOut, strSpec, strTmp;
+	const char*		f = strMessage;
+	char			buf[512];
+	uint64_t		value;
+	double			dvalue;
+	char			c, conv;
+
+	while ( (c=*f++) != '\0' )  {
+		if ( c != '%' )  {
+			strOut += c;
+			continue;
+		}
+
+		if ( *f == '%' )  {
+			strOut += '%';
+			f++;
+			continue;
+		}
+
+		strSpec = "%";
+
+		while ( *f != '\0' && _tstrchr("-+ #0'", *f) != NULL )  {
+			strSpec += *f++;
+		}
+
+		if ( *f == '*' )  {
+			f++;
+			strSpec += reader.getValue(&value) ? std::to_string((int)value) : std::string("0");
+		}
+		while ( *f >= '0' && *f <= '9' )  {
+			strSpec += *f++;
+		}
+
+		if ( *f == '.' )  {
+			strSpec += *f++;
+			if ( *f == '*' )  {
+				f++;
+				strSpec += reader.getValue(&value) ? std::to_string((int)value) : std::string("0");
+			}
+			while ( *f >= '0' && *f <= '9' )  {
+				strSpec += *f++;
+			}
+		}
+
+		/* 'h'/'hh' truncation is kept, other modifiers follow the recorded type */
+		strTmp.clear();
+		while ( *f != '\0' && _tstrchr("hlLqjzt", *f) != NULL )  {
+			strTmp += *f++;
+		}
+		if ( strTmp != "h" && strTmp != "hh" )  {
+			strTmp.clear();
+		}
+
+		conv = *f;
+		if ( conv == '\0' )  {
+			strOut += strSpec;
+			break;
+		}
+		f++;
+
+		if ( conv == 'm' )  {
+			strOut += "%m";
+			continue;
+		}
+
+		if ( conv == 'n' )  {
+			reader.getValue(&value);
+			continue;
+		}
+
+		if ( !reader.isAvail() )  {
+			strOut += "<?>";
+			continue;
+		}
+
+		buf[0] = '\0';
+
+		switch ( reader.getType() )  {
+			case FLR_ARG_STRING:
+				reader.getString(&strTmp);
+				strSpec += 's';
+				_tsnprintf(buf, sizeof(buf), strSpec.c_str(), strTmp.c_str());
+				break;
+
+			case FLR_ARG_DOUBLE:
+			case FLR_ARG_LDOUBLE:
+				reader.getValue(&value);
+				_tmemcpy(&dvalue, &value, sizeof(dvalue));
+				strSpec += conv;
+				_tsnprintf(buf, sizeof(buf), strSpec.c_str(), dvalue);
+				break;
+
+			case FLR_ARG_PTR:
+				reader.getValue(&value);
+				strSpec += 'p';
+				_tsnprintf(buf, sizeof(buf), strSpec.c_str(), (void*)(uintptr_t)value);
+				break;
+
+			case FLR_ARG_INT:
+			case FLR_ARG_UINT:
+				reader.getValue(&value);
+				strSpec += strTmp + conv;
+				_tsnprintf(buf, sizeof(buf), strSpec.c_str(), (int)value);
+				break;
+
+			default:
+				reader.getValue(&value);
+				strSpec += "ll";
+				strSpec += conv;
+				_tsnprintf(buf, sizeof(buf), strSpec.c_str(), (long long)value);
+				break;
+		}
+
+		strOut += buf;
+	}
+
+	return strOut;
+}
+
+/*
+ * Format a HEX dump (CLogger::doFormatHex() rules)
+ */
+static size_t formatHex(const void* pData, int nLength, char* strBuffer, size_t nBufferLength)
+{
+	const char*		strPref;
+	const char*		p = (const char*)pData;
+	char*			s = strBuffer;
+	int				i, l;
+	int				len = (int)nBufferLength-1;
+
+	if ( pData != 0 && nLength > 0 )  {
+		for(i=0; i<nLength; i++)  {
+			if ( len <= 0 ) {
+				break;
+			}
+
+			if ( i == 0 ) 		strPref = " "; else
+			if ( (i&15) == 0 ) 	strPref = "\n"; else
+			if ( (i&3) == 0 ) 	strPref = "  "; else strPref = " ";
+
+			_tsnprintf(s, (size_t)len, "%s%02X", strPref, (*p)&0xff);
+			l = (int)_tstrlen(s);
+			s += l; len -= l; p++;
+		}
+	}
+
+	return nBufferLength-len;
+}
+
+/*
+ * Decode a record to the logger text line (CLogger::writev() rules)
+ *
+ * 		pItem			record to decode
+ * 		strBuffer		output buffer, header nBufferMax bytes
+ *
+ * Return: output length, bytes (0 - record is skipped)
+ */
+static size_t decodeRecord(const decode_item_t* pItem, char* strBuffer)
+{
+	const flr_record_t*	pRecord = pItem->pRecord;
+	const unsigned int	type = _LOGGER_TYPE(pRecord->typeChannels);
+	const size_t		nBufferMax = g_pHeader->nBufferMax;
+	const uint8_t*		pEnd = (const uint8_t*)pRecord + pRecord->size;
+	const char			*strFormat, *strMessage, *strFilename, *strFunction, *f;
+	uint8_t				arArg[FLR_ARG_MAX];
+	size_t				nArgs, len, l, nBufferLength;
+	std::string			strText;
+	const uint8_t*		pData = nullptr;
+	uint32_t			nLength = 0;
+	char*				s = strBuffer;
+	struct tm			tmRecord;
+	time_t				timeRecord;
+	char				c;
+
+	strMessage = getString(pRecord->fmtId);
+	if ( type < 1 || type > LOGGER_TYPES || strMessage == nullptr )  {
+		return 0;
+	}
+
+	strFilename = getString(pRecord->fileId);
+	strFunction = getString(pRecord->funcId);
+	strFormat = strFilename ? g_pHeader->arFormat[type] : g_pHeader->arFormat[0];
+
+	nArgs = sh_min(flr_parse_format(strMessage, arArg), (size_t)pRecord->nArgs);
+	CArgReader	reader((const uint8_t*)(pRecord+1), pEnd, arArg, nArgs);
+
+	f = strFormat;
+	len = nBufferMax-1;
+
+	while ( (c=*f++) != '\0' && len > 0 )  {
+		if ( c != '%' )  {
+			*s = c;
+			s++; len--;
+			continue;
+		}
+
+		switch ( (c=*f++) )  {
+			case 'n':
+				*s = '\n';
+				s++; len--;
+				break;
+
+			case 'F':
+				_tsnprintf(s, len, "%s", strFilename ? strFilename : "<null>");
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 'N':
+				_tsnprintf(s, len, "%d", pRecord->line);
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 'P':
+				_tsnprintf(s, len, "%s", strFunction ? strFunction : "<null>");
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 'T':
+				timeRecord = (time_t)(pRecord->time/1000000000ULL);
+				localtime_r(&timeRecord, &tmRecord);
+				l = strftime(s, len, g_pHeader->arFormatTime[type], &tmRecord);
+				s += l; len -= l;
+				break;
+
+			case 's':
+				strText = formatMessage(strMessage, reader);
+				l = sh_min(strText.length(), len-1);
+				_tmemcpy(s, strText.data(), l);
+				s[l] = '\0';
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 'l':
+				_tsnprintf(s, len, "%s", g_pHeader->arType[type]);
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 'p':
+				_tsnprintf(s, len, "%d", (int)g_pHeader->pid);
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case 't':
+				_tsnprintf(s, len, "%X", pItem->pRing->tid);
+				l = _tstrlen(s);
+				s += l; len -= l;
+				break;
+
+			case '%':
+				*s = '%';
+				s++; len--;
+				break;
+
+			default:
+				*s = '%';
+				s++; len--;
+				if ( len > 0 )  {
+					*s = c;
+					s++; len--;
+				}
+				break;
+		}
+	}
+
+	*s = '\0';
+	nBufferLength = A(s) - A(strBuffer);
+
+	if ( pRecord->flags&FLR_RECORD_DATA )  {
+		reader.skipAll();
+		if ( (size_t)(pEnd-reader.getPos()) >= sizeof(nLength) )  {
+			_tmemcpy(&nLength, reader.getPos(), sizeof(nLength));
+			pData = reader.getPos()+sizeof(nLength);
+			if ( nLength > FLR_DATA_MAX || (size_t)(pEnd-pData) < nLength )  {
+				nLength = 0;
+			}
+		}
+	}
+
+	if ( pData != 0 && (nBufferMax-2) > nBufferLength )  {
+		nBufferLength += formatHex(pData, (int)nLength,
+				&strBuffer[nBufferLength], nBufferMax-nBufferLength);
+
+		if ( nBufferLength < (nBufferMax-2) )  {
+			strBuffer[nBufferLength] = '\n';
+			nBufferLength++;
+			strBuffer[nBufferLength] = '\0';
+		}
+	}
+	else {
+		if ( nBufferLength > 0 && nBufferLength >= (nBufferMax-2) )  {
+			strBuffer[nBufferLength-2] = '\n';
+			strBuffer[nBufferLength-1] = '\0';
+		}
+	}
+
+	return nBufferLength;
+}
+
+/*
+ * Collect the valid records of a ring
+ *
+ * 		pRing			thread ring
+ * 		arItem			records [out]
+ *
+ * Return: FALSE if the ring is damaged (the valid records are collected)
+ */
+static boolean_t collectRing(const flr_ring_t* pRing, std::vector<decode_item_t>& arItem)
+{
+	const uint8_t*			pData = (const uint8_t*)(pRing+1);
+	const size_t			nRingSize = g_pHeader->nRingSize;
+	const flr_record_t*		pRecord;
+	uint64_t				pos;
+	size_t					offset;
+	decode_item_t			item;
+
+	if ( pRing->head < pRing->tail || (pRing->head-pRing->tail) > nRingSize )  {
+		return FALSE;
+	}
+
+	for(pos=pRing->tail; pos<pRing->head; pos+=pRecord->size)  {
+		offset = (size_t)(pos&(nRingSize-1));
+		pRecord = (const flr_record_t*)(pData+offset);
+
+		if ( pRecord->size < sizeof(flr_record_t) && !(pRecord->flags&FLR_RECORD_PAD) )  {
+			return FALSE;
+		}
+		if ( pRecord->size == 0 || (pRecord->size&7) != 0 || offset+pRecord->size > nRingSize ||
+				pos+pRecord->size > pRing->head )
+		{
+			return FALSE;
+		}
+
+		if ( !(pRecord->flags&FLR_RECORD_PAD) )  {
+			item.time = pRecord->time;
+			item.seq = arItem.size();
+			item.pRing = pRing;
+			item.pRecord = pRecord;
+			arItem.push_back(item);
+		}
+	}
+
+	return TRUE;
+}
+
+/*
+ * Normal C/C++ entry point
+ */
+int main(int argc, char* argv[])
+{
+	std::vector<decode_item_t>	arItem;
+	std::vector<uint8_t>		arFile;
+	std::vector<char>			strBuffer;
+	const flr_ring_t*			pRing;
+	FILE*						hFile;
+	size_t						nSize, nStride, nThreads, nDamaged = 0, i, l;
+	uint8_t						buf[64*1024];
+
+	if ( argc != 2 )  {
+		fprintf(stderr, "Usage: %s <recorder_file>\n", argv[0]);
+		return 1;
+	}
+
+	hFile = fopen(argv[1], "rb");
+	if ( hFile == NULL )  {
+		fprintf(stderr, "Failed to open '%s', error %d\n", argv[1], errno);
+		return 1;
+	}
+
+	while ( (l=fread(buf, 1, sizeof(buf), hFile)) > 0 )  {
+		arFile.insert(arFile.end(), buf, buf+l);
+	}
+	fclose(hFile);
+
+	nSize = arFile.size();
+	g_pHeader = (const flr_header_t*)arFile.data();
+
+	if ( nSize < sizeof(flr_header_t) || g_pHeader->magic != FLR_MAGIC ||
+			g_pHeader->version != FLR_VERSION )
+	{
+		fprintf(stderr, "'%s' is not a flight recorder file\n", argv[1]);
+		return 1;
+	}
+
+	if ( g_pHeader->nRingSize == 0 || (g_pHeader->nRingSize&(g_pHeader->nRingSize-1)) != 0 ||
+			g_pHeader->nBufferMax < 8 || (g_pHeader->nStringSize&7) != 0 ||
+			nSize < sizeof(flr_header_t)+g_pHeader->nStringSize )
+	{
+		fprintf(stderr, "'%s' has invalid header\n", argv[1]);
+		return 1;
+	}
+
+	nStride = sizeof(flr_ring_t)+g_pHeader->nRingSize;
+	nThreads = sh_min(g_pHeader->nThreadUsed, g_pHeader->nThreadMax);
+	nThreads = sh_min(nThreads, (nSize-sizeof(flr_header_t)-g_pHeader->nStringSize)/nStride);
+
+	for(i=0; i<nThreads; i++)  {
+		pRing = (const flr_ring_t*)(arFile.data()+sizeof(flr_header_t)+
+									g_pHeader->nStringSize+i*nStride);
+		if ( !collectRing(pRing, arItem) )  {
+			nDamaged++;
+		}
+	}
+
+	std::sort(arItem.begin(), arItem.end(), [](const decode_item_t& a, const decode_item_t& b) {
+		return a.time != b.time ? a.time < b.time : a.seq < b.seq;
+	});
+
+	strBuffer.resize(g_pHeader->nBufferMax);
+	for(const auto& item : arItem)  {
+		l = decodeRecord(&item, strBuffer.data());
+		if ( l > 0 )  {
+			fwrite(strBuffer.data(), l, 1, stdout);
+		}
+	}
+
+	fprintf(stderr, "Process %u: %u record(s) of %u thread(s), %u dropped, %u damaged ring(s)\n",
+			g_pHeader->pid, (unsigned)arItem.size(), (unsigned)nThreads, g_pHeader->nDrop,
+			(unsigned)nDamaged);
+
+	return 0;
+}
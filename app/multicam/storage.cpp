@@ -10,6 +10,9 @@
  *
  *	Revision 1.0, 24.10.2016 11:22:27
  *		Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 00:34:52
+ *		Write the access unit fragments by a single writev().
  */
 
 #include "net_media/rtp_playout_buffer_h264.h"
@@ -38,20 +41,27 @@ CRtpFileWriter::~CRtpFileWriter()
 void CRtpFileWriter::processNode(CRtpPlayoutNode* pNode)
 {
 	CRtpPlayoutNodeH264*	pNodeH264;
+	const struct iovec*		arVec;
 	uint8_t*				pBuffer;
-	size_t					nSize;
+	size_t					nSize, nVec;
 	result_t				nresult;
 
 	pNodeH264 = dynamic_cast<CRtpPlayoutNodeH264*>(pNode);
 	shell_assert(pNodeH264);
 
-	pBuffer = pNodeH264->getData();
 	nSize = pNodeH264->getSize();
 
-	shell_assert(pBuffer != 0);
-
 	if ( nSize > 0 && m_file.isOpen() )  {
-		nresult = m_file.write(pBuffer, &nSize);
+		nresult = pNodeH264->getIov(&arVec, &nVec);
+		if ( nresult == ESUCCESS ) {
+			nresult = m_file.writev(arVec, nVec);
+		}
+		else {
+			pBuffer = pNodeH264->getData();
+			shell_assert(pBuffer != 0);
+			nresult = m_file.write(pBuffer, &nSize);
+		}
+
 		if ( nresult == ESUCCESS ) {
 			counter_inc(m_nFrames);
 		}
@@ -0,0 +1,299 @@
+/*
+ *	Carbon Framework Examples
+ *	Remote Event ping-pong benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 03:41:27
+ *	    Initial revision.
+ *
+ *	Usage:
+ *		remote_event_bench_app			run the benchmark (starts the reply server)
+ *		remote_event_bench_app pong		run the reply server only
+ *
+ *	Measure the remote event round trips between two processes with one
+ *	and with many outstanding requests and compare them with the same
+ *	round trips through the application event loop.
+ */
+
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+#include "shell/file.h"
+
+#include "remote_event_bench_app.h"
+#include "shared.h"
+
+#define BENCH_PAYLOAD_SIZE			64
+#define BENCH_PONG_START_TIMEOUT	HR_5SEC
+
+static const remote_bench_pass_t g_arPass[] =
+{
+	{	"remote, 1 outstanding",		EV_R_PING,		20000,		1	},
+	{	"remote, 256 outstanding",		EV_R_PING,		200000,		256	},
+	{	"in-process, 1 outstanding",	EV_R_LOCAL,		200000,		1	},
+	{	"in-process, 256 outstanding",	EV_R_LOCAL,		1000000,	256	}
+};
+
+/*
+ * Application class constructor
+ *
+ *      argc        command line argument 'argc'
+ *      argv        command line argument 'argv'
+ */
+CRemoteEventBenchApp::CRemoteEventBenchApp(int argc, char* argv[]) :
+    CApplication("Remote Event Benchmark Application", MAKE_VERSION(1,0,0), 1, argc, argv),
+	m_bPong(FALSE),
+	m_pidPong(-1),
+	m_nPass(0),
+	m_nSent(0),
+	m_nRecv(0),
+	m_hrStart(HR_0)
+{
+	m_bPong = argc > 1 && _tstrcmp(argv[1], "pong") == 0;
+}
+
+/*
+ * Application class destructor
+ */
+CRemoteEventBenchApp::~CRemoteEventBenchApp()
+{
+}
+
+/*
+ * Start the reply server process
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRemoteEventBenchApp::startPong()
+{
+	CString		strSocket;
+	hr_time_t	hrStart;
+
+	strSocket = REMOTE_EVENT_ROOT_PATH;
+	strSocket.appendPath(CARBON_REMOTE_EVENT_PONG_RID);
+	CFile::removeFile(strSocket);
+
+	m_pidPong = fork();
+	if ( m_pidPong < 0 )  {
+		log_error(L_GEN, "[bench] failed to start reply server, result: %d\n", errno);
+		return errno;
+	}
+
+	if ( m_pidPong == 0 )  {
+		execl(m_argv[0], m_argv[0], "pong", (char*)NULL);
+		_exit(1);
+	}
+
+	hrStart = hr_time_now();
+	while ( !CFile::fileExists(strSocket) )  {
+		if ( hr_timeout(hrStart, BENCH_PONG_START_TIMEOUT) == HR_0 )  {
+			log_error(L_GEN, "[bench] reply server is not started\n");
+			stopPong();
+			return ETIMEDOUT;
+		}
+		sleep_ms(10);
+	}
+
+	return ESUCCESS;
+}
+
+/*
+ * Stop the reply server process
+ */
+void CRemoteEventBenchApp::stopPong()
+{
+	if ( m_pidPong > 0 )  {
+		if ( g_pRemoteEventService != nullptr )  {
+			appSendRemoteEvent(new CRemoteEvent(EV_R_QUIT, 0, 0, NO_SEQNUM),
+							   CARBON_REMOTE_EVENT_PONG_RID);
+		}
+		else {
+			kill(m_pidPong, SIGTERM);
+		}
+
+		waitpid(m_pidPong, NULL, 0);
+		m_pidPong = -1;
+	}
+}
+
+/*
+ * Send a request of the current pass
+ */
+void CRemoteEventBenchApp::sendRequest()
+{
+	const remote_bench_pass_t*	pPass = &g_arPass[m_nPass];
+	char						payload[BENCH_PAYLOAD_SIZE];
+
+	m_nSent++;
+
+	if ( pPass->type == EV_R_PING )  {
+		_tbzero_object(payload);
+		appSendRemoteEvent(new CRemoteEvent(EV_R_PING, 0, this, (seqnum_t)m_nSent,
+											(const void*)payload, sizeof(payload)),
+						   CARBON_REMOTE_EVENT_PONG_RID);
+	}
+	else {
+		appSendEvent(new CEvent(EV_R_LOCAL, this, NULL, (NPARAM)m_nSent, "local"));
+	}
+}
+
+/*
+ * Start the current pass, stop the application after the last one
+ */
+void CRemoteEventBenchApp::startPass()
+{
+	const remote_bench_pass_t*	pPass;
+	int							i;
+
+	if ( m_nPass >= ARRAY_SIZE(g_arPass) )  {
+		stopPong();
+		stopApplication(0);
+		return;
+	}
+
+	pPass = &g_arPass[m_nPass];
+	m_nSent = 0;
+	m_nRecv = 0;
+	m_hrStart = hr_time_now();
+
+	for(i=0; i<pPass->nWindow && m_nSent < pPass->nCount; i++)  {
+		sendRequest();
+	}
+}
+
+/*
+ * Process a reply of the current pass
+ */
+void CRemoteEventBenchApp::processReply()
+{
+	const remote_bench_pass_t*	pPass = &g_arPass[m_nPass];
+	hr_time_t					hrElapsed;
+
+	m_nRecv++;
+	if ( m_nSent < pPass->nCount )  {
+		sendRequest();
+	}
+
+	if ( m_nRecv == pPass->nCount )  {
+		hrElapsed = hr_time_get_elapsed(m_hrStart);
+		log_info(L_GEN, "%-30s %8d round trips, %6u ms, %9.0f round trips/s, %7.2f us/round trip\n",
+				 pPass->strName, pPass->nCount, (unsigned)HR_TIME_TO_MILLISECONDS(hrElapsed),
+				 hrElapsed > 0 ? (double)pPass->nCount*HR_1SEC/hrElapsed : 0.0,
+				 (double)HR_TIME_TO_MICROSECONDS(hrElapsed)/pPass->nCount);
+
+		m_nPass++;
+		startPass();
+	}
+}
+
+/*
+ * Event processor
+ *
+ *      pEvent      event object to process
+ *
+ * Return:
+ *      TRUE        event processed
+ *      FALSE       event is not processed
+ */
+boolean_t CRemoteEventBenchApp::processEvent(CEvent* pEvent)
+{
+    CRemoteEvent*   pRemoteEvent;
+    boolean_t       bProcessed = TRUE;
+
+    switch ( pEvent->getType() )  {
+        case EV_R_PING:
+            pRemoteEvent = dynamic_cast<CRemoteEvent*>(pEvent);
+            shell_assert(pRemoteEvent);
+            if ( pRemoteEvent )  {
+				appSendRemoteEvent(new CRemoteEvent(EV_R_PONG, pRemoteEvent->getReplyReceiver(), 0,
+													pRemoteEvent->getSessId(),
+													pRemoteEvent->getData(),
+													pRemoteEvent->getDataSize()),
+								   pRemoteEvent->getReplyRid());
+            }
+            break;
+
+		case EV_R_LOCAL:
+			appSendEvent(new CEvent(EV_R_PONG, this, NULL, pEvent->getnParam(), "local"));
+			break;
+
+		case EV_R_PONG:
+			processReply();
+			break;
+
+		case EV_R_QUIT:
+			stopApplication(0);
+			break;
+
+		default:
+			bProcessed = CApplication::processEvent(pEvent);
+			break;
+    }
+
+    return bProcessed;
+}
+
+/*
+ * Application initialisation
+ *
+ * Return:
+ *      ESUCCESS        initalisation success
+ *      other code      initalisation failed, exit application
+ */
+result_t CRemoteEventBenchApp::init()
+{
+	result_t	nresult;
+
+	if ( !m_bPong )  {
+		nresult = startPong();
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+    nresult = CApplication::init();
+    if ( nresult != ESUCCESS )  {
+		stopPong();
+        return nresult;
+    }
+
+    nresult = initRemoteEventService(m_bPong ? CARBON_REMOTE_EVENT_PONG_RID :
+									 	CARBON_REMOTE_EVENT_PING_RID, this);
+    if ( nresult != ESUCCESS )  {
+		stopPong();
+        CApplication::terminate();
+        return nresult;
+    }
+
+	if ( !m_bPong )  {
+		log_info(L_GEN, "Remote event round trips, %d bytes payload:\n", BENCH_PAYLOAD_SIZE);
+		startPass();
+	}
+
+    return nresult;
+}
+
+/*
+ * Application termination
+ */
+void CRemoteEventBenchApp::terminate()
+{
+	stopPong();
+    exitRemoteEventService();
+
+    CApplication::terminate();
+}
+
+/*
+ * Normal C/C++ entry point
+ */
+int main(int argc, char* argv[])
+{
+	return CRemoteEventBenchApp(argc, argv).run();
+}
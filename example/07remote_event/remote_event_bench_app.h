@@ -0,0 +1,65 @@
+/*
+ *	Carbon Framework Examples
+ *	Remote Event ping-pong benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 03:41:27
+ *	    Initial revision.
+ */
+
+#ifndef __EXAMPLE_REMOTE_EVENT_BENCH_APP_H_INCLUDED__
+#define __EXAMPLE_REMOTE_EVENT_BENCH_APP_H_INCLUDED__
+
+#include <sys/types.h>
+
+#include "carbon/carbon.h"
+#include "carbon/application.h"
+#include "carbon/event/remote_event_service.h"
+
+/*
+ * Benchmark pass
+ */
+typedef struct
+{
+	const char*		strName;		/* Pass name */
+	event_type_t	type;			/* Request event, EV_R_PING or EV_R_LOCAL */
+	int				nCount;			/* Round trips */
+	int				nWindow;		/* Outstanding requests */
+} remote_bench_pass_t;
+
+class CRemoteEventBenchApp : public CApplication
+{
+	private:
+		boolean_t		m_bPong;		/* TRUE: reply server mode */
+		pid_t			m_pidPong;		/* Reply server process */
+
+		size_t			m_nPass;		/* Current pass index */
+		int				m_nSent;		/* Sent requests */
+		int				m_nRecv;		/* Received replies */
+		hr_time_t		m_hrStart;		/* Pass start time */
+
+    public:
+		CRemoteEventBenchApp(int argc, char* argv[]);
+        virtual ~CRemoteEventBenchApp();
+
+	public:
+        virtual result_t init();
+        virtual void terminate();
+
+    protected:
+        virtual boolean_t processEvent(CEvent* pEvent);
+
+	private:
+		result_t startPong();
+		void stopPong();
+		void startPass();
+		void sendRequest();
+		void processReply();
+};
+
+#endif /* __EXAMPLE_REMOTE_EVENT_BENCH_APP_H_INCLUDED__ */
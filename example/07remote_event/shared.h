@@ -10,6 +10,9 @@
  *
  *	Revision 1.0, 03.08.2016 17:29:33
  *	    Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 03:41:27
+ *	    Added ping-pong benchmark definitions.
  */
 
 #ifndef __SHARED_H_INCLUDED__
@@ -19,8 +22,14 @@
 
 #define CARBON_REMOTE_EVENT_RECV_RID	"carbon.example.remote_event.recv"
 #define CARBON_REMOTE_EVENT_SEND_RID    "carbon.example.remote_event.send"
+#define CARBON_REMOTE_EVENT_PING_RID	"carbon.example.remote_event.ping"
+#define CARBON_REMOTE_EVENT_PONG_RID	"carbon.example.remote_event.pong"
 
 #define EV_R_TEST						(EV_USER+0)
 #define EV_R_TEST_REPLY					(EV_USER+1)
+#define EV_R_PING						(EV_USER+2)
+#define EV_R_PONG						(EV_USER+3)
+#define EV_R_QUIT						(EV_USER+4)
+#define EV_R_LOCAL						(EV_USER+5)
 
 #endif /* __SHARED_H_INCLUDED__ */
@@ -0,0 +1,105 @@
+/*
+ *	Carbon Framework Examples
+ *	Object allocation benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 14:52:09
+ *	    Initial revision.
+ *
+ *	Allocate and free events and timers in batches
+ *	(a number of objects in flight as in example/02event).
+ */
+
+#include "carbon/event/eventloop.h"
+#include "carbon/memory.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_ALLOC_COUNT           2000000
+#define BENCH_ALLOC_BATCH           1000
+
+#define EV_BENCH_ALLOC              (EV_USER+2)
+
+static void* g_arObject[BENCH_ALLOC_BATCH];
+
+static void timerHandler(void* p)
+{
+    shell_unused(p);
+}
+
+/*
+ * Plain heap allocation of the event sized blocks
+ */
+static void benchmarkAllocHeap()
+{
+    hr_time_t   hrStart = hr_time_now();
+    size_t      i, j;
+
+    for(i=0; i<BENCH_ALLOC_COUNT; i+=BENCH_ALLOC_BATCH)  {
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            g_arObject[j] = memAlloc(sizeof(CEvent));
+        }
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            memFree(g_arObject[j]);
+        }
+    }
+
+    benchmarkResult("memAlloc/memFree (CEvent size)", BENCH_ALLOC_COUNT, hr_time_now()-hrStart);
+}
+
+static void benchmarkAllocEvent()
+{
+    hr_time_t   hrStart = hr_time_now();
+    size_t      i, j;
+
+    for(i=0; i<BENCH_ALLOC_COUNT; i+=BENCH_ALLOC_BATCH)  {
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            g_arObject[j] = new CEvent(EV_BENCH_ALLOC, EVENT_MULTICAST, 0, (NPARAM)j);
+        }
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            ((CEvent*)g_arObject[j])->release();
+        }
+    }
+
+    benchmarkResult("CEvent new/release", BENCH_ALLOC_COUNT, hr_time_now()-hrStart);
+}
+
+static void benchmarkAllocTimer()
+{
+    hr_time_t   hrStart = hr_time_now();
+    size_t      i, j;
+
+    for(i=0; i<BENCH_ALLOC_COUNT; i+=BENCH_ALLOC_BATCH)  {
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            g_arObject[j] = new CTimer(HR_1SEC, timerHandler, "bench-alloc");
+        }
+        for(j=0; j<BENCH_ALLOC_BATCH; j++)  {
+            delete (CTimer*)g_arObject[j];
+        }
+    }
+
+    benchmarkResult("CTimer new/delete", BENCH_ALLOC_COUNT, hr_time_now()-hrStart);
+}
+
+void benchmarkAlloc()
+{
+    CMemoryManager  memoryManager;
+    memory_stat_t   stat;
+
+    memoryManager.resetStat();
+
+    benchmarkAllocHeap();
+    benchmarkAllocEvent();
+    benchmarkAllocTimer();
+
+    memoryManager.getStat(&stat, sizeof(stat));
+    log_info(L_GEN, "slab: allocs %d, frees %d, hits %d, misses %d, remote frees %d, size %d\n",
+             sh_atomic_get(&stat.slab_alloc_count), sh_atomic_get(&stat.slab_free_count),
+             sh_atomic_get(&stat.slab_hit_count), sh_atomic_get(&stat.slab_miss_count),
+             sh_atomic_get(&stat.slab_remote_free_count), sh_atomic_get(&stat.slab_size));
+}
@@ -0,0 +1,169 @@
+/*
+ *	Carbon Framework Examples
+ *	16-bit CRC benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 09:02:37
+ *	    Initial revision.
+ *
+ *	Calculate crc16() over the VEP container sized buffers by each available
+ *	kernel (bitwise - the original one, slice8, slice16, clmul), print the
+ *	throughput in MB/s. The largest buffer is also calculated by parts in
+ *	parallel threads, the parts are joined by crc16_combine().
+ */
+
+#include <pthread.h>
+
+#include "shell/utils.h"
+
+#include "carbon/memory.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_CRC16_BYTES			(512*1024*1024ULL)	/* Bytes per measurement */
+#define BENCH_CRC16_BITWISE_BYTES	(32*1024*1024ULL)	/* Bytes per bitwise measurement */
+#define BENCH_CRC16_THREADS			4
+
+static const size_t g_arCrc16Size[] = {
+	64, 1024, 64*1024, 16*1024*1024
+};
+
+typedef struct
+{
+	const uint8_t*		pData;
+	size_t				nSize;
+	uint16_t			crc;
+} bench_crc16_part_t;
+
+static double benchmarkCrc16Mbs(uint64_t nBytes, hr_time_t hrElapsed)
+{
+	return hrElapsed > 0 ? (double)nBytes*HR_1SEC/hrElapsed/(1024*1024) : 0.0;
+}
+
+/*
+ * Run the current kernel over the buffer
+ *
+ *      pData           data buffer
+ *      nSize           buffer size, bytes
+ *      pCrc            OUT: calculated crc
+ *
+ * Return: throughput, MB/s
+ */
+static double benchmarkCrc16Kernel(const uint8_t* pData, size_t nSize, uint16_t* pCrc)
+{
+	uint64_t	nBytes, nCount, i;
+	hr_time_t	hrStart, hrElapsed;
+	uint16_t	crc = 0;
+
+	nBytes = crc16_get_isa() == CRC16_BITWISE ? BENCH_CRC16_BITWISE_BYTES : BENCH_CRC16_BYTES;
+	nCount = sh_max(nBytes/nSize, (uint64_t)1);
+
+	hrStart = hr_time_now();
+	for(i=0; i<nCount; i++)  {
+		crc = crc16(pData, nSize);
+	}
+	hrElapsed = hr_time_get_elapsed(hrStart);
+
+	*pCrc = crc;
+	return benchmarkCrc16Mbs(nCount*nSize, hrElapsed);
+}
+
+static void* benchmarkCrc16Part(void* p)
+{
+	bench_crc16_part_t*		pPart = (bench_crc16_part_t*)p;
+
+	pPart->crc = crc16(pPart->pData, pPart->nSize);
+	return NULL;
+}
+
+/*
+ * Calculate the CRC by parts in parallel threads
+ *
+ *      pData           data buffer
+ *      nSize           buffer size, bytes
+ *      pCrc            OUT: calculated crc
+ *
+ * Return: throughput, MB/s
+ */
+static double benchmarkCrc16Parallel(const uint8_t* pData, size_t nSize, uint16_t* pCrc)
+{
+	bench_crc16_part_t	arPart[BENCH_CRC16_THREADS];
+	pthread_t			arThread[BENCH_CRC16_THREADS];
+	size_t				nPart = nSize/BENCH_CRC16_THREADS, nPasses, n, i;
+	hr_time_t			hrStart, hrElapsed;
+	uint16_t			crc = 0;
+
+	nPasses = sh_max(BENCH_CRC16_BYTES/nSize, (uint64_t)1);
+
+	hrStart = hr_time_now();
+	for(n=0; n<nPasses; n++)  {
+		for(i=0; i<BENCH_CRC16_THREADS; i++)  {
+			arPart[i].pData = pData + i*nPart;
+			arPart[i].nSize = i < BENCH_CRC16_THREADS-1 ? nPart : nSize-i*nPart;
+			pthread_create(&arThread[i], NULL, benchmarkCrc16Part, &arPart[i]);
+		}
+
+		for(i=0; i<BENCH_CRC16_THREADS; i++)  {
+			pthread_join(arThread[i], NULL);
+		}
+
+		crc = arPart[0].crc;
+		for(i=1; i<BENCH_CRC16_THREADS; i++)  {
+			crc = crc16_combine(crc, arPart[i].crc, arPart[i].nSize);
+		}
+	}
+	hrElapsed = hr_time_get_elapsed(hrStart);
+
+	*pCrc = crc;
+	return benchmarkCrc16Mbs(nPasses*nSize, hrElapsed);
+}
+
+void benchmarkCrc16()
+{
+	crc16_isa_t		isaDefault = crc16_get_isa();
+	size_t			nMax = g_arCrc16Size[ARRAY_SIZE(g_arCrc16Size)-1];
+	uint8_t*		pData = (uint8_t*)memAlloc(nMax);
+	uint32_t		seed = 0x12345678;
+	uint16_t		crc, crcBitwise;
+	double			arMbs[ARRAY_SIZE(g_arCrc16Size)];
+	size_t			i;
+	int				isa;
+
+	for(i=0; i<nMax; i++)  {
+		seed = seed*1103515245 + 12345;
+		pData[i] = (uint8_t)(seed>>23);
+	}
+
+	crc16_set_isa(CRC16_BITWISE);
+	crcBitwise = crc16(pData, nMax);
+
+	log_info(L_GEN, "default kernel: %s\n", crc16_isa_name(isaDefault));
+	log_info(L_GEN, "%-8s %12s %12s %12s %12s  (MB/s)\n", "kernel", "64 B", "1 KB", "64 KB", "16 MB");
+
+	for(isa=CRC16_BITWISE; isa<=CRC16_CLMUL; isa++)  {
+		if ( !crc16_set_isa((crc16_isa_t)isa) )  {
+			continue;
+		}
+
+		for(i=0; i<ARRAY_SIZE(g_arCrc16Size); i++)  {
+			arMbs[i] = benchmarkCrc16Kernel(pData, g_arCrc16Size[i], &crc);
+		}
+
+		log_info(L_GEN, "%-8s %12.0f %12.0f %12.0f %12.0f  %s\n",
+				 crc16_isa_name((crc16_isa_t)isa), arMbs[0], arMbs[1], arMbs[2], arMbs[3],
+				 crc == crcBitwise ? "" : "*CRC MISMATCH*");
+	}
+
+	crc16_set_isa(isaDefault);
+	arMbs[0] = benchmarkCrc16Parallel(pData, nMax, &crc);
+	log_info(L_GEN, "%s, %d threads + crc16_combine(), 16 MB: %.0f MB/s %s\n",
+			 crc16_isa_name(isaDefault), BENCH_CRC16_THREADS, arMbs[0],
+			 crc == crcBitwise ? "" : "*CRC MISMATCH*");
+
+	memFree(pData);
+}
@@ -0,0 +1,141 @@
+/*
+ *	Carbon Framework Examples
+ *	SQL batch writer benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 11:16:42
+ *	    Initial revision.
+ *
+ *	Insert 100k rows to a Sqlite database by CSqlBatch in the different
+ *	modes (row per statement with autocommit, row per statement within
+ *	a transaction, multi-row statements within a transaction, the same
+ *	in WAL journal mode), print the throughput in rows/s.
+ *
+ *	Requires CARBON_DB=1 and the db module in MODULE_DEP.
+ */
+
+#include <unistd.h>
+
+#include "benchmark_app.h"
+
+#if CARBON_DB
+
+#include "db/db_sqlite.h"
+#include "db/db_sql_batch.h"
+
+#define BENCH_DB_ROWS				100000		/* Rows per measurement */
+#define BENCH_DB_AUTOCOMMIT_ROWS	1000		/* Rows per autocommit measurement */
+#define BENCH_DB_FILE				"/tmp/carbon_bench.db"
+
+typedef struct
+{
+	const char*		strTitle;
+	int				nMode;
+	size_t			nRows;
+	const char*		strJournalMode;
+	const char*		strSynchronous;
+} bench_db_case_t;
+
+static const bench_db_case_t g_arDbCase[] = {
+	{ "row, autocommit", 0, BENCH_DB_AUTOCOMMIT_ROWS, "", "" },
+	{ "row, transaction", SQL_BATCH_TRANSACTION, BENCH_DB_ROWS, "", "" },
+	{ "multirow, transaction", SQL_BATCH_MULTIROW|SQL_BATCH_TRANSACTION, BENCH_DB_ROWS, "", "" },
+	{ "multirow, transaction, WAL", SQL_BATCH_MULTIROW|SQL_BATCH_TRANSACTION, BENCH_DB_ROWS,
+		"WAL", "NORMAL" }
+};
+
+static void benchmarkDbRemove()
+{
+	unlink(BENCH_DB_FILE);
+	unlink(BENCH_DB_FILE "-wal");
+	unlink(BENCH_DB_FILE "-shm");
+}
+
+/*
+ * Insert rows to a new database
+ *
+ *      pCase           benchmark case
+ */
+static void benchmarkDbCase(const bench_db_case_t* pCase)
+{
+	CDbSqlite	db(BENCH_DB_FILE);
+	char		strName[32];
+	hr_time_t	hrStart, hrElapsed;
+	uint64_t	nCount = 0;
+	size_t		i;
+	result_t	nresult;
+
+	benchmarkDbRemove();
+
+	db.setJournalMode(pCase->strJournalMode);
+	db.setSynchronous(pCase->strSynchronous);
+
+	nresult = db.connect();
+	if ( nresult == ESUCCESS )  {
+		nresult = db.query("CREATE TABLE track (time INTEGER, sensor INTEGER, "
+						   "value REAL, name TEXT)");
+	}
+
+	if ( nresult != ESUCCESS )  {
+		log_error(L_GEN, "failed to create database %s, result %d\n", BENCH_DB_FILE, nresult);
+		db.disconnect();
+		return;
+	}
+
+	{
+		CSqlBatch	batch(&db, "track", "time, sensor, value, name", 4, pCase->nMode);
+
+		nresult = batch.init();
+
+		hrStart = hr_time_now();
+		for(i=0; i<pCase->nRows && nresult == ESUCCESS; i++)  {
+			_tsnprintf(strName, sizeof(strName), "sensor-%u", (unsigned)(i%64));
+
+			CSqlParam	arParam[] = {
+				CSqlParam((int64_t)i), CSqlParam((uint32_t)(i%64)),
+				CSqlParam((double)i/10), CSqlParam(strName)
+			};
+
+			nresult = batch.insert(arParam);
+		}
+
+		if ( nresult == ESUCCESS )  {
+			nresult = batch.flush();
+		}
+		hrElapsed = hr_time_get_elapsed(hrStart);
+
+		db.queryValue("SELECT COUNT(*) FROM track", &nCount);
+
+		log_info(L_GEN, "%-28s %8lu rows %12.0f rows/s  %s\n", pCase->strTitle, pCase->nRows,
+				 hrElapsed > 0 ? (double)pCase->nRows*HR_1SEC/hrElapsed : 0.0,
+				 nresult == ESUCCESS && nCount == pCase->nRows ? "" : "*FAILED*");
+		batch.dump();
+	}
+
+	db.disconnect();
+}
+
+void benchmarkDb()
+{
+	size_t	i;
+
+	for(i=0; i<ARRAY_SIZE(g_arDbCase); i++)  {
+		benchmarkDbCase(&g_arDbCase[i]);
+	}
+
+	benchmarkDbRemove();
+}
+
+#else /* CARBON_DB */
+
+void benchmarkDb()
+{
+	log_info(L_GEN, "db module is disabled (CARBON_DB=0)\n");
+}
+
+#endif /* CARBON_DB */
@@ -0,0 +1,109 @@
+/*
+ *	Carbon Framework Examples
+ *	Event dispatch benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 12:40:18
+ *	    Initial revision.
+ *
+ *	Send events to a large number of receivers registered
+ *	within a single event loop and dispatch them.
+ */
+
+#include "carbon/event/eventloop.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_EVENT_RECEIVERS       1000
+#define BENCH_EVENT_UNICAST         1000000
+#define BENCH_EVENT_MULTICAST       1000
+#define BENCH_EVENT_BATCH           1000
+
+#define EV_BENCH                    (EV_USER+0)
+
+/*
+ * Event loop with exposed event processing
+ */
+class CBenchEventLoop : public CEventLoop
+{
+    public:
+        CBenchEventLoop() : CEventLoop("bench-event-loop") {}
+        virtual ~CBenchEventLoop() {}
+
+    public:
+        void process() { processEvents(); }
+};
+
+static uint64_t     g_nReceived = 0;
+
+class CBenchReceiver : public CEventReceiver
+{
+    public:
+        CBenchReceiver(CEventLoop* pLoop) : CEventReceiver(pLoop, "bench-receiver") {}
+        virtual ~CBenchReceiver() {}
+
+    public:
+        virtual boolean_t processEvent(CEvent* pEvent) {
+            shell_unused(pEvent);
+            g_nReceived++;
+            return TRUE;
+        }
+};
+
+/*
+ * Send events in batches and dispatch them
+ *
+ *      loop            event loop
+ *      arReceiver      receivers
+ *      nCount          event count
+ *      bMulticast      send multicast events
+ *
+ * Return: elapsed time
+ */
+static hr_time_t benchmarkEventSend(CBenchEventLoop& loop, CBenchReceiver** arReceiver,
+                                    size_t nCount, boolean_t bMulticast)
+{
+    CEventReceiver*     pReceiver;
+    hr_time_t           hrStart;
+    size_t              i, j;
+
+    hrStart = hr_time_now();
+    for(i=0; i<nCount; i+=BENCH_EVENT_BATCH)  {
+        for(j=i; j<(i+BENCH_EVENT_BATCH) && j<nCount; j++)  {
+            pReceiver = bMulticast ? EVENT_MULTICAST : arReceiver[j%BENCH_EVENT_RECEIVERS];
+            loop.sendEvent(new CEvent(EV_BENCH, pReceiver, 0, (NPARAM)j));
+        }
+        loop.process();
+    }
+
+    return hr_time_now()-hrStart;
+}
+
+void benchmarkEvent()
+{
+    CBenchEventLoop     loop;
+    CBenchReceiver*     arReceiver[BENCH_EVENT_RECEIVERS];
+    hr_time_t           hrElapsed;
+    size_t              i;
+
+    for(i=0; i<BENCH_EVENT_RECEIVERS; i++)  {
+        arReceiver[i] = new CBenchReceiver(&loop);
+    }
+
+    g_nReceived = 0;
+    hrElapsed = benchmarkEventSend(loop, arReceiver, BENCH_EVENT_UNICAST, FALSE);
+    benchmarkResult("unicast, 1000 receivers", g_nReceived, hrElapsed);
+
+    g_nReceived = 0;
+    hrElapsed = benchmarkEventSend(loop, arReceiver, BENCH_EVENT_MULTICAST, TRUE);
+    benchmarkResult("multicast, 1000 receivers (deliveries)", g_nReceived, hrElapsed);
+
+    for(i=0; i<BENCH_EVENT_RECEIVERS; i++)  {
+        delete arReceiver[i];
+    }
+}
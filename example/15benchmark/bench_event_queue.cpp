@@ -0,0 +1,138 @@
+/*
+ *	Carbon Framework Examples
+ *	Event queue benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 13:31:52
+ *	    Initial revision.
+ *
+ *	Send events from several producer threads to a single
+ *	event loop thread.
+ */
+
+#include <pthread.h>
+
+#include "carbon/event/eventloop.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_QUEUE_EVENTS          1000000
+#define BENCH_QUEUE_MAX_PRODUCERS   8
+
+#define EV_BENCH_QUEUE              (EV_USER+1)
+
+class CBenchQueueReceiver : public CEventReceiver
+{
+    public:
+        CCondition          m_cond;
+        uint64_t            m_nReceived;
+        uint64_t            m_nExpected;
+
+    public:
+        CBenchQueueReceiver(CEventLoop* pLoop) :
+            CEventReceiver(pLoop, "bench-queue-receiver"),
+            m_nReceived(0),
+            m_nExpected(0)
+        {
+        }
+
+        virtual ~CBenchQueueReceiver() {}
+
+    public:
+        virtual boolean_t processEvent(CEvent* pEvent) {
+            shell_unused(pEvent);
+
+            if ( ++m_nReceived == m_nExpected )  {
+                m_cond.lock();
+                m_cond.wakeup();
+                m_cond.unlock();
+            }
+            return TRUE;
+        }
+};
+
+typedef struct
+{
+    CEventLoop*             pLoop;
+    CBenchQueueReceiver*    pReceiver;
+    size_t                  nCount;
+} bench_producer_t;
+
+static void* producerThread(void* p)
+{
+    bench_producer_t*   pProducer = (bench_producer_t*)p;
+    size_t              i;
+
+    for(i=0; i<pProducer->nCount; i++)  {
+        pProducer->pLoop->sendEvent(new CEvent(EV_BENCH_QUEUE, pProducer->pReceiver,
+                                               0, (NPARAM)i));
+    }
+
+    return NULL;
+}
+
+/*
+ * Send events from a number of threads and wait for the delivery
+ *
+ *      loop            running event loop
+ *      receiver        event receiver
+ *      nProducers      producer thread count
+ */
+static void benchmarkQueueProducers(CEventLoop& loop, CBenchQueueReceiver& receiver,
+                                    size_t nProducers)
+{
+    pthread_t           arThread[BENCH_QUEUE_MAX_PRODUCERS];
+    bench_producer_t    arProducer[BENCH_QUEUE_MAX_PRODUCERS];
+    size_t              nCount = BENCH_QUEUE_EVENTS/nProducers, i;
+    hr_time_t           hrStart, hrElapsed;
+    char                strTmp[64];
+
+    receiver.m_cond.lock();
+    receiver.m_nReceived = 0;
+    receiver.m_nExpected = nCount*nProducers;
+    receiver.m_cond.unlock();
+
+    hrStart = hr_time_now();
+    for(i=0; i<nProducers; i++)  {
+        arProducer[i].pLoop = &loop;
+        arProducer[i].pReceiver = &receiver;
+        arProducer[i].nCount = nCount;
+        pthread_create(&arThread[i], NULL, producerThread, &arProducer[i]);
+    }
+
+    for(i=0; i<nProducers; i++)  {
+        pthread_join(arThread[i], NULL);
+    }
+
+    receiver.m_cond.lock();
+    while ( receiver.m_nReceived < receiver.m_nExpected )  {
+        receiver.m_cond.waitTimed(hr_time_now()+HR_1SEC);
+    }
+    receiver.m_cond.unlock();
+    hrElapsed = hr_time_now()-hrStart;
+
+    _tsnprintf(strTmp, sizeof(strTmp), "send/dispatch, %u producer(s)", (unsigned)nProducers);
+    benchmarkResult(strTmp, nCount*nProducers, hrElapsed);
+}
+
+void benchmarkEventQueue()
+{
+    CEventLoopThread        loop("bench-queue-loop");
+    CBenchQueueReceiver     receiver(&loop);
+    size_t                  nProducers;
+
+    if ( loop.start() != ESUCCESS )  {
+        return;
+    }
+
+    for(nProducers=1; nProducers<=BENCH_QUEUE_MAX_PRODUCERS; nProducers*=2)  {
+        benchmarkQueueProducers(loop, receiver, nProducers);
+    }
+
+    loop.stop();
+}
@@ -0,0 +1,231 @@
+/*
+ *	Carbon Framework Examples
+ *	H.264 bitstream scanning benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 01:40:55
+ *	    Initial revision.
+ *
+ *	Split an Annex B byte stream to the NAL units, remove and insert the
+ *	emulation prevention bytes by each available kernel (scalar, SSE2,
+ *	AVX2), print the throughput in GB/s. The streams are synthesised with
+ *	the 1080p and 4K frame sizes, a recorded stream may be added by the
+ *	BENCH_H264_FILE environment variable.
+ */
+
+#include <stdlib.h>
+
+#include "shell/file.h"
+
+#include "carbon/memory.h"
+
+#include "net_media/h264_scan.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_H264_FRAMES           250             /* 10 seconds at 25 fps */
+#define BENCH_H264_GOP              50
+#define BENCH_H264_PASSES           10
+#define BENCH_H264_SLICES           4               /* Slices per frame */
+
+typedef struct
+{
+    const char*     strName;
+    size_t          nIdrSize;                   /* IDR frame size, bytes */
+    size_t          nFrameSize;                 /* Non-IDR frame size, bytes */
+} bench_h264_profile_t;
+
+static const bench_h264_profile_t g_arH264Profile[] = {
+    { "1080p",      180*1024,       32*1024 },  /* ~8 Mbit/s */
+    { "4K",         640*1024,       110*1024 }  /* ~25 Mbit/s */
+};
+
+/*
+ * Append a NAL unit with a pseudo-random payload
+ *
+ *      pStream         output stream
+ *      pSize           IN/OUT: stream size
+ *      nType           NAL unit type
+ *      nLength         raw payload length
+ *      pSeed           random seed
+ */
+static void benchmarkH264Nal(uint8_t* pStream, size_t* pSize, uint8_t nType,
+                             size_t nLength, uint32_t* pSeed)
+{
+    uint8_t*    pRaw = (uint8_t*)memAlloc(nLength);
+    uint8_t*    p = pStream + *pSize;
+    size_t      i;
+
+    /* CABAC data is close to random, the zero runs force the prevention bytes */
+    for(i=0; i<nLength; i++)  {
+        *pSeed = *pSeed*1103515245 + 12345;
+        pRaw[i] = ((*pSeed>>16)&0x3ff) < 6 ? 0 : (uint8_t)(*pSeed>>23);
+    }
+
+    *p++ = 0; *p++ = 0; *p++ = 0; *p++ = 1;
+    *p++ = (uint8_t)(0x60|nType);
+    p += h264_rbsp_encode(p, pRaw, nLength);
+
+    *pSize = (size_t)(p - pStream);
+    memFree(pRaw);
+}
+
+/*
+ * Make a synthetic stream
+ *
+ *      pProfile        frame sizes
+ *      pSize           OUT: stream size
+ *
+ * Return: stream buffer
+ */
+static uint8_t* benchmarkH264Stream(const bench_h264_profile_t* pProfile, size_t* pSize)
+{
+    size_t      nMax, nFrame;
+    uint8_t*    pStream;
+    uint32_t    seed = 0x12345678;
+    int         i, j;
+
+    nMax = H264_EBSP_SIZE_MAX(pProfile->nIdrSize)*(BENCH_H264_FRAMES/BENCH_H264_GOP+1) +
+            H264_EBSP_SIZE_MAX(pProfile->nFrameSize)*BENCH_H264_FRAMES + 64*BENCH_H264_FRAMES*8;
+    pStream = (uint8_t*)memAlloc(nMax);
+    *pSize = 0;
+
+    for(i=0; i<BENCH_H264_FRAMES; i++)  {
+        if ( (i%BENCH_H264_GOP) == 0 )  {
+            benchmarkH264Nal(pStream, pSize, 7, 24, &seed);       /* SPS */
+            benchmarkH264Nal(pStream, pSize, 8, 4, &seed);        /* PPS */
+            nFrame = pProfile->nIdrSize;
+        }
+        else {
+            nFrame = pProfile->nFrameSize;
+        }
+
+        for(j=0; j<BENCH_H264_SLICES; j++)  {
+            benchmarkH264Nal(pStream, pSize, (i%BENCH_H264_GOP) == 0 ? 5 : 1,
+                             nFrame/BENCH_H264_SLICES, &seed);
+        }
+    }
+
+    return pStream;
+}
+
+static double benchmarkH264Gbs(size_t nSize, hr_time_t hrElapsed)
+{
+    return hrElapsed > 0 ? (double)nSize*BENCH_H264_PASSES*HR_1SEC/hrElapsed/1e9 : 0.0;
+}
+
+/*
+ * Run the kernels of the current instruction set over the stream
+ *
+ *      strName         stream name
+ *      pStream         Annex B byte stream
+ *      nSize           stream size, bytes
+ */
+static void benchmarkH264Kernels(const char* strName, const uint8_t* pStream, size_t nSize)
+{
+    const char*     strIsa = h264_scan_isa_name(h264_scan_get_isa());
+    uint8_t*        pRbsp = (uint8_t*)memAlloc(nSize);
+    uint8_t*        pEbsp = (uint8_t*)memAlloc(H264_EBSP_SIZE_MAX(nSize));
+    size_t          offset, next, nNal = 0, nRbsp = 0, nEbsp = 0;
+    hr_time_t       hrStart, hrScan, hrDecode, hrEncode;
+    int             i;
+
+    /* Start code scan */
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_H264_PASSES; i++)  {
+        offset = 0;
+        nNal = 0;
+        do {
+            next = h264_find_next_nal(pStream+offset, nSize-offset);
+            offset += next;
+            nNal++;
+        } while ( next != 0 );
+    }
+    hrScan = hr_time_get_elapsed(hrStart);
+
+    /* Emulation prevention bytes removal */
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_H264_PASSES; i++)  {
+        nRbsp = h264_rbsp_decode(pRbsp, pStream, nSize);
+    }
+    hrDecode = hr_time_get_elapsed(hrStart);
+
+    /* Emulation prevention bytes insertion */
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_H264_PASSES; i++)  {
+        nEbsp = h264_rbsp_encode(pEbsp, pRbsp, nRbsp);
+    }
+    hrEncode = hr_time_get_elapsed(hrStart);
+
+    log_info(L_GEN, "%-6s %-7s scan %6.2f GB/s, epb strip %6.2f GB/s, epb insert %6.2f GB/s "
+             "(%u nals, %u/%u bytes)\n", strName, strIsa,
+             benchmarkH264Gbs(nSize, hrScan), benchmarkH264Gbs(nSize, hrDecode),
+             benchmarkH264Gbs(nRbsp, hrEncode), (unsigned)nNal, (unsigned)nRbsp,
+             (unsigned)nEbsp);
+
+    memFree(pEbsp);
+    memFree(pRbsp);
+}
+
+/*
+ * Run all the available kernels over the stream
+ */
+static void benchmarkH264Run(const char* strName, const uint8_t* pStream, size_t nSize)
+{
+    h264_scan_isa_t     isaDefault = h264_scan_get_isa();
+    int                 isa;
+
+    log_info(L_GEN, "%s stream: %u KB\n", strName, (unsigned)(nSize/1024));
+
+    for(isa=H264_SCAN_SCALAR; isa<=H264_SCAN_AVX2; isa++)  {
+        if ( h264_scan_set_isa((h264_scan_isa_t)isa) )  {
+            benchmarkH264Kernels(strName, pStream, nSize);
+        }
+    }
+
+    h264_scan_set_isa(isaDefault);
+}
+
+void benchmarkH264()
+{
+    const char*     strFile = getenv("BENCH_H264_FILE");
+    uint8_t*        pStream;
+    size_t          i, nSize;
+
+    log_info(L_GEN, "default kernel: %s\n", h264_scan_isa_name(h264_scan_get_isa()));
+
+    for(i=0; i<ARRAY_SIZE(g_arH264Profile); i++)  {
+        pStream = benchmarkH264Stream(&g_arH264Profile[i], &nSize);
+        benchmarkH264Run(g_arH264Profile[i].strName, pStream, nSize);
+        memFree(pStream);
+    }
+
+    if ( strFile )  {
+        CFile       file;
+        uint64_t    size64;
+        result_t    nresult;
+
+        nresult = file.open(strFile, CFile::fileRead);
+        if ( nresult == ESUCCESS )  {
+            nresult = file.getSize(&size64);
+        }
+        if ( nresult == ESUCCESS )  {
+            nSize = (size_t)size64;
+            pStream = (uint8_t*)memAlloc(nSize);
+            nresult = file.read(pStream, &nSize, CFile::fileReadFull);
+            if ( nresult == ESUCCESS )  {
+                benchmarkH264Run("file", pStream, nSize);
+            }
+            memFree(pStream);
+        }
+
+        if ( nresult != ESUCCESS )  {
+            log_error(L_GEN, "can't read %s, result %d\n", strFile, nresult);
+        }
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ *	Carbon Framework Examples
+ *	HTTP response receive benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 18:04:12
+ *	    Initial revision.
+ *
+ *	Receive a stream of HTTP responses over the loopback connection
+ *	by CHttpContainer and count receive/poll system calls made by
+ *	the process during the receive.
+ */
+
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+
+#include "shell/socket.h"
+
+#include "carbon/http_container.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_HTTP_COUNT            20000
+#define BENCH_HTTP_BODY_SIZE        512
+#define BENCH_HTTP_PORT             29532
+#define BENCH_HTTP_TIMEOUT          HR_10SEC
+
+/*
+ * System call counters
+ *
+ * The libc recv(), recvfrom() and poll() are replaced in this program
+ * to count the calls made by the shell socket functions.
+ */
+static volatile boolean_t   g_bHttpCount = FALSE;
+static atomic_t             g_nHttpRecv;
+static atomic_t             g_nHttpPoll;
+
+extern "C" ssize_t recvfrom(int fd, void* pBuffer, size_t size, int flags,
+                            struct sockaddr* pAddr, socklen_t* pAddrLen)
+{
+    if ( g_bHttpCount )  {
+        sh_atomic_inc(&g_nHttpRecv);
+    }
+    return ::syscall(SYS_recvfrom, fd, pBuffer, size, flags, pAddr, pAddrLen);
+}
+
+extern "C" ssize_t recv(int fd, void* pBuffer, size_t size, int flags)
+{
+    return recvfrom(fd, pBuffer, size, flags, NULL, NULL);
+}
+
+extern "C" int poll(struct pollfd* pfd, nfds_t nfds, int msTimeout)
+{
+    struct timespec     ts;
+
+    if ( g_bHttpCount )  {
+        sh_atomic_inc(&g_nHttpPoll);
+    }
+
+    ts.tv_sec = msTimeout/1000;
+    ts.tv_nsec = (msTimeout%1000)*1000000L;
+    return ::ppoll(pfd, nfds, msTimeout >= 0 ? &ts : NULL, NULL);
+}
+
+/*
+ * Server side: accept a single client and send the responses
+ */
+static void* httpServerThread(void* p)
+{
+    int         hListen = *(int*)p;
+    char        strResponse[1024+BENCH_HTTP_BODY_SIZE];
+    size_t      length, offset;
+    ssize_t     len;
+    int         hSocket, i;
+
+    hSocket = ::accept(hListen, NULL, NULL);
+    if ( hSocket < 0 )  {
+        log_error(L_GEN, "accept() failed, result %d\n", errno);
+        return NULL;
+    }
+
+    length = _tsnprintf(strResponse, sizeof(strResponse),
+                        "HTTP/1.1 200 OK\r\n"
+                        "Server: carbon-benchmark\r\n"
+                        "Date: Sat, 17 Oct 2026 18:00:00 GMT\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Cache-Control: no-cache, no-store\r\n"
+                        "Connection: keep-alive\r\n"
+                        "X-Request-Id: 0123456789abcdef0123456789abcdef\r\n"
+                        "Content-Length: %u\r\n"
+                        "\r\n", BENCH_HTTP_BODY_SIZE);
+    _tmemset(strResponse+length, 'x', BENCH_HTTP_BODY_SIZE);
+    length += BENCH_HTTP_BODY_SIZE;
+
+    for(i=0; i<BENCH_HTTP_COUNT; i++)  {
+        offset = 0;
+        while ( offset < length )  {
+            len = ::send(hSocket, strResponse+offset, length-offset, MSG_NOSIGNAL);
+            if ( len <= 0 )  {
+                ::close(hSocket);
+                return NULL;
+            }
+            offset += len;
+        }
+    }
+
+    /* Wait for the client close */
+    len = ::read(hSocket, strResponse, sizeof(strResponse));
+    shell_unused(len);
+    ::close(hSocket);
+    return NULL;
+}
+
+void benchmarkHttp()
+{
+    struct sockaddr_in  addr;
+    CSocket             socket;
+    pthread_t           thread;
+    hr_time_t           hrStart, hrElapsed;
+    uint64_t            nBytes = 0;
+    int                 hListen, i, nRecv, nPoll;
+    result_t            nresult = ESUCCESS;
+
+    hListen = ::socket(AF_INET, SOCK_STREAM|SOCK_CLOEXEC, 0);
+    i = 1;
+    ::setsockopt(hListen, SOL_SOCKET, SO_REUSEADDR, &i, sizeof(i));
+
+    _tbzero_object(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BENCH_HTTP_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ( ::bind(hListen, (struct sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(hListen, 1) != 0 )  {
+        log_error(L_GEN, "failed to listen, result %d\n", errno);
+        ::close(hListen);
+        return;
+    }
+
+    pthread_create(&thread, NULL, httpServerThread, &hListen);
+
+    nresult = socket.connect(CNetAddr("127.0.0.1", BENCH_HTTP_PORT), BENCH_HTTP_TIMEOUT);
+    if ( nresult == ESUCCESS )  {
+        sh_atomic_set(&g_nHttpRecv, 0);
+        sh_atomic_set(&g_nHttpPoll, 0);
+        g_bHttpCount = TRUE;
+
+        hrStart = hr_time_now();
+        for(i=0; i<BENCH_HTTP_COUNT; i++)  {
+            dec_ptr<CHttpContainer>     pContainer = new CHttpContainer;
+
+            nresult = pContainer->receive(socket, BENCH_HTTP_TIMEOUT);
+            if ( nresult != ESUCCESS )  {
+                log_error(L_GEN, "response %d receive failed, result %d\n", i, nresult);
+                break;
+            }
+            nBytes += pContainer->getBodySize();
+        }
+        hrElapsed = hr_time_get_elapsed(hrStart);
+
+        g_bHttpCount = FALSE;
+        nRecv = sh_atomic_get(&g_nHttpRecv);
+        nPoll = sh_atomic_get(&g_nHttpPoll);
+
+        benchmarkResult("http response receive", i, hrElapsed);
+        log_info(L_GEN, "%d responses, %u body bytes: %d recv (%.1f per response), "
+                 "%d poll (%.1f per response)\n", i, (unsigned)nBytes,
+                 nRecv, i ? (double)nRecv/i : 0.0, nPoll, i ? (double)nPoll/i : 0.0);
+    }
+    else {
+        log_error(L_GEN, "failed to connect, result %d\n", nresult);
+    }
+
+    socket.close();
+    pthread_join(thread, NULL);
+    ::close(hListen);
+}
@@ -0,0 +1,167 @@
+/*
+ *	Carbon Framework Examples
+ *	JSON parser/serializer benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 21:48:16
+ *	    Initial revision.
+ *
+ *	Load and save a multi-megabyte host list document (the same shape
+ *	as the center host data) by the native parser/serializer and by the
+ *	jansson library, look up the members of a large object by the name.
+ */
+
+#include "carbon/json.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_JSON_HOSTS            20000
+#define BENCH_JSON_PASSES           5
+#define BENCH_JSON_LOOKUPS          1000000
+
+/*
+ * Make a host list document
+ *
+ *      root        output object
+ */
+static void benchmarkJsonHosts(CJsonObject& root)
+{
+    CJsonArray&     hosts = root.insertArray("hosts");
+    CJsonObject&    index = root.insertObject("index");
+    char            strTmp[128];
+    int             i, j;
+
+    root.insert("version", 3);
+    root.insert("updated", (uint64_t)1792230000123ULL);
+
+    for(i=0; i<BENCH_JSON_HOSTS; i++)  {
+        CJsonObject*    pHost = hosts.insertObject();
+        CJsonArray*     pArr;
+
+        _tsnprintf(strTmp, sizeof(strTmp), "host-%05d", i);
+        pHost->insert("name", strTmp);
+        index.insert(strTmp, i);
+
+        pHost->insert("id", (uint64_t)(0x5a5a000000ULL+i));
+        _tsnprintf(strTmp, sizeof(strTmp), "10.%d.%d.%d", (i>>16)&255, (i>>8)&255, i&255);
+        pHost->insert("ip", strTmp);
+        pHost->insert("port", 6000+(i%100));
+        pHost->insertBoolean("enabled", (i%7) != 0);
+        pHost->insert("load", (double)(i%1000)/7.0);
+        _tsnprintf(strTmp, sizeof(strTmp), "Host \"%d\"\\rack %d\tslot %d, \xd1\x83\xd0\xb7\xd0\xb5\xd0\xbb",
+                   i, i/40, i%40);
+        pHost->insert("description", strTmp);
+        if ( i%5 == 0 )  {
+            pHost->insertNull("owner");
+        }
+
+        pArr = &pHost->insertArray("services");
+        for(j=0; j<4; j++)  {
+            _tsnprintf(strTmp, sizeof(strTmp), "svc-%d", (i+j)%16);
+            pArr->insert(strTmp);
+        }
+
+        CJsonObject&    stats = pHost->insertObject("stats");
+        stats.insert("rx", (uint64_t)i*1048576);
+        stats.insert("tx", (uint64_t)i*524288);
+        stats.insert("uptime", i*3600);
+    }
+}
+
+/*
+ * Load and save the document by the given engine
+ *
+ *      strJson         document text
+ *      options         JSON_OPTION_NONE or JSON_OPTION_JANSSON
+ */
+static void benchmarkJsonEngine(const CString& strJson, json_option_t options)
+{
+    const char*     strEngine = (options&JSON_OPTION_JANSSON) ? "jansson" : "native";
+    CJsonObject     root;
+    CString         strOut;
+    hr_time_t       hrStart, hrElapsed;
+    char            strTmp[64];
+    int             i;
+    result_t        nresult = ESUCCESS;
+
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_JSON_PASSES && nresult == ESUCCESS; i++)  {
+        nresult = root.load(strJson, strJson.size(), options);
+    }
+    hrElapsed = hr_time_get_elapsed(hrStart);
+
+    if ( nresult != ESUCCESS )  {
+        log_error(L_GEN, "%s load failed, result %d\n", strEngine, nresult);
+        return;
+    }
+
+    _tsnprintf(strTmp, sizeof(strTmp), "%s load, %u KB", strEngine, (unsigned)(strJson.size()/1024));
+    benchmarkResult(strTmp, BENCH_JSON_PASSES, hrElapsed);
+    log_info(L_GEN, "%s load: %.1f MB/s\n", strEngine,
+             hrElapsed > 0 ? (double)strJson.size()*BENCH_JSON_PASSES*HR_1SEC/hrElapsed/1048576 : 0.0);
+
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_JSON_PASSES && nresult == ESUCCESS; i++)  {
+        nresult = root.save(strOut, (json_option_t)(options|JSON_OPTION_PRETTY));
+    }
+    hrElapsed = hr_time_get_elapsed(hrStart);
+
+    if ( nresult != ESUCCESS )  {
+        log_error(L_GEN, "%s save failed, result %d\n", strEngine, nresult);
+        return;
+    }
+
+    _tsnprintf(strTmp, sizeof(strTmp), "%s save, %u KB", strEngine, (unsigned)(strOut.size()/1024));
+    benchmarkResult(strTmp, BENCH_JSON_PASSES, hrElapsed);
+    log_info(L_GEN, "%s save: %.1f MB/s\n", strEngine,
+             hrElapsed > 0 ? (double)strOut.size()*BENCH_JSON_PASSES*HR_1SEC/hrElapsed/1048576 : 0.0);
+}
+
+/*
+ * Member lookups by the name in the large object
+ */
+static void benchmarkJsonLookup(const CJsonObject& root)
+{
+    CJsonObject*    pIndex = root.getObject("index");
+    hr_time_t       hrStart, hrElapsed;
+    char            strTmp[64];
+    int             i, nFound = 0;
+
+    if ( !pIndex )  {
+        log_error(L_GEN, "no index object\n");
+        return;
+    }
+
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_JSON_LOOKUPS; i++)  {
+        _tsnprintf(strTmp, sizeof(strTmp), "host-%05d", (int)(((uint64_t)i*7919)%BENCH_JSON_HOSTS));
+        nFound += pIndex->get(strTmp) != 0;
+    }
+    hrElapsed = hr_time_get_elapsed(hrStart);
+
+    _tsnprintf(strTmp, sizeof(strTmp), "object lookup, %u members", (unsigned)pIndex->size());
+    benchmarkResult(strTmp, BENCH_JSON_LOOKUPS, hrElapsed);
+    if ( nFound != BENCH_JSON_LOOKUPS )  {
+        log_error(L_GEN, "found %d of %d members\n", nFound, BENCH_JSON_LOOKUPS);
+    }
+}
+
+void benchmarkJson()
+{
+    CJsonObject     root;
+    CString         strJson;
+
+    benchmarkJsonHosts(root);
+    root.save(strJson, JSON_OPTION_PRETTY);
+    log_info(L_GEN, "host list document: %u hosts, %u KB\n",
+             BENCH_JSON_HOSTS, (unsigned)(strJson.size()/1024));
+
+    benchmarkJsonEngine(strJson, JSON_OPTION_JANSSON);
+    benchmarkJsonEngine(strJson, JSON_OPTION_NONE);
+    benchmarkJsonLookup(root);
+}
@@ -0,0 +1,121 @@
+/*
+ *	Carbon Framework Examples
+ *	Logger throughput benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 11:55:20
+ *	    Initial revision.
+ *
+ *	Write debug messages to a file appender from several threads in
+ *	the synchronous and asynchronous logger modes, print the time per
+ *	message per thread and the dropped message count.
+ */
+
+#include <unistd.h>
+#include <pthread.h>
+
+#include "shell/logger/appender_file.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_LOGGER_THREADS        8
+#define BENCH_LOGGER_MESSAGES       100000      /* Messages per thread */
+#define BENCH_LOGGER_FILE           "/tmp/carbon_bench.log"
+#define BENCH_LOGGER_FILE_SIZE      (1024*1024*1024)
+
+typedef struct
+{
+    CLogger*        pLogger;
+    int             nThread;
+    hr_time_t       hrElapsed;
+} bench_logger_thread_t;
+
+/*
+ * Writer thread, the same call as log_debug() to a private logger
+ */
+static void* benchmarkLoggerThread(void* p)
+{
+    bench_logger_thread_t*  pThread = (bench_logger_thread_t*)p;
+    hr_time_t               hrStart;
+    int                     i;
+
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_LOGGER_MESSAGES; i++)  {
+        pThread->pLogger->write(LT_DEBUG|L_GEN, __FILE__, __LINE__, __FUNCTION__, NULL, 0,
+                                "thread %d, message %d, value %u\n",
+                                pThread->nThread, i, (unsigned)(i*7));
+    }
+    pThread->hrElapsed = hr_time_get_elapsed(hrStart);
+
+    return NULL;
+}
+
+/*
+ * Run writer threads in the given logger mode
+ *
+ *      bAsync          TRUE: asynchronous logger mode
+ */
+static void benchmarkLoggerMode(boolean_t bAsync)
+{
+    bench_logger_thread_t   arThread[BENCH_LOGGER_THREADS];
+    pthread_t               arId[BENCH_LOGGER_THREADS];
+    hr_time_t               hrStart, hrElapsed, hrThread = 0;
+    uint32_t                nDrop;
+    int                     i;
+    result_t                nresult;
+
+    unlink(BENCH_LOGGER_FILE);
+
+    {
+        CLogger     logger(FALSE);
+
+        nresult = logger.insertAppender(new CAppenderFile(BENCH_LOGGER_FILE, 1,
+                                                          BENCH_LOGGER_FILE_SIZE));
+        if ( nresult == ESUCCESS && bAsync )  {
+            nresult = logger.setAsync(TRUE);
+        }
+
+        if ( nresult != ESUCCESS )  {
+            log_error(L_GEN, "failed to setup logger, result %d\n", nresult);
+            return;
+        }
+
+        hrStart = hr_time_now();
+        for(i=0; i<BENCH_LOGGER_THREADS; i++)  {
+            arThread[i].pLogger = &logger;
+            arThread[i].nThread = i;
+            arThread[i].hrElapsed = 0;
+            pthread_create(&arId[i], NULL, benchmarkLoggerThread, &arThread[i]);
+        }
+
+        for(i=0; i<BENCH_LOGGER_THREADS; i++)  {
+            pthread_join(arId[i], NULL);
+            hrThread += arThread[i].hrElapsed;
+        }
+
+        /* Queued messages are written by setAsync(false) */
+        logger.setAsync(FALSE);
+        hrElapsed = hr_time_get_elapsed(hrStart);
+        nDrop = logger.getDropCount();
+    }
+
+    log_info(L_GEN, "%-6s %d threads x %d messages: %6.2f us/message per thread, "
+             "total %u ms, dropped %u\n",
+             bAsync ? "async" : "sync", BENCH_LOGGER_THREADS, BENCH_LOGGER_MESSAGES,
+             (double)HR_TIME_TO_MICROSECONDS(hrThread)/
+                ((double)BENCH_LOGGER_THREADS*BENCH_LOGGER_MESSAGES),
+             (unsigned)HR_TIME_TO_MILLISECONDS(hrElapsed), nDrop);
+}
+
+void benchmarkLogger()
+{
+    benchmarkLoggerMode(FALSE);
+    benchmarkLoggerMode(TRUE);
+
+    unlink(BENCH_LOGGER_FILE);
+}
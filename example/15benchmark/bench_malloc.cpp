@@ -0,0 +1,86 @@
+/*
+ *	Carbon Framework Examples
+ *	Accounted malloc benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 15:24:47
+ *	    Initial revision.
+ *
+ *	Allocate and free small blocks from several threads
+ *	with the memory manager accounting (CARBON_MALLOC).
+ */
+
+#include <pthread.h>
+
+#include "carbon/memory.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_MALLOC_COUNT          2000000     /* Per thread */
+#define BENCH_MALLOC_BATCH          64
+#define BENCH_MALLOC_MAX_THREADS    8
+#define BENCH_MALLOC_SAMPLE_RATE    64
+
+static void* mallocThread(void* p)
+{
+    void*       arBlock[BENCH_MALLOC_BATCH];
+    size_t      i, j;
+
+    shell_unused(p);
+
+    for(i=0; i<BENCH_MALLOC_COUNT; i+=BENCH_MALLOC_BATCH)  {
+        for(j=0; j<BENCH_MALLOC_BATCH; j++)  {
+            arBlock[j] = memAlloc(16+(j*37)%496);
+        }
+        for(j=0; j<BENCH_MALLOC_BATCH; j++)  {
+            memFree(arBlock[j]);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Run malloc/free loop in a number of threads
+ *
+ *      nThreads        thread count
+ *      strMode         result name suffix
+ */
+static void benchmarkMallocThreads(size_t nThreads, const char* strMode)
+{
+    pthread_t       arThread[BENCH_MALLOC_MAX_THREADS];
+    hr_time_t       hrStart;
+    size_t          i;
+    char            strTmp[64];
+
+    hrStart = hr_time_now();
+    for(i=0; i<nThreads; i++)  {
+        pthread_create(&arThread[i], NULL, mallocThread, NULL);
+    }
+    for(i=0; i<nThreads; i++)  {
+        pthread_join(arThread[i], NULL);
+    }
+
+    _tsnprintf(strTmp, sizeof(strTmp), "malloc/free, %u thread(s)%s", (unsigned)nThreads, strMode);
+    benchmarkResult(strTmp, BENCH_MALLOC_COUNT*nThreads, hr_time_now()-hrStart);
+}
+
+void benchmarkMalloc()
+{
+    CMemoryManager  memoryManager;
+    size_t          nThreads;
+
+    for(nThreads=1; nThreads<=BENCH_MALLOC_MAX_THREADS; nThreads*=2)  {
+        benchmarkMallocThreads(nThreads, "");
+    }
+
+    memoryManager.setSampleRate(BENCH_MALLOC_SAMPLE_RATE);
+    benchmarkMallocThreads(BENCH_MALLOC_MAX_THREADS, ", sampled");
+    memoryManager.dump();
+    memoryManager.setSampleRate(0);
+}
@@ -0,0 +1,340 @@
+/*
+ *	Carbon Framework Examples
+ *	Network server connection scaling benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 17:05:36
+ *	    Initial revision.
+ *
+ *	Connect a large number of clients to CNetServer in the reactor
+ *	mode and run a line echo on every connection. A small number of
+ *	clients is also served in the thread per connection mode.
+ */
+
+#include <sys/epoll.h>
+#include <sys/resource.h>
+
+#include "carbon/text_container.h"
+#include "carbon/net_server/net_server.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_NETSERV_CLIENTS       10000
+#define BENCH_NETSERV_THREAD_CLIENTS 32
+#define BENCH_NETSERV_ROUNDS        10
+#define BENCH_NETSERV_IO_THREADS    2
+#define BENCH_NETSERV_PORT          29531
+#define BENCH_NETSERV_TIMEOUT       HR_1MIN
+
+#define BENCH_NETSERV_LINE          "ping\r\n"
+#define BENCH_NETSERV_LINE_LENGTH   (sizeof(BENCH_NETSERV_LINE)-1)
+
+/*
+ * Line container for the asynchronous I/O
+ */
+class CBenchLineContainer : public CTextContainer
+{
+    public:
+        CBenchLineContainer() : CTextContainer(256) {}
+    protected:
+        virtual ~CBenchLineContainer() {}
+
+    public:
+        virtual CNetContainer* clone() {
+            return new CBenchLineContainer;
+        }
+
+        virtual result_t send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr) {
+            uint32_t    offset = 0;
+            result_t    nresult;
+
+            shell_unused(dstAddr);
+            nresult = send((CSocketAsync&)socket, &offset);
+            if ( nresult == EAGAIN )  {
+                nresult = socket.send(m_pBuffer+offset, m_nSize-offset, hrTimeout);
+            }
+            return nresult;
+        }
+
+        virtual result_t receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr* pSrcAddr) {
+            hr_time_t   hrStart = hr_time_now();
+            result_t    nresult;
+
+            shell_unused(pSrcAddr);
+            clear();
+            while ( (nresult=receive((CSocketAsync&)socket)) == EAGAIN )  {
+                nresult = socket.select(hr_timeout(hrStart, hrTimeout), CSocket::pollRead);
+                if ( nresult != ESUCCESS )  {
+                    break;
+                }
+            }
+            return nresult;
+        }
+
+        virtual result_t send(CSocketAsync& socket, uint32_t* pOffset) {
+            return CTextContainer::send(socket, pOffset);
+        }
+
+        virtual result_t receive(CSocketAsync& socket) {
+            return CTextContainer::receive(socket);
+        }
+
+        virtual void getDump(char* strBuf, size_t length) const {
+            copyString(strBuf, m_pBuffer, length);
+        }
+};
+
+/*
+ * Echo server application side
+ */
+class CBenchNetServReceiver : public CEventReceiver
+{
+    protected:
+        CNetServer*     m_pServer;
+        atomic_t        m_nConnected;
+
+    public:
+        CBenchNetServReceiver(CEventLoop* pLoop) :
+            CEventReceiver(pLoop, "bench-netserv"),
+            m_pServer(0)
+        {
+            sh_atomic_set(&m_nConnected, 0);
+        }
+
+        virtual ~CBenchNetServReceiver() {}
+
+    public:
+        void setServer(CNetServer* pServer) { m_pServer = pServer; }
+        int getConnected() const { return sh_atomic_get(&m_nConnected); }
+
+        virtual boolean_t processEvent(CEvent* pEvent) {
+            CEventNetServerRecv*    pEventRecv;
+
+            switch ( pEvent->getType() )  {
+                case EV_NET_SERVER_CONNECTED:
+                    sh_atomic_inc(&m_nConnected);
+                    return TRUE;
+
+                case EV_NET_SERVER_DISCONNECTED:
+                    /* Connections are closed by the server terminate() */
+                    sh_atomic_dec(&m_nConnected);
+                    return TRUE;
+
+                case EV_NET_SERVER_RECV:
+                    pEventRecv = dynamic_cast<CEventNetServerRecv*>(pEvent);
+                    shell_assert(pEventRecv);
+                    m_pServer->send(pEventRecv->getContainer(), pEventRecv->getHandle());
+                    return TRUE;
+            }
+
+            return FALSE;
+        }
+};
+
+/*
+ * Client connection state
+ */
+typedef struct
+{
+    int         hSocket;
+    size_t      nRecv;          /* Received bytes of the current line */
+    int         nRound;         /* Completed echo rounds */
+} bench_client_t;
+
+/*
+ * Connect clients to the server
+ *
+ *      arClient        clients
+ *      nClients        client count
+ *      hEpoll          client side epoll
+ *
+ * Return: ESUCCESS, ...
+ */
+static result_t benchmarkNetServConnect(bench_client_t* arClient, size_t nClients, int hEpoll)
+{
+    struct sockaddr_in  addr;
+    struct epoll_event  event;
+    size_t              i;
+
+    _tbzero_object(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BENCH_NETSERV_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for(i=0; i<nClients; i++)  {
+        arClient[i].hSocket = ::socket(AF_INET, SOCK_STREAM|SOCK_NONBLOCK|SOCK_CLOEXEC, 0);
+        arClient[i].nRecv = 0;
+        arClient[i].nRound = 0;
+
+        if ( arClient[i].hSocket < 0 )  {
+            log_error(L_GEN, "socket() failed, client %u, result %d\n", (unsigned)i, errno);
+            return errno;
+        }
+
+        if ( ::connect(arClient[i].hSocket, (struct sockaddr*)&addr, sizeof(addr)) != 0 &&
+                errno != EINPROGRESS )
+        {
+            log_error(L_GEN, "connect() failed, client %u, result %d\n", (unsigned)i, errno);
+            return errno;
+        }
+
+        event.events = EPOLLIN;
+        event.data.ptr = &arClient[i];
+        ::epoll_ctl(hEpoll, EPOLL_CTL_ADD, arClient[i].hSocket, &event);
+    }
+
+    return ESUCCESS;
+}
+
+/*
+ * Run echo rounds on all clients
+ *
+ * Return: completed echo count
+ */
+static uint64_t benchmarkNetServEcho(bench_client_t* arClient, size_t nClients, int hEpoll)
+{
+    struct epoll_event  arEvent[256];
+    char                strBuf[64];
+    hr_time_t           hrStart = hr_time_now();
+    uint64_t            nEcho = 0, nTotal = (uint64_t)nClients*BENCH_NETSERV_ROUNDS;
+    bench_client_t*     pClient;
+    ssize_t             len;
+    size_t              i;
+    int                 n, count;
+
+    for(i=0; i<nClients; i++)  {
+        len = ::send(arClient[i].hSocket, BENCH_NETSERV_LINE, BENCH_NETSERV_LINE_LENGTH, MSG_NOSIGNAL);
+        shell_unused(len);
+    }
+
+    while ( nEcho < nTotal && hr_time_get_elapsed(hrStart) < BENCH_NETSERV_TIMEOUT )  {
+        count = ::epoll_wait(hEpoll, arEvent, ARRAY_SIZE(arEvent), 1000);
+
+        for(n=0; n<count; n++)  {
+            pClient = (bench_client_t*)arEvent[n].data.ptr;
+
+            len = ::recv(pClient->hSocket, strBuf, sizeof(strBuf), 0);
+            if ( len <= 0 )  {
+                continue;
+            }
+
+            pClient->nRecv += len;
+            while ( pClient->nRecv >= BENCH_NETSERV_LINE_LENGTH )  {
+                pClient->nRecv -= BENCH_NETSERV_LINE_LENGTH;
+                pClient->nRound++;
+                nEcho++;
+
+                if ( pClient->nRound < BENCH_NETSERV_ROUNDS )  {
+                    len = ::send(pClient->hSocket, BENCH_NETSERV_LINE, BENCH_NETSERV_LINE_LENGTH,
+                                 MSG_NOSIGNAL);
+                    shell_unused(len);
+                }
+            }
+        }
+    }
+
+    return nEcho;
+}
+
+/*
+ * Connect clients and run echo in the given server mode
+ *
+ *      nClients            client count
+ *      nReactorThreads     server I/O threads, 0 - thread per connection
+ */
+static void benchmarkNetServMode(size_t nClients, size_t nReactorThreads)
+{
+    CEventLoopThread        loop("bench-netserv-loop");
+    CBenchNetServReceiver   receiver(&loop);
+    bench_client_t*         arClient;
+    hr_time_t               hrStart, hrElapsed;
+    uint64_t                nEcho;
+    size_t                  i;
+    int                     hEpoll;
+    char                    strTmp[64];
+    result_t                nresult;
+
+    CNetServer  server(nClients+16, new CBenchLineContainer, &receiver, nReactorThreads);
+
+    receiver.setServer(&server);
+    loop.start();
+
+    nresult = server.init();
+    if ( nresult != ESUCCESS )  {
+        log_error(L_GEN, "net server init failed, result %d\n", nresult);
+        loop.stop();
+        return;
+    }
+
+    server.startListen(CNetAddr("127.0.0.1", BENCH_NETSERV_PORT));
+    hr_sleep(HR_100MSEC);
+
+    arClient = new bench_client_t[nClients];
+    hEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+    hrStart = hr_time_now();
+    nresult = benchmarkNetServConnect(arClient, nClients, hEpoll);
+    while ( nresult == ESUCCESS && (size_t)receiver.getConnected() < nClients &&
+            hr_time_get_elapsed(hrStart) < BENCH_NETSERV_TIMEOUT )
+    {
+        hr_sleep(HR_1MSEC);
+    }
+    hrElapsed = hr_time_get_elapsed(hrStart);
+
+    _tsnprintf(strTmp, sizeof(strTmp), "%s connect, %u clients",
+               nReactorThreads ? "reactor" : "thread", (unsigned)nClients);
+    benchmarkResult(strTmp, receiver.getConnected(), hrElapsed);
+
+    if ( nresult == ESUCCESS )  {
+        hrStart = hr_time_now();
+        nEcho = benchmarkNetServEcho(arClient, nClients, hEpoll);
+        hrElapsed = hr_time_get_elapsed(hrStart);
+
+        _tsnprintf(strTmp, sizeof(strTmp), "%s echo, %u clients",
+                   nReactorThreads ? "reactor" : "thread", (unsigned)nClients);
+        benchmarkResult(strTmp, nEcho, hrElapsed);
+    }
+
+    for(i=0; i<nClients; i++)  {
+        if ( arClient[i].hSocket >= 0 )  {
+            ::close(arClient[i].hSocket);
+        }
+    }
+    ::close(hEpoll);
+    delete[] arClient;
+
+    hrStart = hr_time_now();
+    server.terminate();
+    loop.stop();
+
+    log_info(L_GEN, "%s server terminated in %u ms\n", nReactorThreads ? "reactor" : "thread",
+             (unsigned)HR_TIME_TO_MILLISECONDS(hr_time_get_elapsed(hrStart)));
+}
+
+void benchmarkNetServ()
+{
+    struct rlimit   rlim;
+    size_t          nClients = BENCH_NETSERV_CLIENTS;
+    rlim_t          nFiles = nClients*2+256;
+
+    /* Client and server socket per connection */
+    if ( getrlimit(RLIMIT_NOFILE, &rlim) == 0 && rlim.rlim_cur < nFiles )  {
+        rlim.rlim_cur = nFiles;
+        rlim.rlim_max = sh_max(rlim.rlim_max, nFiles);
+        if ( setrlimit(RLIMIT_NOFILE, &rlim) != 0 )  {
+            getrlimit(RLIMIT_NOFILE, &rlim);
+            nClients = rlim.rlim_cur > 512 ? (rlim.rlim_cur-256)/2 : 128;
+            log_info(L_GEN, "file limit %u, using %u clients\n",
+                     (unsigned)rlim.rlim_cur, (unsigned)nClients);
+        }
+    }
+
+    benchmarkNetServMode(BENCH_NETSERV_THREAD_CLIENTS, 0);
+    benchmarkNetServMode(BENCH_NETSERV_THREAD_CLIENTS, BENCH_NETSERV_IO_THREADS);
+    benchmarkNetServMode(nClients, BENCH_NETSERV_IO_THREADS);
+}
@@ -0,0 +1,277 @@
+/*
+ *	Carbon Framework Examples
+ *	RTP receiver pool benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 19:40:21
+ *	    Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 20:31:07
+ *	    Added CRtpFrameCache get/put benchmark.
+ *
+ *	Send RTP streams over the loopback to a number of CRtpReceiverPool
+ *	channels and measure the received packet rate and the receive CPU
+ *	time per packet, in the thread per receiver mode and in the shared
+ *	I/O loop mode.
+ *
+ *	Get and put frames of the shared CRtpFrameCache by a number of
+ *	threads, by a single frame and in batches.
+ */
+
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "net_media/rtp_playout_buffer.h"
+#include "net_media/rtp_receiver_pool.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_RTP_CHANNELS          32
+#define BENCH_RTP_PACKETS           20000           /* Packets per channel */
+#define BENCH_RTP_PACKET_SIZE       1200
+#define BENCH_RTP_INFLIGHT          4096            /* Maximum sent but not received packets */
+#define BENCH_RTP_LOOPS             1
+#define BENCH_RTP_PORT              29600
+#define BENCH_RTP_PROFILE           96
+#define BENCH_RTP_TIMEOUT           HR_1MIN
+
+#define BENCH_RTP_CACHE_THREADS     4
+#define BENCH_RTP_CACHE_COUNT       2000000         /* Frames per thread */
+#define BENCH_RTP_CACHE_BATCH       32
+
+/*
+ * Playout buffer stub: the streams are sent with the other payload type,
+ * so the received frames are dropped by the receiver to the frame cache.
+ */
+class CBenchRtpPlayoutBuffer : public CRtpPlayoutBuffer
+{
+    public:
+        CBenchRtpPlayoutBuffer() :
+            CRtpPlayoutBuffer(BENCH_RTP_PROFILE, 25, 90000, 64, 0, "bench-rtp-playout") {}
+        virtual ~CBenchRtpPlayoutBuffer() {}
+
+    protected:
+        virtual CRtpPlayoutNode* createNode(rtp_frame_t* pFrame, uint64_t rtpRealTimestamp) {
+            shell_unused(pFrame);
+            shell_unused(rtpRealTimestamp);
+            return NULL;
+        }
+};
+
+typedef struct
+{
+    CRtpReceiverPool*   pPool;
+    uint64_t            nSent;              /* Sent packets */
+    hr_time_t           hrCpu;              /* Sender thread CPU time */
+} bench_rtp_sender_t;
+
+static hr_time_t benchmarkRtpCpu(int who)
+{
+    struct rusage   usage;
+
+    getrusage(who, &usage);
+    return SECONDS_TO_HR_TIME(usage.ru_utime.tv_sec+usage.ru_stime.tv_sec) +
+            MICROSECONDS_TO_HR_TIME(usage.ru_utime.tv_usec+usage.ru_stime.tv_usec);
+}
+
+/*
+ * Sender: a packet to each channel per round
+ */
+static void* rtpSenderThread(void* p)
+{
+    bench_rtp_sender_t*     pSender = (bench_rtp_sender_t*)p;
+    struct sockaddr_in      arAddr[BENCH_RTP_CHANNELS];
+    struct mmsghdr          arMsg[BENCH_RTP_CHANNELS];
+    struct iovec            arIov[BENCH_RTP_CHANNELS];
+    uint8_t                 arPacket[BENCH_RTP_CHANNELS][BENCH_RTP_PACKET_SIZE];
+    hr_time_t               hrCpu = benchmarkRtpCpu(RUSAGE_THREAD);
+    uint32_t                fields;
+    int                     hSocket, i, n, nRound;
+
+    hSocket = ::socket(AF_INET, SOCK_DGRAM|SOCK_CLOEXEC, 0);
+
+    _tbzero_object(arMsg);
+    for(i=0; i<BENCH_RTP_CHANNELS; i++)  {
+        _tbzero_object(arAddr[i]);
+        arAddr[i].sin_family = AF_INET;
+        arAddr[i].sin_port = htons(BENCH_RTP_PORT+i);
+        arAddr[i].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        _tbzero_object(arPacket[i]);
+        arIov[i].iov_base = arPacket[i];
+        arIov[i].iov_len = BENCH_RTP_PACKET_SIZE;
+
+        arMsg[i].msg_hdr.msg_name = &arAddr[i];
+        arMsg[i].msg_hdr.msg_namelen = sizeof(arAddr[i]);
+        arMsg[i].msg_hdr.msg_iov = &arIov[i];
+        arMsg[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    for(nRound=0; nRound<BENCH_RTP_PACKETS; nRound++)  {
+        /* Version 2, payload type 97, sequence number */
+        fields = (RTP_VERSION<<30) | ((BENCH_RTP_PROFILE+1)<<16) | (nRound&0xffff);
+        for(i=0; i<BENCH_RTP_CHANNELS; i++)  {
+            *(uint32_t*)arPacket[i] = htonl(fields);
+        }
+
+        while ( pSender->nSent > (uint64_t)pSender->pPool->getFrameCount()+BENCH_RTP_INFLIGHT )  {
+            hr_sleep(HR_1MSEC);
+        }
+
+        n = ::sendmmsg(hSocket, arMsg, BENCH_RTP_CHANNELS, 0);
+        if ( n > 0 )  {
+            pSender->nSent += n;
+        }
+    }
+
+    ::close(hSocket);
+    pSender->hrCpu = benchmarkRtpCpu(RUSAGE_THREAD) - hrCpu;
+    return NULL;
+}
+
+/*
+ * Receive the streams in the given pool mode
+ *
+ *      nLoops          shared I/O loops, 0 - thread per receiver
+ */
+static void benchmarkRtpMode(size_t nLoops)
+{
+    CRtpReceiverPool        pool("bench-rtp", RTP_FRAME_CACHE_LIMIT, nLoops);
+    CBenchRtpPlayoutBuffer  arBuffer[BENCH_RTP_CHANNELS];
+    bench_rtp_sender_t      sender;
+    pthread_t               thread;
+    hr_time_t               hrStart, hrElapsed, hrCpu, hrLast;
+    uint64_t                nRecv, nPrev;
+    char                    strTmp[64];
+    int                     i;
+    result_t                nresult;
+
+    for(i=0; i<BENCH_RTP_CHANNELS; i++)  {
+        pool.insertChannel(&arBuffer[i], CNetAddr("127.0.0.1", BENCH_RTP_PORT+i));
+    }
+
+    nresult = pool.init();
+    if ( nresult != ESUCCESS )  {
+        log_error(L_GEN, "receiver pool init failed, result %d\n", nresult);
+        pool.removeAllChannels();
+        return;
+    }
+
+    hr_sleep(HR_100MSEC);
+
+    sender.pPool = &pool;
+    sender.nSent = 0;
+    sender.hrCpu = HR_0;
+
+    hrCpu = benchmarkRtpCpu(RUSAGE_SELF);
+    hrStart = hr_time_now();
+    pthread_create(&thread, NULL, rtpSenderThread, &sender);
+    pthread_join(thread, NULL);
+
+    /* Wait for the rest of the packets, the lost ones are never received */
+    nPrev = 0;
+    hrLast = hr_time_now();
+    while ( (nRecv=(uint64_t)pool.getFrameCount()) < sender.nSent &&
+            hr_time_get_elapsed(hrLast) < HR_100MSEC*2 &&
+            hr_time_get_elapsed(hrStart) < BENCH_RTP_TIMEOUT )
+    {
+        if ( nRecv != nPrev )  {
+            nPrev = nRecv;
+            hrLast = hr_time_now();
+        }
+        hr_sleep(HR_1MSEC);
+    }
+
+    hrElapsed = hr_time_get_elapsed(hrStart);
+    hrCpu = benchmarkRtpCpu(RUSAGE_SELF) - hrCpu - sender.hrCpu;
+    nRecv = (uint64_t)pool.getFrameCount();
+
+    pool.terminate();
+    pool.removeAllChannels();
+
+    _tsnprintf(strTmp, sizeof(strTmp), "%s receive, %d channels",
+               nLoops ? "loop" : "thread", BENCH_RTP_CHANNELS);
+    benchmarkResult(strTmp, nRecv, hrElapsed);
+    log_info(L_GEN, "%u sent, %u received, receive cpu %u ms, %.0f packets per cpu second\n",
+             (unsigned)sender.nSent, (unsigned)nRecv, (unsigned)HR_TIME_TO_MILLISECONDS(hrCpu),
+             hrCpu > 0 ? (double)nRecv*HR_1SEC/hrCpu : 0.0);
+}
+
+typedef struct
+{
+    CRtpFrameCache*     pCache;
+    boolean_t           bBulk;              /* TRUE: getN()/putN() */
+} bench_rtp_cache_t;
+
+static void* rtpCacheThread(void* p)
+{
+    bench_rtp_cache_t*  pParam = (bench_rtp_cache_t*)p;
+    CRtpFrameCache*     pCache = pParam->pCache;
+    rtp_frame_t*        arFrame[BENCH_RTP_CACHE_BATCH];
+    size_t              i, n, count;
+
+    for(n=0; n<BENCH_RTP_CACHE_COUNT; n+=BENCH_RTP_CACHE_BATCH)  {
+        if ( pParam->bBulk )  {
+            count = pCache->getN(arFrame, BENCH_RTP_CACHE_BATCH);
+            pCache->putN(arFrame, count);
+        }
+        else {
+            for(i=0; i<BENCH_RTP_CACHE_BATCH; i++)  {
+                arFrame[i] = pCache->get();
+            }
+            for(i=0; i<BENCH_RTP_CACHE_BATCH; i++)  {
+                pCache->put(arFrame[i]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Frame cache get/put by a number of threads
+ *
+ *      bBulk           TRUE: getN()/putN(), FALSE: get()/put()
+ */
+static void benchmarkRtpCache(boolean_t bBulk)
+{
+    CRtpFrameCache      cache;
+    bench_rtp_cache_t   param;
+    pthread_t           arThread[BENCH_RTP_CACHE_THREADS];
+    hr_time_t           hrStart, hrElapsed;
+    char                strTmp[64];
+    int                 i;
+
+    param.pCache = &cache;
+    param.bBulk = bBulk;
+
+    hrStart = hr_time_now();
+    for(i=0; i<BENCH_RTP_CACHE_THREADS; i++)  {
+        pthread_create(&arThread[i], NULL, rtpCacheThread, &param);
+    }
+    for(i=0; i<BENCH_RTP_CACHE_THREADS; i++)  {
+        pthread_join(arThread[i], NULL);
+    }
+    hrElapsed = hr_time_get_elapsed(hrStart);
+
+    _tsnprintf(strTmp, sizeof(strTmp), "frame cache %s, %d threads",
+               bBulk ? "getN/putN" : "get/put", BENCH_RTP_CACHE_THREADS);
+    benchmarkResult(strTmp, (uint64_t)BENCH_RTP_CACHE_COUNT*BENCH_RTP_CACHE_THREADS, hrElapsed);
+    cache.dump();
+}
+
+void benchmarkRtp()
+{
+    benchmarkRtpCache(FALSE);
+    benchmarkRtpCache(TRUE);
+
+    benchmarkRtpMode(0);
+    benchmarkRtpMode(BENCH_RTP_LOOPS);
+}
@@ -0,0 +1,172 @@
+/*
+ *	Carbon Framework Examples
+ *	Timer queue benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 11:15:27
+ *	    Initial revision.
+ *
+ *	Arm, restart and fire a large number of one-shot timers
+ *	with every timer queue backend.
+ */
+
+#include "carbon/event/eventloop.h"
+#include "carbon/event/timer_queue.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_TIMER_COUNT           100000
+#define BENCH_TIMER_LIST_COUNT      10000       /* Sorted list is O(n) per insert */
+#define BENCH_TIMER_SPREAD          200         /* Timeout spread, msec */
+
+/*
+ * Sorted linked list timer queue (the former CEventLoop implementation)
+ */
+class CTimerListQueue : public CTimerQueue
+{
+    protected:
+        CTimer*     m_pHead;
+        size_t      m_nCount;
+
+    public:
+        CTimerListQueue() : CTimerQueue(), m_pHead(0), m_nCount(0) {}
+        virtual ~CTimerListQueue() {}
+
+    public:
+        virtual void insert(CTimer* pTimer) {
+            CTimer  *pCur = m_pHead, *pPrev = 0;
+
+            while ( pCur != 0 && pCur->getTime() <= pTimer->getTime() )  {
+                pPrev = pCur;
+                pCur = (CTimer*)pCur->next();
+            }
+
+            pTimer->setPrev(pPrev);
+            pTimer->setNext(pCur);
+            if ( pCur )  { pCur->setPrev(pTimer); }
+            if ( pPrev )  { pPrev->setNext(pTimer); } else { m_pHead = pTimer; }
+
+            link(pTimer, this, 0);
+            m_nCount++;
+        }
+
+        virtual void remove(CTimer* pTimer) {
+            CTimer  *pPrev = (CTimer*)pTimer->prev(), *pNext = (CTimer*)pTimer->next();
+
+            if ( pNext )  { pNext->setPrev(pPrev); }
+            if ( pPrev )  { pPrev->setNext(pNext); } else { m_pHead = pNext; }
+
+            unlink(pTimer);
+            m_nCount--;
+        }
+
+        virtual CTimer* getClosest() const { return m_pHead; }
+
+        virtual CTimer* getExpired(hr_time_t hrTime) {
+            CTimer*     pTimer = m_pHead;
+
+            if ( pTimer != 0 && hrTime >= pTimer->getTime() )  {
+                remove(pTimer);
+                return pTimer;
+            }
+            return 0;
+        }
+
+        virtual CTimer* getHead() const { return m_pHead; }
+        virtual CTimer* getNext(CTimer* pTimer) const { return (CTimer*)pTimer->next(); }
+
+        virtual CTimer* removeHead() {
+            CTimer*     pTimer = m_pHead;
+
+            if ( pTimer )  { remove(pTimer); }
+            return pTimer;
+        }
+
+        virtual size_t getSize() const { return m_nCount; }
+};
+
+/*
+ * Event loop with exposed timer processing
+ */
+class CBenchTimerLoop : public CEventLoop
+{
+    public:
+        CBenchTimerLoop() : CEventLoop("bench-timer-loop") {}
+        virtual ~CBenchTimerLoop() {}
+
+    public:
+        void process() { processTimers(); }
+};
+
+static uint64_t     g_nFired = 0;
+static uint32_t     g_nSeed = 1;
+
+static hr_time_t randomTimeout()
+{
+    g_nSeed = g_nSeed*1103515245 + 12345;
+    return MILLISECONDS_TO_HR_TIME(1 + (g_nSeed>>16)%BENCH_TIMER_SPREAD);
+}
+
+static void timerHandler(void* p)
+{
+    shell_unused(p);
+    g_nFired++;
+}
+
+/*
+ * Run benchmark for a single timer queue
+ *
+ *      strName         backend name
+ *      pQueue          timer queue
+ *      nCount          timer count
+ */
+static void benchmarkTimerQueue(const char* strName, CTimerQueue* pQueue, size_t nCount)
+{
+    CBenchTimerLoop     loop;
+    CTimer**            arTimer;
+    hr_time_t           hrStart, hrProcess;
+    size_t              i;
+    char                strTmp[64];
+
+    loop.setTimerQueue(pQueue);
+    arTimer = (CTimer**)memAlloc(nCount*sizeof(CTimer*));
+    g_nFired = 0;
+
+    hrStart = hr_time_now();
+    for(i=0; i<nCount; i++)  {
+        arTimer[i] = new CTimer(randomTimeout(), timerHandler, "bench-timer");
+        loop.insertTimer(arTimer[i]);
+    }
+    _tsnprintf(strTmp, sizeof(strTmp), "%s: arm", strName);
+    benchmarkResult(strTmp, nCount, hr_time_now()-hrStart);
+
+    hrStart = hr_time_now();
+    for(i=0; i<nCount; i++)  {
+        loop.restartTimer(arTimer[i], randomTimeout());
+    }
+    _tsnprintf(strTmp, sizeof(strTmp), "%s: restart", strName);
+    benchmarkResult(strTmp, nCount, hr_time_now()-hrStart);
+
+    hrProcess = HR_0;
+    while ( g_nFired < nCount )  {
+        hrStart = hr_time_now();
+        loop.process();
+        hrProcess += hr_time_now()-hrStart;
+    }
+    _tsnprintf(strTmp, sizeof(strTmp), "%s: fire", strName);
+    benchmarkResult(strTmp, nCount, hrProcess);
+
+    memFree(arTimer);
+}
+
+void benchmarkTimer()
+{
+    benchmarkTimerQueue("list", new CTimerListQueue(), BENCH_TIMER_LIST_COUNT);
+    benchmarkTimerQueue("heap", new CTimerHeap(), BENCH_TIMER_COUNT);
+    benchmarkTimerQueue("wheel", new CTimerWheel(), BENCH_TIMER_COUNT);
+}
@@ -0,0 +1,109 @@
+/*
+ *	Carbon Framework Examples
+ *	VEP container benchmark
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 10:14:26
+ *	    Initial revision.
+ *
+ *	Build, clone and release the containers of many small telemetry
+ *	packets, print the time per container and the memory taken by a container.
+ */
+
+#include "carbon/memory.h"
+#include "vep/vep.h"
+
+#include "benchmark_app.h"
+
+#define BENCH_VEP_PACKETS			10000		/* Packets per container */
+#define BENCH_VEP_ROUNDS			50			/* Measured containers */
+
+typedef struct
+{
+	uint32_t	nSensor;
+	uint32_t	nTime;
+	int32_t		arValue[6];
+} __attribute__ ((packed)) bench_vep_record_t;
+
+static int64_t benchmarkVepAllocated(CMemoryManager& memoryManager)
+{
+	memory_stat_t	stat;
+
+	memoryManager.getStat(&stat, sizeof(stat));
+	return sh_atomic_get(&stat.alloc_size);
+}
+
+/*
+ * Create a container of BENCH_VEP_PACKETS packets
+ *
+ * Return: container or NULL
+ */
+static CVepContainer* benchmarkVepBuild()
+{
+	CVepContainer*		pContainer = new CVepContainer(VEP_CONTAINER_APP);
+	bench_vep_record_t	record;
+	size_t				i;
+	result_t			nresult = ESUCCESS;
+
+	_tbzero_object(record);
+
+	for(i=0; i<BENCH_VEP_PACKETS && nresult == ESUCCESS; i++)  {
+		record.nSensor = (uint32_t)i;
+		record.nTime = (uint32_t)(i*10);
+		record.arValue[0] = (int32_t)(i%100);
+		nresult = pContainer->insertPacket(1, &record, sizeof(record));
+	}
+
+	if ( nresult != ESUCCESS )  {
+		log_error(L_GEN, "failed to build a container, packet %u, result %d\n", i, nresult);
+		pContainer->release();
+		pContainer = NULL;
+	}
+
+	return pContainer;
+}
+
+void benchmarkVep()
+{
+	CMemoryManager			memoryManager;
+	CVepContainer			*pContainer, *pClone;
+	hr_time_t				hrStart, hrBuild = 0, hrClone = 0, hrRelease = 0;
+	int64_t					nBefore, nSize;
+	int						n;
+
+	nBefore = benchmarkVepAllocated(memoryManager);
+	pContainer = benchmarkVepBuild();
+	if ( !pContainer )  {
+		return;
+	}
+
+	nSize = benchmarkVepAllocated(memoryManager)-nBefore;
+	log_info(L_GEN, "container of %d packets (%u bytes of data): %lld bytes allocated\n",
+			 BENCH_VEP_PACKETS, (unsigned)(BENCH_VEP_PACKETS*(sizeof(bench_vep_record_t)+VEP_PACKET_HEAD_SZ)),
+			 (long long)nSize);
+	pContainer->release();
+
+	for(n=0; n<BENCH_VEP_ROUNDS; n++)  {
+		hrStart = hr_time_now();
+		pContainer = benchmarkVepBuild();
+		hrBuild += hr_time_get_elapsed(hrStart);
+
+		hrStart = hr_time_now();
+		pClone = dynamic_cast<CVepContainer*>(pContainer->clone());
+		hrClone += hr_time_get_elapsed(hrStart);
+
+		hrStart = hr_time_now();
+		pClone->release();
+		pContainer->release();
+		hrRelease += hr_time_get_elapsed(hrStart);
+	}
+
+	benchmarkResult("build 10k packet container", BENCH_VEP_ROUNDS, hrBuild);
+	benchmarkResult("clone 10k packet container", BENCH_VEP_ROUNDS, hrClone);
+	benchmarkResult("release 2x10k packet containers", BENCH_VEP_ROUNDS, hrRelease);
+}
@@ -0,0 +1,143 @@
+/*
+ *	Carbon Framework Examples
+ *	Performance benchmarks
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 11:04:12
+ *	    Initial revision.
+ *
+ *	Usage: benchmark [name ...]
+ *	    Runs all benchmarks if no name is specified.
+ */
+
+#include "benchmark_app.h"
+
+static const struct {
+    const char*     strName;
+    benchmark_t     benchmark;
+} g_arBenchmark[] = {
+    { "timer",      benchmarkTimer },
+    { "event",      benchmarkEvent },
+    { "queue",      benchmarkEventQueue },
+    { "alloc",      benchmarkAlloc },
+    { "malloc",     benchmarkMalloc },
+    { "netserv",    benchmarkNetServ },
+    { "http",       benchmarkHttp },
+    { "rtp",        benchmarkRtp },
+    { "json",       benchmarkJson },
+    { "h264",       benchmarkH264 },
+    { "crc16",      benchmarkCrc16 },
+    { "vep",        benchmarkVep },
+    { "db",         benchmarkDb },
+    { "logger",     benchmarkLogger }
+};
+
+/*
+ * Print a benchmark result line
+ *
+ *      strName         measured operation
+ *      nCount          operation count
+ *      hrElapsed       total time
+ */
+void benchmarkResult(const char* strName, uint64_t nCount, hr_time_t hrElapsed)
+{
+    double      fSec = (double)HR_TIME_TO_MICROSECONDS(hrElapsed)/1000000;
+
+    log_info(L_GEN, "%-40s %10llu ops %10.3f ms %12.0f ops/s\n",
+             strName, (unsigned long long)nCount, fSec*1000,
+             fSec > 0 ? (double)nCount/fSec : 0.0);
+}
+
+/*
+ * Application class constructor
+ *
+ *      argc        command line argument 'argc'
+ *      argv        command line argument 'argv'
+ */
+CBenchmarkApp::CBenchmarkApp(int argc, char* argv[]) :
+    CApplication("Benchmark Application", MAKE_VERSION(1,0,0), 1, argc, argv)
+{
+}
+
+/*
+ * Application class destructor
+ */
+CBenchmarkApp::~CBenchmarkApp()
+{
+}
+
+/*
+ * Run benchmarks specified by the command line
+ */
+void CBenchmarkApp::runBenchmarks()
+{
+    size_t      i;
+    int         j;
+    boolean_t   bRun;
+
+    for(i=0; i<ARRAY_SIZE(g_arBenchmark); i++)  {
+        bRun = m_argc < 2;
+        for(j=1; j<m_argc && !bRun; j++)  {
+            bRun = _tstrcmp(m_argv[j], g_arBenchmark[i].strName) == 0;
+        }
+
+        if ( bRun )  {
+            log_info(L_GEN, "*** Benchmark: %s ***\n", g_arBenchmark[i].strName);
+            g_arBenchmark[i].benchmark();
+        }
+    }
+}
+
+/*
+ * Application initialisation
+ *
+ * Return:
+ *      ESUCCESS        initalisation success
+ *      other code      initalisation failed, exit application
+ */
+result_t CBenchmarkApp::init()
+{
+    return CApplication::init();
+}
+
+/*
+ * Event processor, run benchmarks on the application start and exit
+ *
+ *      pEvent      event object to process
+ *
+ * Return:
+ *      TRUE        event processed
+ *      FALSE       event is not processed
+ */
+boolean_t CBenchmarkApp::processEvent(CEvent* pEvent)
+{
+    if ( pEvent->getType() == EV_START )  {
+        runBenchmarks();
+        stopApplication(0);
+        return TRUE;
+    }
+
+    return CApplication::processEvent(pEvent);
+}
+
+/*
+ * Application termination
+ */
+void CBenchmarkApp::terminate()
+{
+    CApplication::terminate();
+}
+
+/*
+ * Normal C/C++ entry point
+ */
+int main(int argc, char* argv[])
+{
+    CBenchmarkApp   app(argc, argv);
+    return app.run();
+}
@@ -0,0 +1,70 @@
+/*
+ *	Carbon Framework Examples
+ *	Performance benchmarks
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 11:03:40
+ *	    Initial revision.
+ */
+
+#ifndef __EXAMPLE_BENCHMARK_APP_H_INCLUDED__
+#define __EXAMPLE_BENCHMARK_APP_H_INCLUDED__
+
+#include "shell/hr_time.h"
+
+#include "carbon/carbon.h"
+#include "carbon/application.h"
+
+/*
+ * Benchmark entry point
+ */
+typedef void (*benchmark_t)();
+
+/*
+ * Available benchmarks
+ */
+extern void benchmarkTimer();
+extern void benchmarkEvent();
+extern void benchmarkEventQueue();
+extern void benchmarkAlloc();
+extern void benchmarkMalloc();
+extern void benchmarkNetServ();
+extern void benchmarkHttp();
+extern void benchmarkRtp();
+extern void benchmarkJson();
+extern void benchmarkH264();
+extern void benchmarkCrc16();
+extern void benchmarkVep();
+extern void benchmarkDb();
+extern void benchmarkLogger();
+
+/*
+ * Print a benchmark result line
+ *
+ *      strName         measured operation
+ *      nCount          operation count
+ *      hrElapsed       total time
+ */
+extern void benchmarkResult(const char* strName, uint64_t nCount, hr_time_t hrElapsed);
+
+class CBenchmarkApp : public CApplication
+{
+    public:
+        CBenchmarkApp(int argc, char* argv[]);
+        virtual ~CBenchmarkApp();
+
+    public:
+        virtual result_t init();
+        virtual void terminate();
+
+    private:
+        virtual boolean_t processEvent(CEvent* pEvent);
+        void runBenchmarks();
+};
+
+#endif /* __EXAMPLE_BENCHMARK_APP_H_INCLUDED__ */
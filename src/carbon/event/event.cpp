@@ -26,7 +26,8 @@
 CEventReceiver::CEventReceiver(CEventLoop* pOwnerLoop, const char* strName) :
 	CObject(strName),
 	CListItem(),
-	m_pEventLoop(pOwnerLoop)
+	m_pEventLoop(pOwnerLoop),
+	m_pHashNext(0)
 {
 	shell_assert(pOwnerLoop);
 	if ( m_pEventLoop ) {
@@ -37,7 +38,8 @@ CEventReceiver::CEventReceiver(CEventLoop* pOwnerLoop, const char* strName) :
 CEventReceiver::CEventReceiver(const char* strName) :
 	CObject(strName),
 	CListItem(),
-	m_pEventLoop(appMainLoop())
+	m_pEventLoop(appMainLoop()),
+	m_pHashNext(0)
 {
 	CEventLoop*		pLoop = appMainLoop();
 
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 11.06.2015 11:29:16
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 12:10:33
+ *      Added event loop receiver hash chain.
  */
 
 #ifndef __CARBON_EVENT_EVENT_H_INCLUDED__
@@ -40,9 +43,14 @@ class CEventLoop;
 
 class CEventReceiver : public CObject, public CListItem
 {
+	friend class CEventLoop;
+
     protected:
         CEventLoop*     m_pEventLoop;
 
+    private:
+        CEventReceiver* m_pHashNext;			/* Event loop receiver hash chain */
+
     public:
         CEventReceiver(CEventLoop* pOwnerLoop, const char* strName);
 		explicit CEventReceiver(const char* strName);
@@ -0,0 +1,81 @@
+/*
+ *  Carbon framework
+ *  Lock-free event queue
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 13:02:17
+ *      Initial revision.
+ */
+
+#ifndef __CARBON_EVENT_QUEUE_H_INCLUDED__
+#define __CARBON_EVENT_QUEUE_H_INCLUDED__
+
+#include "shell/config.h"
+#include "shell/types.h"
+
+#include "carbon/event/event.h"
+
+/*******************************************************************************
+ * Intrusive multi-producer/single-consumer event queue
+ *
+ * Producers push events to the lock-free stack linked by the CListItem
+ * next pointer, the consumer takes all pending events at once with a
+ * single atomic exchange and restores the send order.
+ */
+
+class CEventQueue
+{
+	private:
+		CEvent* volatile	m_pHead;			/* Last pushed event */
+
+	public:
+		CEventQueue() : m_pHead(0) {}
+		~CEventQueue() {}
+
+	public:
+		/*
+		 * Push an event (any thread)
+		 *
+		 * 		pEvent		event to push
+		 *
+		 * Return: TRUE if the queue was empty
+		 */
+		boolean_t push(CEvent* pEvent) {
+			CEvent*		pHead;
+
+			do {
+				pHead = m_pHead;
+				pEvent->setNext(pHead);
+			} while ( !__sync_bool_compare_and_swap(&m_pHead, pHead, pEvent) );
+
+			return pHead == 0;
+		}
+
+		/*
+		 * Take all pending events (consumer thread)
+		 *
+		 * Return: the first sent event linked by next() in the send order or 0
+		 */
+		CEvent* popAll() {
+			CEvent		*pEvent, *pNext, *pFirst = 0;
+
+			pEvent = __sync_lock_test_and_set(&m_pHead, (CEvent*)0);
+			while ( pEvent != 0 )  {
+				pNext = (CEvent*)pEvent->next();
+				pEvent->setNext(pFirst);
+				pFirst = pEvent;
+				pEvent = pNext;
+			}
+
+			return pFirst;
+		}
+
+		boolean_t isEmpty() const { return m_pHead == 0; }
+};
+
+#endif /* __CARBON_EVENT_QUEUE_H_INCLUDED__ */
@@ -13,8 +13,23 @@
  *
  *  Revision 1.1, 14.02.2017 13:12:12
  *  	Removed std library lists.
+ *
+ *  Revision 1.2, 17.10.2026 10:45:41
+ *  	Replaced sorted timer list with the pluggable timer queue.
+ *
+ *  Revision 1.3, 17.10.2026 12:14:02
+ *  	Direct dispatch of the unicast events.
+ *
+ *  Revision 1.4, 17.10.2026 13:06:22
+ *  	Lock-free event queue, the event loop is woken up only when sleeping.
+ *
+ *  Revision 1.5, 18.10.2026 05:12:40
+ *  	Sync operation table keyed by the session Id, any number of threads
+ *  	may wait for the replies through the same event loop.
  */
 
+#include "shell/memory.h"
+
 #include "carbon/logger.h"
 #include "carbon/sync.h"
 #include "carbon/event/eventloop.h"
@@ -27,10 +42,15 @@
 CEventLoop::CEventLoop(const char* strName) :
     CObject(strName),
 	m_bDone(FALSE),
+	m_pTimerQueue(new CTimerHeap()),
+	m_arReceiverHash(0),
+	m_nReceiverHashSize(0),
 	m_bIterate(FALSE),
-	m_pIterateNext(0),
-    m_pSync(0)
+	m_pIterateNext(0)
 {
+	sh_atomic_set(&m_waiting, 0);
+	sh_atomic_set(&m_nSync, 0);
+	_tbzero_object(m_arSync);
 }
 
 CEventLoop::~CEventLoop()
@@ -41,6 +61,8 @@ CEventLoop::~CEventLoop()
     checkTimerListEmpty();
     checkEventListEmpty();
 #endif /* DEBUG */
+    SAFE_DELETE(m_pTimerQueue);
+    SAFE_FREE(m_arReceiverHash);
 }
 
 /*
@@ -53,6 +75,7 @@ void CEventLoop::cleanup()
 
 	pReceiver = m_receiverList.getFirst();
     while ( pReceiver != 0 )  {
+		removeReceiverHash(pReceiver);
 		m_receiverList.remove(pReceiver);
 		pReceiver = m_receiverList.getFirst();
     }
@@ -70,25 +93,8 @@ void CEventLoop::cleanup()
 void CEventLoop::insertTimer(CTimer* pTimer)
 {
     CAutoLock       locker(m_cond);
-    hr_time_t       hrTime = pTimer->getTime();
-	CTimer*			pCurTimer;
-    boolean_t       bInserted = FALSE;
-
-	pCurTimer = m_timerList.getFirst();
-    while ( pCurTimer != 0 )  {
-        if ( hrTime < pCurTimer->getTime() )  {
-            m_timerList.insert_before(pCurTimer, pTimer);
-            bInserted = TRUE;
-            break;
-        }
-
-		pCurTimer = m_timerList.getNext(pCurTimer);
-    }
-
-    if ( !bInserted )  {
-        m_timerList.insert(pTimer);
-    }
 
+    m_pTimerQueue->insert(pTimer);
     locker.unlock();
 
     if ( logger_is_enabled(LT_TRACE|L_TIMER) )  {
@@ -115,19 +121,12 @@ void CEventLoop::insertTimer(CTimer* pTimer)
 void CEventLoop::restartTimer(CTimer* pTimer, hr_time_t hrNewPeriod)
 {
     CAutoLock   locker(m_cond);
-	CTimer*		pCurTimer;
-
-	pCurTimer = m_timerList.getFirst();
-    while ( pCurTimer != 0 )  {
-        if ( pCurTimer == pTimer )  {
-            m_timerList.remove(pTimer);
-            pTimer->restart(hrNewPeriod);
-            locker.unlock();
-            insertTimer(pTimer);
-            break;
-        }
 
-		pCurTimer = m_timerList.getNext(pCurTimer);
+    if ( m_pTimerQueue->isLinked(pTimer) )  {
+        m_pTimerQueue->remove(pTimer);
+        pTimer->restart(hrNewPeriod);
+        locker.unlock();
+        insertTimer(pTimer);
     }
 }
 
@@ -139,19 +138,12 @@ void CEventLoop::restartTimer(CTimer* pTimer, hr_time_t hrNewPeriod)
 void CEventLoop::pauseTimer(CTimer* pTimer)
 {
     CAutoLock   locker(m_cond);
-	CTimer*		pCurTimer;
-
-	pCurTimer = m_timerList.getFirst();
-    while ( pCurTimer != 0 )  {
-        if ( pCurTimer == pTimer )  {
-            m_timerList.remove(pTimer);
-            pTimer->pause();
-            locker.unlock();
-            insertTimer(pTimer);
-            break;
-        }
 
-		pCurTimer = m_timerList.getNext(pCurTimer);
+    if ( m_pTimerQueue->isLinked(pTimer) )  {
+        m_pTimerQueue->remove(pTimer);
+        pTimer->pause();
+        locker.unlock();
+        insertTimer(pTimer);
     }
 }
 
@@ -166,17 +158,10 @@ boolean_t CEventLoop::unlinkTimer(CTimer* pTimer)
 
     if ( pTimer )  {
         CAutoLock   locker(m_cond);
-		CTimer*		pCurTimer;
-
-		pCurTimer = m_timerList.getFirst();
-        while ( pCurTimer != 0 )  {
-            if ( pCurTimer == pTimer )  {
-                m_timerList.remove(pTimer);
-				bUnlinked = TRUE;
-                break;
-            }
 
-			pCurTimer = m_timerList.getNext(pCurTimer);
+        if ( m_pTimerQueue->isLinked(pTimer) )  {
+            m_pTimerQueue->remove(pTimer);
+            bUnlinked = TRUE;
         }
     }
 
@@ -205,14 +190,33 @@ void CEventLoop::deleteTimerAll()
     CAutoLock   locker(m_cond);
 	CTimer		*pTimer;
 
-	pTimer = m_timerList.getFirst();
-    while ( pTimer != 0 )  {
-		m_timerList.remove(pTimer);
+    while ( (pTimer=m_pTimerQueue->removeHead()) != 0 )  {
         delete pTimer;
-		pTimer = m_timerList.getFirst();
     }
 }
 
+/*
+ * Replace the timer queue of the event loop
+ *
+ *      pTimerQueue     new timer queue (the event loop takes ownership)
+ *
+ * Note: the timers are moved to the new queue, the old queue is deleted
+ */
+void CEventLoop::setTimerQueue(CTimerQueue* pTimerQueue)
+{
+    CAutoLock   locker(m_cond);
+    CTimer      *pTimer;
+
+    shell_assert(pTimerQueue != 0 && pTimerQueue->isEmpty());
+
+    while ( (pTimer=m_pTimerQueue->removeHead()) != 0 )  {
+        pTimerQueue->insert(pTimer);
+    }
+
+    delete m_pTimerQueue;
+    m_pTimerQueue = pTimerQueue;
+}
+
 /*
  * Pick up the next expired timer
  *
@@ -223,20 +227,8 @@ void CEventLoop::deleteTimerAll()
 CTimer* CEventLoop::getClosestTimer(hr_time_t hrTime)
 {
     CAutoLock   locker(m_cond);
-    CTimer*     pClosestTimer = 0, *pTimer;
-
-	pTimer = m_timerList.getFirst();
-    while ( pTimer != 0 )  {
-        if ( hrTime >= pTimer->getTime() )  {
-            m_timerList.remove(pTimer);
-            pClosestTimer = pTimer;
-            break;
-        }
-
-		pTimer = m_timerList.getNext(pTimer);
-    }
 
-    return pClosestTimer;
+    return m_pTimerQueue->getExpired(hrTime);
 }
 
 /*
@@ -275,26 +267,16 @@ void CEventLoop::processTimers()
  */
 void CEventLoop::sendEvent(CEvent* pEvent)
 {
-    CAutoLock   locker(m_cond);
-
 	if ( !m_bDone )  {
 		seqnum_t	sessId = pEvent->getSessId();
 
-		if ( sessId != NO_SEQNUM )  {
-			m_condSync.lock();
-			if ( m_pSync != 0 && m_pSync->getSessId() == sessId )  {
-				m_pSync->attachEvent(pEvent);
-				pEvent->release();
-				m_condSync.unlock();
-				m_condSync.wakeup();
+		/* Sync table is locked only while any sync operation is in progress */
+		if ( sessId != NO_SEQNUM && sh_atomic_get(&m_nSync) != 0 )  {
+			if ( attachSyncEvent(pEvent) )  {
 				return;
 			}
-			m_condSync.unlock();
 		}
 
-        m_eventList.insert(pEvent);
-        locker.unlock();
-
         if ( logger_is_enabled(LT_TRACE|L_EVENT) )  {
         	char			buffer[64];
         	CEventReceiver*	pReceiver = pEvent->getReceiver();
@@ -305,9 +287,12 @@ void CEventLoop::sendEvent(CEvent* pEvent)
                      pReceiver != EVENT_MULTICAST ? pReceiver->getName() :
                      "MULTICAST", buffer);
         }
-    
-        /* Wakeup an event loop */
-        notify();
+
+        /* The event may be processed and released since here */
+        if ( m_eventQueue.push(pEvent) )  {
+            /* Wakeup an event loop on the first pending event only */
+            notify();
+        }
     }
     else  {
         char	buffer[128];
@@ -332,44 +317,70 @@ void CEventLoop::sendEvent(CEvent* pEvent, CEventReceiver* pReceiver)
 }
 
 /*
- * Pick up a next event for the processing
- *
- *      hrTime      process events sent before
+ * Move all sent events to the event loop list
  *
- * Return: event pointer or 0
+ * Note: called by the event loop thread or with stopped event loop
  */
-CEvent* CEventLoop::getNextEvent(hr_time_t hrTime)
+void CEventLoop::takeEvents()
 {
-    CAutoLock   locker(m_cond);
-    CEvent*     pNextEvent = 0, *pEvent;
+    CEvent      *pEvent, *pNext;
 
-	pEvent = m_eventList.getFirst();
+    pEvent = m_eventQueue.popAll();
     while ( pEvent != 0 )  {
-        if ( hrTime > pEvent->getTime() )  {
-            m_eventList.remove(pEvent);
-            pNextEvent = pEvent;
-            break;
-        }
+        pNext = (CEvent*)pEvent->next();
+        m_eventList.insert(pEvent);
+        pEvent = pNext;
+    }
+}
 
-        pEvent = m_eventList.getNext(pEvent);
+/*
+ * Pick up a next taken event for the processing
+ *
+ * Return: event pointer or 0
+ */
+CEvent* CEventLoop::getNextEvent()
+{
+    CEvent*     pEvent;
+
+    pEvent = m_eventList.getFirst();
+    if ( pEvent != 0 )  {
+        m_eventList.remove(pEvent);
     }
 
-    return pNextEvent;
+    return pEvent;
 }
 
 /*
  * Process all events for the current event loop
+ *
+ * Events are taken as a single batch, the events sent while
+ * processing are left to the next iteration.
  */
 void CEventLoop::processEvents()
 {
     CEvent*     pEvent;
-    hr_time_t   hrProcessTime = hr_time_now();
 
-    while ( !m_bDone && (pEvent = getNextEvent(hrProcessTime)) != NULL )  {
+    takeEvents();
+
+    while ( !m_bDone && (pEvent = getNextEvent()) != NULL )  {
         CAutoLock   			locker(m_receiverList);
-        const CEventReceiver* 	pEventReceiver = pEvent->getReceiver();
+        CEventReceiver* 		pEventReceiver = pEvent->getReceiver();
 		CEventReceiver*			pReceiver;
 
+		if ( pEventReceiver != EVENT_MULTICAST )  {
+			/*
+			 * Unicast event, the receiver may have been
+			 * unregistered (or deleted) since the event was sent
+			 */
+			if ( findReceiver(pEventReceiver) )  {
+				locker.unlock();
+				pEventReceiver->processEvent(pEvent);
+			}
+
+			pEvent->release();
+			continue;
+		}
+
 		shell_assert(!m_bIterate);
 		m_bIterate = TRUE;
 		m_pIterateNext = m_receiverList.getFirst();
@@ -378,11 +389,9 @@ void CEventLoop::processEvents()
 			pReceiver = m_pIterateNext;
 			m_pIterateNext = m_receiverList.getNext(pReceiver);
 
-            if ( pReceiver == pEventReceiver || pEventReceiver == EVENT_MULTICAST )  {
-				locker.unlock();
-                pReceiver->processEvent(pEvent);
-				locker.lock();
-            }
+			locker.unlock();
+			pReceiver->processEvent(pEvent);
+			locker.lock();
         }
 
 		m_bIterate = FALSE;
@@ -399,6 +408,8 @@ void CEventLoop::deleteEventAll()
     CAutoLock   locker(m_cond);
     CEvent		*pEvent, *pTmpEvent;
 
+	takeEvents();
+
 	pEvent = m_eventList.getFirst();
     while ( pEvent != 0 )  {
 		pTmpEvent = pEvent;
@@ -420,6 +431,7 @@ void CEventLoop::registerReceiver(CEventReceiver* pReceiver)
 
     shell_assert(pReceiver != 0);
     m_receiverList.insert(pReceiver);
+    insertReceiverHash(pReceiver);
 }
 
 /*
@@ -434,11 +446,12 @@ void CEventLoop::unregisterReceiver(CEventReceiver* pReceiver)
 
     shell_assert(pReceiver != 0);
     
-    bFound = m_receiverList.find(pReceiver);
+    bFound = findReceiver(pReceiver);
     if ( bFound )  {
 		if ( m_bIterate && m_pIterateNext == pReceiver )  {
 			m_pIterateNext = m_receiverList.getNext(pReceiver);
 		}
+		removeReceiverHash(pReceiver);
 		m_receiverList.remove(pReceiver);
     }
     else  {
@@ -447,6 +460,116 @@ void CEventLoop::unregisterReceiver(CEventReceiver* pReceiver)
     }        
 }
 
+/*
+ * Check if the receiver is registered at the event loop
+ *
+ *      pReceiver       receiver object pointer (may be a deleted object)
+ *
+ * Return: TRUE if registered, FALSE otherwise
+ *
+ * Note: the receiver list lock must be held
+ */
+boolean_t CEventLoop::findReceiver(const CEventReceiver* pReceiver) const
+{
+    CEventReceiver*     pItem;
+
+    if ( m_arReceiverHash == 0 )  {
+        return FALSE;
+    }
+
+    /* Only registered (alive) receivers are dereferenced here */
+    pItem = m_arReceiverHash[getReceiverHash(pReceiver)];
+    while ( pItem != 0 && pItem != pReceiver )  {
+        pItem = pItem->m_pHashNext;
+    }
+
+    return pItem != 0;
+}
+
+/*
+ * Insert a receiver to the hash table, grow the table
+ * to keep chains short
+ *
+ *      pReceiver       receiver object pointer
+ *
+ * Note: the receiver list lock must be held
+ */
+void CEventLoop::insertReceiverHash(CEventReceiver* pReceiver)
+{
+    size_t      nHash;
+
+    if ( m_receiverList.getSize() > m_nReceiverHashSize )  {
+        resizeReceiverHash(sh_max(m_nReceiverHashSize*2, EVENT_LOOP_RECEIVER_HASH_MIN));
+    }
+
+    if ( m_arReceiverHash != 0 )  {
+        nHash = getReceiverHash(pReceiver);
+        pReceiver->m_pHashNext = m_arReceiverHash[nHash];
+        m_arReceiverHash[nHash] = pReceiver;
+    }
+}
+
+/*
+ * Remove a receiver from the hash table
+ *
+ *      pReceiver       registered receiver object pointer
+ *
+ * Note: the receiver list lock must be held
+ */
+void CEventLoop::removeReceiverHash(CEventReceiver* pReceiver)
+{
+    CEventReceiver**    ppItem;
+
+    if ( m_arReceiverHash == 0 )  {
+        return;
+    }
+
+    ppItem = &m_arReceiverHash[getReceiverHash(pReceiver)];
+    while ( *ppItem != 0 )  {
+        if ( *ppItem == pReceiver )  {
+            *ppItem = pReceiver->m_pHashNext;
+            pReceiver->m_pHashNext = 0;
+            break;
+        }
+        ppItem = &(*ppItem)->m_pHashNext;
+    }
+}
+
+/*
+ * Rebuild the hash table with a new size
+ *
+ *      nSize       new table size, power of 2
+ *
+ * Note: the receiver list lock must be held
+ */
+void CEventLoop::resizeReceiverHash(size_t nSize)
+{
+    CEventReceiver**    arHash;
+    CEventReceiver*     pReceiver;
+    size_t              nHash;
+
+    arHash = (CEventReceiver**)memAlloc(nSize*sizeof(CEventReceiver*));
+    if ( arHash == 0 )  {
+        log_error(L_GEN, "[eventloop(%s)] out of memory, receiver hash size %d\n",
+                  getName(), nSize);
+        shell_assert(m_arReceiverHash != 0);
+        return;
+    }
+
+    _tbzero(arHash, nSize*sizeof(CEventReceiver*));
+    SAFE_FREE(m_arReceiverHash);
+    m_arReceiverHash = arHash;
+    m_nReceiverHashSize = nSize;
+
+    pReceiver = m_receiverList.getFirst();
+    while ( pReceiver != 0 )  {
+        nHash = getReceiverHash(pReceiver);
+        pReceiver->m_pHashNext = m_arReceiverHash[nHash];
+        m_arReceiverHash[nHash] = pReceiver;
+        pReceiver = m_receiverList.getNext(pReceiver);
+    }
+}
+
 /*
  * Calculate sleep time for the event loop
  *
@@ -457,15 +580,15 @@ hr_time_t CEventLoop::getNextIterTime() const
     CTimer*     pTimer;
     hr_time_t   hrNextIterTime;
 
-    if ( !m_timerList.isEmpty() )  {
-        pTimer = m_timerList.getFirst();
+    pTimer = m_pTimerQueue->getClosest();
+    if ( pTimer != 0 )  {
         hrNextIterTime = pTimer->getTime();
     }
     else  {
         hrNextIterTime = hr_time_now() + EVENT_LOOP_ITERATION_TIMEOUT;
     }
 
-    if ( hr_time_now() >= hrNextIterTime || m_eventList.getSize() != 0 ) {
+    if ( hr_time_now() >= hrNextIterTime || !m_eventList.isEmpty() || !m_eventQueue.isEmpty() ) {
         hrNextIterTime = HR_0;
     }
 
@@ -487,7 +610,7 @@ void CEventLoop::runEventLoop()
             onIdle();
         }
         if ( (hrNextIterTime=getNextIterTime()) != 0 && !m_bDone ) {
-            m_cond.waitTimed(hrNextIterTime);
+            waitNotify(hrNextIterTime);
         }
 
         m_cond.unlock();
@@ -497,6 +620,26 @@ void CEventLoop::runEventLoop()
     //deleteEventAll();
 }
 
+/*
+ * Sleep until notified or the time has come
+ *
+ *      hrTime      time to stop waiting
+ *
+ * Note: m_cond must be held
+ */
+void CEventLoop::waitNotify(hr_time_t hrTime)
+{
+    /* Senders check the flag after queueing, the queue is checked after setting */
+    sh_atomic_set(&m_waiting, 1);
+    __sync_synchronize();
+
+    if ( m_eventQueue.isEmpty() )  {
+        m_cond.waitTimed(hrTime);
+    }
+
+    sh_atomic_set(&m_waiting, 0);
+}
+
 /*
  * Terminating the event loop
  */
@@ -513,51 +656,139 @@ void CEventLoop::stopEventLoop()
  */
 void CEventLoop::notify()
 {
-    m_cond.lock();
-    m_cond.wakeup();
-    m_cond.unlock();
+    __sync_synchronize();
+    if ( sh_atomic_get(&m_waiting) != 0 )  {
+        m_cond.lock();
+        m_cond.wakeup();
+        m_cond.unlock();
+    }
 }
 
+/*
+ * Register a sync operation, the reply event with the operation
+ * session Id will be passed to the operation instead of dispatching
+ *
+ * 		pSync			sync operation
+ *
+ * Note: must be called before sending the request
+ */
 void CEventLoop::attachSync(CSyncBase* pSync)
 {
-	m_condSync.lock();
+	CSyncBase**		ppSync;
+
+	m_lockSync.lock();
+
+	ppSync = &m_arSync[pSync->getSessId()&(EVENT_LOOP_SYNC_HASH_SIZE-1)];
+	pSync->m_pNext = *ppSync;
+	pSync->m_bReady = FALSE;
+	pSync->m_bCancel = FALSE;
+	*ppSync = pSync;
+	sh_atomic_inc(&m_nSync);
+
+	m_lockSync.unlock();
+}
+
+/*
+ * Unregister a sync operation
+ *
+ * 		pSync			sync operation
+ */
+void CEventLoop::detachSync(CSyncBase* pSync)
+{
+	CSyncBase**		ppSync;
+
+	m_lockSync.lock();
 
-	shell_assert(m_pSync == 0);
-	if ( m_pSync != 0 )  {
-		log_error(L_GEN, "[eventloop(%s)] m_pSync is not 0 !!!\n", getName());
+	ppSync = &m_arSync[pSync->getSessId()&(EVENT_LOOP_SYNC_HASH_SIZE-1)];
+	while ( *ppSync != 0 && *ppSync != pSync )  {
+		ppSync = &(*ppSync)->m_pNext;
 	}
 
-	m_pSync = pSync;
-	/* log_debug(L_GEN, "[eventloop(%s)] ATTACHED Sync Object %p\n", getName(), pSync); */
+	if ( *ppSync != 0 )  {
+		*ppSync = pSync->m_pNext;
+		pSync->m_pNext = 0;
+		sh_atomic_dec(&m_nSync);
+	}
+	else {
+		log_error(L_GEN, "[eventloop(%s)] sync %u is not attached\n", getName(), pSync->getSessId());
+	}
 
-	/* Leave sync locked ! */
+	m_lockSync.unlock();
 }
 
-void CEventLoop::detachSync()
+/*
+ * Pass the event to the sync operation awaiting it
+ *
+ * 		pEvent			event to pass
+ *
+ * Return: TRUE if the event has been taken by a sync operation
+ */
+boolean_t CEventLoop::attachSyncEvent(CEvent* pEvent)
 {
-	/* The sync lock must be held */
-	if ( m_pSync == 0 )  {
-		log_error(L_GEN, "[eventloop(%s)] sync has gone away\n", getName());
+	seqnum_t		sessId = pEvent->getSessId();
+	CSyncBase*		pSync;
+
+	m_lockSync.lock();
+
+	pSync = m_arSync[sessId&(EVENT_LOOP_SYNC_HASH_SIZE-1)];
+	while ( pSync != 0 && pSync->getSessId() != sessId )  {
+		pSync = pSync->m_pNext;
+	}
+
+	if ( pSync != 0 )  {
+		/* Wake up under the table lock, the operation can't be detached meanwhile */
+		pSync->m_cond.lock();
+		pSync->attachEvent(pEvent);
+		pSync->m_bReady = TRUE;
+		pSync->m_cond.wakeup();
+		pSync->m_cond.unlock();
+	}
+
+	m_lockSync.unlock();
+
+	if ( pSync != 0 )  {
+		pEvent->release();
 	}
 
-	/* log_debug(L_GEN, "[eventloop(%s)] DETTACHED Sync Object %p\n", getName(), m_pSync); */
+	return pSync != 0;
+}
+
+/*
+ * Wake up all sync operations in progress, the operations fail with EBADE
+ */
+void CEventLoop::cancelSync()
+{
+	CSyncBase*		pSync;
+	size_t			i;
+
+	m_lockSync.lock();
+
+	for(i=0; i<EVENT_LOOP_SYNC_HASH_SIZE; i++)  {
+		pSync = m_arSync[i];
+		while ( pSync != 0 )  {
+			pSync->m_cond.lock();
+			pSync->m_bCancel = TRUE;
+			pSync->m_cond.wakeup();
+			pSync->m_cond.unlock();
+			pSync = pSync->m_pNext;
+		}
+	}
 
-	m_pSync = 0;
-	m_condSync.unlock();
+	m_lockSync.unlock();
 }
 
 /*
  * Waiting to execute sync function
  *
+ * 		pSync				attached sync operation
  * 		hrTimeout			maximum time to wait
  *
- * Return: ESUCCESS, ETIMEDOUT, EFAULT, EBADE
- *
- * Note: Sync lock must be held
+ * Return: ESUCCESS, ETIMEDOUT, EBADE, ...
  */
-result_t CEventLoop::waitSync(hr_time_t hrTimeout)
+result_t CEventLoop::waitSync(CSyncBase* pSync, hr_time_t hrTimeout)
 {
-    result_t    nresult;
+	hr_time_t	hrTime;
+	result_t	nresult;
 
 	if ( m_bDone )  {
 		/* Event loop is shutting down */
@@ -565,21 +796,26 @@ result_t CEventLoop::waitSync(hr_time_t hrTimeout)
 		return ETIMEDOUT;
 	}
 
-	shell_assert(m_pSync);
-    if ( !m_pSync )  {
-        log_error(L_GEN, "[eventloop(%s)] sync is not attached\n", getName());
-        return EFAULT;
-    }
+	hrTime = hr_time_now() + hrTimeout;
 
-	m_condSync.waitTimed(hr_time_now()+hrTimeout);
+	/* The late replies are attached under the lock, process the reply under the lock */
+	pSync->m_cond.lock();
+	while ( !pSync->m_bReady && !pSync->m_bCancel )  {
+		if ( pSync->m_cond.waitTimed(hrTime) == ETIMEDOUT )  {
+			break;
+		}
+	}
 
-    if ( !m_pSync )  {
-        log_error(L_GEN, "[eventloop(%s)] sync has gone away\n", getName());
-        return EBADE;
-    }
+	if ( pSync->m_bReady || !pSync->m_bCancel )  {
+		nresult = pSync->processSyncEvent();
+	}
+	else {
+		log_error(L_GEN, "[eventloop(%s)] sync has gone away\n", getName());
+		nresult = EBADE;
+	}
+	pSync->m_cond.unlock();
 
-    nresult = m_pSync->processSyncEvent();
-    return nresult;
+	return nresult;
 }
 
 /*
@@ -624,7 +860,7 @@ void CEventLoop::printTime(hr_time_t hrTime, char* strBuffer, size_t length) con
 void CEventLoop::checkTimerListEmpty()
 {
     CAutoLock   locker(m_cond);
-    int			n = m_timerList.getSize();
+    int			n = (int)m_pTimerQueue->getSize();
 
     if ( n > 0 )  {
 		log_dump("*** TimerList is not empty: (count=%d) ***\n", n);
@@ -643,6 +879,8 @@ void CEventLoop::checkEventListEmpty()
     int			n = 0;
     char		buffer[128];
 
+	takeEvents();
+
 	pEvent = m_eventList.getFirst();
     while ( pEvent != 0 )  {
     	if ( n++ == 0 )  {
@@ -668,13 +906,13 @@ void CEventLoop::dumpTimers(const char* strPref)
 	CTimer*		pTimer;
 
 	if ( strPref )  {
-		log_dump("*** Timer list (%d) ***\n", m_timerList.getSize());
+		log_dump("*** Timer list (%d) ***\n", m_pTimerQueue->getSize());
 	}
 
-	pTimer = m_timerList.getFirst();
+	pTimer = m_pTimerQueue->getHead();
 	while ( pTimer != 0 )  {
 		log_dump("--- Timer: %s\n", pTimer->getName());
-		pTimer = m_timerList.getNext(pTimer);
+		pTimer = m_pTimerQueue->getNext(pTimer);
 	}
 }
 
@@ -760,13 +998,7 @@ result_t CEventLoopThread::start()
 void CEventLoopThread::stop()
 {
 	stopEventLoop();
-
-	m_condSync.lock();
-	if ( m_pSync != 0 ) {
-		m_condSync.wakeup();
-		m_pSync = 0;
-	}
-	m_condSync.unlock();
+	cancelSync();
 
 	m_thEventLoop.stop();
 
@@ -13,6 +13,15 @@
  *
  *  Revision 1.1, 14.02.2017 13:12:54
  *  	Removed std library lists.
+ *
+ *  Revision 1.2, 17.10.2026 10:45:18
+ *  	Replaced sorted timer list with the pluggable timer queue.
+ *
+ *  Revision 1.3, 17.10.2026 13:05:48
+ *  	Lock-free event queue.
+ *
+ *  Revision 1.4, 18.10.2026 05:12:40
+ *  	Sync operation table, concurrent sync operations.
  */
 
 #ifndef __CARBON_EVENTLOOP_H_INCLUDED__
@@ -20,14 +29,19 @@
 
 #include "shell/config.h"
 #include "shell/object.h"
+#include "shell/atomic.h"
 
 #include "carbon/thread.h"
 #include "carbon/lock.h"
 #include "carbon/event.h"
 #include "carbon/timer.h"
 #include "carbon/utils.h"
+#include "carbon/event/timer_queue.h"
+#include "carbon/event/event_queue.h"
 
 #define EVENT_LOOP_ITERATION_TIMEOUT    HR_1MIN
+#define EVENT_LOOP_RECEIVER_HASH_MIN	64
+#define EVENT_LOOP_SYNC_HASH_SIZE		16			/* Sync table size, power of 2 */
 
 /******************************************************************************
  * Event loop class
@@ -40,17 +54,22 @@ class CEventLoop : public CObject
     protected:
         boolean_t           		m_bDone;                /* Global EXIT flag */
         CCondition          		m_cond;					/* Idle sleeping on variable */
+        atomic_t					m_waiting;				/* Event loop sleeps on m_cond */
 
-        CLockedList<CEvent>			m_eventList;			/* Event queue */
-        CLockedList<CTimer>			m_timerList;			/* Timer sorted queue */
+        CEventQueue					m_eventQueue;			/* Sent events, lock-free */
+        CLockedList<CEvent>			m_eventList;			/* Taken events, event loop thread only */
+        CTimerQueue*				m_pTimerQueue;			/* Timer queue */
 		CLockedList<CEventReceiver>	m_receiverList;			/* Registered event receivers */
+		CEventReceiver**			m_arReceiverHash;		/* Registered receivers hash table */
+		size_t						m_nReceiverHashSize;	/* Hash table size, power of 2 */
 
 		boolean_t					m_bIterate;				/* Access under m_receiverList lock */
 		CEventReceiver*				m_pIterateNext;			/* Access under m_receiverList lock */
 
 		/* Synchronous execution support */
-		CCondition					m_condSync;				/* Sync execution awaiting result on variable */
-		CSyncBase*					m_pSync;				/* Sync operation in progress */
+		CMutex						m_lockSync;				/* Sync table lock */
+		CSyncBase*					m_arSync[EVENT_LOOP_SYNC_HASH_SIZE];	/* Sync operations by session Id */
+		atomic_t					m_nSync;				/* Sync operations in progress */
         
     public:
         CEventLoop(const char* strName);
@@ -66,6 +85,7 @@ class CEventLoop : public CObject
         boolean_t unlinkTimer(CTimer* pTimer);
         void deleteTimer(CTimer* pTimer);
         void deleteTimerAll();
+        void setTimerQueue(CTimerQueue* pTimerQueue);
 
 		virtual void dispatchEvents() {
 			processTimers();
@@ -80,23 +100,38 @@ class CEventLoop : public CObject
         virtual void stopEventLoop();
 
 		void attachSync(CSyncBase* pSync);
-		void detachSync();
-		result_t waitSync(hr_time_t hrTimeout);
+		void detachSync(CSyncBase* pSync);
+		result_t waitSync(CSyncBase* pSync, hr_time_t hrTimeout);
 
     protected:
         CTimer* getClosestTimer(hr_time_t hrTime);
         virtual void processTimers();
 
-        CEvent* getNextEvent(hr_time_t hrTime);
+        void takeEvents();
+        CEvent* getNextEvent();
         virtual void processEvents();
 
 		hr_time_t getNextIterTime() const;
+		void waitNotify(hr_time_t hrTime);
+		void cancelSync();
 
         /* Optional IDLE handler. WARNING: run under lock */
         virtual void onIdle() {}
 
     private:
         void cleanup();
+
+		size_t getReceiverHash(const CEventReceiver* pReceiver) const {
+			return (size_t)((((uintptr_t)pReceiver)>>4)*2654435761U) & (m_nReceiverHashSize-1);
+		}
+
+		boolean_t findReceiver(const CEventReceiver* pReceiver) const;
+		void insertReceiverHash(CEventReceiver* pReceiver);
+		void removeReceiverHash(CEventReceiver* pReceiver);
+		void resizeReceiverHash(size_t nSize);
+
+		boolean_t attachSyncEvent(CEvent* pEvent);
+
         void printTime(hr_time_t hrTime, char* strBuffer, size_t length) const;
 
 #if CARBON_DEBUG_DUMP
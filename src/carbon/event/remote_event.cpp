@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 01.08.2016 17:53:40
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 03:41:27
+ *      Added getHead().
  */
 
 #include "carbon/memory.h"
@@ -35,22 +38,32 @@ void CRemoteEvent::setData(const void* pData, size_t size)
 	}
 }
 
+/*
+ * Make the network packet header of the event
+ *
+ * 		pHead		OUT: packet header, followed by getData()/getDataSize() payload
+ */
+void CRemoteEvent::getHead(remote_event_head_t* pHead) const
+{
+	_tbzero(pHead, sizeof(*pHead));
+	pHead->ident = REMOTE_EVENT_IDENT;
+	pHead->length = sizeof(*pHead)+m_size;
+	pHead->type = getType();
+	pHead->pparam = (uint64_t)getpParam();
+	pHead->nparam = (uint64_t)getnParam();
+	pHead->sessId = getSessId();
+	pHead->receiver = (uint64_t)getReceiver();
+	pHead->reply_receiver = (uint64_t)getReplyReceiver();
+	copyString(pHead->reply_rid, getReplyRid(), sizeof(pHead->reply_rid));
+}
+
 result_t CRemoteEvent::send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr)
 {
 	remote_event_head_t		head;
 	hr_time_t				hrNow;
 	result_t				nresult;
 
-	_tbzero_object(head);
-	head.ident = REMOTE_EVENT_IDENT;
-	head.length = sizeof(head)+m_size;
-	head.type = getType();
-	head.pparam = (uint64_t)getpParam();
-	head.nparam = (uint64_t)getnParam();
-	head.sessId = getSessId();
-	head.receiver = (uint64_t)getReceiver();
-	head.reply_receiver = (uint64_t)getReplyReceiver();
-	copyString(head.reply_rid, getReplyRid(), sizeof(head.reply_rid));
+	getHead(&head);
 
 	hrNow = hr_time_now();
 	nresult = socket.send(&head, sizeof(head), hrTimeout, dstAddr);
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 01.08.2016 11:47:14
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 03:41:27
+ *      Added getHead() for the batched channel writes.
  */
 
 #ifndef __CARBON_EVENT_REMOTE_EVENT_H_INCLUDED__
@@ -106,6 +109,7 @@ class CRemoteEvent : public CEvent
 		const void* getData() const { return m_pData; }
 		size_t getDataSize() const { return m_size; }
 
+		void getHead(remote_event_head_t* pHead) const;
 		result_t send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr = NETADDR_NULL);
 		result_t receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr* pSrcAddr = NULL);
 
@@ -0,0 +1,350 @@
+/*
+ *  Carbon framework
+ *  Remote events persistent peer channel
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 03:41:27
+ *      Initial revision.
+ */
+
+#include <poll.h>
+#include <sys/uio.h>
+
+#include "carbon/carbon.h"
+#include "carbon/logger.h"
+#include "carbon/event/remote_event_channel.h"
+
+/*******************************************************************************
+ * Class CRemoteEventChannel
+ */
+
+/*
+ * Channel constructor
+ *
+ * 		strRid			peer remote Id
+ * 		strSocket		peer local socket path
+ */
+CRemoteEventChannel::CRemoteEventChannel(const char* strRid, const char* strSocket) :
+	m_strRid(strRid),
+	m_strSocket(strSocket),
+	m_hrLastIo(HR_0),
+	m_bStop(FALSE),
+	m_thWriter("remote_channel")
+{
+	counter_reset_struct(m_stat);
+}
+
+CRemoteEventChannel::~CRemoteEventChannel()
+{
+	shell_assert(!m_thWriter.isRunning());
+	shell_assert(m_arQueue.empty());
+}
+
+/*
+ * Start the channel writer
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRemoteEventChannel::start()
+{
+	result_t	nresult;
+
+	m_bStop = FALSE;
+	nresult = m_thWriter.start(THREAD_CALLBACK(CRemoteEventChannel::thread, this));
+	if ( nresult != ESUCCESS )  {
+		log_error(L_GEN, "[remote_channel] failed to start channel to '%s', result: %d\n",
+				  m_strRid.cs(), nresult);
+	}
+
+	return nresult;
+}
+
+/*
+ * Write the queued events and stop the channel writer
+ */
+void CRemoteEventChannel::stop()
+{
+	std::vector<remote_event_item_t>	arQueue;
+
+	m_cond.lock();
+	m_bStop = TRUE;
+	m_cond.wakeup();
+	m_cond.unlock();
+
+	m_thWriter.stop();
+
+	/* Events are left if the writer has not been started */
+	m_cond.lock();
+	arQueue.swap(m_arQueue);
+	m_cond.unlock();
+
+	if ( !arQueue.empty() )  {
+		notify(&arQueue[0], arQueue.size(), ECANCELED);
+	}
+}
+
+/*
+ * Queue an event to send
+ *
+ * 		pEvent			event to send (referenced by the channel)
+ * 		pReceiver		EV_NETCONN_SENT notification receiver (may be 0)
+ * 		sessId			notification session Id
+ * 		hrTimeout		maximum time to wait for the queue room
+ *
+ * Return:
+ * 		ESUCCESS		event is queued
+ * 		ENOBUFS			queue is full
+ * 		ECANCELED		channel is stopping
+ */
+result_t CRemoteEventChannel::send(CRemoteEvent* pEvent, CEventReceiver* pReceiver, seqnum_t sessId,
+								   hr_time_t hrTimeout)
+{
+	remote_event_item_t		item;
+	hr_time_t				hrStart = hr_time_now(), hrRest;
+	result_t				nresult = ESUCCESS;
+
+	m_cond.lock();
+
+	if ( m_arQueue.size() >= REMOTE_EVENT_CHANNEL_QUEUE_MAX && !m_bStop )  {
+		counter_inc(m_stat.wait);
+		while ( m_arQueue.size() >= REMOTE_EVENT_CHANNEL_QUEUE_MAX && !m_bStop )  {
+			hrRest = hr_timeout(hrStart, hrTimeout);
+			if ( hrRest == HR_0 )  {
+				nresult = ENOBUFS;
+				break;
+			}
+			m_cond.waitTimed(hr_time_now()+hrRest);
+		}
+	}
+
+	if ( m_bStop )  {
+		nresult = ECANCELED;
+	}
+
+	if ( nresult == ESUCCESS )  {
+		item.pEvent = pEvent;
+		item.pReceiver = pReceiver;
+		item.sessId = sessId;
+
+		pEvent->reference();
+		m_arQueue.push_back(item);
+		if ( m_arQueue.size() == 1 )  {
+			m_cond.wakeup();
+		}
+	}
+
+	m_cond.unlock();
+
+	if ( nresult != ESUCCESS )  {
+		log_debug(L_GEN, "[remote_channel] failed to queue event %d to '%s', result: %d\n",
+				  pEvent->getType(), m_strRid.cs(), nresult);
+		counter_inc(m_stat.fail);
+	}
+
+	return nresult;
+}
+
+/*
+ * Connect to the peer
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRemoteEventChannel::connect()
+{
+	result_t	nresult;
+
+	nresult = m_socket.connect(m_strSocket, REMOTE_EVENT_CHANNEL_CONNECT_TIMEOUT, SOCKET_TYPE_STREAM);
+	if ( nresult == ESUCCESS )  {
+		counter_inc(m_stat.connect);
+	}
+	else {
+		log_debug(L_GEN, "[remote_channel] failed to connect to '%s', result: %d\n",
+				  m_strSocket.cs(), nresult);
+	}
+
+	return nresult;
+}
+
+/*
+ * Check the connection is not closed by the peer
+ *
+ * Return: TRUE if the connection may be used
+ *
+ * Note: the peer never writes to the channel, any input means EOF or an error.
+ */
+boolean_t CRemoteEventChannel::isAlive() const
+{
+	struct pollfd	pfd;
+
+	pfd.fd = m_socket.getHandle();
+	pfd.events = POLLIN|POLLPRI;
+	pfd.revents = 0;
+
+	return ::poll(&pfd, 1, 0) == 0;
+}
+
+/*
+ * Write the events by a single socket write
+ *
+ * 		arItem		events to write
+ * 		count		event count, up to REMOTE_EVENT_CHANNEL_BATCH_MAX
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRemoteEventChannel::write(const remote_event_item_t* arItem, size_t count)
+{
+	remote_event_head_t		arHead[REMOTE_EVENT_CHANNEL_BATCH_MAX];
+	struct iovec			arIov[REMOTE_EVENT_CHANNEL_BATCH_MAX*2];
+	size_t					i, nIov = 0;
+	result_t				nresult;
+
+	shell_assert(count <= REMOTE_EVENT_CHANNEL_BATCH_MAX);
+
+	if ( m_socket.isOpen() && !isAlive() )  {
+		log_debug(L_GEN, "[remote_channel] connection to '%s' is closed by the peer\n",
+				  m_strRid.cs());
+		m_socket.close();
+	}
+
+	if ( !m_socket.isOpen() )  {
+		nresult = connect();
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+	for(i=0; i<count; i++)  {
+		CRemoteEvent*	pEvent = arItem[i].pEvent;
+
+		pEvent->getHead(&arHead[i]);
+		arIov[nIov].iov_base = &arHead[i];
+		arIov[nIov].iov_len = sizeof(arHead[i]);
+		nIov++;
+
+		if ( pEvent->getDataSize() > 0 )  {
+			arIov[nIov].iov_base = (void*)pEvent->getData();
+			arIov[nIov].iov_len = pEvent->getDataSize();
+			nIov++;
+		}
+	}
+
+	nresult = m_socket.sendv(arIov, nIov, REMOTE_EVENT_CHANNEL_SEND_TIMEOUT);
+	if ( nresult == ESUCCESS )  {
+		m_hrLastIo = hr_time_now();
+		counter_inc(m_stat.write);
+	}
+	else {
+		log_debug(L_GEN, "[remote_channel] failed to write %u event(s) to '%s', result: %d\n",
+				  (unsigned)count, m_strRid.cs(), nresult);
+		m_socket.close();
+	}
+
+	return nresult;
+}
+
+/*
+ * Notify the senders and release the events
+ *
+ * 		arItem		written events
+ * 		count		event count
+ * 		nresult		write result
+ */
+void CRemoteEventChannel::notify(const remote_event_item_t* arItem, size_t count, result_t nresult)
+{
+	CEvent*		pEvent;
+	char		strTmp[32];
+	size_t		i;
+
+	for(i=0; i<count; i++)  {
+		if ( arItem[i].pReceiver )  {
+			_tsnprintf(strTmp, sizeof(strTmp), "sess=%u, nresult=%d", arItem[i].sessId, nresult);
+			pEvent = new CEvent(EV_NETCONN_SENT, arItem[i].pReceiver, NULL, (NPARAM)nresult, strTmp);
+			pEvent->setSessId(arItem[i].sessId);
+			appSendEvent(pEvent);
+		}
+
+		arItem[i].pEvent->release();
+	}
+
+	if ( nresult == ESUCCESS )  {
+		counter_add(m_stat.event, count);
+	}
+	else {
+		counter_add(m_stat.fail, count);
+	}
+}
+
+/*
+ * Channel writer thread
+ */
+void* CRemoteEventChannel::thread(CThread* pThread, void* pData)
+{
+	std::vector<remote_event_item_t>	arBatch;
+	hr_time_t							hrIdle;
+	size_t								i, count;
+	boolean_t							bStop = FALSE;
+	result_t							nresult;
+
+	shell_unused(pData);
+	pThread->bootCompleted(ESUCCESS);
+
+	while ( !bStop )  {
+		m_cond.lock();
+		while ( m_arQueue.empty() && !m_bStop )  {
+			if ( m_socket.isOpen() )  {
+				hrIdle = hr_timeout(m_hrLastIo, REMOTE_EVENT_CHANNEL_IDLE_TIMEOUT);
+				if ( hrIdle == HR_0 )  {
+					m_socket.close();
+					continue;
+				}
+				m_cond.waitTimed(hr_time_now()+hrIdle);
+			}
+			else {
+				m_cond.wait();
+			}
+		}
+
+		/* Take all queued events, the senders waiting for the room may continue */
+		arBatch.swap(m_arQueue);
+		bStop = m_bStop;
+		m_cond.wakeup();
+		m_cond.unlock();
+
+		for(i=0; i<arBatch.size(); i+=count)  {
+			count = sh_min(arBatch.size()-i, (size_t)REMOTE_EVENT_CHANNEL_BATCH_MAX);
+			nresult = write(&arBatch[i], count);
+			notify(&arBatch[i], count, nresult);
+		}
+		arBatch.clear();
+	}
+
+	m_socket.close();
+	return NULL;
+}
+
+/*******************************************************************************
+ * Debugging support
+ */
+
+#if CARBON_DEBUG_DUMP
+
+void CRemoteEventChannel::dump(const char* strPref) const
+{
+	size_t	count;
+
+	m_cond.lock();
+	count = m_arQueue.size();
+	m_cond.unlock();
+
+	log_dump("%sChannel to '%s': queued %u, sent %u, writes %u, connects %u, waits %u, fails %u\n",
+			 strPref, m_strRid.cs(), (unsigned)count, counter_get(m_stat.event),
+			 counter_get(m_stat.write), counter_get(m_stat.connect), counter_get(m_stat.wait),
+			 counter_get(m_stat.fail));
+}
+
+#endif /* CARBON_DEBUG_DUMP */
@@ -0,0 +1,116 @@
+/*
+ *  Carbon framework
+ *  Remote events persistent peer channel
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 03:41:27
+ *      Initial revision.
+ */
+/*
+ * Purpose:
+ *      One persistent stream connection to a peer remote event service.
+ *      The events are queued by the callers and written by the channel
+ *      thread, all events queued since the previous write are coalesced
+ *      into a single writev(). The peer receives the events in the queue
+ *      order and sends the replies (matched by the session Id) through
+ *      its own channel to this service.
+ *
+ *      The queue length is limited: a caller waits for a free room up to
+ *      the send timeout (backpressure) and fails with ENOBUFS.
+ *
+ *      The connection is closed after REMOTE_EVENT_CHANNEL_IDLE_TIMEOUT
+ *      of inactivity, which is shorter than the peer keep-alive timeout.
+ */
+
+#ifndef __CARBON_EVENT_REMOTE_EVENT_CHANNEL_H_INCLUDED__
+#define __CARBON_EVENT_REMOTE_EVENT_CHANNEL_H_INCLUDED__
+
+#include <vector>
+
+#include "shell/config.h"
+#include "shell/socket.h"
+#include "shell/counter.h"
+
+#include "carbon/thread.h"
+#include "carbon/lock.h"
+#include "carbon/cstring.h"
+#include "carbon/event/remote_event.h"
+
+#define REMOTE_EVENT_CHANNEL_QUEUE_MAX			4096		/* Maximum queued events */
+#define REMOTE_EVENT_CHANNEL_BATCH_MAX			256			/* Maximum events per write */
+#define REMOTE_EVENT_CHANNEL_IDLE_TIMEOUT		HR_4SEC
+#define REMOTE_EVENT_CHANNEL_SEND_TIMEOUT		HR_4SEC
+#define REMOTE_EVENT_CHANNEL_CONNECT_TIMEOUT	HR_4SEC
+
+/*
+ * Queued event
+ */
+typedef struct
+{
+	CRemoteEvent*		pEvent;			/* Event to send */
+	CEventReceiver*		pReceiver;		/* EV_NETCONN_SENT receiver (may be 0) */
+	seqnum_t			sessId;			/* EV_NETCONN_SENT session Id */
+} remote_event_item_t;
+
+/*
+ * Channel statistic data
+ */
+typedef struct
+{
+	counter_t	event;				/* Sent events */
+	counter_t	write;				/* Socket writes */
+	counter_t	connect;			/* Connections */
+	counter_t	wait;				/* Caller waits for the queue room */
+	counter_t	fail;				/* Failed events */
+} __attribute__ ((packed)) remote_channel_stat_t;
+
+class CRemoteEventChannel
+{
+	protected:
+		CString								m_strRid;		/* Peer remote Id */
+		CString								m_strSocket;	/* Peer local socket */
+
+		CSocket								m_socket;		/* Peer connection */
+		hr_time_t							m_hrLastIo;		/* Last write time */
+
+		std::vector<remote_event_item_t>	m_arQueue;		/* Queued events */
+		mutable CCondition					m_cond;			/* Queue lock/condition */
+		boolean_t							m_bStop;		/* TRUE: stop the channel */
+		CThread								m_thWriter;		/* Writer thread */
+
+		remote_channel_stat_t				m_stat;			/* Channel statistic */
+
+	public:
+		CRemoteEventChannel(const char* strRid, const char* strSocket);
+		virtual ~CRemoteEventChannel();
+
+	public:
+		const char* getRid() const { return m_strRid; }
+
+		result_t start();
+		void stop();
+
+		result_t send(CRemoteEvent* pEvent, CEventReceiver* pReceiver, seqnum_t sessId,
+					  hr_time_t hrTimeout = REMOTE_EVENT_CHANNEL_SEND_TIMEOUT);
+
+		const remote_channel_stat_t* getStat() const { return &m_stat; }
+
+	private:
+		void* thread(CThread* pThread, void* pData);
+		result_t connect();
+		boolean_t isAlive() const;
+		result_t write(const remote_event_item_t* arItem, size_t count);
+		void notify(const remote_event_item_t* arItem, size_t count, result_t nresult);
+
+#if CARBON_DEBUG_DUMP
+	public:
+		virtual void dump(const char* strPref = "") const;
+#endif /* CARBON_DEBUG_DUMP */
+};
+
+#endif /* __CARBON_EVENT_REMOTE_EVENT_CHANNEL_H_INCLUDED__ */
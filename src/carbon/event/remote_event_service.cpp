@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 03.08.2016 14:39:18
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 03:41:27
+ *      Send events through the persistent per-peer channels.
  */
 
 #include "shell/shell.h"
@@ -35,7 +38,8 @@ CRemoteEventService::CRemoteEventService(const char* strSelfRid, CEventReceiver*
 	CModule(MODULE_NAME),
 	m_pParent(pParent),
 	m_pNetConnector(nullptr),
-	m_strSelfRid(strSelfRid)
+	m_strSelfRid(strSelfRid),
+	m_bActive(FALSE)
 {
 	dec_ptr<CRemoteEvent>	pEvent = new CRemoteEvent;
 	m_pNetConnector = new CTcpConnector(new CRemoteEventContainer(pEvent),
@@ -44,6 +48,7 @@ CRemoteEventService::CRemoteEventService(const char* strSelfRid, CEventReceiver*
 
 CRemoteEventService::~CRemoteEventService()
 {
+	stopChannels();
 	SAFE_DELETE(m_pNetConnector);
 }
 
@@ -79,18 +84,93 @@ result_t CRemoteEventService::preparePath()
 
 }
 
-result_t CRemoteEventService::sendEvent(CRemoteEvent* pEvent, const char* strDestRid,
-								CEventReceiver* pReceiver, seqnum_t nSessId)
+/*
+ * Find or create the channel to the peer
+ *
+ * 		strDestRid		peer remote Id
+ *
+ * Return: started channel or 0
+ */
+CRemoteEventChannel* CRemoteEventService::getChannel(const char* strDestRid)
 {
-	dec_ptr<CRemoteEventContainer>	pContainer = new CRemoteEventContainer(pEvent);
-	CString							strSocket;
-	result_t						nresult;
+	CRemoteEventChannel*	pChannel = 0;
+	CString					strSocket;
+	size_t					i;
+
+	CAutoLock	locker(m_lock);
+
+	if ( !m_bActive )  {
+		return 0;
+	}
+
+	for(i=0; i<m_arChannel.size(); i++)  {
+		if ( _tstrcmp(m_arChannel[i]->getRid(), strDestRid) == 0 )  {
+			return m_arChannel[i];
+		}
+	}
 
 	strSocket = REMOTE_EVENT_ROOT_PATH;
 	strSocket.appendPath(strDestRid);
 
+	pChannel = new CRemoteEventChannel(strDestRid, strSocket);
+	if ( pChannel->start() == ESUCCESS )  {
+		m_arChannel.push_back(pChannel);
+	}
+	else {
+		SAFE_DELETE(pChannel);
+	}
+
+	return pChannel;
+}
+
+/*
+ * Stop and delete all peer channels
+ */
+void CRemoteEventService::stopChannels()
+{
+	std::vector<CRemoteEventChannel*>	arChannel;
+	size_t								i;
+
+	m_lock.lock();
+	m_bActive = FALSE;
+	arChannel.swap(m_arChannel);
+	m_lock.unlock();
+
+	for(i=0; i<arChannel.size(); i++)  {
+		arChannel[i]->stop();
+		delete arChannel[i];
+	}
+}
+
+/*
+ * Send an event to the remote service
+ *
+ * 		pEvent			event to send (released by the function)
+ * 		strDestRid		destination service remote Id
+ * 		pReceiver		EV_NETCONN_SENT notification receiver (may be 0)
+ * 		nSessId			notification session Id
+ *
+ * Return: ESUCCESS, ENOBUFS, ...
+ *
+ * Note: the event is queued to the peer channel, the caller is blocked
+ * 		 while the channel queue is full.
+ */
+result_t CRemoteEventService::sendEvent(CRemoteEvent* pEvent, const char* strDestRid,
+								CEventReceiver* pReceiver, seqnum_t nSessId)
+{
+	CRemoteEventChannel*	pChannel;
+	result_t				nresult;
+
 	pEvent->setReplyRid(m_strSelfRid);
-	nresult = m_pNetConnector->send(pContainer, strSocket, pReceiver, nSessId);
+
+	pChannel = getChannel(strDestRid);
+	if ( pChannel )  {
+		nresult = pChannel->send(pEvent, pReceiver, nSessId);
+	}
+	else {
+		log_error(L_GEN, "[remote_service] no channel to '%s'\n", strDestRid);
+		nresult = ENOENT;
+	}
 
 	pEvent->release();
 	return nresult;
@@ -159,8 +239,13 @@ result_t CRemoteEventService::init()
 	if ( nresult != ESUCCESS )  {
 		m_pNetConnector->terminate();
 		CModule::terminate();
+		return nresult;
 	}
 
+	m_lock.lock();
+	m_bActive = TRUE;
+	m_lock.unlock();
+
 	return nresult;
 }
 
@@ -169,6 +254,7 @@ result_t CRemoteEventService::init()
  */
 void CRemoteEventService::terminate()
 {
+	stopChannels();
 	m_pNetConnector->terminate();
 	CModule::terminate();
 	CFile::removeFile(m_strSocket);
@@ -182,7 +268,15 @@ void CRemoteEventService::terminate()
 
 void CRemoteEventService::dump(const char* strPref) const
 {
-	shell_unused(strPref);
+	size_t	i;
+
+	CAutoLock	locker(m_lock);
+
+	log_dump("%sRemote event service '%s': %u channel(s)\n", strPref,
+			 m_strSelfRid.cs(), (unsigned)m_arChannel.size());
+	for(i=0; i<m_arChannel.size(); i++)  {
+		m_arChannel[i]->dump("    ");
+	}
 }
 
 #endif /* CARBON_DEBUG_DUMP */
@@ -10,15 +10,22 @@
  *
  *  Revision 1.0, 03.08.2016 14:39:18
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 03:41:27
+ *      Send events through the persistent per-peer channels.
  */
 
 #ifndef __CARBON_EVENT_REMOTE_EVENT_SERVICE_H_INCLUDED__
 #define __CARBON_EVENT_REMOTE_EVENT_SERVICE_H_INCLUDED__
 
+#include <vector>
+
 #include "shell/config.h"
 
 #include "carbon/module.h"
+#include "carbon/lock.h"
 #include "carbon/event/remote_event.h"
+#include "carbon/event/remote_event_channel.h"
 #include "carbon/cstring.h"
 #include "carbon/net_connector/tcp_connector.h"
 
@@ -39,6 +46,10 @@ class CRemoteEventService : public CModule
 		CString				m_strSelfRid;		/* Service remote id */
 		CString				m_strSocket;		/* Local socket filename */
 
+		std::vector<CRemoteEventChannel*>	m_arChannel;	/* Peer channels */
+		mutable CMutex		m_lock;				/* m_arChannel lock */
+		boolean_t			m_bActive;			/* TRUE: service is initialised */
+
 	public:
 		CRemoteEventService(const char* strSelfRid, CEventReceiver* pParent);
 		virtual ~CRemoteEventService();
@@ -52,6 +63,8 @@ class CRemoteEventService : public CModule
 
 	private:
 		result_t preparePath();
+		CRemoteEventChannel* getChannel(const char* strDestRid);
+		void stopChannels();
 
 #if CARBON_DEBUG_DUMP
 	public:
@@ -35,7 +35,9 @@ CTimer::CTimer(hr_time_t hrPeriod, timer_cb_t callback, int options, void* pPara
 	m_hrPeriod(hrPeriod),
 	m_callback(callback),
 	m_options(options),
-	m_pParam(pParam)
+	m_pParam(pParam),
+	m_pTimerQueue(0),
+	m_nTimerSlot(0)
 {
 	restart();
 }
@@ -55,7 +57,9 @@ CTimer::CTimer(hr_time_t hrPeriod, timer_cb_t callback, int options, const char*
 	m_hrPeriod(hrPeriod),
 	m_callback(callback),
 	m_options(options),
-	m_pParam(NULL)
+	m_pParam(NULL),
+	m_pTimerQueue(0),
+	m_nTimerSlot(0)
 {
 	restart();
 }
@@ -67,7 +71,9 @@ CTimer::CTimer(hr_time_t hrPeriod, timer_cb_t callback, void* pParam, const char
 	m_hrPeriod(hrPeriod),
 	m_callback(callback),
 	m_options(0),
-	m_pParam(pParam)
+	m_pParam(pParam),
+	m_pTimerQueue(0),
+	m_nTimerSlot(0)
 {
 	restart();
 }
@@ -86,7 +92,9 @@ CTimer::CTimer(hr_time_t hrPeriod, timer_cb_t callback, const char* strName) :
 	m_hrPeriod(hrPeriod),
 	m_callback(callback),
 	m_options(0),
-	m_pParam(NULL)
+	m_pParam(NULL),
+	m_pTimerQueue(0),
+	m_nTimerSlot(0)
 {
 	restart();
 }
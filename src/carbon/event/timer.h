@@ -13,6 +13,9 @@
  *
  *  Revision 2.0, 18.07.2015 22:44:51
  *  	Completely rewrite to use non-static callbacks.
+ *
+ *  Revision 2.1, 17.10.2026 10:20:12
+ *  	Added timer queue position.
  */
 
 #ifndef __CARBON_EVENT_TIMER_H_INCLUDED__
@@ -38,8 +41,12 @@ typedef std::function<void(void*)> timer_cb_t;
 #define __CTimer_PARENT
 #endif /* CARBON_DEBUG_TRACK_OBJECT */
 
+class CTimerQueue;
+
 class CTimer : public CObject, public CListItem __CTimer_PARENT
 {
+	friend class CTimerQueue;
+
     public:
         enum {
             timerPeriodic = 0x1
@@ -52,6 +59,10 @@ class CTimer : public CObject, public CListItem __CTimer_PARENT
         int                 m_options;              /* Timer options, timerXXX */
         void*               m_pParam;           	/* Timer parameter */
 
+    private:
+        CTimerQueue*        m_pTimerQueue;          /* Owner timer queue or 0 */
+        size_t              m_nTimerSlot;           /* Position in the owner queue */
+
     public:
         CTimer(hr_time_t hrPeriod, timer_cb_t callback, int options, void* pParam, const char* strName);
         CTimer(hr_time_t hrPeriod, timer_cb_t callback, int options, const char* strName);
@@ -0,0 +1,439 @@
+/*
+ *  Carbon framework
+ *  Event loop timer queues
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 10:13:05
+ *      Initial revision.
+ */
+
+#include "shell/memory.h"
+
+#include "carbon/logger.h"
+#include "carbon/event/timer_queue.h"
+
+#define TIMER_HEAP_STEP			64
+
+/*******************************************************************************
+ * CTimerHeap class
+ */
+
+CTimerHeap::CTimerHeap() :
+	CTimerQueue(),
+	m_arTimer(0),
+	m_nCount(0),
+	m_nAlloc(0)
+{
+}
+
+CTimerHeap::~CTimerHeap()
+{
+	shell_assert(m_nCount == 0);
+	SAFE_FREE(m_arTimer);
+}
+
+/*
+ * Move timer up to the heap root while it fires earlier than the parent
+ *
+ * 		nSlot		timer position
+ */
+void CTimerHeap::siftUp(size_t nSlot)
+{
+	CTimer*		pTimer = m_arTimer[nSlot];
+	hr_time_t	hrTime = pTimer->getTime();
+	size_t		nParent;
+
+	while ( nSlot > 0 )  {
+		nParent = (nSlot-1)/2;
+		if ( hrTime >= m_arTimer[nParent]->getTime() )  {
+			break;
+		}
+
+		place(m_arTimer[nParent], nSlot);
+		nSlot = nParent;
+	}
+
+	place(pTimer, nSlot);
+}
+
+/*
+ * Move timer down to the heap leaves while any child fires earlier
+ *
+ * 		nSlot		timer position
+ */
+void CTimerHeap::siftDown(size_t nSlot)
+{
+	CTimer*		pTimer = m_arTimer[nSlot];
+	hr_time_t	hrTime = pTimer->getTime();
+	size_t		nChild;
+
+	while ( (nChild=nSlot*2+1) < m_nCount )  {
+		if ( (nChild+1) < m_nCount &&
+				m_arTimer[nChild+1]->getTime() < m_arTimer[nChild]->getTime() )  {
+			nChild++;
+		}
+
+		if ( hrTime <= m_arTimer[nChild]->getTime() )  {
+			break;
+		}
+
+		place(m_arTimer[nChild], nSlot);
+		nSlot = nChild;
+	}
+
+	place(pTimer, nSlot);
+}
+
+/*
+ * Insert a timer to the heap
+ *
+ * 		pTimer		timer to insert (must not be linked)
+ */
+void CTimerHeap::insert(CTimer* pTimer)
+{
+	shell_assert(getOwner(pTimer) == 0);
+
+	if ( m_nCount >= m_nAlloc )  {
+		size_t		nAlloc = m_nAlloc != 0 ? m_nAlloc*2 : TIMER_HEAP_STEP;
+		CTimer**	arTimer;
+
+		arTimer = (CTimer**)memRealloc(m_arTimer, nAlloc*sizeof(CTimer*));
+		if ( arTimer == 0 )  {
+			log_error(L_GEN, "[timer_heap] out of memory, %d timers\n", nAlloc);
+			shell_assert(FALSE);
+			return;
+		}
+
+		m_arTimer = arTimer;
+		m_nAlloc = nAlloc;
+	}
+
+	link(pTimer, this, m_nCount);
+	m_arTimer[m_nCount] = pTimer;
+	m_nCount++;
+	siftUp(m_nCount-1);
+}
+
+/*
+ * Remove a timer from the heap
+ *
+ * 		pTimer		linked timer to remove
+ */
+void CTimerHeap::remove(CTimer* pTimer)
+{
+	size_t		nSlot = getSlot(pTimer);
+	CTimer*		pLast;
+
+	shell_assert(isLinked(pTimer));
+	shell_assert(nSlot < m_nCount && m_arTimer[nSlot] == pTimer);
+
+	unlink(pTimer);
+	m_nCount--;
+
+	if ( nSlot != m_nCount )  {
+		pLast = m_arTimer[m_nCount];
+		place(pLast, nSlot);
+
+		if ( nSlot > 0 && pLast->getTime() < m_arTimer[(nSlot-1)/2]->getTime() )  {
+			siftUp(nSlot);
+		}
+		else {
+			siftDown(nSlot);
+		}
+	}
+}
+
+/*
+ * Unlink the earliest timer if it is expired
+ *
+ * 		hrTime		current time
+ *
+ * Return: expired timer or 0
+ */
+CTimer* CTimerHeap::getExpired(hr_time_t hrTime)
+{
+	CTimer*		pTimer = getClosest();
+
+	if ( pTimer != 0 && hrTime >= pTimer->getTime() )  {
+		remove(pTimer);
+		return pTimer;
+	}
+
+	return 0;
+}
+
+/*
+ * Unlink the last heap timer, the heap stays consistent without sifting
+ *
+ * Return: timer or 0
+ */
+CTimer* CTimerHeap::removeHead()
+{
+	CTimer*		pTimer = 0;
+
+	if ( m_nCount != 0 )  {
+		m_nCount--;
+		pTimer = m_arTimer[m_nCount];
+		unlink(pTimer);
+	}
+
+	return pTimer;
+}
+
+/*******************************************************************************
+ * CTimerWheel class
+ */
+
+CTimerWheel::CTimerWheel(hr_time_t hrResolution, size_t nSlots) :
+	CTimerQueue(),
+	m_arSlot(0),
+	m_nSlots(1),
+	m_hrResolution(hrResolution > 0 ? hrResolution : TIMER_WHEEL_RESOLUTION),
+	m_nTick(0),
+	m_nCount(0),
+	m_nHeadSlot(0),
+	m_pClosest(0)
+{
+	/* Round slot count up to the power of 2 */
+	while ( m_nSlots < nSlots )  {
+		m_nSlots <<= 1;
+	}
+
+	m_arSlot = (CTimer**)memAlloc(m_nSlots*sizeof(CTimer*));
+	shell_assert(m_arSlot);
+	_tbzero(m_arSlot, m_nSlots*sizeof(CTimer*));
+
+	m_nTick = getTick(hr_time_now());
+}
+
+CTimerWheel::~CTimerWheel()
+{
+	shell_assert(m_nCount == 0);
+	SAFE_FREE(m_arSlot);
+}
+
+/*
+ * Insert a timer to the wheel
+ *
+ * 		pTimer		timer to insert (must not be linked)
+ *
+ * Note: an already expired timer is placed to the current slot
+ */
+void CTimerWheel::insert(CTimer* pTimer)
+{
+	uint64_t	nTick = getTick(pTimer->getTime());
+	size_t		nSlot;
+	CTimer*		pHead;
+
+	shell_assert(getOwner(pTimer) == 0);
+
+	if ( m_nCount == 0 )  {
+		/* Idle wheel, move cursor to the current time */
+		m_nTick = getTick(hr_time_now());
+	}
+
+	nSlot = (size_t)(sh_max(nTick, m_nTick) & (m_nSlots-1));
+	pHead = m_arSlot[nSlot];
+
+	pTimer->setPrev(0);
+	pTimer->setNext(pHead);
+	if ( pHead )  {
+		pHead->setPrev(pTimer);
+	}
+	m_arSlot[nSlot] = pTimer;
+
+	link(pTimer, this, nSlot);
+	m_nCount++;
+
+	if ( m_pClosest != 0 && pTimer->getTime() < m_pClosest->getTime() )  {
+		m_pClosest = pTimer;
+	}
+}
+
+/*
+ * Unlink a timer from the slot list
+ *
+ * 		pTimer		linked timer
+ */
+void CTimerWheel::unlinkSlot(CTimer* pTimer)
+{
+	CTimer*		pPrev = (CTimer*)pTimer->prev();
+	CTimer*		pNext = (CTimer*)pTimer->next();
+
+	if ( pPrev )  {
+		pPrev->setNext(pNext);
+	}
+	else {
+		m_arSlot[getSlot(pTimer)] = pNext;
+	}
+
+	if ( pNext )  {
+		pNext->setPrev(pPrev);
+	}
+
+	pTimer->setNext(0);
+	pTimer->setPrev(0);
+	unlink(pTimer);
+	m_nCount--;
+
+	if ( m_pClosest == pTimer )  {
+		m_pClosest = 0;
+	}
+}
+
+/*
+ * Remove a timer from the wheel
+ *
+ * 		pTimer		linked timer to remove
+ */
+void CTimerWheel::remove(CTimer* pTimer)
+{
+	shell_assert(isLinked(pTimer));
+	unlinkSlot(pTimer);
+}
+
+/*
+ * Find the earliest timer
+ *
+ * Scan slots starting at the cursor, the first slot containing
+ * timers of the current wheel turn holds the closest timer.
+ * The result is cached until the timer is unlinked.
+ *
+ * Return: closest timer or 0
+ */
+CTimer* CTimerWheel::getClosest() const
+{
+	CTimer		*pTimer, *pClosest = 0;
+	uint64_t	nTick;
+	size_t		i;
+
+	if ( m_pClosest != 0 || m_nCount == 0 )  {
+		return m_pClosest;
+	}
+
+	for(i=0; i<m_nSlots && pClosest == 0; i++)  {
+		nTick = m_nTick+i;
+		pTimer = getSlotHead((size_t)(nTick & (m_nSlots-1)));
+
+		while ( pTimer != 0 )  {
+			if ( getTick(pTimer->getTime()) <= nTick )  {
+				if ( pClosest == 0 || pTimer->getTime() < pClosest->getTime() )  {
+					pClosest = pTimer;
+				}
+			}
+			pTimer = getSlotNext(pTimer);
+		}
+	}
+
+	if ( pClosest == 0 )  {
+		/* All timers are beyond the current turn */
+		pTimer = getHead();
+		while ( pTimer != 0 )  {
+			if ( pClosest == 0 || pTimer->getTime() < pClosest->getTime() )  {
+				pClosest = pTimer;
+			}
+			pTimer = getNext(pTimer);
+		}
+	}
+
+	m_pClosest = pClosest;
+	return pClosest;
+}
+
+/*
+ * Advance the wheel cursor and unlink an expired timer
+ *
+ * 		hrTime		current time
+ *
+ * Return: expired timer or 0
+ */
+CTimer* CTimerWheel::getExpired(hr_time_t hrTime)
+{
+	uint64_t	nNowTick = getTick(hrTime);
+	CTimer*		pTimer;
+
+	if ( m_nCount == 0 )  {
+		m_nTick = sh_max(m_nTick, nNowTick);
+		return 0;
+	}
+
+	if ( nNowTick > m_nTick && (nNowTick-m_nTick) >= m_nSlots )  {
+		/* A full wheel turn has passed, every slot must be checked once */
+		m_nTick = nNowTick-m_nSlots+1;
+	}
+
+	while ( m_nTick <= nNowTick )  {
+		pTimer = getSlotHead((size_t)(m_nTick & (m_nSlots-1)));
+		while ( pTimer != 0 )  {
+			if ( hrTime >= pTimer->getTime() )  {
+				unlinkSlot(pTimer);
+				return pTimer;
+			}
+			pTimer = getSlotNext(pTimer);
+		}
+
+		if ( m_nTick == nNowTick )  {
+			break;
+		}
+		m_nTick++;
+	}
+
+	return 0;
+}
+
+/*
+ * Enumerate wheel timers
+ */
+CTimer* CTimerWheel::getHead() const
+{
+	size_t	i;
+
+	for(i=0; i<m_nSlots; i++)  {
+		if ( m_arSlot[i] != 0 )  {
+			return m_arSlot[i];
+		}
+	}
+
+	return 0;
+}
+
+CTimer* CTimerWheel::getNext(CTimer* pTimer) const
+{
+	CTimer*		pNext = getSlotNext(pTimer);
+	size_t		i;
+
+	if ( pNext == 0 )  {
+		for(i=getSlot(pTimer)+1; i<m_nSlots && pNext == 0; i++)  {
+			pNext = m_arSlot[i];
+		}
+	}
+
+	return pNext;
+}
+
+/*
+ * Unlink a first found timer
+ *
+ * Return: timer or 0
+ */
+CTimer* CTimerWheel::removeHead()
+{
+	CTimer*		pTimer = 0;
+	size_t		i;
+
+	for(i=0; i<m_nSlots && m_nCount != 0; i++)  {
+		pTimer = m_arSlot[(m_nHeadSlot+i) & (m_nSlots-1)];
+		if ( pTimer != 0 )  {
+			m_nHeadSlot = getSlot(pTimer);
+			unlinkSlot(pTimer);
+			break;
+		}
+	}
+
+	return pTimer;
+}
@@ -0,0 +1,179 @@
+/*
+ *  Carbon framework
+ *  Event loop timer queues
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 10:12:40
+ *      Initial revision.
+ */
+
+#ifndef __CARBON_EVENT_TIMER_QUEUE_H_INCLUDED__
+#define __CARBON_EVENT_TIMER_QUEUE_H_INCLUDED__
+
+#include "shell/config.h"
+#include "shell/types.h"
+#include "shell/hr_time.h"
+
+#include "carbon/event/timer.h"
+
+/*
+ * Timer wheel defaults
+ */
+#define TIMER_WHEEL_RESOLUTION		HR_10MSEC
+#define TIMER_WHEEL_SLOTS			4096
+
+/*******************************************************************************
+ * Timer queue base class
+ *
+ * The queue keeps timers of a single event loop, all functions
+ * must be called under the event loop lock.
+ */
+
+class CTimerQueue
+{
+	public:
+		CTimerQueue() {}
+		virtual ~CTimerQueue() {}
+
+	public:
+		virtual void insert(CTimer* pTimer) = 0;
+		virtual void remove(CTimer* pTimer) = 0;
+
+		/* Closest to fire timer or 0 */
+		virtual CTimer* getClosest() const = 0;
+		/* Unlink any timer expired at the hrTime or return 0 */
+		virtual CTimer* getExpired(hr_time_t hrTime) = 0;
+
+		/* Enumerate timers in the unspecified order */
+		virtual CTimer* getHead() const = 0;
+		virtual CTimer* getNext(CTimer* pTimer) const = 0;
+		/* Unlink any timer (cheapest to remove) or return 0 */
+		virtual CTimer* removeHead() = 0;
+
+		virtual size_t getSize() const = 0;
+		boolean_t isEmpty() const { return getSize() == 0; }
+
+		boolean_t isLinked(const CTimer* pTimer) const {
+			return pTimer->m_pTimerQueue == this;
+		}
+
+	protected:
+		static void link(CTimer* pTimer, CTimerQueue* pQueue, size_t nSlot) {
+			pTimer->m_pTimerQueue = pQueue;
+			pTimer->m_nTimerSlot = nSlot;
+		}
+
+		static CTimerQueue* getOwner(const CTimer* pTimer) {
+			return pTimer->m_pTimerQueue;
+		}
+
+		static void unlink(CTimer* pTimer) {
+			pTimer->m_pTimerQueue = 0;
+		}
+
+		static size_t getSlot(const CTimer* pTimer) { return pTimer->m_nTimerSlot; }
+		static void setSlot(CTimer* pTimer, size_t nSlot) { pTimer->m_nTimerSlot = nSlot; }
+};
+
+/*******************************************************************************
+ * Indexed binary min-heap
+ *
+ * Insert/remove/restart: O(log n), closest timer: O(1)
+ */
+
+class CTimerHeap : public CTimerQueue
+{
+	protected:
+		CTimer**		m_arTimer;				/* Heap array */
+		size_t			m_nCount;				/* Timers in the heap */
+		size_t			m_nAlloc;				/* Allocated array items */
+
+	public:
+		CTimerHeap();
+		virtual ~CTimerHeap();
+
+	public:
+		virtual void insert(CTimer* pTimer);
+		virtual void remove(CTimer* pTimer);
+
+		virtual CTimer* getClosest() const {
+			return m_nCount != 0 ? m_arTimer[0] : 0;
+		}
+
+		virtual CTimer* getExpired(hr_time_t hrTime);
+
+		virtual CTimer* getHead() const { return getClosest(); }
+		virtual CTimer* getNext(CTimer* pTimer) const {
+			size_t	nSlot = getSlot(pTimer)+1;
+			return nSlot < m_nCount ? m_arTimer[nSlot] : 0;
+		}
+		virtual CTimer* removeHead();
+
+		virtual size_t getSize() const { return m_nCount; }
+
+	private:
+		void place(CTimer* pTimer, size_t nSlot) {
+			m_arTimer[nSlot] = pTimer;
+			setSlot(pTimer, nSlot);
+		}
+
+		void siftUp(size_t nSlot);
+		void siftDown(size_t nSlot);
+};
+
+/*******************************************************************************
+ * Hashed timing wheel
+ *
+ * Insert/remove/restart: O(1), expired timers are collected
+ * slot by slot while the wheel cursor advances with the time.
+ * The wheel fits better for a large number of timers which are
+ * mostly restarted or cancelled before expiration (I/O timeouts).
+ */
+
+class CTimerWheel : public CTimerQueue
+{
+	protected:
+		CTimer**		m_arSlot;				/* Slots (unsorted timer lists) */
+		size_t			m_nSlots;				/* Slot count, power of 2 */
+		hr_time_t		m_hrResolution;			/* Time covered by a single slot */
+		uint64_t		m_nTick;				/* Current wheel cursor (tick) */
+		size_t			m_nCount;				/* Timers in the wheel */
+		size_t			m_nHeadSlot;			/* Last slot unlinked by removeHead() */
+
+		mutable CTimer*	m_pClosest;				/* Cached closest timer */
+
+	public:
+		CTimerWheel(hr_time_t hrResolution = TIMER_WHEEL_RESOLUTION,
+					size_t nSlots = TIMER_WHEEL_SLOTS);
+		virtual ~CTimerWheel();
+
+	public:
+		virtual void insert(CTimer* pTimer);
+		virtual void remove(CTimer* pTimer);
+
+		virtual CTimer* getClosest() const;
+		virtual CTimer* getExpired(hr_time_t hrTime);
+
+		virtual CTimer* getHead() const;
+		virtual CTimer* getNext(CTimer* pTimer) const;
+		virtual CTimer* removeHead();
+
+		virtual size_t getSize() const { return m_nCount; }
+
+	private:
+		uint64_t getTick(hr_time_t hrTime) const {
+			return hrTime > 0 ? (uint64_t)(hrTime/m_hrResolution) : 0;
+		}
+
+		CTimer* getSlotHead(size_t nSlot) const { return m_arSlot[nSlot]; }
+		CTimer* getSlotNext(CTimer* pTimer) const { return (CTimer*)pTimer->next(); }
+
+		void unlinkSlot(CTimer* pTimer);
+};
+
+#endif /* __CARBON_EVENT_TIMER_QUEUE_H_INCLUDED__ */
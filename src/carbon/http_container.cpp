@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 29.09.2016 16:42:07
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 18:59:12
+ *      Replaced serialise() by the scatter/gather send, added asynchronous send.
  */
 
 #include <stdexcept>
@@ -347,61 +350,45 @@ CNetContainer* CHttpContainer::clone()
 	return (CNetContainer*)(CHttpContainer*)pContainer;
 }
 
-result_t CHttpContainer::serialise(char** ppBuffer, size_t* pSize)
+/*
+ * Get the container fragments for the scatter/gather send
+ *
+ * 		arVec			fragments [out]
+ * 		pCount			IN: maximum fragments, OUT: fragment count
+ *
+ * Return: ESUCCESS, ENOSPC
+ */
+result_t CHttpContainer::getSendIov(struct iovec* arVec, size_t* pCount)
 {
-	char*		pBuffer;
-	size_t		fullSize, len;
-	result_t	nresult = ESUCCESS;
-
-	fullSize = m_strStart.size() + HTTP_EOL_LEN + m_strHeader.size() +
-				HTTP_EOL_LEN + m_nCurSize;
-	pBuffer = (char*)memAlloc(fullSize);
-	if ( pBuffer != 0 )  {
-		len = m_strStart.size();
-		UNALIGNED_MEMCPY(pBuffer, m_strStart.cs(), len);
-
-		UNALIGNED_MEMCPY(&pBuffer[len], HTTP_EOL, HTTP_EOL_LEN);
-		len += HTTP_EOL_LEN;
-
-		UNALIGNED_MEMCPY(&pBuffer[len], m_strHeader.cs(), m_strHeader.size());
-		len += m_strHeader.size();
-
-		UNALIGNED_MEMCPY(&pBuffer[len], HTTP_EOL, HTTP_EOL_LEN);
-		len += HTTP_EOL_LEN;
-
-		UNALIGNED_MEMCPY(&pBuffer[len], m_pBody, m_nCurSize);
-
-		*ppBuffer = pBuffer;
-		*pSize = fullSize;
-	}
-	else {
-		log_error(L_GEN, "[http_cont] out of memory allocating %d bytes\n", fullSize);
-		nresult = ENOMEM;
+	if ( *pCount < 5 )  {
+		*pCount = 0;
+		return ENOSPC;
 	}
 
-	return nresult;
+	arVec[0].iov_base = (void*)m_strStart.cs();
+	arVec[0].iov_len = m_strStart.size();
+	arVec[1].iov_base = (void*)HTTP_EOL;
+	arVec[1].iov_len = HTTP_EOL_LEN;
+	arVec[2].iov_base = (void*)m_strHeader.cs();
+	arVec[2].iov_len = m_strHeader.size();
+	arVec[3].iov_base = (void*)HTTP_EOL;
+	arVec[3].iov_len = HTTP_EOL_LEN;
+	arVec[4].iov_base = m_pBody;
+	arVec[4].iov_len = m_nCurSize;
+
+	*pCount = 5;
+	return ESUCCESS;
 }
 
 /*
- * Send a container
+ * Check the start line and update Content-Length header before sending
  *
- * 		socket			open socket object
- * 		hrTimeout		maximum send time
- * 		dstAddr			destination address (for sendto())
- * 		pOffset			send offset [in/out]
- *
- * 	Return:
- * 		ESUCCESS	all data have been sent
- * 		EINTR		sending was interrupted by signal
- * 		...
+ * Return: ESUCCESS, EINVAL
  */
-result_t CHttpContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr)
+result_t CHttpContainer::prepareSend()
 {
-	char*		pBuffer;
-	size_t		size;
 	CString		strContentLength;
 	int 		contentLength;
-	result_t	nresult;
 
 	if ( m_strStart.isEmpty() )  {
 		log_error(L_GEN, "[http_cont] can't send container, starting line is not set\n");
@@ -419,13 +406,28 @@ result_t CHttpContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAd
 		}
 	}
 
-	nresult = serialise(&pBuffer, &size);
-	if ( nresult == ESUCCESS )  {
-		//char *sss = (char*)memAlloc(size+1);
-		//UNALIGNED_MEMCPY(sss, pBuffer, size); sss[size] = 0;
-		//log_debug(L_GEN, "SERIALISE: '%s'\n", sss);
+	return ESUCCESS;
+}
+
+/*
+ * Send a container
+ *
+ * 		socket			open socket object
+ * 		hrTimeout		maximum send time
+ * 		dstAddr			destination address (for sendto())
+ *
+ * 	Return:
+ * 		ESUCCESS	all data have been sent
+ * 		EINTR		sending was interrupted by signal
+ * 		...
+ */
+result_t CHttpContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr)
+{
+	result_t	nresult;
 
-		nresult = socket.send(pBuffer, &size, hrTimeout, dstAddr);
+	nresult = prepareSend();
+	if ( nresult == ESUCCESS )  {
+		nresult = sendIov(socket, hrTimeout, dstAddr);
 		if ( nresult != ESUCCESS )  {
 			char 		strTmp[128];
 			CNetAddr	dst;
@@ -436,13 +438,36 @@ result_t CHttpContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAd
 			log_debug(L_GEN, "[http_cont] failed to send container to %s, result %d: %s\n",
 					  (const char*)dst, nresult, strTmp);
 		}
-
-		memFree(pBuffer);
 	}
 
 	return nresult;
 }
 
+/*
+ * Send container in asynchronous mode
+ *
+ * 		socket		open socket object
+ * 		pOffset		send offset [in/out], 0 - start sending
+ *
+ * Return:
+ * 		ESUCCESS	all data have been sent
+ * 		EAGAIN		can't send all data at the moment, repeat again
+ * 		...
+ */
+result_t CHttpContainer::send(CSocketAsync& socket, uint32_t* pOffset)
+{
+	result_t	nresult;
+
+	if ( *pOffset == 0 )  {
+		nresult = prepareSend();
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+	return sendIov(socket, pOffset);
+}
+
 /*
  * Get a content length based on received headers
  *
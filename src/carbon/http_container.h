@@ -11,6 +11,10 @@
  *  Revision 1.0, 29.09.2016 16:39:37
  *      Initial revision.
  *      No chanking encoding support
+ *
+ *  Revision 1.1, 17.10.2026 18:58:30
+ *      Send start line, headers and body by a single sendmsg() without
+ *      copying, added asynchronous send.
  */
 
 #ifndef __CARBON_HTTP_CONTAINER_H_INCLUDED__
@@ -67,13 +71,16 @@ class CHttpContainer : public CNetContainer
 		virtual result_t send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr = NETADDR_NULL);
 		virtual result_t receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr* pSrcAddr = NULL);
 
+		virtual result_t send(CSocketAsync& socket, uint32_t* pOffset);
+		virtual result_t getSendIov(struct iovec* arVec, size_t* pCount);
+
 		virtual void dump(const char* strPref = "") const;
 		virtual void getDump(char* strBuf, size_t length) const;
 
 	protected:
 		void makeBuffer(size_t nSize);
 		int findHeader(const char* strHeader) const ;
-		result_t serialise(char** ppBuffer, size_t* pSize);
+		result_t prepareSend();
 		virtual int getContentLength() const;
 		result_t receiveChunked(CSocket& socket, hr_time_t hrTimeout);
 };
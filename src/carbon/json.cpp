@@ -13,12 +13,35 @@
  *
  *  Revision 1.1, 19.10.2018 13:14:17
  *  	Added support of 'null' data type.
+ *
+ *  Revision 1.2, 17.10.2026 21:12:05
+ *  	Native single pass parser/serializer, vector item storage,
+ *  	hashed object member index, slab allocated items.
+ */
+/*
+ * Note:
+ * 		The native parser builds the items directly from the text in a single
+ * 		pass, the serializer writes the items to a growing buffer. The output
+ * 		is the same as jansson one (JSON_PRESERVE_ORDER), the jansson library
+ * 		path is still available by the JSON_OPTION_JANSSON option.
  */
 
+#include <new>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+
 #include "shell/file.h"
 #include "carbon/memory.h"
+#if CARBON_SLAB_ALLOCATOR
+#include "carbon/slab_allocator.h"
+#endif /* CARBON_SLAB_ALLOCATOR */
 #include "carbon/json.h"
 
+#define JSON_SOURCE_BUFFER		"<string>"
+#define JSON_WRITER_SIZE_MIN	4096		/* Initial serializer buffer size, bytes */
+#define JSON_TEXT_SIZE_MIN		256			/* Initial decoded string buffer size, bytes */
+
 /*
  * Convert internal library JSON type (JSON_xxx) to external (JSON_OBJ_xxx) type
  *
@@ -60,10 +83,80 @@ static void _formatError(json_error_t* pJsonError, char* strBuffer,
 			 pJsonError->source, pJsonError->text);
 }
 
+/*
+ * Get length of the valid UTF-8 multibyte sequence
+ *
+ * 		p			sequence first byte (>= 0x80)
+ * 		nMax		maximum available bytes
+ *
+ * Return: sequence length, bytes, or 0 if the sequence is invalid
+ */
+static size_t _utf8Length(const uint8_t* p, size_t nMax)
+{
+	size_t		i, n;
+	uint8_t		c = p[0], nMin = 0x80, nMaxNext = 0xbf;
+
+	if ( c >= 0xc2 && c <= 0xdf )  {
+		n = 2;
+	} else
+	if ( c >= 0xe0 && c <= 0xef )  {
+		n = 3;
+		if ( c == 0xe0 )  { nMin = 0xa0; }				/* Overlong */
+		if ( c == 0xed )  { nMaxNext = 0x9f; }			/* Surrogates */
+	} else
+	if ( c >= 0xf0 && c <= 0xf4 )  {
+		n = 4;
+		if ( c == 0xf0 )  { nMin = 0x90; }				/* Overlong */
+		if ( c == 0xf4 )  { nMaxNext = 0x8f; }			/* Above U+10FFFF */
+	}
+	else {
+		return 0;
+	}
+
+	if ( n > nMax || p[1] < nMin || p[1] > nMaxNext )  {
+		return 0;
+	}
+
+	for(i=2; i<n; i++)  {
+		if ( p[i] < 0x80 || p[i] > 0xbf )  {
+			return 0;
+		}
+	}
+
+	return n;
+}
+
 /*******************************************************************************
  * CJsonItem class
  */
 
+void* CJsonItem::operator new(size_t size)
+{
+	void*	pData;
+
+#if CARBON_SLAB_ALLOCATOR
+	pData = slabAlloc(size);
+#else /* CARBON_SLAB_ALLOCATOR */
+	pData = memAlloc(size);
+#endif /* CARBON_SLAB_ALLOCATOR */
+	if ( !pData )  {
+		throw std::bad_alloc();
+	}
+
+	return pData;
+}
+
+void CJsonItem::operator delete(void* pData)
+{
+	if ( pData )  {
+#if CARBON_SLAB_ALLOCATOR
+		slabFree(pData);
+#else /* CARBON_SLAB_ALLOCATOR */
+		memFree(pData);
+#endif /* CARBON_SLAB_ALLOCATOR */
+	}
+}
+
 CJsonItem* CJsonItem::getRoot()
 {
 	CJsonItem		*pItem, *pParent;
@@ -400,222 +493,1339 @@ void CJsonNull::dump(const char* strPref) const
 
 
 /*******************************************************************************
- * CJsonOA class
+ * Native parser
  */
-void CJsonOA::clear()
-{
-	while ( !m_item.empty() )  {
-		delete *m_item.begin();
-		m_item.erase(m_item.begin());
-	}
-}
 
-CJsonItem* CJsonOA::operator[](size_t index) const
+/*
+ * Decoded string buffer
+ */
+typedef struct {
+	char*		pData;				/* Buffer, NUL terminated */
+	size_t		nSize;				/* Allocated size, bytes */
+	size_t		nLength;			/* Decoded string length, bytes */
+} json_text_t;
+
+class CJsonParser
 {
-	if ( index < m_item.size() ) {
-		json_item_list_t::const_iterator	it;
-		size_t	i;
+	private:
+		const char*		m_pStart;			/* JSON text */
+		const char*		m_pEnd;				/* JSON text end */
+		const char*		m_p;				/* Current position */
+		int				m_nDepth;			/* Current objects/arrays nesting */
+		json_text_t		m_name;				/* Last decoded member name */
+		json_text_t		m_value;			/* Last decoded string/real value */
+		json_error_t	m_error;			/* Error position and text */
+
+	public:
+		CJsonParser(const char* strJson, size_t nLength, const char* strSource);
+		~CJsonParser()
+		{
+			SAFE_FREE(m_name.pData);
+			SAFE_FREE(m_value.pData);
+		}
 
-		it = m_item.begin();
-		for(i=0; i<index; i++)  {
-			it++;
+	public:
+		result_t parse(CJsonOA* pRoot);
+		void formatError(char* strBuffer, size_t length) {
+			_formatError(&m_error, strBuffer, length);
 		}
 
-		return *it;
+	private:
+		result_t parseObject(CJsonObject* pObject);
+		result_t parseArray(CJsonArray* pArray);
+		result_t parseValue(const char* strName, CJsonItem** ppItem);
+		result_t parseNumber(const char* strName, CJsonItem** ppItem);
+		result_t parseString(json_text_t* pText);
+		boolean_t parseLiteral(const char* strLiteral, size_t length);
+
+		boolean_t append(json_text_t* pText, const void* pData, size_t size);
+		result_t error(const char* strText);
+
+		void skipSpace() {
+			while ( m_p < m_pEnd && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t') )  {
+				m_p++;
+			}
+		}
+};
+
+CJsonParser::CJsonParser(const char* strJson, size_t nLength, const char* strSource) :
+	m_pStart(strJson),
+	m_pEnd(strJson+nLength),
+	m_p(strJson),
+	m_nDepth(0)
+{
+	_tbzero_object(m_name);
+	_tbzero_object(m_value);
+	_tbzero_object(m_error);
+	_tsnprintf(m_error.source, sizeof(m_error.source), "%s", strSource);
+}
+
+/*
+ * Set the parse error at the current position
+ *
+ * 		strText		error description
+ *
+ * Return: EINVAL
+ */
+result_t CJsonParser::error(const char* strText)
+{
+	const char*		p;
+
+	m_error.line = 1;
+	m_error.column = 0;
+	for(p=m_pStart; p<m_p && p<m_pEnd; p++)  {
+		if ( *p == '\n' )  {
+			m_error.line++;
+			m_error.column = 0;
+		}
+		else {
+			m_error.column++;
+		}
 	}
 
-	return 0;
+	m_error.position = (int)(p-m_pStart);
+	_tsnprintf(m_error.text, sizeof(m_error.text), "%s", strText);
+	return EINVAL;
 }
 
-CJsonItem* CJsonOA::createItem(const char* strName, json_type type) const
+/*
+ * Append data to the decoded string buffer
+ *
+ * 		pText		string buffer
+ * 		pData		data to append
+ * 		size		data size, bytes
+ *
+ * Return: TRUE on success, FALSE on out of memory
+ */
+boolean_t CJsonParser::append(json_text_t* pText, const void* pData, size_t size)
 {
-	CJsonItem*		pItem = 0;
-	const char*		sName = strName ? strName : "";
+	if ( (pText->nLength+size+1) > pText->nSize )  {
+		size_t	nSize = sh_max(pText->nSize*2, JSON_TEXT_SIZE_MIN);
+		char*	pBuffer;
 
-	switch ( type ) {
-		case JSON_OBJECT:
-			pItem = new CJsonObject(sName);
-			break;
+		while ( nSize < (pText->nLength+size+1) )  {
+			nSize *= 2;
+		}
 
-		case JSON_ARRAY:
-			pItem = new CJsonArray(sName);
-			break;
+		pBuffer = (char*)memRealloc(pText->pData, nSize);
+		if ( !pBuffer )  {
+			return FALSE;
+		}
 
-		case JSON_STRING:
-			pItem = new CJsonString(sName);
-			break;
+		pText->pData = pBuffer;
+		pText->nSize = nSize;
+	}
 
-		case JSON_INTEGER:
-			pItem = new CJsonInteger(sName);
-			break;
+	UNALIGNED_MEMCPY(&pText->pData[pText->nLength], pData, size);
+	pText->nLength += size;
+	return TRUE;
+}
 
-		case JSON_TRUE:
-		case JSON_FALSE:
-			pItem = new CJsonBoolean(sName);
-			break;
+/*
+ * Decode a string, the current character is a quote
+ *
+ * 		pText		decoded string buffer [out]
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonParser::parseString(json_text_t* pText)
+{
+	const char	*p, *pChunk;
+	char		strUtf8[4];
+	uint32_t	c, c2;
+	size_t		n;
+	int			i;
+
+	pText->nLength = 0;
+	p = m_p+1;
+
+	while ( TRUE )  {
+		pChunk = p;
+		while ( p < m_pEnd && (uint8_t)*p >= 0x20 && (uint8_t)*p < 0x80 && *p != '"' && *p != '\\' )  {
+			p++;
+		}
 
-		case JSON_REAL:
-			pItem = new CJsonFloat(sName);
-			break;
+		if ( p > pChunk && !append(pText, pChunk, p-pChunk) )  {
+			return ENOMEM;
+		}
 
-		case JSON_NULL:
-			pItem = new CJsonNull(sName);
-			break;
+		if ( p >= m_pEnd )  {
+			m_p = p;
+			return error("premature end of input");
+		}
 
-		default:
-			log_error(L_GEN, "[json] name '%s': unsupported JSON type %d\n", sName, type);
+		if ( *p == '"' )  {
+			p++;
 			break;
-	}
+		}
 
-	return pItem;
-}
+		if ( (uint8_t)*p >= 0x80 )  {
+			n = _utf8Length((const uint8_t*)p, m_pEnd-p);
+			if ( n == 0 )  {
+				m_p = p;
+				return error("invalid UTF-8 string");
+			}
 
-json_t* CJsonOA::createJanssonItem(json_item_type_t type, boolean_t bValue) const
-{
-	json_t*		pItem = 0;
+			if ( !append(pText, p, n) )  {
+				return ENOMEM;
+			}
+			p += n;
+			continue;
+		}
 
-	switch ( type )  {
-		case JSON_ITEM_OBJECT:
-			pItem = json_object();
-			break;
+		if ( *p != '\\' )  {
+			m_p = p;
+			return error("control character in string");
+		}
 
-		case JSON_ITEM_ARRAY:
-			pItem = json_array();
-			break;
+		/* Escape sequence */
+		if ( (p+1) >= m_pEnd )  {
+			m_p = p;
+			return error("premature end of input");
+		}
 
-		case JSON_ITEM_STRING:
-			pItem = json_string("");
-			break;
+		c = (uint8_t)p[1];
+		switch ( c )  {
+			case '"':
+			case '\\':
+			case '/':	break;
+			case 'b':	c = '\b'; break;
+			case 'f':	c = '\f'; break;
+			case 'n':	c = '\n'; break;
+			case 'r':	c = '\r'; break;
+			case 't':	c = '\t'; break;
+
+			case 'u':
+				c = 0;
+				for(i=2; i<6; i++)  {
+					if ( (p+i) >= m_pEnd || !isxdigit(p[i]) )  {
+						m_p = p;
+						return error("invalid escape");
+					}
+					c = (c << 4) | (isdigit(p[i]) ? p[i]-'0' : (tolower(p[i])-'a'+10));
+				}
 
-		case JSON_ITEM_INTEGER:
-			pItem = json_integer(0);
-			break;
+				if ( c >= 0xd800 && c <= 0xdbff )  {
+					/* Surrogate pair, the low surrogate is required */
+					c2 = 0;
+					if ( (p+12) <= m_pEnd && p[6] == '\\' && p[7] == 'u' )  {
+						for(i=8; i<12 && isxdigit(p[i]); i++)  {
+							c2 = (c2 << 4) | (isdigit(p[i]) ? p[i]-'0' : (tolower(p[i])-'a'+10));
+						}
+						c2 = i == 12 ? c2 : 0;
+					}
+
+					if ( c2 < 0xdc00 || c2 > 0xdfff )  {
+						m_p = p;
+						return error("invalid Unicode surrogate pair");
+					}
+
+					c = 0x10000 + ((c-0xd800) << 10) + (c2-0xdc00);
+					p += 6;
+				} else
+				if ( c >= 0xdc00 && c <= 0xdfff )  {
+					m_p = p;
+					return error("unexpected Unicode low surrogate");
+				} else
+				if ( c == 0 )  {
+					m_p = p;
+					return error("\\u0000 is not allowed");
+				}
 
-		case JSON_ITEM_FLOAT:
-			pItem = json_real(0.0);
-			break;
+				if ( c < 0x80 )  {
+					strUtf8[0] = (char)c;
+					n = 1;
+				} else
+				if ( c < 0x800 )  {
+					strUtf8[0] = (char)(0xc0 | (c >> 6));
+					strUtf8[1] = (char)(0x80 | (c & 0x3f));
+					n = 2;
+				} else
+				if ( c < 0x10000 )  {
+					strUtf8[0] = (char)(0xe0 | (c >> 12));
+					strUtf8[1] = (char)(0x80 | ((c >> 6) & 0x3f));
+					strUtf8[2] = (char)(0x80 | (c & 0x3f));
+					n = 3;
+				}
+				else {
+					strUtf8[0] = (char)(0xf0 | (c >> 18));
+					strUtf8[1] = (char)(0x80 | ((c >> 12) & 0x3f));
+					strUtf8[2] = (char)(0x80 | ((c >> 6) & 0x3f));
+					strUtf8[3] = (char)(0x80 | (c & 0x3f));
+					n = 4;
+				}
 
-		case JSON_ITEM_BOOLEAN:
-			pItem = json_boolean(bValue);
-			break;
+				if ( !append(pText, strUtf8, n) )  {
+					return ENOMEM;
+				}
+				p += 6;
+				continue;
 
-		case JSON_ITEM_NULL:
-			pItem = json_null();
-			break;
+			default:
+				m_p = p;
+				return error("invalid escape");
+		}
 
-		default:
-			log_error(L_GEN, "[json] unexpected JSON item type %d\n", type);
-			break;
+		strUtf8[0] = (char)c;
+		if ( !append(pText, strUtf8, 1) )  {
+			return ENOMEM;
+		}
+		p += 2;
 	}
 
-	if ( pItem == 0 )  {
-		log_error(L_GEN, "[json] can't create jansson item, type %d\n", type);
+	if ( !append(pText, "", 0) )  {
+		return ENOMEM;
 	}
+	pText->pData[pText->nLength] = '\0';
 
-	return pItem;
+	m_p = p;
+	return ESUCCESS;
 }
 
-void CJsonOA::copy(const CJsonOA& jsonOA)
+/*
+ * Parse an integer or a real number
+ *
+ * 		strName		item name
+ * 		ppItem		created item [out]
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonParser::parseNumber(const char* strName, CJsonItem** ppItem)
 {
-	CJsonItem	*pItem, *pNewItem;
-	size_t		i, count;
+	const char*		p = m_p;
+	uint64_t		nValue = 0, nLimit, d;
+	double			dValue;
+	boolean_t		bNegative = FALSE, bReal = FALSE, bOverflow = FALSE;
 
-	this->clear();
+	if ( *p == '-' )  {
+		bNegative = TRUE;
+		p++;
+	}
 
-	count = jsonOA.size();
-	for(i=0; i<count; i++)  {
-		pItem = jsonOA[i];
-		pNewItem = pItem->clone();
-		this->insert(pNewItem);
+	if ( p >= m_pEnd || !isdigit(*p) )  {
+		m_p = p;
+		return error("invalid token");
 	}
-}
 
-result_t CJsonOA::load(const char* strJson)
-{
-	const char*		s;
-	size_t			nLength;
-	result_t		nresult = ESUCCESS;
+	if ( *p == '0' )  {
+		p++;
+		if ( p < m_pEnd && isdigit(*p) )  {
+			m_p = p;
+			return error("invalid token");
+		}
+	}
+	else {
+		while ( p < m_pEnd && isdigit(*p) )  {
+			d = (uint64_t)(*p-'0');
+			if ( nValue > (UINT64_MAX-d)/10 )  {
+				bOverflow = TRUE;
+			}
+			nValue = nValue*10 + d;
+			p++;
+		}
+	}
 
-	s = strJson;
-	if ( s )  {
-		SKIP_CHARS(s, " \t");
+	if ( p < m_pEnd && *p == '.' )  {
+		p++;
+		if ( p >= m_pEnd || !isdigit(*p) )  {
+			m_p = p;
+			return error("invalid token");
+		}
+		while ( p < m_pEnd && isdigit(*p) )  {
+			p++;
+		}
+		bReal = TRUE;
 	}
 
-	if ( s != NULL && *s != '\0' ) {
-		nLength = _tstrlen(s);
-		nresult = load(s, nLength);
+	if ( p < m_pEnd && (*p == 'e' || *p == 'E') )  {
+		p++;
+		if ( p < m_pEnd && (*p == '+' || *p == '-') )  {
+			p++;
+		}
+		if ( p >= m_pEnd || !isdigit(*p) )  {
+			m_p = p;
+			return error("invalid token");
+		}
+		while ( p < m_pEnd && isdigit(*p) )  {
+			p++;
+		}
+		bReal = TRUE;
+	}
+
+	if ( !bReal )  {
+		nLimit = bNegative ? (uint64_t)INT64_MAX+1 : (uint64_t)INT64_MAX;
+		if ( bOverflow || nValue > nLimit )  {
+			return error(bNegative ? "too big negative integer" : "too big integer");
+		}
+
+		*ppItem = new CJsonInteger(strName, bNegative ? (int64_t)(0-nValue) : (int64_t)nValue);
 	}
 	else {
-		/* Empty JSON */
-		clear();
+		/* The text may be not terminated, convert a copy */
+		m_value.nLength = 0;
+		if ( !append(&m_value, m_p, p-m_p) )  {
+			return ENOMEM;
+		}
+		m_value.pData[m_value.nLength] = '\0';
+
+		errno = 0;
+		dValue = strtod(m_value.pData, NULL);
+		if ( errno == ERANGE && dValue != 0.0 )  {
+			return error("real number overflow");
+		}
+
+		*ppItem = new CJsonFloat(strName, dValue);
 	}
 
-	return nresult;
+	m_p = p;
+	return ESUCCESS;
 }
 
-result_t CJsonOA::loadFile(const char* strFilename, json_option_t options)
+boolean_t CJsonParser::parseLiteral(const char* strLiteral, size_t length)
 {
-	json_t*			pRoot;
-	json_error_t	error;
-	result_t		nresult;
+	if ( (size_t)(m_pEnd-m_p) >= length && _tmemcmp(m_p, strLiteral, length) == 0 )  {
+		m_p += length;
+		return TRUE;
+	}
 
-	shell_unused(options);
-	shell_assert(strFilename);
+	return FALSE;
+}
+
+/*
+ * Parse any value
+ *
+ * 		strName		item name
+ * 		ppItem		created item [out], the item is not created on error
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonParser::parseValue(const char* strName, CJsonItem** ppItem)
+{
+	CJsonItem*		pItem = 0;
+	result_t		nresult = ESUCCESS;
 
-	if ( CFile::fileExists(strFilename, R_OK) ) {
-		pRoot = json_load_file(strFilename, 0, &error);
-		if ( pRoot )  {
-			int 	reqType = getType() == JSON_ITEM_OBJECT ? JSON_OBJECT : JSON_ARRAY;
+	if ( m_p >= m_pEnd )  {
+		return error("premature end of input");
+	}
 
-			if ( json_typeof(pRoot) == reqType ) {
-				clear();
-				nresult = doLoad(pRoot);
-				if ( nresult != ESUCCESS )  {
-					clear();
-				}
+	switch ( *m_p )  {
+		case '{':
+			pItem = new CJsonObject(strName);
+			nresult = parseObject(static_cast<CJsonObject*>(pItem));
+			break;
+
+		case '[':
+			pItem = new CJsonArray(strName);
+			nresult = parseArray(static_cast<CJsonArray*>(pItem));
+			break;
+
+		case '"':
+			nresult = parseString(&m_value);
+			if ( nresult == ESUCCESS )  {
+				pItem = new CJsonString(strName, m_value.pData);
+			}
+			break;
+
+		case 't':
+		case 'f':
+			if ( parseLiteral("true", 4) )  {
+				pItem = new CJsonBoolean(strName, TRUE);
+			} else
+			if ( parseLiteral("false", 5) )  {
+				pItem = new CJsonBoolean(strName, FALSE);
 			}
 			else {
-				log_error(L_GEN, "[json] specified json is of type %d, expected type %d\n",
-						  	json_typeof(pRoot), reqType);
-				nresult = EINVAL;
+				nresult = error("invalid token");
 			}
+			break;
 
-			json_decref(pRoot);
-		}
-		else {
-			char 	strBuf[128];
+		case 'n':
+			if ( parseLiteral("null", 4) )  {
+				pItem = new CJsonNull(strName);
+			}
+			else {
+				nresult = error("invalid token");
+			}
+			break;
 
-			_formatError(&error, strBuf, sizeof(strBuf));
-			log_error(L_GEN, "[json] failed to load json file %s: %s\n", strFilename, strBuf);
-			nresult = EFAULT;
-		}
+		default:
+			if ( *m_p == '-' || isdigit(*m_p) )  {
+				nresult = parseNumber(strName, &pItem);
+			}
+			else {
+				nresult = error("invalid token");
+			}
+			break;
 	}
-	else {
-		log_debug(L_GEN, "[json] file '%s' is not exists or is not readable\n",
-				  strFilename);
-		nresult = ENOENT;
+
+	if ( nresult != ESUCCESS )  {
+		SAFE_DELETE(pItem);
 	}
 
+	*ppItem = pItem;
 	return nresult;
 }
 
-result_t CJsonOA::saveFile(const char* strFilename, json_option_t options) const
+/*
+ * Parse object members, the current character is '{'
+ */
+result_t CJsonParser::parseObject(CJsonObject* pObject)
 {
-	json_t*		pRoot;
+	CJsonItem*	pItem;
 	result_t	nresult;
 
-	shell_assert(strFilename);
+	if ( ++m_nDepth > JSON_PARSE_DEPTH_MAX )  {
+		return error("maximum parsing depth reached");
+	}
 
-	pRoot = getType() == JSON_ITEM_OBJECT ? json_object() : json_array();
-	if ( pRoot )  {
-		nresult = doSave(pRoot);
-		if ( nresult == ESUCCESS )  {
-			size_t	flags = (options&JSON_OPTION_PRETTY) ? JSON_INDENT(JSON_PRETTY_INDENT) : 0;
-			int 	retVal;
+	m_p++;
+	skipSpace();
 
-			retVal = json_dump_file(pRoot, strFilename, flags);
-			if ( retVal != 0 )  {
-				log_error(L_GEN, "[json] failure saving file %s\n", strFilename);
+	if ( m_p < m_pEnd && *m_p == '}' )  {
+		m_p++;
+		m_nDepth--;
+		return ESUCCESS;
+	}
+
+	while ( TRUE )  {
+		if ( m_p >= m_pEnd || *m_p != '"' )  {
+			return error("string or '}' expected");
+		}
+
+		nresult = parseString(&m_name);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+
+		skipSpace();
+		if ( m_p >= m_pEnd || *m_p != ':' )  {
+			return error("':' expected");
+		}
+
+		m_p++;
+		skipSpace();
+
+		nresult = parseValue(m_name.pData, &pItem);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+
+		pObject->insert(pItem);
+
+		skipSpace();
+		if ( m_p < m_pEnd && *m_p == ',' )  {
+			m_p++;
+			skipSpace();
+			continue;
+		}
+
+		if ( m_p < m_pEnd && *m_p == '}' )  {
+			m_p++;
+			break;
+		}
+
+		return error("'}' expected");
+	}
+
+	m_nDepth--;
+	return ESUCCESS;
+}
+
+/*
+ * Parse array items, the current character is '['
+ */
+result_t CJsonParser::parseArray(CJsonArray* pArray)
+{
+	CJsonItem*	pItem;
+	result_t	nresult;
+
+	if ( ++m_nDepth > JSON_PARSE_DEPTH_MAX )  {
+		return error("maximum parsing depth reached");
+	}
+
+	m_p++;
+	skipSpace();
+
+	if ( m_p < m_pEnd && *m_p == ']' )  {
+		m_p++;
+		m_nDepth--;
+		return ESUCCESS;
+	}
+
+	while ( TRUE )  {
+		nresult = parseValue("", &pItem);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+
+		pItem->m_pParent = pArray;
+		pArray->m_item.push_back(pItem);
+
+		skipSpace();
+		if ( m_p < m_pEnd && *m_p == ',' )  {
+			m_p++;
+			skipSpace();
+			continue;
+		}
+
+		if ( m_p < m_pEnd && *m_p == ']' )  {
+			m_p++;
+			break;
+		}
+
+		return error("']' expected");
+	}
+
+	m_nDepth--;
+	return ESUCCESS;
+}
+
+/*
+ * Parse the whole text to the empty root object/array
+ *
+ * 		pRoot		root item, JSON_ITEM_OBJECT or JSON_ITEM_ARRAY
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonParser::parse(CJsonOA* pRoot)
+{
+	result_t	nresult;
+
+	shell_assert(pRoot->size() == 0);
+
+	skipSpace();
+
+	if ( pRoot->isObject() )  {
+		nresult = (m_p < m_pEnd && *m_p == '{') ?
+			parseObject(dynamic_cast<CJsonObject*>(pRoot)) : error("'{' expected");
+	}
+	else {
+		nresult = (m_p < m_pEnd && *m_p == '[') ?
+			parseArray(dynamic_cast<CJsonArray*>(pRoot)) : error("'[' expected");
+	}
+
+	if ( nresult == ESUCCESS )  {
+		skipSpace();
+		if ( m_p < m_pEnd )  {
+			nresult = error("end of file expected");
+		}
+	}
+
+	return nresult;
+}
+
+/*******************************************************************************
+ * Native serializer
+ */
+
+class CJsonWriter
+{
+	private:
+		char*			m_pBuffer;			/* Output buffer */
+		size_t			m_nLength;			/* Output length, bytes */
+		size_t			m_nSize;			/* Allocated buffer size, bytes */
+		int				m_nIndent;			/* Spaces per level, 0 - single line */
+		boolean_t		m_bCompact;			/* TRUE: no spaces after ':' and ',' */
+		boolean_t		m_bFailed;			/* TRUE: out of memory */
+
+	public:
+		CJsonWriter(json_option_t options) :
+			m_pBuffer(0),
+			m_nLength(0),
+			m_nSize(0),
+			m_nIndent((options&JSON_OPTION_PRETTY) ? JSON_PRETTY_INDENT : 0),
+			m_bCompact(!(options&JSON_OPTION_PRETTY) && (options&JSON_OPTION_COMPACT)),
+			m_bFailed(FALSE)
+		{
+		}
+
+		~CJsonWriter()
+		{
+			SAFE_FREE(m_pBuffer);
+		}
+
+	public:
+		result_t write(const CJsonOA* pRoot);
+
+		const char* getData() const { return m_pBuffer; }
+		size_t getLength() const { return m_nLength; }
+
+	private:
+		result_t writeItem(const CJsonItem* pItem, int nDepth);
+		result_t writeString(const char* strValue);
+		void writeIndent(int nDepth, boolean_t bSpace);
+		boolean_t reserve(size_t size);
+
+		void put(const void* pData, size_t size) {
+			if ( reserve(size) )  {
+				UNALIGNED_MEMCPY(&m_pBuffer[m_nLength], pData, size);
+				m_nLength += size;
+			}
+		}
+
+		void put(char c) {
+			if ( reserve(1) )  {
+				m_pBuffer[m_nLength++] = c;
+			}
+		}
+};
+
+boolean_t CJsonWriter::reserve(size_t size)
+{
+	if ( (m_nLength+size) > m_nSize )  {
+		size_t	nSize = sh_max(m_nSize*2, JSON_WRITER_SIZE_MIN);
+		char*	pBuffer;
+
+		if ( m_bFailed )  {
+			return FALSE;
+		}
+
+		while ( nSize < (m_nLength+size) )  {
+			nSize *= 2;
+		}
+
+		pBuffer = (char*)memRealloc(m_pBuffer, nSize);
+		if ( !pBuffer )  {
+			m_bFailed = TRUE;
+			return FALSE;
+		}
+
+		m_pBuffer = pBuffer;
+		m_nSize = nSize;
+	}
+
+	return TRUE;
+}
+
+/*
+ * Write a line break and indent in pretty mode or a space after ','
+ */
+void CJsonWriter::writeIndent(int nDepth, boolean_t bSpace)
+{
+	size_t	size;
+
+	if ( m_nIndent > 0 )  {
+		size = (size_t)(nDepth*m_nIndent);
+		if ( reserve(size+1) )  {
+			m_pBuffer[m_nLength++] = '\n';
+			_tmemset(&m_pBuffer[m_nLength], ' ', size);
+			m_nLength += size;
+		}
+	} else
+	if ( bSpace && !m_bCompact )  {
+		put(' ');
+	}
+}
+
+result_t CJsonWriter::writeString(const char* strValue)
+{
+	const char	*p, *pChunk;
+	char		strEscape[8];
+	uint8_t		c;
+	size_t		n;
+
+	put('"');
+
+	pChunk = p = strValue;
+	while ( (c=(uint8_t)*p) != '\0' )  {
+		if ( c >= 0x80 )  {
+			n = _utf8Length((const uint8_t*)p, 4);
+			if ( n == 0 )  {
+				log_error(L_GEN, "[json] invalid UTF-8 string\n");
+				return EINVAL;
+			}
+			p += n;
+			continue;
+		}
+
+		if ( c >= 0x20 && c != '"' && c != '\\' )  {
+			p++;
+			continue;
+		}
+
+		put(pChunk, p-pChunk);
+		switch ( c )  {
+			case '"':	put("\\\"", 2); break;
+			case '\\':	put("\\\\", 2); break;
+			case '\b':	put("\\b", 2); break;
+			case '\f':	put("\\f", 2); break;
+			case '\n':	put("\\n", 2); break;
+			case '\r':	put("\\r", 2); break;
+			case '\t':	put("\\t", 2); break;
+			default:
+				_tsnprintf(strEscape, sizeof(strEscape), "\\u%04X", c);
+				put(strEscape, 6);
+				break;
+		}
+
+		pChunk = ++p;
+	}
+
+	put(pChunk, p-pChunk);
+	put('"');
+	return ESUCCESS;
+}
+
+result_t CJsonWriter::writeItem(const CJsonItem* pItem, int nDepth)
+{
+	char		strBuf[64], *s;
+	size_t		i, count;
+	uint64_t	u;
+	int64_t		nValue;
+	double		dValue;
+	int			n;
+	result_t	nresult = ESUCCESS;
+
+	switch ( pItem->getType() )  {
+		case JSON_ITEM_OBJECT:
+		case JSON_ITEM_ARRAY:
+		{
+			const CJsonOA*	pOA = static_cast<const CJsonOA*>(pItem);
+			boolean_t		bObject = pItem->isObject();
+
+			put(bObject ? '{' : '[');
+
+			count = pOA->m_item.size();
+			if ( count > 0 )  {
+				writeIndent(nDepth+1, FALSE);
+			}
+
+			for(i=0; i<count && nresult == ESUCCESS; i++)  {
+				const CJsonItem*	pChild = pOA->m_item[i];
+
+				if ( bObject )  {
+					nresult = writeString(pChild->getName());
+					if ( nresult != ESUCCESS )  {
+						break;
+					}
+					if ( m_bCompact )  {
+						put(':');
+					}
+					else {
+						put(": ", 2);
+					}
+				}
+
+				nresult = writeItem(pChild, nDepth+1);
+				if ( (i+1) < count )  {
+					put(',');
+					writeIndent(nDepth+1, TRUE);
+				}
+				else {
+					writeIndent(nDepth, FALSE);
+				}
+			}
+
+			put(bObject ? '}' : ']');
+			break;
+		}
+
+		case JSON_ITEM_STRING:
+			nresult = writeString(static_cast<const CJsonString*>(pItem)->get());
+			break;
+
+		case JSON_ITEM_INTEGER:
+			nValue = static_cast<const CJsonInteger*>(pItem)->get();
+			u = nValue < 0 ? 0-(uint64_t)nValue : (uint64_t)nValue;
+			s = &strBuf[sizeof(strBuf)];
+			do {
+				*--s = (char)('0' + u%10);
+				u /= 10;
+			} while ( u != 0 );
+			if ( nValue < 0 )  {
+				*--s = '-';
+			}
+			put(s, &strBuf[sizeof(strBuf)]-s);
+			break;
+
+		case JSON_ITEM_BOOLEAN:
+			if ( static_cast<const CJsonBoolean*>(pItem)->get() )  {
+				put("true", 4);
+			}
+			else {
+				put("false", 5);
+			}
+			break;
+
+		case JSON_ITEM_FLOAT:
+			dValue = static_cast<const CJsonFloat*>(pItem)->get();
+			if ( !isfinite(dValue) )  {
+				log_error(L_GEN, "[json] can't save non-finite real value\n");
+				nresult = EINVAL;
+				break;
+			}
+
+			n = _tsnprintf(strBuf, sizeof(strBuf), "%.17g", dValue);
+			if ( _tstrchr(strBuf, '.') == NULL && _tstrchr(strBuf, 'e') == NULL )  {
+				/* Keep the value real on decoding */
+				strBuf[n++] = '.';
+				strBuf[n++] = '0';
+			}
+
+			if ( (s=_tstrchr(strBuf, 'e')) != NULL )  {
+				/* Drop '+' and leading zeros of the exponent */
+				char*	e = ++s;
+
+				if ( *s == '-' )  {
+					s++; e++;
+				}
+				while ( *e == '+' || *e == '0' )  {
+					e++;
+				}
+				n -= (int)(e-s);
+				memmove(s, e, _tstrlen(e)+1);
+			}
+
+			put(strBuf, (size_t)n);
+			break;
+
+		case JSON_ITEM_NULL:
+			put("null", 4);
+			break;
+
+		default:
+			log_error(L_GEN, "[json] unexpected JSON item type %d\n", pItem->getType());
+			nresult = EINVAL;
+			break;
+	}
+
+	return nresult;
+}
+
+/*
+ * Serialize the root object/array
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonWriter::write(const CJsonOA* pRoot)
+{
+	result_t	nresult;
+
+	nresult = writeItem(pRoot, 0);
+	if ( nresult == ESUCCESS && (m_bFailed || !reserve(1)) )  {
+		log_error(L_GEN, "[json] out of memory exporting JSON\n");
+		nresult = ENOMEM;
+	}
+
+	if ( nresult == ESUCCESS )  {
+		m_pBuffer[m_nLength] = '\0';
+	}
+
+	return nresult;
+}
+
+/*******************************************************************************
+ * CJsonOA class
+ */
+void CJsonOA::clear()
+{
+	json_item_list_t::iterator	it;
+
+	for(it=m_item.begin(); it != m_item.end(); it++)  {
+		delete *it;
+	}
+
+	m_item.clear();
+}
+
+CJsonItem* CJsonOA::createItem(const char* strName, json_type type) const
+{
+	CJsonItem*		pItem = 0;
+	const char*		sName = strName ? strName : "";
+
+	switch ( type ) {
+		case JSON_OBJECT:
+			pItem = new CJsonObject(sName);
+			break;
+
+		case JSON_ARRAY:
+			pItem = new CJsonArray(sName);
+			break;
+
+		case JSON_STRING:
+			pItem = new CJsonString(sName);
+			break;
+
+		case JSON_INTEGER:
+			pItem = new CJsonInteger(sName);
+			break;
+
+		case JSON_TRUE:
+		case JSON_FALSE:
+			pItem = new CJsonBoolean(sName);
+			break;
+
+		case JSON_REAL:
+			pItem = new CJsonFloat(sName);
+			break;
+
+		case JSON_NULL:
+			pItem = new CJsonNull(sName);
+			break;
+
+		default:
+			log_error(L_GEN, "[json] name '%s': unsupported JSON type %d\n", sName, type);
+			break;
+	}
+
+	return pItem;
+}
+
+json_t* CJsonOA::createJanssonItem(json_item_type_t type, boolean_t bValue) const
+{
+	json_t*		pItem = 0;
+
+	switch ( type )  {
+		case JSON_ITEM_OBJECT:
+			pItem = json_object();
+			break;
+
+		case JSON_ITEM_ARRAY:
+			pItem = json_array();
+			break;
+
+		case JSON_ITEM_STRING:
+			pItem = json_string("");
+			break;
+
+		case JSON_ITEM_INTEGER:
+			pItem = json_integer(0);
+			break;
+
+		case JSON_ITEM_FLOAT:
+			pItem = json_real(0.0);
+			break;
+
+		case JSON_ITEM_BOOLEAN:
+			pItem = json_boolean(bValue);
+			break;
+
+		case JSON_ITEM_NULL:
+			pItem = json_null();
+			break;
+
+		default:
+			log_error(L_GEN, "[json] unexpected JSON item type %d\n", type);
+			break;
+	}
+
+	if ( pItem == 0 )  {
+		log_error(L_GEN, "[json] can't create jansson item, type %d\n", type);
+	}
+
+	return pItem;
+}
+
+void CJsonOA::copy(const CJsonOA& jsonOA)
+{
+	CJsonItem	*pItem, *pNewItem;
+	size_t		i, count;
+
+	this->clear();
+
+	count = jsonOA.size();
+	m_item.reserve(count);
+	for(i=0; i<count; i++)  {
+		pItem = jsonOA[i];
+		pNewItem = pItem->clone();
+		this->insert(pNewItem);
+	}
+}
+
+result_t CJsonOA::load(const char* strJson)
+{
+	const char*		s;
+	size_t			nLength;
+	result_t		nresult = ESUCCESS;
+
+	s = strJson;
+	if ( s )  {
+		SKIP_CHARS(s, " \t");
+	}
+
+	if ( s != NULL && *s != '\0' ) {
+		nLength = _tstrlen(s);
+		nresult = load(s, nLength);
+	}
+	else {
+		/* Empty JSON */
+		clear();
+	}
+
+	return nresult;
+}
+
+/*
+ * Load object/array from the JSON text
+ *
+ * 		strJson			JSON text (may be not NUL terminated)
+ * 		nLength			text length, bytes
+ * 		options			JSON_OPTION_JANSSON: use jansson library
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonOA::load(const char* strJson, size_t nLength, json_option_t options)
+{
+	const char*		s;
+	size_t			nLen;
+	result_t		nresult;
+
+	s = strJson;
+	nLen = nLength;
+	if ( s != 0 )  {
+		while ( nLen > 0 && _tstrchr(" \t", *s) != NULL )  {
+			s++; nLen--;
+		}
+	}
+
+	if ( nLen == 0 || s == 0 || *s == '\0' )  {
+		/* Empty JSON */
+		clear();
+		return ESUCCESS;
+	}
+
+	if ( options&JSON_OPTION_JANSSON )  {
+		return loadJansson(s, nLen);
+	}
+
+	CJsonParser		parser(s, nLen, JSON_SOURCE_BUFFER);
+
+	clear();
+	nresult = parser.parse(this);
+	if ( nresult != ESUCCESS )  {
+		char 	strBuf[128];
+
+		parser.formatError(strBuf, sizeof(strBuf));
+		log_error(L_GEN, "[json] failed to load JSON string: %s\n", strBuf);
+		clear();
+	}
+
+	return nresult;
+}
+
+result_t CJsonOA::loadJansson(const char* strJson, size_t nLength)
+{
+	json_t*			pRoot;
+	json_error_t	error;
+	int 			reqType = getType() == JSON_ITEM_OBJECT ? JSON_OBJECT : JSON_ARRAY;
+	result_t		nresult;
+
+	pRoot = json_loadb(strJson, nLength, 0, &error);
+	if ( !pRoot )  {
+		char 	strBuf[128];
+
+		_formatError(&error, strBuf, sizeof(strBuf));
+		log_error(L_GEN, "[json] failed to load JSON string: %s\n", strBuf);
+		return EINVAL;
+	}
+
+	if ( json_typeof(pRoot) == reqType ) {
+		clear();
+
+		nresult = doLoad(pRoot);
+		if ( nresult != ESUCCESS )  {
+			clear();
+		}
+	}
+	else {
+		log_error(L_GEN, "[json] can't load JSON, expected %s, but found %d type (jansson)\n",
+				  	reqType == JSON_OBJECT ? "object" : "array", json_typeof(pRoot));
+		nresult = EINVAL;
+	}
+
+	json_decref(pRoot);
+	return nresult;
+}
+
+/*
+ * Save object/array to the JSON text
+ *
+ * 		strJson			output JSON text [out]
+ * 		options			JSON_OPTION_PRETTY, JSON_OPTION_COMPACT,
+ * 						JSON_OPTION_JANSSON: use jansson library
+ *
+ * Return: ESUCCESS, EINVAL, ENOMEM
+ */
+result_t CJsonOA::save(CString& strJson, json_option_t options) const
+{
+	result_t	nresult;
+
+	if ( options&JSON_OPTION_JANSSON )  {
+		return saveJansson(strJson, options);
+	}
+
+	CJsonWriter		writer(options);
+
+	nresult = writer.write(this);
+	if ( nresult == ESUCCESS )  {
+		strJson.clear();
+		strJson.append(writer.getData(), writer.getLength());
+	}
+	else {
+		log_error(L_GEN, "[json] failure saving JSON, result %d\n", nresult);
+	}
+
+	return nresult;
+}
+
+result_t CJsonOA::saveJansson(CString& strJson, json_option_t options) const
+{
+	json_t*		pRoot;
+	result_t	nresult;
+
+	pRoot = getType() == JSON_ITEM_OBJECT ? json_object() : json_array();
+	if ( pRoot )  {
+		nresult = doSave(pRoot);
+		if ( nresult == ESUCCESS )  {
+			size_t			flags = 0;
+			const char*		s;
+
+			if ( options&JSON_OPTION_PRETTY )  {
+				flags |= JSON_INDENT(JSON_PRETTY_INDENT);
+			} else if ( options&JSON_OPTION_COMPACT )  {
+				flags |= JSON_COMPACT;
+			}
+
+			s = json_dumps(pRoot, flags);
+			if ( s )  {
+				strJson = s;
+				memFree((void*)s);
+			}
+			else {
+				log_error(L_GEN, "[json] failed to export JSON to string\n");
+				nresult = ENOMEM;
+			}
+		}
+		else {
+			log_error(L_GEN, "[json] failure saving JSON, result %d\n", nresult);
+		}
+
+		json_decref(pRoot);
+	}
+	else {
+		log_error(L_GEN, "[json] failure to create root JSON item\n");
+		nresult = ENOMEM;
+	}
+
+	return nresult;
+}
+
+result_t CJsonOA::loadFile(const char* strFilename, json_option_t options)
+{
+	json_t*			pRoot;
+	json_error_t	error;
+	uint64_t		nSize;
+	char*			pBuffer;
+	result_t		nresult;
+
+	shell_assert(strFilename);
+
+	if ( !CFile::fileExists(strFilename, R_OK) ) {
+		log_debug(L_GEN, "[json] file '%s' is not exists or is not readable\n",
+				  strFilename);
+		return ENOENT;
+	}
+
+	if ( (options&JSON_OPTION_JANSSON) == 0 )  {
+		nresult = CFile::sizeFile(strFilename, &nSize);
+		if ( nresult != ESUCCESS )  {
+			log_error(L_GEN, "[json] failed to load json file %s, result %d\n",
+					  strFilename, nresult);
+			return nresult;
+		}
+
+		pBuffer = (char*)memAlloc((size_t)nSize+1);
+		if ( !pBuffer )  {
+			log_error(L_GEN, "[json] out of memory loading json file %s\n", strFilename);
+			return ENOMEM;
+		}
+
+		nresult = nSize > 0 ? CFile::readFile(strFilename, pBuffer, (size_t)nSize) : ESUCCESS;
+		if ( nresult == ESUCCESS )  {
+			CJsonParser		parser(pBuffer, (size_t)nSize, strFilename);
+
+			clear();
+			nresult = parser.parse(this);
+			if ( nresult != ESUCCESS )  {
+				char 	strBuf[128];
+
+				parser.formatError(strBuf, sizeof(strBuf));
+				log_error(L_GEN, "[json] failed to load json file %s: %s\n", strFilename, strBuf);
+				clear();
+				nresult = EFAULT;
+			}
+		}
+		else {
+			log_error(L_GEN, "[json] failed to read json file %s, result %d\n",
+					  strFilename, nresult);
+		}
+
+		memFree(pBuffer);
+		return nresult;
+	}
+
+	pRoot = json_load_file(strFilename, 0, &error);
+	if ( pRoot )  {
+		int 	reqType = getType() == JSON_ITEM_OBJECT ? JSON_OBJECT : JSON_ARRAY;
+
+		if ( json_typeof(pRoot) == reqType ) {
+			clear();
+			nresult = doLoad(pRoot);
+			if ( nresult != ESUCCESS )  {
+				clear();
+			}
+		}
+		else {
+			log_error(L_GEN, "[json] specified json is of type %d, expected type %d\n",
+					  	json_typeof(pRoot), reqType);
+			nresult = EINVAL;
+		}
+
+		json_decref(pRoot);
+	}
+	else {
+		char 	strBuf[128];
+
+		_formatError(&error, strBuf, sizeof(strBuf));
+		log_error(L_GEN, "[json] failed to load json file %s: %s\n", strFilename, strBuf);
+		nresult = EFAULT;
+	}
+
+	return nresult;
+}
+
+result_t CJsonOA::saveFile(const char* strFilename, json_option_t options) const
+{
+	json_t*		pRoot;
+	result_t	nresult;
+
+	shell_assert(strFilename);
+
+	if ( (options&JSON_OPTION_JANSSON) == 0 )  {
+		CJsonWriter		writer((json_option_t)(options&JSON_OPTION_PRETTY));
+
+		nresult = writer.write(this);
+		if ( nresult == ESUCCESS )  {
+			nresult = CFile::writeFile(strFilename, writer.getData(), writer.getLength());
+			if ( nresult != ESUCCESS )  {
+				log_error(L_GEN, "[json] failure saving file %s, result %d\n",
+						  strFilename, nresult);
+			}
+		}
+
+		return nresult;
+	}
+
+	pRoot = getType() == JSON_ITEM_OBJECT ? json_object() : json_array();
+	if ( pRoot )  {
+		nresult = doSave(pRoot);
+		if ( nresult == ESUCCESS )  {
+			size_t	flags = (options&JSON_OPTION_PRETTY) ? JSON_INDENT(JSON_PRETTY_INDENT) : 0;
+			int 	retVal;
+
+			retVal = json_dump_file(pRoot, strFilename, flags);
+			if ( retVal != 0 )  {
+				log_error(L_GEN, "[json] failure saving file %s\n", strFilename);
 				nresult = EIO;
 			}
 		}
@@ -639,6 +1849,116 @@ CJsonArray* CJsonObject::getArray(const char* strName) const {
 	return dynamic_cast<CJsonArray*>(find(strName));
 }
 
+static uint32_t _hashName(const char* strName)
+{
+	const uint8_t*	p = (const uint8_t*)strName;
+	uint32_t		hash = 2166136261u;		/* FNV-1a */
+
+	while ( *p != '\0' )  {
+		hash = (hash ^ *p++) * 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+ * Find a member position by the name
+ *
+ * 		strName		member name
+ *
+ * Return: member position or size() if not found
+ */
+size_t CJsonObject::indexOf(const char* strName) const
+{
+	size_t		i, count = m_item.size();
+	uint32_t	n;
+
+	shell_assert(strName);
+
+	if ( m_nIndexSize == 0 )  {
+		for(i=0; i<count; i++)  {
+			if ( _tstrcmp(m_item[i]->getName(), strName) == 0 )  {
+				return i;
+			}
+		}
+		return count;
+	}
+
+	i = _hashName(strName) & (m_nIndexSize-1);
+	while ( (n=m_arIndex[i]) != 0 )  {
+		if ( _tstrcmp(m_item[n-1]->getName(), strName) == 0 )  {
+			return n-1;
+		}
+		i = (i+1) & (m_nIndexSize-1);
+	}
+
+	return count;
+}
+
+/*
+ * Rebuild the member index, the index is dropped below JSON_INDEX_MIN members
+ */
+void CJsonObject::indexRebuild()
+{
+	size_t		i, j, nSize, count = m_item.size();
+
+	if ( count < JSON_INDEX_MIN )  {
+		SAFE_FREE(m_arIndex);
+		m_nIndexSize = 0;
+		return;
+	}
+
+	/* Keep the load factor below 1/2 until the next rebuild */
+	nSize = JSON_INDEX_MIN*2;
+	while ( nSize < count*4 )  {
+		nSize *= 2;
+	}
+
+	if ( nSize != m_nIndexSize )  {
+		uint32_t*	arIndex = (uint32_t*)memAlloc(nSize*sizeof(uint32_t));
+
+		if ( !arIndex )  {
+			/* Fall back to the linear search */
+			SAFE_FREE(m_arIndex);
+			m_nIndexSize = 0;
+			return;
+		}
+
+		SAFE_FREE(m_arIndex);
+		m_arIndex = arIndex;
+		m_nIndexSize = nSize;
+	}
+
+	_tbzero(m_arIndex, m_nIndexSize*sizeof(uint32_t));
+	for(i=0; i<count; i++)  {
+		j = _hashName(m_item[i]->getName()) & (m_nIndexSize-1);
+		while ( m_arIndex[j] != 0 )  {
+			j = (j+1) & (m_nIndexSize-1);
+		}
+		m_arIndex[j] = (uint32_t)(i+1);
+	}
+}
+
+/*
+ * Add a member to the index
+ *
+ * 		index		member position
+ */
+void CJsonObject::indexInsert(size_t index)
+{
+	size_t	i;
+
+	if ( m_nIndexSize == 0 || m_item.size()*2 > m_nIndexSize )  {
+		indexRebuild();
+		return;
+	}
+
+	i = _hashName(m_item[index]->getName()) & (m_nIndexSize-1);
+	while ( m_arIndex[i] != 0 )  {
+		i = (i+1) & (m_nIndexSize-1);
+	}
+	m_arIndex[i] = (uint32_t)(index+1);
+}
 
 void CJsonObject::insert(CJsonItem* pJsonItem)
 {
@@ -648,6 +1968,7 @@ void CJsonObject::insert(CJsonItem* pJsonItem)
 
 	pJsonItem->m_pParent = this;
 	m_item.push_back(pJsonItem);
+	indexInsert(m_item.size()-1);
 }
 
 CJsonArray& CJsonObject::insertArray(const char* strName)
@@ -660,44 +1981,27 @@ CJsonArray& CJsonObject::insertArray(const char* strName)
 
 result_t CJsonObject::remove(const char* strName)
 {
-	json_item_list_t::iterator	it;
-	CString		sName(strName);
+	size_t		index;
 	result_t	nresult = ENOENT;
 
 	shell_assert(strName);
 
-	it = m_item.begin();
-	while ( it != m_item.end() ) {
-		if ( sName == (*it)->getName() )  {
-			delete *it;
-			m_item.erase(it);
-			nresult = ESUCCESS;
-			break;
-		}
-
-		it++;
+	index = indexOf(strName);
+	if ( index < m_item.size() )  {
+		delete m_item[index];
+		m_item.erase(m_item.begin()+index);
+		indexRebuild();
+		nresult = ESUCCESS;
 	}
 
 	return nresult;
 }
 
-CJsonItem* CJsonObject::get(const char* strName) const
+void CJsonObject::clear()
 {
-	json_item_list_t::const_iterator	it;
-	CJsonItem*		pItem = 0;
-	CString			sName(strName);
-
-	it = m_item.begin();
-	while ( it != m_item.end() ) {
-		if ( sName == (*it)->getName() )  {
-			pItem = *it;
-			break;
-		}
-
-		it++;
-	}
-
-	return pItem;
+	CJsonOA::clear();
+	SAFE_FREE(m_arIndex);
+	m_nIndexSize = 0;
 }
 
 result_t CJsonObject::doLoad(json_t* pItem)
@@ -739,55 +2043,6 @@ result_t CJsonObject::doLoad(json_t* pItem)
 	return nresult;
 }
 
-result_t CJsonObject::load(const char* strJson, size_t nLength)
-{
-	const char*		s;
-	size_t			nLen;
-	json_t*			pRoot;
-	json_error_t	error;
-	result_t		nresult;
-
-	s = strJson;
-	nLen = nLength;
-	if ( s != 0 )  {
-		while ( nLen > 0 && _tstrchr(" \t", *s) != NULL )  {
-			s++; nLen--;
-		}
-	}
-
-	if ( nLen == 0 || s == 0 || *s == '\0' )  {
-		/* Empty JSON */
-		clear();
-		return ESUCCESS;
-	}
-
-	pRoot = json_loadb(strJson, nLen, 0, &error);
-	if ( !pRoot )  {
-		char 	strBuf[128];
-
-		_formatError(&error, strBuf, sizeof(strBuf));
-		log_error(L_GEN, "[json] failed to load JSON string: %s\n", strBuf);
-		return EINVAL;
-	}
-
-	if ( json_is_object(pRoot) ) {
-		clear();
-
-		nresult = doLoad(pRoot);
-		if ( nresult != ESUCCESS )  {
-			clear();
-		}
-	}
-	else {
-		log_error(L_GEN, "[json] can't load JSON, expected object, but found %d type (jansson)\n",
-				  	json_typeof(pRoot));
-		nresult = EINVAL;
-	}
-
-	json_decref(pRoot);
-	return nresult;
-}
-
 result_t CJsonObject::doSave(json_t* pItem) const
 {
 	size_t		i, count;
@@ -835,48 +2090,6 @@ result_t CJsonObject::doSave(json_t* pItem) const
 	return nresult;
 }
 
-result_t CJsonObject::save(CString& strJson, json_option_t options) const
-{
-	json_t*		pRoot;
-	result_t	nresult;
-
-	pRoot = json_object();
-	if ( pRoot )  {
-		nresult = doSave(pRoot);
-		if ( nresult == ESUCCESS )  {
-			size_t			flags = 0;
-			const char*		s;
-
-			if ( options&JSON_OPTION_PRETTY )  {
-				flags |= JSON_INDENT(JSON_PRETTY_INDENT);
-			} else if ( options&JSON_OPTION_COMPACT )  {
-				flags |= JSON_COMPACT;
-			}
-
-			s = json_dumps(pRoot, flags);
-			if ( s )  {
-				strJson = s;
-				memFree((void*)s);
-			}
-			else {
-				log_error(L_GEN, "[json] failed to export JSON to string\n");
-				nresult = ENOMEM;
-			}
-		}
-		else {
-			log_error(L_GEN, "[json] failure saving JSON, result %d\n", nresult);
-		}
-
-		json_decref(pRoot);
-	}
-	else {
-		log_error(L_GEN, "[json] failure to create root JSON object\n");
-		nresult = ENOMEM;
-	}
-
-	return nresult;
-}
-
 void CJsonObject::dump(int nIndent, boolean_t bLast) const
 {
 	json_item_list_t::const_iterator it;
@@ -936,22 +2149,9 @@ CJsonItem* CJsonArray::insert(CJsonItem* pJsonItem, size_t index)
 	CJsonItem*	x = 0;
 
 	rindex = index == (size_t)-1 ? length : index;
-	if ( rindex < length )  {
-		json_item_list_t::iterator	it;
-		size_t	i;
-
-		it = m_item.begin();
-		for(i=0; i<rindex; i++)  {
-			it++;
-		}
-
-		pJsonItem->m_pParent = this;
-		m_item.insert(it, pJsonItem);
-		x = pJsonItem;
-	}
-	else if ( rindex == length ) {
+	if ( rindex <= length )  {
 		pJsonItem->m_pParent = this;
-		m_item.push_back(pJsonItem);
+		m_item.insert(m_item.begin()+rindex, pJsonItem);
 		x = pJsonItem;
 	}
 	else {
@@ -967,16 +2167,8 @@ result_t CJsonArray::remove(size_t index)
 	result_t	nresult = EINVAL;
 
 	if ( index < size() ) {
-		json_item_list_t::iterator	it;
-		size_t	i;
-
-		it = m_item.begin();
-		for (i = 0; i < index; i++) {
-			it++;
-		}
-
-		delete *it;
-		m_item.erase(it);
+		delete m_item[index];
+		m_item.erase(m_item.begin()+index);
 		nresult = ESUCCESS;
 	}
 
@@ -1022,55 +2214,6 @@ result_t CJsonArray::doLoad(json_t* pItem)
 	return nresult;
 }
 
-result_t CJsonArray::load(const char* strJson, size_t nLength)
-{
-	const char*		s;
-	size_t			nLen;
-	json_t*			pRoot;
-	json_error_t	error;
-	result_t		nresult;
-
-	s = strJson;
-	nLen = nLength;
-	if ( s != 0 )  {
-		while ( nLen > 0 && _tstrchr(" \t", *s) != NULL )  {
-			s++; nLen--;
-		}
-	}
-
-	if ( s == 0 || *s == '\0' || nLen == 0 )  {
-		/* Empty JSON */
-		clear();
-		return ESUCCESS;
-	}
-
-	pRoot = json_loadb(strJson, nLen, 0, &error);
-	if ( !pRoot )  {
-		char 	strBuf[128];
-
-		_formatError(&error, strBuf, sizeof(strBuf));
-		log_error(L_GEN, "[json] failed to load JSON string: %s\n", strBuf);
-		return EINVAL;
-	}
-
-	if ( json_is_array(pRoot) ) {
-		clear();
-
-		nresult = doLoad(pRoot);
-		if ( nresult != ESUCCESS )  {
-			clear();
-		}
-	}
-	else {
-		log_error(L_GEN, "[json] can't load JSON, expected array, but found %d type (jansson)\n",
-				  json_typeof(pRoot));
-		nresult = EINVAL;
-	}
-
-	json_decref(pRoot);
-	return nresult;
-}
-
 result_t CJsonArray::doSave(json_t* pItem) const
 {
 	size_t		i, count;
@@ -1118,48 +2261,6 @@ result_t CJsonArray::doSave(json_t* pItem) const
 	return nresult;
 }
 
-result_t CJsonArray::save(CString& strJson, json_option_t options) const
-{
-	json_t*		pRoot;
-	result_t	nresult;
-
-	pRoot = json_array();
-	if ( pRoot )  {
-		nresult = doSave(pRoot);
-		if ( nresult == ESUCCESS )  {
-			size_t			flags = 0;
-			const char*		s;
-
-			if ( options&JSON_OPTION_PRETTY )  {
-				flags |= JSON_INDENT(JSON_PRETTY_INDENT);
-			} else if ( options&JSON_OPTION_COMPACT )  {
-				flags |= JSON_COMPACT;
-			}
-
-			s = json_dumps(pRoot, flags);
-			if ( s )  {
-				strJson = s;
-				memFree((void*)s);
-			}
-			else {
-				log_error(L_GEN, "[json] failed to export JSON to string\n");
-				nresult = ENOMEM;
-			}
-		}
-		else {
-			log_error(L_GEN, "[json] failure saving JSON, result %d\n", nresult);
-		}
-
-		json_decref(pRoot);
-	}
-	else {
-		log_error(L_GEN, "[json] failure to create root JSON array\n");
-		nresult = ENOMEM;
-	}
-
-	return nresult;
-}
-
 void CJsonArray::dump(int nIndent, boolean_t bLast) const
 {
 	json_item_list_t::const_iterator it;
@@ -13,12 +13,16 @@
  *
  *  Revision 1.1, 19.10.2018 13:13:36
  *  	Added support of 'null' data type.
+ *
+ *  Revision 1.2, 17.10.2026 21:10:44
+ *  	Native single pass parser/serializer, vector item storage,
+ *  	hashed object member index, slab allocated items.
  */
 
 #ifndef __CARBON_JSON_H_INCLUDED__
 #define __CARBON_JSON_H_INCLUDED__
 
-#include <list>
+#include <vector>
 
 #include <jansson.h>
 
@@ -37,10 +41,13 @@ typedef enum {
 	JSON_OPTION_NONE 			= 0,
 	JSON_OPTION_PRETTY 			= 1,
 	JSON_OPTION_COMPACT			= 2,
-	JSON_OPTION_SAVE_SAFE		= 4		/* use intermediate temp file when saving */
+	JSON_OPTION_SAVE_SAFE		= 4,	/* use intermediate temp file when saving */
+	JSON_OPTION_JANSSON			= 8		/* use jansson library instead of the native parser/serializer */
 } json_option_t;
 
 #define JSON_PRETTY_INDENT		4
+#define JSON_PARSE_DEPTH_MAX	512		/* Maximum nested objects/arrays */
+#define JSON_INDEX_MIN			8		/* Minimum object members to index by the name */
 
 /*
  * Public json types (library types are used private in the class)
@@ -56,7 +63,7 @@ typedef enum {
 } json_item_type_t;
 
 class CJsonItem;
-typedef std::list<CJsonItem*>		json_item_list_t;
+typedef std::vector<CJsonItem*>		json_item_list_t;
 
 /*******************************************************************************
  * Item base class
@@ -73,6 +80,8 @@ class CJsonItem __CJsonItem_PARENT
 	friend class CJsonOA;
 	friend class CJsonArray;
 	friend class CJsonObject;
+	friend class CJsonParser;
+	friend class CJsonWriter;
 
 	protected:
 		CString					m_strName;			/* Item name (optional) */
@@ -92,6 +101,9 @@ class CJsonItem __CJsonItem_PARENT
 		{
 		}
 
+		void* operator new(size_t size);
+		void operator delete(void* pData);
+
 	public:
 		json_item_type_t getType() const { return m_type; }
 		boolean_t isString() const { return getType() == JSON_ITEM_STRING; }
@@ -454,6 +466,9 @@ class CJsonNull : public CJsonItem
  */
 class CJsonOA : public CJsonItem
 {
+	friend class CJsonParser;
+	friend class CJsonWriter;
+
 	protected:
 		json_item_list_t	m_item;
 
@@ -471,14 +486,19 @@ class CJsonOA : public CJsonItem
 
 	public:
 		virtual size_t size() const { return m_item.size(); }
-		virtual CJsonItem* operator[](size_t index) const;
+		virtual CJsonItem* operator[](size_t index) const {
+			return index < m_item.size() ? m_item[index] : 0;
+		}
 
 		virtual void insert(CJsonItem* pJsonItem) = 0;
 		virtual void clear();
 
 		virtual result_t load(const char* strJson);
-		virtual result_t load(const char* strJson, size_t nLength) = 0;
-		virtual result_t save(CString& strJson, json_option_t options = JSON_OPTION_NONE) const = 0;
+		virtual result_t load(const char* strJson, size_t nLength) {
+			return load(strJson, nLength, JSON_OPTION_NONE);
+		}
+		virtual result_t load(const char* strJson, size_t nLength, json_option_t options);
+		virtual result_t save(CString& strJson, json_option_t options = JSON_OPTION_NONE) const;
 
 		virtual result_t loadFile(const char* strFilename, json_option_t options = JSON_OPTION_NONE);
 		virtual result_t saveFile(const char* strFilename, json_option_t options = JSON_OPTION_PRETTY) const;
@@ -494,6 +514,9 @@ class CJsonOA : public CJsonItem
 		CJsonItem* createItem(const char* strName, json_type type) const;
 		json_t* createJanssonItem(json_item_type_t type, boolean_t bValue) const;
 
+		result_t loadJansson(const char* strJson, size_t nLength);
+		result_t saveJansson(CString& strJson, json_option_t options) const;
+
 		virtual CJsonItem* clone() const = 0;
 };
 
@@ -504,26 +527,40 @@ class CJsonArray;
 
 class CJsonObject : public CJsonOA
 {
+	protected:
+		uint32_t*			m_arIndex;			/* Member index by the name: position+1, 0 - free slot */
+		size_t				m_nIndexSize;		/* Index slots (power of 2), 0 - not indexed */
+
 	public:
 		CJsonObject(const char* strName = "") :
-			CJsonOA(strName, JSON_ITEM_OBJECT)
+			CJsonOA(strName, JSON_ITEM_OBJECT),
+			m_arIndex(0),
+			m_nIndexSize(0)
 		{
 		}
 
 		CJsonObject(const CJsonObject& jsonObject) :
-			CJsonOA(jsonObject.getName(), JSON_ITEM_OBJECT)
+			CJsonOA(jsonObject.getName(), JSON_ITEM_OBJECT),
+			m_arIndex(0),
+			m_nIndexSize(0)
 		{
 			copy(jsonObject);
 		}
 
 		virtual ~CJsonObject()
 		{
+			SAFE_FREE(m_arIndex);
 		}
 
 	public:
-		CJsonItem* get(const char* strName) const;
+		CJsonItem* get(const char* strName) const {
+			size_t	index = indexOf(strName);
+			return index < m_item.size() ? m_item[index] : 0;
+		}
+
 		virtual void insert(CJsonItem* pJsonItem);
 		result_t remove(const char* strName);
+		virtual void clear();
 
 		CJsonString& insert(const char* strName, const char* strValue) {
 			CJsonString*	pItem = new CJsonString(strName, strValue);
@@ -680,9 +717,13 @@ class CJsonObject : public CJsonOA
 
 		CJsonArray* getArray(const char* strName) const;
 
-		virtual result_t load(const char* strJson, size_t nLength);
 		virtual result_t load(const char* strJson) { return CJsonOA::load(strJson); }
-		virtual result_t save(CString& strJson, json_option_t options = JSON_OPTION_NONE) const;
+		virtual result_t load(const char* strJson, size_t nLength) {
+			return CJsonOA::load(strJson, nLength);
+		}
+		virtual result_t load(const char* strJson, size_t nLength, json_option_t options) {
+			return CJsonOA::load(strJson, nLength, options);
+		}
 
 		virtual void dump(const char* strPref = "") const;
 		virtual void dump(int nIndent, boolean_t bLast) const;
@@ -696,6 +737,10 @@ class CJsonObject : public CJsonOA
 			pNewObject->copy(*this);
 			return pNewObject;
 		}
+
+		size_t indexOf(const char* strName) const;
+		void indexInsert(size_t index);
+		void indexRebuild();
 };
 
 /*******************************************************************************
@@ -810,9 +855,13 @@ class CJsonArray : public CJsonOA
 			return *this;
 		}
 
-		virtual result_t load(const char* strJson, size_t nLength);
 		virtual result_t load(const char* strJson) { return CJsonOA::load(strJson); }
-		virtual result_t save(CString& strJson, json_option_t options = JSON_OPTION_NONE) const;
+		virtual result_t load(const char* strJson, size_t nLength) {
+			return CJsonOA::load(strJson, nLength);
+		}
+		virtual result_t load(const char* strJson, size_t nLength, json_option_t options) {
+			return CJsonOA::load(strJson, nLength, options);
+		}
 
 		virtual void dump(const char* strPref = "") const;
 		virtual void dump(int nIndent, boolean_t bLast) const;
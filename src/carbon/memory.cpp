@@ -17,6 +17,12 @@
  *  Revision 3.0, 19.10.2018 17:37:36
  *  	Removed deprecated glibc memory hooks and
  *  	redefine weak malloc/free functions.
+ *
+ *  Revision 3.1, 17.10.2026 14:31:40
+ *  	Added slab allocator statistic.
+ *
+ *  Revision 3.2, 17.10.2026 15:10:52
+ *  	Per-thread sharded counters, allocation size sampling.
  */
 /*
  * Note:
@@ -28,12 +34,61 @@
 
 #include "carbon/logger.h"
 #include "carbon/memory.h"
+#if CARBON_SLAB_ALLOCATOR
+#include "carbon/slab_allocator.h"
+#endif /* CARBON_SLAB_ALLOCATOR */
+
+
+/*
+ * Allocation counters are sharded by threads, every shard takes its own
+ * cache line so the threads do not share the counters in common case.
+ * The allocated size is flushed to the global counter in batches, the
+ * maximum allocated size is tracked on the flush only (accuracy is
+ * MEMORY_STAT_SHARDS*MEMORY_STAT_BATCH bytes).
+ */
+#define MEMORY_STAT_SHARDS			64
+#define MEMORY_STAT_BATCH			(64*1024)
+#define MEMORY_CACHE_LINE			64
+
+typedef struct {
+	int64_t		full_alloc_count;
+	int64_t		free_count;
+	int64_t		realloc_count;
+	int64_t		fail_count;
+	int64_t		size_delta;					/* Not flushed allocated size */
+	uint64_t	arHist[MEMORY_HIST_BUCKETS];	/* Sampled allocation sizes */
+} __attribute__ ((aligned(MEMORY_CACHE_LINE))) memory_shard_t;
+
+static memory_shard_t		g_arShard[MEMORY_STAT_SHARDS];
+static int64_t volatile		g_nAllocSize = 0;
+static int64_t volatile		g_nAllocSizeMax = 0;
+static int volatile			g_nShardNext = 0;
+static unsigned volatile	g_nSampleRate = 0;			/* 0 - sampling is disabled */
+
+static __thread int			t_nShard __attribute__ ((tls_model("initial-exec"))) = -1;
+static __thread unsigned	t_nSample __attribute__ ((tls_model("initial-exec"))) = 0;
+static __thread uint32_t	t_nSampleSeed __attribute__ ((tls_model("initial-exec"))) = 0;
+
+static inline memory_shard_t* get_shard()
+{
+	if ( t_nShard < 0 )  {
+		t_nShard = __sync_fetch_and_add(&g_nShardNext, 1) % MEMORY_STAT_SHARDS;
+	}
+
+	return &g_arShard[t_nShard];
+}
 
+static int64_t get_alloc_size()
+{
+	int64_t		nSize = g_nAllocSize;
+	size_t		i;
+
+	for(i=0; i<MEMORY_STAT_SHARDS; i++)  {
+		nSize += g_arShard[i].size_delta;
+	}
 
-static memory_stat_t	g_stat = {
-	ZERO_ATOMIC, ZERO_ATOMIC, ZERO_ATOMIC, ZERO_ATOMIC,
-	ZERO_ATOMIC, ZERO_ATOMIC, ZERO_ATOMIC
-};
+	return nSize;
+}
 
 /*******************************************************************************
  * Memory Allocation Manager
@@ -41,77 +96,221 @@ static memory_stat_t	g_stat = {
 
 void CMemoryManager::getStat(void* pBuffer, size_t nSize) const
 {
-	size_t rsize = sh_min(nSize, sizeof(g_stat));
+	memory_stat_t	stat;
+	size_t			rsize = sh_min(nSize, sizeof(stat));
+	int64_t			nAlloc = 0, nFree = 0, nRealloc = 0, nFail = 0;
+	size_t			i;
+
+	for(i=0; i<MEMORY_STAT_SHARDS; i++)  {
+		nAlloc += g_arShard[i].full_alloc_count;
+		nFree += g_arShard[i].free_count;
+		nRealloc += g_arShard[i].realloc_count;
+		nFail += g_arShard[i].fail_count;
+	}
 
-	UNALIGNED_MEMCPY(pBuffer, &g_stat, rsize);
+	_tbzero(&stat, sizeof(stat));
+	sh_atomic_set(&stat.full_alloc_count, (int32_t)nAlloc);
+	sh_atomic_set(&stat.free_count, (int32_t)nFree);
+	sh_atomic_set(&stat.alloc_count, (int32_t)(nAlloc-nFree));
+	sh_atomic_set(&stat.alloc_size, (int32_t)get_alloc_size());
+	sh_atomic_set(&stat.alloc_size_max, (int32_t)g_nAllocSizeMax);
+	sh_atomic_set(&stat.realloc_count, (int32_t)nRealloc);
+	sh_atomic_set(&stat.fail_count, (int32_t)nFail);
+
+#if CARBON_SLAB_ALLOCATOR
+	slab_stat_t		slabStat;
+
+	slabGetStat(&slabStat);
+	sh_atomic_set(&stat.slab_alloc_count, (int32_t)slabStat.alloc_count);
+	sh_atomic_set(&stat.slab_free_count, (int32_t)slabStat.free_count);
+	sh_atomic_set(&stat.slab_hit_count, (int32_t)slabStat.hit_count);
+	sh_atomic_set(&stat.slab_miss_count, (int32_t)slabStat.miss_count);
+	sh_atomic_set(&stat.slab_remote_free_count, (int32_t)slabStat.remote_free_count);
+	sh_atomic_set(&stat.slab_size, (int32_t)slabStat.chunk_size);
+#endif /* CARBON_SLAB_ALLOCATOR */
+
+	UNALIGNED_MEMCPY(pBuffer, &stat, rsize);
 }
 
+/*
+ * Reset the counters, the currently allocated size is kept
+ */
 void CMemoryManager::resetStat()
 {
-	sh_atomic_set(&g_stat.full_alloc_count, 0);
-	sh_atomic_set(&g_stat.free_count, 0);
-	sh_atomic_set(&g_stat.alloc_count, 0);
-	sh_atomic_set(&g_stat.alloc_size, 0);
-	sh_atomic_set(&g_stat.alloc_size_max, 0);
-	sh_atomic_set(&g_stat.realloc_count, 0);
-	sh_atomic_set(&g_stat.fail_count, 0);
+	int64_t		nSize;
+	size_t		i, j;
+
+	for(i=0; i<MEMORY_STAT_SHARDS; i++)  {
+		g_arShard[i].full_alloc_count = 0;
+		g_arShard[i].free_count = 0;
+		g_arShard[i].realloc_count = 0;
+		g_arShard[i].fail_count = 0;
+		for(j=0; j<MEMORY_HIST_BUCKETS; j++)  {
+			g_arShard[i].arHist[j] = 0;
+		}
+	}
+
+	nSize = get_alloc_size();
+	g_nAllocSizeMax = nSize;
+
+#if CARBON_SLAB_ALLOCATOR
+	slabResetStat();
+#endif /* CARBON_SLAB_ALLOCATOR */
+}
+
+/*
+ * Enable allocation size sampling
+ *
+ * 		nRate		sample every nRate-th allocation of a thread, 0 - disable
+ */
+void CMemoryManager::setSampleRate(unsigned int nRate)
+{
+	g_nSampleRate = nRate;
+}
+
+/*
+ * Get sampled allocation size histogram
+ *
+ * 		arCount		bucket counters [out], bucket N counts sizes 2^N..2^(N+1)-1
+ * 		nCount		maximum buckets to get
+ *
+ * Return: bucket count
+ */
+size_t CMemoryManager::getHistogram(uint64_t* arCount, size_t nCount) const
+{
+	size_t		i, j, n = sh_min(nCount, MEMORY_HIST_BUCKETS);
+
+	for(j=0; j<n; j++)  {
+		arCount[j] = 0;
+		for(i=0; i<MEMORY_STAT_SHARDS; i++)  {
+			arCount[j] += g_arShard[i].arHist[j];
+		}
+	}
+
+	return n;
 }
 
 void CMemoryManager::dump(const char* strPref) const
 {
+	memory_stat_t	stat;
+
+	getStat(&stat, sizeof(stat));
+
 	log_dump("%s*** MemoryManager statistic:\n", strPref);
-	log_dump("     allocs:                  %u\n", sh_atomic_get(&g_stat.full_alloc_count));
-	log_dump("     freeds:                  %u\n", sh_atomic_get(&g_stat.free_count));
-	log_dump("     reallocs:                %u\n", sh_atomic_get(&g_stat.realloc_count));
-	log_dump("     failed:                  %u\n", sh_atomic_get(&g_stat.fail_count));
-	log_dump("     allocated:               %u\n", sh_atomic_get(&g_stat.alloc_count));
-	log_dump("     allocated size:          %u\n", sh_atomic_get(&g_stat.alloc_size));
-	log_dump("     max allocated size:      %u\n", sh_atomic_get(&g_stat.alloc_size_max));
+	log_dump("     allocs:                  %u\n", sh_atomic_get(&stat.full_alloc_count));
+	log_dump("     freeds:                  %u\n", sh_atomic_get(&stat.free_count));
+	log_dump("     reallocs:                %u\n", sh_atomic_get(&stat.realloc_count));
+	log_dump("     failed:                  %u\n", sh_atomic_get(&stat.fail_count));
+	log_dump("     allocated:               %u\n", sh_atomic_get(&stat.alloc_count));
+	log_dump("     allocated size:          %u\n", sh_atomic_get(&stat.alloc_size));
+	log_dump("     max allocated size:      %u\n", sh_atomic_get(&stat.alloc_size_max));
+
+	if ( g_nSampleRate != 0 )  {
+		uint64_t	arHist[MEMORY_HIST_BUCKETS];
+		size_t		i, n;
+
+		n = getHistogram(arHist, MEMORY_HIST_BUCKETS);
+		log_dump("     sampled sizes (1/%u):\n", g_nSampleRate);
+		for(i=0; i<n; i++)  {
+			if ( arHist[i] != 0 )  {
+				log_dump("         %10llu..%-10llu  %llu\n", 1ULL<<i, (2ULL<<i)-1, arHist[i]);
+			}
+		}
+	}
+
+#if CARBON_SLAB_ALLOCATOR
+	slab_stat_t		slabStat;
+
+	slabGetStat(&slabStat);
+	log_dump("     slab allocs:             %llu\n", slabStat.alloc_count);
+	log_dump("     slab freeds:             %llu (remote %llu)\n",
+			 slabStat.free_count, slabStat.remote_free_count);
+	log_dump("     slab hits/misses:        %llu/%llu\n",
+			 slabStat.hit_count, slabStat.miss_count);
+	log_dump("     slab size:               %llu (%llu thread caches)\n",
+			 slabStat.chunk_size, slabStat.cache_count);
+#endif /* CARBON_SLAB_ALLOCATOR */
 }
 
 #if CARBON_MALLOC
 
-static void update_max_value(size_t nSize)
+static void update_max_value(int64_t nSize)
 {
-	size_t		nOldSize;
+	int64_t		nOldSize;
 	int 		i = 20;
 
 	do {
-		nOldSize = (size_t)sh_atomic_get(&g_stat.alloc_size_max);
+		nOldSize = g_nAllocSizeMax;
 	} while ( nOldSize < nSize &&
-			  !sh_atomic_cas(&g_stat.alloc_size_max, nOldSize, nSize)
+			  !__sync_bool_compare_and_swap(&g_nAllocSizeMax, nOldSize, nSize)
 			  && i-- > 0);
 }
 
+/*
+ * Account allocated size change, flush the shard delta
+ * to the global counter when the batch is exceeded
+ */
+static inline void stat_size(memory_shard_t* pShard, int64_t nDelta)
+{
+	int64_t		nShardDelta, nCurSize;
+
+	nShardDelta = __sync_add_and_fetch(&pShard->size_delta, nDelta);
+	if ( nShardDelta > MEMORY_STAT_BATCH || nShardDelta < -MEMORY_STAT_BATCH )  {
+		__sync_sub_and_fetch(&pShard->size_delta, nShardDelta);
+		nCurSize = __sync_add_and_fetch(&g_nAllocSize, nShardDelta);
+		if ( nShardDelta > 0 )  {
+			update_max_value(nCurSize);
+		}
+	}
+}
+
+/*
+ * Sample allocation size, the interval is randomised
+ * around the sample rate to avoid aliasing with periodic
+ * allocation patterns
+ */
+static inline void stat_sample(memory_shard_t* pShard, size_t nSize)
+{
+	unsigned	nRate = g_nSampleRate;
+	size_t		nBucket;
+
+	if ( nRate != 0 && t_nSample-- == 0 )  {
+		t_nSampleSeed = t_nSampleSeed*1103515245 + 12345;
+		t_nSample = (t_nSampleSeed>>16)%(nRate*2);
+
+		nBucket = nSize != 0 ? (size_t)(63-__builtin_clzll(nSize)) : 0;
+		__sync_add_and_fetch(&pShard->arHist[sh_min(nBucket, MEMORY_HIST_BUCKETS-1)], 1);
+	}
+}
+
 static void stat_alloc(size_t nSize)
 {
-	size_t nCurSize;
+	memory_shard_t*		pShard = get_shard();
 
-	sh_atomic_inc(&g_stat.full_alloc_count);
-	sh_atomic_inc(&g_stat.alloc_count);
-	nCurSize = sh_atomic_add(&g_stat.alloc_size, nSize);
-	update_max_value(nCurSize);
+	__sync_add_and_fetch(&pShard->full_alloc_count, 1);
+	stat_size(pShard, (int64_t)nSize);
+	stat_sample(pShard, nSize);
 }
 
 static void stat_free(size_t nSize)
 {
-	sh_atomic_inc(&g_stat.free_count);
-	sh_atomic_dec(&g_stat.alloc_count);
-	sh_atomic_sub(&g_stat.alloc_size, nSize);
+	memory_shard_t*		pShard = get_shard();
+
+	__sync_add_and_fetch(&pShard->free_count, 1);
+	stat_size(pShard, -(int64_t)nSize);
 }
 
 static void stat_realloc(ssize_t nDelta)
 {
-	size_t nCurSize;
+	memory_shard_t*		pShard = get_shard();
 
-	sh_atomic_inc(&g_stat.realloc_count);
-	nCurSize = sh_atomic_add(&g_stat.alloc_size, nDelta);
-	update_max_value(nCurSize);
+	__sync_add_and_fetch(&pShard->realloc_count, 1);
+	stat_size(pShard, (int64_t)nDelta);
 }
 
 static void stat_failed()
 {
-	sh_atomic_inc(&g_stat.fail_count);
+	__sync_add_and_fetch(&get_shard()->fail_count, 1);
 }
 
 #define EXT_SZ				(sizeof(extp_t))
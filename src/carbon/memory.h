@@ -17,6 +17,12 @@
  *  Revision 3.0, 19.10.2018 17:36:29
  *  	Removed deprecated glibc memory hooks and
  *  	redefine weak malloc/free functions.
+ *
+ *  Revision 3.1, 17.10.2026 14:31:18
+ *  	Added slab allocator statistic.
+ *
+ *  Revision 3.2, 17.10.2026 15:10:30
+ *  	Per-thread sharded counters, allocation size sampling.
  */
 
 #ifndef __CARBON_MEMORY_H_INCLUDED__
@@ -29,6 +35,11 @@
 
 #include "carbon/module.h"
 
+/*
+ * Sampled allocation size histogram buckets (power of 2 sizes)
+ */
+#define MEMORY_HIST_BUCKETS			32
+
 /*
  * Statistic data for the Memory Manager
  */
@@ -40,6 +51,14 @@ typedef struct  {
 	atomic_t	alloc_size_max;				/* Max. simultaneously allocated size */
 	atomic_t	realloc_count;				/* Reallocated blocks */
 	atomic_t	fail_count;					/* Fail count */
+
+	/* Slab allocator (CEvent, CTimer, CMediaFrame objects) */
+	atomic_t	slab_alloc_count;			/* Allocated objects */
+	atomic_t	slab_free_count;			/* Freed objects */
+	atomic_t	slab_hit_count;				/* Allocations served by a thread cache */
+	atomic_t	slab_miss_count;			/* Allocations required a new chunk */
+	atomic_t	slab_remote_free_count;		/* Objects freed by a non-owner thread */
+	atomic_t	slab_size;					/* Memory taken by the slab chunks, bytes */
 } __attribute__ ((packed)) memory_stat_t;
 
 /*
@@ -57,6 +76,10 @@ class CMemoryManager : public CModule
 		virtual void getStat(void* pBuffer, size_t nSize) const;
 		virtual void resetStat();
 
+		/* Allocation size sampling */
+		void setSampleRate(unsigned int nRate);
+		size_t getHistogram(uint64_t* arCount, size_t nCount) const;
+
 	public:
 		virtual void dump(const char* strPref = "") const;
 };
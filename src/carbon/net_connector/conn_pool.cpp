@@ -0,0 +1,490 @@
+/*
+ *  Carbon framework
+ *  Keep-alive client connection pool
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 02:20:36
+ *      Initial revision.
+ */
+
+#include <poll.h>
+
+#include "carbon/logger.h"
+#include "carbon/net_connector/conn_pool.h"
+
+#define CONN_POOL_PURGE_INTERVAL		HR_1SEC
+
+/*
+ * Idle connection
+ */
+typedef struct
+{
+	CSocketRef*		pSocket;			/* Connected socket */
+	hr_time_t		hrCreated;			/* Connection time */
+	hr_time_t		hrIdle;				/* Release time */
+} conn_pool_idle_t;
+
+/*
+ * Pool destination
+ */
+class CConnPoolHost
+{
+	public:
+		CString							m_strKey;		/* Destination key */
+		std::vector<conn_pool_idle_t>	m_arIdle;		/* Idle connections, the most recent last */
+		size_t							m_nActive;		/* Acquired connections */
+
+	public:
+		CConnPoolHost(const char* strKey) :
+			m_strKey(strKey),
+			m_nActive(0)
+		{
+		}
+
+		~CConnPoolHost()
+		{
+			shell_assert(m_arIdle.empty());
+		}
+};
+
+/*******************************************************************************
+ * CConnPool class
+ */
+
+CConnPool::CConnPool(size_t nIdleMax, size_t nActiveMax, hr_time_t hrIdleTimeout, hr_time_t hrTtl) :
+	m_nIdleMax(nIdleMax),
+	m_nActiveMax(nActiveMax),
+	m_hrIdleTimeout(hrIdleTimeout),
+	m_hrTtl(hrTtl),
+	m_hrPurge(HR_0)
+{
+	counter_reset_struct(m_stat);
+}
+
+CConnPool::~CConnPool()
+{
+	size_t	i;
+
+	clear();
+
+	for(i=0; i<m_arHost.size(); i++)  {
+		shell_assert(m_arHost[i]->m_nActive == 0);
+		delete m_arHost[i];
+	}
+	m_arHost.clear();
+}
+
+/*
+ * Setup the pool limits
+ *
+ * 		nIdleMax			maximum idle connections per destination (0 - pool disabled)
+ * 		nActiveMax			maximum acquired connections per destination (0 - unlimited)
+ * 		hrIdleTimeout		maximum connection idle time
+ * 		hrTtl				maximum connection lifetime
+ */
+void CConnPool::setLimits(size_t nIdleMax, size_t nActiveMax, hr_time_t hrIdleTimeout, hr_time_t hrTtl)
+{
+	m_cond.lock();
+	m_nIdleMax = nIdleMax;
+	m_nActiveMax = nActiveMax;
+	m_hrIdleTimeout = hrIdleTimeout;
+	m_hrTtl = hrTtl;
+	m_hrPurge = HR_0;
+	m_cond.wakeup();
+	m_cond.unlock();
+
+	purge();
+}
+
+void CConnPool::getLimits(size_t* pnIdleMax, size_t* pnActiveMax, hr_time_t* phrIdleTimeout,
+						  hr_time_t* phrTtl) const
+{
+	CAutoLock	locker(m_cond);
+
+	if ( pnIdleMax )  {
+		*pnIdleMax = m_nIdleMax;
+	}
+	if ( pnActiveMax )  {
+		*pnActiveMax = m_nActiveMax;
+	}
+	if ( phrIdleTimeout )  {
+		*phrIdleTimeout = m_hrIdleTimeout;
+	}
+	if ( phrTtl )  {
+		*phrTtl = m_hrTtl;
+	}
+}
+
+/*
+ * Find or create a destination
+ *
+ * 		strKey		destination key
+ *
+ * Return: destination
+ *
+ * Note: pool must be locked.
+ */
+CConnPoolHost* CConnPool::findHost(const char* strKey)
+{
+	CConnPoolHost*	pHost;
+	size_t			i;
+
+	for(i=0; i<m_arHost.size(); i++)  {
+		if ( m_arHost[i]->m_strKey == strKey )  {
+			return m_arHost[i];
+		}
+	}
+
+	pHost = new CConnPoolHost(strKey);
+	m_arHost.push_back(pHost);
+	return pHost;
+}
+
+/*
+ * Check the idle connection was not closed by the peer
+ *
+ * 		pSocket		idle connection
+ *
+ * Return: TRUE if the connection may be reused
+ */
+boolean_t CConnPool::isAlive(CSocketRef* pSocket) const
+{
+	struct pollfd	pfd;
+	int				n;
+
+	if ( !pSocket->isOpen() || pSocket->getReadAhead() > 0 )  {
+		return FALSE;
+	}
+
+	/* Idle connection has no input: any data or EOF means it can't be reused */
+	pfd.fd = pSocket->getHandle();
+	pfd.events = POLLIN|POLLPRI;
+	pfd.revents = 0;
+
+	n = ::poll(&pfd, 1, 0);
+	return n == 0;
+}
+
+/*
+ * Remove expired idle connections of the destination
+ *
+ * 		pHost			destination
+ * 		hrNow			current time
+ * 		arClose			OUT: connections to close
+ *
+ * Note: pool must be locked.
+ */
+void CConnPool::purgeHost(CConnPoolHost* pHost, hr_time_t hrNow, std::vector<CSocketRef*>& arClose)
+{
+	size_t	i = 0;
+
+	while ( i < pHost->m_arIdle.size() )  {
+		const conn_pool_idle_t&		idle = pHost->m_arIdle[i];
+
+		if ( (hrNow-idle.hrIdle) >= m_hrIdleTimeout || (hrNow-idle.hrCreated) >= m_hrTtl ||
+				pHost->m_arIdle.size() > m_nIdleMax )
+		{
+			arClose.push_back(idle.pSocket);
+			pHost->m_arIdle.erase(pHost->m_arIdle.begin()+i);
+			counter_inc(m_stat.stale);
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+void CConnPool::closeSockets(std::vector<CSocketRef*>& arClose)
+{
+	size_t	i;
+
+	for(i=0; i<arClose.size(); i++)  {
+		arClose[i]->close();
+		arClose[i]->release();
+	}
+	arClose.clear();
+}
+
+/*
+ * Take an idle connection or reserve a slot for the new one
+ *
+ * 		pConn			OUT: connection
+ * 		pHost			destination
+ * 		hrTimeout		maximum time to wait for a free slot
+ * 		bNew			TRUE: do not reuse idle connections
+ *
+ * Return:
+ * 		ESUCCESS		idle connection is taken
+ * 		ENOENT			no idle connections, a slot is reserved for the new connection
+ * 		ETIMEDOUT		destination concurrency limit is reached
+ *
+ * Note: pool must be locked.
+ */
+result_t CConnPool::takeIdle(conn_pool_conn_t* pConn, CConnPoolHost* pHost, hr_time_t hrTimeout,
+							 boolean_t bNew)
+{
+	std::vector<CSocketRef*>	arClose;
+	hr_time_t					hrStart = hr_time_now(), hrNow, hrRest;
+	result_t					nresult;
+
+	while ( m_nActiveMax != 0 && pHost->m_nActive >= m_nActiveMax )  {
+		hrRest = hr_timeout(hrStart, hrTimeout);
+		if ( hrRest == HR_0 )  {
+			counter_inc(m_stat.busy);
+			return ETIMEDOUT;
+		}
+		m_cond.waitTimed(hr_time_now()+hrRest);
+	}
+
+	pHost->m_nActive++;
+	nresult = ENOENT;
+
+	hrNow = hr_time_now();
+	purgeHost(pHost, hrNow, arClose);
+
+	while ( !bNew && !pHost->m_arIdle.empty() )  {
+		conn_pool_idle_t	idle = pHost->m_arIdle.back();
+
+		pHost->m_arIdle.pop_back();
+		if ( isAlive(idle.pSocket) )  {
+			pConn->pSocket = idle.pSocket;
+			pConn->hrCreated = idle.hrCreated;
+			pConn->bReused = TRUE;
+			nresult = ESUCCESS;
+			break;
+		}
+
+		arClose.push_back(idle.pSocket);
+		counter_inc(m_stat.stale);
+	}
+
+	if ( nresult == ESUCCESS )  {
+		counter_inc(m_stat.hit);
+	}
+	else {
+		counter_inc(m_stat.miss);
+	}
+
+	m_cond.unlock();
+	closeSockets(arClose);
+	m_cond.lock();
+
+	return nresult;
+}
+
+/*
+ * Acquire a connection to the TCP host
+ *
+ * 		pConn			OUT: connection
+ * 		dstAddr			destination host
+ * 		bindAddr		source address (may be NETADDR_NULL)
+ * 		hrTimeout		maximum connect (including waiting for a free slot) time
+ * 		bNew			TRUE: make a new connection only
+ *
+ * Return: ESUCCESS, ETIMEDOUT, ...
+ */
+result_t CConnPool::acquire(conn_pool_conn_t* pConn, const CNetAddr& dstAddr, const CNetAddr& bindAddr,
+							hr_time_t hrTimeout, boolean_t bNew)
+{
+	CNetAddr		dst(dstAddr), bind(bindAddr);
+	char			strKey[128];
+	hr_time_t		hrStart = hr_time_now();
+	result_t		nresult;
+
+	_tsnprintf(strKey, sizeof(strKey), "%s/%s", dst.cs(), bind.isValid() ? bind.cs() : "");
+
+	pConn->pSocket = 0;
+	pConn->bReused = FALSE;
+
+	m_cond.lock();
+	pConn->pHost = findHost(strKey);
+	nresult = takeIdle(pConn, pConn->pHost, hrTimeout, bNew);
+	m_cond.unlock();
+
+	if ( nresult != ENOENT )  {
+		return nresult;
+	}
+
+	pConn->pSocket = new CSocketRef;
+	pConn->hrCreated = hr_time_now();
+	nresult = pConn->pSocket->connect(dstAddr, hr_timeout(hrStart, hrTimeout), bindAddr);
+	if ( nresult != ESUCCESS )  {
+		release(pConn, FALSE);
+	}
+
+	return nresult;
+}
+
+/*
+ * Acquire a connection to the UNIX local socket
+ *
+ * 		pConn			OUT: connection
+ * 		strSocket		local socket path
+ * 		hrTimeout		maximum connect (including waiting for a free slot) time
+ * 		bNew			TRUE: make a new connection only
+ *
+ * Return: ESUCCESS, ETIMEDOUT, ...
+ */
+result_t CConnPool::acquire(conn_pool_conn_t* pConn, const char* strSocket,
+							hr_time_t hrTimeout, boolean_t bNew)
+{
+	char			strKey[128];
+	hr_time_t		hrStart = hr_time_now();
+	result_t		nresult;
+
+	_tsnprintf(strKey, sizeof(strKey), "unix:%s", strSocket);
+
+	pConn->pSocket = 0;
+	pConn->bReused = FALSE;
+
+	m_cond.lock();
+	pConn->pHost = findHost(strKey);
+	nresult = takeIdle(pConn, pConn->pHost, hrTimeout, bNew);
+	m_cond.unlock();
+
+	if ( nresult != ENOENT )  {
+		return nresult;
+	}
+
+	pConn->pSocket = new CSocketRef;
+	pConn->hrCreated = hr_time_now();
+	nresult = pConn->pSocket->connect(strSocket, hr_timeout(hrStart, hrTimeout), SOCKET_TYPE_STREAM);
+	if ( nresult != ESUCCESS )  {
+		release(pConn, FALSE);
+	}
+
+	return nresult;
+}
+
+/*
+ * Release an acquired connection
+ *
+ * 		pConn		connection
+ * 		bKeep		TRUE: keep the connection for the reuse (the I/O succeeded),
+ * 					FALSE: close the connection
+ */
+void CConnPool::release(conn_pool_conn_t* pConn, boolean_t bKeep)
+{
+	std::vector<CSocketRef*>	arClose;
+	CConnPoolHost*				pHost = pConn->pHost;
+	hr_time_t					hrNow = hr_time_now();
+
+	shell_assert(pHost);
+
+	m_cond.lock();
+
+	shell_assert(pHost->m_nActive > 0);
+	pHost->m_nActive--;
+
+	if ( pConn->pSocket )  {
+		if ( bKeep && pConn->pSocket->isOpen() && pHost->m_arIdle.size() < m_nIdleMax &&
+				(hrNow-pConn->hrCreated) < m_hrTtl )
+		{
+			conn_pool_idle_t	idle;
+
+			idle.pSocket = pConn->pSocket;
+			idle.hrCreated = pConn->hrCreated;
+			idle.hrIdle = hrNow;
+			pHost->m_arIdle.push_back(idle);
+		}
+		else {
+			arClose.push_back(pConn->pSocket);
+		}
+	}
+
+	if ( m_nActiveMax != 0 )  {
+		m_cond.wakeup();
+	}
+
+	m_cond.unlock();
+
+	pConn->pSocket = 0;
+	pConn->pHost = 0;
+	closeSockets(arClose);
+
+	purge();
+}
+
+/*
+ * Close the expired idle connections of all destinations
+ * (not more often than once per CONN_POOL_PURGE_INTERVAL)
+ */
+void CConnPool::purge()
+{
+	std::vector<CSocketRef*>	arClose;
+	hr_time_t					hrNow = hr_time_now();
+	size_t						i;
+
+	m_cond.lock();
+	if ( (hrNow-m_hrPurge) >= CONN_POOL_PURGE_INTERVAL )  {
+		m_hrPurge = hrNow;
+		for(i=0; i<m_arHost.size(); i++)  {
+			purgeHost(m_arHost[i], hrNow, arClose);
+		}
+	}
+	m_cond.unlock();
+
+	closeSockets(arClose);
+}
+
+/*
+ * Close all idle connections
+ */
+void CConnPool::clear()
+{
+	std::vector<CSocketRef*>	arClose;
+	size_t						i, j;
+
+	m_cond.lock();
+	for(i=0; i<m_arHost.size(); i++)  {
+		CConnPoolHost*	pHost = m_arHost[i];
+
+		for(j=0; j<pHost->m_arIdle.size(); j++)  {
+			arClose.push_back(pHost->m_arIdle[j].pSocket);
+		}
+		pHost->m_arIdle.clear();
+	}
+	m_cond.unlock();
+
+	closeSockets(arClose);
+}
+
+size_t CConnPool::getIdleCount() const
+{
+	CAutoLock	locker(m_cond);
+	size_t		i, count = 0;
+
+	for(i=0; i<m_arHost.size(); i++)  {
+		count += m_arHost[i]->m_arIdle.size();
+	}
+
+	return count;
+}
+
+/*******************************************************************************
+ * Debugging support
+ */
+
+#if CARBON_DEBUG_DUMP
+
+void CConnPool::dump(const char* strPref) const
+{
+	CAutoLock	locker(m_cond);
+	size_t		i;
+
+	log_dump("%sConnection pool: %u destination(s), hit %u, miss %u, stale %u, busy %u\n",
+			 strPref, (unsigned)m_arHost.size(), counter_get(m_stat.hit), counter_get(m_stat.miss),
+			 counter_get(m_stat.stale), counter_get(m_stat.busy));
+
+	for(i=0; i<m_arHost.size(); i++)  {
+		log_dump("    %s: idle %u, active %u\n", m_arHost[i]->m_strKey.cs(),
+				 (unsigned)m_arHost[i]->m_arIdle.size(), (unsigned)m_arHost[i]->m_nActive);
+	}
+}
+
+#endif /* CARBON_DEBUG_DUMP */
@@ -0,0 +1,133 @@
+/*
+ *  Carbon framework
+ *  Keep-alive client connection pool
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 02:20:36
+ *      Initial revision.
+ */
+/*
+ * Purpose:
+ *      Per-destination pool of the idle connected stream sockets (TCP host
+ *      or UNIX local socket). A caller acquires a connection, performs I/O
+ *      and releases the connection back to the pool on success or closes
+ *      it on failure.
+ *
+ *      An idle connection is reused only if it is not older than the TTL,
+ *      has been idle less than the idle timeout and the peer did not close
+ *      it (the socket has no pending input and no errors). A number of
+ *      simultaneously acquired connections per destination may be limited,
+ *      the caller waits for a free slot within the I/O timeout.
+ *
+ *      The idle timeout should be shorter than the peer keep-alive timeout
+ *      (see CTcpServer::setKeepAlive()), so the peer never closes a connection
+ *      being reused.
+ *
+ * Limits:
+ *      nIdleMax            maximum idle connections per destination (0 - pool disabled)
+ *      nActiveMax          maximum acquired connections per destination (0 - unlimited)
+ *      hrIdleTimeout       maximum connection idle time
+ *      hrTtl               maximum connection lifetime
+ */
+
+#ifndef __CARBON_CONN_POOL_H_INCLUDED__
+#define __CARBON_CONN_POOL_H_INCLUDED__
+
+#include <vector>
+
+#include "shell/config.h"
+#include "shell/hr_time.h"
+#include "shell/netaddr.h"
+#include "shell/counter.h"
+#include "shell/socket.h"
+
+#include "carbon/lock.h"
+#include "carbon/cstring.h"
+
+#define CONN_POOL_IDLE_MAX				4
+#define CONN_POOL_ACTIVE_MAX			0
+#define CONN_POOL_IDLE_TIMEOUT			HR_4SEC
+#define CONN_POOL_TTL					HR_5MIN
+
+/*
+ * Pool statistic data
+ */
+typedef struct
+{
+	counter_t	hit;					/* Idle connection reused */
+	counter_t	miss;					/* New connection required */
+	counter_t	stale;					/* Idle connections closed by the peer or expired */
+	counter_t	busy;					/* Destination concurrency limit timeouts */
+} __attribute__ ((packed)) conn_pool_stat_t;
+
+class CConnPoolHost;
+
+/*
+ * Acquired connection
+ */
+typedef struct
+{
+	CSocketRef*			pSocket;		/* Connected socket */
+	CConnPoolHost*		pHost;			/* Destination */
+	hr_time_t			hrCreated;		/* Connection time */
+	boolean_t			bReused;		/* TRUE: idle connection has been reused */
+} conn_pool_conn_t;
+
+class CConnPool
+{
+	protected:
+		std::vector<CConnPoolHost*>	m_arHost;			/* Destinations, never removed */
+		mutable CCondition			m_cond;				/* Pool lock/free slot condition */
+
+		size_t						m_nIdleMax;			/* Maximum idle connections per destination */
+		size_t						m_nActiveMax;		/* Maximum acquired connections per destination */
+		hr_time_t					m_hrIdleTimeout;	/* Maximum idle time */
+		hr_time_t					m_hrTtl;			/* Maximum connection lifetime */
+		hr_time_t					m_hrPurge;			/* Last expired connections purge time */
+
+		conn_pool_stat_t			m_stat;				/* Pool statistic */
+
+	public:
+		CConnPool(size_t nIdleMax = CONN_POOL_IDLE_MAX, size_t nActiveMax = CONN_POOL_ACTIVE_MAX,
+				  hr_time_t hrIdleTimeout = CONN_POOL_IDLE_TIMEOUT, hr_time_t hrTtl = CONN_POOL_TTL);
+		virtual ~CConnPool();
+
+	public:
+		void setLimits(size_t nIdleMax, size_t nActiveMax, hr_time_t hrIdleTimeout, hr_time_t hrTtl);
+		void getLimits(size_t* pnIdleMax, size_t* pnActiveMax, hr_time_t* phrIdleTimeout,
+					   hr_time_t* phrTtl) const;
+
+		result_t acquire(conn_pool_conn_t* pConn, const CNetAddr& dstAddr, const CNetAddr& bindAddr,
+						 hr_time_t hrTimeout, boolean_t bNew = FALSE);
+		result_t acquire(conn_pool_conn_t* pConn, const char* strSocket,
+						 hr_time_t hrTimeout, boolean_t bNew = FALSE);
+		void release(conn_pool_conn_t* pConn, boolean_t bKeep);
+
+		void purge();
+		void clear();
+
+		const conn_pool_stat_t* getStat() const { return &m_stat; }
+		void resetStat() { counter_reset_struct(m_stat); }
+
+		size_t getIdleCount() const;
+
+	private:
+		CConnPoolHost* findHost(const char* strKey);
+		result_t takeIdle(conn_pool_conn_t* pConn, CConnPoolHost* pHost, hr_time_t hrTimeout,
+						  boolean_t bNew);
+		void purgeHost(CConnPoolHost* pHost, hr_time_t hrNow, std::vector<CSocketRef*>& arClose);
+		boolean_t isAlive(CSocketRef* pSocket) const;
+		void closeSockets(std::vector<CSocketRef*>& arClose);
+
+#if CARBON_DEBUG_DUMP
+	public:
+		virtual void dump(const char* strPref = "") const;
+#endif /* CARBON_DEBUG_DUMP */
+};
+
+#endif /* __CARBON_CONN_POOL_H_INCLUDED__ */
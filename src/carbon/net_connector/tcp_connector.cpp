@@ -14,6 +14,9 @@
  *  Revision 3.0, 10.05.2017 10:48:56
  *  	Separated CNetConnector class to CTcpConnector and CUdpConnectior
  *
+ *  Revision 3.1, 18.10.2026 02:48:10
+ *  	Added keep-alive connection pool
+ *
  */
 
 #include <new>
@@ -289,9 +292,9 @@ result_t CTcpConnector::sendSync(CNetContainer* pContainer, CSocketRef* pSocket)
 			hr_time_t hrTimeout;
 
 			getTimeouts(&hrTimeout, 0);
-			nresult = pEventLoop->waitSync(hrTimeout + HR_30SEC);
+			nresult = pEventLoop->waitSync(&syncer, hrTimeout + HR_30SEC);
 		}
-		pEventLoop->detachSync();
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_GEN, "[tcpconn] event loop is not found\n");
@@ -320,9 +323,9 @@ result_t CTcpConnector::sendSync(CNetContainer* pContainer, const char* strSocke
 			hr_time_t hrTimeout;
 
 			getTimeouts(&hrTimeout, 0);
-			nresult = pEventLoop->waitSync(hrTimeout + HR_30SEC);
+			nresult = pEventLoop->waitSync(&syncer, hrTimeout + HR_30SEC);
 		}
-		pEventLoop->detachSync();
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_GEN, "[tcpconn] event loop is not found\n");
@@ -405,14 +408,14 @@ result_t CTcpConnector::ioSync(CNetContainer* pContainer, const CNetAddr& destAd
 			hr_time_t hrSendTimeout, hrRecvTimeout;
 
 			getTimeouts(&hrSendTimeout, &hrRecvTimeout);
-			nresult = pEventLoop->waitSync(hrSendTimeout + hrRecvTimeout +
-											   getConnectTimeout() + HR_30SEC);
+			nresult = pEventLoop->waitSync(&syncer, hrSendTimeout + hrRecvTimeout +
+											            getConnectTimeout() + HR_30SEC);
 			if ( nresult == ESUCCESS )  {
 				*ppOutContainer = syncer.getContainer();
 				(*ppOutContainer)->reference();
 			}
 		}
-		pEventLoop->detachSync();
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_GEN, "[tcpconn] event loop is not found\n");
@@ -424,9 +427,23 @@ result_t CTcpConnector::ioSync(CNetContainer* pContainer, const CNetAddr& destAd
 }
 
 
+void CTcpConnector::getStat(void* pBuffer, size_t nSize) const
+{
+    tcpconn_stat_t              stat;
+    const conn_pool_stat_t*     pPoolStat = m_connPool.getStat();
+    size_t                      rsize = sh_min(nSize, sizeof(stat));
+
+    UNALIGNED_MEMCPY(&stat, &m_stat, sizeof(stat));
+    counter_set(stat.pool_hit, counter_get(pPoolStat->hit));
+    counter_set(stat.pool_miss, counter_get(pPoolStat->miss));
+
+    UNALIGNED_MEMCPY(pBuffer, &stat, rsize);
+}
+
 void CTcpConnector::resetStat()
 {
     counter_reset_struct(m_stat);
+    m_connPool.resetStat();
 }
 
 
@@ -506,6 +523,7 @@ void CTcpConnector::terminate()
 {
 	stopListen();
 	m_pWorkerPool->stop();
+	m_connPool.clear();
 
 	if ( (CNetContainer*)m_pRecvTempl ) {
 		shell_assert_ex(m_pRecvTempl->getRefCount() == 1,
@@ -531,6 +549,8 @@ void CTcpConnector::dump(const char* strPref) const
     log_dump("     I/O errors:              %d\n", counter_get(m_stat.fail));
     log_dump("     pool workers:            %d\n", counter_get(m_stat.worker));
 	log_dump("     pool worker errors:      %d\n", counter_get(m_stat.worker_fail));
+	log_dump("     connection pool hits:    %d\n", counter_get(m_connPool.getStat()->hit));
+	log_dump("     connection pool misses:  %d\n", counter_get(m_connPool.getStat()->miss));
 }
 
 #endif /* CARBON_DEBUG_DUMP */
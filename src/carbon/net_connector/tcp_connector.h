@@ -19,6 +19,9 @@
  *
  *  Revision 3.0, 10.05.2017 10:48:56
  *  	Separated CNetConnector class to CTcpConnector and CUdpConnectior
+ *
+ *  Revision 3.1, 18.10.2026 02:48:10
+ *  	Added keep-alive connection pool for send()/io()/ioSync()
  */
 /*
  * Purpose:
@@ -71,6 +74,13 @@
  *      hr_time_t getConnectTimeout() const;
  *      	Obtain current connect to remote host timeout.
  *
+ *      void setConnPool(size_t nIdleMax, size_t nActiveMax, hr_time_t hrIdleTimeout, hr_time_t hrTtl);
+ *          Setup the outgoing connection pool limits (see carbon/net_connector/conn_pool.h),
+ *          nIdleMax = 0 disables the connection reuse.
+ *
+ *      CConnPool* getConnPool();
+ *          Obtain the outgoing connection pool.
+ *
  *
  * III) Public API:
  *      ~~~~~~~~~~~
@@ -83,7 +93,8 @@
  *
  *      result_t send(CNetContainer* pContainer, const char* strSocket,
  *               		CEventReceiver* pReplyReceiver = 0, seqnum_t sessId = NO_SEQNUM);
- *          Connect/Send/Disconnect a container through a local UNIX socket.
+ *          Connect/Send a container through a local UNIX socket, the connection
+ *          is kept in the pool for the following containers.
  *          A reply packet is send if a pReplyReceiver is not NULL.
  *          Optional event: CEvent, EV_NETCONN_SENT (NPARAM = nresult)
  *
@@ -95,9 +106,9 @@
  *
  *      result_t io(CNetContainer* pContainer, const CNetAddr& destAddr,
  *             			CEventReceiver* pReplyReceiver, seqnum_t sessId);
- *          Connect to the remote host, send a container, receive a reply container,
- *          disconnect from the remote host and send reply containing
- *          a received container.
+ *          Connect to the remote host (or reuse the pooled connection), send a container,
+ *          receive a reply container and send reply containing a received container.
+ *          The connection is returned to the pool on success.
  *
  *          Result event: CEventNetConnRecv, EV_NETCONN_RECV
  *
@@ -118,6 +129,7 @@
 #include "carbon/module.h"
 #include "carbon/event.h"
 #include "carbon/net_container.h"
+#include "carbon/net_connector/conn_pool.h"
 #include "carbon/net_connector/tcp_listen.h"
 #include "carbon/net_connector/tcp_worker.h"
 
@@ -271,6 +283,9 @@ typedef struct
 
     counter_t   worker;					/* Current worker pool thread count */
 	counter_t	worker_fail;			/* Worker request fails */
+
+	counter_t	pool_hit;				/* Outgoing connections reused */
+	counter_t	pool_miss;				/* Outgoing connections made */
 } __attribute__ ((packed)) tcpconn_stat_t;
 
 
@@ -287,6 +302,7 @@ class CTcpConnector : public CModule
         CTcpWorkerPool*       	m_pWorkerPool;      /* I/O Worker threads */
         dec_ptr<CNetContainer>	m_pRecvTempl;	    /* Receive container template */
         size_t                  m_nMaxWorkers;		/* Maximum sumalteniously running workers */
+		CConnPool				m_connPool;			/* Outgoing keep-alive connections */
 
 		tcpconn_stat_t          m_stat;             /* Module statistic */
 
@@ -314,10 +330,7 @@ class CTcpConnector : public CModule
             return sizeof(m_stat);
         }
 
-        virtual void getStat(void* pBuffer, size_t nSize) const {
-            size_t rsize = sh_min(nSize, sizeof(m_stat));
-            UNALIGNED_MEMCPY(pBuffer, &m_stat, rsize);
-        }
+        virtual void getStat(void* pBuffer, size_t nSize) const;
 
         virtual void resetStat();
 
@@ -365,6 +378,18 @@ class CTcpConnector : public CModule
 			return m_pWorkerPool->getConnectTimeout();
 		}
 
+		void setConnPool(size_t nIdleMax, size_t nActiveMax, hr_time_t hrIdleTimeout, hr_time_t hrTtl) {
+			m_connPool.setLimits(nIdleMax, nActiveMax, hrIdleTimeout, hrTtl);
+		}
+
+		CConnPool* getConnPool() {
+			return &m_connPool;
+		}
+
+		result_t keepAlive(CSocketRef* pSocket) {
+			return m_pListenServer->keepAlive(pSocket);
+		}
+
         virtual result_t send(CNetContainer* pContainer, CSocketRef* pSocket,
                             CEventReceiver* pReplyReceiver = 0, seqnum_t sessId = NO_SEQNUM);
 
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 11.06.2015 16:43:08
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Enabled keep-alive client connections.
  */
 
 #include <new>
@@ -21,6 +24,12 @@
 
 #define MODULE_NAME			"tcp_conn_listen"
 
+/*
+ * Idle client connection timeout, must be longer than the
+ * connection pool idle timeout of the clients (CONN_POOL_IDLE_TIMEOUT)
+ */
+#define TCPCONN_KEEPALIVE_TIMEOUT		HR_10SEC
+
 
 /*******************************************************************************
  * CTcpListenServer class
@@ -32,6 +41,7 @@ CTcpListenServer::CTcpListenServer(CTcpConnector* pParent) :
     m_thServer(MODULE_NAME)
 {
     shell_assert(pParent);
+    setKeepAlive(TCPCONN_KEEPALIVE_TIMEOUT);
 }
 
 CTcpListenServer::~CTcpListenServer()
@@ -10,9 +10,19 @@
  *
  *  Revision 1.0, 11.06.2015 18:23:21
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Keep-alive incoming connections, pooled outgoing connections.
+ *
+ *  Revision 1.2, 18.10.2026 03:41:27
+ *      Receive the pipelined containers of a connection in a row.
+ *
+ *  Revision 1.3, 18.10.2026 13:21:40
+ *      Requeue the connection with the buffered containers left after a batch.
  */
 
 #include <new>
+#include <sys/socket.h>
 
 #include "carbon/event.h"
 #include "carbon/packet_io.h"
@@ -28,6 +38,11 @@
 #define TCPCONN_RECV_TIMEOUT          	HR_10SEC
 #define TCPCONN_CONNECT_TIMEOUT			HR_10SEC
 
+/*
+ * Maximum containers received from a connection in a row
+ */
+#define TCPCONN_RECV_BATCH_MAX			256
+
 
 /*******************************************************************************
  * CTcpWorkerItem class
@@ -86,16 +101,13 @@ void CTcpWorkerItem::notifySend(CEventReceiver* pReplyReceiver,
 }
 
 /*
- * Receive a data from socket with default timeout
+ * Receive a container from socket with default timeout and dispatch it
  *
  *      pSocket             open socket
  *
- * Note: Event EV_NETCONN_RECEIVE is received from listen server:
- *          - receive new packet from the net;
- *          - on success: send EV_NETCONN_RECV to the default receiver with no session ID;
- *          - on failed: do nothing
+ * Return: ESUCCESS, ...
  */
-void CTcpWorkerItem::processReceive(CSocketRef* pSocket)
+result_t CTcpWorkerItem::receive(CSocketRef* pSocket)
 {
     CTcpWorkerPool*			pParent = getParent();
     hr_time_t               hrRecvTimeout;
@@ -155,6 +167,58 @@ void CTcpWorkerItem::processReceive(CSocketRef* pSocket)
     else {
         pParent->statFail();
     }
+
+    return nresult;
+}
+
+/*
+ * Receive the containers from socket
+ *
+ *      pSocket             open socket
+ *
+ * Note: Event EV_NETCONN_RECEIVE is received from listen server:
+ *          - receive new packet from the net;
+ *          - on success: send EV_NETCONN_RECV to the default receiver with no session ID,
+ *            receive the following pipelined packets already available on the socket
+ *            and pass the connection back to the listen server to wait for the next packet;
+ *          - packets left in the read-ahead buffer after TCPCONN_RECV_BATCH_MAX packets
+ *            are received on the next EV_NETCONN_DO_CONNECT event queued to this worker;
+ *          - on failed: do nothing
+ */
+void CTcpWorkerItem::processReceive(CSocketRef* pSocket)
+{
+    int             count = 0;
+    char            ch;
+    result_t        nresult;
+
+    while ( (nresult=receive(pSocket)) == ESUCCESS && ++count < TCPCONN_RECV_BATCH_MAX )  {
+        if ( pSocket->getReadAhead() == 0 &&
+                ::recv(pSocket->getHandle(), &ch, 1, MSG_PEEK|MSG_DONTWAIT) <= 0 )  {
+            /* No more data or EOF */
+            break;
+        }
+    }
+
+    if ( nresult != ESUCCESS )  {
+        return;
+    }
+
+    if ( pSocket->getReadAhead() == 0 )  {
+        getParent()->getParent()->keepAlive(pSocket);
+    }
+    else {
+        /* Batch limit reached, the next containers are in the read-ahead buffer */
+        CEventTcpConnDoConnect*     pEvent = 0;
+
+        try {
+            pEvent = new CEventTcpConnDoConnect(this, pSocket);
+            sendEvent(pEvent);
+        }
+        catch(const std::bad_alloc& exc) {
+            log_error(L_NETCONN, "[tcpconn_work] failed to allocate event\n");
+            SAFE_RELEASE(pEvent);
+        }
+    }
 }
 
 /*
@@ -215,8 +279,9 @@ void CTcpWorkerItem::processSend(CNetContainer* pContainer, CSocketRef* pSocket,
 void CTcpWorkerItem::processSendLocal(CNetContainer* pContainer, const char* strSocket,
 							  CEventReceiver* pReplyReceiver, seqnum_t sessId)
 {
-	dec_ptr<CSocketRef>	pSocket = new CSocketRef;
 	CTcpWorkerPool*    	pParent = getParent();
+	CConnPool*			pPool = pParent->getParent()->getConnPool();
+	conn_pool_conn_t	conn;
 	hr_time_t			hrSendTimeout;
 	result_t        	nresult;
 
@@ -225,21 +290,34 @@ void CTcpWorkerItem::processSendLocal(CNetContainer* pContainer, const char* str
 	log_trace(L_NETCONN, "[tcpconn_work(%d)] sending a container to '%s'\n",
 			  sessId, strSocket);
 
-	nresult = pSocket->connect(strSocket, pParent->getConnectTimeout(), SOCKET_TYPE_STREAM);
+	nresult = pPool->acquire(&conn, strSocket, pParent->getConnectTimeout());
 	if ( nresult == ESUCCESS )  {
-		nresult = pContainer->send(*pSocket, hrSendTimeout);
-		if ( nresult == ESUCCESS ) {
-			pParent->statSend();
+		nresult = pContainer->send(*conn.pSocket, hrSendTimeout);
+		if ( nresult != ESUCCESS && conn.bReused )  {
+			/* The peer has closed the idle connection, send once again */
+			pPool->release(&conn, FALSE);
+			nresult = pPool->acquire(&conn, strSocket, pParent->getConnectTimeout(), TRUE);
+			if ( nresult == ESUCCESS )  {
+				nresult = pContainer->send(*conn.pSocket, hrSendTimeout);
+			}
+		}
+	}
 
-			if ( logger_is_enabled(LT_TRACE|L_NETCONN_IO) )  {
-				char    strTmp[128];
+	if ( conn.pSocket )  {
+		pPool->release(&conn, nresult == ESUCCESS);
+	}
 
-				pContainer->getDump(strTmp, sizeof(strTmp));
-				log_trace(L_NETCONN_IO, "[tcpconn_work] <<< Sent container: %s\n", strTmp);
-			}
-			else {
-				log_trace(L_NETCONN, "[tcpconn_work(%d)] container send\n", sessId);
-			}
+	if ( nresult == ESUCCESS )  {
+		pParent->statSend();
+
+		if ( logger_is_enabled(LT_TRACE|L_NETCONN_IO) )  {
+			char    strTmp[128];
+
+			pContainer->getDump(strTmp, sizeof(strTmp));
+			log_trace(L_NETCONN_IO, "[tcpconn_work] <<< Sent container: %s\n", strTmp);
+		}
+		else {
+			log_trace(L_NETCONN, "[tcpconn_work(%d)] container send\n", sessId);
 		}
 	}
 	else {
@@ -247,8 +325,6 @@ void CTcpWorkerItem::processSendLocal(CNetContainer* pContainer, const char* str
 		pParent->statFail();
 	}
 
-	pSocket->close();
-
 	if ( pReplyReceiver ) {
 		notifySend(pReplyReceiver, nresult, sessId);
 	}
@@ -272,7 +348,8 @@ void CTcpWorkerItem::processIo(CNetContainer* pContainer, const CNetAddr& destAd
 
 	shell_assert(pContainer);
     pParent->getTimeouts(&hrSendTimeout, &hrRecvTimeout);
-    CPacketIo	IO(hrSendTimeout+hrRecvTimeout+pParent->getConnectTimeout());
+    CPacketIo	IO(hrSendTimeout+hrRecvTimeout+pParent->getConnectTimeout(),
+				   pParent->getParent()->getConnPool());
 
 	log_trace(L_NETCONN, "[tcpconn_work(%d)] executing I/O...\n", sessId);
 
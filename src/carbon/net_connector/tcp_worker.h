@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 11.06.2015 18:14:54
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 03:41:27
+ *      Receive the pipelined containers of a connection in a row.
  */
 
 #ifndef __CARBON_TCP_WORKER_H_INCLUDED__
@@ -39,6 +42,7 @@ class CTcpWorkerItem : public CThreadPoolItem
 
         virtual boolean_t processEvent(CEvent* pEvent);
 
+        virtual result_t receive(CSocketRef* pSocket);
         virtual void processReceive(CSocketRef* pSocket);
         virtual void processSend(CNetContainer* pContainer, CSocketRef* pSocket,
 							CEventReceiver* pReplyReceiver, seqnum_t sessId);
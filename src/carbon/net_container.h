@@ -10,6 +10,12 @@
  *
  *  Revision 1.0, 19.04.2015 15:11:59
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 18:52:08
+ *      Added scatter/gather send support.
+ *
+ *  Revision 1.2, 18.10.2026 11:24:12
+ *      Added isReceiving().
  */
 
 #ifndef __CARBON_NET_CONTAINER_H_INCLUDED__
@@ -29,6 +35,8 @@
 #define __CNetContainer_PARENT
 #endif /* CARBON_DEBUG_TRACK_OBJECT */
 
+#define NET_CONTAINER_IOV_MAX			32		/* Maximum fragments of a container */
+
 
 class CNetContainer : public CRefObject __CNetContainer_PARENT
 {
@@ -48,6 +56,54 @@ class CNetContainer : public CRefObject __CNetContainer_PARENT
 		virtual result_t send(CSocketAsync& socket, uint32_t* pOffset) { shell_assert(FALSE); return ENOSYS; }
 		virtual result_t receive(CSocketAsync& socket) { shell_assert(FALSE); return ENOSYS; }
 
+		/* TRUE: a part of the container has been received by receive(CSocketAsync&) */
+		virtual boolean_t isReceiving() const { return FALSE; }
+
+		/*
+		 * Optional scatter/gather send support: get the serialised container
+		 * fragments pointing to the container own memory
+		 *
+		 * 		arVec		fragments [out]
+		 * 		pCount		IN: maximum fragments, OUT: fragment count
+		 *
+		 * Return: ESUCCESS, ENOSPC, ENOSYS
+		 */
+		virtual result_t getSendIov(struct iovec* arVec, size_t* pCount) {
+			*pCount = 0;
+			return ENOSYS;
+		}
+
+	protected:
+		/*
+		 * Send fragments returned by the getSendIov() without copying
+		 */
+		result_t sendIov(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr) {
+			struct iovec	arVec[NET_CONTAINER_IOV_MAX];
+			size_t			count = ARRAY_SIZE(arVec);
+			result_t		nresult;
+
+			nresult = getSendIov(arVec, &count);
+			if ( nresult == ESUCCESS )  {
+				nresult = socket.sendv(arVec, count, hrTimeout, dstAddr);
+			}
+			return nresult;
+		}
+
+		result_t sendIov(CSocketAsync& socket, uint32_t* pOffset) {
+			struct iovec	arVec[NET_CONTAINER_IOV_MAX];
+			size_t			count = ARRAY_SIZE(arVec), offset = *pOffset;
+			result_t		nresult;
+
+			nresult = getSendIov(arVec, &count);
+			if ( nresult == ESUCCESS )  {
+				nresult = socket.sendvAsync(arVec, count, &offset);
+				*pOffset = (uint32_t)offset;
+			}
+			return nresult;
+		}
+
+	public:
+
 #if CARBON_DEBUG_DUMP
 		virtual void getDump(char* strBuf, size_t length) const = 0;
 		virtual void dump(const char* strPref = "") const = 0;
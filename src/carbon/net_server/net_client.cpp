@@ -635,8 +635,8 @@ result_t CNetClient::connectSync(const CNetAddr& netAddr, socket_type_t sockType
 	if ( pEventLoop ) {
 		pEventLoop->attachSync(&syncer);
 		connect(netAddr, sessId, sockType);
-		nresult = pEventLoop->waitSync(getConnectTimeout() + HR_30SEC);
-		pEventLoop->detachSync();
+		nresult = pEventLoop->waitSync(&syncer, getConnectTimeout() + HR_30SEC);
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_NETCLI, "[netcli] event loop is not found\n");
@@ -679,8 +679,8 @@ result_t CNetClient::disconnectSync()
 	if ( pEventLoop ) {
 		pEventLoop->attachSync(&syncer);
 		disconnect(sessId);
-		nresult = pEventLoop->waitSync(getConnectTimeout() + HR_30SEC);
-		pEventLoop->detachSync();
+		nresult = pEventLoop->waitSync(&syncer, getConnectTimeout() + HR_30SEC);
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_NETCLI, "[netcli] event loop is not found\n");
@@ -722,8 +722,8 @@ result_t CNetClient::sendSync(CNetContainer* pContainer)
 		getTimeouts(&hrTimeout, NULL);
 		pEventLoop->attachSync(&syncer);
 		send(pContainer, sessId);
-		nresult = pEventLoop->waitSync(hrTimeout + HR_30SEC);
-		pEventLoop->detachSync();
+		nresult = pEventLoop->waitSync(&syncer, hrTimeout + HR_30SEC);
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_NETCLI, "[netcli] event loop is not found\n");
@@ -765,8 +765,8 @@ result_t CNetClient::recvSync(CNetContainer* pContainer)
 		getTimeouts(NULL, &hrTimeout);
 		pEventLoop->attachSync(&syncer);
 		send(pContainer, sessId);
-		nresult = pEventLoop->waitSync(hrTimeout + HR_30SEC);
-		pEventLoop->detachSync();
+		nresult = pEventLoop->waitSync(&syncer, hrTimeout + HR_30SEC);
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_NETCLI, "[netcli] event loop is not found\n");
@@ -809,8 +809,8 @@ result_t CNetClient::ioSync(CNetContainer* pContainer)
 		getTimeouts(&hrSendTimeout, &hrRecvTimeout);
 		pEventLoop->attachSync(&syncer);
 		io(pContainer, sessId);
-		nresult = pEventLoop->waitSync(hrSendTimeout + hrRecvTimeout + HR_30SEC);
-		pEventLoop->detachSync();
+		nresult = pEventLoop->waitSync(&syncer, hrSendTimeout + hrRecvTimeout + HR_30SEC);
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_NETCLI, "[netcli] event loop is not found\n");
@@ -0,0 +1,1069 @@
+/*
+ *  Carbon framework
+ *  Network server epoll reactor
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 16:11:20
+ *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 17:55:02
+ *      Drain the socket read-ahead buffer in doRecv().
+ *
+ *  Revision 1.2, 18.10.2026 11:27:15
+ *      Receive and send timeouts.
+ */
+
+#include <new>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "carbon/carbon.h"
+#include "carbon/net_server/net_server.h"
+#include "carbon/net_server/net_reactor.h"
+
+#define MODULE_NAME			"net_reactor"
+
+/*******************************************************************************
+ * CNetReactorConnection
+ */
+
+CNetReactorConnection::CNetReactorConnection(CSocketRef* pSocket, CNetReactorLoop* pLoop) :
+	CRefObject(),
+	m_pSocket(pSocket),
+	m_pLoop(pLoop),
+	m_pSend(0),
+	m_nSendOffset(0),
+	m_nEvents(0),
+	m_bFailSent(FALSE),
+	m_pSendHead(0),
+	m_pSendTail(0),
+	m_pNextPending(0),
+	m_bPending(FALSE),
+	m_bClosing(FALSE),
+	m_pNextHash(0)
+{
+	shell_assert(m_pSocket->isOpen());
+	m_pSocket->reference();
+
+	_tbzero_object(m_recvTimer);
+	m_recvTimer.pConnection = this;
+	_tbzero_object(m_sendTimer);
+	m_sendTimer.pConnection = this;
+}
+
+CNetReactorConnection::~CNetReactorConnection()
+{
+	shell_assert(m_pSend == 0);
+	shell_assert(m_pSendHead == 0);
+	shell_assert(m_nEvents == 0);
+	shell_assert(m_recvTimer.hrDeadline == HR_0);
+	shell_assert(m_sendTimer.hrDeadline == HR_0);
+
+	m_pSocket->close();
+}
+
+/*******************************************************************************
+ * CNetReactorLoop
+ */
+
+CNetReactorLoop::CNetReactorLoop() :
+	m_pReactor(0),
+	m_thread(MODULE_NAME),
+	m_hEpoll(-1),
+	m_hEvent(-1),
+	m_bDone(FALSE),
+	m_pPendingHead(0),
+	m_pPendingTail(0)
+{
+	_tbzero_object(m_recvTimers);
+	_tbzero_object(m_sendTimers);
+}
+
+CNetReactorLoop::~CNetReactorLoop()
+{
+	shell_assert(m_hEpoll < 0);
+	shell_assert(m_pPendingHead == 0);
+}
+
+/*
+ * Wake up the I/O thread
+ */
+void CNetReactorLoop::wakeup()
+{
+	uint64_t	value = 1;
+	ssize_t		len;
+
+	len = ::write(m_hEvent, &value, sizeof(value));
+	shell_unused(len);
+}
+
+/*
+ * Put a connection to the pending list and wake up I/O thread
+ *
+ * 		pConnection		connection with a new request
+ *
+ * Note: loop lock must be held
+ */
+void CNetReactorLoop::post(CNetReactorConnection* pConnection)
+{
+	boolean_t	bWakeup = FALSE;
+
+	if ( !pConnection->m_bPending )  {
+		pConnection->m_bPending = TRUE;
+		pConnection->m_pNextPending = 0;
+
+		if ( m_pPendingTail )  {
+			m_pPendingTail->m_pNextPending = pConnection;
+		}
+		else {
+			m_pPendingHead = pConnection;
+			bWakeup = TRUE;
+		}
+		m_pPendingTail = pConnection;
+	}
+
+	if ( bWakeup )  {
+		wakeup();
+	}
+}
+
+/*
+ * Add a new connection to the I/O loop
+ *
+ * 		pConnection		accepted connection, the loop holds its own reference
+ * 						until the connection is closed
+ */
+void CNetReactorLoop::postConnection(CNetReactorConnection* pConnection)
+{
+	CAutoLock	locker(m_lock);
+
+	pConnection->reference();
+	post(pConnection);
+}
+
+/*
+ * Queue a container to send
+ *
+ * 		pConnection		connection to send on
+ * 		pContainer		container to send
+ * 		sessId			unique session Id (NO_SEQNUM - do not send reply)
+ *
+ * Return: ESUCCESS, ENOTCONN (connection is closing)
+ */
+result_t CNetReactorLoop::postSend(CNetReactorConnection* pConnection,
+							   CNetContainer* pContainer, seqnum_t sessId)
+{
+	net_reactor_send_t*		pSend;
+
+	pSend = new net_reactor_send_t;
+	pSend->pNext = 0;
+	pSend->pContainer = pContainer;
+	pSend->sessId = sessId;
+
+	CAutoLock	locker(m_lock);
+
+	if ( pConnection->m_bClosing )  {
+		/* The loop may have already dropped the connection */
+		locker.unlock();
+		delete pSend;
+		return ENOTCONN;
+	}
+
+	pContainer->reference();
+	if ( pConnection->m_pSendTail )  {
+		pConnection->m_pSendTail->pNext = pSend;
+	}
+	else {
+		pConnection->m_pSendHead = pSend;
+	}
+	pConnection->m_pSendTail = pSend;
+
+	post(pConnection);
+
+	return ESUCCESS;
+}
+
+/*
+ * Request to close a connection
+ *
+ * 		pConnection		connection to close
+ */
+void CNetReactorLoop::postClose(CNetReactorConnection* pConnection)
+{
+	CAutoLock	locker(m_lock);
+
+	pConnection->m_bClosing = TRUE;
+	post(pConnection);
+}
+
+void CNetReactorLoop::notifyRecv(CNetReactorConnection* pConnection, CNetContainer* pContainer)
+{
+	CEventNetServerRecv*    pEvent;
+
+	pEvent = new CEventNetServerRecv(m_pReactor->m_pServer->getReceiver(), pContainer,
+									 pConnection->getHandle());
+	appSendEvent(pEvent);
+}
+
+void CNetReactorLoop::notifySend(result_t nOpResult, seqnum_t sessId)
+{
+	CEvent*     pEvent;
+
+	if ( sessId != NO_SEQNUM ) {
+		pEvent = new CEvent(EV_NET_SERVER_SENT, m_pReactor->m_pServer->getReceiver(),
+							(PPARAM)0, (NPARAM)nOpResult, "net_serv_sent");
+		pEvent->setSessId(sessId);
+		appSendEvent(pEvent);
+	}
+}
+
+void CNetReactorLoop::notifyClosed(CNetReactorConnection* pConnection)
+{
+	CEvent*		pEvent;
+
+	if ( !pConnection->m_bFailSent ) {
+		log_trace(L_NETSERV, "[net_reactor] connection closed, sending a notification\n");
+
+		pEvent = new CEvent(EV_NET_SERVER_DISCONNECTED, m_pReactor->m_pServer->getReceiver(),
+							(PPARAM)pConnection->getHandle(), (NPARAM)0,
+							"net_serv_closed_connection");
+		appSendEvent(pEvent);
+		pConnection->m_bFailSent = TRUE;
+	}
+}
+
+/*
+ * Change epoll events of the connection
+ *
+ * 		pConnection		connection
+ * 		nEvents			new events, 0 - remove connection from epoll
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CNetReactorLoop::setEvents(CNetReactorConnection* pConnection, uint32_t nEvents)
+{
+	struct epoll_event	event;
+	int					op, retVal;
+	result_t			nresult = ESUCCESS;
+
+	if ( pConnection->m_nEvents != nEvents )  {
+		op = nEvents == 0 ? EPOLL_CTL_DEL :
+			(pConnection->m_nEvents == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD);
+
+		event.events = nEvents;
+		event.data.ptr = pConnection;
+
+		retVal = ::epoll_ctl(m_hEpoll, op, pConnection->m_pSocket->getHandle(), &event);
+		if ( retVal == 0 )  {
+			pConnection->m_nEvents = nEvents;
+		}
+		else {
+			nresult = errno;
+			log_error(L_NETSERV, "[net_reactor] epoll_ctl(%d) failed, result %d\n", op, nresult);
+			if ( op == EPOLL_CTL_DEL )  {
+				pConnection->m_nEvents = 0;
+			}
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Fail the current and all queued containers
+ *
+ * 		pConnection		connection
+ * 		nSendResult		result code to report
+ */
+void CNetReactorLoop::cancelSend(CNetReactorConnection* pConnection, result_t nSendResult)
+{
+	net_reactor_send_t	*pSend, *pNext;
+
+	m_lock.lock();
+	pSend = pConnection->m_pSendHead;
+	pConnection->m_pSendHead = pConnection->m_pSendTail = 0;
+	m_lock.unlock();
+
+	if ( pConnection->m_pSend )  {
+		pConnection->m_pSend->pNext = pSend;
+		pSend = pConnection->m_pSend;
+		pConnection->m_pSend = 0;
+	}
+
+	while ( pSend )  {
+		pNext = pSend->pNext;
+
+		notifySend(nSendResult, pSend->sessId);
+		pSend->pContainer->release();
+		delete pSend;
+
+		pSend = pNext;
+	}
+}
+
+/*
+ * Start a deadline
+ *
+ * 		pList			deadline list
+ * 		pTimer			connection deadline
+ * 		hrTimeout		timeout, HR_0 - no timeout
+ *
+ * Note: an armed deadline is not restarted
+ */
+void CNetReactorLoop::armTimer(net_reactor_timer_list_t* pList, net_reactor_timer_t* pTimer,
+							   hr_time_t hrTimeout)
+{
+	if ( pTimer->hrDeadline != HR_0 || hrTimeout == HR_0 )  {
+		return;
+	}
+
+	pTimer->hrDeadline = hr_time_now() + hrTimeout;
+	pTimer->pNext = 0;
+	pTimer->pPrev = pList->pTail;
+
+	if ( pList->pTail )  {
+		pList->pTail->pNext = pTimer;
+	}
+	else {
+		pList->pHead = pTimer;
+	}
+	pList->pTail = pTimer;
+}
+
+/*
+ * Stop a deadline
+ *
+ * 		pList			deadline list
+ * 		pTimer			connection deadline
+ */
+void CNetReactorLoop::cancelTimer(net_reactor_timer_list_t* pList, net_reactor_timer_t* pTimer)
+{
+	if ( pTimer->hrDeadline == HR_0 )  {
+		return;
+	}
+
+	if ( pTimer->pPrev )  {
+		pTimer->pPrev->pNext = pTimer->pNext;
+	}
+	else {
+		pList->pHead = pTimer->pNext;
+	}
+
+	if ( pTimer->pNext )  {
+		pTimer->pNext->pPrev = pTimer->pPrev;
+	}
+	else {
+		pList->pTail = pTimer->pPrev;
+	}
+
+	pTimer->pPrev = pTimer->pNext = 0;
+	pTimer->hrDeadline = HR_0;
+}
+
+/*
+ * Close the connections with the expired deadlines
+ *
+ * 		pList			deadline list
+ * 		strOp			operation name for logging
+ *
+ * Result: send EV_NET_SERVER_DISCONNECTED notification for each closed connection
+ */
+void CNetReactorLoop::expireTimers(net_reactor_timer_list_t* pList, const char* strOp)
+{
+	CNetReactorConnection*	pConnection;
+	hr_time_t				hrNow = hr_time_now();
+
+	while ( pList->pHead && pList->pHead->hrDeadline <= hrNow )  {
+		pConnection = pList->pHead->pConnection;
+
+		log_debug(L_NETSERV, "[net_reactor] %s timeout, closing connection %Xh\n",
+				  strOp, pConnection->getHandle());
+		m_pReactor->m_pServer->statFail();
+
+		/* Removes the connection deadlines */
+		closeSocket(pConnection, ETIMEDOUT);
+		notifyClosed(pConnection);
+	}
+}
+
+/*
+ * Get the epoll_wait() timeout to the earliest deadline
+ *
+ * Return: timeout, ms, -1 - no deadlines
+ */
+int CNetReactorLoop::getWaitTimeout() const
+{
+	hr_time_t	hrDeadline = HR_0, hrNow;
+
+	if ( m_recvTimers.pHead )  {
+		hrDeadline = m_recvTimers.pHead->hrDeadline;
+	}
+
+	if ( m_sendTimers.pHead && (hrDeadline == HR_0 || m_sendTimers.pHead->hrDeadline < hrDeadline) )  {
+		hrDeadline = m_sendTimers.pHead->hrDeadline;
+	}
+
+	if ( hrDeadline == HR_0 )  {
+		return -1;
+	}
+
+	hrNow = hr_time_now();
+	if ( hrDeadline <= hrNow )  {
+		return 0;
+	}
+
+	return (int)sh_min(HR_TIME_TO_MILLISECONDS(hrDeadline-hrNow+HR_1MSEC-1),
+					   HR_TIME_TO_MILLISECONDS(HR_1MIN));
+}
+
+/*
+ * Remove a connection from the epoll and close the socket
+ *
+ * 		pConnection		connection
+ * 		nSendResult		result code to report for the queued containers
+ */
+void CNetReactorLoop::closeSocket(CNetReactorConnection* pConnection, result_t nSendResult)
+{
+	setEvents(pConnection, 0);
+	cancelTimer(&m_recvTimers, &pConnection->m_recvTimer);
+	cancelTimer(&m_sendTimers, &pConnection->m_sendTimer);
+	pConnection->m_pSocket->close();
+	pConnection->m_pRecvContainer = 0;
+
+	cancelSend(pConnection, nSendResult);
+}
+
+/*
+ * Final close of a connection and release the loop reference
+ */
+void CNetReactorLoop::closeConnection(CNetReactorConnection* pConnection)
+{
+	log_trace(L_NETSERV, "[net_reactor] closing connection %Xh\n", pConnection->getHandle());
+
+	closeSocket(pConnection, ECANCELED);
+	pConnection->release();
+}
+
+/*
+ * Receive available containers
+ *
+ * 		pConnection		connection
+ *
+ * Result: send EV_NET_SERVER_RECV notification on receive any container
+ */
+void CNetReactorLoop::doRecv(CNetReactorConnection* pConnection)
+{
+	CNetServer*		pServer = m_pReactor->m_pServer;
+	int				i;
+	result_t		nresult;
+
+	/*
+	 * Data left in the socket read-ahead buffer is not reported
+	 * by the epoll, so the buffer is drained regardless of the batch limit
+	 */
+	for(i=0; i<NET_REACTOR_RECV_BATCH || pConnection->m_pSocket->getReadAhead() > 0; i++)  {
+		if ( !(CNetContainer*)pConnection->m_pRecvContainer )  {
+			dec_ptr<CNetContainer>	pContainerOriginal = pServer->getRecvTemplRef();
+
+			shell_assert((CNetContainer*)pContainerOriginal);
+			try {
+				pConnection->m_pRecvContainer = pContainerOriginal->clone();
+			}
+			catch (const std::bad_alloc& exc)  {
+				log_error(L_NETSERV, "[net_reactor] memory allocation failed\n");
+				pServer->statFail();
+				break;
+			}
+		}
+
+		nresult = pConnection->m_pRecvContainer->receive(*pConnection->m_pSocket);
+		if ( nresult == ESUCCESS )  {
+			CNetContainer*	pContainer = pConnection->m_pRecvContainer;
+
+			if ( logger_is_enabled(LT_TRACE|L_NETSERV_IO) ) {
+				char    strTmp[128];
+
+				pContainer->getDump(strTmp, sizeof(strTmp));
+				log_trace(L_NETCONN_IO, "[net_reactor] >>> Recv container: %s\n", strTmp);
+			}
+
+			notifyRecv(pConnection, pContainer);
+			pServer->statRecv();
+			cancelTimer(&m_recvTimers, &pConnection->m_recvTimer);
+			pConnection->m_pRecvContainer = 0;
+			pConnection->m_bFailSent = FALSE;
+			continue;
+		}
+
+		if ( nresult == EAGAIN || nresult == EINTR )  {
+			if ( pConnection->m_pRecvContainer->isReceiving() )  {
+				armTimer(&m_recvTimers, &pConnection->m_recvTimer, pServer->getRecvTimeout());
+			}
+			break;
+		}
+
+		if ( IS_NETWORK_CONNECTION_CLOSED(nresult) )  {
+			log_trace(L_NETSERV, "[net_reactor] receive packet failed, error %d\n", nresult);
+			pServer->statFail();
+			closeSocket(pConnection, ENOTCONN);
+			notifyClosed(pConnection);
+		}
+		else {
+			log_debug(L_NETSERV, "[net_reactor] receive packet failed, error %d\n", nresult);
+			pServer->statFail();
+			cancelTimer(&m_recvTimers, &pConnection->m_recvTimer);
+			pConnection->m_pRecvContainer = 0;
+		}
+		break;
+	}
+}
+
+/*
+ * Send queued containers until the socket buffer is full
+ *
+ * 		pConnection		connection
+ *
+ * Result: send EV_NET_SERVER_SENT notification for each container
+ */
+void CNetReactorLoop::doSend(CNetReactorConnection* pConnection)
+{
+	CNetServer*				pServer = m_pReactor->m_pServer;
+	net_reactor_send_t*		pSend;
+	uint32_t				nEvents = EPOLLIN;
+	result_t				nresult;
+
+	while ( pConnection->m_pSocket->isOpen() )  {
+		if ( !pConnection->m_pSend )  {
+			m_lock.lock();
+			pSend = pConnection->m_pSendHead;
+			if ( pSend )  {
+				pConnection->m_pSendHead = pSend->pNext;
+				if ( !pConnection->m_pSendHead )  {
+					pConnection->m_pSendTail = 0;
+				}
+			}
+			m_lock.unlock();
+
+			if ( !pSend )  {
+				break;
+			}
+
+			pSend->pNext = 0;
+			pConnection->m_pSend = pSend;
+			pConnection->m_nSendOffset = 0;
+		}
+
+		pSend = pConnection->m_pSend;
+		nresult = pSend->pContainer->send(*pConnection->m_pSocket, &pConnection->m_nSendOffset);
+		if ( nresult == EAGAIN || nresult == EINTR )  {
+			armTimer(&m_sendTimers, &pConnection->m_sendTimer, pServer->getSendTimeout());
+			nEvents |= EPOLLOUT;
+			break;
+		}
+
+		pConnection->m_pSend = 0;
+		cancelTimer(&m_sendTimers, &pConnection->m_sendTimer);
+
+		if ( nresult == ESUCCESS )  {
+			if ( logger_is_enabled(LT_TRACE|L_NETSERV_IO) ) {
+				char    strTmp[128];
+
+				pSend->pContainer->getDump(strTmp, sizeof(strTmp));
+				log_trace(L_NETCONN_IO, "[net_reactor] <<< Sent container: %s\n", strTmp);
+			}
+			pServer->statSend();
+			pConnection->m_bFailSent = FALSE;
+		}
+		else {
+			log_error(L_NETSERV, "[net_reactor(%d)] failed to send container, result %d\n",
+					  pSend->sessId, nresult);
+			pServer->statFail();
+		}
+
+		notifySend(nresult, pSend->sessId);
+		pSend->pContainer->release();
+		delete pSend;
+
+		if ( IS_NETWORK_CONNECTION_CLOSED(nresult) )  {
+			closeSocket(pConnection, ENOTCONN);
+			notifyClosed(pConnection);
+		}
+	}
+
+	if ( pConnection->m_pSocket->isOpen() )  {
+		setEvents(pConnection, nEvents);
+	}
+	else {
+		/* Connection has been closed by peer */
+		cancelSend(pConnection, ENOTCONN);
+	}
+}
+
+/*
+ * Process epoll events of a connection
+ *
+ * 		pConnection		connection
+ * 		nEvents			epoll events
+ */
+void CNetReactorLoop::processIo(CNetReactorConnection* pConnection, uint32_t nEvents)
+{
+	if ( nEvents&(EPOLLIN|EPOLLERR|EPOLLHUP) )  {
+		doRecv(pConnection);
+	}
+
+	if ( (nEvents&(EPOLLOUT|EPOLLERR|EPOLLHUP)) && pConnection->m_pSocket->isOpen() )  {
+		doSend(pConnection);
+	}
+}
+
+/*
+ * Process the requests posted by the other threads
+ */
+void CNetReactorLoop::processPending()
+{
+	CNetReactorConnection	*pConnection, *pNext;
+	boolean_t				bClosing;
+
+	m_lock.lock();
+	pConnection = m_pPendingHead;
+	m_pPendingHead = m_pPendingTail = 0;
+	m_lock.unlock();
+
+	while ( pConnection )  {
+		m_lock.lock();
+		pNext = pConnection->m_pNextPending;
+		pConnection->m_pNextPending = 0;
+		pConnection->m_bPending = FALSE;
+		bClosing = pConnection->m_bClosing;
+		m_lock.unlock();
+
+		if ( bClosing )  {
+			closeConnection(pConnection);
+		}
+		else {
+			if ( pConnection->m_nEvents == 0 && pConnection->m_pSocket->isOpen() )  {
+				/* A new connection */
+				if ( setEvents(pConnection, EPOLLIN) != ESUCCESS )  {
+					closeSocket(pConnection, ENOTCONN);
+					notifyClosed(pConnection);
+				}
+			}
+
+			if ( (pConnection->m_nEvents&EPOLLOUT) == 0 )  {
+				doSend(pConnection);
+			}
+		}
+
+		pConnection = pNext;
+	}
+}
+
+/*
+ * I/O thread worker
+ */
+void* CNetReactorLoop::threadIo(CThread* pThread, void* pData)
+{
+	struct epoll_event	arEvent[NET_REACTOR_EVENTS_MAX];
+	uint64_t			value;
+	ssize_t				len;
+	int					i, count;
+
+	shell_unused(pData);
+	pThread->bootCompleted(ESUCCESS);
+
+	while ( !m_bDone )  {
+		count = ::epoll_wait(m_hEpoll, arEvent, NET_REACTOR_EVENTS_MAX, getWaitTimeout());
+		if ( count < 0 )  {
+			if ( errno != EINTR )  {
+				log_error(L_NETSERV, "[net_reactor] epoll_wait() failed, result %d\n", errno);
+				hr_sleep(HR_100MSEC);
+			}
+			continue;
+		}
+
+		for(i=0; i<count; i++)  {
+			if ( arEvent[i].data.ptr != 0 )  {
+				processIo((CNetReactorConnection*)arEvent[i].data.ptr, arEvent[i].events);
+			}
+			else {
+				len = ::read(m_hEvent, &value, sizeof(value));
+				shell_unused(len);
+			}
+		}
+
+		processPending();
+
+		expireTimers(&m_recvTimers, "receive");
+		expireTimers(&m_sendTimers, "send");
+	}
+
+	processPending();
+
+	return NULL;
+}
+
+/*
+ * Create epoll and start I/O thread
+ *
+ * 		pReactor		parent reactor
+ * 		index			loop index
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CNetReactorLoop::init(CNetReactor* pReactor, size_t index)
+{
+	struct epoll_event	event;
+	char				strName[CARBON_OBJECT_NAME_LENGTH];
+	result_t			nresult;
+
+	m_pReactor = pReactor;
+	m_bDone = FALSE;
+
+	m_hEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+	if ( m_hEpoll < 0 )  {
+		nresult = errno;
+		log_error(L_NETSERV, "[net_reactor] failed to create epoll, result %d\n", nresult);
+		return nresult;
+	}
+
+	m_hEvent = ::eventfd(0, EFD_NONBLOCK|EFD_CLOEXEC);
+	if ( m_hEvent < 0 )  {
+		nresult = errno;
+		log_error(L_NETSERV, "[net_reactor] failed to create eventfd, result %d\n", nresult);
+		terminate();
+		return nresult;
+	}
+
+	event.events = EPOLLIN;
+	event.data.ptr = 0;
+	if ( ::epoll_ctl(m_hEpoll, EPOLL_CTL_ADD, m_hEvent, &event) != 0 )  {
+		nresult = errno;
+		log_error(L_NETSERV, "[net_reactor] failed to add eventfd, result %d\n", nresult);
+		terminate();
+		return nresult;
+	}
+
+	_tsnprintf(strName, sizeof(strName), "%s%u", MODULE_NAME, (unsigned)index);
+	m_thread.setName(strName);
+
+	nresult = m_thread.start(THREAD_CALLBACK(CNetReactorLoop::threadIo, this));
+	if ( nresult != ESUCCESS )  {
+		log_error(L_NETSERV, "[net_reactor] failed to start I/O thread, result %d\n", nresult);
+		terminate();
+	}
+
+	return nresult;
+}
+
+/*
+ * Stop I/O thread, the posted close requests are completed
+ */
+void CNetReactorLoop::terminate()
+{
+	if ( m_thread.isRunning() )  {
+		m_bDone = TRUE;
+		wakeup();
+		m_thread.stop();
+	}
+
+	if ( m_hEvent >= 0 )  {
+		::close(m_hEvent);
+		m_hEvent = -1;
+	}
+
+	if ( m_hEpoll >= 0 )  {
+		::close(m_hEpoll);
+		m_hEpoll = -1;
+	}
+}
+
+/*******************************************************************************
+ * CNetReactor
+ */
+
+CNetReactor::CNetReactor(CNetServer* pServer, size_t nLoops, size_t nMaxConnection) :
+	m_pServer(pServer),
+	m_arLoop(0),
+	m_nLoops(sh_min(sh_max(nLoops, 1), NET_REACTOR_THREADS_MAX)),
+	m_arHash(0),
+	m_nHashSize(64),
+	m_nConnections(0)
+{
+	shell_assert(pServer);
+
+	while ( m_nHashSize < nMaxConnection && m_nHashSize < NET_REACTOR_HASH_MAX )  {
+		m_nHashSize <<= 1;
+	}
+
+	sh_atomic_set(&m_nNextLoop, 0);
+}
+
+CNetReactor::~CNetReactor()
+{
+	shell_assert(m_nConnections == 0);
+	shell_assert(m_arLoop == 0);
+}
+
+/*
+ * Find a connection by handle
+ *
+ * 		hConnection		connection handle
+ *
+ * Return: connection or 0 if not found
+ *
+ * Note: reactor lock must be held
+ */
+CNetReactorConnection* CNetReactor::findConnection(net_connection_t hConnection) const
+{
+	CNetReactorConnection*	pConnection;
+
+	pConnection = m_arHash[getHash(hConnection)];
+	while ( pConnection && pConnection->getHandle() != hConnection )  {
+		pConnection = pConnection->m_pNextHash;
+	}
+
+	return pConnection;
+}
+
+/*
+ * Note: reactor lock must be held
+ */
+void CNetReactor::insertConnection(CNetReactorConnection* pConnection)
+{
+	size_t	index = getHash(pConnection->getHandle());
+
+	pConnection->m_pNextHash = m_arHash[index];
+	m_arHash[index] = pConnection;
+	m_nConnections++;
+}
+
+/*
+ * Note: reactor lock must be held
+ */
+CNetReactorConnection* CNetReactor::removeConnection(net_connection_t hConnection)
+{
+	CNetReactorConnection	**ppConnection, *pConnection;
+
+	ppConnection = &m_arHash[getHash(hConnection)];
+	while ( *ppConnection && (*ppConnection)->getHandle() != hConnection )  {
+		ppConnection = &(*ppConnection)->m_pNextHash;
+	}
+
+	pConnection = *ppConnection;
+	if ( pConnection )  {
+		*ppConnection = pConnection->m_pNextHash;
+		pConnection->m_pNextHash = 0;
+		m_nConnections--;
+	}
+
+	return pConnection;
+}
+
+/*
+ * Create a connection object and pass it to the I/O thread
+ *
+ * 		pSocket			connected socket
+ *
+ * Result: send EV_NET_SERVER_CONNECTED notification
+ *
+ * Return: connection handle or NET_CONNECTION_NULL
+ */
+net_connection_t CNetReactor::createConnection(CSocketRef* pSocket)
+{
+	CNetReactorConnection*	pConnection;
+	CNetReactorLoop*		pLoop;
+	CEvent*					pEvent;
+	size_t					index;
+
+	shell_assert(pSocket->isOpen());
+	shell_assert(m_arLoop);
+
+	index = (uint32_t)sh_atomic_inc(&m_nNextLoop) % m_nLoops;
+	pLoop = &m_arLoop[index];
+
+	try {
+		pConnection = new CNetReactorConnection(pSocket, pLoop);
+	}
+	catch(const std::bad_alloc& exc) {
+		return NET_CONNECTION_NULL;
+	}
+
+	CAutoLock	locker(m_lock);
+	insertConnection(pConnection);
+	m_pServer->statConnection(m_nConnections);
+	locker.unlock();
+
+	/*
+	 * Notify before the connection is passed to the I/O thread,
+	 * so the notification precedes any received container
+	 */
+	pEvent = new CEvent(EV_NET_SERVER_CONNECTED, m_pServer->getReceiver(),
+						(PPARAM)pConnection->getHandle(), 0, "net_serv_connect");
+	appSendEvent(pEvent);
+
+	pLoop->postConnection(pConnection);
+
+	return pConnection->getHandle();
+}
+
+/*
+ * Remove a connection from the table and close it in the I/O thread
+ *
+ * 		hConnection		connection handle
+ *
+ * Return: ESUCCESS, ENOENT
+ */
+result_t CNetReactor::deleteConnection(net_connection_t hConnection)
+{
+	CNetReactorConnection*	pConnection;
+	CAutoLock				locker(m_lock);
+
+	pConnection = removeConnection(hConnection);
+	if ( !pConnection )  {
+		log_error(L_NETSERV, "[net_reactor] connection is not found %lu\n", (natural_t)hConnection);
+		return ENOENT;
+	}
+
+	m_pServer->statConnection(m_nConnections);
+	locker.unlock();
+
+	pConnection->m_pLoop->postClose(pConnection);
+	pConnection->release();
+
+	return ESUCCESS;
+}
+
+void CNetReactor::closeConnections()
+{
+	CNetReactorConnection*	pConnection;
+	size_t					i;
+
+	m_lock.lock();
+	for(i=0; i<m_nHashSize; i++)  {
+		while ( (pConnection = m_arHash[i]) != 0 )  {
+			removeConnection(pConnection->getHandle());
+
+			m_lock.unlock();
+			pConnection->m_pLoop->postClose(pConnection);
+			pConnection->release();
+			m_lock.lock();
+		}
+	}
+	m_pServer->statConnection(m_nConnections);
+	m_lock.unlock();
+}
+
+/*
+ * Check if a connection is connected
+ *
+ * Return: ESUCCESS, ENOTCONN, EINVAL
+ */
+result_t CNetReactor::isConnected(net_connection_t hConnection) const
+{
+	CNetReactorConnection*	pConnection;
+	CAutoLock				locker(m_lock);
+	result_t				nresult = EINVAL;
+
+	pConnection = findConnection(hConnection);
+	if ( pConnection )  {
+		nresult = pConnection->isConnected() ? ESUCCESS : ENOTCONN;
+	}
+
+	return nresult;
+}
+
+/*
+ * Queue a container to send
+ *
+ *      pContainer      container to send
+ *      hConnection     connection to send
+ *      sessId          unique session id
+ *
+ * Return: ESUCCESS, ESRCH, ENOTCONN
+ */
+result_t CNetReactor::send(CNetContainer* pContainer, net_connection_t hConnection, seqnum_t sessId)
+{
+	CNetReactorConnection*	pConnection;
+	CAutoLock				locker(m_lock);
+	result_t				nresult;
+
+	pConnection = findConnection(hConnection);
+	if ( !pConnection )  {
+		return ESRCH;
+	}
+
+	pConnection->reference();
+	locker.unlock();
+
+	nresult = pConnection->m_pLoop->postSend(pConnection, pContainer, sessId);
+	pConnection->release();
+
+	return nresult;
+}
+
+/*
+ * Start I/O threads
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CNetReactor::init()
+{
+	size_t		i;
+	result_t	nresult = ESUCCESS;
+
+	shell_assert(m_arLoop == 0);
+
+	try {
+		m_arHash = new CNetReactorConnection*[m_nHashSize];
+		m_arLoop = new CNetReactorLoop[m_nLoops];
+	}
+	catch(const std::bad_alloc& exc) {
+		delete[] m_arHash;
+		m_arHash = 0;
+		return ENOMEM;
+	}
+
+	_tbzero(m_arHash, m_nHashSize*sizeof(m_arHash[0]));
+	m_nConnections = 0;
+
+	for(i=0; i<m_nLoops && nresult == ESUCCESS; i++)  {
+		nresult = m_arLoop[i].init(this, i);
+	}
+
+	if ( nresult != ESUCCESS )  {
+		terminate();
+	}
+	else {
+		log_debug(L_NETSERV, "[net_reactor] started %u I/O thread(s), connection table %u\n",
+				  m_nLoops, m_nHashSize);
+	}
+
+	return nresult;
+}
+
+/*
+ * Close all connections and stop I/O threads
+ */
+void CNetReactor::terminate()
+{
+	size_t		i;
+
+	if ( m_arLoop )  {
+		closeConnections();
+
+		for(i=0; i<m_nLoops; i++)  {
+			m_arLoop[i].terminate();
+		}
+
+		delete[] m_arLoop;
+		m_arLoop = 0;
+	}
+
+	delete[] m_arHash;
+	m_arHash = 0;
+}
@@ -0,0 +1,238 @@
+/*
+ *  Carbon framework
+ *  Network server epoll reactor
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 16:10:44
+ *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 11:26:40
+ *      Receive and send timeouts.
+ */
+/*
+ * Purpose:
+ *      Serve CNetServer connections by a fixed number of I/O threads,
+ *      each thread runs an epoll loop over its own connections.
+ *
+ *      A connection is a small state object: a socket, a partially received
+ *      container and a queue of the containers to send. The containers are
+ *      received and sent incrementally by CNetContainer::receive(CSocketAsync&)
+ *      and CNetContainer::send(CSocketAsync&, uint32_t*), so the receive
+ *      template container must implement the asynchronous I/O.
+ *
+ *      All state of a connection except the send queue is accessed by the
+ *      owner I/O thread only. Other threads post requests (send, close)
+ *      to the I/O thread and wake it up by the eventfd.
+ *
+ *      The reactor sends the same notifications as the thread per connection
+ *      mode: EV_NET_SERVER_RECV, EV_NET_SERVER_SENT, EV_NET_SERVER_DISCONNECTED.
+ *
+ *      A partially received container must be completed within the server
+ *      receive timeout, a started container send - within the send timeout,
+ *      otherwise the connection is closed (EV_NET_SERVER_DISCONNECTED, the
+ *      queued containers fail with ETIMEDOUT). The deadlines are kept in two
+ *      per loop lists ordered by the arm time and drive the epoll_wait() timeout.
+ */
+
+#ifndef __CARBON_NET_REACTOR_H_INCLUDED__
+#define __CARBON_NET_REACTOR_H_INCLUDED__
+
+#include "shell/socket.h"
+#include "shell/atomic.h"
+
+#include "carbon/net_container.h"
+#include "carbon/thread.h"
+#include "carbon/lock.h"
+#include "carbon/net_server/net_server_connection.h"
+
+#define NET_REACTOR_THREADS_MAX			64
+#define NET_REACTOR_EVENTS_MAX			256		/* epoll_wait() batch */
+#define NET_REACTOR_RECV_BATCH			16		/* Maximum containers received at once */
+#define NET_REACTOR_HASH_MAX			65536	/* Maximum connection table size */
+
+class CNetReactor;
+class CNetReactorLoop;
+class CNetReactorConnection;
+
+/*
+ * Pending send request
+ */
+typedef struct net_reactor_send
+{
+	struct net_reactor_send*	pNext;
+	CNetContainer*				pContainer;		/* Container to send (referenced) */
+	seqnum_t					sessId;			/* Unique session Id (NO_SEQNUM - no reply) */
+} net_reactor_send_t;
+
+/*
+ * Receive/send deadline of a connection
+ */
+typedef struct net_reactor_timer
+{
+	struct net_reactor_timer*	pPrev;
+	struct net_reactor_timer*	pNext;
+	CNetReactorConnection*		pConnection;	/* Owner connection */
+	hr_time_t					hrDeadline;		/* Expiration time, HR_0 - not armed */
+} net_reactor_timer_t;
+
+typedef struct
+{
+	net_reactor_timer_t*		pHead;			/* The earliest deadline */
+	net_reactor_timer_t*		pTail;
+} net_reactor_timer_list_t;
+
+/*
+ * Reactor connection state
+ */
+class CNetReactorConnection : public CRefObject
+{
+	friend class CNetReactor;
+	friend class CNetReactorLoop;
+
+	protected:
+		dec_ptr<CSocketRef>		m_pSocket;			/* Connected socket */
+		CNetReactorLoop*		m_pLoop;			/* Owner I/O loop */
+
+		/* Owner I/O thread only */
+		dec_ptr<CNetContainer>	m_pRecvContainer;	/* Receiving container */
+		net_reactor_send_t*		m_pSend;			/* Sending container */
+		uint32_t				m_nSendOffset;		/* Sending container offset */
+		uint32_t				m_nEvents;			/* Registered epoll events, 0 - not registered */
+		boolean_t				m_bFailSent;		/* TRUE: closed notification has been sent */
+		net_reactor_timer_t		m_recvTimer;		/* Partially received container deadline */
+		net_reactor_timer_t		m_sendTimer;		/* Started container send deadline */
+
+		/* Under the loop lock */
+		net_reactor_send_t*		m_pSendHead;		/* Send queue */
+		net_reactor_send_t*		m_pSendTail;
+		CNetReactorConnection*	m_pNextPending;		/* Next connection in the pending list */
+		boolean_t				m_bPending;			/* TRUE: connection is in the pending list */
+		boolean_t				m_bClosing;			/* TRUE: connection close requested */
+
+		/* Under the reactor lock */
+		CNetReactorConnection*	m_pNextHash;		/* Next connection in the hash chain */
+
+	public:
+		CNetReactorConnection(CSocketRef* pSocket, CNetReactorLoop* pLoop);
+	protected:
+		virtual ~CNetReactorConnection();
+
+	public:
+		net_connection_t getHandle() { return reinterpret_cast<net_connection_t>(this); }
+		boolean_t isConnected() const { return m_pSocket->isOpen(); }
+};
+
+/*
+ * Single I/O thread of the reactor
+ */
+class CNetReactorLoop
+{
+	protected:
+		CNetReactor*			m_pReactor;			/* Parent reactor */
+		CThread					m_thread;			/* I/O thread */
+		int						m_hEpoll;			/* Epoll descriptor */
+		int						m_hEvent;			/* Wakeup eventfd descriptor */
+		volatile boolean_t		m_bDone;			/* TRUE: stop I/O thread */
+
+		CMutex					m_lock;				/* Pending list and send queues lock */
+		CNetReactorConnection*	m_pPendingHead;		/* Connections with the posted requests */
+		CNetReactorConnection*	m_pPendingTail;
+
+		/* I/O thread only */
+		net_reactor_timer_list_t	m_recvTimers;	/* Armed receive deadlines */
+		net_reactor_timer_list_t	m_sendTimers;	/* Armed send deadlines */
+
+	public:
+		CNetReactorLoop();
+		virtual ~CNetReactorLoop();
+
+	public:
+		result_t init(CNetReactor* pReactor, size_t index);
+		void terminate();
+
+		void postConnection(CNetReactorConnection* pConnection);
+		result_t postSend(CNetReactorConnection* pConnection, CNetContainer* pContainer, seqnum_t sessId);
+		void postClose(CNetReactorConnection* pConnection);
+
+	protected:
+		void post(CNetReactorConnection* pConnection);
+		void wakeup();
+
+		void processPending();
+		void processIo(CNetReactorConnection* pConnection, uint32_t nEvents);
+		void doRecv(CNetReactorConnection* pConnection);
+		void doSend(CNetReactorConnection* pConnection);
+		result_t setEvents(CNetReactorConnection* pConnection, uint32_t nEvents);
+
+		void closeSocket(CNetReactorConnection* pConnection, result_t nSendResult);
+		void closeConnection(CNetReactorConnection* pConnection);
+		void cancelSend(CNetReactorConnection* pConnection, result_t nSendResult);
+
+		void armTimer(net_reactor_timer_list_t* pList, net_reactor_timer_t* pTimer,
+					  hr_time_t hrTimeout);
+		void cancelTimer(net_reactor_timer_list_t* pList, net_reactor_timer_t* pTimer);
+		void expireTimers(net_reactor_timer_list_t* pList, const char* strOp);
+		int getWaitTimeout() const;
+
+		void notifyRecv(CNetReactorConnection* pConnection, CNetContainer* pContainer);
+		void notifySend(result_t nOpResult, seqnum_t sessId);
+		void notifyClosed(CNetReactorConnection* pConnection);
+
+	private:
+		void* threadIo(CThread* pThread, void* pData);
+};
+
+/*
+ * Reactor: I/O threads and connection table
+ */
+class CNetReactor
+{
+	friend class CNetReactorLoop;
+
+	protected:
+		CNetServer*				m_pServer;			/* Parent server */
+		CNetReactorLoop*		m_arLoop;			/* I/O loops */
+		size_t					m_nLoops;			/* I/O loop count */
+		atomic_t				m_nNextLoop;		/* Round-robin loop selector */
+
+		CNetReactorConnection**	m_arHash;			/* Connection table, handle -> connection */
+		size_t					m_nHashSize;		/* Table size, power of 2 */
+		size_t					m_nConnections;		/* Connection count */
+		mutable CMutex			m_lock;				/* Connection table lock */
+
+	public:
+		CNetReactor(CNetServer* pServer, size_t nLoops, size_t nMaxConnection);
+		virtual ~CNetReactor();
+
+	public:
+		result_t init();
+		void terminate();
+
+		size_t getConnections() const {
+			CAutoLock	locker(m_lock);
+			return m_nConnections;
+		}
+
+		net_connection_t createConnection(CSocketRef* pSocket);
+		result_t deleteConnection(net_connection_t hConnection);
+		void closeConnections();
+
+		result_t isConnected(net_connection_t hConnection) const;
+		result_t send(CNetContainer* pContainer, net_connection_t hConnection, seqnum_t sessId);
+
+	protected:
+		size_t getHash(net_connection_t hConnection) const {
+			return (size_t)((((uintptr_t)hConnection)>>4)*2654435761U) & (m_nHashSize-1);
+		}
+
+		CNetReactorConnection* findConnection(net_connection_t hConnection) const;
+		void insertConnection(CNetReactorConnection* pConnection);
+		CNetReactorConnection* removeConnection(net_connection_t hConnection);
+};
+
+#endif  /* __CARBON_NET_REACTOR_H_INCLUDED__ */
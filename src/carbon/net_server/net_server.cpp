@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 23.06.2016 15:01:58
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 16:41:05
+ *      Added epoll reactor mode.
  */
 
 #include <new>
@@ -18,6 +21,7 @@
 #include "carbon/event.h"
 #include "carbon/sync.h"
 #include "carbon/net_server/net_server_connection.h"
+#include "carbon/net_server/net_reactor.h"
 #include "carbon/net_server/net_server.h"
 
 #define MODULE_NAME			"net_server"
@@ -61,23 +65,31 @@ result_t CNetServerSyncResult::processSyncEvent()
 /*******************************************************************************
  * CNetServer Module
  */
-CNetServer::CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent) :
+CNetServer::CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent,
+					   size_t nReactorThreads) :
     CModule(MODULE_NAME),
     CTcpServer(MODULE_NAME),
     m_pParent(pParent),
     m_listenThread(MODULE_NAME),
+	m_pReactor(0),
     m_nMaxConnection(nMaxConnection),
 	m_pRecvTempl(pRecvTempl),
     m_hrSendTimeout(NET_SERVER_SEND_TIMEOUT),
 	m_hrRecvTimeout(NET_SERVER_RECV_TIMEOUT)
 {
-    m_arConnection.reserve(nMaxConnection);
+	if ( nReactorThreads > 0 )  {
+		m_pReactor = new CNetReactor(this, nReactorThreads, nMaxConnection);
+	}
+	else {
+		m_arConnection.reserve(nMaxConnection);
+	}
     shell_assert(pParent);
 }
 
 CNetServer::~CNetServer()
 {
     shell_assert(m_arConnection.empty());
+	SAFE_DELETE(m_pReactor);
 }
 
 /*
@@ -117,20 +129,31 @@ result_t CNetServer::processClient(CSocketRef* pSocket)
     size_t      count;
     result_t    nresult = E2BIG;
 
-    count = m_arConnection.size();
+    count = m_pReactor ? m_pReactor->getConnections() : m_arConnection.size();
     locker.unlock();
 
     if ( count < m_nMaxConnection )  {
         CNetServerConnection*   pConnection;
+		net_connection_t		hConnection;
 
 		log_trace(L_NETSERV, "[netserv] accepted client\n");
-        pConnection = createConnection(pSocket);
-        if ( pConnection )  {
-            CEvent*     pEvent;
+		if ( m_pReactor )  {
+			/* Reactor sends EV_NET_SERVER_CONNECTED itself */
+			hConnection = m_pReactor->createConnection(pSocket);
+		}
+		else {
+			pConnection = createConnection(pSocket);
+			hConnection = pConnection ? pConnection->getHandle() : NET_CONNECTION_NULL;
+			if ( hConnection != NET_CONNECTION_NULL )  {
+				CEvent*     pEvent;
+
+				pEvent = new CEvent(EV_NET_SERVER_CONNECTED, m_pParent,
+							(PPARAM)hConnection, 0, "net_serv_connect");
+				appSendEvent(pEvent);
+			}
+		}
 
-            pEvent = new CEvent(EV_NET_SERVER_CONNECTED, m_pParent,
-						(PPARAM)pConnection->getHandle(), 0, "net_serv_connect");
-            appSendEvent(pEvent);
+        if ( hConnection != NET_CONNECTION_NULL )  {
             statClient();
             nresult = ESUCCESS;
         }
@@ -150,19 +173,19 @@ result_t CNetServer::processClient(CSocketRef* pSocket)
 /*
  * Find a specific connection within server connections
  *
- *      pConnection     connection to search
+ *      hConnection     connection to search
  *
  * Return: connection index or -1 if not found
  *
  * Note: net server lock must be held
  */
-int CNetServer::findConnection(CNetServerConnection* pConnection) const
+int CNetServer::findConnection(net_connection_t hConnection) const
 {
     int     i, count = (int)m_arConnection.size();
     int     index = -1;
 
     for(i=0; i<count; i++)  {
-        if ( m_arConnection[i] == pConnection )  {
+        if ( m_arConnection[i]->getHandle() == hConnection )  {
             index = i;
             break;
         }
@@ -201,7 +224,7 @@ CNetServerConnection* CNetServer::createConnection(CSocketRef* pSocket)
 			CAutoLock	locker(m_lock);
 			int 		index;
 
-			index = findConnection(pConnection);
+			index = findConnection(pConnection->getHandle());
 			if ( index >= 0 ) {
 				m_arConnection.erase(m_arConnection.begin()+index);
 			}
@@ -220,14 +243,16 @@ CNetServerConnection* CNetServer::createConnection(CSocketRef* pSocket)
 /*
  * Delete a specified connection
  */
-result_t CNetServer::deleteConnection(CNetServerConnection* pConnection)
+result_t CNetServer::deleteConnection(net_connection_t hConnection)
 {
     CAutoLock   locker(m_lock);
     int         index;
     result_t    nresult = ESUCCESS;
 
-    index = findConnection(pConnection);
+    index = findConnection(hConnection);
     if ( index >= 0 )  {
+		CNetServerConnection*	pConnection = m_arConnection[index];
+
         m_arConnection.erase(m_arConnection.begin()+index);
 		statConnection(m_arConnection.size());
         locker.unlock();
@@ -238,7 +263,7 @@ result_t CNetServer::deleteConnection(CNetServerConnection* pConnection)
         delete pConnection;
     }
     else {
-        log_error(L_NETSERV, "[netserv] connection is not found %lu\n", (natural_t)pConnection);
+        log_error(L_NETSERV, "[netserv] connection is not found %lu\n", (natural_t)hConnection);
         nresult = ENOENT;
     }
 
@@ -301,6 +326,11 @@ result_t CNetServer::isConnected(net_connection_t hConnection)
     result_t		nresult = EINVAL;
     int             i;
 
+	if ( m_pReactor )  {
+		locker.unlock();
+		return m_pReactor->isConnected(hConnection);
+	}
+
     i = findConnection(hConnection);
     if ( i >= 0 )  {
         nresult = m_arConnection[i]->isConnected() ? ESUCCESS : ENOTCONN;
@@ -325,6 +355,17 @@ result_t CNetServer::send(CNetContainer* pContainer, net_connection_t hConnectio
     int             i;
     result_t        nresult = ESUCCESS;
 
+	if ( m_pReactor )  {
+		locker.unlock();
+		nresult = m_pReactor->send(pContainer, hConnection, sessId);
+		if ( nresult != ESUCCESS )  {
+			log_error(L_NETSERV, "[netserv(%d)] connection %Xh is not available, result %d\n",
+					  sessId, hConnection, nresult);
+			statFail();
+		}
+		return nresult;
+	}
+
     i = findConnection(hConnection);
     if ( i >= 0 )  {
         CEventNetServerDoSend*  pEvent;
@@ -354,9 +395,9 @@ result_t CNetServer::sendSync(CNetContainer* pContainer, net_connection_t hConne
 		pEventLoop->attachSync(&syncer);
 		nresult = send(pContainer, hConnection, sessId);
 		if ( nresult == ESUCCESS ) {
-			nresult = pEventLoop->waitSync(getSendTimeout() + HR_30SEC);
+			nresult = pEventLoop->waitSync(&syncer, getSendTimeout() + HR_30SEC);
 		}
-		pEventLoop->detachSync();
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_GEN, "[netserv] event loop is not found\n");
@@ -378,18 +419,28 @@ result_t CNetServer::disconnect(net_connection_t hConnection)
 {
     result_t    nresult;
 
-    nresult = deleteConnection(hConnection);
+	if ( m_pReactor )  {
+		nresult = m_pReactor->deleteConnection(hConnection);
+	}
+	else {
+		nresult = deleteConnection(hConnection);
+	}
     return nresult;
 }
 
 void CNetServer::closeConnections()
 {
+	if ( m_pReactor )  {
+		m_pReactor->closeConnections();
+		return;
+	}
+
 	m_lock.lock();
 	while ( !m_arConnection.empty() )  {
-		CNetServerConnection*   pConnection = m_arConnection[0];
+		net_connection_t	hConnection = m_arConnection[0]->getHandle();
 
 		m_lock.unlock();
-		deleteConnection(pConnection);
+		deleteConnection(hConnection);
 		m_lock.lock();
 	}
 	m_lock.unlock();
@@ -416,7 +467,15 @@ result_t CNetServer::init()
     }
 
     resetStat();
-    return ESUCCESS;
+
+	if ( m_pReactor )  {
+		nresult = m_pReactor->init();
+		if ( nresult != ESUCCESS )  {
+			CModule::terminate();
+		}
+	}
+
+    return nresult;
 }
 
 /*
@@ -429,6 +488,10 @@ void CNetServer::terminate()
     stopListen();
 	closeConnections();
 
+	if ( m_pReactor )  {
+		m_pReactor->terminate();
+	}
+
 	shell_assert_ex(m_pRecvTempl->getRefCount() == 1,
 					"refcount = %d\n", m_pRecvTempl->getRefCount());
     CModule::terminate();
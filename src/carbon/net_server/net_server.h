@@ -10,16 +10,22 @@
  *
  *  Revision 1.0, 23.06.2016 13:21:59
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 16:40:12
+ *      Added epoll reactor mode.
  */
 /*
  * Purpose:
  *      Synchronous/Asynchronous network server with permanent connections
  *
  * Constructor:
- *      CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent);
+ *      CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent,
+ *      			size_t nReactorThreads = 0);
  *      	nMaxConnection	maximum simultaneous connections
  * 			pRecvTempl		sample container for receiving the new containers
  *      	pParent			default container receiver
+ *      	nReactorThreads	I/O threads of the epoll reactor (see net_reactor.h),
+ *      					0 - a separate thread per connection
  *
  *
  * I) Initialisation/Deinitialisation API:
@@ -79,6 +85,17 @@
  * IV) Notification API:
  *     ~~~~~~~~~~~~~~~~~
  *
+ *     EV_NET_SERVER_CONNECTED
+ *     Send a message to the parent if a new connection was accepted.
+ *     PPARAM - client handle
+ *
+ *     EV_NET_SERVER_RECV
+ *     Send a received container to the parent, see CEventNetServerRecv.
+ *
+ *     EV_NET_SERVER_SENT
+ *     Send a result of the send() with a session Id to the parent.
+ *     NPARAM - result code
+ *
  *     EV_NET_SERVER_DISCONNECTED
  *     Send a message to the parent if a connection was closed by remote peer.
  *     PPARAM - client handle
@@ -98,6 +115,7 @@
 #include "carbon/event.h"
 #include "carbon/thread.h"
 #include "carbon/net_server/net_server_connection.h"
+#include "carbon/net_server/net_reactor.h"
 
 #define NET_SERVER_SEND_TIMEOUT         HR_4SEC
 #define NET_SERVER_RECV_TIMEOUT         HR_16SEC
@@ -191,6 +209,7 @@ class CNetServer : public CModule, public CTcpServer
         CThread             m_listenThread;		/* Listening in the separate thread */
 
 		std::vector<CNetServerConnection*>	m_arConnection;
+		CNetReactor*		m_pReactor;			/* Reactor mode I/O threads or 0 */
         size_t              m_nMaxConnection;	/* Maximum simultaneous connections */
 		mutable CMutex		m_lock;				/* Synchronisation */
 
@@ -199,7 +218,8 @@ class CNetServer : public CModule, public CTcpServer
 		hr_time_t			m_hrRecvTimeout;	/* Receive timeout, access under lock */
 
     public:
-        CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent);
+        CNetServer(size_t nMaxConnection, CNetContainer* pRecvTempl, CEventReceiver* pParent,
+				   size_t nReactorThreads = 0);
         virtual ~CNetServer();
 
     public:
@@ -278,9 +298,9 @@ class CNetServer : public CModule, public CTcpServer
 	protected:
 		virtual result_t processClient(CSocketRef* pSocket);
 
-        virtual int findConnection(CNetServerConnection* pConnection) const;
+        virtual int findConnection(net_connection_t hConnection) const;
 		virtual CNetServerConnection* createConnection(CSocketRef* pSocket);
-		virtual result_t deleteConnection(CNetServerConnection* pConnection);
+		virtual result_t deleteConnection(net_connection_t hConnection);
 
 	private:
         void* threadListen(CThread* pThread, void* pData);
@@ -10,6 +10,12 @@
  *
  *  Revision 1.0, 23.06.2016 17:24:25
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 13:24:10
+ *      Idle sleeping via CEventLoop::waitNotify().
+ *
+ *  Revision 1.2, 17.10.2026 16:02:58
+ *      Use opaque connection handle in notifications.
  */
 
 #include <new>
@@ -115,7 +121,7 @@ void CNetServerConnection::notifyRecv(CNetContainer* pContainer)
 {
 	CEventNetServerRecv*    pEvent;
 
-	pEvent = new CEventNetServerRecv(m_pParent->getReceiver(), pContainer, this);
+	pEvent = new CEventNetServerRecv(m_pParent->getReceiver(), pContainer, getHandle());
 	appSendEvent(pEvent);
 }
 
@@ -335,7 +341,7 @@ void CNetServerConnection::runEventLoop()
 
 				/*log_debug(L_NETSERV_FL, "[netserv_con] sleeping %d ms...\n",
 						  HR_TIME_TO_MILLISECONDS(hrNextIterTime-hr_time_now()));*/
-				m_cond.waitTimed(hrNextIterTime);
+				waitNotify(hrNextIterTime);
 		}
 
 		m_cond.unlock();
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 23.06.2016 17:16:52
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 16:02:31
+ *      Opaque connection handle (shared with the reactor mode).
  */
 
 #ifndef __CARBON_NET_SERVER_CONNECTION_H_INCLUDED__
@@ -23,7 +26,12 @@
 class CNetServerConnection;
 class CNetServer;
 
-typedef CNetServerConnection*       net_connection_t;
+/*
+ * Connection handle, points either to CNetServerConnection (thread per connection)
+ * or to CNetReactorConnection (reactor mode) and is validated by the server
+ */
+struct net_connection;
+typedef struct net_connection*		net_connection_t;
 #define NET_CONNECTION_NULL			((net_connection_t)0)
 
 class CNetServerConnection : public CEventLoopThread, public CEventReceiver
@@ -49,7 +57,7 @@ class CNetServerConnection : public CEventLoopThread, public CEventReceiver
 
 		virtual void disconnect();
 
-		net_connection_t getHandle() { return this; }
+		net_connection_t getHandle() { return reinterpret_cast<net_connection_t>(this); }
 
 	protected:
         virtual boolean_t processEvent(CEvent* pEvent);
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 01.08.2016 14:42:06
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Reuse the pooled connections, retry once on a stale connection.
  */
 
 #include "shell/socket.h"
@@ -17,46 +20,117 @@
 #include "carbon/logger.h"
 #include "carbon/packet_io.h"
 
+/*
+ * Connect to the remote host or take a pooled connection
+ *
+ * 		pConn			OUT: connection
+ * 		dstAddr			remote host address
+ * 		srcAddr			source address (may be NETADDR_NULL)
+ * 		hrTimeout		connect timeout
+ * 		bNew			TRUE: make a new connection only
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CPacketIo::connect(conn_pool_conn_t* pConn, const CNetAddr& dstAddr, const CNetAddr& srcAddr,
+							hr_time_t hrTimeout, boolean_t bNew)
+{
+	result_t	nresult;
 
+	if ( m_pPool )  {
+		return m_pPool->acquire(pConn, dstAddr, srcAddr, hrTimeout, bNew);
+	}
+
+	pConn->pSocket = new CSocketRef;
+	pConn->pHost = 0;
+	pConn->hrCreated = hr_time_now();
+	pConn->bReused = FALSE;
+
+	nresult = pConn->pSocket->connect(dstAddr, hrTimeout, srcAddr);
+	if ( nresult != ESUCCESS )  {
+		disconnect(pConn, FALSE);
+	}
+
+	return nresult;
+}
+
+/*
+ * Return the connection to the pool or close it
+ *
+ * 		pConn		connection
+ * 		bKeep		TRUE: the connection may be reused
+ */
+void CPacketIo::disconnect(conn_pool_conn_t* pConn, boolean_t bKeep)
+{
+	if ( m_pPool )  {
+		m_pPool->release(pConn, bKeep);
+	}
+	else {
+		pConn->pSocket->close();
+		SAFE_RELEASE(pConn->pSocket);
+	}
+}
+
+/*
+ * Send a container and receive the reply container
+ *
+ * 		pInContainer		container to send
+ * 		pOutContainer		reply container (may be 0, pInContainer is used)
+ * 		dstAddr				remote host address
+ * 		srcAddr				source address (may be NETADDR_NULL)
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: the I/O failed on a reused pooled connection is repeated once
+ * 		 on the new connection (if the container to send is not overwritten).
+ */
 result_t CPacketIo::execute(CNetContainer* pInContainer, CNetContainer* pOutContainer,
 							const CNetAddr& dstAddr, const CNetAddr& srcAddr)
 {
 	CNetContainer*		pOut;
-	CSocket				ioSocket;
+	conn_pool_conn_t	conn;
 	hr_time_t			hrStart, hrTimeout;
+	boolean_t			bNew = FALSE, bRetry;
 	result_t			nresult;
 
+	pOut = pOutContainer ? pOutContainer : pInContainer;
 	hrStart = hr_time_now();
-	nresult = ioSocket.connect(dstAddr, m_hrTimeout, srcAddr);
-	if ( nresult != ESUCCESS )  {
-		log_debug(L_GEN, "[vep_packet_io] failed to connect to %s in %d secs, result: %d\n",
-						(const char*)dstAddr, HR_TIME_TO_SECONDS(m_hrTimeout), nresult);
-		return nresult;
-	}
 
-	hrTimeout = hr_timeout(hrStart, m_hrTimeout);
-	nresult = pInContainer->send(ioSocket, hrTimeout);
-	if ( nresult != ESUCCESS )  {
-		log_debug(L_GEN, "[vep_packet_io] failed to send packet to %s, result: %d\n",
-						(const char*)dstAddr, nresult);
-		ioSocket.close();
-		return nresult;
-	}
+	while ( TRUE )  {
+		nresult = connect(&conn, dstAddr, srcAddr, hr_timeout(hrStart, m_hrTimeout), bNew);
+		if ( nresult != ESUCCESS )  {
+			log_debug(L_GEN, "[vep_packet_io] failed to connect to %s in %d secs, result: %d\n",
+							(const char*)dstAddr, HR_TIME_TO_SECONDS(m_hrTimeout), nresult);
+			return nresult;
+		}
 
-	if ( pOutContainer )  {
-		pOutContainer->clear();
-		pOut = pOutContainer;
-	}
-	else {
-		pInContainer->clear();
-		pOut = pInContainer;
+		hrTimeout = hr_timeout(hrStart, m_hrTimeout);
+		nresult = pInContainer->send(*conn.pSocket, hrTimeout);
+		if ( nresult == ESUCCESS )  {
+			pOut->clear();
+
+			hrTimeout = hr_timeout(hrStart, m_hrTimeout);
+			nresult = pOut->receive(*conn.pSocket, hrTimeout);
+			bRetry = conn.bReused && pOut != pInContainer &&
+						(nresult == ECONNRESET || nresult == EPIPE);
+		}
+		else {
+			bRetry = conn.bReused;
+		}
+
+		disconnect(&conn, nresult == ESUCCESS);
+
+		if ( nresult == ESUCCESS || !bRetry || hr_timeout(hrStart, m_hrTimeout) == HR_0 )  {
+			break;
+		}
+
+		/* The peer has closed the idle connection */
+		log_debug(L_GEN, "[vep_packet_io] stale connection to %s, result: %d, reconnecting\n",
+						(const char*)dstAddr, nresult);
+		bNew = TRUE;
 	}
 
-	hrTimeout = hr_timeout(hrStart, m_hrTimeout);
-	nresult = pOut->receive(ioSocket, hrTimeout);
-	ioSocket.close();
 	if ( nresult != ESUCCESS )  {
-		log_debug(L_GEN, "[vep_packet_io] failed to receive reply from %s, result: %d\n",
+		log_debug(L_GEN, "[vep_packet_io] failed I/O with %s, result: %d\n",
 						(const char*)dstAddr, nresult);
 	}
 
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 01.08.2016 14:41:06
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Added optional keep-alive connection pool.
  */
 
 #ifndef __CARBON_PACKET_IO_H_INCLUDED__
@@ -19,14 +22,19 @@
 #include "shell/netaddr.h"
 
 #include "carbon/net_container.h"
+#include "carbon/net_connector/conn_pool.h"
 
 class CPacketIo
 {
 	protected:
 		hr_time_t		m_hrTimeout;
+		CConnPool*		m_pPool;			/* Connection pool (may be 0) */
 
 	public:
-		CPacketIo(hr_time_t hrTimeout) : m_hrTimeout(hrTimeout) {
+		CPacketIo(hr_time_t hrTimeout, CConnPool* pPool = 0) :
+			m_hrTimeout(hrTimeout),
+			m_pPool(pPool)
+		{
 		}
 		virtual ~CPacketIo() {
 		}
@@ -34,6 +42,11 @@ class CPacketIo
 	public:
 		result_t execute(CNetContainer* pInContainer, CNetContainer* pOutContainer,
 						 const CNetAddr& dstAddr, const CNetAddr& srcAddr = NETADDR_NULL);
+
+	private:
+		result_t connect(conn_pool_conn_t* pConn, const CNetAddr& dstAddr, const CNetAddr& srcAddr,
+						 hr_time_t hrTimeout, boolean_t bNew);
+		void disconnect(conn_pool_conn_t* pConn, boolean_t bKeep);
 };
 
 #endif /* __CARBON_PACKET_IO_H_INCLUDED__ */
@@ -122,13 +122,13 @@ result_t shellExecuteSync(const char* strCmd, CEventReceiver* pReplyReceiver,
 								   strCmd, _tstrlen(strCmd));
 		nresult = appSendRemoteEvent(pEvent, CARBON_SHELL_EXECUTE_RID);
 		if ( nresult == ESUCCESS) {
-			nresult = pEventLoop->waitSync(hrTimeout);
+			nresult = pEventLoop->waitSync(&syncer, hrTimeout);
 		}
 		else {
 			log_error(L_GEN, "[shell_execute] failed to send event, result: %d\n", nresult);
 		}
 
-		pEventLoop->detachSync();
+		pEventLoop->detachSync(&syncer);
 	}
 	else {
 		log_error(L_GEN, "[shell_execute] event loop is not found\n");
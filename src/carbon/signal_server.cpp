@@ -13,6 +13,9 @@
  *
  *  Revision 1.1, 28.06.2015 14:07:57
  *  	Fixed stopHandler(): stop only than processed in main thread.
+ *
+ *  Revision 1.2, 18.10.2026 08:14:52
+ *  	Flush the logger flight recorder on fatal errors.
  */
 /*
  * Processing signals:
@@ -77,6 +80,7 @@ void CSignalServer::fatalHandler(int signum)
 	log_dump("Fatal error, got a signal %d\n", signum);
 	log_dump("Stack trace:\n");
 	printBacktrace();
+	logger_recorder_flush();
 	exit(0xff);
 }
 
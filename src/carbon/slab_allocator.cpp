@@ -0,0 +1,348 @@
+/*
+ *  Carbon framework
+ *  Thread caching slab allocator
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 14:03:12
+ *      Initial revision.
+ */
+/*
+ * Note:
+ * 		Every thread allocates from its own cache without locking.
+ * 		A block freed by the owner thread returns to the local free list,
+ * 		a block freed by any other thread is pushed to the lock-free remote
+ * 		list of the owner cache, which is taken back at once by the owner
+ * 		when the local list runs out. A cache of the exited thread is
+ * 		adopted by the next new thread. Chunks are never returned
+ * 		to the system.
+ */
+
+#include <pthread.h>
+
+#include "shell/defines.h"
+#include "shell/tstring.h"
+#include "shell/memory.h"
+#include "shell/assert.h"
+
+#include "carbon/slab_allocator.h"
+
+#define SLAB_CLASS_COUNT			13
+#define SLAB_CLASS_STEP				32
+#define SLAB_CLASS_LARGE			0xffff
+#define SLAB_MAGIC					0x51ab
+
+/*
+ * Block header, keeps 16 bytes alignment of the user data
+ */
+typedef struct slab_cache slab_cache_t;
+
+typedef struct slab_block {
+	union {
+		slab_cache_t*		pCache;			/* Owner cache (allocated block) */
+		struct slab_block*	pNext;			/* Next free block (free block) */
+	};
+	uint16_t				nClass;			/* Size class index or SLAB_CLASS_LARGE */
+	uint16_t				nMagic;			/* SLAB_MAGIC */
+	uint32_t				nReserved;
+} __attribute__ ((aligned(16))) slab_block_t;
+
+typedef struct {
+	slab_block_t*			pFree;			/* Local free list, owner thread only */
+	slab_block_t* volatile	pRemote;		/* Blocks freed by other threads */
+} slab_class_t;
+
+struct slab_cache {
+	slab_class_t			arClass[SLAB_CLASS_COUNT];
+	slab_cache_t*			pNext;			/* All caches list */
+	slab_cache_t*			pNextOrphan;	/* Caches of exited threads */
+
+	/* Statistic, updated by the owner thread */
+	uint64_t				nAlloc;
+	uint64_t				nFree;
+	uint64_t				nHit;
+	uint64_t				nMiss;
+	uint64_t				nLarge;
+	uint64_t				nChunkSize;
+	/* Updated by any thread */
+	uint64_t volatile		nRemoteFree;
+};
+
+static const size_t g_arClassSize[SLAB_CLASS_COUNT] = {
+	32, 64, 96, 128, 160, 192, 256, 320, 384, 512, 640, 768, 1024
+};
+
+/* Size class index by (size+SLAB_CLASS_STEP-1)/SLAB_CLASS_STEP */
+static uint8_t				g_arClassIndex[SLAB_BLOCK_MAX/SLAB_CLASS_STEP+1];
+
+static pthread_once_t		g_once = PTHREAD_ONCE_INIT;
+static pthread_key_t		g_key;
+static pthread_mutex_t		g_lock = PTHREAD_MUTEX_INITIALIZER;
+static slab_cache_t*		g_pCacheList = 0;		/* Under g_lock */
+static slab_cache_t*		g_pOrphanList = 0;		/* Under g_lock */
+static uint64_t volatile	g_nLargeFree = 0;
+
+static __thread slab_cache_t*	t_pCache = 0;
+
+/*
+ * Detach the cache from the exiting thread
+ */
+static void slabThreadExit(void* p)
+{
+	slab_cache_t*	pCache = (slab_cache_t*)p;
+
+	t_pCache = 0;
+
+	pthread_mutex_lock(&g_lock);
+	pCache->pNextOrphan = g_pOrphanList;
+	g_pOrphanList = pCache;
+	pthread_mutex_unlock(&g_lock);
+}
+
+static void slabInit()
+{
+	size_t	i, nClass = 0;
+
+	for(i=0; i<ARRAY_SIZE(g_arClassIndex); i++)  {
+		while ( g_arClassSize[nClass] < i*SLAB_CLASS_STEP )  {
+			nClass++;
+		}
+		g_arClassIndex[i] = (uint8_t)nClass;
+	}
+
+	shell_verify(pthread_key_create(&g_key, slabThreadExit) == 0);
+}
+
+/*
+ * Get (adopt or create) the current thread cache
+ *
+ * Return: cache or NULL
+ */
+static slab_cache_t* slabGetCache()
+{
+	slab_cache_t*	pCache;
+
+	if ( t_pCache != 0 )  {
+		return t_pCache;
+	}
+
+	pthread_once(&g_once, slabInit);
+
+	pthread_mutex_lock(&g_lock);
+	pCache = g_pOrphanList;
+	if ( pCache != 0 )  {
+		g_pOrphanList = pCache->pNextOrphan;
+		pCache->pNextOrphan = 0;
+	}
+	else {
+		pCache = (slab_cache_t*)memAlloc(sizeof(slab_cache_t));
+		if ( pCache != 0 )  {
+			_tbzero(pCache, sizeof(slab_cache_t));
+			pCache->pNext = g_pCacheList;
+			g_pCacheList = pCache;
+		}
+	}
+	pthread_mutex_unlock(&g_lock);
+
+	if ( pCache != 0 )  {
+		pthread_setspecific(g_key, pCache);
+		t_pCache = pCache;
+	}
+
+	return pCache;
+}
+
+/*
+ * Carve a new chunk to the free list of the size class
+ *
+ * 		pCache		current thread cache
+ * 		nClass		size class index
+ *
+ * Return: TRUE on success, FALSE on out of memory
+ */
+static boolean_t slabRefill(slab_cache_t* pCache, size_t nClass)
+{
+	size_t			nStride = sizeof(slab_block_t)+g_arClassSize[nClass];
+	size_t			nCount = SLAB_CHUNK_SIZE/nStride, i;
+	uint8_t*		pChunk;
+	slab_block_t*	pBlock;
+
+	pChunk = (uint8_t*)memAlloc(nCount*nStride);
+	if ( pChunk == 0 )  {
+		return FALSE;
+	}
+
+	for(i=0; i<nCount; i++)  {
+		pBlock = (slab_block_t*)&pChunk[i*nStride];
+		pBlock->nClass = (uint16_t)nClass;
+		pBlock->nMagic = SLAB_MAGIC;
+		pBlock->pNext = pCache->arClass[nClass].pFree;
+		pCache->arClass[nClass].pFree = pBlock;
+	}
+
+	pCache->nChunkSize += nCount*nStride;
+	return TRUE;
+}
+
+static void* slabAllocLarge(slab_cache_t* pCache, size_t nSize)
+{
+	slab_block_t*	pBlock;
+
+	pBlock = (slab_block_t*)memAlloc(sizeof(slab_block_t)+nSize);
+	if ( pBlock == 0 )  {
+		return NULL;
+	}
+
+	pBlock->pCache = 0;
+	pBlock->nClass = SLAB_CLASS_LARGE;
+	pBlock->nMagic = SLAB_MAGIC;
+
+	if ( pCache != 0 )  {
+		pCache->nAlloc++;
+		pCache->nLarge++;
+	}
+
+	return &pBlock[1];
+}
+
+/*
+ * Allocate a block
+ *
+ * 		nSize		block size, bytes
+ *
+ * Return: block address or NULL
+ */
+void* slabAlloc(size_t nSize)
+{
+	slab_cache_t*	pCache = slabGetCache();
+	slab_class_t*	pClass;
+	slab_block_t*	pBlock;
+	size_t			nClass;
+
+	if ( pCache == 0 || nSize > SLAB_BLOCK_MAX )  {
+		return slabAllocLarge(pCache, nSize);
+	}
+
+	nClass = g_arClassIndex[(nSize+SLAB_CLASS_STEP-1)/SLAB_CLASS_STEP];
+	pClass = &pCache->arClass[nClass];
+
+	if ( pClass->pFree == 0 && pClass->pRemote != 0 )  {
+		/* Take back all blocks freed by the other threads */
+		pClass->pFree = __sync_lock_test_and_set(&pClass->pRemote, (slab_block_t*)0);
+	}
+
+	if ( pClass->pFree != 0 )  {
+		pCache->nHit++;
+	}
+	else {
+		if ( !slabRefill(pCache, nClass) )  {
+			return NULL;
+		}
+		pCache->nMiss++;
+	}
+
+	pBlock = pClass->pFree;
+	pClass->pFree = pBlock->pNext;
+
+	pBlock->pCache = pCache;
+	pCache->nAlloc++;
+
+	return &pBlock[1];
+}
+
+/*
+ * Free a block allocated by slabAlloc()
+ *
+ * 		ptr			block address or NULL
+ */
+void slabFree(void* ptr)
+{
+	slab_block_t	*pBlock, *pHead;
+	slab_cache_t*	pCache;
+	slab_class_t*	pClass;
+
+	if ( ptr == 0 )  {
+		return;
+	}
+
+	pBlock = ((slab_block_t*)ptr)-1;
+	shell_assert_ex(pBlock->nMagic == SLAB_MAGIC, "slabFree(): block is corrupt\n");
+
+	if ( pBlock->nClass == SLAB_CLASS_LARGE )  {
+		memFree(pBlock);
+		__sync_add_and_fetch(&g_nLargeFree, 1);
+		return;
+	}
+
+	pCache = pBlock->pCache;
+	pClass = &pCache->arClass[pBlock->nClass];
+
+	if ( pCache == t_pCache )  {
+		pBlock->pNext = pClass->pFree;
+		pClass->pFree = pBlock;
+		pCache->nFree++;
+	}
+	else {
+		do {
+			pHead = pClass->pRemote;
+			pBlock->pNext = pHead;
+		} while ( !__sync_bool_compare_and_swap(&pClass->pRemote, pHead, pBlock) );
+
+		__sync_add_and_fetch(&pCache->nRemoteFree, 1);
+	}
+}
+
+/*
+ * Collect statistic of all thread caches
+ *
+ * 		pStat		statistic [out]
+ *
+ * Note: the counters of the running threads are read without synchronisation
+ */
+void slabGetStat(slab_stat_t* pStat)
+{
+	slab_cache_t*	pCache;
+
+	_tbzero(pStat, sizeof(*pStat));
+
+	pthread_mutex_lock(&g_lock);
+	pCache = g_pCacheList;
+	while ( pCache != 0 )  {
+		pStat->alloc_count += pCache->nAlloc;
+		pStat->free_count += pCache->nFree+pCache->nRemoteFree;
+		pStat->hit_count += pCache->nHit;
+		pStat->miss_count += pCache->nMiss;
+		pStat->remote_free_count += pCache->nRemoteFree;
+		pStat->large_count += pCache->nLarge;
+		pStat->chunk_size += pCache->nChunkSize;
+		pStat->cache_count++;
+		pCache = pCache->pNext;
+	}
+	pthread_mutex_unlock(&g_lock);
+
+	pStat->free_count += g_nLargeFree;
+}
+
+/*
+ * Reset the event counters (the chunk size is kept)
+ */
+void slabResetStat()
+{
+	slab_cache_t*	pCache;
+
+	pthread_mutex_lock(&g_lock);
+	pCache = g_pCacheList;
+	while ( pCache != 0 )  {
+		pCache->nAlloc = pCache->nFree = 0;
+		pCache->nHit = pCache->nMiss = pCache->nLarge = 0;
+		pCache->nRemoteFree = 0;
+		pCache = pCache->pNext;
+	}
+	pthread_mutex_unlock(&g_lock);
+
+	g_nLargeFree = 0;
+}
@@ -0,0 +1,63 @@
+/*
+ *  Carbon framework
+ *  Thread caching slab allocator
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 17.10.2026 14:02:36
+ *      Initial revision.
+ */
+
+#ifndef __CARBON_SLAB_ALLOCATOR_H_INCLUDED__
+#define __CARBON_SLAB_ALLOCATOR_H_INCLUDED__
+
+#include "shell/config.h"
+#include "shell/types.h"
+
+/*
+ * Blocks up to SLAB_BLOCK_MAX bytes are served by the size classes,
+ * the larger blocks are passed to memAlloc()/memFree()
+ */
+#define SLAB_BLOCK_MAX				1024
+#define SLAB_CHUNK_SIZE				(64*1024)	/* Size class refill, bytes */
+
+/*
+ * Slab allocator statistic
+ */
+typedef struct {
+	uint64_t	alloc_count;				/* Allocated blocks */
+	uint64_t	free_count;					/* Freed blocks */
+	uint64_t	hit_count;					/* Allocations served by a thread cache */
+	uint64_t	miss_count;					/* Allocations required a new chunk */
+	uint64_t	remote_free_count;			/* Blocks freed by a non-owner thread */
+	uint64_t	large_count;				/* Allocations above SLAB_BLOCK_MAX */
+	uint64_t	chunk_size;					/* Memory taken by the chunks, bytes */
+	uint64_t	cache_count;				/* Thread caches */
+} slab_stat_t;
+
+/*
+ * Allocate a block
+ *
+ * 		nSize		block size, bytes
+ *
+ * Return: block address or NULL
+ *
+ * Note: the block may be freed by any thread
+ */
+extern void* slabAlloc(size_t nSize);
+
+/*
+ * Free a block allocated by slabAlloc()
+ *
+ * 		ptr			block address or NULL
+ */
+extern void slabFree(void* ptr);
+
+extern void slabGetStat(slab_stat_t* pStat);
+extern void slabResetStat();
+
+#endif /* __CARBON_SLAB_ALLOCATOR_H_INCLUDED__ */
@@ -10,6 +10,10 @@
  *
  *  Revision 1.0, 08.06.2015 12:00:27
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 05:12:40
+ *  	Per-request wait object, any number of the sync operations
+ *  	may be outstanding on the same event loop.
  */
 
 #ifndef __CARBON_SYNC_H_INCLUDED__
@@ -19,15 +23,28 @@
 #include "carbon/lock.h"
 #include "carbon/event.h"
 
+class CEventLoop;
+
 class CSyncBase
 {
+	friend class CEventLoop;
+
 	protected:
 		seqnum_t		m_sessId;
 		dec_ptr<CEvent>	m_pEvent;		/* Reply event */
 
+	private:
+		CCondition		m_cond;			/* Reply waiting on variable */
+		boolean_t		m_bReady;		/* TRUE: reply has been attached */
+		boolean_t		m_bCancel;		/* TRUE: event loop is stopping */
+		CSyncBase*		m_pNext;		/* Event loop sync table chain */
+
 	public:
 		CSyncBase(seqnum_t sessId) :
-			m_sessId(sessId)
+			m_sessId(sessId),
+			m_bReady(FALSE),
+			m_bCancel(FALSE),
+			m_pNext(0)
 		{
 		}
 
@@ -10,8 +10,17 @@
  *
  *  Revision 1.0, 07.05.2015 20:59:57
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Added keep-alive client connections.
+ *
+ *  Revision 1.2, 18.10.2026 13:21:40
+ *      Dispatch the idle connections with the buffered requests without polling.
  */
 
+#include <poll.h>
+#include <sys/socket.h>
+
 #include "shell/hr_time.h"
 #include "shell/dec_ptr.h"
 #include "shell/error.h"
@@ -28,7 +37,8 @@
 
 CTcpServer::CTcpServer(const char* strName) :
 	CObject(strName),
-	m_servAddr(NETADDR_NULL)
+	m_servAddr(NETADDR_NULL),
+	m_hrKeepAlive(HR_0)
 {
 	m_pSocket = new CSocketRef();
 	sh_atomic_set(&m_nStop, 0);
@@ -36,6 +46,7 @@ CTcpServer::CTcpServer(const char* strName) :
 
 CTcpServer::~CTcpServer()
 {
+	releaseKeepAlive();
 	m_pSocket->close();
 	m_pSocket->release();
 }
@@ -76,6 +87,12 @@ result_t CTcpServer::run()
 		return nresult;
 	}
 
+	if ( m_hrKeepAlive != HR_0 )  {
+		nresult = runKeepAlive();
+		m_pSocket->close();
+		return nresult;
+	}
+
 	/*
 	 * Processing connections
 	 */
@@ -109,3 +126,196 @@ result_t CTcpServer::run()
 	m_pSocket->close();
 	return nresult;
 }
+
+/*
+ * Watch the client connection for the next request
+ *
+ * 		pSocket		connected client socket, the request has been received
+ *
+ * Return:
+ * 		ESUCCESS		connection is watched by the server
+ * 		ENOSYS			keep-alive is disabled, the connection will be closed
+ * 		ENOSPC			too many idle connections
+ *
+ * Note: the next request is passed to the processClient() on the listen thread.
+ *       A connection with the request already in the read-ahead buffer is passed
+ *       without polling.
+ */
+result_t CTcpServer::keepAlive(CSocketRef* pSocket)
+{
+	tcp_server_keep_t	keep;
+	result_t			nresult = ESUCCESS;
+
+	if ( m_hrKeepAlive == HR_0 || !m_breaker.isEnabled() || isStopping() )  {
+		return ENOSYS;
+	}
+
+	m_lock.lock();
+	if ( m_arKeep.size() < TCP_SERVER_KEEPALIVE_MAX )  {
+		keep.pSocket = pSocket;
+		keep.hrTime = hr_time_now();
+		pSocket->reference();
+		m_arKeep.push_back(keep);
+	}
+	else {
+		nresult = ENOSPC;
+	}
+	m_lock.unlock();
+
+	if ( nresult == ESUCCESS )  {
+		m_breaker._break();
+	}
+
+	return nresult;
+}
+
+/*
+ * Release the client connections pending to watch
+ */
+void CTcpServer::releaseKeepAlive()
+{
+	size_t	i;
+
+	m_lock.lock();
+	for(i=0; i<m_arKeep.size(); i++)  {
+		m_arKeep[i].pSocket->release();
+	}
+	m_arKeep.clear();
+	m_lock.unlock();
+}
+
+/*
+ * Process new connections and the requests on the idle client connections
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CTcpServer::runKeepAlive()
+{
+	std::vector<tcp_server_keep_t>	arKeep;
+	std::vector<struct pollfd>		arPfd;
+	hr_time_t						hrNow, hrIdle;
+	int								msTimeout, n;
+	size_t							i, j;
+	boolean_t						bReadAhead;
+	char							ch;
+	result_t						nresult;
+
+	if ( !m_breaker.isEnabled() )  {
+		nresult = m_breaker.enable();
+		if ( nresult != ESUCCESS )  {
+			log_debug(L_GEN, "[tcp_server] failed to enable breaker, result %d\n", nresult);
+			return nresult;
+		}
+	}
+
+	nresult = ESUCCESS;
+
+	while ( !isStopping() )  {
+		/* Take the connections passed since the last poll */
+		m_lock.lock();
+		arKeep.insert(arKeep.end(), m_arKeep.begin(), m_arKeep.end());
+		m_arKeep.clear();
+		m_lock.unlock();
+
+		hrNow = hr_time_now();
+		msTimeout = (int)HR_TIME_TO_MILLISECONDS(HR_1MIN);
+		bReadAhead = FALSE;
+		arPfd.resize(2);
+
+		i = 0;
+		while ( i < arKeep.size() )  {
+			hrIdle = hrNow - arKeep[i].hrTime;
+			if ( hrIdle >= m_hrKeepAlive )  {
+				arKeep[i].pSocket->release();
+				arKeep.erase(arKeep.begin()+i);
+				continue;
+			}
+
+			msTimeout = sh_min(msTimeout, (int)HR_TIME_TO_MILLISECONDS(m_hrKeepAlive-hrIdle)+1);
+			if ( arKeep[i].pSocket->getReadAhead() > 0 )  {
+				/* The request is already received, poll() does not see it */
+				bReadAhead = TRUE;
+				msTimeout = 0;
+			}
+
+			arPfd.resize(arPfd.size()+1);
+			arPfd.back().fd = arKeep[i].pSocket->getHandle();
+			arPfd.back().events = POLLIN|POLLPRI;
+			arPfd.back().revents = 0;
+			i++;
+		}
+
+		arPfd[0].fd = m_pSocket->getHandle();
+		arPfd[0].events = POLLIN;
+		arPfd[0].revents = 0;
+		arPfd[1].fd = m_breaker.getRHandle();
+		arPfd[1].events = POLLIN;
+		arPfd[1].revents = 0;
+
+		n = ::poll(&arPfd[0], arPfd.size(), msTimeout);
+		if ( n == 0 && !bReadAhead )  {
+			continue;
+		}
+
+		if ( n < 0 )  {
+			nresult = errno;
+			if ( nresult == EINTR )  {
+				nresult = ESUCCESS;
+				break;
+			}
+
+			log_debug(L_GEN, "[tcp_server] polling failed, result %d\n", nresult);
+			hr_sleep(HR_1SEC);
+			nresult = ESUCCESS;
+			continue;
+		}
+
+		if ( arPfd[1].revents != 0 )  {
+			m_breaker.reset();
+		}
+
+		/* Requests and disconnections on the idle connections */
+		for(i=arKeep.size(); i>0 && nresult == ESUCCESS; i--)  {
+			j = i-1;
+			if ( arPfd[j+2].revents == 0 && arKeep[j].pSocket->getReadAhead() == 0 )  {
+				continue;
+			}
+
+			dec_ptr<CSocketRef>		clientSocketPtr = arKeep[j].pSocket;
+
+			arKeep.erase(arKeep.begin()+j);
+			if ( clientSocketPtr->getReadAhead() > 0 ||
+					((arPfd[j+2].revents&(POLLIN|POLLPRI)) != 0 &&
+					::recv(clientSocketPtr->getHandle(), &ch, 1, MSG_PEEK|MSG_DONTWAIT) > 0) )
+			{
+				nresult = processClient(clientSocketPtr);
+			}
+		}
+
+		if ( nresult == ESUCCESS && (arPfd[0].revents&POLLIN) != 0 )  {
+			dec_ptr<CSocketRef>		clientSocketPtr;
+
+			clientSocketPtr = m_pSocket->accept();
+			if ( (CSocketRef*)clientSocketPtr )  {
+				nresult = processClient(clientSocketPtr);
+			}
+		}
+
+		if ( nresult == EINTR || nresult == ECANCELED )  {
+			nresult = ESUCCESS;
+			break;
+		}
+
+		if ( nresult != ESUCCESS )  {
+			log_debug(L_GEN, "[tcp_server] client processing failed, result %d\n", nresult);
+			nresult = ESUCCESS;
+		}
+	}
+
+	for(i=0; i<arKeep.size(); i++)  {
+		arKeep[i].pSocket->release();
+	}
+	releaseKeepAlive();
+
+	return nresult;
+}
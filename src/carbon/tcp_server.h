@@ -10,17 +10,35 @@
  *
  *  Revision 1.0, 06.05.2015 23:47:40
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 02:48:10
+ *      Added keep-alive client connections (setKeepAlive(), keepAlive()).
  */
 
 #ifndef __CARBON_TCP_SERVER_H_INCLUDED__
 #define __CARBON_TCP_SERVER_H_INCLUDED__
 
+#include <vector>
+
 #include "shell/socket.h"
 #include "shell/atomic.h"
 #include "shell/object.h"
+#include "shell/breaker.h"
 
+#include "carbon/lock.h"
 #include "carbon/cstring.h"
 
+#define TCP_SERVER_KEEPALIVE_MAX			256		/* Maximum idle client connections */
+
+/*
+ * Idle client connection
+ */
+typedef struct
+{
+	CSocketRef*		pSocket;			/* Client socket */
+	hr_time_t		hrTime;				/* Last request time */
+} tcp_server_keep_t;
+
 class CTcpServer : public CObject
 {
 	protected:
@@ -29,13 +47,41 @@ class CTcpServer : public CObject
 		CString				m_strSocket;		/* Socket to listen on */
 		atomic_t			m_nStop;			/* TRUE: stopping server */
 
+		hr_time_t			m_hrKeepAlive;		/* Idle client connection timeout, HR_0: disabled */
+		std::vector<tcp_server_keep_t>	m_arKeep;	/* Client connections to watch */
+		CMutex				m_lock;				/* m_arKeep lock */
+		CFileBreaker		m_breaker;			/* Connection watch breaker */
+
 	public:
 		explicit CTcpServer(const char* strName);
 		virtual ~CTcpServer();
 
 	public:
 		virtual result_t run();
-		virtual void stop() { sh_atomic_inc(&m_nStop); }
+		virtual void stop() {
+			sh_atomic_inc(&m_nStop);
+			if ( m_breaker.isEnabled() )  {
+				m_breaker._break();
+			}
+		}
+
+		/*
+		 * Keep the client connections open after the request and process
+		 * the following requests on the same connection
+		 *
+		 * 		hrKeepAlive		idle client connection timeout, HR_0: close after the request
+		 *
+		 * Note: must be set before run().
+		 */
+		void setKeepAlive(hr_time_t hrKeepAlive) {
+			m_hrKeepAlive = hrKeepAlive;
+		}
+
+		hr_time_t getKeepAlive() const {
+			return m_hrKeepAlive;
+		}
+
+		virtual result_t keepAlive(CSocketRef* pSocket);
 
 	public:
 		boolean_t isAddrLocal() const {
@@ -72,6 +118,10 @@ class CTcpServer : public CObject
 		}
 
 		virtual result_t processClient(CSocketRef* pSocket) = 0;
+
+	private:
+		result_t runKeepAlive();
+		void releaseKeepAlive();
 };
 
 #endif /* __CARBON_TCP_SERVER_H_INCLUDED__ */
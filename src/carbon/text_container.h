@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 19.04.2015 16:35:06
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 11:24:12
+ *      Added isReceiving().
  */
 
 #ifndef __CARBON_TEXT_CONTAINER_H_INCLUDED__
@@ -50,6 +53,7 @@ class CTextContainer : public CNetContainer
 
 		virtual result_t send(CSocketAsync& socket, uint32_t* pOffset);
 		virtual result_t receive(CSocketAsync& socket);
+		virtual boolean_t isReceiving() const { return m_nSize > 0; }
 
 		virtual void dump(const char* strPref = "") const;
 
@@ -13,6 +13,9 @@
  *
  *  Revision 1.0, 15.02.2017 11:10:16
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 14:25:40
+ *      Thread caching slab allocator.
  */
 
 #include <new>
@@ -21,12 +24,19 @@
 #include "carbon/event.h"
 #include "carbon/memory.h"
 #include "carbon/logger.h"
+#if CARBON_SLAB_ALLOCATOR
+#include "carbon/slab_allocator.h"
+#endif /* CARBON_SLAB_ALLOCATOR */
 
 static void* default_dynamic_alloc(size_t size) throw()
 {
 	void*	pData;
 
+#if CARBON_SLAB_ALLOCATOR
+	pData = slabAlloc(size);
+#else /* CARBON_SLAB_ALLOCATOR */
 	pData = memAlloc(size);
+#endif /* CARBON_SLAB_ALLOCATOR */
 	if ( pData )  {
 		return pData;
 	}
@@ -38,7 +48,11 @@ static void* default_dynamic_alloc(size_t size) throw()
 static void default_dymanic_free(void* pData)
 {
 	if ( pData ) {
+#if CARBON_SLAB_ALLOCATOR
+		slabFree(pData);
+#else /* CARBON_SLAB_ALLOCATOR */
 		memFree(pData);
+#endif /* CARBON_SLAB_ALLOCATOR */
 	}
 }
 
@@ -13,6 +13,9 @@
  *
  *  Revision 1.1, 14.08.2017 14:17:30
  *  	Fixed parseAppPath(), changed strPath size to PATH_MAX
+ *
+ *  Revision 1.2, 18.10.2026 08:14:52
+ *  	Dump the logger flight recorder on EV_USR1.
  */
 
 #include <limits.h>
@@ -117,6 +120,7 @@ boolean_t CApplication::processEvent(CEvent* pEvent)
 			break;
 
 		case EV_USR1:
+			logger_recorder_dump();
 			onEvUsr1();
 			bProcessed = TRUE;
 			break;
@@ -10,8 +10,14 @@
  *
  *  Revision 1.0, 08.11.2017 12:16:42
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 09:41:52
+ *      Added streaming compression/decompression with per-thread contexts.
  */
 
+#include <pthread.h>
+#include <new>
+
 #include "contact/zip.h"
 
 /*******************************************************************************
@@ -124,3 +130,197 @@ result_t CZip::decompress(void* pDstBuf, size_t* pDstLen, const void* pSrcBuf, s
 
 	return nresult;
 }
+
+/*******************************************************************************
+ * CZipStream class
+ */
+
+static pthread_once_t		g_zipOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t		g_zipKey;
+
+static __thread CZipStream*	t_pZipDeflate = 0;
+static __thread CZipStream*	t_pZipInflate = 0;
+
+/*
+ * Release the exiting thread streams
+ */
+static void zipThreadExit(void* p)
+{
+	shell_unused(p);
+
+	SAFE_DELETE(t_pZipDeflate);
+	SAFE_DELETE(t_pZipInflate);
+}
+
+static void zipInit()
+{
+	shell_verify(pthread_key_create(&g_zipKey, zipThreadExit) == 0);
+}
+
+CZipStream::CZipStream(boolean_t bDeflate) :
+	m_bDeflate(bDeflate),
+	m_bInit(FALSE),
+	m_bEnd(FALSE),
+	m_nLevel(Z_DEFAULT_COMPRESSION)
+{
+	_tbzero_object(m_stream);
+}
+
+CZipStream::~CZipStream()
+{
+	if ( m_bInit )  {
+		if ( m_bDeflate )  {
+			::deflateEnd(&m_stream);
+		}
+		else {
+			::inflateEnd(&m_stream);
+		}
+	}
+}
+
+/*
+ * Start a new stream
+ *
+ * 		pDstBuf			output buffer
+ * 		nDstLen			output buffer length
+ * 		nLevel			compression level (ignored on decompression)
+ *
+ * Return: ESUCCESS, ENOMEM, EINVAL
+ *
+ * Note: the compression output buffer should be at least getBound() bytes
+ */
+result_t CZipStream::start(void* pDstBuf, size_t nDstLen, int nLevel)
+{
+	int		zerror;
+
+	if ( !m_bInit )  {
+		zerror = m_bDeflate ? ::deflateInit(&m_stream, nLevel) : ::inflateInit(&m_stream);
+		if ( zerror != Z_OK )  {
+			return CZip::zerror2nresult(zerror);
+		}
+
+		m_bInit = TRUE;
+		m_nLevel = nLevel;
+	}
+	else {
+		zerror = m_bDeflate ? ::deflateReset(&m_stream) : ::inflateReset(&m_stream);
+		if ( zerror == Z_OK && m_bDeflate && nLevel != m_nLevel )  {
+			/* Nothing was compressed yet, the parameters change is immediate */
+			zerror = ::deflateParams(&m_stream, nLevel, Z_DEFAULT_STRATEGY);
+			m_nLevel = nLevel;
+		}
+
+		if ( zerror != Z_OK )  {
+			return CZip::zerror2nresult(zerror);
+		}
+	}
+
+	m_stream.next_out = (Bytef*)pDstBuf;
+	m_stream.avail_out = (uInt)nDstLen;
+	m_bEnd = FALSE;
+
+	return ESUCCESS;
+}
+
+/*
+ * Compress/decompress a next data part
+ *
+ * 		pSrcBuf			source data
+ * 		nSrcLen			source data length
+ *
+ * Return:
+ * 		ESUCCESS		all data has been processed
+ * 		ENOSPC			output buffer is full
+ * 		EFAULT			invalid compressed data
+ * 		...
+ */
+result_t CZipStream::update(const void* pSrcBuf, size_t nSrcLen)
+{
+	int		zerror;
+
+	shell_assert(m_bInit);
+
+	m_stream.next_in = (Bytef*)pSrcBuf;
+	m_stream.avail_in = (uInt)nSrcLen;
+
+	while ( m_stream.avail_in > 0 )  {
+		if ( m_bEnd )  {
+			/* Data after the compressed stream end */
+			return EFAULT;
+		}
+
+		zerror = m_bDeflate ? ::deflate(&m_stream, Z_NO_FLUSH) : ::inflate(&m_stream, Z_NO_FLUSH);
+		if ( zerror == Z_STREAM_END )  {
+			m_bEnd = TRUE;
+		}
+		else if ( zerror == Z_BUF_ERROR )  {
+			/* No progress is possible, the output buffer is full */
+			return m_bDeflate ? ENOSPC : EFAULT;
+		}
+		else if ( zerror != Z_OK )  {
+			return zerror == Z_NEED_DICT ? EFAULT : CZip::zerror2nresult(zerror);
+		}
+	}
+
+	return ESUCCESS;
+}
+
+/*
+ * Complete the stream
+ *
+ * 		pDstLen			output data length [out]
+ *
+ * Return:
+ * 		ESUCCESS		stream has been completed
+ * 		ENOSPC			compression output buffer is full
+ * 		EFAULT			truncated compressed data
+ */
+result_t CZipStream::finish(size_t* pDstLen)
+{
+	int		zerror;
+
+	shell_assert(m_bInit);
+
+	if ( m_bDeflate )  {
+		m_stream.next_in = 0;
+		m_stream.avail_in = 0;
+
+		zerror = ::deflate(&m_stream, Z_FINISH);
+		if ( zerror != Z_STREAM_END )  {
+			return zerror == Z_OK || zerror == Z_BUF_ERROR ? ENOSPC : CZip::zerror2nresult(zerror);
+		}
+	}
+	else if ( !m_bEnd )  {
+		return EFAULT;
+	}
+
+	*pDstLen = (size_t)m_stream.total_out;
+	return ESUCCESS;
+}
+
+/*
+ * Get the stream owned by the current thread
+ *
+ * Return: stream or NULL (out of memory)
+ */
+CZipStream* CZipStream::getDeflate()
+{
+	if ( t_pZipDeflate == 0 )  {
+		pthread_once(&g_zipOnce, zipInit);
+		t_pZipDeflate = new(std::nothrow) CZipStream(TRUE);
+		pthread_setspecific(g_zipKey, (void*)1);
+	}
+
+	return t_pZipDeflate;
+}
+
+CZipStream* CZipStream::getInflate()
+{
+	if ( t_pZipInflate == 0 )  {
+		pthread_once(&g_zipOnce, zipInit);
+		t_pZipInflate = new(std::nothrow) CZipStream(FALSE);
+		pthread_setspecific(g_zipKey, (void*)1);
+	}
+
+	return t_pZipInflate;
+}
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 08.11.2017 12:09:56
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 09:41:18
+ *      Added streaming compression/decompression with per-thread contexts.
  */
 
 #ifndef __CONTACT_ZIP_H_INCLUDED__
@@ -34,8 +37,40 @@ class CZip
 		result_t compress(void* pDstBuf, size_t* pDstLen, const void* pSrcBuf, size_t nSrcLen, int nLevel);
 		result_t decompress(void* pDstBuf, size_t* pDstLen, const void* pSrcBuf, size_t nSrcLen);
 
+		static result_t zerror2nresult(int zerror);
+};
+
+/*
+ * Streaming compression/decompression (zlib format)
+ *
+ * The data is fed by any number of update() calls to the output buffer
+ * given by start(). A stream is reset (not reallocated) on the next start(),
+ * the per-thread streams are returned by getDeflate()/getInflate().
+ */
+class CZipStream
+{
 	protected:
-		result_t zerror2nresult(int zerror);
+		z_stream		m_stream;				/* zlib stream */
+		boolean_t		m_bDeflate;				/* TRUE: compression, FALSE: decompression */
+		boolean_t		m_bInit;				/* Stream is initialised */
+		boolean_t		m_bEnd;					/* Decompression: stream end has been reached */
+		int				m_nLevel;				/* Compression level of the initialised stream */
+
+	public:
+		CZipStream(boolean_t bDeflate);
+		~CZipStream();
+
+	public:
+		result_t start(void* pDstBuf, size_t nDstLen, int nLevel = Z_DEFAULT_COMPRESSION);
+		result_t update(const void* pSrcBuf, size_t nSrcLen);
+		result_t finish(size_t* pDstLen);
+
+		static size_t getBound(size_t nSrcLen) {
+			return (size_t)::deflateBound(NULL, (uLong)nSrcLen);
+		}
+
+		static CZipStream* getDeflate();
+		static CZipStream* getInflate();
 };
 
 #endif /* __CONTACT_ZIP_H_INCLUDED__ */
@@ -9,6 +9,17 @@
  *
  *  Revision 1.0, 03.08.2020 12:39:33
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:38:09
+ *      Prepared statements with the bound parameters and per connection
+ *      statement cache, streaming iterate mode (mysql_use_result()).
+ *
+ *  Revision 1.2, 18.10.2026 11:04:20
+ *      Parameter bindings are kept in the connection object
+ *      (SQL_PARAM_MAX is large enough for the multi-row inserts).
+ *
+ *  Revision 1.3, 18.10.2026 12:57:14
+ *      Deadlock, lock wait timeout and lost connection result codes.
  */
 /*
  * Initialisation:
@@ -62,6 +73,23 @@
  *		catch(std::sql_exception& ex)  {
  *			log_error(L_SQL, "[mysql] database iterate failed, result %d\n", ex.getResult());
  *		}
+ *
+ * Prepared statements:
+ *
+ * 		CSqlParam	arParam[] = { CSqlParam(strName), CSqlParam(ip) };
+ *
+ * 		nresult = db.query("UPDATE host SET name=? WHERE ip=?", arParam, ARRAY_SIZE(arParam));
+ *
+ * 	Statements are prepared on the first use and kept in the per connection
+ * 	LRU cache (setStatementCache()), the cache is cleared on disconnect.
+ * 	Parametrised iterate() result holds the connection lock until free().
+ *
+ * Streaming iterate:
+ *
+ * 		db.iterate("SELECT * FROM track", &res, SQL_ITERATE_STREAM);
+ *
+ * 	Rows are fetched from the server one by one (mysql_use_result()), the
+ * 	connection is locked until the result is freed.
  */
 
 #include <stdexcept>
@@ -180,6 +208,10 @@ result_t errMySql2Nr(unsigned int nErr)
 		case ER_DUP_ENTRY:					nresult = EEXIST; break;
 		case CR_OUT_OF_MEMORY:				nresult = ENOMEM; break;
 		case ER_NO_SUCH_TABLE:				nresult = ENOENT; break;
+		case ER_LOCK_DEADLOCK:				nresult = EDEADLK; break;
+		case ER_LOCK_WAIT_TIMEOUT:			nresult = EBUSY; break;
+		case CR_SERVER_GONE_ERROR:
+		case CR_SERVER_LOST:				nresult = ENOTCONN; break;
 		default:							nresult = EIO; break;
 	}
 
@@ -208,7 +240,8 @@ CDbMySql::CDbMySql(const CNetAddr& server, const char* strUser, const char* strP
 	m_pHandle(nullptr),
 	m_nAutoReconnect(MYSQL_AUTORECONNECT_DEFAULT),
 	m_bMultiStmt(false),
-	m_nResultCount(ZERO_ATOMIC)
+	m_nResultCount(ZERO_ATOMIC),
+	m_stmtCache(freeStatement)
 {
 }
 
@@ -224,7 +257,8 @@ CDbMySql::CDbMySql(const CNetAddr& server, const char* strUser, const char* strP
 	m_pHandle(nullptr),
 	m_nAutoReconnect(MYSQL_AUTORECONNECT_DEFAULT),
 	m_bMultiStmt(false),
-	m_nResultCount(ZERO_ATOMIC)
+	m_nResultCount(ZERO_ATOMIC),
+	m_stmtCache(freeStatement)
 {
 }
 
@@ -417,12 +451,35 @@ void CDbMySql::doDisconnect()
 {
 	shell_assert(m_pHandle);
 
+	m_stmtCache.clear();
 	::mysql_close(m_pHandle);
 	m_pHandle = nullptr;
 
 	log_trace(L_SQL, "[mysql] disconnected database %s\n", m_server.cs());
 }
 
+/*
+ * [Static]
+ *
+ * Statement cache destructor
+ */
+void CDbMySql::freeStatement(MYSQL_STMT* pStmt)
+{
+	mysql_stmt_close(pStmt);
+}
+
+/*
+ * Set prepared statement cache size
+ *
+ * 		nMax		maximum cached statements, 0 - disable caching
+ */
+void CDbMySql::setStatementCache(size_t nMax)
+{
+	CAutoLock		locker(m_lock);
+
+	m_stmtCache.setMax(nMax);
+}
+
 /*
  * Enable/disable multi-statement execution
  *
@@ -972,31 +1029,40 @@ result_t CDbMySql::queryRow(const char* strQuery, str_vector_t* pVector)
  *
  * 		strQuery		sql query to iterate
  * 		pResult			intermediate result
+ * 		nFlags			SQL_ITERATE_STREAM: fetch rows one by one (mysql_use_result()),
+ * 						the connection is locked until the result is freed
  *
  * Return: exception on error (nr=EEXIST,ENOENT,EIO,ENOMEM)
  */
-void CDbMySql::iterate(const char* strQuery, CSqlResult* pResult) noexcept(false)
+void CDbMySql::iterate(const char* strQuery, CSqlResult* pResult, int nFlags) noexcept(false)
 {
-	CAutoLock		locker(m_lock);
 	CMySqlResult*	pMySqlResult = dynamic_cast<CMySqlResult*>(pResult);
 	MYSQL_RES*		pMysqlRes;
 	const char*		strErr;
 	unsigned int	nErr;
+	boolean_t		bStream = (nFlags&SQL_ITERATE_STREAM) != 0;
 	result_t		nresult;
 
 	shell_assert(pMySqlResult);
 
-	log_trace(L_SQL, "[mysql] iterate query: '%s'\n", strQuery);
+	log_trace(L_SQL, "[mysql] iterate query: '%s'%s\n", strQuery, bStream ? " (stream)" : "");
+
+	m_lock.lock();
 
 	nresult = doQuery(strQuery);
 	if ( nresult != ESUCCESS )  {
+		m_lock.unlock();
 		throw std::sql_exception(nresult);
 	}
 
-	pMysqlRes = mysql_store_result(m_pHandle);
+	pMysqlRes = bStream ? mysql_use_result(m_pHandle) : mysql_store_result(m_pHandle);
 	if ( pMysqlRes ) {
-		pMySqlResult->init(this, pMysqlRes, FALSE);
+		/* Streaming result keeps the lock until free() */
+		pMySqlResult->init(this, pMysqlRes, bStream);
 		sh_atomic_inc(&m_nResultCount);
+		if ( !bStream )  {
+			m_lock.unlock();
+		}
 	}
 	else {
 		nErr = ::mysql_errno(m_pHandle);
@@ -1004,15 +1070,398 @@ void CDbMySql::iterate(const char* strQuery, CSqlResult* pResult) noexcept(false
 			strErr = ::mysql_error(m_pHandle);
 			nresult = errMySql2Nr(nErr);
 
-			log_error(L_SQL, "[mysql] mysql_store_result() failed, query='%s', "
-							 "mysql error %d (%s)\n", strQuery, nErr, strErr);
+			log_error(L_SQL, "[mysql] %s() failed, query='%s', mysql error %d (%s)\n",
+					  bStream ? "mysql_use_result" : "mysql_store_result", strQuery, nErr, strErr);
+			m_lock.unlock();
 			throw std::sql_exception(nresult);
 		}
 
+		m_lock.unlock();
 		pMySqlResult->init(this, pMysqlRes, FALSE);
 	}
 }
 
+/*
+ * Bind query parameters to the statement bindings
+ *
+ * 		arBind			statement bindings [out]
+ * 		arLength		text/blob lengths [out]
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ */
+static void bindParams(MYSQL_BIND* arBind, unsigned long* arLength,
+					   const CSqlParam* arParam, size_t nParams)
+{
+	size_t	i;
+
+	_tbzero(arBind, nParams*sizeof(MYSQL_BIND));
+
+	for(i=0; i<nParams; i++)  {
+		arBind[i].buffer = (void*)arParam[i].getBuffer();
+
+		switch ( arParam[i].getType() )  {
+			case SQL_PARAM_INT64:
+				arBind[i].buffer_type = MYSQL_TYPE_LONGLONG;
+				break;
+
+			case SQL_PARAM_UINT64:
+				arBind[i].buffer_type = MYSQL_TYPE_LONGLONG;
+				arBind[i].is_unsigned = 1;
+				break;
+
+			case SQL_PARAM_DOUBLE:
+				arBind[i].buffer_type = MYSQL_TYPE_DOUBLE;
+				break;
+
+			case SQL_PARAM_TEXT:
+			case SQL_PARAM_BLOB:
+				arLength[i] = (unsigned long)arParam[i].getSize();
+				arBind[i].buffer_type = arParam[i].getType() == SQL_PARAM_TEXT ?
+										MYSQL_TYPE_STRING : MYSQL_TYPE_BLOB;
+				arBind[i].buffer_length = arLength[i];
+				arBind[i].length = &arLength[i];
+				break;
+
+			default:
+				arBind[i].buffer_type = MYSQL_TYPE_NULL;
+				arBind[i].buffer = nullptr;
+				break;
+		}
+	}
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ *
+ * 		strQuery		query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		ppStmt			executed statement [out]
+ *
+ * Return:
+ * 		ESUCCESS		query executed
+ * 		EINVAL			invalid parameter count
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: Function do connect and reconnect as necessary.
+ * Note: Statement is taken from the statement cache or prepared, the
+ * 		 caller must return it by m_stmtCache.release() after the use
+ * 		 (see CMySqlResult::free()).
+ * Note: Mutual lock must be held
+ */
+result_t CDbMySql::doExecute(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+							 MYSQL_STMT** ppStmt)
+{
+	MYSQL_STMT*		pStmt;
+	int				nCount, rc;
+	result_t		nresult;
+	const char*		strErr;
+	unsigned int	nErr;
+	boolean_t		bLost;
+
+	shell_assert_ex(m_bDbMySqlLibraryInitialised, "MySql library is not "
+					  "initialised, call CDbMySql::initLibrary()\n");
+
+	nresult = initThread();
+	if ( nresult != ESUCCESS ) {
+		return EIO;
+	}
+
+	if ( !strQuery || !*strQuery )  {
+		log_error(L_SQL, "[mysql] mysql query is empty\n");
+		return EIO;
+	}
+
+	if ( nParams > SQL_PARAM_MAX )  {
+		log_error(L_SQL, "[mysql] too many parameters %lu, query '%s'\n", nParams, strQuery);
+		return EINVAL;
+	}
+
+	bindParams(m_arParamBind, m_arParamLength, arParam, nParams);
+
+	nresult = EIO;
+	nCount = m_nAutoReconnect ? m_nAutoReconnect : 1;
+
+	for(int i=0; i<nCount; i++) {
+		if ( !isConnected() )  {
+			doConnect();
+		}
+
+		if ( isConnected() )  {
+			rc = 0;
+			pStmt = m_stmtCache.acquire(strQuery);
+			if ( !pStmt )  {
+				pStmt = mysql_stmt_init(m_pHandle);
+				if ( !pStmt )  {
+					log_error(L_SQL, "[mysql] failed to allocate statement\n");
+					nresult = ENOMEM;
+					break;
+				}
+
+				rc = mysql_stmt_prepare(pStmt, strQuery, _tstrlen(strQuery));
+				if ( rc == 0 )  {
+					m_stmtCache.insert(strQuery, pStmt);
+				}
+			}
+
+			if ( rc == 0 )  {
+				if ( mysql_stmt_param_count(pStmt) != nParams )  {
+					log_error(L_SQL, "[mysql] query '%s' expects %lu parameters, got %lu\n",
+							  strQuery, mysql_stmt_param_count(pStmt), nParams);
+					m_stmtCache.release(pStmt);
+					nresult = EINVAL;
+					break;
+				}
+
+				rc = (nParams > 0 && mysql_stmt_bind_param(pStmt, m_arParamBind)) ? 1 : 0;
+				if ( rc == 0 )  {
+					rc = mysql_stmt_execute(pStmt);
+				}
+
+				if ( rc == 0 )  {
+					/* Success */
+					*ppStmt = pStmt;
+					nresult = ESUCCESS;
+					break;
+				}
+			}
+
+			strErr = ::mysql_stmt_error(pStmt);
+			nErr = ::mysql_stmt_errno(pStmt);
+			nresult = errMySql2Nr(nErr);
+			bLost = nErr == CR_SERVER_GONE_ERROR || nErr == CR_SERVER_LOST;
+
+			if ( !bLost || (i+1) == nCount ) {
+				log_error(L_SQL, "[mysql] statement '%s' failed, mysql error %d (%s)\n",
+						  			strQuery, nErr, strErr);
+
+				m_stmtCache.release(pStmt);
+				if ( bLost )  {
+					doDisconnect();
+				}
+
+				break;
+			}
+
+			log_debug(L_SQL, "[mysql] connection lost, trying to reconnect to %s\n",
+					  				m_server.cs());
+			m_stmtCache.release(pStmt);
+			doDisconnect();
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ *
+ * Return:
+ * 		ESUCCESS		query executed
+ * 		EINVAL			invalid parameter count
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: No exception raised.
+ */
+result_t CDbMySql::query(const char* strQuery, const CSqlParam* arParam, size_t nParams)
+{
+	CAutoLock		locker(m_lock);
+	CMySqlResult	result;
+	MYSQL_STMT*		pStmt;
+	result_t		nresult;
+
+	log_trace(L_SQL, "[mysql] statement: '%s'\n", strQuery);
+
+	nresult = doExecute(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		/* Discard the result set if any */
+		nresult = result.init(this, pStmt, FALSE, FALSE);
+		result.free();
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ * and fetch a string value from the result
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pValue			fetched string [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			invalid parameter count
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ */
+result_t CDbMySql::queryValue(const char* strQuery, const CSqlParam* arParam,
+							  size_t nParams, CString* pValue)
+{
+	CAutoLock		locker(m_lock);
+	CMySqlResult	result;
+	CMySqlRow		row;
+	MYSQL_STMT*		pStmt;
+	const char*		s;
+	result_t		nresult;
+
+	log_trace(L_SQL, "[mysql] statement string value: '%s'\n", strQuery);
+
+	nresult = doExecute(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		nresult = result.init(this, pStmt, FALSE, FALSE);
+		if ( nresult == ESUCCESS )  {
+			try {
+				if ( result.getFields() > 0 && result.getRow(&row) )  {
+					s = row[0];
+					*pValue = s != nullptr ? s : "";
+				}
+				else {
+					log_debug(L_SQL, "[mysql] statement '%s' returns no data\n", strQuery);
+					nresult = ENODATA;
+				}
+			}
+			catch(const std::sql_exception& exc)  {
+				nresult = exc.getResult();
+			}
+			catch(const std::bad_alloc& exc)  {
+				log_error(L_SQL, "[mysql] out of memory\n");
+				nresult = ENOMEM;
+			}
+
+			result.free();
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ * and fetch a single row
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pVector			string values array [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			invalid parameter count
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: NULL fields are returned as empty string ("")
+ */
+result_t CDbMySql::queryRow(const char* strQuery, const CSqlParam* arParam,
+							size_t nParams, str_vector_t* pVector)
+{
+	CAutoLock		locker(m_lock);
+	CMySqlResult	result;
+	CMySqlRow		row;
+	MYSQL_STMT*		pStmt;
+	size_t			nFields;
+	const char*		s;
+	result_t		nresult;
+
+	shell_assert(pVector);
+
+	log_trace(L_SQL, "[mysql] statement row: '%s'\n", strQuery);
+
+	nresult = doExecute(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		nresult = result.init(this, pStmt, FALSE, FALSE);
+		if ( nresult == ESUCCESS )  {
+			try {
+				nFields = result.getFields();
+				if ( nFields > 0 && result.getRow(&row) )  {
+					pVector->clear();
+					pVector->reserve(nFields);
+					for(size_t i=0; i<nFields; i++)  {
+						s = row[i];
+						pVector->push_back(s != nullptr ? CString(s) : CString());
+					}
+				}
+				else {
+					log_debug(L_SQL, "[mysql] statement '%s' returns no data\n", strQuery);
+					nresult = ENODATA;
+				}
+			}
+			catch(const std::sql_exception& exc)  {
+				pVector->clear();
+				nresult = exc.getResult();
+			}
+			catch(const std::bad_alloc& exc)  {
+				pVector->clear();
+				nresult = ENOMEM;
+				log_error(L_SQL, "[mysql] out of memory\n");
+			}
+
+			result.free();
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Start iterate prepared statement with the bound parameters
+ *
+ * 		strQuery		sql query to iterate, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pResult			intermediate result
+ * 		nFlags			SQL_ITERATE_STREAM: fetch rows one by one
+ *
+ * Return: exception on error (nr=EINVAL,EEXIST,ENOENT,EIO,ENOMEM)
+ *
+ * Note: the connection is locked until the result is freed.
+ */
+void CDbMySql::iterate(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+					   CSqlResult* pResult, int nFlags) noexcept(false)
+{
+	CMySqlResult*	pMySqlResult = dynamic_cast<CMySqlResult*>(pResult);
+	MYSQL_STMT*		pStmt;
+	boolean_t		bStream = (nFlags&SQL_ITERATE_STREAM) != 0;
+	result_t		nresult;
+
+	shell_assert(pMySqlResult);
+
+	log_trace(L_SQL, "[mysql] iterate statement: '%s'%s\n", strQuery, bStream ? " (stream)" : "");
+
+	m_lock.lock();
+
+	nresult = doExecute(strQuery, arParam, nParams, &pStmt);
+	if ( nresult != ESUCCESS )  {
+		m_lock.unlock();
+		throw std::sql_exception(nresult);
+	}
+
+	/* Result keeps the lock until free(), unlocks on failure */
+	nresult = pMySqlResult->init(this, pStmt, !bStream, TRUE);
+	if ( nresult != ESUCCESS )  {
+		throw std::sql_exception(nresult);
+	}
+}
+
 /*
  * Escape the special characters
  *
@@ -1194,6 +1643,8 @@ result_t CDbMySql::recordInsert(const char* strQuery, const char* strTable, uint
 
 void CDbMySql::dump(const char* strPref) const
 {
-	log_dump("*** DbMySql%s: server %s, connected: %d\n",
-		  strPref, m_server.cs(), isConnected());
+	log_dump("*** DbMySql%s: server %s, connected: %d, statements: %lu/%lu, "
+			 "hits: %llu, misses: %llu, evicts: %llu\n",
+		  strPref, m_server.cs(), isConnected(), m_stmtCache.getCount(), m_stmtCache.getMax(),
+		  m_stmtCache.getHits(), m_stmtCache.getMisses(), m_stmtCache.getEvicts());
 }
@@ -9,6 +9,13 @@
  *
  *  Revision 1.0, 03.08.2020 12:39:33
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:37:22
+ *      Prepared statements with the bound parameters and per connection
+ *      statement cache, streaming iterate mode.
+ *
+ *  Revision 1.2, 18.10.2026 11:04:02
+ *      Parameter bindings are kept in the connection object.
  */
 
 #ifndef __DB_MYSQL_H_INCLUDED__
@@ -45,6 +52,10 @@ class CDbMySql : public CDbSql
 
 		atomic_t 		m_nResultCount;			/* Debugging: calculating result/free ops */
 
+		CSqlStatementCache<MYSQL_STMT*>	m_stmtCache;	/* Prepared statements */
+		MYSQL_BIND		m_arParamBind[SQL_PARAM_MAX];	/* Executing statement parameters */
+		unsigned long	m_arParamLength[SQL_PARAM_MAX];
+
 		static boolean_t 			m_bDbMySqlLibraryInitialised;
 		static __thread boolean_t 	m_bDbMysqlThreadInitialised;
 
@@ -72,6 +83,8 @@ class CDbMySql : public CDbSql
 		result_t enableMultiStatement(boolean_t bEnable);
 		result_t flushMultiStatementResult();
 
+		void setStatementCache(size_t nMax);
+
 		virtual result_t connect();
 		virtual result_t disconnect();
 		virtual	boolean_t isConnected() const { return m_pHandle != nullptr; }
@@ -86,7 +99,18 @@ class CDbMySql : public CDbSql
 
 		virtual result_t queryRow(const char* strQuery, str_vector_t* pVector);
 
-		virtual void iterate(const char* strQuery, CSqlResult* pResult) noexcept(false);
+		virtual void iterate(const char* strQuery, CSqlResult* pResult,
+							 int nFlags = 0) noexcept(false);
+
+		using CDbSql::queryValue;
+
+		virtual result_t query(const char* strQuery, const CSqlParam* arParam, size_t nParams);
+		virtual result_t queryValue(const char* strQuery, const CSqlParam* arParam,
+									size_t nParams, CString* pValue);
+		virtual result_t queryRow(const char* strQuery, const CSqlParam* arParam,
+								  size_t nParams, str_vector_t* pVector);
+		virtual void iterate(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+							 CSqlResult* pResult, int nFlags = 0) noexcept(false);
 
 		virtual result_t escapeSafe(const char* strQuery, CString& strOut);
 		virtual void escape(const char* strQuery, CString& strOut) noexcept(false);
@@ -98,6 +122,10 @@ class CDbMySql : public CDbSql
 		result_t doConnect();
 		void doDisconnect();
 		result_t doQuery(const char* strQuery);
+		result_t doExecute(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+						   MYSQL_STMT** ppStmt);
+
+		static void freeStatement(MYSQL_STMT* pStmt);
 
 	public:
 		virtual void dump(const char* strPref = "") const;
@@ -9,10 +9,18 @@
  *
  *  Revision 1.0, 03.08.2020 16:51:35
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:36:31
+ *      Prepared statement results, connection lock held by the
+ *      streaming result.
+ *
+ *  Revision 1.2, 18.10.2026 12:47:40
+ *      MySQL 8.0 build (no my_bool).
  */
 
 #include <mysql/mysql.h>
 
+#include "carbon/memory.h"
 #include "carbon/logger.h"
 #include "db/db_mysql.h"
 #include "db/db_mysql_result.h"
@@ -87,6 +95,121 @@ int64_t CMySqlRow::getInt64(size_t nIndex) noexcept(false)
  * CMySqlResult class
  */
 
+/*
+ * Initialise the result of the executed prepared statement
+ *
+ * 		pDb			database object
+ * 		pStmt		executed statement (from the statement cache)
+ * 		bStore		TRUE: buffer the whole result in the client memory,
+ * 					FALSE: fetch rows from the server one by one
+ * 		bLocked		TRUE: result holds the connection lock and
+ * 					unlocks it on free()
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		EIO				failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: the statement is returned to the cache (and the lock is unlocked
+ * if held) on free(), including a failure of this function.
+ */
+result_t CMySqlResult::init(CDbMySql* pDb, MYSQL_STMT* pStmt, boolean_t bStore, boolean_t bLocked)
+{
+	MYSQL_FIELD*	arField;
+	size_t			nSize, i;
+	unsigned int	nErr;
+	const char* 	strErr;
+	result_t		nresult;
+
+	shell_assert(pDb);
+	shell_assert(pStmt);
+	shell_assert(!m_pStmt);
+
+	m_pDb = pDb;
+	m_pStmt = pStmt;
+	m_bLocked = bLocked;
+
+	m_pMySqlRes = mysql_stmt_result_metadata(pStmt);
+	if ( !m_pMySqlRes )  {
+		nErr = ::mysql_stmt_errno(pStmt);
+		if ( nErr != 0 )  {
+			strErr = ::mysql_stmt_error(pStmt);
+			nresult = errMySql2Nr(nErr);
+
+			log_error(L_SQL, "[mysql] mysql_stmt_result_metadata() failed, mysql error %d (%s)\n",
+					  nErr, strErr);
+			free();
+			return nresult;
+		}
+
+		return ESUCCESS;		/* Statement returns no result set */
+	}
+
+	sh_atomic_inc(&m_pDb->m_nResultCount);
+
+	if ( bStore && mysql_stmt_store_result(pStmt) != 0 )  {
+		nErr = ::mysql_stmt_errno(pStmt);
+		strErr = ::mysql_stmt_error(pStmt);
+		nresult = errMySql2Nr(nErr);
+
+		log_error(L_SQL, "[mysql] mysql_stmt_store_result() failed, mysql error %d (%s)\n",
+				  nErr, strErr);
+		free();
+		return nresult;
+	}
+
+	/*
+	 * Bind all columns as strings to keep CMySqlRow interface
+	 */
+	m_nFields = mysql_num_fields(m_pMySqlRes);
+	nSize = m_nFields*(sizeof(MYSQL_BIND)+sizeof(char*)+sizeof(unsigned long)+2*sizeof(mysql_bool_t));
+
+	m_arBind = (MYSQL_BIND*)memAlloc(nSize);
+	if ( !m_arBind )  {
+		log_error(L_SQL, "[mysql] memory allocation failed, size %lu\n", nSize);
+		m_nFields = 0;
+		free();
+		return ENOMEM;
+	}
+
+	_tbzero(m_arBind, nSize);
+	m_arRow = (char**)&m_arBind[m_nFields];
+	m_arLength = (unsigned long*)&m_arRow[m_nFields];
+	m_arNull = (mysql_bool_t*)&m_arLength[m_nFields];
+	m_arError = &m_arNull[m_nFields];
+
+	arField = mysql_fetch_fields(m_pMySqlRes);
+	for(i=0; i<m_nFields; i++)  {
+		nSize = sh_min((size_t)arField[i].length, (size_t)MYSQL_COLUMN_BUFFER_INIT)+1;
+
+		m_arBind[i].buffer_type = MYSQL_TYPE_STRING;
+		m_arBind[i].buffer = memAlloc(nSize);
+		m_arBind[i].buffer_length = nSize;
+		m_arBind[i].length = &m_arLength[i];
+		m_arBind[i].is_null = &m_arNull[i];
+		m_arBind[i].error = &m_arError[i];
+
+		if ( !m_arBind[i].buffer )  {
+			log_error(L_SQL, "[mysql] memory allocation failed, size %lu\n", nSize);
+			free();
+			return ENOMEM;
+		}
+	}
+
+	if ( mysql_stmt_bind_result(pStmt, m_arBind) != 0 )  {
+		nErr = ::mysql_stmt_errno(pStmt);
+		strErr = ::mysql_stmt_error(pStmt);
+		nresult = errMySql2Nr(nErr);
+
+		log_error(L_SQL, "[mysql] mysql_stmt_bind_result() failed, mysql error %d (%s)\n",
+				  nErr, strErr);
+		free();
+		return nresult;
+	}
+
+	return ESUCCESS;
+}
+
 /*
  * Get field count in the result rows
  *
@@ -123,6 +246,10 @@ boolean_t CMySqlResult::getRow(CSqlRow* pRow) noexcept(false)
 		return FALSE;
 	}
 
+	if ( m_pStmt )  {
+		return getStmtRow(pMySqlRow);
+	}
+
 	row = mysql_fetch_row(m_pMySqlRes);
 	if ( row != nullptr ) {
 		pMySqlRow->init(row, mysql_num_fields(m_pMySqlRes));
@@ -142,11 +269,139 @@ boolean_t CMySqlResult::getRow(CSqlRow* pRow) noexcept(false)
 	return FALSE;
 }
 
+/*
+ * Fetch the truncated columns of the current statement row again
+ * into the enlarged buffers
+ *
+ * Return: ESUCCESS, ENOMEM, EIO
+ */
+result_t CMySqlResult::fetchTruncated()
+{
+	void*			pBuffer;
+	size_t			nSize, i;
+	unsigned int	nErr;
+	const char* 	strErr;
+
+	for(i=0; i<m_nFields; i++)  {
+		if ( !m_arError[i] )  {
+			continue;
+		}
+
+		nSize = m_arLength[i]+1;
+		pBuffer = memRealloc(m_arBind[i].buffer, nSize);
+		if ( !pBuffer )  {
+			log_error(L_SQL, "[mysql] memory allocation failed, size %lu\n", nSize);
+			return ENOMEM;
+		}
+
+		m_arBind[i].buffer = pBuffer;
+		m_arBind[i].buffer_length = nSize;
+
+		if ( mysql_stmt_fetch_column(m_pStmt, &m_arBind[i], (unsigned int)i, 0) != 0 )  {
+			nErr = ::mysql_stmt_errno(m_pStmt);
+			strErr = ::mysql_stmt_error(m_pStmt);
+
+			log_error(L_SQL, "[mysql] mysql_stmt_fetch_column() failed, mysql error %d (%s)\n",
+					  nErr, strErr);
+			return errMySql2Nr(nErr);
+		}
+	}
+
+	/* Subsequent rows are fetched into the enlarged buffers */
+	if ( mysql_stmt_bind_result(m_pStmt, m_arBind) != 0 )  {
+		nErr = ::mysql_stmt_errno(m_pStmt);
+		strErr = ::mysql_stmt_error(m_pStmt);
+
+		log_error(L_SQL, "[mysql] mysql_stmt_bind_result() failed, mysql error %d (%s)\n",
+				  nErr, strErr);
+		return errMySql2Nr(nErr);
+	}
+
+	return ESUCCESS;
+}
+
+/*
+ * Fetch the next row of the executed prepared statement
+ *
+ * 		pRow		row object to place next row
+ *
+ * Return:
+ * 		TRUE		success, returned next row
+ * 		FALSE		result is empty, no more rows
+ *
+ * Note:
+ * 		generate std::sql_exception on any db error
+ */
+boolean_t CMySqlResult::getStmtRow(CMySqlRow* pRow) noexcept(false)
+{
+	unsigned int	nErr;
+	const char* 	strErr;
+	size_t			nLength, i;
+	int				retVal;
+	result_t		nresult;
+
+	retVal = mysql_stmt_fetch(m_pStmt);
+	if ( retVal == MYSQL_NO_DATA )  {
+		return FALSE;
+	}
+
+	if ( retVal == MYSQL_DATA_TRUNCATED )  {
+		nresult = fetchTruncated();
+		if ( nresult != ESUCCESS )  {
+			throw std::sql_exception(nresult);
+		}
+	}
+	else if ( retVal != 0 )  {
+		nErr = ::mysql_stmt_errno(m_pStmt);
+		strErr = ::mysql_stmt_error(m_pStmt);
+		nresult = errMySql2Nr(nErr);
+
+		log_error(L_SQL, "[mysql] mysql_stmt_fetch() failed, mysql error %d (%s)\n",
+				  nErr, strErr);
+		throw std::sql_exception(nresult);
+	}
+
+	for(i=0; i<m_nFields; i++)  {
+		if ( !m_arNull[i] )  {
+			nLength = sh_min((size_t)m_arLength[i], (size_t)m_arBind[i].buffer_length-1);
+			m_arRow[i] = (char*)m_arBind[i].buffer;
+			m_arRow[i][nLength] = '\0';
+		}
+		else {
+			m_arRow[i] = nullptr;
+		}
+	}
+
+	pRow->init(m_arRow, m_nFields);
+	return TRUE;
+}
+
 /*
  * Free MySQL query result
+ *
+ * Note: the statement is returned to the cache, the connection lock is
+ * unlocked if held by the result.
  */
 void CMySqlResult::free()
 {
+	size_t	i;
+
+	if ( m_pStmt )  {
+		mysql_stmt_free_result(m_pStmt);
+		m_pDb->m_stmtCache.release(m_pStmt);
+		m_pStmt = nullptr;
+	}
+
+	if ( m_arBind )  {
+		for(i=0; i<m_nFields; i++)  {
+			memFree(m_arBind[i].buffer);
+		}
+
+		memFree(m_arBind);
+		m_arBind = nullptr;
+		m_nFields = 0;
+	}
+
 	if ( m_pMySqlRes )  {
 		int32_t		nResultCount;
 
@@ -160,4 +415,9 @@ void CMySqlResult::free()
 			log_error(L_SQL, "[mysql] *******************************************\n");
 		}
 	}
+
+	if ( m_bLocked )  {
+		m_bLocked = FALSE;
+		m_pDb->m_lock.unlock();
+	}
 }
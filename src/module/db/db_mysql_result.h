@@ -9,15 +9,29 @@
  *
  *  Revision 1.0, 03.08.2020 16:49:58
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:36:05
+ *      Prepared statement results, connection lock held by the
+ *      streaming result.
+ *
+ *  Revision 1.2, 18.10.2026 12:47:19
+ *      MySQL 8.0 build (no my_bool).
  */
 
 #ifndef __DB_MYSQL_RESULT_H_INCLUDED__
 #define __DB_MYSQL_RESULT_H_INCLUDED__
 
+#include <type_traits>
 #include <mysql/mysql.h>
 
 #include "db/db_sql.h"
 
+/*
+ * MYSQL_BIND flag type: my_bool (char) in MySQL 5.x and MariaDB,
+ * bool in MySQL 8.0 (my_bool has been removed)
+ */
+typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type	mysql_bool_t;
+
 /*
  * Helper class for MySQL row iterations
  */
@@ -46,6 +60,8 @@ class CMySqlRow : public CSqlRow
 
 class CDbMySql;
 
+#define MYSQL_COLUMN_BUFFER_INIT		256		/* Initial statement column buffer, bytes */
+
 /*
  * Class represents a MySQL query result
  */
@@ -53,11 +69,33 @@ class CMySqlResult : public CSqlResult
 {
 	protected:
 		CDbMySql*		m_pDb;
-		MYSQL_RES*		m_pMySqlRes;
-		boolean_t		m_bLocked;
+		MYSQL_RES*		m_pMySqlRes;			/* Query result or statement metadata */
+		boolean_t		m_bLocked;				/* Result holds the connection lock */
+
+		MYSQL_STMT*		m_pStmt;				/* Executed prepared statement */
+		size_t			m_nFields;				/* Statement result columns */
+		MYSQL_BIND*		m_arBind;				/* Statement result bindings (as strings) */
+		char**			m_arRow;				/* Current statement row */
+		unsigned long*	m_arLength;				/* Fetched column lengths */
+		mysql_bool_t*	m_arNull;				/* Fetched column NULL flags */
+		mysql_bool_t*	m_arError;				/* Fetched column truncation flags */
 
 	public:
-		CMySqlResult() : CSqlResult(), m_pDb(nullptr), m_pMySqlRes(nullptr), m_bLocked(FALSE) {}
+		CMySqlResult() :
+			CSqlResult(),
+			m_pDb(nullptr),
+			m_pMySqlRes(nullptr),
+			m_bLocked(FALSE),
+			m_pStmt(nullptr),
+			m_nFields(0),
+			m_arBind(nullptr),
+			m_arRow(nullptr),
+			m_arLength(nullptr),
+			m_arNull(nullptr),
+			m_arError(nullptr)
+		{
+		}
+
 		virtual ~CMySqlResult() { free(); }
 
 	public:
@@ -71,7 +109,13 @@ class CMySqlResult : public CSqlResult
 			m_bLocked = bLocked;
 		}
 
+		virtual result_t init(CDbMySql* pDb, MYSQL_STMT* pStmt, boolean_t bStore, boolean_t bLocked);
+
 		virtual void free();
+
+	protected:
+		boolean_t getStmtRow(CMySqlRow* pRow) noexcept(false);
+		result_t fetchTruncated();
 };
 
 #endif /* __DB_MYSQL_RESULT_H_INCLUDED__ */
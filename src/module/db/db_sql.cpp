@@ -9,8 +9,17 @@
  *
  *  Revision 1.0, 03.08.2020 12:02:48
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:34:40
+ *      Added numeric queryValue() with the bound parameters,
+ *      recursive connection lock.
+ *
+ *  Revision 1.2, 18.10.2026 11:03:15
+ *      Added begin()/commit()/rollback().
  */
 
+#include "carbon/logger.h"
+
 #include "db/db_sql.h"
 
 /*******************************************************************************
@@ -19,6 +28,7 @@
 
 CDbSql::CDbSql(const char* strName) :
 	CModule(strName),
+	m_lock(CMutex::mutexRecursive),
 	m_hrConnectTimeout(HR_0),
 	m_hrSendTimeout(HR_0),
 	m_hrRecvTimeout(HR_0)
@@ -51,3 +61,143 @@ void CDbSql::setTimeouts(hr_time_t hrSendTimeout, hr_time_t hrRecvTimeout)
 	m_hrRecvTimeout = hrRecvTimeout;
 }
 
+
+/*
+ * Execute a given SQL query with the bound parameters and
+ * fetch a UINT64 value from the result
+ *
+ * 		strQuery		SQL query to execute
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pValue			fetched value [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			value is not a number
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ */
+result_t CDbSql::queryValue(const char* strQuery, const CSqlParam* arParam,
+							size_t nParams, uint64_t* pValue)
+{
+	CString		strValue;
+	uint64_t	nValue;
+	result_t	nresult;
+
+	nresult = queryValue(strQuery, arParam, nParams, &strValue);
+	if ( nresult == ESUCCESS )  {
+		nresult = strValue.getNumber(nValue);
+		if ( nresult == ESUCCESS ) {
+			*pValue = nValue;
+		}
+		else {
+			log_debug(L_SQL, "[sql] invalid uint64 string '%s' in query '%s'\n",
+					  strValue.cs(), strQuery);
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a given SQL query with the bound parameters and
+ * fetch a INT64 value from the result
+ *
+ * 		strQuery		SQL query to execute
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pValue			fetched value [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			value is not a number
+ * 		EEXIST			query failed (duplicate key, etc)
+ * 		ENOENT			query failed (no such table, etc)
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ */
+result_t CDbSql::queryValue(const char* strQuery, const CSqlParam* arParam,
+							size_t nParams, int64_t* pValue)
+{
+	CString		strValue;
+	int64_t		nValue;
+	result_t	nresult;
+
+	nresult = queryValue(strQuery, arParam, nParams, &strValue);
+	if ( nresult == ESUCCESS )  {
+		nresult = strValue.getNumber(nValue);
+		if ( nresult == ESUCCESS ) {
+			*pValue = nValue;
+		}
+		else {
+			log_debug(L_SQL, "[sql] invalid int64 string '%s' in query '%s'\n",
+					  strValue.cs(), strQuery);
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Start a transaction
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: on success the connection stays locked by the calling thread
+ * until commit() or rollback(), queries of other threads are not mixed
+ * into the transaction.
+ */
+result_t CDbSql::begin()
+{
+	result_t	nresult;
+
+	m_lock.lock();
+
+	nresult = query("BEGIN");
+	if ( nresult != ESUCCESS )  {
+		m_lock.unlock();
+	}
+
+	return nresult;
+}
+
+/*
+ * Commit the transaction started by begin()
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: the transaction is rolled back if commit failed,
+ * the connection is unlocked in any case.
+ */
+result_t CDbSql::commit()
+{
+	result_t	nresult;
+
+	nresult = query("COMMIT");
+	if ( nresult != ESUCCESS )  {
+		log_error(L_SQL, "[sql] commit failed, result %d, rolling back\n", nresult);
+		query("ROLLBACK");
+	}
+
+	m_lock.unlock();
+	return nresult;
+}
+
+/*
+ * Roll back the transaction started by begin()
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CDbSql::rollback()
+{
+	result_t	nresult;
+
+	nresult = query("ROLLBACK");
+	m_lock.unlock();
+
+	return nresult;
+}
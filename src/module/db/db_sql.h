@@ -9,6 +9,14 @@
  *
  *  Revision 1.0, 03.08.2020 12:00:38
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:34:12
+ *      Added bound parameters (CSqlParam), per connection prepared
+ *      statement cache (CSqlStatementCache) and streaming iterate mode.
+ *
+ *  Revision 1.2, 18.10.2026 11:02:47
+ *      Added transactions holding the connection lock (begin/commit/rollback),
+ *      the connection lock is recursive. Text parameter of the given length.
  */
 
 #ifndef __DB_SQL_H_INCLUDED__
@@ -77,13 +85,318 @@ class CSqlResult
 		virtual void free() = 0;
 };
 
+#define SQL_PARAM_MAX				256			/* Maximum bound parameters per query */
+#define SQL_STMT_CACHE_DEFAULT		32			/* Default prepared statement cache size */
+
+/*
+ * SQL_ITERATE_STREAM: fetch rows from the server one by one as the caller
+ * iterates instead of buffering the whole result in the client memory.
+ * The connection stays locked until the result is freed.
+ */
+#define SQL_ITERATE_STREAM			0x0001
+
+/*
+ * Query parameter type
+ */
+typedef enum {
+	SQL_PARAM_NULL,
+	SQL_PARAM_INT64,
+	SQL_PARAM_UINT64,
+	SQL_PARAM_DOUBLE,
+	SQL_PARAM_TEXT,
+	SQL_PARAM_BLOB
+} sql_param_type_t;
+
+/*
+ * Query parameter bound to the '?' placeholder
+ *
+ * Note: text and blob data are not copied and must stay valid
+ * until the query is finished.
+ */
+class CSqlParam
+{
+	protected:
+		sql_param_type_t	m_type;
+		union {
+			int64_t			m_nInt;
+			uint64_t		m_nUint;
+			double			m_dValue;
+			const void*		m_pData;
+		};
+		size_t				m_nSize;		/* Text/blob data length, bytes */
+
+	public:
+		CSqlParam() : m_type(SQL_PARAM_NULL), m_pData(nullptr), m_nSize(0) {}
+		CSqlParam(int32_t nValue) : m_type(SQL_PARAM_INT64), m_nInt(nValue), m_nSize(0) {}
+		CSqlParam(uint32_t nValue) : m_type(SQL_PARAM_UINT64), m_nUint(nValue), m_nSize(0) {}
+		CSqlParam(int64_t nValue) : m_type(SQL_PARAM_INT64), m_nInt(nValue), m_nSize(0) {}
+		CSqlParam(uint64_t nValue) : m_type(SQL_PARAM_UINT64), m_nUint(nValue), m_nSize(0) {}
+		CSqlParam(double dValue) : m_type(SQL_PARAM_DOUBLE), m_dValue(dValue), m_nSize(0) {}
+		CSqlParam(const char* strValue) :
+			m_type(strValue ? SQL_PARAM_TEXT : SQL_PARAM_NULL),
+			m_pData(strValue),
+			m_nSize(strValue ? _tstrlen(strValue) : 0) {}
+		CSqlParam(const CString& strValue) :
+			m_type(SQL_PARAM_TEXT), m_pData(strValue.cs()), m_nSize(strValue.size()) {}
+		CSqlParam(const void* pData, size_t nSize) :
+			m_type(SQL_PARAM_BLOB), m_pData(pData), m_nSize(nSize) {}
+		CSqlParam(sql_param_type_t type, const void* pData, size_t nSize) :
+			m_type(type), m_pData(pData), m_nSize(nSize) {}
+
+	public:
+		sql_param_type_t getType() const { return m_type; }
+		int64_t getInt64() const { return m_nInt; }
+		uint64_t getUint64() const { return m_nUint; }
+		double getDouble() const { return m_dValue; }
+		const void* getData() const { return m_pData; }
+		size_t getSize() const { return m_nSize; }
+
+		/* Value buffer for the client libraries binding by pointer */
+		const void* getBuffer() const {
+			return m_type == SQL_PARAM_TEXT || m_type == SQL_PARAM_BLOB ? m_pData : &m_nInt;
+		}
+};
+
+/*
+ * Per connection LRU cache of the prepared statements
+ *
+ * Statement is taken by acquire() for the query execution and returned
+ * by release(), a busy statement is never evicted. A statement which was
+ * not cached (the cache is full of busy statements or disabled) is
+ * freed by release().
+ *
+ * Note: Caller must hold the connection lock
+ */
+template<typename T>
+class CSqlStatementCache
+{
+	public:
+		typedef void (*free_fn_t)(T pStmt);
+
+	protected:
+		struct entry_t {
+			uint32_t		hash;			/* Query text hash */
+			CString			strQuery;		/* Query text */
+			T				pStmt;			/* Prepared statement */
+			uint64_t		nUse;			/* Last use sequence */
+			boolean_t		bBusy;			/* Statement is executing */
+		};
+
+		entry_t*		m_arEntry;			/* Cached statements */
+		size_t			m_nCount;			/* Used entries */
+		size_t			m_nMax;				/* Maximum entries */
+		uint64_t		m_nSeq;				/* Use sequence counter */
+		free_fn_t		m_pfnFree;			/* Statement destructor */
+
+		uint64_t		m_nHits;			/* Statistics */
+		uint64_t		m_nMisses;
+		uint64_t		m_nEvicts;
+
+	public:
+		CSqlStatementCache(free_fn_t pfnFree, size_t nMax = SQL_STMT_CACHE_DEFAULT) :
+			m_arEntry(nullptr),
+			m_nCount(0),
+			m_nMax(0),
+			m_nSeq(0),
+			m_pfnFree(pfnFree),
+			m_nHits(0),
+			m_nMisses(0),
+			m_nEvicts(0)
+		{
+			setMax(nMax);
+		}
+
+		virtual ~CSqlStatementCache()
+		{
+			clear();
+			delete[] m_arEntry;
+		}
+
+	public:
+		size_t getMax() const { return m_nMax; }
+		size_t getCount() const { return m_nCount; }
+		uint64_t getHits() const { return m_nHits; }
+		uint64_t getMisses() const { return m_nMisses; }
+		uint64_t getEvicts() const { return m_nEvicts; }
+
+		/*
+		 * Change the cache size, all cached statements are freed
+		 *
+		 * 		nMax		maximum cached statements, 0 - disable cache
+		 */
+		void setMax(size_t nMax)
+		{
+			clear();
+			delete[] m_arEntry;
+			m_arEntry = nMax > 0 ? new entry_t[nMax] : nullptr;
+			m_nMax = nMax;
+		}
+
+		/*
+		 * Find a cached idle statement and mark it busy
+		 *
+		 * 		strQuery		query text
+		 *
+		 * Return: statement or nullptr if the query should be prepared
+		 */
+		T acquire(const char* strQuery)
+		{
+			uint32_t	hash = getHash(strQuery);
+			size_t		i;
+
+			for(i=0; i<m_nCount; i++)  {
+				entry_t*	pEntry = &m_arEntry[i];
+
+				if ( pEntry->hash == hash && !pEntry->bBusy &&
+						_tstrcmp(pEntry->strQuery, strQuery) == 0 )  {
+					pEntry->bBusy = TRUE;
+					pEntry->nUse = ++m_nSeq;
+					m_nHits++;
+					return pEntry->pStmt;
+				}
+			}
+
+			m_nMisses++;
+			return nullptr;
+		}
+
+		/*
+		 * Cache a newly prepared statement as busy, evict the least
+		 * recently used idle statement if the cache is full
+		 *
+		 * 		strQuery		query text
+		 * 		pStmt			prepared statement
+		 */
+		void insert(const char* strQuery, T pStmt)
+		{
+			entry_t*	pEntry = nullptr;
+			size_t		i;
+
+			if ( m_nCount < m_nMax )  {
+				pEntry = &m_arEntry[m_nCount];
+			}
+			else {
+				for(i=0; i<m_nCount; i++)  {
+					if ( !m_arEntry[i].bBusy &&
+							(!pEntry || m_arEntry[i].nUse < pEntry->nUse) )  {
+						pEntry = &m_arEntry[i];
+					}
+				}
+
+				if ( !pEntry )  {
+					return;		/* Not cached, freed on release() */
+				}
+
+				m_pfnFree(pEntry->pStmt);
+				remove(pEntry);
+				m_nEvicts++;
+				pEntry = &m_arEntry[m_nCount];
+			}
+
+			try {
+				pEntry->strQuery = strQuery;
+			}
+			catch(const std::bad_alloc& exc)  {
+				return;
+			}
+
+			pEntry->hash = getHash(strQuery);
+			pEntry->pStmt = pStmt;
+			pEntry->nUse = ++m_nSeq;
+			pEntry->bBusy = TRUE;
+			m_nCount++;
+		}
+
+		/*
+		 * Return the statement to the cache after the execution
+		 *
+		 * 		pStmt		statement returned by acquire() or inserted
+		 */
+		void release(T pStmt)
+		{
+			entry_t*	pEntry = find(pStmt);
+
+			if ( pEntry )  {
+				pEntry->bBusy = FALSE;
+			}
+			else {
+				m_pfnFree(pStmt);
+			}
+		}
+
+		/*
+		 * Remove the statement from the cache and free it
+		 * (statement can't be executed anymore)
+		 *
+		 * 		pStmt		statement returned by acquire() or inserted
+		 */
+		void discard(T pStmt)
+		{
+			entry_t*	pEntry = find(pStmt);
+
+			if ( pEntry )  {
+				remove(pEntry);
+			}
+			m_pfnFree(pStmt);
+		}
+
+		/*
+		 * Free all cached statements
+		 */
+		void clear()
+		{
+			while ( m_nCount > 0 )  {
+				m_nCount--;
+				m_pfnFree(m_arEntry[m_nCount].pStmt);
+				m_arEntry[m_nCount].strQuery.clear();
+			}
+		}
+
+	protected:
+		entry_t* find(T pStmt)
+		{
+			size_t	i;
+
+			for(i=0; i<m_nCount; i++)  {
+				if ( m_arEntry[i].pStmt == pStmt )  {
+					return &m_arEntry[i];
+				}
+			}
+
+			return nullptr;
+		}
+
+		void remove(entry_t* pEntry)
+		{
+			entry_t*	pLast = &m_arEntry[m_nCount-1];
+
+			if ( pEntry != pLast )  {
+				*pEntry = *pLast;
+			}
+			pLast->strQuery.clear();
+			m_nCount--;
+		}
+
+		static uint32_t getHash(const char* strQuery)
+		{
+			uint32_t	hash = 2166136261U;		/* FNV-1a */
+
+			while ( *strQuery )  {
+				hash = (hash ^ (uint8_t)*strQuery) * 16777619U;
+				strQuery++;
+			}
+
+			return hash;
+		}
+};
+
 /*******************************************************************************
  * SQL Database base class
  */
 class CDbSql : public CModule
 {
 	protected:
-		CMutex			m_lock;
+		CMutex			m_lock;					/* Connection lock (recursive) */
 		hr_time_t 		m_hrConnectTimeout;
 		hr_time_t 		m_hrSendTimeout;
 		hr_time_t		m_hrRecvTimeout;
@@ -105,7 +418,31 @@ class CDbSql : public CModule
 		virtual result_t queryValue(const char* strQuery, uint32_t* pValue) = 0;
 		virtual result_t queryValue(const char* strQuery, int32_t* pValue) = 0;
 		virtual result_t queryRow(const char* strQuery, str_vector_t* pVector) = 0;
-		virtual void iterate(const char* strQuery, CSqlResult* pResult) noexcept(false) = 0;
+		virtual void iterate(const char* strQuery, CSqlResult* pResult,
+							 int nFlags = 0) noexcept(false) = 0;
+
+		/*
+		 * Prepared statements with the bound parameters
+		 */
+		virtual result_t query(const char* strQuery, const CSqlParam* arParam, size_t nParams) = 0;
+
+		virtual result_t queryValue(const char* strQuery, const CSqlParam* arParam,
+									size_t nParams, CString* pValue) = 0;
+		virtual result_t queryValue(const char* strQuery, const CSqlParam* arParam,
+									size_t nParams, uint64_t* pValue);
+		virtual result_t queryValue(const char* strQuery, const CSqlParam* arParam,
+									size_t nParams, int64_t* pValue);
+		virtual result_t queryRow(const char* strQuery, const CSqlParam* arParam,
+								  size_t nParams, str_vector_t* pVector) = 0;
+		virtual void iterate(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+							 CSqlResult* pResult, int nFlags = 0) noexcept(false) = 0;
+
+		/*
+		 * Transaction, the connection is locked until commit()/rollback()
+		 */
+		virtual result_t begin();
+		virtual result_t commit();
+		virtual result_t rollback();
 
 	public:
 		virtual void dump(const char* strPref = "") const = 0;
@@ -0,0 +1,554 @@
+/*
+ *  Carbon/DB module
+ *  SQL batch writer
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 11:10:27
+ *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 13:03:10
+ *      Transient errors are retried and the unwritten rows are kept,
+ *      only the rows actually not written are counted as lost.
+ */
+/*
+ * API:
+ *
+ * 		CSqlBatch	batch(pDb, "track", "time, sensor, value", 3);
+ *
+ * 		batch.init();
+ *
+ * 		CSqlParam	arParam[] = { CSqlParam(nTime), CSqlParam(nSensor), CSqlParam(dValue) };
+ * 		nresult = batch.insert(arParam);		// may flush the pending rows
+ *
+ * 		batch.flushExpired();					// from a periodic timer
+ *
+ * 		batch.terminate();						// flush the rest
+ *
+ * 	On a transient error (database is locked, deadlock, lost connection)
+ * 	the flush is retried up to SQL_BATCH_RETRY_MAX times, the rows which are
+ * 	still not written stay pending. The rows failed with the other errors
+ * 	are discarded (counted as lost rows): all rows of the group in the
+ * 	transaction mode, the rows of the failed statement in the autocommit mode.
+ * 	When the pending rows fill the batch, insert() fails with the flush
+ * 	error and the row is not added.
+ */
+
+#include <new>
+
+#include "carbon/memory.h"
+#include "carbon/logger.h"
+
+#include "db/db_sql_batch.h"
+
+#define SQL_BATCH_DATA_INIT			4096		/* Initial text/blob data buffer, bytes */
+
+/*******************************************************************************
+ * CSqlBatch class
+ */
+
+/*
+ * Batch writer constructor
+ *
+ * 		pDb				database connection
+ * 		strTable		table name
+ * 		strColumns		inserted column list, "name, ip, ..."
+ * 		nColumns		column count (parameters per row)
+ * 		nMode			SQL_BATCH_MULTIROW, SQL_BATCH_TRANSACTION
+ * 		nRowsMax		flush row count threshold
+ * 		hrTimeout		flush time threshold (the oldest pending row age)
+ */
+CSqlBatch::CSqlBatch(CDbSql* pDb, const char* strTable, const char* strColumns, size_t nColumns,
+					 int nMode, size_t nRowsMax, hr_time_t hrTimeout) :
+	m_pDb(pDb),
+	m_strTable(strTable),
+	m_strColumns(strColumns),
+	m_nColumns(nColumns),
+	m_nMode(nMode),
+	m_nRowsMax(sh_max(nRowsMax, (size_t)1)),
+	m_hrTimeout(hrTimeout),
+	m_arValue(nullptr),
+	m_nRows(0),
+	m_pData(nullptr),
+	m_nDataSize(0),
+	m_nDataMax(0),
+	m_hrFirst(HR_0),
+	m_arParam(nullptr),
+	m_nStmtRows(1),
+	m_nTotalRows(0),
+	m_nLostRows(0),
+	m_nFlushes(0),
+	m_nStatements(0),
+	m_hrFlushTime(HR_0)
+{
+	shell_assert(pDb);
+	shell_assert(nColumns > 0 && nColumns <= SQL_PARAM_MAX);
+}
+
+CSqlBatch::~CSqlBatch()
+{
+	terminate();
+}
+
+/*
+ * Allocate the pending rows buffers
+ *
+ * Return: ESUCCESS, ENOMEM, EINVAL
+ */
+result_t CSqlBatch::init()
+{
+	CAutoLock	locker(m_lock);
+
+	shell_assert(!m_arValue);
+
+	if ( m_nColumns < 1 || m_nColumns > SQL_PARAM_MAX )  {
+		log_error(L_SQL, "[sql_batch] invalid column count %lu, table %s\n",
+				  m_nColumns, m_strTable.cs());
+		return EINVAL;
+	}
+
+	if ( m_nMode&SQL_BATCH_MULTIROW )  {
+		m_nStmtRows = sh_min(m_nRowsMax, (size_t)SQL_PARAM_MAX/m_nColumns);
+	}
+
+	m_arValue = (value_t*)memAlloc(m_nRowsMax*m_nColumns*sizeof(value_t));
+	m_arParam = new (std::nothrow) CSqlParam[m_nStmtRows*m_nColumns];
+	m_pData = (uint8_t*)memAlloc(SQL_BATCH_DATA_INIT);
+
+	if ( !m_arValue || !m_arParam || !m_pData )  {
+		log_error(L_SQL, "[sql_batch] out of memory, %lu rows\n", m_nRowsMax);
+		memFree(m_arValue);
+		m_arValue = nullptr;
+		delete[] m_arParam;
+		m_arParam = nullptr;
+		memFree(m_pData);
+		m_pData = nullptr;
+		return ENOMEM;
+	}
+
+	m_nDataMax = SQL_BATCH_DATA_INIT;
+	formatInsert(m_strInsert, m_nStmtRows);
+
+	return ESUCCESS;
+}
+
+/*
+ * Flush the pending rows and free resources
+ */
+void CSqlBatch::terminate()
+{
+	CAutoLock	locker(m_lock);
+
+	if ( m_arValue )  {
+		doFlush();
+
+		if ( m_nRows > 0 )  {
+			log_error(L_SQL, "[sql_batch] %lu pending rows of table %s are discarded\n",
+					  m_nRows, m_strTable.cs());
+			m_nLostRows += m_nRows;
+			m_nRows = 0;
+			m_nDataSize = 0;
+		}
+
+		memFree(m_arValue);
+		m_arValue = nullptr;
+		delete[] m_arParam;
+		m_arParam = nullptr;
+		memFree(m_pData);
+		m_pData = nullptr;
+		m_nDataMax = 0;
+	}
+}
+
+/*
+ * Build INSERT statement
+ *
+ * 		strQuery		statement [out]
+ * 		nRows			rows in the statement
+ */
+void CSqlBatch::formatInsert(CString& strQuery, size_t nRows) const
+{
+	size_t	i, j;
+
+	strQuery.format("INSERT INTO %s (%s) VALUES ", m_strTable.cs(), m_strColumns.cs());
+
+	for(i=0; i<nRows; i++)  {
+		strQuery += i == 0 ? "(?" : ", (?";
+		for(j=1; j<m_nColumns; j++)  {
+			strQuery += ", ?";
+		}
+		strQuery += ")";
+	}
+}
+
+/*
+ * Add a row
+ *
+ * 		arParam			row values, nColumns items
+ *
+ * Return:
+ * 		ESUCCESS		row is added (or written)
+ * 		ENOMEM			out of memory, row is not added
+ * 		...				flush failed (the row is not added if the batch is full)
+ *
+ * Note: text/blob data is copied.
+ */
+result_t CSqlBatch::insert(const CSqlParam* arParam)
+{
+	CAutoLock	locker(m_lock);
+	value_t*	arValue;
+	size_t		nSize, i;
+	result_t	nresult = ESUCCESS;
+
+	shell_assert(m_arValue);
+
+	if ( m_nRows >= m_nRowsMax )  {
+		/* Rows kept by the previous failed flush */
+		nresult = doFlush();
+		if ( m_nRows >= m_nRowsMax )  {
+			return nresult;
+		}
+	}
+
+	nSize = m_nDataSize;
+	for(i=0; i<m_nColumns; i++)  {
+		nSize += arParam[i].getType() == SQL_PARAM_TEXT || arParam[i].getType() == SQL_PARAM_BLOB ?
+					arParam[i].getSize() : 0;
+	}
+
+	if ( nSize > m_nDataMax )  {
+		size_t		nDataMax = sh_max(m_nDataMax*2, nSize);
+		uint8_t*	pData;
+
+		pData = (uint8_t*)memRealloc(m_pData, nDataMax);
+		if ( !pData )  {
+			log_error(L_SQL, "[sql_batch] out of memory, data size %lu\n", nDataMax);
+			return ENOMEM;
+		}
+
+		m_pData = pData;
+		m_nDataMax = nDataMax;
+	}
+
+	arValue = &m_arValue[m_nRows*m_nColumns];
+	for(i=0; i<m_nColumns; i++)  {
+		arValue[i].type = arParam[i].getType();
+
+		switch ( arValue[i].type )  {
+			case SQL_PARAM_INT64:
+				arValue[i].nInt = arParam[i].getInt64();
+				break;
+
+			case SQL_PARAM_UINT64:
+				arValue[i].nUint = arParam[i].getUint64();
+				break;
+
+			case SQL_PARAM_DOUBLE:
+				arValue[i].dValue = arParam[i].getDouble();
+				break;
+
+			case SQL_PARAM_TEXT:
+			case SQL_PARAM_BLOB:
+				arValue[i].nOffset = m_nDataSize;
+				arValue[i].nSize = arParam[i].getSize();
+				_tmemcpy(m_pData+m_nDataSize, arParam[i].getData(), arValue[i].nSize);
+				m_nDataSize += arValue[i].nSize;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	if ( m_nRows == 0 )  {
+		m_hrFirst = hr_time_now();
+	}
+	m_nRows++;
+
+	if ( m_nRows >= m_nRowsMax || hr_time_get_elapsed(m_hrFirst) >= m_hrTimeout )  {
+		nresult = doFlush();
+	}
+
+	return nresult;
+}
+
+/*
+ * Write all pending rows
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CSqlBatch::flush()
+{
+	CAutoLock	locker(m_lock);
+
+	return m_arValue ? doFlush() : ESUCCESS;
+}
+
+/*
+ * Write the pending rows if the oldest row is older than the time threshold
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CSqlBatch::flushExpired()
+{
+	CAutoLock	locker(m_lock);
+	result_t	nresult = ESUCCESS;
+
+	if ( m_nRows > 0 && hr_time_get_elapsed(m_hrFirst) >= m_hrTimeout )  {
+		nresult = doFlush();
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a single INSERT statement
+ *
+ * 		nRow			first pending row
+ * 		nRows			row count, up to m_nStmtRows
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CSqlBatch::execute(size_t nRow, size_t nRows)
+{
+	const value_t*	arValue = &m_arValue[nRow*m_nColumns];
+	size_t			nParams = nRows*m_nColumns, i;
+	CString			strQuery;
+
+	shell_assert(nRows <= m_nStmtRows);
+
+	for(i=0; i<nParams; i++)  {
+		switch ( arValue[i].type )  {
+			case SQL_PARAM_INT64:
+				m_arParam[i] = CSqlParam(arValue[i].nInt);
+				break;
+
+			case SQL_PARAM_UINT64:
+				m_arParam[i] = CSqlParam(arValue[i].nUint);
+				break;
+
+			case SQL_PARAM_DOUBLE:
+				m_arParam[i] = CSqlParam(arValue[i].dValue);
+				break;
+
+			case SQL_PARAM_TEXT:
+			case SQL_PARAM_BLOB:
+				m_arParam[i] = CSqlParam(arValue[i].type, m_pData+arValue[i].nOffset, arValue[i].nSize);
+				break;
+
+			default:
+				m_arParam[i] = CSqlParam();
+				break;
+		}
+	}
+
+	m_nStatements++;
+
+	if ( nRows == m_nStmtRows )  {
+		return m_pDb->query(m_strInsert, m_arParam, nParams);
+	}
+
+	/* The rest of the pending rows */
+	formatInsert(strQuery, nRows);
+	return m_pDb->query(strQuery, m_arParam, nParams);
+}
+
+/*
+ * Write all pending rows within a single transaction
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: no row is written on error
+ */
+result_t CSqlBatch::writeTransaction()
+{
+	size_t		nRow, nRows;
+	result_t	nresult;
+
+	nresult = m_pDb->begin();
+	if ( nresult != ESUCCESS )  {
+		return nresult;
+	}
+
+	for(nRow=0; nRow<m_nRows && nresult == ESUCCESS; nRow += nRows)  {
+		nRows = sh_min(m_nStmtRows, m_nRows-nRow);
+		nresult = execute(nRow, nRows);
+	}
+
+	if ( nresult == ESUCCESS )  {
+		nresult = m_pDb->commit();
+	}
+	else {
+		m_pDb->rollback();
+	}
+
+	return nresult;
+}
+
+/*
+ * Write the pending rows statement by statement (autocommit)
+ *
+ * 		pRow			first row to write [in], first row not processed [out]
+ * 		pWritten		written rows counter [in/out]
+ * 		pLost			discarded rows counter [in/out]
+ *
+ * Return: ESUCCESS, transient error (the rest of rows is not processed),
+ * 		   the last other error
+ */
+result_t CSqlBatch::writeRows(size_t* pRow, size_t* pWritten, size_t* pLost)
+{
+	size_t		nRow, nRows;
+	result_t	nresult = ESUCCESS, nr;
+
+	for(nRow=*pRow; nRow<m_nRows; nRow += nRows)  {
+		nRows = sh_min(m_nStmtRows, m_nRows-nRow);
+		nr = execute(nRow, nRows);
+
+		if ( nr == ESUCCESS )  {
+			*pWritten += nRows;
+		}
+		else if ( isTransient(nr) )  {
+			nresult = nr;
+			break;
+		}
+		else {
+			*pLost += nRows;
+			nresult = nr;
+		}
+	}
+
+	*pRow = nRow;
+	return nresult;
+}
+
+/*
+ * Remove the first pending rows
+ *
+ * 		nRows			rows to remove
+ */
+void CSqlBatch::removeRows(size_t nRows)
+{
+	value_t*	arValue;
+	size_t		i, nValues, nOffset;
+
+	if ( nRows >= m_nRows )  {
+		m_nRows = 0;
+		m_nDataSize = 0;
+		return;
+	}
+
+	/* Text/blob data is stored in the row order */
+	arValue = &m_arValue[nRows*m_nColumns];
+	nValues = (m_nRows-nRows)*m_nColumns;
+	nOffset = m_nDataSize;
+	for(i=0; i<nValues; i++)  {
+		if ( arValue[i].type == SQL_PARAM_TEXT || arValue[i].type == SQL_PARAM_BLOB )  {
+			nOffset = arValue[i].nOffset;
+			break;
+		}
+	}
+
+	for(i=0; i<nValues; i++)  {
+		m_arValue[i] = arValue[i];
+		if ( m_arValue[i].type == SQL_PARAM_TEXT || m_arValue[i].type == SQL_PARAM_BLOB )  {
+			m_arValue[i].nOffset -= nOffset;
+		}
+	}
+
+	_tmemmove(m_pData, m_pData+nOffset, m_nDataSize-nOffset);
+	m_nDataSize -= nOffset;
+	m_nRows -= nRows;
+}
+
+/*
+ * Write all pending rows
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: Batch lock must be held
+ */
+result_t CSqlBatch::doFlush()
+{
+	hr_time_t	hrStart;
+	size_t		nRow = 0, nWritten = 0, nLost = 0, nRows = m_nRows;
+	int			nRetry;
+	result_t	nresult = ESUCCESS;
+
+	if ( m_nRows == 0 )  {
+		return ESUCCESS;
+	}
+
+	hrStart = hr_time_now();
+
+	for(nRetry=0; nRetry<=SQL_BATCH_RETRY_MAX; nRetry++)  {
+		if ( m_nMode&SQL_BATCH_TRANSACTION )  {
+			nresult = writeTransaction();
+			if ( nresult == ESUCCESS )  {
+				nWritten = m_nRows;
+				nRow = m_nRows;
+			}
+			else if ( !isTransient(nresult) )  {
+				nLost = m_nRows;
+				nRow = m_nRows;
+			}
+		}
+		else {
+			nresult = writeRows(&nRow, &nWritten, &nLost);
+		}
+
+		if ( !isTransient(nresult) )  {
+			break;
+		}
+	}
+
+	m_nTotalRows += nWritten;
+	m_nLostRows += nLost;
+
+	if ( nLost > 0 )  {
+		log_error(L_SQL, "[sql_batch] %lu of %lu rows to table %s are discarded, result %d\n",
+				  nLost, nRows, m_strTable.cs(), nresult);
+	}
+
+	if ( nRow < m_nRows )  {
+		log_warning(L_SQL, "[sql_batch] %lu of %lu rows to table %s are kept pending, result %d\n",
+					m_nRows-nRow, nRows, m_strTable.cs(), nresult);
+	}
+
+	m_nFlushes++;
+	m_hrFlushTime += hr_time_get_elapsed(hrStart);
+
+	removeRows(nRow);
+
+	return nresult;
+}
+
+/*
+ * Get write throughput
+ *
+ * Return: written rows per second of the flush time
+ */
+double CSqlBatch::getRowsPerSec() const
+{
+	return m_hrFlushTime > 0 ? (double)m_nTotalRows*HR_1SEC/m_hrFlushTime : 0.0;
+}
+
+/*******************************************************************************
+ * Debugging support
+ */
+
+void CSqlBatch::dump(const char* strPref) const
+{
+	log_dump("*** SqlBatch%s: table %s, mode: %s%s, pending: %lu/%lu, rows/stmt: %lu\n",
+			 strPref, m_strTable.cs(),
+			 (m_nMode&SQL_BATCH_MULTIROW) ? "multirow " : "",
+			 (m_nMode&SQL_BATCH_TRANSACTION) ? "transaction" : "autocommit",
+			 m_nRows, m_nRowsMax, m_nStmtRows);
+	log_dump("    rows: %llu, lost: %llu, flushes: %llu, statements: %llu, "
+			 "flush time: %llu ms, %.0f rows/s\n",
+			 m_nTotalRows, m_nLostRows, m_nFlushes, m_nStatements,
+			 HR_TIME_TO_MILLISECONDS(m_hrFlushTime), getRowsPerSec());
+}
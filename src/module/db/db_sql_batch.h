@@ -0,0 +1,135 @@
+/*
+ *  Carbon/DB module
+ *  SQL batch writer
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 11:08:51
+ *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 13:02:44
+ *      Rows are kept on the transient errors.
+ */
+/*
+ * Purpose:
+ *      Accumulate the inserted rows of a table and write them to the
+ *      database by groups: when the row count threshold is reached, the
+ *      oldest pending row is older than the time threshold, or on flush().
+ *
+ *      A group is written as the multi-row INSERT statements
+ *      (SQL_BATCH_MULTIROW) and/or within a single transaction
+ *      (SQL_BATCH_TRANSACTION). The statements are prepared once and
+ *      reused from the connection statement cache.
+ *
+ *      On a transient error (EBUSY, EDEADLK, ...) the group is retried,
+ *      the rows which are still not written are kept pending up to the
+ *      next flush. On the other errors the failed rows are discarded
+ *      (counted as lost rows).
+ */
+
+#ifndef __DB_SQL_BATCH_H_INCLUDED__
+#define __DB_SQL_BATCH_H_INCLUDED__
+
+#include "shell/lock.h"
+#include "shell/hr_time.h"
+
+#include "carbon/cstring.h"
+
+#include "db/db_sql.h"
+
+#define SQL_BATCH_ROWS_DEFAULT		1000		/* Default rows per flush */
+#define SQL_BATCH_TIMEOUT_DEFAULT	HR_1SEC		/* Default maximum pending row age */
+#define SQL_BATCH_RETRY_MAX			2			/* Retries of a transient error per flush */
+
+/*
+ * Flush modes
+ */
+#define SQL_BATCH_MULTIROW			0x0001		/* INSERT ... VALUES (...),(...),... */
+#define SQL_BATCH_TRANSACTION		0x0002		/* Flush within a single transaction */
+
+class CSqlBatch
+{
+	protected:
+		/*
+		 * Pending row value, text/blob data is copied to m_pData
+		 */
+		struct value_t {
+			sql_param_type_t	type;
+			union {
+				int64_t			nInt;
+				uint64_t		nUint;
+				double			dValue;
+				size_t			nOffset;		/* Text/blob data offset in m_pData */
+			};
+			size_t				nSize;			/* Text/blob data length, bytes */
+		};
+
+	protected:
+		CDbSql*			m_pDb;					/* Database connection */
+		CMutex			m_lock;					/* Pending rows lock */
+
+		CString			m_strTable;				/* Table name */
+		CString			m_strColumns;			/* Inserted columns, "name, ip, ..." */
+		size_t			m_nColumns;				/* Column count */
+		int				m_nMode;				/* SQL_BATCH_xxx */
+		size_t			m_nRowsMax;				/* Flush row count threshold */
+		hr_time_t		m_hrTimeout;			/* Flush time threshold */
+
+		value_t*		m_arValue;				/* Pending rows, m_nRowsMax*m_nColumns */
+		size_t			m_nRows;				/* Pending row count */
+		uint8_t*		m_pData;				/* Pending text/blob data */
+		size_t			m_nDataSize;			/* Used data size, bytes */
+		size_t			m_nDataMax;				/* Allocated data size, bytes */
+		hr_time_t		m_hrFirst;				/* Oldest pending row time */
+
+		CSqlParam*		m_arParam;				/* Statement parameters */
+		size_t			m_nStmtRows;			/* Rows per INSERT statement */
+		CString			m_strInsert;			/* Full INSERT statement */
+
+		uint64_t		m_nTotalRows;			/* Statistics: written rows */
+		uint64_t		m_nLostRows;			/* Statistics: discarded rows */
+		uint64_t		m_nFlushes;				/* Statistics: flushes */
+		uint64_t		m_nStatements;			/* Statistics: executed statements */
+		hr_time_t		m_hrFlushTime;			/* Statistics: total flush time */
+
+	public:
+		CSqlBatch(CDbSql* pDb, const char* strTable, const char* strColumns, size_t nColumns,
+				  int nMode = SQL_BATCH_MULTIROW|SQL_BATCH_TRANSACTION,
+				  size_t nRowsMax = SQL_BATCH_ROWS_DEFAULT,
+				  hr_time_t hrTimeout = SQL_BATCH_TIMEOUT_DEFAULT);
+		virtual ~CSqlBatch();
+
+	public:
+		result_t init();
+		void terminate();
+
+		result_t insert(const CSqlParam* arParam);
+		result_t flush();
+		result_t flushExpired();
+
+		size_t getPending() const { return m_nRows; }
+		uint64_t getTotalRows() const { return m_nTotalRows; }
+		uint64_t getLostRows() const { return m_nLostRows; }
+		double getRowsPerSec() const;
+
+		void dump(const char* strPref = "") const;
+
+	protected:
+		result_t doFlush();
+		result_t writeTransaction();
+		result_t writeRows(size_t* pRow, size_t* pWritten, size_t* pLost);
+		void removeRows(size_t nRows);
+		result_t execute(size_t nRow, size_t nRows);
+
+		static boolean_t isTransient(result_t nresult) {
+			return nresult == EBUSY || nresult == EAGAIN || nresult == EDEADLK ||
+					nresult == ETIMEDOUT || nresult == ENOTCONN;
+		}
+		void formatInsert(CString& strQuery, size_t nRows) const;
+};
+
+#endif /* __DB_SQL_BATCH_H_INCLUDED__ */
@@ -10,12 +10,64 @@
  *
  *  Revision 1.0, 02.08.2015 12:54:01
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:42:50
+ *      Ported to CDbSql interface, statements with the bound parameters,
+ *      per connection prepared statement cache, row streaming results.
+ *
+ *  Revision 1.2, 18.10.2026 11:06:12
+ *      Journal mode and synchronous settings.
+ *
+ *  Revision 1.3, 18.10.2026 12:56:30
+ *      Busy timeout, SQLITE_LOCKED is EBUSY.
+ */
+/*
+ * API:
+ *
+ * 		CDbSqlite	db("/var/lib/app/data.db");
+ *
+ * 		db.connect();
+ *
+ * 		CSqlParam	arParam[] = { CSqlParam(strName), CSqlParam(ip) };
+ *
+ * 		nresult = db.query("INSERT INTO host (name, ip) VALUES(?, ?)", arParam, 2);
+ *
+ *		try {
+ *			CSqliteResult	res;
+ *			CSqliteRow		row;
+ *
+ *			db.iterate("SELECT id, name FROM host WHERE ip=?", arParam+1, 1, &res);
+ *			while ( res.getRow(&row) )  {
+ *				log_dump("%u: %s\n", row.getUint32(0), row[1]);
+ *			}
+ *		}
+ *		catch(std::sql_exception& ex)  {
+ *			log_error(L_SQL, "[sqlite] database iterate failed, result %d\n", ex.getResult());
+ *		}
+ *
+ * 	All queries are prepared statements kept in the per connection LRU cache
+ * 	(setStatementCache()), the cache is cleared on disconnect. Result rows
+ * 	are always stepped on the statement (streaming), the connection is locked
+ * 	until the result is freed.
+ *
+ * Write performance:
+ *
+ * 		db.setJournalMode("WAL");		// persistent in the database file
+ * 		db.setSynchronous("NORMAL");	// per connection, applied on connect()
+ *
+ * 	In the default mode (DELETE journal, FULL synchronous) each transaction
+ * 	is synced to the disk several times, group the rows by CSqlBatch.
+ *
+ * 	A statement on the database locked by another connection waits up to
+ * 	the busy timeout (setBusyTimeout(), 5 seconds by default) and fails
+ * 	with EBUSY.
  */
 
 #include <new>
 
 #include "shell/shell.h"
 #include "carbon/logger.h"
+#include "carbon/cstring.h"
 
 #include "db/db_sqlite.h"
 
@@ -26,6 +78,9 @@ static result_t sqlite2nresult(int retVal)
 	switch (retVal)  {
 		case SQLITE_OK:			nresult = ESUCCESS; break;
 		case SQLITE_ABORT:		nresult = ECANCELED; break;
+		case SQLITE_BUSY:		nresult = EBUSY; break;
+		case SQLITE_LOCKED:		nresult = EBUSY; break;
+		case SQLITE_CONSTRAINT:	nresult = EEXIST; break;
 		case SQLITE_CANTOPEN:	nresult = ENOENT; break;
 		case SQLITE_ERROR:		nresult = EIO; break;
 		case SQLITE_INTERRUPT:	nresult = EINTR; break;
@@ -42,124 +97,198 @@ static result_t sqlite2nresult(int retVal)
 }
 
 /*******************************************************************************
- * CSqliteResult class
+ * CSqliteRow class
  */
 
-CSqliteResult::CSqliteResult() :
-	CSqlResult(),
-	m_pStmt(0)
+int CSqliteRow::getType(size_t nIndex) noexcept(false)
 {
+	if ( nIndex < m_nFields && m_pStmt != nullptr )  {
+		return sqlite3_column_type(m_pStmt, (int)nIndex);
+	}
+
+	log_error(L_SQL, "[sql_row] index %lu overflow, nFields %lu\n", nIndex, m_nFields);
+	throw std::sql_exception(EFAULT);
 }
 
-CSqliteResult::CSqliteResult(sqlite3_stmt* pStmt) :
-	CSqlResult(),
-	m_pStmt(pStmt)
+char* CSqliteRow::operator[](size_t nIndex) noexcept(false)
 {
+	getType(nIndex);
+	return (char*)sqlite3_column_text(m_pStmt, (int)nIndex);
 }
 
-CSqliteResult::~CSqliteResult()
+uint32_t CSqliteRow::getUint32(size_t nIndex) noexcept(false)
 {
-	finalise();
-}
+	char*		s;
+	uint32_t	n;
 
+	if ( getType(nIndex) == SQLITE_INTEGER )  {
+		return (uint32_t)sqlite3_column_int64(m_pStmt, (int)nIndex);
+	}
 
-void CSqliteResult::finalise()
-{
-	if ( m_pStmt != 0 )  {
-		sqlite3_finalize(m_pStmt);
-		m_pStmt = 0;
+	s = (*this)[nIndex];
+	if ( CString(s).getNumber(n) != ESUCCESS )  {
+		log_error(L_SQL, "[sql_row] string is not a number: '%s'\n", s);
+		throw std::sql_exception(EFAULT);
 	}
-}
 
+	return n;
+}
 
-size_t CSqliteResult::getComumns() const
+int32_t CSqliteRow::getInt32(size_t nIndex) noexcept(false)
 {
-	size_t	nColumns = 0;
+	char*		s;
+	int32_t		n;
 
-	if ( m_pStmt != 0 )  {
-		nColumns = (size_t)sqlite3_column_count(m_pStmt);
+	if ( getType(nIndex) == SQLITE_INTEGER )  {
+		return (int32_t)sqlite3_column_int64(m_pStmt, (int)nIndex);
 	}
 
-	return nColumns;
+	s = (*this)[nIndex];
+	if ( CString(s).getNumber(n) != ESUCCESS )  {
+		log_error(L_SQL, "[sql_row] string is not a number: '%s'\n", s);
+		throw std::sql_exception(EFAULT);
+	}
+
+	return n;
 }
 
-SQL_VARIANT CSqliteResult::operator[](int index) const
+uint64_t CSqliteRow::getUint64(size_t nIndex) noexcept(false)
 {
-	SQL_VARIANT var;
-
-	if ( m_pStmt != 0 && (size_t)index < getComumns() ) {
-		int column_type;
+	char*		s;
+	uint64_t	n;
 
-		column_type = sqlite3_column_type(m_pStmt, index);
-		switch (column_type) {
-			case SQLITE_INTEGER:
-				var.vtype = SQL_VT_INTEGER;
-				var.vsize = sizeof(var.valInt);
-				var.valInt = (uint64_t)sqlite3_column_int64(m_pStmt, index);
-				break;
-
-			case SQLITE_FLOAT:
-				var.vtype = SQL_VT_REAL;
-				var.vsize = sizeof(var.valDouble);
-				var.valDouble = sqlite3_column_double(m_pStmt, index);
-				break;
+	if ( getType(nIndex) == SQLITE_INTEGER )  {
+		return (uint64_t)sqlite3_column_int64(m_pStmt, (int)nIndex);
+	}
 
-			case SQLITE_TEXT:
-				var.vtype = SQL_VT_TEXT;
-				var.vsize = (uint32_t)sqlite3_column_bytes(m_pStmt, index);
-				var.valText = (const char*)sqlite3_column_text(m_pStmt, index);
-				break;
+	s = (*this)[nIndex];
+	if ( CString(s).getNumber(n) != ESUCCESS )  {
+		log_error(L_SQL, "[sql_row] string is not a number: '%s'\n", s);
+		throw std::sql_exception(EFAULT);
+	}
 
-			case SQLITE_BLOB:
-				var.vtype = SQL_VT_BLOB;
-				var.vsize = (uint32_t)sqlite3_column_bytes(m_pStmt, index);
-				var.valBlob = sqlite3_column_blob(m_pStmt, index);
-				break;
+	return n;
+}
 
-			case SQLITE_NULL:
-				var.vtype = SQL_VT_NULL;
-				var.vsize = 0;
-				break;
+int64_t CSqliteRow::getInt64(size_t nIndex) noexcept(false)
+{
+	char*		s;
+	int64_t		n;
 
-			default:
-				log_debug(L_DB, "[sqlite] unexpected column type %d\n", column_type);
-				var.vtype = SQL_VT_ERROR;
-				var.vsize = 0;
-				break;
-		}
+	if ( getType(nIndex) == SQLITE_INTEGER )  {
+		return (int64_t)sqlite3_column_int64(m_pStmt, (int)nIndex);
 	}
-	else {
-		var.vtype = SQL_VT_EMPTY;
-		var.vsize = 0;
+
+	s = (*this)[nIndex];
+	if ( CString(s).getNumber(n) != ESUCCESS )  {
+		log_error(L_SQL, "[sql_row] string is not a number: '%s'\n", s);
+		throw std::sql_exception(EFAULT);
 	}
 
-	return var;
+	return n;
 }
 
-result_t CSqliteResult::getNextRow()
+/*******************************************************************************
+ * CSqliteResult class
+ */
+
+/*
+ * Initialise the result of the prepared statement
+ *
+ * 		pDb			database object
+ * 		pStmt		statement with the bound parameters (from the statement cache)
+ * 		nPending	result of the first sqlite3_step() or SQLITE_OK
+ * 		bLocked		TRUE: result holds the connection lock and unlocks it on free()
+ */
+void CSqliteResult::init(CDbSqlite* pDb, sqlite3_stmt* pStmt, int nPending, boolean_t bLocked)
 {
-	result_t	nresult = ENODATA;
+	shell_assert(pDb);
+	shell_assert(!m_pStmt);
 
-	if ( m_pStmt )  {
-		int 	retVal;
+	m_pDb = pDb;
+	m_pStmt = pStmt;
+	m_nPending = nPending;
+	m_bLocked = bLocked;
+}
+
+/*
+ * Get field count in the result rows
+ *
+ * Return: count
+ */
+size_t CSqliteResult::getFields() const
+{
+	return m_pStmt ? (size_t)sqlite3_column_count(m_pStmt) : 0;
+}
+
+/*
+ * Step the statement to the next row
+ *
+ * 		pRow		row object to place next row
+ *
+ * Return:
+ * 		TRUE		success, returned next row
+ * 		FALSE		result is empty, no more rows
+ *
+ * Note:
+ * 		generate std::sql_exception on any db error
+ */
+boolean_t CSqliteResult::getRow(CSqlRow* pRow) noexcept(false)
+{
+	CSqliteRow*		pSqliteRow = dynamic_cast<CSqliteRow*>(pRow);
+	int				retVal;
+	result_t		nresult;
+
+	shell_assert(pSqliteRow);
+
+	if ( !m_pStmt )  {
+		return FALSE;
+	}
 
+	if ( m_nPending != SQLITE_OK )  {
+		retVal = m_nPending;
+		m_nPending = SQLITE_OK;
+	}
+	else {
 		retVal = sqlite3_step(m_pStmt);
-		switch (retVal)  {
-			case SQLITE_ROW:		/* Got a row */
-				nresult = ESUCCESS;
-				break;
+	}
 
-			case SQLITE_DONE:
-				nresult = ENODATA;
-				break;
+	if ( retVal == SQLITE_ROW )  {
+		pSqliteRow->init(m_pStmt, (size_t)sqlite3_column_count(m_pStmt));
+		return TRUE;
+	}
 
-			default:
-				nresult = sqlite2nresult(retVal);
-				break;
-		}
+	if ( retVal == SQLITE_DONE )  {
+		/* Do not restart the statement on the next call */
+		m_nPending = SQLITE_DONE;
+		return FALSE;
 	}
 
-	return nresult;
+	nresult = sqlite2nresult(retVal);
+	log_error(L_SQL, "[sqlite] sqlite3_step() failed, query='%s', sqlite error %d (%s)\n",
+			  sqlite3_sql(m_pStmt), retVal, sqlite3_errmsg(m_pDb->m_pHandle));
+	throw std::sql_exception(nresult);
+}
+
+/*
+ * Free Sqlite query result
+ *
+ * Note: the statement is returned to the cache, the connection lock is
+ * unlocked if held by the result.
+ */
+void CSqliteResult::free()
+{
+	if ( m_pStmt )  {
+		sqlite3_reset(m_pStmt);
+		sqlite3_clear_bindings(m_pStmt);
+		m_pDb->m_stmtCache.release(m_pStmt);
+		m_pStmt = nullptr;
+	}
+
+	if ( m_bLocked )  {
+		m_bLocked = FALSE;
+		m_pDb->m_lock.unlock();
+	}
 }
 
 
@@ -172,8 +301,10 @@ CMutex CDbSqlite::m_lockInit;
 
 CDbSqlite::CDbSqlite(const char* strDatabase) :
 	CDbSql("Sqlite"),
-	m_pHandle(NULL),
-	m_nConnectCount(0)
+	m_pHandle(nullptr),
+	m_nConnectCount(0),
+	m_stmtCache(freeStatement),
+	m_hrBusyTimeout(SQLITE_BUSY_TIMEOUT_DEFAULT)
 {
 	copyString(m_strDatabase, strDatabase, sizeof(m_strDatabase));
 
@@ -188,7 +319,7 @@ CDbSqlite::CDbSqlite(const char* strDatabase) :
 			m_nLibraryInitialised++;
 		}
 		else {
-			log_debug(L_DB, "[sqlite] low level library initialisation failed, sqlite result: %d\n", retVal);
+			log_debug(L_SQL, "[sqlite] low level library initialisation failed, sqlite result: %d\n", retVal);
 			m_resultInit = sqlite2nresult(retVal);
 		}
 	}
@@ -198,7 +329,7 @@ CDbSqlite::~CDbSqlite()
 {
 	CAutoLock	locker(m_lockInit);
 
-	shell_assert(m_pHandle == NULL);
+	shell_assert(m_pHandle == nullptr);
 	shell_assert(m_nConnectCount == 0);
 
 	if ( m_resultInit == ESUCCESS )  {
@@ -208,15 +339,136 @@ CDbSqlite::~CDbSqlite()
 
 			retVal = sqlite3_shutdown();
 			if ( retVal != SQLITE_OK ) {
-				log_debug(L_DB, "[sqlite] low level library shutdown failed, sqlite result: %d\n", retVal);
+				log_debug(L_SQL, "[sqlite] low level library shutdown failed, sqlite result: %d\n", retVal);
 			}
 		}
 	}
 }
 
+/*
+ * [Static]
+ *
+ * Statement cache destructor
+ */
+void CDbSqlite::freeStatement(sqlite3_stmt* pStmt)
+{
+	sqlite3_finalize(pStmt);
+}
+
+/*
+ * Set prepared statement cache size
+ *
+ * 		nMax		maximum cached statements, 0 - disable caching
+ */
+void CDbSqlite::setStatementCache(size_t nMax)
+{
+	CAutoLock	locker(m_lock);
+
+	m_stmtCache.setMax(nMax);
+}
+
+/*
+ * Set journal mode (PRAGMA journal_mode)
+ *
+ * 		strMode			DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: WAL mode is persistent, the other connections of the database
+ * file are switched too.
+ */
+result_t CDbSqlite::setJournalMode(const char* strMode)
+{
+	CAutoLock	locker(m_lock);
+
+	m_strJournalMode = strMode;
+	return isConnected() ? applyJournalMode() : ESUCCESS;
+}
+
+/*
+ * Set synchronous mode (PRAGMA synchronous)
+ *
+ * 		strMode			OFF, NORMAL, FULL, EXTRA
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: NORMAL is safe in WAL mode (the last transactions may roll back
+ * on the power loss, the database is not corrupted).
+ */
+result_t CDbSqlite::setSynchronous(const char* strMode)
+{
+	CAutoLock	locker(m_lock);
+
+	m_strSynchronous = strMode;
+	return isConnected() ? applySynchronous() : ESUCCESS;
+}
+
+/*
+ * Set the locked database wait time (sqlite3_busy_timeout())
+ *
+ * 		hrTimeout		maximum wait time, HR_0 - fail immediately
+ */
+void CDbSqlite::setBusyTimeout(hr_time_t hrTimeout)
+{
+	CAutoLock	locker(m_lock);
+
+	m_hrBusyTimeout = hrTimeout;
+	if ( isConnected() )  {
+		sqlite3_busy_timeout(m_pHandle, (int)HR_TIME_TO_MILLISECONDS(m_hrBusyTimeout));
+	}
+}
+
+/*
+ * Apply the journal mode setting
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: Mutual lock must be held
+ */
+result_t CDbSqlite::applyJournalMode()
+{
+	char		strQuery[64];
+	CString		strMode;
+	result_t	nresult;
+
+	if ( m_strJournalMode.isEmpty() )  {
+		return ESUCCESS;
+	}
+
+	_tsnprintf(strQuery, sizeof(strQuery), "PRAGMA journal_mode=%s", m_strJournalMode.cs());
+	nresult = queryValue(strQuery, &strMode);
+	if ( nresult == ESUCCESS && strcasecmp(strMode, m_strJournalMode) != 0 )  {
+		/* E.g. in-memory database can't use WAL */
+		log_warning(L_SQL, "[sqlite] database %s journal mode is '%s', requested '%s'\n",
+					m_strDatabase, strMode.cs(), m_strJournalMode.cs());
+		nresult = ENOTSUP;
+	}
+
+	return nresult;
+}
+
+/*
+ * Apply the synchronous setting
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: Mutual lock must be held
+ */
+result_t CDbSqlite::applySynchronous()
+{
+	char	strQuery[64];
+
+	if ( m_strSynchronous.isEmpty() )  {
+		return ESUCCESS;
+	}
+
+	_tsnprintf(strQuery, sizeof(strQuery), "PRAGMA synchronous=%s", m_strSynchronous.cs());
+	return query(strQuery);
+}
+
 result_t CDbSqlite::connect()
 {
-	CAutoLock	locker(m_lockInit);
+	CAutoLock	locker(m_lock);
 	result_t	nresult = ESUCCESS;
 
 	if ( m_resultInit != ESUCCESS )  {
@@ -227,21 +479,27 @@ result_t CDbSqlite::connect()
 	if ( m_nConnectCount < 1 )  {
 		int		retVal;
 
-		shell_assert(m_pHandle == NULL);
+		shell_assert(m_pHandle == nullptr);
 		retVal = sqlite3_open(m_strDatabase, &m_pHandle);
 		if ( retVal != SQLITE_OK ) {
 			const char*		strErr;
 
 			strErr = sqlite3_errstr(retVal);
-			log_debug(L_DB, "[sqlite] failed to open db %s, sqlite result: %s(%d)\n",
+			log_debug(L_SQL, "[sqlite] failed to open db %s, sqlite result: %s(%d)\n",
 					  m_strDatabase, strErr, retVal);
 
 			sqlite3_close(m_pHandle);
-			m_pHandle = NULL;
+			m_pHandle = nullptr;
 			nresult = sqlite2nresult(retVal);
 		}
 	}
 
+	if ( nresult == ESUCCESS && m_nConnectCount < 1 )  {
+		sqlite3_busy_timeout(m_pHandle, (int)HR_TIME_TO_MILLISECONDS(m_hrBusyTimeout));
+		applyJournalMode();
+		applySynchronous();
+	}
+
 	if ( nresult == ESUCCESS )  {
 		m_nConnectCount++;
 	}
@@ -251,98 +509,481 @@ result_t CDbSqlite::connect()
 
 void CDbSqlite::disconnect()
 {
-	CAutoLock	locker(m_lockInit);
+	CAutoLock	locker(m_lock);
 
-	shell_assert(m_pHandle != NULL);
+	shell_assert(m_pHandle != nullptr);
 	shell_assert(m_nConnectCount > 0);
 	if ( m_nConnectCount < 2 )  {
 		int		retVal;
 
+		/* Unfinalized statements keep the database open */
+		m_stmtCache.clear();
+
 		retVal = sqlite3_close(m_pHandle);
 		if ( retVal != SQLITE_OK )  {
 			const char*		strErr;
 
 			strErr = sqlite3_errstr(retVal);
-			log_debug(L_GEN, "[sqlite] failed to close db %s, sqlite result: %s(%d)\n",
+			log_debug(L_SQL, "[sqlite] failed to close db %s, sqlite result: %s(%d)\n",
 					  m_strDatabase, strErr, retVal);
 		}
-		m_pHandle = NULL;
+		m_pHandle = nullptr;
 	}
 
 	m_nConnectCount--;
 }
 
-result_t CDbSqlite::query(const char* strQuery, CSqlResult** ppResult)
+/*
+ * Take the prepared statement from the cache (or prepare a new one)
+ * and bind the parameters
+ *
+ * 		strQuery		query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		ppStmt			statement ready to step [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		EBADF			database is not connected
+ * 		EINVAL			invalid parameter count
+ * 		EIO				query failed
+ * 		ENOMEM			out of memory
+ *
+ * Note: Statement must be returned by CSqliteResult::free()
+ * Note: Mutual lock must be held
+ */
+result_t CDbSqlite::doPrepare(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+							  sqlite3_stmt** ppStmt)
 {
-	result_t	nresult = EBADF;
+	sqlite3_stmt*	pStmt;
+	const char*		strErr;
+	size_t			i;
+	int				retVal;
 
 	shell_assert(strQuery);
-	shell_assert(ppResult);
 
-	*ppResult = 0;
+	if ( !isConnected() )  {
+		log_error(L_SQL, "[sqlite] database %s is not connected\n", m_strDatabase);
+		return EBADF;
+	}
 
-	if ( isConnected() )  {
-		sqlite3_stmt*	pStmt = 0;
-		int 			retVal;
+	pStmt = m_stmtCache.acquire(strQuery);
+	if ( !pStmt )  {
+		retVal = sqlite3_prepare_v2(m_pHandle, strQuery, -1, &pStmt, NULL);
+		if ( retVal != SQLITE_OK )  {
+			strErr = sqlite3_errmsg(m_pHandle);
+			log_error(L_SQL, "[sqlite] query '%s' failed, sqlite error %d (%s)\n",
+					  strQuery, retVal, strErr);
+			return sqlite2nresult(retVal);
+		}
 
-		log_debug(L_DB_SQL_TRACE, "[sqlite] SQL: '%s'\n", strQuery);
+		if ( !pStmt )  {
+			log_error(L_SQL, "[sqlite] sqlite query is empty\n");
+			return EIO;
+		}
 
-		retVal = sqlite3_prepare_v2(m_pHandle, strQuery, -1, &pStmt, NULL);
-		if ( retVal == SQLITE_OK ) {
-			CSqliteResult*	pResult;
-
-			retVal = sqlite3_step(pStmt);
-			//log_debug(L_DB_SQL_TRACE, "[sqlite] SQL RESULT: '%d'\n", retVal);
-
-			switch (retVal)  {
-				case SQLITE_ROW:		/* Got a row */
-					try {
-						pResult = new CSqliteResult(pStmt);
-						*ppResult = pResult;
-						nresult = ESUCCESS;
-					}
-					catch(const std::bad_alloc& exc)  {
-						log_error(L_DB, "[sqlite] memory allocation failed\n");
-						nresult = ENOMEM;
-					}
-					break;
-
-				case SQLITE_DONE:
-					try {
-						pResult = new CSqliteResult();
-						*ppResult = pResult;
-						nresult = ENODATA;
-					}
-					catch(const std::bad_alloc& exc)  {
-						log_error(L_DB, "[sqlite] memory allocation failed\n");
-						nresult = ENOMEM;
-					}
-					break;
-
-				default:
-					nresult = sqlite2nresult(retVal);
-					break;
+		m_stmtCache.insert(strQuery, pStmt);
+	}
+
+	if ( (size_t)sqlite3_bind_parameter_count(pStmt) != nParams )  {
+		log_error(L_SQL, "[sqlite] query '%s' expects %d parameters, got %lu\n",
+				  strQuery, sqlite3_bind_parameter_count(pStmt), nParams);
+		m_stmtCache.release(pStmt);
+		return EINVAL;
+	}
+
+	retVal = SQLITE_OK;
+	for(i=0; i<nParams && retVal == SQLITE_OK; i++)  {
+		const CSqlParam*	pParam = &arParam[i];
+		int					nIndex = (int)i+1;
+
+		switch ( pParam->getType() )  {
+			case SQL_PARAM_INT64:
+				retVal = sqlite3_bind_int64(pStmt, nIndex, pParam->getInt64());
+				break;
+
+			case SQL_PARAM_UINT64:
+				retVal = sqlite3_bind_int64(pStmt, nIndex, (sqlite3_int64)pParam->getUint64());
+				break;
+
+			case SQL_PARAM_DOUBLE:
+				retVal = sqlite3_bind_double(pStmt, nIndex, pParam->getDouble());
+				break;
+
+			case SQL_PARAM_TEXT:
+				retVal = sqlite3_bind_text(pStmt, nIndex, (const char*)pParam->getData(),
+										   (int)pParam->getSize(), SQLITE_STATIC);
+				break;
+
+			case SQL_PARAM_BLOB:
+				retVal = sqlite3_bind_blob(pStmt, nIndex, pParam->getData(),
+										   (int)pParam->getSize(), SQLITE_STATIC);
+				break;
+
+			default:
+				retVal = sqlite3_bind_null(pStmt, nIndex);
+				break;
+		}
+	}
+
+	if ( retVal != SQLITE_OK )  {
+		strErr = sqlite3_errmsg(m_pHandle);
+		log_error(L_SQL, "[sqlite] binding parameter %lu of query '%s' failed, sqlite error %d (%s)\n",
+				  i, strQuery, retVal, strErr);
+		sqlite3_clear_bindings(pStmt);
+		m_stmtCache.release(pStmt);
+		return sqlite2nresult(retVal);
+	}
+
+	*ppStmt = pStmt;
+	return ESUCCESS;
+}
+
+/*
+ * Execute query
+ *
+ * 		strQuery		SQL query to execute
+ *
+ * Return:
+ * 		ESUCCESS		query executed
+ * 		EEXIST			query failed (constraint violation)
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: No exception raised.
+ */
+result_t CDbSqlite::query(const char* strQuery)
+{
+	return query(strQuery, nullptr, 0);
+}
+
+/*
+ * Execute a given SQL query and fetch a string value from the result
+ *
+ * 		strQuery		SQL query to execute
+ * 		pValue			fetched string [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ */
+result_t CDbSqlite::queryValue(const char* strQuery, CString* pValue)
+{
+	return queryValue(strQuery, nullptr, 0, pValue);
+}
+
+result_t CDbSqlite::queryValue(const char* strQuery, uint64_t* pValue)
+{
+	return queryValue(strQuery, nullptr, 0, pValue);
+}
+
+result_t CDbSqlite::queryValue(const char* strQuery, int64_t* pValue)
+{
+	return queryValue(strQuery, nullptr, 0, pValue);
+}
+
+result_t CDbSqlite::queryValue(const char* strQuery, uint32_t* pValue)
+{
+	uint64_t	nValue;
+	result_t	nresult;
+
+	nresult = queryValue(strQuery, nullptr, 0, &nValue);
+	if ( nresult == ESUCCESS )  {
+		if ( nValue <= UINT32_MAX )  {
+			*pValue = (uint32_t)nValue;
+		}
+		else {
+			log_debug(L_SQL, "[sqlite] uint32 value %llu overflow in query '%s'\n",
+					  nValue, strQuery);
+			nresult = ERANGE;
+		}
+	}
+
+	return nresult;
+}
+
+result_t CDbSqlite::queryValue(const char* strQuery, int32_t* pValue)
+{
+	int64_t		nValue;
+	result_t	nresult;
+
+	nresult = queryValue(strQuery, nullptr, 0, &nValue);
+	if ( nresult == ESUCCESS )  {
+		if ( nValue >= INT32_MIN && nValue <= INT32_MAX )  {
+			*pValue = (int32_t)nValue;
+		}
+		else {
+			log_debug(L_SQL, "[sqlite] int32 value %lld overflow in query '%s'\n",
+					  nValue, strQuery);
+			nresult = ERANGE;
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Query single row
+ *
+ * 		strQuery		sql query to execute
+ * 		pVector			string values array [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: NULL fields are returned as empty string ("")
+ */
+result_t CDbSqlite::queryRow(const char* strQuery, str_vector_t* pVector)
+{
+	return queryRow(strQuery, nullptr, 0, pVector);
+}
+
+/*
+ * Start iterate query
+ *
+ * 		strQuery		sql query to iterate
+ * 		pResult			intermediate result
+ * 		nFlags			unused, rows are always stepped on the statement
+ *
+ * Return: exception on error (nr=EBADF,EEXIST,EIO,ENOMEM)
+ *
+ * Note: the connection is locked until the result is freed.
+ */
+void CDbSqlite::iterate(const char* strQuery, CSqlResult* pResult, int nFlags) noexcept(false)
+{
+	iterate(strQuery, nullptr, 0, pResult, nFlags);
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ *
+ * Return:
+ * 		ESUCCESS		query executed
+ * 		EINVAL			invalid parameter count
+ * 		EEXIST			query failed (constraint violation)
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: No exception raised.
+ */
+result_t CDbSqlite::query(const char* strQuery, const CSqlParam* arParam, size_t nParams)
+{
+	CAutoLock		locker(m_lock);
+	CSqliteResult	result;
+	CSqliteRow		row;
+	sqlite3_stmt*	pStmt;
+	result_t		nresult;
+
+	log_trace(L_SQL, "[sqlite] query: '%s'\n", strQuery);
+
+	nresult = doPrepare(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		result.init(this, pStmt, SQLITE_OK, FALSE);
+
+		try {
+			while ( result.getRow(&row) )  {
+				;
 			}
+		}
+		catch(const std::sql_exception& exc)  {
+			nresult = exc.getResult();
+		}
 
-			if ( nresult != ESUCCESS )  {
-				sqlite3_finalize(pStmt);
-				if ( nresult == ENODATA )  {
-					nresult = ESUCCESS;
-				}
+		result.free();
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ * and fetch a string value from the result
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pValue			fetched string [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			invalid parameter count
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ */
+result_t CDbSqlite::queryValue(const char* strQuery, const CSqlParam* arParam,
+							   size_t nParams, CString* pValue)
+{
+	CAutoLock		locker(m_lock);
+	CSqliteResult	result;
+	CSqliteRow		row;
+	sqlite3_stmt*	pStmt;
+	const char*		s;
+	result_t		nresult;
+
+	log_trace(L_SQL, "[sqlite] query string value: '%s'\n", strQuery);
+
+	nresult = doPrepare(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		result.init(this, pStmt, SQLITE_OK, FALSE);
+
+		try {
+			if ( result.getFields() > 0 && result.getRow(&row) )  {
+				s = row[0];
+				*pValue = s != nullptr ? s : "";
+			}
+			else {
+				log_debug(L_SQL, "[sqlite] query '%s' returns no data\n", strQuery);
+				nresult = ENODATA;
 			}
 		}
-		else {
-			const char*		strErr;
+		catch(const std::sql_exception& exc)  {
+			nresult = exc.getResult();
+		}
+		catch(const std::bad_alloc& exc)  {
+			log_error(L_SQL, "[sqlite] out of memory\n");
+			nresult = ENOMEM;
+		}
 
-			strErr = sqlite3_errmsg(m_pHandle);
-			log_debug(L_DB, "[sqlite] query '%s' failed, result: %s(%u)\n", strQuery, strErr, retVal);
-			nresult = sqlite2nresult(retVal);
+		result.free();
+	}
+
+	return nresult;
+}
+
+/*
+ * Execute a prepared statement with the bound parameters
+ * and fetch a single row
+ *
+ * 		strQuery		SQL query to execute, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pVector			string values array [out]
+ *
+ * Return:
+ * 		ESUCCESS		success
+ * 		ENODATA			query executed but returns no data
+ * 		EINVAL			invalid parameter count
+ * 		EBADF			database is not connected
+ * 		EIO				query failed (I/O error)
+ * 		ENOMEM			out of memory
+ *
+ * Note: NULL fields are returned as empty string ("")
+ */
+result_t CDbSqlite::queryRow(const char* strQuery, const CSqlParam* arParam,
+							 size_t nParams, str_vector_t* pVector)
+{
+	CAutoLock		locker(m_lock);
+	CSqliteResult	result;
+	CSqliteRow		row;
+	sqlite3_stmt*	pStmt;
+	size_t			nFields;
+	const char*		s;
+	result_t		nresult;
+
+	shell_assert(pVector);
+
+	log_trace(L_SQL, "[sqlite] row query: '%s'\n", strQuery);
+
+	nresult = doPrepare(strQuery, arParam, nParams, &pStmt);
+	if ( nresult == ESUCCESS )  {
+		result.init(this, pStmt, SQLITE_OK, FALSE);
+
+		try {
+			nFields = result.getFields();
+			if ( nFields > 0 && result.getRow(&row) )  {
+				pVector->clear();
+				pVector->reserve(nFields);
+				for(size_t i=0; i<nFields; i++)  {
+					s = row[i];
+					pVector->push_back(s != nullptr ? CString(s) : CString());
+				}
+			}
+			else {
+				log_debug(L_SQL, "[sqlite] query '%s' returns no data\n", strQuery);
+				nresult = ENODATA;
+			}
+		}
+		catch(const std::sql_exception& exc)  {
+			pVector->clear();
+			nresult = exc.getResult();
+		}
+		catch(const std::bad_alloc& exc)  {
+			pVector->clear();
+			nresult = ENOMEM;
+			log_error(L_SQL, "[sqlite] out of memory\n");
 		}
+
+		result.free();
 	}
 
 	return nresult;
 }
 
+/*
+ * Start iterate prepared statement with the bound parameters
+ *
+ * 		strQuery		sql query to iterate, '?' - parameter placeholder
+ * 		arParam			query parameters
+ * 		nParams			query parameter count
+ * 		pResult			intermediate result
+ * 		nFlags			unused, rows are always stepped on the statement
+ *
+ * Return: exception on error (nr=EINVAL,EBADF,EEXIST,EIO,ENOMEM)
+ *
+ * Note: the connection is locked until the result is freed.
+ */
+void CDbSqlite::iterate(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+						CSqlResult* pResult, int nFlags) noexcept(false)
+{
+	CSqliteResult*	pSqliteResult = dynamic_cast<CSqliteResult*>(pResult);
+	sqlite3_stmt*	pStmt;
+	int				retVal;
+	result_t		nresult;
+
+	shell_assert(pSqliteResult);
+	shell_unused(nFlags);
+
+	log_trace(L_SQL, "[sqlite] iterate query: '%s'\n", strQuery);
+
+	m_lock.lock();
+
+	nresult = doPrepare(strQuery, arParam, nParams, &pStmt);
+	if ( nresult != ESUCCESS )  {
+		m_lock.unlock();
+		throw std::sql_exception(nresult);
+	}
+
+	/* Report the query errors here rather than on the first getRow() */
+	retVal = sqlite3_step(pStmt);
+	if ( retVal != SQLITE_ROW && retVal != SQLITE_DONE )  {
+		nresult = sqlite2nresult(retVal);
+		log_error(L_SQL, "[sqlite] query '%s' failed, sqlite error %d (%s)\n",
+				  strQuery, retVal, sqlite3_errmsg(m_pHandle));
+
+		sqlite3_reset(pStmt);
+		sqlite3_clear_bindings(pStmt);
+		m_stmtCache.release(pStmt);
+		m_lock.unlock();
+		throw std::sql_exception(nresult);
+	}
+
+	pSqliteResult->init(this, pStmt, retVal, TRUE);
+}
 
 void CDbSqlite::escape(const char* strInput, char* strOutput, size_t szOutput)
 {
@@ -364,3 +1005,18 @@ void CDbSqlite::escape(const char* strInput, char* strOutput, size_t szOutput)
 
 	strOutput[length] = '\0';
 }
+
+/*******************************************************************************
+ * Debugging support
+ */
+
+void CDbSqlite::dump(const char* strPref) const
+{
+	log_dump("*** DbSqlite%s: database %s, connected: %d, journal: %s, synchronous: %s, "
+			 "statements: %lu/%lu, hits: %llu, misses: %llu, evicts: %llu\n",
+			 strPref, m_strDatabase, isConnected(),
+			 m_strJournalMode.isEmpty() ? "default" : m_strJournalMode.cs(),
+			 m_strSynchronous.isEmpty() ? "default" : m_strSynchronous.cs(),
+			 m_stmtCache.getCount(), m_stmtCache.getMax(),
+			 m_stmtCache.getHits(), m_stmtCache.getMisses(), m_stmtCache.getEvicts());
+}
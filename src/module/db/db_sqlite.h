@@ -10,6 +10,16 @@
  *
  *  Revision 1.0, 02.08.2015 12:44:03
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:41:17
+ *      Ported to CDbSql interface, statements with the bound parameters,
+ *      per connection prepared statement cache, row streaming results.
+ *
+ *  Revision 1.2, 18.10.2026 11:05:36
+ *      Journal mode and synchronous settings.
+ *
+ *  Revision 1.3, 18.10.2026 12:56:02
+ *      Busy timeout.
  */
 
 #ifndef __CARBON_DB_SQLITE_H_INCLUDED__
@@ -21,28 +31,80 @@
 
 #include "db/db_sql.h"
 
-class CSqliteResult : public CSqlResult
+#define SQLITE_BUSY_TIMEOUT_DEFAULT		HR_5SEC		/* Wait for the locked database */
+
+/*
+ * Helper class for Sqlite row iterations
+ *
+ * Note: column values are valid until the next row is fetched
+ */
+class CSqliteRow : public CSqlRow
 {
 	protected:
-		sqlite3_stmt*		m_pStmt;
+		sqlite3_stmt*		m_pStmt;		/* Statement positioned on the row */
+		size_t				m_nFields;		/* Fields in the row */
 
 	public:
-		CSqliteResult();
-		CSqliteResult(sqlite3_stmt* pStmt);
-		virtual ~CSqliteResult();
+		CSqliteRow() : CSqlRow(), m_pStmt(nullptr), m_nFields(0) {}
+		virtual ~CSqliteRow() {}
 
 	public:
-		virtual size_t getComumns() const;
-		virtual SQL_VARIANT operator[](int index) const;
-		virtual result_t getNextRow();
+		virtual void init(sqlite3_stmt* pStmt, size_t nFields) {
+			m_pStmt = pStmt; m_nFields = nFields;
+		}
 
-	private:
-		void finalise();
+		virtual char* operator[](size_t nIndex) noexcept(false);
+
+		virtual uint32_t getUint32(size_t nIndex) noexcept(false);
+		virtual int32_t getInt32(size_t nIndex) noexcept(false);
+		virtual uint64_t getUint64(size_t nIndex) noexcept(false);
+		virtual int64_t getInt64(size_t nIndex) noexcept(false);
+
+	protected:
+		int getType(size_t nIndex) noexcept(false);
+};
+
+class CDbSqlite;
+
+/*
+ * Class represents a Sqlite query result, rows are stepped
+ * on the prepared statement as the caller iterates
+ */
+class CSqliteResult : public CSqlResult
+{
+	protected:
+		CDbSqlite*			m_pDb;
+		sqlite3_stmt*		m_pStmt;		/* Executing statement (from the cache) */
+		int					m_nPending;		/* Step result not yet returned by getRow() */
+		boolean_t			m_bLocked;		/* Result holds the connection lock */
+
+	public:
+		CSqliteResult() :
+			CSqlResult(),
+			m_pDb(nullptr),
+			m_pStmt(nullptr),
+			m_nPending(SQLITE_OK),
+			m_bLocked(FALSE)
+		{
+		}
+
+		virtual ~CSqliteResult() { free(); }
+
+	public:
+		virtual size_t getFields() const;
+		virtual boolean_t getRow(CSqlRow* pRow) noexcept(false);
 
+		virtual void init(CDbSqlite* pDb, sqlite3_stmt* pStmt, int nPending, boolean_t bLocked);
+		virtual void free();
 };
 
+/*
+ * Sqlite database class
+ */
 class CDbSqlite : public CDbSql
 {
+	friend class CSqliteResult;
+
 	private:
 		static int		m_nLibraryInitialised;
 		static CMutex	m_lockInit;
@@ -50,23 +112,64 @@ class CDbSqlite : public CDbSql
 		result_t		m_resultInit;
 		char			m_strDatabase[256];
 		sqlite3*		m_pHandle;
-
-		CMutex			m_lockConnect;
 		int				m_nConnectCount;
 
+		CSqlStatementCache<sqlite3_stmt*>	m_stmtCache;	/* Prepared statements */
+
+		CString			m_strJournalMode;	/* PRAGMA journal_mode, "" - default */
+		CString			m_strSynchronous;	/* PRAGMA synchronous, "" - default */
+		hr_time_t		m_hrBusyTimeout;	/* Locked database wait time, HR_0 - no wait */
+
 	public:
 		CDbSqlite(const char* strDatabase);
 		virtual ~CDbSqlite();
 
 	public:
+		void setStatementCache(size_t nMax);
+		result_t setJournalMode(const char* strMode);
+		result_t setSynchronous(const char* strMode);
+		void setBusyTimeout(hr_time_t hrTimeout);
+
 		virtual result_t connect();
 		virtual void disconnect();
+		virtual boolean_t isConnected() const { return m_pHandle != nullptr; }
+
+		virtual result_t query(const char* strQuery);
+
+		virtual result_t queryValue(const char* strQuery, CString* pValue);
+		virtual result_t queryValue(const char* strQuery, uint64_t* pValue);
+		virtual result_t queryValue(const char* strQuery, int64_t* pValue);
+		virtual result_t queryValue(const char* strQuery, uint32_t* pValue);
+		virtual result_t queryValue(const char* strQuery, int32_t* pValue);
+
+		virtual result_t queryRow(const char* strQuery, str_vector_t* pVector);
+
+		virtual void iterate(const char* strQuery, CSqlResult* pResult,
+							 int nFlags = 0) noexcept(false);
+
+		using CDbSql::queryValue;
+
+		virtual result_t query(const char* strQuery, const CSqlParam* arParam, size_t nParams);
+		virtual result_t queryValue(const char* strQuery, const CSqlParam* arParam,
+									size_t nParams, CString* pValue);
+		virtual result_t queryRow(const char* strQuery, const CSqlParam* arParam,
+								  size_t nParams, str_vector_t* pVector);
+		virtual void iterate(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+							 CSqlResult* pResult, int nFlags = 0) noexcept(false);
 
-		virtual result_t query(const char* strQuery, CSqlResult** ppResult);
 		virtual void escape(const char* strInput, char* strOutput, size_t szOutput);
 
 	protected:
-		boolean_t isConnected() const { return m_pHandle != 0; }
+		result_t doPrepare(const char* strQuery, const CSqlParam* arParam, size_t nParams,
+						   sqlite3_stmt** ppStmt);
+
+		result_t applyJournalMode();
+		result_t applySynchronous();
+
+		static void freeStatement(sqlite3_stmt* pStmt);
+
+	public:
+		virtual void dump(const char* strPref = "") const;
 };
 
 #endif /* __CARBON_DB_SQLITE_H_INCLUDED__ */
@@ -1,5 +1,4 @@
 
 MODULE_DEP +=
 
-THPARTY_DEP += 
-#sqlite
+THPARTY_DEP += sqlite
@@ -10,6 +10,10 @@
  *
  *	Revision 1.0, 10.10.2016 14:51:46
  *	    Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 01:12:40
+ *	    Separator search and emulation prevention removal by the
+ *	    h264_scan vector kernels.
  */
 /*
  *	H264 Stream:
@@ -27,10 +31,9 @@
 
 #include "carbon/memory.h"
 
+#include "net_media/h264_scan.h"
 #include "net_media/h264.h"
 
-#define H264_NAL_SEPARATOR			0x00000001
-
 //#define H264_NAL_TYPE(__nal_head)	((__nal_head)&0x1F)
 
 const char* strNalType(size_t type)
@@ -138,49 +141,12 @@ boolean_t CH264::isNalSeparator(const uint8_t *pBuffer) const
 
 size_t CH264::findNextNalSeparator(const uint8_t *pBuffer, size_t length) const
 {
-	uint32_t 	val, temp;
-	size_t		offset;
-
-	offset = 0;
-	if ( isNalSeparator(pBuffer) ) {
-		pBuffer += 3;
-		offset = 3;
-	}
-
-	val = 0xffffffff;
-	while ( offset < length-3 ) {
-		val <<= 8;
-		temp = val & 0xff000000;
-		val &= 0x00ffffff;
-		val |= *pBuffer++;
-		offset++;
-		if ( val == H264_NAL_SEPARATOR ) {
-			if ( temp == 0 ) return offset-4;
-			return offset-3;
-		}
-	}
-
-	return 0;
+	return h264_find_next_nal(pBuffer, length);
 }
 
 void CH264::nalDecode3(uint8_t* pDst, int* pDstLen, const uint8_t* pSrc, int srcLen)
 {
-	uint8_t*		svDst = pDst;
-	const uint8_t*	end = &pSrc[srcLen];
-
-	while ( pSrc < end ) {
-		if ( pSrc < end - 3 && pSrc[0] == 0x00 && pSrc[1] == 0x00 && pSrc[2] == 0x03) {
-			*pDst++ = 0x00;
-			*pDst++ = 0x00;
-
-			pSrc += 3;
-			continue;
-		}
-
-		*pDst++ = *pSrc++;
-	}
-
-	*pDstLen = (int)(A(pDst) - A(svDst));
+	*pDstLen = (int)h264_rbsp_decode(pDst, pSrc, (size_t)srcLen);
 }
 
 
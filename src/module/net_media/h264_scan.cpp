@@ -0,0 +1,297 @@
+/*
+ *	Carbon/Network MultiMedia Streaming Module
+ *	H.264 bitstream start code and emulation prevention kernels
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 01:12:40
+ *		Initial revision.
+ */
+/*
+ * 	All the operations search for a triple 00 00 x, where x is within
+ * 	a given range: start code x = 1, emulation prevention byte x = 3,
+ * 	emulation prevention insertion point x = 0..3. The vector kernels
+ * 	compare the bytes at the offsets 0, 1 and 2 of 16/32 positions at
+ * 	once, the bitstream payload rarely contains two zero bytes, so the
+ * 	most of the data is passed without any branch.
+ */
+
+#include "shell/shell.h"
+#include "shell/tstring.h"
+
+#include "net_media/h264_scan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define H264_SCAN_X86			1
+#include <immintrin.h>
+#endif
+
+/*
+ * Find a triple 00 00 x, min <= x <= min+range
+ *
+ * 		p			data to scan
+ * 		end			data end
+ * 		min			minimal third byte value
+ * 		range		third byte value range
+ *
+ * Return: triple pointer or end if not found
+ */
+typedef const uint8_t* (*h264_scan_find_t)(const uint8_t* p, const uint8_t* end,
+											uint8_t min, uint8_t range);
+
+static const uint8_t* h264ScanScalar(const uint8_t* p, const uint8_t* end,
+									 uint8_t min, uint8_t range)
+{
+	while ( (end-p) > 2 )  {
+		if ( p[2] != 0 )  {
+			if ( p[1] == 0 && p[0] == 0 && (uint8_t)(p[2]-min) <= range )  {
+				return p;
+			}
+			/* The triples at p+1 and p+2 require p[2] == 0 */
+			p += 3;
+		}
+		else {
+			if ( p[1] == 0 && p[0] == 0 && min == 0 )  {
+				return p;
+			}
+			p += p[1] != 0 ? 2 : 1;
+		}
+	}
+
+	return end;
+}
+
+#if H264_SCAN_X86
+
+__attribute__((target("sse2")))
+static const uint8_t* h264ScanSse2(const uint8_t* p, const uint8_t* end,
+								   uint8_t min, uint8_t range)
+{
+	const __m128i	zero = _mm_setzero_si128();
+	const __m128i	vmin = _mm_set1_epi8((char)min);
+	const __m128i	vrange = _mm_set1_epi8((char)range);
+	__m128i			v0, v1, v2, m;
+	unsigned int	mask;
+
+	while ( (end-p) >= 18 )  {
+		v0 = _mm_loadu_si128((const __m128i*)p);
+		v1 = _mm_loadu_si128((const __m128i*)(p+1));
+		v2 = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)(p+2)), vmin);
+
+		m = _mm_and_si128(_mm_cmpeq_epi8(v0, zero), _mm_cmpeq_epi8(v1, zero));
+		m = _mm_and_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v2, vrange), v2));
+
+		mask = (unsigned int)_mm_movemask_epi8(m);
+		if ( mask != 0 )  {
+			return p + __builtin_ctz(mask);
+		}
+		p += 16;
+	}
+
+	return h264ScanScalar(p, end, min, range);
+}
+
+__attribute__((target("avx2")))
+static const uint8_t* h264ScanAvx2(const uint8_t* p, const uint8_t* end,
+								   uint8_t min, uint8_t range)
+{
+	const __m256i	zero = _mm256_setzero_si256();
+	const __m256i	vmin = _mm256_set1_epi8((char)min);
+	const __m256i	vrange = _mm256_set1_epi8((char)range);
+	__m256i			v0, v1, v2, m;
+	unsigned int	mask;
+
+	while ( (end-p) >= 34 )  {
+		v0 = _mm256_loadu_si256((const __m256i*)p);
+		v1 = _mm256_loadu_si256((const __m256i*)(p+1));
+		v2 = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*)(p+2)), vmin);
+
+		m = _mm256_and_si256(_mm256_cmpeq_epi8(v0, zero), _mm256_cmpeq_epi8(v1, zero));
+		m = _mm256_and_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(v2, vrange), v2));
+
+		mask = (unsigned int)_mm256_movemask_epi8(m);
+		if ( mask != 0 )  {
+			return p + __builtin_ctz(mask);
+		}
+		p += 32;
+	}
+
+	return h264ScanSse2(p, end, min, range);
+}
+
+#endif /* H264_SCAN_X86 */
+
+static const uint8_t* h264ScanResolve(const uint8_t* p, const uint8_t* end,
+									  uint8_t min, uint8_t range);
+
+static h264_scan_find_t	g_h264ScanFind = h264ScanResolve;
+static h264_scan_isa_t	g_h264ScanIsa = H264_SCAN_SCALAR;
+
+/*
+ * Select the best kernel on the first call
+ */
+static const uint8_t* h264ScanResolve(const uint8_t* p, const uint8_t* end,
+									  uint8_t min, uint8_t range)
+{
+	if ( !h264_scan_set_isa(H264_SCAN_AVX2) && !h264_scan_set_isa(H264_SCAN_SSE2) )  {
+		h264_scan_set_isa(H264_SCAN_SCALAR);
+	}
+
+	return g_h264ScanFind(p, end, min, range);
+}
+
+/*
+ * Force the kernel implementation
+ *
+ * 		isa			instruction set to use
+ *
+ * Return: FALSE if the CPU does not support the instruction set
+ */
+boolean_t h264_scan_set_isa(h264_scan_isa_t isa)
+{
+	h264_scan_find_t	find;
+
+	switch ( isa )  {
+		case H264_SCAN_SCALAR:
+			find = h264ScanScalar;
+			break;
+
+#if H264_SCAN_X86
+		case H264_SCAN_SSE2:
+			__builtin_cpu_init();
+			if ( !__builtin_cpu_supports("sse2") )  {
+				return FALSE;
+			}
+			find = h264ScanSse2;
+			break;
+
+		case H264_SCAN_AVX2:
+			__builtin_cpu_init();
+			if ( !__builtin_cpu_supports("avx2") )  {
+				return FALSE;
+			}
+			find = h264ScanAvx2;
+			break;
+#endif /* H264_SCAN_X86 */
+
+		default:
+			return FALSE;
+	}
+
+	g_h264ScanIsa = isa;
+	g_h264ScanFind = find;
+	return TRUE;
+}
+
+h264_scan_isa_t h264_scan_get_isa()
+{
+	if ( g_h264ScanFind == h264ScanResolve )  {
+		h264ScanResolve(NULL, NULL, 0, 0);
+	}
+
+	return g_h264ScanIsa;
+}
+
+const char* h264_scan_isa_name(h264_scan_isa_t isa)
+{
+	static const char* arName[] = { "scalar", "sse2", "avx2" };
+
+	return (size_t)isa < ARRAY_SIZE(arName) ? arName[isa] : "*ERROR*";
+}
+
+size_t h264_find_start_code(const uint8_t* pBuffer, size_t length)
+{
+	return (size_t)(g_h264ScanFind(pBuffer, pBuffer+length, 1, 0) - pBuffer);
+}
+
+size_t h264_find_next_nal(const uint8_t* pBuffer, size_t length)
+{
+	size_t	start, offset;
+
+	if ( length <= 3 )  {
+		return 0;
+	}
+
+	start = 0;
+	if ( pBuffer[0] == 0 && pBuffer[1] == 0 &&
+			( pBuffer[2] == 1 || (pBuffer[2] == 0 && pBuffer[3] == 1) ) )  {
+		start = 3;
+	}
+
+	if ( length-3 <= start )  {
+		return 0;
+	}
+
+	/* The separator must be followed by 3 bytes at least */
+	offset = start + h264_find_start_code(pBuffer+start, length-3-start);
+	if ( offset >= length-3 )  {
+		return 0;
+	}
+
+	return (offset > start && pBuffer[offset-1] == 0) ? offset-1 : offset;
+}
+
+size_t h264_rbsp_decode(uint8_t* pDst, const uint8_t* pSrc, size_t length)
+{
+	const uint8_t*	end = pSrc+length;
+	const uint8_t*	p;
+	uint8_t*		svDst = pDst;
+	size_t			size;
+
+	if ( length < 4 )  {
+		if ( pDst != pSrc )  {
+			_tmemmove(pDst, pSrc, length);
+		}
+		return length;
+	}
+
+	while ( pSrc < end )  {
+		/* The prevention byte is never the last one */
+		p = g_h264ScanFind(pSrc, end-1, 3, 0);
+		if ( p == end-1 )  {
+			p = end;
+		}
+
+		size = (size_t)(p-pSrc);
+		if ( p < end )  {
+			size += 2;
+		}
+
+		if ( pDst != pSrc )  {
+			_tmemmove(pDst, pSrc, size);
+		}
+		pDst += size;
+		pSrc = p < end ? p+3 : end;
+	}
+
+	return (size_t)(pDst-svDst);
+}
+
+size_t h264_rbsp_encode(uint8_t* pDst, const uint8_t* pSrc, size_t length)
+{
+	const uint8_t*	end = pSrc+length;
+	const uint8_t*	p;
+	uint8_t*		svDst = pDst;
+	size_t			size;
+
+	while ( pSrc < end )  {
+		p = g_h264ScanFind(pSrc, end, 0, 3);
+		if ( p == end )  {
+			UNALIGNED_MEMCPY(pDst, pSrc, (size_t)(end-pSrc));
+			pDst += end-pSrc;
+			break;
+		}
+
+		size = (size_t)(p-pSrc)+2;
+		UNALIGNED_MEMCPY(pDst, pSrc, size);
+		pDst += size;
+		*pDst++ = 0x03;
+		pSrc = p+2;
+	}
+
+	return (size_t)(pDst-svDst);
+}
@@ -0,0 +1,87 @@
+/*
+ *	Carbon/Network MultiMedia Streaming Module
+ *	H.264 bitstream start code and emulation prevention kernels
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 18.10.2026 01:12:40
+ *		Initial revision.
+ */
+/*
+ * Purpose:
+ * 		Byte stream scanning shared by CH264 and the MP4 H.264 parser:
+ * 		the start code (00 00 01) search and the emulation prevention
+ * 		byte (00 00 03) removal and insertion. The kernels test 16 (SSE2)
+ * 		or 32 (AVX2) positions per iteration, the implementation is
+ * 		selected on the first call by the CPU features.
+ */
+
+#ifndef __NET_MEDIA_H264_SCAN_H_INCLUDED__
+#define __NET_MEDIA_H264_SCAN_H_INCLUDED__
+
+#include "shell/types.h"
+
+typedef enum {
+	H264_SCAN_SCALAR	= 0,
+	H264_SCAN_SSE2		= 1,
+	H264_SCAN_AVX2		= 2
+} h264_scan_isa_t;
+
+/* Maximum encoded size of the RBSP of the given length */
+#define H264_EBSP_SIZE_MAX(__length)		((__length)+(__length)/2+1)
+
+/*
+ * Find a start code triple 00 00 01
+ *
+ * 		pBuffer			data to scan
+ * 		length			data length, bytes
+ *
+ * Return: triple offset or length if not found
+ */
+extern size_t h264_find_start_code(const uint8_t* pBuffer, size_t length);
+
+/*
+ * Find the next NAL unit separator (00 00 01 or 00 00 00 01), a separator
+ * at the beginning of the data is skipped
+ *
+ * 		pBuffer			data to scan
+ * 		length			data length, bytes
+ *
+ * Return: separator offset or 0 if not found
+ */
+extern size_t h264_find_next_nal(const uint8_t* pBuffer, size_t length);
+
+/*
+ * Remove the emulation prevention bytes (00 00 03 -> 00 00)
+ *
+ * 		pDst			output buffer, may be the same as pSrc
+ * 		pSrc			encapsulated data
+ * 		length			data length, bytes
+ *
+ * Return: output length, bytes
+ */
+extern size_t h264_rbsp_decode(uint8_t* pDst, const uint8_t* pSrc, size_t length);
+
+/*
+ * Insert the emulation prevention bytes (00 00 0x -> 00 00 03 0x, x <= 3)
+ *
+ * 		pDst			output buffer, at least H264_EBSP_SIZE_MAX(length) bytes
+ * 		pSrc			raw data
+ * 		length			data length, bytes
+ *
+ * Return: output length, bytes
+ */
+extern size_t h264_rbsp_encode(uint8_t* pDst, const uint8_t* pSrc, size_t length);
+
+/*
+ * Kernel selection
+ */
+extern h264_scan_isa_t h264_scan_get_isa();
+extern boolean_t h264_scan_set_isa(h264_scan_isa_t isa);
+extern const char* h264_scan_isa_name(h264_scan_isa_t isa);
+
+#endif /* __NET_MEDIA_H264_SCAN_H_INCLUDED__ */
@@ -10,8 +10,20 @@
  *
  *	Revision 1.0, 16.11.2016 18:44:52
  *	    Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 14:40:35
+ *	    Added slab allocated new/delete.
  */
 
+#include <new>
+
+#include "shell/config.h"
+#include "shell/memory.h"
+
+#if CARBON_SLAB_ALLOCATOR
+#include "carbon/slab_allocator.h"
+#endif /* CARBON_SLAB_ALLOCATOR */
+
 #include "net_media/media_frame.h"
 
 /*******************************************************************************
@@ -27,3 +39,35 @@ CMediaFrame::CMediaFrame(const char* strName) :
 CMediaFrame::~CMediaFrame()
 {
 }
+
+/*
+ * Frames are created for every received video/audio frame and mostly
+ * released by the other thread, allocate them from the thread caches
+ */
+void* CMediaFrame::operator new(size_t size)
+{
+	void*	pData;
+
+#if CARBON_SLAB_ALLOCATOR
+	pData = slabAlloc(size);
+#else /* CARBON_SLAB_ALLOCATOR */
+	pData = memAlloc(size);
+#endif /* CARBON_SLAB_ALLOCATOR */
+
+	if ( !pData )  {
+		throw std::bad_alloc();
+	}
+
+	return pData;
+}
+
+void CMediaFrame::operator delete(void* pData)
+{
+	if ( pData )  {
+#if CARBON_SLAB_ALLOCATOR
+		slabFree(pData);
+#else /* CARBON_SLAB_ALLOCATOR */
+		memFree(pData);
+#endif /* CARBON_SLAB_ALLOCATOR */
+	}
+}
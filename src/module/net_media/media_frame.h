@@ -10,11 +10,19 @@
  *
  *	Revision 1.0, 16.11.2016 18:42:44
  *	    Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 14:40:12
+ *	    Added slab allocated new/delete.
+ *
+ *	Revision 1.2, 18.10.2026 00:31:15
+ *	    Added optional getIov().
  */
 
 #ifndef __MEDIA_FRAME_H_INCLUDED__
 #define __MEDIA_FRAME_H_INCLUDED__
 
+#include <sys/uio.h>
+
 #include "shell/shell.h"
 #include "shell/object.h"
 #include "shell/ref_object.h"
@@ -27,6 +35,10 @@ class CMediaFrame : public CObject, public CRefObject
 	protected:
 		virtual ~CMediaFrame();
 
+	public:
+		void* operator new(size_t size);
+		void operator delete(void* pData);
+
 	public:
 		/*
 		 * Frame data/size
@@ -34,6 +46,21 @@ class CMediaFrame : public CObject, public CRefObject
 		virtual uint8_t* getData() = 0;
 		virtual size_t getSize() const = 0;
 
+		/*
+		 * Optional frame data fragments pointing to the frame own memory,
+		 * the fragments are valid while the frame is referenced
+		 *
+		 * 		parVec		fragments [out]
+		 * 		pCount		fragment count [out]
+		 *
+		 * Return: ESUCCESS, ENOSYS (use getData())
+		 */
+		virtual result_t getIov(const struct iovec** parVec, size_t* pCount) {
+			*parVec = NULL;
+			*pCount = 0;
+			return ENOSYS;
+		}
+
 		/*
 		 * Get/Set a media frame Decode Timestamp (DTS):
 		 * 		- first timestamp is random value (starts from any value)
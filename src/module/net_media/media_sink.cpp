@@ -10,12 +10,20 @@
  *
  *	Revision 1.0, 24.10.2016 10:26:15
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 23:20:41
+ *		Completed nodes are passed by the lock-free SPSC queue.
+ *
+ *	Revision 1.2, 18.10.2026 11:48:30
+ *		Playout thread waits for a free queue slot.
  */
 
 #include "net_media/rtp_playout_buffer.h"
 #include "net_media/media_sink.h"
 
 #define VIDEO_SINKV_IDLE			HR_8SEC
+#define VIDEO_SINKV_PUT_TIMEOUT		HR_1SEC		/* Maximum wait for a free queue slot */
+#define VIDEO_SINKV_DROP_LOG		HR_10SEC	/* Minimum interval of the overflow logging */
 
 /*******************************************************************************
  * CVideoSink class
@@ -39,9 +47,13 @@ CVideoSink::~CVideoSink()
 CVideoSinkV::CVideoSinkV() :
 	CVideoSink(),
 	CThread("video_sink", HR_0, HR_4SEC),
-	m_nNodes(ZERO_COUNTER)
+	m_hrDropLog(HR_0),
+	m_nNodes(ZERO_COUNTER),
+	m_nNodesDropped(ZERO_COUNTER)
 {
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_waiting, 0);
+	sh_atomic_set(&m_full, 0);
+	sh_atomic_set(&m_bDone, FALSE);
 }
 
 CVideoSinkV::~CVideoSinkV()
@@ -59,32 +71,110 @@ void CVideoSinkV::wakeup()
 }
 
 /*
- * Remove all awaiting nodes from the list
+ * Wake up a sink thread if it is waiting
+ */
+void CVideoSinkV::notify()
+{
+	__sync_synchronize();
+	if ( sh_atomic_get(&m_waiting) != 0 )  {
+		wakeup();
+	}
+}
+
+/*
+ * Sleep until notified or the time has come
+ *
+ *      hrTime      time to stop waiting
+ *
+ * Note: m_cond must be held
+ */
+void CVideoSinkV::waitNotify(hr_time_t hrTime)
+{
+	/* Producer checks the flag after queueing, the queue is checked after setting */
+	sh_atomic_set(&m_waiting, 1);
+	__sync_synchronize();
+
+	if ( m_arNode.empty() )  {
+		m_cond.waitTimed(hrTime);
+	}
+
+	sh_atomic_set(&m_waiting, 0);
+}
+
+/*
+ * Wait for a free queue slot and append a node
+ *
+ * 		pNode		node to append
+ *
+ * Return: TRUE if the node is appended, FALSE on timeout or cancellation
+ *
+ * Note: called by the playout buffer thread only
+ */
+boolean_t CVideoSinkV::waitPush(CRtpPlayoutNode* pNode)
+{
+	hr_time_t	hrDeadline = hr_time_now()+VIDEO_SINKV_PUT_TIMEOUT;
+	boolean_t	bPushed;
+
+	m_condFull.lock();
+
+	/* Consumer checks the flag after removing, the queue is checked after setting */
+	sh_atomic_set(&m_full, 1);
+	__sync_synchronize();
+
+	while ( !(bPushed=m_arNode.push(pNode)) && sh_atomic_get(&m_bDone) == FALSE &&
+				hr_time_now() < hrDeadline )
+	{
+		m_condFull.waitTimed(hrDeadline);
+	}
+
+	sh_atomic_set(&m_full, 0);
+	m_condFull.unlock();
+
+	return bPushed;
+}
+
+/*
+ * Remove all awaiting nodes from the queue
+ *
+ * Note: called when the sink thread is not running
  */
 void CVideoSinkV::clear()
 {
-	CAutoLock			locker(m_cond);
-	CRtpPlayoutNode*	pNode = 0;
+	CRtpPlayoutNode*	pNode;
 
-	while ( !m_arNode.empty() ) {
-		pNode = *m_arNode.begin();
-		m_arNode.pop_front();
+	while ( (pNode=m_arNode.pop()) != 0 ) {
 		pNode->release();
 	}
 }
 
 /*
- * Put new completed node to the list and wakeup sink thread
+ * Put new completed node to the queue and wakeup sink thread
+ *
+ * Note: called by the playout buffer thread only
  */
 void CVideoSinkV::put(CRtpPlayoutNode* pNode)
 {
-	CAutoLock			locker(m_cond);
-
-	if ( atomic_get(&m_bDone) == FALSE ) {
+	if ( sh_atomic_get(&m_bDone) == FALSE ) {
 		pNode->reference();
-		m_arNode.push_back(pNode);
+		if ( !m_arNode.push(pNode) )  {
+			/* Sink is behind, hold the playout thread */
+			notify();
+
+			if ( !waitPush(pNode) )  {
+				pNode->release();
+				counter_inc(m_nNodesDropped);
+
+				if ( hr_time_get_elapsed(m_hrDropLog) >= VIDEO_SINKV_DROP_LOG )  {
+					log_error(L_RTP, "[sinkv] node queue overflow, %u node(s) dropped\n",
+							  counter_get(m_nNodesDropped));
+					m_hrDropLog = hr_time_now();
+				}
+				return;
+			}
+		}
+
 		counter_inc(m_nNodes);
-		m_cond.wakeup();
+		notify();
 	}
 }
 
@@ -95,12 +185,16 @@ void CVideoSinkV::put(CRtpPlayoutNode* pNode)
  */
 CRtpPlayoutNode* CVideoSinkV::getNextNode()
 {
-	CAutoLock			locker(m_cond);
-	CRtpPlayoutNode*	pNode = 0;
+	CRtpPlayoutNode*	pNode;
 
-	if ( !m_arNode.empty() )  {
-		pNode = *m_arNode.begin();
-		m_arNode.pop_front();
+	pNode = m_arNode.pop();
+	if ( pNode )  {
+		__sync_synchronize();
+		if ( sh_atomic_get(&m_full) != 0 )  {
+			m_condFull.lock();
+			m_condFull.wakeup();
+			m_condFull.unlock();
+		}
 	}
 
 	return pNode;
@@ -113,16 +207,17 @@ void* CVideoSinkV::threadProc(CThread* pThread, void* pData)
 {
 	CRtpPlayoutNode*	pNode;
 
-	while ( atomic_get(&m_bDone) == FALSE )  {
+	while ( sh_atomic_get(&m_bDone) == FALSE )  {
 		pNode = getNextNode();
 		if ( pNode )  {
 			processNode(pNode);
 			pNode->release();
+			continue;
 		}
 
 		m_cond.lock();
-		if ( atomic_get(&m_bDone) == FALSE && m_arNode.size() == 0 )  {
-			m_cond.waitTimed(hr_time_now()+VIDEO_SINKV_IDLE);
+		if ( sh_atomic_get(&m_bDone) == FALSE )  {
+			waitNotify(hr_time_now()+VIDEO_SINKV_IDLE);
 		}
 		m_cond.unlock();
 	}
@@ -144,7 +239,7 @@ result_t CVideoSinkV::init(int nFps, int nRate)
 		return nresult;
 	}
 
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_bDone, FALSE);
 
 	nresult = CThread::start(THREAD_CALLBACK(CVideoSinkV::threadProc, this), 0);
 	if ( nresult != ESUCCESS )  {
@@ -160,8 +255,15 @@ result_t CVideoSinkV::init(int nFps, int nRate)
  */
 void CVideoSinkV::terminate()
 {
-	atomic_set(&m_bDone, TRUE);
-	wakeup();
+	m_cond.lock();
+	sh_atomic_set(&m_bDone, TRUE);
+	m_cond.wakeup();
+	m_cond.unlock();
+
+	m_condFull.lock();
+	m_condFull.wakeup();
+	m_condFull.unlock();
+
 	CThread::stop();
 	clear();
 }
@@ -172,8 +274,7 @@ void CVideoSinkV::terminate()
 
 void CVideoSinkV::dump(const char* strPref) const
 {
-	CAutoLock	locker(m_cond);
-
-	log_dump("*** %sVideoSinkV: pending nodes: %u, full node count: %u\n",
-			 strPref, m_arNode.size(), counter_get(m_nNodes));
+	log_dump("*** %sVideoSinkV: pending nodes: %u, full node count: %u, dropped: %u\n",
+			 strPref, (unsigned)m_arNode.size(), counter_get(m_nNodes),
+			 counter_get(m_nNodesDropped));
 }
@@ -10,13 +10,17 @@
  *
  *	Revision 1.0, 24.10.2016 10:22:59
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 23:20:41
+ *		Completed nodes are passed by the lock-free SPSC queue.
+ *
+ *	Revision 1.2, 18.10.2026 11:48:30
+ *		Playout thread waits for a free queue slot.
  */
 
 #ifndef __NET_MEDIA_VIDEO_SINK_H_INCLUDED__
 #define __NET_MEDIA_VIDEO_SINK_H_INCLUDED__
 
-#include <list>
-
 #include "shell/counter.h"
 
 #include "carbon/thread.h"
@@ -24,6 +28,7 @@
 #include "carbon/carbon.h"
 
 #include "net_media/rtp_playout_buffer.h"
+#include "net_media/rtp_node_ring.h"
 
 class CVideoSink
 {
@@ -58,11 +63,16 @@ class CVideoSink
 class CVideoSinkV : public CVideoSink, public CThread
 {
 	private:
-		std::list<CRtpPlayoutNode*>	m_arNode;			/* Completed node list */
-		mutable CCondition			m_cond;				/* List synchonization/wakeup */
+		CRtpNodeQueue				m_arNode;			/* Completed nodes, playout thread to sink thread */
+		mutable CCondition			m_cond;				/* Sink thread wakeup */
+		atomic_t					m_waiting;			/* Sink thread is waiting on m_cond */
+		mutable CCondition			m_condFull;			/* Playout thread wakeup on a free slot */
+		atomic_t					m_full;				/* Playout thread is waiting on m_condFull */
 		atomic_t					m_bDone;			/* Cancellation flag */
+		hr_time_t					m_hrDropLog;		/* Last queue overflow log time */
 
 		counter_t					m_nNodes;			/* DBG: Full processed node count */
+		counter_t					m_nNodesDropped;	/* DBG: Nodes dropped by the queue overflow */
 
 	public:
 		CVideoSinkV();
@@ -84,6 +94,9 @@ class CVideoSinkV : public CVideoSink, public CThread
 		virtual void clear();
 
 	private:
+		void notify();
+		void waitNotify(hr_time_t hrTime);
+		boolean_t waitPush(CRtpPlayoutNode* pNode);
 		void* threadProc(CThread* pThread, void* pData);
 };
 
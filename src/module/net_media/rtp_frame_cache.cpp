@@ -10,96 +10,429 @@
  *
  *	Revision 1.0, 11.10.2016 17:41:00
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 20:06:31
+ *		Per-thread magazines over a lock-free depot, slab preallocation.
  */
 
+#include <pthread.h>
+#include <sys/mman.h>
+
 #include "carbon/memory.h"
 
 #include "net_media/rtp_frame_cache.h"
 
+#define RTP_MAGAZINE_NONE			0xffffffffU
+#define RTP_FRAME_STRIDE			ALIGN(sizeof(rtp_frame_t), 64)
+#define RTP_FRAME_SLAB_HEAD			ALIGN(sizeof(rtp_frame_slab_t), 64)
+
+/*
+ * Thread index allocation, shared by all caches
+ *
+ * A thread takes the lowest free index on the first cache access and
+ * releases it on exit. A new thread adopts the magazines left by the
+ * exited thread with the same index.
+ */
+static pthread_once_t		g_rtpCacheOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t		g_rtpCacheKey;
+static pthread_mutex_t		g_rtpCacheLock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t				g_rtpCacheThreadMap = 0;	/* Busy indexes, under g_rtpCacheLock */
+
+static __thread int			t_rtpCacheThread = -1;		/* -1: not assigned, -2: none available */
+
+static void rtpCacheThreadExit(void* p)
+{
+	int		index = (int)((intptr_t)p)-1;
+
+	pthread_mutex_lock(&g_rtpCacheLock);
+	g_rtpCacheThreadMap &= ~(1ULL << index);
+	pthread_mutex_unlock(&g_rtpCacheLock);
+
+	t_rtpCacheThread = -1;
+}
+
+static void rtpCacheInit()
+{
+	shell_verify(pthread_key_create(&g_rtpCacheKey, rtpCacheThreadExit) == 0);
+}
+
+/*
+ * Get the current thread index
+ *
+ * Return: index or -1 if no free index is available
+ */
+static int rtpCacheThreadIndex()
+{
+	int		index;
+
+	if ( t_rtpCacheThread != -1 )  {
+		return t_rtpCacheThread >= 0 ? t_rtpCacheThread : -1;
+	}
+
+	pthread_once(&g_rtpCacheOnce, rtpCacheInit);
+
+	pthread_mutex_lock(&g_rtpCacheLock);
+	for(index=0; index<RTP_FRAME_CACHE_THREADS; index++)  {
+		if ( (g_rtpCacheThreadMap & (1ULL << index)) == 0 )  {
+			g_rtpCacheThreadMap |= 1ULL << index;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&g_rtpCacheLock);
+
+	if ( index < RTP_FRAME_CACHE_THREADS )  {
+		pthread_setspecific(g_rtpCacheKey, (void*)(intptr_t)(index+1));
+		t_rtpCacheThread = index;
+	}
+	else {
+		t_rtpCacheThread = -2;
+		index = -1;
+	}
+
+	return index;
+}
+
 /*******************************************************************************
  * CRtpFrameCache class
  */
 
+/*
+ * Create a frame cache
+ *
+ * 		nMaxLength		frames to preallocate
+ */
 CRtpFrameCache::CRtpFrameCache(int nMaxLength) :
 	m_nLength(0),
 	m_nMaxLength(nMaxLength),
+	m_arMagazine(0),
+	m_nMagazines(0),
+	m_nFullHead(RTP_MAGAZINE_NONE),
+	m_nEmptyHead(RTP_MAGAZINE_NONE),
+	m_pSlab(0),
+	m_nSlabFree(0),
+	m_pSlabNext(0),
+	m_nSlabs(0),
+	m_nHugeSlabs(0),
+	m_nFrames(0),
 	m_hitCount(0),
 	m_misCount(0)
 {
+	rtp_frame_magazine_t*	pMagazine;
+	rtp_frame_t*			pFrame;
+	size_t					i, count;
+	uint32_t				index;
+
 	queue_init(&m_queue);
+	_tbzero_object(m_arThread);
+
+	/*
+	 * Magazines for the preallocated frames twice, plus a pair per thread
+	 */
+	count = nMaxLength > 0 ? (size_t)nMaxLength : 0;
+	m_nMagazines = ((count+RTP_FRAME_MAGAZINE_SIZE-1)/RTP_FRAME_MAGAZINE_SIZE)*2 +
+						RTP_FRAME_CACHE_THREADS*2;
+	m_arMagazine = (rtp_frame_magazine_t*)memAlloc(m_nMagazines*sizeof(rtp_frame_magazine_t));
+	if ( m_arMagazine == 0 )  {
+		log_error(L_RTP, "[rtp_frame_cache] failed to allocate %u magazines\n",
+				  (unsigned)m_nMagazines);
+		m_nMagazines = 0;
+	}
+
+	for(i=0; i<m_nMagazines; i++)  {
+		m_arMagazine[i].nIndex = (uint32_t)i;
+		m_arMagazine[i].nCount = 0;
+		depotPush(&m_nEmptyHead, &m_arMagazine[i]);
+	}
+
+	/*
+	 * Preallocate frames to the depot
+	 */
+	while ( count > 0 && (index=depotPop(&m_nEmptyHead)) != RTP_MAGAZINE_NONE )  {
+		pMagazine = &m_arMagazine[index];
+		while ( pMagazine->nCount < RTP_FRAME_MAGAZINE_SIZE && count > 0 &&
+				(pFrame=allocFrame()) != RTP_FRAME_NULL )
+		{
+			pMagazine->arFrame[pMagazine->nCount++] = pFrame;
+			count--;
+		}
+
+		if ( pMagazine->nCount == 0 )  {
+			depotPush(&m_nEmptyHead, pMagazine);
+			break;
+		}
+		depotPush(&m_nFullHead, pMagazine);
+	}
 }
 
 CRtpFrameCache::~CRtpFrameCache()
 {
-	clear();
+	rtp_frame_slab_t*	pSlab;
+
+	while ( m_pSlab != 0 )  {
+		pSlab = m_pSlab;
+		m_pSlab = pSlab->pNext;
+		::munmap(pSlab, RTP_FRAME_SLAB_SIZE);
+	}
+
+	SAFE_FREE(m_arMagazine);
 }
 
 /*
- * Allocate a RTP frame from the cache
- *
- * Return: frame pointer or RTP_FRAME_NULL
+ * Reset statistic, the frames are kept in the slabs until
+ * the cache is destroyed
  */
-rtp_frame_t* CRtpFrameCache::get()
+void CRtpFrameCache::clear()
 {
-	CAutoLock		locker(m_lock);
-	rtp_frame_t*	pFrame;
+	CAutoLock	locker(m_lock);
+	size_t		i;
 
-	if ( m_nLength > 0 )  {
-		queue_remove_first(&m_queue, pFrame, rtp_frame_t*, link);
-		shell_assert(pFrame->pOwner == this);
-		m_nLength--;
-		m_hitCount++;
+	for(i=0; i<RTP_FRAME_CACHE_THREADS; i++)  {
+		m_arThread[i].nHit = 0;
 	}
-	else {
-		m_misCount++;
+	m_hitCount = 0;
+	m_misCount = 0;
+}
 
-		if ( m_nLength < m_nMaxLength ) {
-			locker.unlock();
-			pFrame = (rtp_frame_t*)memAlloc(sizeof(rtp_frame_t));
-			if ( pFrame != RTP_FRAME_NULL ) {
-				pFrame->pOwner = this;
-			}
+/*
+ * Get magazines of the current thread
+ *
+ * Return: thread magazines or NULL
+ */
+rtp_frame_thread_t* CRtpFrameCache::getThread()
+{
+	int		index = m_nMagazines > 0 ? rtpCacheThreadIndex() : -1;
+
+	return index >= 0 ? &m_arThread[index] : NULL;
+}
+
+/*
+ * Pop a magazine from a depot stack
+ *
+ * 		pHead			stack head
+ *
+ * Return: magazine index or RTP_MAGAZINE_NONE
+ */
+uint32_t CRtpFrameCache::depotPop(volatile uint64_t* pHead)
+{
+	uint64_t	head, newHead;
+	uint32_t	index;
+
+	do {
+		head = *pHead;
+		index = (uint32_t)head;
+		if ( index == RTP_MAGAZINE_NONE )  {
+			break;
 		}
-		else {
-			/* Allocated frames limit reached */
-			pFrame = RTP_FRAME_NULL;
+		/* The tag increment protects from ABA on the concurrent pop/push */
+		newHead = (((head >> 32)+1) << 32) | m_arMagazine[index].nNext;
+	} while ( !__sync_bool_compare_and_swap(pHead, head, newHead) );
+
+	return index;
+}
+
+/*
+ * Push a magazine to a depot stack
+ *
+ * 		pHead			stack head
+ * 		pMagazine		magazine to push
+ */
+void CRtpFrameCache::depotPush(volatile uint64_t* pHead, rtp_frame_magazine_t* pMagazine)
+{
+	uint64_t	head, newHead;
+
+	do {
+		head = *pHead;
+		pMagazine->nNext = (uint32_t)head;
+		newHead = (((head >> 32)+1) << 32) | pMagazine->nIndex;
+	} while ( !__sync_bool_compare_and_swap(pHead, head, newHead) );
+}
+
+/*
+ * Map a new frame slab
+ *
+ * Return: TRUE on success, FALSE on out of memory
+ *
+ * Note: cache lock must be held
+ */
+boolean_t CRtpFrameCache::allocSlab()
+{
+	rtp_frame_slab_t*	pSlab;
+	void*				p;
+	boolean_t			bHuge = TRUE;
+
+	p = ::mmap(NULL, RTP_FRAME_SLAB_SIZE, PROT_READ|PROT_WRITE,
+			   MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+	if ( p == MAP_FAILED )  {
+		/* No reserved hugepages, ask for the transparent ones */
+		bHuge = FALSE;
+		p = ::mmap(NULL, RTP_FRAME_SLAB_SIZE, PROT_READ|PROT_WRITE,
+				   MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		if ( p == MAP_FAILED )  {
+			log_error(L_RTP, "[rtp_frame_cache] failed to map a slab, result %d\n", errno);
+			return FALSE;
 		}
+		::madvise(p, RTP_FRAME_SLAB_SIZE, MADV_HUGEPAGE);
 	}
 
-	return pFrame;
+	pSlab = (rtp_frame_slab_t*)p;
+	pSlab->pNext = m_pSlab;
+	pSlab->bHuge = bHuge;
+	m_pSlab = pSlab;
+
+	m_pSlabNext = (uint8_t*)p + RTP_FRAME_SLAB_HEAD;
+	m_nSlabFree = (RTP_FRAME_SLAB_SIZE-RTP_FRAME_SLAB_HEAD)/RTP_FRAME_STRIDE;
+
+	m_nSlabs++;
+	m_nHugeSlabs += bHuge ? 1 : 0;
+	return TRUE;
 }
 
 /*
- * Put an RTP frame to the cache
+ * Carve a new frame from the current slab
  *
- * 		pFrame			frame to put back to the cache
+ * Return: frame or RTP_FRAME_NULL
+ *
+ * Note: cache lock must be held
  */
-void CRtpFrameCache::put(rtp_frame_t* pFrame)
+rtp_frame_t* CRtpFrameCache::allocFrame()
 {
-	CAutoLock		locker(m_lock);
+	rtp_frame_t*	pFrame;
 
-	if ( pFrame != RTP_FRAME_NULL )  {
-		queue_enter_first(&m_queue, pFrame, rtp_frame_t*, link);
-		m_nLength++;
+	if ( m_nSlabFree == 0 && !allocSlab() )  {
+		return RTP_FRAME_NULL;
 	}
+
+	pFrame = (rtp_frame_t*)m_pSlabNext;
+	m_pSlabNext += RTP_FRAME_STRIDE;
+	m_nSlabFree--;
+	m_nFrames++;
+
+	pFrame->pOwner = this;
+	return pFrame;
 }
 
 /*
- * Free cached frames
+ * Get a number of RTP frames from the cache
  *
- * 		count		frames to free
+ * 		arFrame			frames [out]
+ * 		count			frames to get
  *
- * Note: queue lock must be held
+ * Return: frame count got (less than count on out of memory only)
  */
-void CRtpFrameCache::queueFree(int count)
+size_t CRtpFrameCache::getN(rtp_frame_t** arFrame, size_t count)
 {
-	rtp_frame_t*	pFrame;
-	int 			n = 0;
+	rtp_frame_thread_t*		pThread = getThread();
+	rtp_frame_magazine_t*	pMagazine;
+	rtp_frame_t*			pFrame;
+	size_t					n = 0, k;
+	uint32_t				index;
+
+	if ( pThread != 0 )  {
+		while ( n < count )  {
+			pMagazine = pThread->pLoaded;
+			if ( pMagazine != 0 && pMagazine->nCount > 0 )  {
+				k = sh_min(count-n, pMagazine->nCount);
+				pMagazine->nCount -= k;
+				_tmemcpy(&arFrame[n], &pMagazine->arFrame[pMagazine->nCount], k*sizeof(rtp_frame_t*));
+				n += k;
+				continue;
+			}
+
+			if ( pThread->pPrevious != 0 && pThread->pPrevious->nCount > 0 )  {
+				pThread->pLoaded = pThread->pPrevious;
+				pThread->pPrevious = pMagazine;
+				continue;
+			}
+
+			/* Both magazines are empty, exchange with a full one */
+			index = depotPop(&m_nFullHead);
+			if ( index == RTP_MAGAZINE_NONE )  {
+				break;
+			}
 
-	while ( !queue_empty(&m_queue) && n < count )  {
-		queue_remove_first(&m_queue, pFrame, rtp_frame_t*, link);
-		m_nLength--;
-		memFree(pFrame);
+			if ( pThread->pPrevious != 0 )  {
+				depotPush(&m_nEmptyHead, pThread->pPrevious);
+			}
+			pThread->pPrevious = pMagazine;
+			pThread->pLoaded = &m_arMagazine[index];
+		}
+
+		pThread->nHit += n;
+	}
+
+	if ( n < count )  {
+		CAutoLock	locker(m_lock);
+
+		while ( n < count && m_nLength > 0 )  {
+			queue_remove_first(&m_queue, pFrame, rtp_frame_t*, link);
+			shell_assert(pFrame->pOwner == this);
+			arFrame[n++] = pFrame;
+			m_nLength--;
+			m_hitCount++;
+		}
+
+		while ( n < count && (pFrame=allocFrame()) != RTP_FRAME_NULL )  {
+			arFrame[n++] = pFrame;
+			m_misCount++;
+		}
+	}
+
+	return n;
+}
+
+/*
+ * Put a number of RTP frames back to the cache
+ *
+ * 		arFrame			frames to put
+ * 		count			frame count
+ */
+void CRtpFrameCache::putN(rtp_frame_t* const* arFrame, size_t count)
+{
+	rtp_frame_thread_t*		pThread = getThread();
+	rtp_frame_magazine_t*	pMagazine;
+	size_t					n = 0, k;
+	uint32_t				index;
+
+	if ( pThread != 0 )  {
+		while ( n < count )  {
+			pMagazine = pThread->pLoaded;
+			if ( pMagazine != 0 && pMagazine->nCount < RTP_FRAME_MAGAZINE_SIZE )  {
+				k = sh_min(count-n, RTP_FRAME_MAGAZINE_SIZE-pMagazine->nCount);
+				_tmemcpy(&pMagazine->arFrame[pMagazine->nCount], &arFrame[n], k*sizeof(rtp_frame_t*));
+				pMagazine->nCount += k;
+				n += k;
+				continue;
+			}
+
+			if ( pThread->pPrevious != 0 && pThread->pPrevious->nCount == 0 )  {
+				pThread->pLoaded = pThread->pPrevious;
+				pThread->pPrevious = pMagazine;
+				continue;
+			}
+
+			/* Both magazines are full, exchange with an empty one */
+			index = depotPop(&m_nEmptyHead);
+			if ( index == RTP_MAGAZINE_NONE )  {
+				break;
+			}
+
+			if ( pThread->pPrevious != 0 )  {
+				depotPush(&m_nFullHead, pThread->pPrevious);
+			}
+			pThread->pPrevious = pMagazine;
+			pThread->pLoaded = &m_arMagazine[index];
+		}
+	}
+
+	if ( n < count )  {
+		CAutoLock	locker(m_lock);
+
+		while ( n < count )  {
+			shell_assert(arFrame[n]->pOwner == this);
+			queue_enter_first(&m_queue, arFrame[n], rtp_frame_t*, link);
+			m_nLength++;
+			n++;
+		}
 	}
 }
 
@@ -110,12 +443,20 @@ void CRtpFrameCache::queueFree(int count)
 void CRtpFrameCache::dump(const char* strPref) const
 {
 	CAutoLock	locker(m_lock);
+	uint64_t	hitCount = m_hitCount;
+	size_t		i;
 	int 		hit = 0;
 
-	if ( m_hitCount+m_misCount != 0 ) {
-		hit = (int)((m_hitCount * 100) / (m_hitCount + m_misCount));
+	for(i=0; i<RTP_FRAME_CACHE_THREADS; i++)  {
+		hitCount += m_arThread[i].nHit;
+	}
+
+	if ( hitCount+m_misCount != 0 ) {
+		hit = (int)((hitCount * 100) / (hitCount + m_misCount));
 	}
 
-	log_dump("*** %sRTP Frame Cache: hit ratio %d%% (hit: %d, mis: %d)\n",
-				strPref, hit, m_hitCount, m_misCount);
+	log_dump("*** %sRTP Frame Cache: hit ratio %d%% (hit: %llu, mis: %d), "
+			 "%d frames in %d slab(s) (%d hugepage), %d shared\n",
+				strPref, hit, (unsigned long long)hitCount, m_misCount,
+				m_nFrames, m_nSlabs, m_nHugeSlabs, m_nLength);
 }
@@ -10,6 +10,24 @@
  *
  *	Revision 1.0, 11.10.2016 17:41:00
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 20:05:48
+ *		Per-thread magazines over a lock-free depot, bulk getN()/putN(),
+ *		frames are preallocated in the hugepage backed slabs.
+ */
+/*
+ * Purpose:
+ * 		Every thread takes and releases frames through its own pair of
+ * 		magazines (arrays of up to RTP_FRAME_MAGAZINE_SIZE frames) without
+ * 		locking. Full and empty magazines are exchanged with the shared
+ * 		depot, which is a pair of lock-free stacks.
+ *
+ * 		The frames are carved from RTP_FRAME_SLAB_SIZE slabs mapped by
+ * 		hugepages when available. The slabs are released by the cache
+ * 		destructor only.
+ *
+ * 		Threads above RTP_FRAME_CACHE_THREADS and frames which do not fit
+ * 		to the depot fall back to the shared list under the lock.
  */
 
 #ifndef __NET_MEDIA_RTP_FRAME_CACHE_H_INCLUDED__
@@ -22,36 +40,94 @@
 
 #include "net_media/rtp.h"
 
-#define RTP_FRAME_CACHE_LIMIT			1000	/* Default maximum allocated frames */
+#define RTP_FRAME_CACHE_LIMIT			1000	/* Default preallocated frames */
+#define RTP_FRAME_MAGAZINE_SIZE			32		/* Frames per magazine */
+#define RTP_FRAME_CACHE_THREADS			32		/* Maximum threads with own magazines */
+#define RTP_FRAME_SLAB_SIZE				(2*1024*1024)	/* Frame slab size, bytes */
+
+/*
+ * Magazine: a stack of free frames
+ */
+typedef struct
+{
+	uint32_t			nIndex;				/* Magazine index in the cache */
+	uint32_t			nNext;				/* Next magazine in the depot stack */
+	size_t				nCount;				/* Frame count */
+	rtp_frame_t*		arFrame[RTP_FRAME_MAGAZINE_SIZE];
+} rtp_frame_magazine_t;
+
+/*
+ * Per-thread magazines, accessed by the owner thread only
+ */
+typedef struct
+{
+	rtp_frame_magazine_t*	pLoaded;		/* Current magazine */
+	rtp_frame_magazine_t*	pPrevious;		/* Previous magazine, full or empty */
+	uint64_t				nHit;			/* DBG: Frames taken from the magazines */
+	uint64_t				__pad[5];		/* Cache line padding */
+} rtp_frame_thread_t;
+
+/*
+ * Frame slab header
+ */
+typedef struct rtp_frame_slab
+{
+	struct rtp_frame_slab*	pNext;			/* Next slab of the cache */
+	boolean_t				bHuge;			/* TRUE: mapped by hugepages */
+} rtp_frame_slab_t;
 
 class CRtpFrameCache
 {
 	private:
-		queue_head_t		m_queue;			/* Available free RTP frames */
-		int					m_nLength;			/* Available frame count */
-		const int 			m_nMaxLength;		/* Maximum allocated frames */
-		mutable CMutex		m_lock;				/* Access synchronisation */
+		queue_head_t		m_queue;			/* Shared free RTP frames */
+		int					m_nLength;			/* Shared free frame count */
+		const int 			m_nMaxLength;		/* Preallocated frames */
+		mutable CMutex		m_lock;				/* Shared list and slabs lock */
+
+		rtp_frame_magazine_t*	m_arMagazine;	/* All magazines */
+		size_t				m_nMagazines;		/* Magazine count */
+		volatile uint64_t	m_nFullHead;		/* Depot full magazines, tag:index */
+		volatile uint64_t	m_nEmptyHead;		/* Depot empty magazines, tag:index */
+		rtp_frame_thread_t	m_arThread[RTP_FRAME_CACHE_THREADS];
+
+		rtp_frame_slab_t*	m_pSlab;			/* Slab list, the first one is current */
+		size_t				m_nSlabFree;		/* Free frames in the current slab */
+		uint8_t*			m_pSlabNext;		/* Next free frame in the current slab */
+		int					m_nSlabs;			/* DBG: Slab count */
+		int					m_nHugeSlabs;		/* DBG: Hugepage slab count */
+		int					m_nFrames;			/* DBG: Carved frame count */
 
-		uint32_t			m_hitCount;			/* DBG: Reused frames */
+		uint32_t			m_hitCount;			/* DBG: Reused frames from the shared list */
 		uint32_t			m_misCount;			/* DBG: Allocated frames */
 
 	public:
 		CRtpFrameCache(int nMaxLength = RTP_FRAME_CACHE_LIMIT);
 		~CRtpFrameCache();
 
-		void clear() {
-			CAutoLock	locker(m_lock);
-			queueFree(m_nLength);
+		void clear();
+
+		rtp_frame_t* get() {
+			rtp_frame_t*	pFrame;
+			return getN(&pFrame, 1) != 0 ? pFrame : RTP_FRAME_NULL;
+		}
+		void put(rtp_frame_t* pFrame) {
+			if ( pFrame != RTP_FRAME_NULL )  {
+				putN(&pFrame, 1);
+			}
 		}
 
-		rtp_frame_t* get();
-		void put(rtp_frame_t* pFrame);
+		size_t getN(rtp_frame_t** arFrame, size_t count);
+		void putN(rtp_frame_t* const* arFrame, size_t count);
 
 		void dump(const char* strPref = "") const;
 
 	private:
-		void queueFree(int count);
+		rtp_frame_thread_t* getThread();
+		uint32_t depotPop(volatile uint64_t* pHead);
+		void depotPush(volatile uint64_t* pHead, rtp_frame_magazine_t* pMagazine);
 
+		rtp_frame_t* allocFrame();
+		boolean_t allocSlab();
 };
 
 #endif /* __NET_MEDIA_RTP_FRAME_CACHE_H_INCLUDED__ */
@@ -0,0 +1,100 @@
+/*
+ *	Carbon/Network MultiMedia Streaming Module
+ *	RTP playout node ring and sink handoff queue
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 22:58:12
+ *		Initial revision.
+ */
+
+#include "net_media/rtp_playout_buffer.h"
+#include "net_media/rtp_node_ring.h"
+
+/*
+ * Find the position of the first node with the timestamp not less
+ * than the given one
+ *
+ * 		rtpRealTimestamp		extended RTP timestamp
+ *
+ * Return: position from the oldest node, m_nCount if all nodes are older
+ */
+size_t CRtpNodeRing::lowerBound(uint64_t rtpRealTimestamp) const
+{
+	size_t	lo = 0, hi = m_nCount, mid;
+
+	while ( lo < hi )  {
+		mid = (lo+hi)/2;
+		if ( at(mid)->getTimestamp() < rtpRealTimestamp )  {
+			lo = mid+1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/*
+ * Find a node with specified extended RTP timestamp
+ *
+ * 		rtpRealTimestamp		timestamp of the node to find
+ *
+ * Return: node pointer or 0
+ */
+CRtpPlayoutNode* CRtpNodeRing::find(uint64_t rtpRealTimestamp) const
+{
+	CRtpPlayoutNode*	pNode;
+	size_t				index;
+
+	if ( m_nCount == 0 )  {
+		return 0;
+	}
+
+	/* In order stream: a frame of the newest node or of a new node */
+	pNode = back();
+	if ( pNode->getTimestamp() <= rtpRealTimestamp )  {
+		return pNode->getTimestamp() == rtpRealTimestamp ? pNode : 0;
+	}
+
+	index = lowerBound(rtpRealTimestamp);
+	pNode = at(index);
+
+	return pNode->getTimestamp() == rtpRealTimestamp ? pNode : 0;
+}
+
+/*
+ * Insert a node in the timestamp order
+ *
+ * 		pNode		node to insert (the timestamp is not in the ring)
+ *
+ * Return: FALSE if the ring is full
+ */
+boolean_t CRtpNodeRing::insert(CRtpPlayoutNode* pNode)
+{
+	uint64_t	rtpRealTimestamp = pNode->getTimestamp();
+	size_t		index, i;
+
+	if ( full() )  {
+		return FALSE;
+	}
+
+	index = m_nCount;
+	if ( m_nCount > 0 && back()->getTimestamp() > rtpRealTimestamp )  {
+		/* Reordered frame, shift the newer nodes */
+		index = lowerBound(rtpRealTimestamp);
+		for(i=m_nCount; i>index; i--)  {
+			m_arNode[(m_nHead+i)&(RTP_NODE_RING_SIZE-1)] = at(i-1);
+		}
+	}
+
+	m_arNode[(m_nHead+index)&(RTP_NODE_RING_SIZE-1)] = pNode;
+	m_nCount++;
+
+	return TRUE;
+}
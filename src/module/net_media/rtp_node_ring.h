@@ -0,0 +1,133 @@
+/*
+ *	Carbon/Network MultiMedia Streaming Module
+ *	RTP playout node ring and sink handoff queue
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *	Revision history:
+ *
+ *	Revision 1.0, 17.10.2026 22:58:12
+ *		Initial revision.
+ */
+/*
+ * Purpose:
+ * 		CRtpNodeRing keeps the pending playout nodes ordered by the
+ * 		extended RTP timestamp in a fixed array. The arriving frames
+ * 		belong to the newest node in the common case, so the lookup
+ * 		and the insertion check the newest node first and fall back
+ * 		to the binary search within the reorder window (the ring size).
+ *
+ * 		CRtpNodeQueue passes the completed nodes from the playout
+ * 		buffer thread (the only producer) to the sink thread (the only
+ * 		consumer) without locking.
+ */
+
+#ifndef __NET_MEDIA_RTP_NODE_RING_H_INCLUDED__
+#define __NET_MEDIA_RTP_NODE_RING_H_INCLUDED__
+
+#include "shell/types.h"
+
+#define RTP_NODE_RING_SIZE			64			/* Pending playout nodes (power of 2) */
+#define RTP_NODE_QUEUE_SIZE			256			/* Completed nodes to the sink (power of 2) */
+
+class CRtpPlayoutNode;
+
+/*
+ * Playout nodes in the extended RTP timestamp order
+ */
+class CRtpNodeRing
+{
+	private:
+		CRtpPlayoutNode*	m_arNode[RTP_NODE_RING_SIZE];
+		size_t				m_nHead;			/* Oldest node index */
+		size_t				m_nCount;			/* Node count */
+
+	public:
+		CRtpNodeRing() : m_nHead(0), m_nCount(0) {}
+		~CRtpNodeRing() {}
+
+	public:
+		size_t size() const { return m_nCount; }
+		boolean_t empty() const { return m_nCount == 0; }
+		boolean_t full() const { return m_nCount == RTP_NODE_RING_SIZE; }
+
+		/* Node by the position, 0 is the oldest one */
+		CRtpPlayoutNode* at(size_t index) const {
+			return m_arNode[(m_nHead+index)&(RTP_NODE_RING_SIZE-1)];
+		}
+		CRtpPlayoutNode* front() const { return at(0); }
+		CRtpPlayoutNode* back() const { return at(m_nCount-1); }
+
+		void popFront() {
+			m_nHead = (m_nHead+1)&(RTP_NODE_RING_SIZE-1);
+			m_nCount--;
+		}
+
+		CRtpPlayoutNode* find(uint64_t rtpRealTimestamp) const;
+		boolean_t insert(CRtpPlayoutNode* pNode);
+
+	private:
+		size_t lowerBound(uint64_t rtpRealTimestamp) const;
+};
+
+/*
+ * Single producer/single consumer completed node queue
+ */
+class CRtpNodeQueue
+{
+	private:
+		CRtpPlayoutNode*	m_arNode[RTP_NODE_QUEUE_SIZE];
+		size_t				m_nHead;			/* Next node to get, written by the consumer */
+		uint8_t				__pad[56];			/* Cache line padding */
+		size_t				m_nTail;			/* Next free slot, written by the producer */
+
+	public:
+		CRtpNodeQueue() : m_nHead(0), m_nTail(0) {}
+		~CRtpNodeQueue() {}
+
+	public:
+		size_t size() const {
+			return __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE) -
+					__atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE);
+		}
+		boolean_t empty() const { return size() == 0; }
+
+		/*
+		 * Append a node (producer thread)
+		 *
+		 * Return: FALSE if the queue is full
+		 */
+		boolean_t push(CRtpPlayoutNode* pNode) {
+			size_t	tail = m_nTail;
+
+			if ( (tail-__atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE)) >= RTP_NODE_QUEUE_SIZE )  {
+				return FALSE;
+			}
+
+			m_arNode[tail&(RTP_NODE_QUEUE_SIZE-1)] = pNode;
+			__atomic_store_n(&m_nTail, tail+1, __ATOMIC_RELEASE);
+			return TRUE;
+		}
+
+		/*
+		 * Remove the oldest node (consumer thread)
+		 *
+		 * Return: node or 0 if the queue is empty
+		 */
+		CRtpPlayoutNode* pop() {
+			size_t				head = m_nHead;
+			CRtpPlayoutNode*	pNode;
+
+			if ( head == __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE) )  {
+				return 0;
+			}
+
+			pNode = m_arNode[head&(RTP_NODE_QUEUE_SIZE-1)];
+			__atomic_store_n(&m_nHead, head+1, __ATOMIC_RELEASE);
+			return pNode;
+		}
+};
+
+#endif /* __NET_MEDIA_RTP_NODE_RING_H_INCLUDED__ */
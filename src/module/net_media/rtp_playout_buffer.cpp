@@ -10,6 +10,10 @@
  *
  *	Revision 1.0, 14.10.2016 17:42:00
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 23:20:41
+ *		Pending nodes are kept in the timestamp ordered ring,
+ *		the thread is stopped before the final flush.
  */
 
 #include "net_media/rtp_frame_cache.h"
@@ -238,10 +242,11 @@ CRtpPlayoutBuffer::CRtpPlayoutBuffer(int nProfile, int nFps, int nClockRate,
 	m_nFrameDropped(ZERO_COUNTER),
 	m_nFrameLate(ZERO_COUNTER),
 	m_nNodeDropped(ZERO_COUNTER),
-	m_nNodeMaxCount(ZERO_COUNTER)
+	m_nNodeMaxCount(ZERO_COUNTER),
+	m_nNodeOverflow(ZERO_COUNTER)
 {
 	m_pInputQueue = new CRtpInputQueue(nMaxInputQueue);
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_bDone, FALSE);
 
 	shell_assert_ex(nMaxDelay >= 0 && nMaxDelay <= (m_nFps*2), "nMaxDelay: %d", nMaxDelay);
 }
@@ -263,8 +268,8 @@ void CRtpPlayoutBuffer::clear()
 
 	CAutoLock	locker(m_cond);
 	while ( !m_arNode.empty() ) {
-		pNode = *m_arNode.begin();
-		m_arNode.pop_front();
+		pNode = m_arNode.front();
+		m_arNode.popFront();
 		pNode->release();
 	}
 }
@@ -284,12 +289,12 @@ void CRtpPlayoutBuffer::wakeup()
 
 hr_time_t CRtpPlayoutBuffer::getNextWakeupTime() const
 {
-	std::list<CRtpPlayoutNode*>::const_iterator		it;
 	hr_time_t	hrNextTime = hr_time_now()+HR_8SEC;
+	size_t		i;
 
-	for(it=m_arNode.begin(); it != m_arNode.end(); it++) {
-		if ( (*it)->getPlayoutTime() < hrNextTime ) {
-			hrNextTime = (*it)->getPlayoutTime();
+	for(i=0; i<m_arNode.size(); i++) {
+		if ( m_arNode.at(i)->getPlayoutTime() < hrNextTime ) {
+			hrNextTime = m_arNode.at(i)->getPlayoutTime();
 		}
 	}
 
@@ -305,42 +310,23 @@ hr_time_t CRtpPlayoutBuffer::getNextWakeupTime() const
  */
 CRtpPlayoutNode* CRtpPlayoutBuffer::findNode(uint64_t rtpRealTimestamp) const
 {
-	CRtpPlayoutNode*	pNode = 0;
-	std::list<CRtpPlayoutNode*>::const_iterator		it;
-
-	for(it=m_arNode.begin(); it != m_arNode.end(); it++)  {
-		if ( (*it)->getTimestamp() == rtpRealTimestamp )  {
-			pNode = *it;
-			break;
-		}
-	}
-
-	return pNode;
+	return m_arNode.find(rtpRealTimestamp);
 }
 
 /*
- * Insert new node to the list in timestamp order
+ * Insert new node to the ring in timestamp order
  *
  * 		pNode		new created node
+ *
+ * Note: the ring must have a free slot
  */
 void CRtpPlayoutBuffer::insertNode(CRtpPlayoutNode* pNode)
 {
-	std::list<CRtpPlayoutNode*>::reverse_iterator	it;
-	uint64_t	nodeRtpTimestamp = pNode->getTimestamp();
-	boolean_t	bInserted = FALSE;
-
-	for(it=m_arNode.rbegin(); it != m_arNode.rend(); it++) {
-		if ( nodeRtpTimestamp > (*it)->getTimestamp() )  {
-			std::list<CRtpPlayoutNode*>::iterator 	itn = it.base();
-			m_arNode.insert(itn, pNode);
-			bInserted = TRUE;
-			break;
-		}
-	}
+	boolean_t	bInserted;
 
-	if ( !bInserted )  {
-		m_arNode.push_back(pNode);
-	}
+	bInserted = m_arNode.insert(pNode);
+	shell_assert(bInserted);
+	shell_unused(bInserted);
 
 	if ( (int)m_arNode.size() > counter_get(m_nNodeMaxCount) ) {
 		counter_inc(m_nNodeMaxCount);
@@ -449,6 +435,22 @@ void CRtpPlayoutBuffer::getInputFrames()
 			nresult = pNode->insertFrame(pFrame);
 		}
 		else {
+			if ( m_arNode.full() )  {
+				/* Reorder window overflow, drop the oldest node or the frame */
+				pNode = m_arNode.front();
+				if ( rtpRealTimestamp < pNode->getTimestamp() )  {
+					pFrame->pOwner->put(pFrame);
+					counter_inc(m_nFrameLate);
+					continue;
+				}
+
+				m_lastPlayoutTimestamp = pNode->getTimestamp();
+				m_arNode.popFront();
+				pNode->release();
+				counter_inc(m_nNodeDropped);
+				counter_inc(m_nNodeOverflow);
+			}
+
 			pNode = createNode(pFrame, rtpRealTimestamp);
 			if ( pNode )  {
 				insertNode(pNode);
@@ -481,20 +483,19 @@ void CRtpPlayoutBuffer::getInputFrames()
 
 void CRtpPlayoutBuffer::playout()
 {
-	std::list<CRtpPlayoutNode*>::iterator	it;
 	CRtpPlayoutNode*	pNode;
 	hr_time_t			hrNow = hr_time_now();
 	int 				nDelayCount;
 
-	while ( (it=m_arNode.begin()) != m_arNode.end() )  {
-		if ( (*it)->getPlayoutTime() > hrNow )  {
+	while ( !m_arNode.empty() )  {
+		pNode = m_arNode.front();
+		if ( pNode->getPlayoutTime() > hrNow )  {
 			break;
 		}
 
-		pNode = *it;
 		if ( pNode->isReady() )  {
 			m_lastPlayoutTimestamp = pNode->getTimestamp();
-			it = m_arNode.erase(it);
+			m_arNode.popFront();
 			m_pSink->put(pNode);
 			pNode->release();
 			continue;
@@ -512,46 +513,20 @@ void CRtpPlayoutBuffer::playout()
 			//log_debug(L_RTP, "[rtp_playout(%s)] -- drop node, invalid or timeout (%d ms) --\n",
 			//		  	getName(), HR_TIME_TO_MILLISECONDS(hrTime));
 			m_lastPlayoutTimestamp = pNode->getTimestamp();
-			it = m_arNode.erase(it);
+			m_arNode.popFront();
 			pNode->release();
 			counter_inc(m_nNodeDropped);
 		}
 	}
-
-#if 0
-	it=m_arNode.begin();
-	while ( it != m_arNode.end() )  {
-		if ( (*it)->getPlayoutTime() < hrNow )  {
-			pNode = *it;
-			it = m_arNode.erase(it);
-
-			m_lastPlayoutTimestamp = pNode->getTimestamp();
-
-			if ( pNode->completeNode() )  {
-				/* Pass completed node to the sink */
-				m_pSink->put(pNode);
-				pNode->release();
-			}
-			else {
-				//log_debug(L_RTP, "-- DROPPED NODE PLAYOUT --\n");
-				pNode->release();
-				counter_inc(m_nNodeDropped);
-			}
-		}
-		else {
-			it++;
-		}
-	}
-#endif
 }
 
 void* CRtpPlayoutBuffer::threadProc(CThread* pThread, void* pData)
 {
-	while ( atomic_get(&m_bDone) == FALSE ) {
+	while ( sh_atomic_get(&m_bDone) == FALSE ) {
 		getInputFrames();
 		playout();
 		m_cond.lock();
-		if ( m_pInputQueue->getLength() == 0 && atomic_get(&m_bDone) == FALSE ) {
+		if ( m_pInputQueue->getLength() == 0 && sh_atomic_get(&m_bDone) == FALSE ) {
 			m_cond.waitTimed(getNextWakeupTime());
 		}
 		m_cond.unlock();
@@ -575,7 +550,7 @@ result_t CRtpPlayoutBuffer::init(CVideoSink* pSink)
 	shell_assert(pSink);
 
 	m_pSink = pSink;
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_bDone, FALSE);
 	m_rtpSourceInited = FALSE;
 	m_lastPlayoutTimestamp = 0;
 
@@ -593,15 +568,16 @@ result_t CRtpPlayoutBuffer::init(CVideoSink* pSink)
  */
 void CRtpPlayoutBuffer::terminate()
 {
-	flush();
-	clear();
-
 	m_cond.lock();
-	atomic_set(&m_bDone, TRUE);
+	sh_atomic_set(&m_bDone, TRUE);
 	m_cond.wakeup();
 	m_cond.unlock();
 	CThread::stop();
 
+	/* The sink handoff queue has a single producer, flush after the thread stop */
+	flush();
+	clear();
+
 	m_pSink = 0;
 }
 
@@ -611,18 +587,18 @@ void CRtpPlayoutBuffer::terminate()
 
 int CRtpPlayoutBuffer::validateNodeOrder() const
 {
-	std::list<CRtpPlayoutNode*>::const_iterator	it;
 	int			nInvalid = 0;
 	uint64_t	timestamp = 0;
+	size_t		i;
 
-	for(it=m_arNode.begin(); it != m_arNode.end(); it++) {
-		if ( it != m_arNode.begin() ) {
-			if ( timestamp > (*it)->getTimestamp() ) {
+	for(i=0; i<m_arNode.size(); i++) {
+		if ( i != 0 ) {
+			if ( timestamp > m_arNode.at(i)->getTimestamp() ) {
 				nInvalid++;
 			}
 		}
 		else {
-			timestamp = (*it)->getTimestamp();
+			timestamp = m_arNode.at(i)->getTimestamp();
 		}
 	}
 
@@ -631,11 +607,11 @@ int CRtpPlayoutBuffer::validateNodeOrder() const
 
 void CRtpPlayoutBuffer::dumpNodes() const
 {
-	std::list<CRtpPlayoutNode*>::const_iterator	it;
-	int 		n, nInvalidOrder;
+	size_t		i;
+	int 		nInvalidOrder;
 
-	for(n=0, it=m_arNode.begin(); it != m_arNode.end(); it++, n++) {
-		(*it)->dump("   ");
+	for(i=0; i<m_arNode.size(); i++) {
+		m_arNode.at(i)->dump("   ");
 	}
 
 	nInvalidOrder = validateNodeOrder();
@@ -652,9 +628,10 @@ void CRtpPlayoutBuffer::dump(const char* strPref) const
 
 	nodeCount = m_arNode.size();
 
-	log_dump("  > %sRTP Playout Buffer: name %s, clock rate: %d, nodes: %u current, %u max, %u dropped\n",
+	log_dump("  > %sRTP Playout Buffer: name %s, clock rate: %d, nodes: %u current, %u max, %u dropped, %u overflow\n",
 			 strPref, getName(), m_nClockRate, nodeCount,
-			 counter_get(m_nNodeMaxCount), counter_get(m_nNodeDropped));
+			 counter_get(m_nNodeMaxCount), counter_get(m_nNodeDropped),
+			 counter_get(m_nNodeOverflow));
 
 	log_dump("    frames: %d, %u dropped, %u late\n",
 			counter_get(m_nFrameCount), counter_get(m_nFrameDropped),
@@ -10,13 +10,14 @@
  *
  *	Revision 1.0, 14.10.2016 17:39:38
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 23:20:41
+ *		Pending nodes are kept in the timestamp ordered ring.
  */
 
 #ifndef __NET_MEDIA_RTP_PLAYOUT_BUFFER_H_INCLUDED__
 #define __NET_MEDIA_RTP_PLAYOUT_BUFFER_H_INCLUDED__
 
-#include <list>
-
 #include "shell/queue.h"
 #include "shell/counter.h"
 
@@ -25,6 +26,7 @@
 
 #include "net_media/rtp.h"
 #include "net_media/media_frame.h"
+#include "net_media/rtp_node_ring.h"
 
 class CRtpInputQueue;
 class CVideoSink;
@@ -81,7 +83,7 @@ class CRtpPlayoutBuffer : public CThread
 		CRtpInputQueue*		m_pInputQueue;			/* Source flame queue */
 		CVideoSink*			m_pSink;				/* Post processor */
 
-		std::list<CRtpPlayoutNode*>		m_arNode;	/* Node list */
+		CRtpNodeRing		m_arNode;				/* Pending nodes, timestamp ordered */
 		CCondition			m_cond;
 		atomic_t			m_bDone;				/* Process stopped? */
 
@@ -103,6 +105,7 @@ class CRtpPlayoutBuffer : public CThread
 		counter_t			m_nFrameLate;			/* DBG: Frame late (dropped) */
 		counter_t			m_nNodeDropped;			/* DBG: Node dropped count */
 		counter_t			m_nNodeMaxCount;		/* DBG: Max nodes in queue */
+		counter_t			m_nNodeOverflow;		/* DBG: Nodes dropped by the ring overflow */
 
 	public:
 		CRtpPlayoutBuffer(int nProfile, int nFps, int nClockRate, int nMaxInputQueue,
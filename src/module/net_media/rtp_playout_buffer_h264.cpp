@@ -10,6 +10,10 @@
  *
  *	Revision 1.0, 17.10.2016 13:34:56
  *		Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 00:31:15
+ *		Access unit is assembled as a fragment list pointing to the
+ *		RTP frame payloads, contiguous image is built on demand.
  */
 
 #include <new>
@@ -27,13 +31,19 @@ CRtpPlayoutNodeH264::CRtpPlayoutNodeH264(uint64_t rtpRealTimestamp, hr_time_t hr
 	CRtpPlayoutNode(rtpRealTimestamp, hrPlayoutTime, pParent),
 	m_flags(0),
 	m_pData(NULL),
-	m_nSize(0)
+	m_nSize(0),
+	m_pIovMem(NULL),
+	m_arIov(NULL),
+	m_nIov(0),
+	m_arNal(NULL),
+	m_nNal(0)
 {
 }
 
 CRtpPlayoutNodeH264::~CRtpPlayoutNodeH264()
 {
 	SAFE_FREE(m_pData);
+	SAFE_FREE(m_pIovMem);
 }
 
 /*
@@ -338,40 +348,37 @@ boolean_t xdump_nal_check(const uint8_t* pData, size_t size, uint32_t flags)
 */
 
 
+static const uint8_t g_nalSeparator[H264_NAL_SEPARATOR_SIZE] = { 0, 0, 0, 1 };
+
 /*
- * Build a compressed H264 image
+ * Build a compressed H264 image fragment list, the frame payloads
+ * are referenced, not copied
  *
- * Return: ESUCCESS, ENOMEM
+ * Return: ESUCCESS, ENOMEM, EINVAL
  */
 result_t CRtpPlayoutNodeH264::buildCompressed()
 {
 	const rtp_frame_t*		elt;
 	CRtpPlayoutBufferH264*	pParent = (CRtpPlayoutBufferH264*)m_pParent;
-	size_t					length, offset;
-	boolean_t				bNeedSeparator = FALSE;
+	size_t					nFrames, nSPsize, length;
+	uint8_t*				pPrefix;
+	boolean_t				bInFua = FALSE;
 
 	shell_assert(m_nLength > 0);
-	shell_assert(m_pData == 0);
+	shell_assert(m_pIovMem == 0);
 	shell_assert(m_nSize == 0);
 
 	/*
-	 * Calculate an image length
+	 * Check the payload types
 	 */
-	length = 0;
+	nFrames = 0;
 
 	queue_iterate(&m_queue, elt, const rtp_frame_t*, link) {
 		size_t 				headLen = rtp_frame_head_length(elt);
-		size_t				payloadLen = elt->length - headLen;
 		const uint8_t*		pPayload = ((const uint8_t*)&elt->head) + headLen;
 		const h264_nal_t*	pNal = (const h264_nal_t*)pPayload;
 
-		length += 4;		/* nal separator: 00 00 00 01 */
-
 		switch ( pNal->h.nal_unit_type )  {
-			case H264_NAL_TYPE_FU_A:
-				length += sizeof(h264_nal_head_t) + (payloadLen - sizeof(rtp_h264_payload_fua_t));
-				break;
-
 			case H264_NAL_TYPE_STAP_A:
 			case H264_NAL_TYPE_STAP_B:
 			case H264_NAL_TYPE_MTAP16:
@@ -383,42 +390,66 @@ result_t CRtpPlayoutNodeH264::buildCompressed()
 				return EINVAL;
 
 			default:
-				length += payloadLen;
 				break;
 		}
-	}
 
-	if ( (m_flags&flagParams) == 0 ) {
-		/*
-		 * Write SPS/PPS
-		 */
-		length += pParent->getSPsize();
+		nFrames++;
 	}
 
+	/* SPS/PPS are copied, they may be updated by the following nodes */
+	nSPsize = (m_flags&flagParams) == 0 ? pParent->getSPsize() : 0;
+
 	/*
-	 * Allocate buffer
+	 * Allocate fragments: up to 2 per frame and SPS/PPS,
+	 * NAL units: up to 1 per frame and SPS/PPS,
+	 * prefixes: separator and NAL header per FU-A start and SPS/PPS data
 	 */
-	length = ALIGN(length, 64);
-	m_pData = (uint8_t*)memAlloc(length);
-	if ( !m_pData )  {
+	length = sizeof(struct iovec)*(nFrames*2+2) + sizeof(h264_nal_iov_t)*(nFrames+2) +
+			(H264_NAL_SEPARATOR_SIZE+sizeof(h264_nal_head_t))*nFrames + nSPsize;
+
+	m_pIovMem = memAlloc(length);
+	if ( !m_pIovMem )  {
 		log_error(L_RTP, "[rtp_playout_node_h264(%s)] out of memory %d bytes\n", getName(), length);
 		return ENOMEM;
 	}
 
-	/*
-	 * Copy H264 data
-	 */
-	offset = 0;
+	m_arIov = (struct iovec*)m_pIovMem;
+	m_arNal = (h264_nal_iov_t*)(m_arIov + nFrames*2+2);
+	pPrefix = (uint8_t*)(m_arNal + nFrames+2);
+	m_nIov = 0;
+	m_nNal = 0;
+
+#define APPEND_NAL(__type)		\
+	do { \
+		h264_nal_iov_t*	__pNal = &m_arNal[m_nNal++]; \
+		__pNal->nIov = (uint32_t)m_nIov; __pNal->nCount = 0; \
+		__pNal->nSize = 0; __pNal->nType = (uint8_t)(__type); \
+	} while(0)
+
+#define APPEND_IOV(__p, __len)	\
+	do { \
+		m_arIov[m_nIov].iov_base = (void*)(__p); \
+		m_arIov[m_nIov].iov_len = (__len); \
+		m_nIov++; \
+		m_arNal[m_nNal-1].nCount++; \
+		m_arNal[m_nNal-1].nSize += (uint32_t)(__len); \
+		m_nSize += (__len); \
+	} while(0)
 
 	/* First write SPS/PPS */
-	if ( (m_flags&flagParams) == 0 ) {
-		offset += pParent->getSPdata(m_pData+offset);
-		bNeedSeparator = TRUE;
-
-		/*if ( offset != 33 ) {
-			log_debug(L_RTP, "[rtp_playout_node_h264(%s)] !!!!!!!!!!!!!!!!!! writing SPS/PPS %d bytes\n", getName(), offset);
-			log_dump_bin(m_pData, offset, "[rtp_playout_node_h264(%s)] !!! PPS Data: ");
-		}*/
+	if ( nSPsize > 0 ) {
+		pParent->getSPdata(pPrefix);
+
+		if ( pParent->getSpsSize() > 0 )  {
+			APPEND_NAL(H264_NAL_TYPE_SEQ_PARAM);
+			APPEND_IOV(pPrefix, H264_NAL_SEPARATOR_SIZE+pParent->getSpsSize());
+			pPrefix += H264_NAL_SEPARATOR_SIZE+pParent->getSpsSize();
+		}
+		if ( pParent->getPpsSize() > 0 )  {
+			APPEND_NAL(H264_NAL_TYPE_PIC_PARAM);
+			APPEND_IOV(pPrefix, H264_NAL_SEPARATOR_SIZE+pParent->getPpsSize());
+			pPrefix += H264_NAL_SEPARATOR_SIZE+pParent->getPpsSize();
+		}
 	}
 
 	queue_iterate(&m_queue, elt, const rtp_frame_t*, link) {
@@ -432,59 +463,40 @@ result_t CRtpPlayoutNodeH264::buildCompressed()
 		switch ( pNal->h.nal_unit_type )  {
 			case H264_NAL_TYPE_FU_A:
 				pFua = (const rtp_h264_payload_fua_t*)pNal;
-				//log_debug(L_RTP, "build FU_A, offset %d, start: %d\n", offset, pFua->header.start);
 
 				if ( pFua->header.start )  {
-					WRITE_NAL_SEPARATOR(m_pData+offset, offset);
-
 					nalHead.nal_unit_type = pFua->header.type;
 					nalHead.nal_ref_idc = pFua->indicator.nal_ref_idc;
 					nalHead.forbidden_zero_bit = pFua->indicator.forbidden_zero_bit;
 
-					UNALIGNED_MEMCPY(m_pData+offset, &nalHead, sizeof(nalHead));
-					offset += sizeof(nalHead);
+					UNALIGNED_MEMCPY(pPrefix, g_nalSeparator, H264_NAL_SEPARATOR_SIZE);
+					UNALIGNED_MEMCPY(pPrefix+H264_NAL_SEPARATOR_SIZE, &nalHead, sizeof(nalHead));
+
+					APPEND_NAL(pFua->header.type);
+					APPEND_IOV(pPrefix, H264_NAL_SEPARATOR_SIZE+sizeof(nalHead));
+					pPrefix += H264_NAL_SEPARATOR_SIZE+sizeof(nalHead);
+					bInFua = TRUE;
 
 					/* Check for an IDR frame */
 					if ( nalHead.nal_unit_type == H264_NAL_TYPE_IDR_SLICE )  {
 						m_flags |= flagIdr;
 					}
-
-					/*if ( nalHead.nal_unit_type == H264_NAL_TYPE_PIC_PARAM )  {
-						size_t l = payloadLen-sizeof(rtp_h264_payload_fua_t);
-						if ( l != 4 )  {
-							log_debug(L_RTP, "[rtp_playout_node_h264(%s)] +++++++++++++ PPS len: %d\n",
-									  getName(), l);
-						}
-					}
-
-					if ( nalHead.nal_unit_type == H264_NAL_TYPE_SEQ_PARAM )  {
-						size_t l = payloadLen-sizeof(rtp_h264_payload_fua_t);
-						if ( l != 21 )  {
-							log_debug(L_RTP, "[rtp_playout_node_h264(%s)] +++++++++++++ SPS len: %d\n",
-									  getName(), l);
-						}
-					}*/
-
-					bNeedSeparator = FALSE;
 				}
 
-				if ( bNeedSeparator )  {
-					WRITE_NAL_SEPARATOR(m_pData+offset, offset);
-					bNeedSeparator = FALSE;
+				if ( !bInFua )  {
+					APPEND_NAL(pFua->header.type);
+					APPEND_IOV(g_nalSeparator, H264_NAL_SEPARATOR_SIZE);
+					bInFua = TRUE;
 				}
 
-				UNALIGNED_MEMCPY(m_pData+offset, &pFua->payload,
-								 payloadLen-sizeof(rtp_h264_payload_fua_t));
-				offset += payloadLen-sizeof(rtp_h264_payload_fua_t);
+				APPEND_IOV(&pFua->payload, payloadLen-sizeof(rtp_h264_payload_fua_t));
 				break;
 
 			default:
-				//log_debug(L_RTP, "build Sindle, offset %d\n", offset);
-				WRITE_NAL_SEPARATOR(m_pData+offset, offset);
-				bNeedSeparator = FALSE;
-
-				UNALIGNED_MEMCPY(m_pData+offset, pNal, payloadLen);
-				offset += payloadLen;
+				APPEND_NAL(pNal->h.nal_unit_type);
+				APPEND_IOV(g_nalSeparator, H264_NAL_SEPARATOR_SIZE);
+				APPEND_IOV(pNal, payloadLen);
+				bInFua = FALSE;
 
 				/* Check if a IDR frame */
 				if ( pNal->h.nal_unit_type == H264_NAL_TYPE_IDR_SLICE )  {
@@ -494,7 +506,8 @@ result_t CRtpPlayoutNodeH264::buildCompressed()
 		}
 	}
 
-	m_nSize = offset;
+#undef APPEND_IOV
+#undef APPEND_NAL
 
 	elt = (const rtp_frame_t*)queue_first(&m_queue);
 	m_hrPts = elt->hrArriveTime;
@@ -534,6 +547,54 @@ result_t CRtpPlayoutNodeH264::buildCompressed()
 	return ESUCCESS;
 }
 
+/*
+ * Get a contiguous compressed H264 image, the image is built
+ * by the first call
+ *
+ * Return: image data or NULL
+ */
+uint8_t* CRtpPlayoutNodeH264::getData()
+{
+	uint8_t*	pData;
+	size_t		i;
+
+	if ( m_pData == NULL && m_nSize > 0 )  {
+		pData = (uint8_t*)memAlloc(ALIGN(m_nSize, 64));
+		if ( !pData )  {
+			log_error(L_RTP, "[rtp_playout_node_h264(%s)] out of memory %d bytes\n",
+					  getName(), m_nSize);
+			return NULL;
+		}
+
+		m_pData = pData;
+		for(i=0; i<m_nIov; i++)  {
+			UNALIGNED_MEMCPY(pData, m_arIov[i].iov_base, m_arIov[i].iov_len);
+			pData += m_arIov[i].iov_len;
+		}
+	}
+
+	return m_pData;
+}
+
+/*
+ * Get a compressed H264 image fragments
+ *
+ * 		parVec		fragments [out]
+ * 		pCount		fragment count [out]
+ *
+ * Return: ESUCCESS, ENOSYS (node is not built)
+ */
+result_t CRtpPlayoutNodeH264::getIov(const struct iovec** parVec, size_t* pCount)
+{
+	if ( !isReady() )  {
+		return CRtpPlayoutNode::getIov(parVec, pCount);
+	}
+
+	*parVec = m_arIov;
+	*pCount = m_nIov;
+	return ESUCCESS;
+}
+
 
 /*******************************************************************************
  * Debugging support
@@ -636,7 +697,8 @@ void CRtpPlayoutNodeH264::dump(const char* strPref) const
 {
 	CRtpPlayoutNode::dump(strPref);
 
-	log_dump("%s>> Flags: %u, Completed: %d bytes\n", strPref, m_flags, m_nSize);
+	log_dump("%s>> Flags: %u, Completed: %d bytes, %u fragments, %u NAL units\n",
+			 strPref, m_flags, m_nSize, (unsigned)m_nIov, (unsigned)m_nNal);
 
 	dumpFrames(strPref);
 }
@@ -10,14 +10,34 @@
  *
  *	Revision 1.0, 17.10.2016 13:31:19
  *		Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 00:31:15
+ *		Access unit is assembled as a fragment list pointing to the
+ *		RTP frame payloads, contiguous image is built on demand.
  */
 
 #ifndef __NET_MEDIA_RTP_PLAYOUT_BUFFER_H264_H_INCLUDED__
 #define __NET_MEDIA_RTP_PLAYOUT_BUFFER_H264_H_INCLUDED__
 
+#include <sys/uio.h>
+
 #include "net_media/h264.h"
 #include "net_media/rtp_playout_buffer.h"
 
+#define H264_NAL_SEPARATOR_SIZE		4		/* Start code 00 00 00 01 */
+
+/*
+ * Access unit NAL unit, a range of the node fragments,
+ * the first fragment starts with the NAL separator
+ */
+typedef struct
+{
+	uint32_t		nIov;				/* First fragment index */
+	uint32_t		nCount;				/* Fragment count */
+	uint32_t		nSize;				/* NAL unit size including the separator, bytes */
+	uint8_t			nType;				/* NAL unit type, H264_NAL_TYPE_xxx */
+} h264_nal_iov_t;
+
 class CRtpPlayoutNodeH264 : public CRtpPlayoutNode
 {
 	enum {
@@ -29,9 +49,15 @@ class CRtpPlayoutNodeH264 : public CRtpPlayoutNode
 
 	protected:
 		int 			m_flags;		/* Various flags, flagXXX */
-		uint8_t*		m_pData;		/* Compressed H264 frame data or NULL */
+		uint8_t*		m_pData;		/* Contiguous H264 frame data or NULL (built on demand) */
 		size_t			m_nSize;		/* Compressed data size, bytes */
 
+		void*			m_pIovMem;		/* Fragment, NAL and prefix memory */
+		struct iovec*	m_arIov;		/* Compressed frame fragments */
+		size_t			m_nIov;			/* Fragment count */
+		h264_nal_iov_t*	m_arNal;		/* NAL units */
+		size_t			m_nNal;			/* NAL unit count */
+
 	public:
 		CRtpPlayoutNodeH264(uint64_t rtpRealTimestamp, hr_time_t hrPlayoutTime,
 							CRtpPlayoutBuffer* pParent);
@@ -41,10 +67,17 @@ class CRtpPlayoutNodeH264 : public CRtpPlayoutNode
 		virtual result_t insertFrame(rtp_frame_t* pFrame);
 		virtual boolean_t isReady() const { return (m_flags&flagReady) != 0; }
 
-		virtual uint8_t* getData() { return m_pData; }
+		virtual uint8_t* getData();
 		virtual size_t getSize() const { return m_nSize; }
+		virtual result_t getIov(const struct iovec** parVec, size_t* pCount);
 		virtual boolean_t isIdrFrame() const { return (m_flags&flagIdr) != 0; }
 
+		size_t getNalCount() const { return m_nNal; }
+		const h264_nal_iov_t* getNal(size_t index) const { return &m_arNal[index]; }
+		const struct iovec* getNalIov(const h264_nal_iov_t* pNal) const {
+			return &m_arIov[pNal->nIov];
+		}
+
 		virtual void dump(const char* strPref = "") const;
 		virtual void dumpFrames(const char* strMargin = "") const;
 		virtual void dumpFramePayload(int index, const rtp_frame_t* pFrame, const char* strMargin) const;
@@ -80,6 +113,8 @@ class CRtpPlayoutBufferH264 : public CRtpPlayoutBuffer
 		void setPps(void* pPps, size_t size);
 		size_t getSPdata(void* pBuffer) const;
 		size_t getSPsize() const;
+		size_t getSpsSize() const { return m_nSps; }
+		size_t getPpsSize() const { return m_nPps; }
 
 		void incrUnsupportedFrame() { counter_inc(m_nUnsupportedFrames); }
 
@@ -10,8 +10,19 @@
  *
  *	Revision 1.0, 12.10.2016 10:41:52
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 19:12:05
+ *		Added CRtpReceiverLoop, batched receiving by recvmmsg().
+ *
+ *	Revision 1.2, 18.10.2026 11:41:08
+ *		CRtpReceiverLoop discards datagrams instead of sleeping
+ *		when the frame cache is exhausted.
  */
 
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
 #include "carbon/utils.h"
 
 #include "net_media/rtp_frame_cache.h"
@@ -19,6 +30,7 @@
 #include "net_media/rtp_receiver_pool.h"
 
 #define RTP_RECEIVE_TIMEOUT			HR_16SEC
+#define RTP_RECEIVER_SLOT_EVENT		UINT32_MAX		/* Epoll data of the wakeup eventfd */
 
 /*******************************************************************************
  * CRtpReceiver class
@@ -27,6 +39,8 @@
 CRtpReceiver::CRtpReceiver(const CNetAddr& netAddr, CRtpReceiverPool* pParent) :
 	CThread(HR_0, HR_4SEC),
 	m_pParent(pParent),
+	m_pLoop(0),
+	m_nSlot(-1),
 	m_netAddr(netAddr),
 
 	m_nLastSeq(0xffff),
@@ -41,7 +55,7 @@ CRtpReceiver::CRtpReceiver(const CNetAddr& netAddr, CRtpReceiverPool* pParent) :
 	_tsnprintf(strTmp, sizeof(strTmp), "%s-%s", pParent->getName(), m_netAddr.cs());
 	CThread::setName(strTmp);
 
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_bDone, FALSE);
 	m_arPlayoutBuffer.reserve(4);
 }
 
@@ -250,6 +264,42 @@ void CRtpReceiver::queueFrame(rtp_frame_t* pFrame)
 	counter_inc(m_nFrameDrop);
 }
 
+/*
+ * Process a received rtp frame: validate, track sequence numbers
+ * and put to the input queue
+ *
+ * 		pFrame		received RTP frame pointer (length and arrive time are set)
+ */
+void CRtpReceiver::processFrame(rtp_frame_t* pFrame)
+{
+	result_t	nresult;
+
+	nresult = validateFrame(pFrame);
+	if ( nresult == ESUCCESS )  {
+		uint16_t	seq = RTP_HEAD_SEQUENCE(pFrame->head.fields);
+
+		if ( m_nLastSeq != 0xffff )  {
+			m_nLastSeq++;
+			if ( seq != m_nLastSeq ) {
+				//log_error(L_RTP, "[rtp_recv(%s) *** WRONG SEQNUM %u => %u (%d) ****\n",
+				//		  	getName(), m_nLastSeq, seq, (int)(seq-m_nLastSeq));
+				counter_add(m_nFrameLost, (int)(seq-m_nLastSeq));
+				m_nLastSeq = seq;
+			}
+		}
+		else {
+			m_nLastSeq = seq;
+		}
+
+		queueFrame(pFrame);
+	}
+	else {
+		//log_error(L_RTP, "[rtp_recv(%s)] -- DROP INVALID FRAME --\n", getName());
+		pFrame->pOwner->put(pFrame);
+		counter_inc(m_nFrameErr);
+	}
+}
+
 void* CRtpReceiver::threadProc(CThread* pThread, void* pData)
 {
 	rtp_frame_t*	pFrame;
@@ -258,38 +308,15 @@ void* CRtpReceiver::threadProc(CThread* pThread, void* pData)
 
 	shell_assert(m_socket.isOpen());
 
-	while ( atomic_get(&m_bDone) == FALSE )  {
+	while ( sh_atomic_get(&m_bDone) == FALSE )  {
 		pFrame = m_pParent->getCacheFrame();
 		if ( pFrame != RTP_FRAME_NULL )  {
-			pFrame->length = sizeof(pFrame->head)+sizeof(pFrame->__buffer__);
+			pFrame->length = sizeof(pFrame->__buffer__);
 			nresult = m_socket.receive(&pFrame->head, &pFrame->length, 0,
 									   RTP_RECEIVE_TIMEOUT, &srcAddr);
 			if ( nresult == ESUCCESS )  {
 				pFrame->hrArriveTime = hr_time_now();
-				nresult = validateFrame(pFrame);
-				if ( nresult == ESUCCESS )  {
-					uint16_t	seq = RTP_HEAD_SEQUENCE(pFrame->head.fields);
-
-					if ( m_nLastSeq != 0xffff )  {
-						m_nLastSeq++;
-						if ( seq != m_nLastSeq ) {
-							//log_error(L_RTP, "[rtp_recv(%s) *** WRONG SEQNUM %u => %u (%d) ****\n",
-							//		  	getName(), m_nLastSeq, seq, (int)(seq-m_nLastSeq));
-							counter_add(m_nFrameLost, (int)(seq-m_nLastSeq));
-							m_nLastSeq = seq;
-						}
-					}
-					else {
-						m_nLastSeq = seq;
-					}
-
-					queueFrame(pFrame);
-				}
-				else {
-					//log_error(L_RTP, "[rtp_recv(%s)] -- DROP INVALID FRAME --\n", getName());
-					pFrame->pOwner->put(pFrame);
-					counter_inc(m_nFrameErr);
-				}
+				processFrame(pFrame);
 			}
 			else {
 				//log_error(L_RTP, "[rtp_recv(%s)] -- RECEIVE FAILED, result %d --\n", getName(), nresult);
@@ -312,18 +339,18 @@ void* CRtpReceiver::threadProc(CThread* pThread, void* pData)
 /*
  * Start receiving a RTP stream
  *
- * 		bindAddr		network address to receive
+ * 		pLoop			I/O loop to receive by, NULL - start own receiving thread
  *
  * Return: ESUCCESS, ...
  */
-result_t CRtpReceiver::init()
+result_t CRtpReceiver::init(CRtpReceiverLoop* pLoop)
 {
 	result_t	nresult;
 
 	shell_assert(!CThread::isRunning());
 	shell_assert(m_netAddr.isValid());
 
-	atomic_set(&m_bDone, FALSE);
+	sh_atomic_set(&m_bDone, FALSE);
 
 	log_debug(L_RTP, "[rtp_recv(%s)] receiving %s\n", getName(), m_netAddr.cs());
 
@@ -333,6 +360,17 @@ result_t CRtpReceiver::init()
 		return nresult;
 	}
 
+	if ( pLoop )  {
+		nresult = pLoop->insertReceiver(this);
+		if ( nresult == ESUCCESS )  {
+			m_pLoop = pLoop;
+		}
+		else {
+			m_socket.close();
+		}
+		return nresult;
+	}
+
 	nresult = CThread::start(THREAD_CALLBACK(CRtpReceiver::threadProc, this));
 	if ( nresult != ESUCCESS )  {
 		m_socket.close();
@@ -346,9 +384,15 @@ result_t CRtpReceiver::init()
  */
 void CRtpReceiver::terminate()
 {
-	atomic_set(&m_bDone, TRUE);
-	m_socket.breakerBreak();
-	CThread::stop();
+	sh_atomic_set(&m_bDone, TRUE);
+	if ( m_pLoop )  {
+		m_pLoop->removeReceiver(this);
+		m_pLoop = 0;
+	}
+	else {
+		m_socket.breakerBreak();
+		CThread::stop();
+	}
 	m_socket.close();
 
 #if DEBUG
@@ -371,33 +415,445 @@ void CRtpReceiver::dump(const char* strPref) const
 	CAutoLock	locker(m_lock);
 	size_t		count = m_arPlayoutBuffer.size();
 
-	log_dump("    %sReceiver: name %s, %u buffer(s), ip: %s, Frames: %d success, %d dropped, "
+	log_dump("    %sReceiver: name %s, %u buffer(s), ip: %s, %s, Frames: %d success, %d dropped, "
 			 "%d lost, %d invalid, %d mem failed\n",
-			 strPref, getName(), count, m_netAddr.cs(),
+			 strPref, getName(), count, m_netAddr.cs(), m_pLoop ? "loop" : "thread",
 			 counter_get(m_nFrameCount), counter_get(m_nFrameDrop),
 			 counter_get(m_nFrameLost),  counter_get(m_nFrameErr),
 			 counter_get(m_nFrameErrMem));
 }
 
+/*******************************************************************************
+ * CRtpReceiverLoop class
+ */
+
+CRtpReceiverLoop::CRtpReceiverLoop() :
+	m_pParent(0),
+	m_thread("rtp_recv_loop"),
+	m_hEpoll(-1),
+	m_hEvent(-1),
+	m_bDone(FALSE),
+	m_nReceivers(0),
+	m_nFrames(0)
+{
+	size_t	i;
+
+	_tbzero_object(m_arMsg);
+	for(i=0; i<RTP_RECEIVE_BATCH; i++)  {
+		m_arFrame[i] = RTP_FRAME_NULL;
+		m_arMsg[i].msg_hdr.msg_iov = &m_arIov[i];
+		m_arMsg[i].msg_hdr.msg_iovlen = 1;
+	}
+}
+
+CRtpReceiverLoop::~CRtpReceiverLoop()
+{
+	shell_assert(m_hEpoll < 0);
+	shell_assert(m_nReceivers == 0);
+	shell_assert(m_nFrames == 0);
+}
+
+/*
+ * Register a receiver socket in the loop
+ *
+ * 		pReceiver		receiver with the open socket
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRtpReceiverLoop::insertReceiver(CRtpReceiver* pReceiver)
+{
+	CAutoLock			locker(m_lock);
+	struct epoll_event	event;
+	size_t				slot, count = m_arReceiver.size();
+	result_t			nresult = ESUCCESS;
+
+	for(slot=0; slot<count; slot++)  {
+		if ( m_arReceiver[slot] == 0 )  {
+			break;
+		}
+	}
+
+	event.events = EPOLLIN;
+	event.data.u64 = 0;
+	event.data.u32 = (uint32_t)slot;
+	if ( ::epoll_ctl(m_hEpoll, EPOLL_CTL_ADD, pReceiver->m_socket.getHandle(), &event) == 0 )  {
+		if ( slot < count )  {
+			m_arReceiver[slot] = pReceiver;
+		}
+		else {
+			m_arReceiver.push_back(pReceiver);
+		}
+		pReceiver->m_nSlot = (int)slot;
+		m_nReceivers++;
+	}
+	else {
+		nresult = errno;
+		log_error(L_RTP, "[rtp_recv_loop(%s)] failed to add socket, result %d\n",
+				  m_thread.getName(), nresult);
+	}
+
+	return nresult;
+}
+
+/*
+ * Unregister a receiver, the receiver is not accessed
+ * by the I/O thread after return
+ *
+ * 		pReceiver		registered receiver
+ */
+void CRtpReceiverLoop::removeReceiver(CRtpReceiver* pReceiver)
+{
+	CAutoLock	locker(m_lock);
+	int			slot = pReceiver->m_nSlot;
+
+	shell_assert(slot >= 0 && (size_t)slot < m_arReceiver.size());
+	shell_assert(m_arReceiver[slot] == pReceiver);
+
+	::epoll_ctl(m_hEpoll, EPOLL_CTL_DEL, pReceiver->m_socket.getHandle(), NULL);
+	m_arReceiver[slot] = 0;
+	pReceiver->m_nSlot = -1;
+	m_nReceivers--;
+}
+
+/*
+ * Get free frames from the cache up to the batch size
+ *
+ * Return: TRUE if at least one frame is ready to receive to
+ */
+boolean_t CRtpReceiverLoop::fillFrames()
+{
+	size_t	i, count;
+
+	if ( m_nFrames < RTP_RECEIVE_BATCH )  {
+		count = m_pParent->getCacheFrames(&m_arFrame[m_nFrames], RTP_RECEIVE_BATCH-m_nFrames);
+		for(i=m_nFrames; i<m_nFrames+count; i++)  {
+			m_arIov[i].iov_base = &m_arFrame[i]->head;
+			m_arIov[i].iov_len = sizeof(m_arFrame[i]->__buffer__);
+		}
+		m_nFrames += count;
+	}
+
+	return m_nFrames > 0;
+}
+
+/*
+ * Discard the datagrams of a ready receiver socket, used when no free
+ * frames are available (the socket must be drained, otherwise epoll
+ * reports it again immediately)
+ *
+ * 		pReceiver		receiver to read
+ */
+void CRtpReceiverLoop::discard(CRtpReceiver* pReceiver)
+{
+	size_t	i, nRound = 0;
+	int		n;
+
+	for(i=0; i<RTP_RECEIVE_BATCH; i++)  {
+		m_arIov[i].iov_base = m_arScratch;
+		m_arIov[i].iov_len = sizeof(m_arScratch);
+	}
+
+	while ( nRound < RTP_RECEIVE_ROUNDS )  {
+		n = ::recvmmsg(pReceiver->m_socket.getHandle(), m_arMsg, RTP_RECEIVE_BATCH,
+					   MSG_DONTWAIT, NULL);
+		if ( n <= 0 )  {
+			if ( n < 0 && errno == EINTR )  {
+				continue;
+			}
+			break;
+		}
+
+		counter_add(pReceiver->m_nFrameErrMem, n);
+
+		if ( n < RTP_RECEIVE_BATCH )  {
+			/* Socket queue is empty */
+			break;
+		}
+
+		nRound++;
+	}
+}
+
+/*
+ * Drain a ready receiver socket
+ *
+ * 		pReceiver		receiver to read
+ */
+void CRtpReceiverLoop::receive(CRtpReceiver* pReceiver)
+{
+	rtp_frame_t*	pFrame;
+	hr_time_t		hrNow;
+	size_t			i, nRecv, nRound = 0;
+	int				n;
+
+	while ( nRound < RTP_RECEIVE_ROUNDS )  {
+		if ( !fillFrames() )  {
+			/* Loop lock is held, the other receivers must not wait */
+			discard(pReceiver);
+			break;
+		}
+
+		n = ::recvmmsg(pReceiver->m_socket.getHandle(), m_arMsg, (unsigned int)m_nFrames,
+					   MSG_DONTWAIT, NULL);
+		if ( n <= 0 )  {
+			if ( n < 0 && errno == EINTR )  {
+				continue;
+			}
+			break;
+		}
+
+		nRecv = (size_t)n;
+		hrNow = hr_time_now();
+		for(i=0; i<nRecv; i++)  {
+			pFrame = m_arFrame[i];
+			pFrame->length = m_arMsg[i].msg_len;
+			pFrame->hrArriveTime = hrNow;
+			pReceiver->processFrame(pFrame);
+		}
+
+		/* Move the unused frames to the beginning */
+		for(i=nRecv; i<m_nFrames; i++)  {
+			m_arFrame[i-nRecv] = m_arFrame[i];
+			m_arIov[i-nRecv].iov_base = m_arIov[i].iov_base;
+		}
+		m_nFrames -= nRecv;
+
+		if ( nRecv < RTP_RECEIVE_BATCH )  {
+			/* Socket queue is empty */
+			break;
+		}
+
+		nRound++;
+	}
+}
+
+/*
+ * I/O thread worker
+ */
+void* CRtpReceiverLoop::threadIo(CThread* pThread, void* pData)
+{
+	struct epoll_event	arEvent[RTP_RECEIVER_EVENTS_MAX];
+	uint64_t			value;
+	ssize_t				len;
+	uint32_t			slot;
+	int					i, count;
+
+	shell_unused(pData);
+	pThread->bootCompleted(ESUCCESS);
+
+	while ( !m_bDone )  {
+		count = ::epoll_wait(m_hEpoll, arEvent, RTP_RECEIVER_EVENTS_MAX, -1);
+		if ( count < 0 )  {
+			if ( errno != EINTR )  {
+				log_error(L_RTP, "[rtp_recv_loop(%s)] epoll_wait() failed, result %d\n",
+						  m_thread.getName(), errno);
+				hr_sleep(HR_100MSEC);
+			}
+			continue;
+		}
+
+		CAutoLock	locker(m_lock);
+
+		for(i=0; i<count; i++)  {
+			slot = arEvent[i].data.u32;
+			if ( slot != RTP_RECEIVER_SLOT_EVENT )  {
+				/* Slot may be freed or reused after the epoll_wait() */
+				if ( slot < m_arReceiver.size() && m_arReceiver[slot] != 0 )  {
+					receive(m_arReceiver[slot]);
+				}
+			}
+			else {
+				len = ::read(m_hEvent, &value, sizeof(value));
+				shell_unused(len);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Create epoll and start I/O thread
+ *
+ * 		pParent			parent receiver pool
+ * 		index			loop index
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRtpReceiverLoop::init(CRtpReceiverPool* pParent, size_t index)
+{
+	struct epoll_event	event;
+	char				strName[CARBON_OBJECT_NAME_LENGTH];
+	result_t			nresult;
+
+	m_pParent = pParent;
+	m_bDone = FALSE;
+
+	m_hEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+	if ( m_hEpoll < 0 )  {
+		nresult = errno;
+		log_error(L_RTP, "[rtp_recv_loop] failed to create epoll, result %d\n", nresult);
+		return nresult;
+	}
+
+	m_hEvent = ::eventfd(0, EFD_NONBLOCK|EFD_CLOEXEC);
+	if ( m_hEvent < 0 )  {
+		nresult = errno;
+		log_error(L_RTP, "[rtp_recv_loop] failed to create eventfd, result %d\n", nresult);
+		terminate();
+		return nresult;
+	}
+
+	event.events = EPOLLIN;
+	event.data.u64 = 0;
+	event.data.u32 = RTP_RECEIVER_SLOT_EVENT;
+	if ( ::epoll_ctl(m_hEpoll, EPOLL_CTL_ADD, m_hEvent, &event) != 0 )  {
+		nresult = errno;
+		log_error(L_RTP, "[rtp_recv_loop] failed to add eventfd, result %d\n", nresult);
+		terminate();
+		return nresult;
+	}
+
+	_tsnprintf(strName, sizeof(strName), "%s-io%u", pParent->getName(), (unsigned)index);
+	m_thread.setName(strName);
+
+	nresult = m_thread.start(THREAD_CALLBACK(CRtpReceiverLoop::threadIo, this));
+	if ( nresult != ESUCCESS )  {
+		log_error(L_RTP, "[rtp_recv_loop] failed to start I/O thread, result %d\n", nresult);
+		terminate();
+	}
+
+	return nresult;
+}
+
+/*
+ * Stop I/O thread and release the prepared frames
+ */
+void CRtpReceiverLoop::terminate()
+{
+	uint64_t	value = 1;
+	ssize_t		len;
+	size_t		i;
+
+	if ( m_thread.isRunning() )  {
+		m_bDone = TRUE;
+		len = ::write(m_hEvent, &value, sizeof(value));
+		shell_unused(len);
+		m_thread.stop();
+	}
+
+	if ( m_nFrames > 0 )  {
+		m_arFrame[0]->pOwner->putN(m_arFrame, m_nFrames);
+		for(i=0; i<m_nFrames; i++)  {
+			m_arFrame[i] = RTP_FRAME_NULL;
+		}
+		m_nFrames = 0;
+	}
+
+	if ( m_hEvent >= 0 )  {
+		::close(m_hEvent);
+		m_hEvent = -1;
+	}
+
+	if ( m_hEpoll >= 0 )  {
+		::close(m_hEpoll);
+		m_hEpoll = -1;
+	}
+}
 
 /*******************************************************************************
  * CRtpReceiverPool class
  */
 
-CRtpReceiverPool::CRtpReceiverPool(const char* strName, int nMaxCacheFrames) :
+/*
+ * Create a receiver pool
+ *
+ * 		strName				pool name
+ * 		nMaxCacheFrames		maximum allocated frames
+ * 		nLoops				shared I/O loop count, 0 - thread per receiver
+ */
+CRtpReceiverPool::CRtpReceiverPool(const char* strName, int nMaxCacheFrames, size_t nLoops) :
 	CObject(strName),
-	m_bReceiving(FALSE)
+	m_bReceiving(FALSE),
+	m_arLoop(0),
+	m_nLoops(sh_min(nLoops, RTP_RECEIVER_LOOPS_MAX)),
+	m_nLoopsRunning(0)
 {
 	m_pFrameCache = new CRtpFrameCache(nMaxCacheFrames);
+	if ( m_nLoops > 0 )  {
+		m_arLoop = new CRtpReceiverLoop[m_nLoops];
+	}
 }
 
 CRtpReceiverPool::~CRtpReceiverPool()
 {
 	shell_assert_ex(m_arReceiver.empty(), "[rtp_recv_pool(%s)] where are %u receiver(s) exist",
 						getName(), m_arReceiver.size());
+	terminateLoops();
+	if ( m_arLoop )  {
+		delete[] m_arLoop;
+		m_arLoop = 0;
+	}
 	SAFE_DELETE(m_pFrameCache);
 }
 
+/*
+ * Start shared I/O loops
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CRtpReceiverPool::initLoops()
+{
+	size_t		i;
+	result_t	nresult = ESUCCESS;
+
+	for(i=m_nLoopsRunning; i<m_nLoops; i++)  {
+		nresult = m_arLoop[i].init(this, i);
+		if ( nresult != ESUCCESS )  {
+			terminateLoops();
+			break;
+		}
+		m_nLoopsRunning++;
+	}
+
+	return nresult;
+}
+
+/*
+ * Stop shared I/O loops
+ */
+void CRtpReceiverPool::terminateLoops()
+{
+	size_t	i;
+
+	for(i=0; i<m_nLoopsRunning; i++)  {
+		m_arLoop[i].terminate();
+	}
+
+	m_nLoopsRunning = 0;
+}
+
+/*
+ * Select the least loaded I/O loop
+ *
+ * Return: I/O loop or NULL in the thread mode
+ */
+CRtpReceiverLoop* CRtpReceiverPool::getLoop() const
+{
+	CRtpReceiverLoop*	pLoop = 0;
+	size_t				i, count, nMin = SIZE_MAX;
+
+	for(i=0; i<m_nLoopsRunning; i++)  {
+		count = m_arLoop[i].getReceivers();
+		if ( count < nMin )  {
+			nMin = count;
+			pLoop = &m_arLoop[i];
+		}
+	}
+
+	return pLoop;
+}
+
 /*
  * Find receiver for the specified network address
  *
@@ -513,6 +969,24 @@ void CRtpReceiverPool::getStat(const CRtpPlayoutBuffer* pBuffer, int* pnFrameLos
 	}
 }
 
+/*
+ * Get total received frame count
+ *
+ * Return: frames received by all receivers
+ */
+int CRtpReceiverPool::getFrameCount() const
+{
+	CAutoLock	locker(m_lock);
+	size_t		i, count = m_arReceiver.size();
+	int			nFrames = 0;
+
+	for(i=0; i<count; i++)  {
+		nFrames += m_arReceiver[i]->getFrameCount();
+	}
+
+	return nFrames;
+}
+
 /*
  * Initialise receiver pool
  *
@@ -527,8 +1001,17 @@ result_t CRtpReceiverPool::init()
 	int 			nFail = 0, nSuccess = 0;
 	result_t		nresult = ESUCCESS, nr;
 
+	if ( m_nLoops > 0 )  {
+		nresult = initLoops();
+		if ( nresult != ESUCCESS )  {
+			log_error(L_RTP, "[rtp_recv_pool(%s)] failed to start I/O loops, result %d\n",
+					  getName(), nresult);
+			return nresult;
+		}
+	}
+
 	for(i=0; i<count; i++) {
-		nr = m_arReceiver[i]->init();
+		nr = m_arReceiver[i]->init(getLoop());
 		if ( nr == ESUCCESS )  {
 			nSuccess++;
 		}
@@ -555,6 +1038,7 @@ void CRtpReceiverPool::terminate()
 		m_arReceiver[i]->terminate();
 	}
 
+	terminateLoops();
 	m_bReceiving = FALSE;
 }
 
@@ -567,8 +1051,9 @@ void CRtpReceiverPool::dump(const char* strPref) const
 	CAutoLock		locker(m_lock);
 	size_t			i, count = m_arReceiver.size();
 
-	log_dump("*** %sRTP receiver pool(%s): %d receiver(s), %s\n",
-			 strPref, getName(), count, m_bReceiving ? "Receiving" : "STOPPED");
+	log_dump("*** %sRTP receiver pool(%s): %d receiver(s), %u I/O loop(s), %s\n",
+			 strPref, getName(), count, (unsigned)m_nLoops,
+			 m_bReceiving ? "Receiving" : "STOPPED");
 
 	for(i=0; i<count; i++)  {
 		m_arReceiver[i]->dump();
@@ -10,6 +10,13 @@
  *
  *	Revision 1.0, 12.10.2016 10:39:44
  *		Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 19:12:05
+ *		Added shared I/O loop mode: a few epoll threads receive
+ *		all RTP streams by recvmmsg().
+ *
+ *	Revision 1.2, 18.10.2026 11:41:08
+ *		Datagrams are discarded when the frame cache is exhausted.
  */
 /*
  *				+-------------------+
@@ -33,9 +40,24 @@
  *												+---------------------------------------+
  */
 
+/*
+ * Receiving modes:
+ *
+ * 		thread mode		each CRtpReceiver runs its own thread with blocking
+ * 						receive, one system call per frame;
+ *
+ * 		loop mode		receivers are distributed over a few CRtpReceiverLoop
+ * 						threads, a loop waits for all its sockets by epoll and
+ * 						drains a ready socket by recvmmsg() in batches of up
+ * 						to RTP_RECEIVE_BATCH frames. When the frame cache is
+ * 						exhausted the datagrams are discarded (counted as the
+ * 						allocation failures), a loop never sleeps.
+ */
+
 #ifndef __NET_MEDIA_RTP_RECEIVER_POOL_H_INCLUDED__
 #define __NET_MEDIA_RTP_RECEIVER_POOL_H_INCLUDED__
 
+#include <sys/socket.h>
 #include <vector>
 
 #include "shell/socket.h"
@@ -48,13 +70,23 @@
 #include "net_media/rtp.h"
 #include "net_media/rtp_frame_cache.h"
 
+#define RTP_RECEIVER_LOOPS_MAX		16		/* Maximum I/O loops in the pool */
+#define RTP_RECEIVER_EVENTS_MAX		64		/* epoll_wait() batch */
+#define RTP_RECEIVE_BATCH			32		/* Maximum frames received by a single recvmmsg() */
+#define RTP_RECEIVE_ROUNDS			4		/* Maximum recvmmsg() calls per socket wakeup */
+
 class CRtpPlayoutBuffer;
 class CRtpReceiverPool;
+class CRtpReceiverLoop;
 
 class CRtpReceiver : public CThread
 {
+	friend class CRtpReceiverLoop;
+
 	private:
 		CRtpReceiverPool*	m_pParent;			/* Parent receiver pool */
+		CRtpReceiverLoop*	m_pLoop;			/* Owner I/O loop, NULL - thread mode */
+		int					m_nSlot;			/* Slot index in the owner I/O loop */
 
 		mutable CMutex		m_lock;				/* Queue internal lock */
 		std::vector<CRtpPlayoutBuffer*> m_arPlayoutBuffer;	/* Playout buffers */
@@ -75,7 +107,7 @@ class CRtpReceiver : public CThread
 		virtual ~CRtpReceiver();
 
 	public:
-		result_t init();
+		result_t init(CRtpReceiverLoop* pLoop = NULL);
 		void terminate();
 
 		const CNetAddr& getNetAddr() const { return m_netAddr; }
@@ -89,15 +121,63 @@ class CRtpReceiver : public CThread
 		void getStat(int* pnFrameLost) const {
 			*pnFrameLost = counter_get(m_nFrameLost);
 		}
+		int getFrameCount() const {
+			return counter_get(m_nFrameCount)+counter_get(m_nFrameDrop);
+		}
 		void dump(const char* strPref = "") const;
 
 	private:
 		result_t validateFrame(rtp_frame_t* pFrame) const;
+		void processFrame(rtp_frame_t* pFrame);
 		void queueFrame(rtp_frame_t* pFrame);
 
 		void* threadProc(CThread* pThread, void* pData);
 };
 
+/*
+ * Shared I/O thread serving a number of receivers
+ */
+class CRtpReceiverLoop
+{
+	private:
+		CRtpReceiverPool*	m_pParent;			/* Parent receiver pool */
+		CThread				m_thread;			/* I/O thread */
+		int					m_hEpoll;			/* Epoll descriptor */
+		int					m_hEvent;			/* Wakeup eventfd descriptor */
+		volatile boolean_t	m_bDone;			/* TRUE: stop I/O thread */
+
+		mutable CMutex		m_lock;				/* Receiver slots lock */
+		std::vector<CRtpReceiver*>	m_arReceiver;	/* Receiver slots, NULL - free slot */
+		size_t				m_nReceivers;		/* Busy slot count */
+
+		/* I/O thread only */
+		rtp_frame_t*		m_arFrame[RTP_RECEIVE_BATCH];	/* Frames ready to receive to */
+		size_t				m_nFrames;			/* Ready frame count */
+		struct mmsghdr		m_arMsg[RTP_RECEIVE_BATCH];
+		struct iovec		m_arIov[RTP_RECEIVE_BATCH];
+		uint8_t				m_arScratch[RTP_PACKET_LENGTH_MAX];	/* Discarded datagrams buffer */
+
+	public:
+		CRtpReceiverLoop();
+		~CRtpReceiverLoop();
+
+	public:
+		result_t init(CRtpReceiverPool* pParent, size_t index);
+		void terminate();
+
+		size_t getReceivers() const { CAutoLock locker(m_lock); return m_nReceivers; }
+
+		result_t insertReceiver(CRtpReceiver* pReceiver);
+		void removeReceiver(CRtpReceiver* pReceiver);
+
+	private:
+		boolean_t fillFrames();
+		void receive(CRtpReceiver* pReceiver);
+		void discard(CRtpReceiver* pReceiver);
+
+		void* threadIo(CThread* pThread, void* pData);
+};
+
 class CRtpReceiverPool : public CObject
 {
 	private:
@@ -106,8 +186,13 @@ class CRtpReceiverPool : public CObject
 		std::vector<CRtpReceiver*>	m_arReceiver;	/* Receivers list */
 		boolean_t			m_bReceiving;		/* TRUE: poll is receiving */
 
+		CRtpReceiverLoop*	m_arLoop;			/* I/O loops, NULL - thread mode */
+		const size_t		m_nLoops;			/* I/O loop count */
+		size_t				m_nLoopsRunning;	/* Started I/O loop count */
+
 	public:
-		CRtpReceiverPool(const char* strName, int nMaxCacheFrames = RTP_FRAME_CACHE_LIMIT);
+		CRtpReceiverPool(const char* strName, int nMaxCacheFrames = RTP_FRAME_CACHE_LIMIT,
+						 size_t nLoops = 0);
 		virtual ~CRtpReceiverPool();
 
 	public:
@@ -125,13 +210,21 @@ class CRtpReceiverPool : public CObject
 		void removeAllChannels();
 
 		rtp_frame_t* getCacheFrame() { return m_pFrameCache->get(); }
+		size_t getCacheFrames(rtp_frame_t** arFrame, size_t count) {
+			return m_pFrameCache->getN(arFrame, count);
+		}
 
 		void getStat(const CRtpPlayoutBuffer* pBuffer, int* pnFrameLost) const;
+		int getFrameCount() const;
 		void dump(const char* strPref = "") const;
 
 	private:
 		int findChannel(const CNetAddr& netAddr) const;
 		int findChannel(const CRtpPlayoutBuffer* pBuffer) const;
+
+		result_t initLoops();
+		void terminateLoops();
+		CRtpReceiverLoop* getLoop() const;
 };
 
 #endif /* __NET_MEDIA_RTP_RECEIVER_POOL_H_INCLUDED__ */
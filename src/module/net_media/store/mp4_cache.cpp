@@ -27,71 +27,186 @@ CMp4CacheItem::CMp4CacheItem(const char* strFile, CMp4Cache* pParent) :
 	m_pParent(pParent),
 	m_strFile(strFile),
 	m_hHandle(-1),
-	m_pBuffer(NULL),
-	m_nSize(0),
-	m_nOffset(0),
-	m_nErrors(ZERO_COUNTER)
+	m_hDirect(-1),
+	m_pMemory(NULL),
+	m_pCurrent(NULL),
+	m_nErrors(ZERO_COUNTER),
+	m_pFree(NULL),
+	m_pHead(NULL),
+	m_pTail(NULL),
+	m_pNextReady(NULL),
+	m_bScheduled(FALSE),
+	m_nWriteResult(ESUCCESS),
+	m_bPrealloc(FALSE),
+	m_nAllocated(0),
+	m_nEnd(0),
+	m_nSynced(0),
+	m_nSyncedPrev(0)
 {
 }
 
 CMp4CacheItem::~CMp4CacheItem()
 {
 	shell_assert(m_hHandle == -1);
+	shell_assert(m_hDirect == -1);
+	shell_assert(m_pMemory == NULL);
 }
 
-result_t CMp4CacheItem::doWrite(const void* pBuffer, int64_t size, int64_t off)
+/*
+ * Preallocate file space up to the given offset
+ *
+ * 		nEnd		required file size, bytes
+ *
+ * Note: called by the writing thread
+ */
+void CMp4CacheItem::preallocate(int64_t nEnd)
 {
+	int64_t		nAllocated;
+	result_t	nresult;
+
+	nAllocated = ((nEnd+MP4_CACHE_PREALLOC_SIZE-1)/MP4_CACHE_PREALLOC_SIZE)*MP4_CACHE_PREALLOC_SIZE;
+
+	if ( ::fallocate(m_hHandle, FALLOC_FL_KEEP_SIZE, m_nAllocated, nAllocated-m_nAllocated) == 0 )  {
+		m_nAllocated = nAllocated;
+	}
+	else {
+		/* Filesystem does not support preallocation or no space, write as is */
+		nresult = errno;
+		log_debug(L_MP4FILE, "[mp4_cache] file %s: preallocation disabled, result: %d\n",
+				  m_strFile.cs(), nresult);
+		m_bPrealloc = FALSE;
+	}
+}
+
+/*
+ * Start writeback of the recently written data and wait for the writeback
+ * of the previous window, then drop the written pages from the page cache
+ *
+ * Note: called by the writing thread
+ */
+void CMp4CacheItem::writeback()
+{
+	if ( (m_nEnd-m_nSynced) < MP4_CACHE_SYNC_SIZE )  {
+		return;
+	}
+
+	::sync_file_range(m_hHandle, m_nSynced, m_nEnd-m_nSynced, SYNC_FILE_RANGE_WRITE);
+
+	if ( m_nSynced > m_nSyncedPrev )  {
+		::sync_file_range(m_hHandle, m_nSyncedPrev, m_nSynced-m_nSyncedPrev,
+				SYNC_FILE_RANGE_WAIT_BEFORE|SYNC_FILE_RANGE_WRITE|SYNC_FILE_RANGE_WAIT_AFTER);
+		::posix_fadvise(m_hHandle, m_nSyncedPrev, m_nSynced-m_nSyncedPrev, POSIX_FADV_DONTNEED);
+	}
+
+	m_nSyncedPrev = m_nSynced;
+	m_nSynced = m_nEnd;
+}
+
+/*
+ * Write a block to the file
+ *
+ * 		pBuffer		block to write
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: called by the writer thread or by the sink thread
+ * 		 if no writer thread is running
+ */
+result_t CMp4CacheItem::writeBlock(const mp4_cache_buffer_t* pBuffer)
+{
+	int64_t		nEnd = pBuffer->nOffset + pBuffer->nSize;
+	int			handle;
 	ssize_t		n;
 	result_t	nresult = ESUCCESS;
 
 	shell_assert(m_hHandle >= 0);
 
-	n = ::pwrite(m_hHandle, pBuffer, size, off);
+	if ( m_bPrealloc && nEnd > m_nAllocated )  {
+		preallocate(nEnd);
+	}
+
+	handle = m_hHandle;
+	if ( m_hDirect >= 0 && (pBuffer->nOffset%MP4_CACHE_DIRECT_ALIGN) == 0 &&
+			(pBuffer->nSize%MP4_CACHE_DIRECT_ALIGN) == 0 )
+	{
+		handle = m_hDirect;
+	}
+
+	n = ::pwrite(handle, pBuffer->pData, pBuffer->nSize, pBuffer->nOffset);
+	if ( n < 0 && handle == m_hDirect && errno == EINVAL )  {
+		/* Direct I/O is rejected by the filesystem, use the buffered I/O */
+		log_debug(L_MP4FILE, "[mp4_cache] file %s: direct i/o disabled\n", m_strFile.cs());
+		::close(m_hDirect);
+		m_hDirect = -1;
+		n = ::pwrite(m_hHandle, pBuffer->pData, pBuffer->nSize, pBuffer->nOffset);
+	}
+
 	if ( n < 0 )  {
 		nresult = errno;
-		log_error(L_MP4FILE, "[mp4_cache] failed to write file %s, %d bytes, result: %d\n",
-				  m_strFile.cs(), (int)size, nresult);
+		log_error(L_MP4FILE, "[mp4_cache] failed to write file %s, %u bytes, result: %d\n",
+				  m_strFile.cs(), pBuffer->nSize, nresult);
 	}
 	else {
-		if ( size != n )  {
-			log_error(L_MP4FILE, "[mp4_cache] failed to write file %s, written %ld of %ld bytes\n",
-					  m_strFile.cs(), n, size);
+		if ( pBuffer->nSize != n )  {
+			log_error(L_MP4FILE, "[mp4_cache] failed to write file %s, written %ld of %u bytes\n",
+					  m_strFile.cs(), n, pBuffer->nSize);
 			nresult = EIO;
 		}
 	}
 
+	if ( nEnd > m_nEnd )  {
+		m_nEnd = nEnd;
+	}
+
+	if ( m_pParent->getOptions()&MP4_CACHE_OPTION_SYNC )  {
+		writeback();
+	}
+
 	return nresult;
 }
 
-result_t CMp4CacheItem::doFlush()
+/*
+ * Queue the current buffer to write
+ *
+ * 		bTake		TRUE: take the next free buffer to fill
+ *
+ * Return: ESUCCESS, ... (first write error of the file)
+ */
+result_t CMp4CacheItem::flush(boolean_t bTake)
 {
+	int64_t		nOffset = m_pCurrent->nOffset + m_pCurrent->nSize;
 	result_t	nresult = ESUCCESS;
 
-	if ( m_nSize > 0 )  {
-		nresult = doWrite(m_pBuffer, m_nSize, m_nOffset);
+	if ( m_pCurrent->nSize > 0 )  {
+		nresult = m_pParent->queueBuffer(this, m_pCurrent);
+		m_pCurrent = bTake ? m_pParent->takeBuffer(this) : NULL;
+		if ( m_pCurrent )  {
+			m_pCurrent->nOffset = nOffset;
+		}
 	}
 
 	return nresult;
-
 }
 
 result_t CMp4CacheItem::open(MP4FileMode fileMode)
 {
-	int 		handle;
+	size_t		nBlockSize = m_pParent->getCacheBufferSize();
+	uint8_t*	pData;
+	int 		handle, i;
 	result_t	nresult;
 
 	shell_assert(m_hHandle == -1);
-	shell_assert(m_pBuffer == NULL);
+	shell_assert(m_pMemory == NULL);
 
 	if ( m_strFile.isEmpty() )  {
 		log_debug(L_MP4FILE, "[mp4_cache] no filename specified\n");
 		return ENOENT;
 	}
 
-	m_pBuffer = (uint8_t*)memAlloc(m_pParent->getCacheBufferSize());
-	if ( !m_pBuffer )  {
+	m_pMemory = (uint8_t*)memAlloc(nBlockSize*MP4_CACHE_BUFFERS+MP4_CACHE_DIRECT_ALIGN);
+	if ( !m_pMemory )  {
 		log_error(L_MP4FILE, "[mp4_cache] memory allocation failed %u bytes, file: %s\n",
-				  m_pParent->getCacheBufferSize(), m_strFile.cs());
+				  nBlockSize*MP4_CACHE_BUFFERS, m_strFile.cs());
 		return ENOMEM;
 	}
 
@@ -100,35 +215,61 @@ result_t CMp4CacheItem::open(MP4FileMode fileMode)
 		nresult = errno;
 		log_error(L_MP4FILE, "[mp4_cache] failed to open file %s, result: %d\n",
 				  m_strFile.cs(), nresult);
-		SAFE_FREE(m_pBuffer);
+		SAFE_FREE(m_pMemory);
 		return nresult;
 	}
 
+	if ( m_pParent->getOptions()&MP4_CACHE_OPTION_DIRECT )  {
+		m_hDirect = ::open(m_strFile, O_WRONLY|O_DIRECT);
+		if ( m_hDirect < 0 )  {
+			log_debug(L_MP4FILE, "[mp4_cache] file %s: direct i/o is unavailable, result: %d\n",
+					  m_strFile.cs(), errno);
+		}
+	}
+
+	/* Block buffers, the first one is current */
+	pData = (uint8_t*)ALIGN((uintptr_t)m_pMemory, MP4_CACHE_DIRECT_ALIGN);
+	m_pFree = NULL;
+	for(i=MP4_CACHE_BUFFERS-1; i>=0; i--)  {
+		m_arBuffer[i].pNext = m_pFree;
+		m_arBuffer[i].pData = pData + nBlockSize*i;
+		m_arBuffer[i].nSize = 0;
+		m_arBuffer[i].nOffset = 0;
+		m_arBuffer[i].hrQueued = HR_0;
+		m_pFree = &m_arBuffer[i];
+	}
+
+	m_pCurrent = m_pFree;
+	m_pFree = m_pCurrent->pNext;
+	m_pCurrent->pNext = NULL;
+	m_pHead = m_pTail = NULL;
+	m_bScheduled = FALSE;
+	m_nWriteResult = ESUCCESS;
+
+	m_bPrealloc = (m_pParent->getOptions()&MP4_CACHE_OPTION_PREALLOC) != 0;
+	m_nAllocated = m_nEnd = m_nSynced = m_nSyncedPrev = 0;
+
 	m_hHandle = handle;
-	m_nOffset = 0;
-	m_nSize = 0;
 	counter_set(m_nErrors, 0);
 
+	shell_unused(fileMode);
 	return ESUCCESS;
 }
 
 result_t CMp4CacheItem::seek(int64_t nPos)
 {
-	result_t	nresult;
-	int			retVal = 0;
+	result_t	nresult = ESUCCESS;
 
-	if ( (m_nOffset+m_nSize) != nPos )  {
-		nresult = doFlush();
-		m_nOffset = nPos;
-		m_nSize = 0;
+	if ( (m_pCurrent->nOffset+m_pCurrent->nSize) != nPos )  {
+		nresult = flush(TRUE);
+		m_pCurrent->nOffset = nPos;
 
 		if ( nresult != ESUCCESS )  {
-			retVal = 1;
 			counter_inc(m_nErrors);
 		}
 	}
 
-	return retVal;
+	return nresult;
 }
 
 result_t CMp4CacheItem::read(void* pBuffer, int64_t size, int64_t* nin, int64_t maxChunkSize)
@@ -142,69 +283,55 @@ result_t CMp4CacheItem::write(const void* pBuffer, int64_t size, int64_t* nout,
 							  int64_t maxChunkSize)
 {
 	const uint8_t*	p = (const uint8_t*)pBuffer;
-	int				i, count, rest, length = (int)size, l;
+	int64_t			length = size;
 	size_t			nBlockSize = m_pParent->getCacheBufferSize();
+	uint32_t		l;
 	result_t		nresult = ESUCCESS, nr;
 
-	l = sh_min(length, (int)(nBlockSize-m_nSize));
-	if ( l > 0 )  {
-		UNALIGNED_MEMCPY(&m_pBuffer[m_nSize], p, l);
+	while ( length > 0 )  {
+		l = (uint32_t)sh_min(length, (int64_t)(nBlockSize-m_pCurrent->nSize));
+		UNALIGNED_MEMCPY(&m_pCurrent->pData[m_pCurrent->nSize], p, l);
+		m_pCurrent->nSize += l;
 		length -= l;
-		m_nSize += l;
 		p += l;
-	}
-
-	if ( m_nSize == nBlockSize )  {
-		nresult = doFlush();
-		m_nOffset += nBlockSize;
-		m_nSize = 0;
-
-		if ( nresult != ESUCCESS )  {
-			counter_inc(m_nErrors);
-		}
-	}
-
-	if ( length == 0 )  {
-		*nout = size;
-		return nresult;
-	}
-
-	count = length/(int)nBlockSize;
-	rest = length%(int)nBlockSize;
-
-	for(i=0; i<count; i++)  {
-		nr = doWrite(p, nBlockSize, m_nOffset);
-		m_nOffset += nBlockSize;
-		p += nBlockSize;
 
-		if ( nr != ESUCCESS )  {
-			counter_inc(m_nErrors);
-			nresult_join(nresult, nr);
+		if ( m_pCurrent->nSize == nBlockSize )  {
+			nr = flush(TRUE);
+			if ( nr != ESUCCESS )  {
+				counter_inc(m_nErrors);
+				nresult = nr;
+			}
 		}
 	}
 
-	if ( rest > 0 )  {
-		UNALIGNED_MEMCPY(m_pBuffer, p, rest);
-		m_nSize += rest;
-	}
-
 	*nout = size;
 	return nresult;
 }
 
 result_t CMp4CacheItem::close()
 {
-	result_t	nresult;
+	result_t	nresult, nr;
 	int 		retVal;
 
-	nresult = doFlush();
-	m_nOffset += m_nSize;
-	m_nSize = 0;
+	nresult = flush(FALSE);
+	nr = m_pParent->drain(this);
+	nresult_join(nresult, nr);
 
 	if ( nresult != ESUCCESS )  {
 		counter_inc(m_nErrors);
 	}
 
+	if ( m_nAllocated > m_nEnd )  {
+		/* Release the preallocated space beyond the end of file */
+		retVal = ::ftruncate(m_hHandle, m_nEnd);
+		shell_unused(retVal);
+	}
+
+	if ( m_hDirect >= 0 )  {
+		::close(m_hDirect);
+		m_hDirect = -1;
+	}
+
 	retVal = ::close(m_hHandle);
 	if ( retVal != 0 ) {
 		nresult = errno;
@@ -212,7 +339,9 @@ result_t CMp4CacheItem::close()
 	}
 
 	m_hHandle = -1;
-	SAFE_FREE(m_pBuffer);
+	m_pCurrent = NULL;
+	m_pFree = NULL;
+	SAFE_FREE(m_pMemory);
 
 	return nresult;
 }
@@ -226,9 +355,11 @@ result_t CMp4CacheItem::close()
  */
 void CMp4CacheItem::dump(const char* strMargin) const
 {
-	log_dump("%sItem: %s, open: %s, off: %u, size: %u, errors: %d\n",
-			 m_strFile.cs(), m_hHandle != -1 ? "YES" : "NO",
-			 (int)m_nOffset, m_nSize, counter_get(m_nErrors));
+	log_dump("%sItem: %s, open: %s, off: %lld, size: %u, end: %lld, errors: %d, result: %d\n",
+			 strMargin, m_strFile.cs(), m_hHandle != -1 ? "YES" : "NO",
+			 m_pCurrent ? (long long)m_pCurrent->nOffset : 0LL,
+			 m_pCurrent ? m_pCurrent->nSize : 0, (long long)m_nEnd,
+			 counter_get(m_nErrors), m_nWriteResult);
 }
 
 /*******************************************************************************
@@ -258,14 +389,280 @@ CMp4Cache* CMp4Cache::getCache()
 	return m_pInstance;
 }
 
-CMp4Cache::CMp4Cache(size_t nBlockSize) :
-	m_nBlockSize(nBlockSize)
+/*
+ * Create cache
+ *
+ * 		nBlockSize		block buffer size, bytes (multiple of MP4_CACHE_DIRECT_ALIGN)
+ * 		nWriters		writer threads, 0 - write by the caller thread
+ * 		options			cache options, MP4_CACHE_OPTION_xxx
+ */
+CMp4Cache::CMp4Cache(size_t nBlockSize, size_t nWriters, int options) :
+	m_nBlockSize(nBlockSize),
+	m_options(options),
+	m_nWriters(0),
+	m_bDone(FALSE),
+	m_pReadyHead(NULL),
+	m_pReadyTail(NULL),
+	m_nQueued(0),
+	m_nQueuedMax(0),
+	m_nWrites(0),
+	m_nWriteBytes(0),
+	m_hrWriteTime(HR_0),
+	m_hrWriteMax(HR_0),
+	m_hrQueueMax(HR_0),
+	m_nStalls(0),
+	m_hrStallTime(HR_0)
 {
+	shell_assert((nBlockSize%MP4_CACHE_DIRECT_ALIGN) == 0);
+	_tbzero_object(m_arWriter);
+	startWriters(nWriters);
 }
 
 CMp4Cache::~CMp4Cache()
 {
 	shell_assert(m_file.size() == 0);
+	stopWriters();
+}
+
+/*
+ * Start the writer pool
+ *
+ * 		nWriters		thread count
+ *
+ * Note: if no thread is started the blocks are written by the caller
+ */
+void CMp4Cache::startWriters(size_t nWriters)
+{
+	CThread*	pThread;
+	char		strName[CARBON_OBJECT_NAME_LENGTH];
+	size_t		i;
+	result_t	nresult;
+
+	nWriters = sh_min(nWriters, (size_t)MP4_CACHE_WRITERS_MAX);
+	for(i=0; i<nWriters; i++)  {
+		_tsnprintf(strName, sizeof(strName), "mp4-writer%u", (unsigned)i);
+		pThread = new CThread(strName);
+
+		nresult = pThread->start(THREAD_CALLBACK(CMp4Cache::threadWriter, this));
+		if ( nresult != ESUCCESS )  {
+			log_error(L_MP4FILE, "[mp4_cache] failed to start writer thread, result: %d\n", nresult);
+			delete pThread;
+			break;
+		}
+
+		m_arWriter[m_nWriters] = pThread;
+		m_nWriters++;
+	}
+}
+
+/*
+ * Stop the writer pool
+ */
+void CMp4Cache::stopWriters()
+{
+	size_t	i;
+
+	m_ioLock.lock();
+	m_bDone = TRUE;
+	m_ioLock.wakeup();
+	m_ioLock.unlock();
+
+	for(i=0; i<m_nWriters; i++)  {
+		m_arWriter[i]->stop();
+		SAFE_DELETE(m_arWriter[i]);
+	}
+
+	m_nWriters = 0;
+}
+
+/*
+ * Update write statistic
+ *
+ * 		pBuffer			written buffer
+ * 		hrStart			write start time
+ * 		hrEnd			write end time
+ *
+ * Note: m_ioLock must be locked
+ */
+void CMp4Cache::account(const mp4_cache_buffer_t* pBuffer, hr_time_t hrStart, hr_time_t hrEnd)
+{
+	hr_time_t	hrWrite = hrEnd - hrStart;
+
+	m_nWrites++;
+	m_nWriteBytes += pBuffer->nSize;
+	m_hrWriteTime += hrWrite;
+	m_hrWriteMax = sh_max(m_hrWriteMax, hrWrite);
+	m_hrQueueMax = sh_max(m_hrQueueMax, hrEnd-pBuffer->hrQueued);
+}
+
+/*
+ * Writer thread: write the queued buffers of the ready items, a single
+ * item is processed by one thread at a time to keep the block order
+ */
+void* CMp4Cache::threadWriter(CThread* pThread, void* pData)
+{
+	CMp4CacheItem*		pItem;
+	mp4_cache_buffer_t*	pBuffer;
+	hr_time_t			hrStart;
+	result_t			nresult;
+
+	shell_unused(pData);
+	pThread->bootCompleted(ESUCCESS);
+
+	m_ioLock.lock();
+
+	while ( !m_bDone )  {
+		pItem = m_pReadyHead;
+		if ( !pItem )  {
+			m_ioLock.wait();
+			continue;
+		}
+
+		m_pReadyHead = pItem->m_pNextReady;
+		if ( !m_pReadyHead )  {
+			m_pReadyTail = NULL;
+		}
+		pItem->m_pNextReady = NULL;
+
+		while ( (pBuffer=pItem->m_pHead) != NULL )  {
+			pItem->m_pHead = pBuffer->pNext;
+			if ( !pItem->m_pHead )  {
+				pItem->m_pTail = NULL;
+			}
+			m_nQueued--;
+			m_ioLock.unlock();
+
+			hrStart = hr_time_now();
+			nresult = pItem->writeBlock(pBuffer);
+
+			m_ioLock.lock();
+			account(pBuffer, hrStart, hr_time_now());
+			if ( nresult != ESUCCESS && pItem->m_nWriteResult == ESUCCESS )  {
+				pItem->m_nWriteResult = nresult;
+			}
+
+			pBuffer->pNext = pItem->m_pFree;
+			pItem->m_pFree = pBuffer;
+			m_ioLock.wakeup();
+		}
+
+		pItem->m_bScheduled = FALSE;
+		m_ioLock.wakeup();
+	}
+
+	m_ioLock.unlock();
+
+	return NULL;
+}
+
+/*
+ * Take a free buffer of the file, wait for the writer if all buffers
+ * are queued
+ *
+ * 		pItem		cache item
+ *
+ * Return: empty buffer
+ */
+mp4_cache_buffer_t* CMp4Cache::takeBuffer(CMp4CacheItem* pItem)
+{
+	CAutoLock			locker(m_ioLock);
+	mp4_cache_buffer_t*	pBuffer;
+	hr_time_t			hrStart;
+
+	if ( !pItem->m_pFree )  {
+		m_nStalls++;
+		hrStart = hr_time_now();
+		while ( !pItem->m_pFree )  {
+			m_ioLock.wait();
+		}
+		m_hrStallTime += hr_time_get_elapsed(hrStart);
+	}
+
+	pBuffer = pItem->m_pFree;
+	pItem->m_pFree = pBuffer->pNext;
+
+	pBuffer->pNext = NULL;
+	pBuffer->nSize = 0;
+
+	return pBuffer;
+}
+
+/*
+ * Queue a filled buffer to write
+ *
+ * 		pItem		cache item
+ * 		pBuffer		buffer to write
+ *
+ * Return: ESUCCESS, ... (first write error of the file)
+ */
+result_t CMp4Cache::queueBuffer(CMp4CacheItem* pItem, mp4_cache_buffer_t* pBuffer)
+{
+	CAutoLock	locker(m_ioLock);
+	hr_time_t	hrStart;
+	result_t	nresult;
+
+	pBuffer->pNext = NULL;
+	pBuffer->hrQueued = hr_time_now();
+
+	if ( m_nWriters == 0 )  {
+		/* No writer pool, write synchronously */
+		locker.unlock();
+		hrStart = hr_time_now();
+		nresult = pItem->writeBlock(pBuffer);
+
+		locker.lock();
+		account(pBuffer, hrStart, hr_time_now());
+		if ( nresult != ESUCCESS && pItem->m_nWriteResult == ESUCCESS )  {
+			pItem->m_nWriteResult = nresult;
+		}
+
+		pBuffer->pNext = pItem->m_pFree;
+		pItem->m_pFree = pBuffer;
+		return pItem->m_nWriteResult;
+	}
+
+	if ( pItem->m_pTail )  {
+		pItem->m_pTail->pNext = pBuffer;
+	}
+	else {
+		pItem->m_pHead = pBuffer;
+	}
+	pItem->m_pTail = pBuffer;
+
+	m_nQueued++;
+	m_nQueuedMax = sh_max(m_nQueuedMax, m_nQueued);
+
+	if ( !pItem->m_bScheduled )  {
+		pItem->m_bScheduled = TRUE;
+		if ( m_pReadyTail )  {
+			m_pReadyTail->m_pNextReady = pItem;
+		}
+		else {
+			m_pReadyHead = pItem;
+		}
+		m_pReadyTail = pItem;
+		m_ioLock.wakeup();
+	}
+
+	return pItem->m_nWriteResult;
+}
+
+/*
+ * Wait until all queued buffers of the file are written
+ *
+ * 		pItem		cache item
+ *
+ * Return: ESUCCESS, ... (first write error of the file)
+ */
+result_t CMp4Cache::drain(CMp4CacheItem* pItem)
+{
+	CAutoLock	locker(m_ioLock);
+
+	while ( pItem->m_bScheduled )  {
+		m_ioLock.wait();
+	}
+
+	return pItem->m_nWriteResult;
 }
 
 void CMp4Cache::insertItem(CMp4CacheItem* pItem)
@@ -476,9 +873,20 @@ void CMp4Cache::dump(const char* strPref) const
 	CAutoLock		locker(m_lock);
 	std::map<void*, CMp4CacheItem*>::const_iterator it;
 
-	log_dump("*** %sMP4 Cache (%u items):\n", m_file.size());
+	log_dump("*** %sMP4 Cache (%u items):\n", strPref, (unsigned)m_file.size());
 
 	for(it=m_file.begin(); it!=m_file.end(); it++) {
 		it->second->dump("    ");
 	}
+
+	CAutoLock		ioLocker(m_ioLock);
+
+	log_dump("    writers: %u, queued: %u, max queued: %u, stalls: %llu (%llu ms)\n",
+			 (unsigned)m_nWriters, (unsigned)m_nQueued, (unsigned)m_nQueuedMax,
+			 (unsigned long long)m_nStalls, (unsigned long long)HR_TIME_TO_MILLISECONDS(m_hrStallTime));
+	log_dump("    writes: %llu (%llu KB), latency avg: %llu us, max: %llu us, max queue time: %llu ms\n",
+			 (unsigned long long)m_nWrites, (unsigned long long)(m_nWriteBytes/1024),
+			 (unsigned long long)(m_nWrites ? HR_TIME_TO_MICROSECONDS(m_hrWriteTime)/m_nWrites : 0),
+			 (unsigned long long)HR_TIME_TO_MICROSECONDS(m_hrWriteMax),
+			 (unsigned long long)HR_TIME_TO_MILLISECONDS(m_hrQueueMax));
 }
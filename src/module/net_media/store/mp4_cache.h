@@ -10,6 +10,23 @@
  *
  *	Revision 1.0, 17.11.2016 12:52:50
  *	    Initial revision.
+ *
+ *	Revision 1.1, 17.10.2026 22:14:37
+ *	    Write-behind: the filled blocks are written by the background
+ *	    writer pool, file preallocation, optional O_DIRECT writes,
+ *	    periodic writeback, queue and latency counters.
+ */
+/*
+ * Purpose:
+ * 		Every open file owns MP4_CACHE_BUFFERS rotating block buffers.
+ * 		The sink thread fills the current buffer and queues it to the
+ * 		file write queue, the queued buffers are written in order by one
+ * 		of the writer threads at a time. The sink thread waits only when
+ * 		all buffers of the file are queued (writer stall).
+ *
+ * 		The write errors are sticky and reported by the next seek(),
+ * 		write() or close() call. close() returns when all queued buffers
+ * 		are written.
  */
 
 #ifndef __MP4_CACHE_H_INCLUDED__
@@ -24,21 +41,66 @@
 #include "carbon/cstring.h"
 
 #define MP4_CACHE_BLOCKSIZE			(512*1024)
+#define MP4_CACHE_BUFFERS			4					/* Rotating buffers per file */
+#define MP4_CACHE_WRITERS			2					/* Writer pool threads */
+#define MP4_CACHE_WRITERS_MAX		16
+#define MP4_CACHE_PREALLOC_SIZE		(16*1024*1024)		/* Preallocation step, bytes */
+#define MP4_CACHE_SYNC_SIZE			(8*1024*1024)		/* Writeback interval, bytes */
+#define MP4_CACHE_DIRECT_ALIGN		4096				/* O_DIRECT memory/offset/size alignment */
+
+/*
+ * Cache options
+ */
+#define MP4_CACHE_OPTION_PREALLOC	0x01				/* fallocate() the file ahead */
+#define MP4_CACHE_OPTION_SYNC		0x02				/* Periodic sync_file_range() */
+#define MP4_CACHE_OPTION_DIRECT		0x04				/* O_DIRECT for the aligned blocks */
+
+#define MP4_CACHE_OPTIONS			(MP4_CACHE_OPTION_PREALLOC|MP4_CACHE_OPTION_SYNC)
+
+/*
+ * Cache block buffer
+ */
+typedef struct mp4_cache_buffer
+{
+	struct mp4_cache_buffer*	pNext;			/* Next buffer in the list */
+	uint8_t*					pData;			/* Block data, MP4_CACHE_DIRECT_ALIGN aligned */
+	uint32_t					nSize;			/* Data size, bytes */
+	int64_t						nOffset;		/* File offset */
+	hr_time_t					hrQueued;		/* Time the buffer was queued */
+} mp4_cache_buffer_t;
 
 class CMp4Cache;
 
 class CMp4CacheItem
 {
+	friend class CMp4Cache;
+
 	private:
 		CMp4Cache*		m_pParent;			/* Parent cache pointer */
 
 		CString			m_strFile;			/* Open full filename */
 		int				m_hHandle;			/* OPen file handle or -1 */
-		uint8_t*		m_pBuffer;			/* Memory buffer */
-		uint32_t		m_nSize;			/* Current data size in buffer */
-		int64_t			m_nOffset;			/* Offset within buffer */
+		int				m_hDirect;			/* O_DIRECT file handle or -1 */
+		uint8_t*		m_pMemory;			/* Buffer memory */
+		mp4_cache_buffer_t	m_arBuffer[MP4_CACHE_BUFFERS];
+		mp4_cache_buffer_t*	m_pCurrent;		/* Buffer being filled (sink thread) */
 		counter_t		m_nErrors;			/* Error count within current file */
 
+		/* Protected by the parent writer lock */
+		mp4_cache_buffer_t*	m_pFree;		/* Free buffers */
+		mp4_cache_buffer_t*	m_pHead;		/* Write queue head */
+		mp4_cache_buffer_t*	m_pTail;		/* Write queue tail */
+		CMp4CacheItem*	m_pNextReady;		/* Next item in the parent ready list */
+		boolean_t		m_bScheduled;		/* TRUE: item is in the ready list or being written */
+		result_t		m_nWriteResult;		/* First background write error */
+
+		/* Accessed by the writing thread only */
+		boolean_t		m_bPrealloc;		/* TRUE: preallocate file */
+		int64_t			m_nAllocated;		/* Preallocated file size */
+		int64_t			m_nEnd;				/* Maximum written offset */
+		int64_t			m_nSynced;			/* Writeback started offset */
+		int64_t			m_nSyncedPrev;		/* Previous writeback started offset */
+
 	public:
 		CMp4CacheItem(const char* strFile, CMp4Cache* pParent);
 		virtual ~CMp4CacheItem();
@@ -53,8 +115,10 @@ class CMp4CacheItem
 		void dump(const char* strMargin) const;
 
 	private:
-		result_t doFlush();
-		result_t doWrite(const void* pBuffer, int64_t size, int64_t off);
+		result_t flush(boolean_t bTake);
+		result_t writeBlock(const mp4_cache_buffer_t* pBuffer);
+		void preallocate(int64_t nEnd);
+		void writeback();
 };
 
 /*
@@ -62,20 +126,43 @@ class CMp4CacheItem
  */
 class CMp4Cache
 {
+	friend class CMp4CacheItem;
+
 	protected:
 		size_t							m_nBlockSize;		/* Cache I/O block size */
+		int								m_options;			/* Cache options, MP4_CACHE_OPTION_xxx */
 		std::map<void*, CMp4CacheItem*>	m_file;				/* Cached files */
 
+		CThread*						m_arWriter[MP4_CACHE_WRITERS_MAX];
+		size_t							m_nWriters;			/* Running writer threads */
+		mutable CCondition				m_ioLock;			/* Write queues lock */
+		boolean_t						m_bDone;			/* TRUE: writer pool is stopping */
+		CMp4CacheItem*					m_pReadyHead;		/* Items with the queued buffers */
+		CMp4CacheItem*					m_pReadyTail;
+
+		/* Statistic, protected by m_ioLock */
+		size_t							m_nQueued;			/* Queued buffers */
+		size_t							m_nQueuedMax;		/* Maximum queued buffers */
+		uint64_t						m_nWrites;			/* Written blocks */
+		uint64_t						m_nWriteBytes;		/* Written bytes */
+		hr_time_t						m_hrWriteTime;		/* Total block write time */
+		hr_time_t						m_hrWriteMax;		/* Maximum block write time */
+		hr_time_t						m_hrQueueMax;		/* Maximum time from queuing to written */
+		uint64_t						m_nStalls;			/* Sink thread waits for a free buffer */
+		hr_time_t						m_hrStallTime;		/* Total sink thread wait time */
+
 		static CMutex					m_lock;				/* Synchronisation access */
 		static CMp4Cache*				m_pInstance;		/* Singleton */
 		static const MP4FileProvider 	m_fileProvider;
 
 	public:
-		CMp4Cache(size_t nBlockSize);
+		CMp4Cache(size_t nBlockSize, size_t nWriters = MP4_CACHE_WRITERS,
+				  int options = MP4_CACHE_OPTIONS);
 		virtual ~CMp4Cache();
 
 	public:
 		size_t getCacheBufferSize() const { return m_nBlockSize; }
+		int getOptions() const { return m_options; }
 		void insertItem(CMp4CacheItem* pItem);
 		void deleteItem(CMp4CacheItem* pItem);
 		CMp4CacheItem* getItem(void* pHandle) const;
@@ -91,6 +178,16 @@ class CMp4Cache
 		static int cacheWrite(void* pHandle, const void* pBuffer, int64_t size, int64_t* nout, int64_t maxChunkSize);
 		static int cacheClose(void* pHandle);
 
+	protected:
+		mp4_cache_buffer_t* takeBuffer(CMp4CacheItem* pItem);
+		result_t queueBuffer(CMp4CacheItem* pItem, mp4_cache_buffer_t* pBuffer);
+		result_t drain(CMp4CacheItem* pItem);
+		void account(const mp4_cache_buffer_t* pBuffer, hr_time_t hrStart, hr_time_t hrEnd);
+
+	private:
+		void startWriters(size_t nWriters);
+		void stopWriters();
+		void* threadWriter(CThread* pThread, void* pData);
 };
 
 #endif /* __MP4_CACHE_H_INCLUDED__ */
@@ -21,6 +21,7 @@
 
 #include "carbon/memory.h"
 
+#include "net_media/h264_scan.h"
 #include "net_media/store/mp4_h264/mpeg4ip.h"
 #include "net_media/store/mp4_h264/mp4av_h264.h"
 #include "net_media/store/mp4_h264/mpeg4ip_bitstream.h"
@@ -94,24 +95,7 @@ int32_t h264_se (CBitstream *bs)
 static void h264_decode_annexb( uint8_t *dst, int *dstlen,
                                 const uint8_t *src, const int srclen )
 {
-  uint8_t *dst_sav = dst;
-  const uint8_t *end = &src[srclen];
-
-  while (src < end)
-  {
-    if (src < end - 3 && src[0] == 0x00 && src[1] == 0x00 &&
-        src[2] == 0x03)
-    {
-      *dst++ = 0x00;
-      *dst++ = 0x00;
-
-      src += 3;
-      continue;
-    }
-    *dst++ = *src++;
-  }
-
-  *dstlen = dst - dst_sav;
+  *dstlen = (int)h264_rbsp_decode(dst, src, (size_t)srclen);
 }
 
 extern "C" bool h264_is_start_code (const uint8_t *pBuf) 
@@ -128,30 +112,7 @@ extern "C" bool h264_is_start_code (const uint8_t *pBuf)
 extern "C" uint32_t h264_find_next_start_code (const uint8_t *pBuf, 
 					       uint32_t bufLen)
 {
-  uint32_t val, temp;
-  uint32_t offset;
-
-  offset = 0;
-  if (pBuf[0] == 0 && 
-      pBuf[1] == 0 && 
-      ((pBuf[2] == 1) ||
-       ((pBuf[2] == 0) && pBuf[3] == 1))) {
-    pBuf += 3;
-    offset = 3;
-  }
-  val = 0xffffffff;
-  while (offset < bufLen - 3) {
-    val <<= 8;
-    temp = val & 0xff000000;
-    val &= 0x00ffffff;
-    val |= *pBuf++;
-    offset++;
-    if (val == H264_START_CODE) {
-      if (temp == 0) return offset - 4;
-      return offset - 3;
-    }
-  }
-  return 0;
+  return (uint32_t)h264_find_next_nal(pBuf, bufLen);
 }
 
 extern "C" uint8_t h264_nal_unit_type (const uint8_t *buffer)
@@ -45,6 +45,7 @@ class CBitstream {
     m_chDecBufferSize = bit_len;
     m_bBookmarkOn = 0;
     m_uNumOfBitsInBuffer = 0;
+    m_chDecData = 0;
 
   };
   void init(const char *buffer, uint32_t bit_len) {
@@ -10,10 +10,14 @@
  *
  *	Revision 1.0, 16.11.2016 18:52:07
  *	    Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 00:31:15
+ *	    NAL units of the RTP playout nodes are read from the node fragments.
  */
 
 #include "carbon/memory.h"
 
+#include "net_media/rtp_playout_buffer_h264.h"
 #include "net_media/store/mp4_cache.h"
 #include "net_media/store/mp4_h264_file.h"
 
@@ -272,8 +276,50 @@ bool CMp4H264File::RefreshReader(nal_reader_t *nal, uint32_t nal_start)
 	return true;
 }
 
+/*
+ * Load the next NAL unit of the fragmented source: the NAL fragments
+ * are gathered to the reader buffer, no start code scanning is required
+ */
+bool CMp4H264File::LoadNalIov(nal_reader_t *nal)
+{
+	const h264_nal_iov_t*	pNal;
+	const struct iovec*		arIov;
+	uint32_t				i, offset;
+
+	if ( nal->nal_index >= nal->pNode->getNalCount() )  {
+		return false;
+	}
+
+	pNal = nal->pNode->getNal(nal->nal_index);
+	nal->nal_index++;
+
+	if ( pNal->nSize > nal->buffer_size_max )  {
+		uint8_t* tmp = (uint8_t *)memRealloc(nal->buffer, pNal->nSize);
+		if ( tmp == NULL )  {
+			return false;
+		}
+		nal->buffer = tmp;
+		nal->buffer_size_max = pNal->nSize;
+	}
+
+	arIov = nal->pNode->getNalIov(pNal);
+	offset = 0;
+	for(i=0; i<pNal->nCount; i++)  {
+		UNALIGNED_MEMCPY(nal->buffer+offset, arIov[i].iov_base, arIov[i].iov_len);
+		offset += (uint32_t)arIov[i].iov_len;
+	}
+
+	nal->buffer_on = offset;
+	nal->buffer_size = offset;
+	return true;
+}
+
 bool CMp4H264File::LoadNal(nal_reader_t *nal)
 {
+	if ( nal->pNode )  {
+		return LoadNalIov(nal);
+	}
+
 	if (nal->buffer_on != 0 || nal->buffer_size == 0) {
 		if (RefreshReader(nal, nal->buffer_on) == false) {
 #ifdef DEBUG_H264
@@ -304,6 +350,36 @@ bool CMp4H264File::LoadNal(nal_reader_t *nal)
 	return true;
 }
 
+/*
+ * Set a NAL reader source: the fragments of the playout node
+ * or a contiguous frame data
+ *
+ * 		nal			NAL reader
+ * 		pFrame		frame to read
+ *
+ * Return: false if the frame has no data
+ */
+bool CMp4H264File::InitReader(nal_reader_t *nal, CMediaFrame* pFrame)
+{
+	const CRtpPlayoutNodeH264*	pNode = dynamic_cast<const CRtpPlayoutNodeH264*>(pFrame);
+
+	nal->pos = 0;
+	nal->nal_index = 0;
+
+	if ( pNode && pNode->getNalCount() > 0 )  {
+		nal->pNode = pNode;
+		nal->pData = NULL;
+		nal->size = (int)pNode->getSize();
+		return true;
+	}
+
+	nal->pNode = NULL;
+	nal->pData = (const char*)pFrame->getData();
+	nal->size = (int)pFrame->getSize();
+
+	return nal->pData != NULL && nal->size != 0;
+}
+
 /*
  * Create a new MP4 file (existing files are truncated)
  *
@@ -448,24 +524,18 @@ result_t CMp4H264File::doCreateVideoTrack(CMediaFrame* pFrame)
 	uint8_t 	AVCLevelIndication = 0;
 	uint32_t 	mp4FrameDuration;
 
-	const char*	pData = (const char*)pFrame->getData();
-	int 		size = (int)pFrame->getSize();
-
 	shell_assert(isOpen());
 	shell_assert(m_videoTrackId == MP4_INVALID_TRACK_ID);
 	shell_assert(m_nVideoFps != 0);
 	shell_assert(m_nVideoRate != 0);
 
-	if ( !pData || size == 0 )  {
+	_tbzero_object(nal);
+	if ( !InitReader(&nal, pFrame) )  {
 		log_debug(L_MP4FILE, "[mp4_file] %s: can't create video track, invalid frame data\n",
 				  getFile());
 		return EINVAL;
 	}
 
-	_tbzero_object(nal);
-	nal.pData = pData;
-	nal.size = size;
-
 	/*
 	 * Find sequence header
 	 */
@@ -565,22 +635,15 @@ result_t CMp4H264File::doWriteVideoFrame(CMediaFrame* pFrame)
 	MP4Duration 	mp4Duration;
 	bool 			bResult;
 
-	const char*		pData = (const char*)pFrame->getData();
-	int 			size = (int)pFrame->getSize();
-
 	shell_assert(isOpen());
 	shell_assert(m_videoTrackId != MP4_INVALID_TRACK_ID);
 	shell_assert(m_nVideoFps != 0);
 	shell_assert(m_nVideoRate != 0);
 
-	if ( !pData || size == 0 )  {
+	if ( !InitReader(&nal, pFrame) )  {
 		return ESUCCESS;
 	}
 
-	nal.pData = pData;
-	nal.size = size;
-	nal.pos = 0;
-
 	while ( LoadNal(&nal) != false ) {
 		uint32_t header_size;
 		header_size = nal.buffer[2] == 1 ? 3 : 4;
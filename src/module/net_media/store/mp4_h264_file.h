@@ -10,6 +10,9 @@
  *
  *	Revision 1.0, 16.11.2016 18:51:17
  *	    Initial revision.
+ *
+ *	Revision 1.1, 18.10.2026 00:31:15
+ *	    NAL units of the RTP playout nodes are read from the node fragments.
  */
 /*
  * MP4 file:
@@ -34,11 +37,16 @@
 
 #define MP4_TIME_RATE_GENERAL				90000
 
+class CRtpPlayoutNodeH264;
+
 typedef struct nal_reader_t {
 	const char* pData;
 	int			size;
 	int			pos;
 
+	const CRtpPlayoutNodeH264*	pNode;		/* Fragmented source or NULL */
+	size_t		nal_index;					/* Next NAL unit of the fragmented source */
+
 	uint8_t*	buffer;
 	uint32_t 	buffer_on;
 	uint32_t 	buffer_size;
@@ -140,6 +148,8 @@ class CMp4H264File : public CMediaFile
 		bool remove_unused_sei_messages(nal_reader_t* nal, uint32_t header_size);
 		bool RefreshReader(nal_reader_t* nal, uint32_t nal_start);
 		bool LoadNal(nal_reader_t* nal);
+		bool LoadNalIov(nal_reader_t* nal);
+		bool InitReader(nal_reader_t* nal, CMediaFrame* pFrame);
 
 		result_t doCreateVideoTrack(CMediaFrame* pFrame);
 		result_t doWriteVideoFrame(CMediaFrame* pFrame);
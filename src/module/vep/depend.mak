@@ -0,0 +1,6 @@
+
+ifeq ($(CARBON_ZLIB),1)
+MODULE_DEP += contact
+endif
+
+THPARTY_DEP +=
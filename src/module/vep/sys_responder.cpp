@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 02.06.2015 10:21:52
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:23:05
+ *      Replies are compressed if the requester accepts it.
  */
 
 #include "shell/logger/logger_base.h"
@@ -35,6 +38,20 @@ CSysResponder::~CSysResponder()
 {
 }
 
+/*
+ * Send reply container to the requester
+ *
+ *      pContainer      container to send
+ *      pSocket         open socket
+ *
+ * Note: the container is compressed if the requester accepts it
+ */
+result_t CSysResponder::sendReply(CVepContainer* pContainer, CSocketRef* pSocket)
+{
+    m_compress.prepare(pContainer);
+    return m_pNetConnector->send(pContainer, pSocket);
+}
+
 /*
  * Send reply packet of type SYSTEM_PACKET_VERSION_TYPE
  *
@@ -61,7 +78,7 @@ result_t CSysResponder::doPacketVersion(CSocketRef* pSocket)
     nresult = containerPtr->insertPacket(SYSTEM_PACKET_VERSION_REPLY, &reply, sizeof(reply));
     shell_assert(nresult == ESUCCESS);
 
-    nresult = m_pNetConnector->send(containerPtr, pSocket);
+    nresult = sendReply(containerPtr, pSocket);
     return nresult;
 }
 
@@ -89,7 +106,7 @@ result_t CSysResponder::doPacketMemoryStat(CSocketRef* pSocket)
     nresult = containerPtr->insertPacket(SYSTEM_PACKET_MEMORY_STAT_REPLY, &stat, sizeof(stat));
     shell_assert(nresult == ESUCCESS);
 
-    nresult = m_pNetConnector->send(containerPtr, pSocket);
+    nresult = sendReply(containerPtr, pSocket);
     return nresult;
 }
 
@@ -115,7 +132,7 @@ result_t CSysResponder::doPacketNetConnStat(CSocketRef* pSocket)
     nresult = containerPtr->insertPacket(SYSTEM_PACKET_NETCONN_STAT_REPLY, &stat, sizeof(stat));
     shell_assert(nresult == ESUCCESS);
 
-    nresult = m_pNetConnector->send(containerPtr, pSocket);
+    nresult = sendReply(containerPtr, pSocket);
     return nresult;
 }
 
@@ -139,7 +156,7 @@ result_t CSysResponder::doPacketGetLoggerChannel(CSocketRef* pSocket)
     nresult = containerPtr->insertPacket(SYSTEM_PACKET_LOGGER_CHANNEL, &channel, sizeof(channel));
     shell_assert(nresult == ESUCCESS);
 
-    nresult = m_pNetConnector->send(containerPtr, pSocket);
+    nresult = sendReply(containerPtr, pSocket);
     return nresult;
 }
 
@@ -172,7 +189,7 @@ result_t CSysResponder::doPacketLoggerEnable(CSocketRef* pSocket, CVepContainer*
     nresult = resContainerPtr->insertPacket(SYSTEM_PACKET_RESULT, &result, sizeof(result));
     shell_assert(nresult == ESUCCESS);
 
-    nresult = m_pNetConnector->send(resContainerPtr, pSocket);
+    nresult = sendReply(resContainerPtr, pSocket);
     return nresult;
 }
 
@@ -214,6 +231,10 @@ result_t CSysResponder::processPacket(CEventTcpConnRecv* pEventPacket)
         return EFAULT;
     }
 
+    /* Requests are processed one by one on the event loop thread */
+    m_compress.reset();
+    m_compress.received(pContainer);
+
     contType = pContainer->getType();
     if ( contType != VEP_CONTAINER_SYSTEM )  {
         CVepContainer::getContainerName(contType, stmp, sizeof(stmp));
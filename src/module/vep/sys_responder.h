@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 02.06.2015 10:16:26
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:23:05
+ *      Added sendReply().
  */
 
 #ifndef __CARBON_SYS_RESPONDER_H_INCLUDED__
@@ -31,6 +34,7 @@ class CSysResponder : public CModule
     private:
         CApplication*       m_pApp;
         CTcpConnector*      m_pNetConnector;
+        CVepCompressPeer    m_compress;         /* Compression accepted by the requester */
 
     public:
         CSysResponder(CApplication* pApp, CTcpConnector* pNetConnector);
@@ -44,6 +48,8 @@ class CSysResponder : public CModule
 		virtual void dump(const char* strPref = "") const;
 
     protected:
+        result_t sendReply(CVepContainer* pContainer, CSocketRef* pSocket);
+
         virtual result_t doPacketVersion(CSocketRef* pSocket);
         virtual result_t doPacketMemoryStat(CSocketRef* pSocket);
         virtual result_t doPacketNetConnStat(CSocketRef* pSocket);
@@ -10,6 +10,26 @@
  *
  *  Revision 1.0, 04.05.2015 19:32:07
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 16:53:02
+ *      Added asynchronous send/receive.
+ *
+ *  Revision 1.2, 17.10.2026 19:07:40
+ *      Send header and packets by the scatter/gather I/O,
+ *      fixed packet length in serialise() and received header copying
+ *      for the large containers in receive().
+ *
+ *  Revision 1.3, 18.10.2026 09:02:37
+ *      The received data CRC is calculated while receiving.
+ *
+ *  Revision 1.4, 18.10.2026 09:47:40
+ *      Added the container data compression (VEP_CONT_COMPRESS).
+ *
+ *  Revision 1.5, 18.10.2026 10:16:44
+ *      Packets are stored in place in the container arena.
+ *
+ *  Revision 1.6, 18.10.2026 12:38:51
+ *      Added getPacketData().
  */
 
 #include <new>
@@ -21,7 +41,12 @@
 #include "carbon/memory.h"
 #include "vep/vep.h"
 
-#define VEP_PACKETS_MAX					16
+#if CARBON_ZLIB
+#include "contact/zip.h"
+#endif /* CARBON_ZLIB */
+
+#define VEP_PACKETS_MAX					(64*1024)
+#define VEP_CONTAINER_RECV_CHUNK		(64*1024)		/* Receive/CRC step, bytes */
 
 
 /*******************************************************************************
@@ -33,16 +58,36 @@ CMutex					CVepContainer::m_tableNameLock;
 
 
 CVepContainer::CVepContainer() :
-	CNetContainer()
+	CNetContainer(),
+	m_pRecvBuffer(0),
+	m_nRecvSize(0),
+	m_nRecvCrcSize(0),
+	m_nRecvCrc(CRC16_INIT),
+	m_nCompress(0),
+	m_nCompressLevel(VEP_COMPRESS_LEVEL),
+	m_pZipBuffer(0),
+	m_nZipSize(0)
 {
-	m_arPacket.reserve(VEP_PACKETS_MAX);
+	m_pArena = m_arenaBuffer;
+	m_nArenaSize = sizeof(m_arenaBuffer);
+	m_nArenaLength = 0;
 	clear();
 }
 
 CVepContainer::CVepContainer(vep_container_type_t contType, vep_packet_type_t packType) :
-	CNetContainer()
+	CNetContainer(),
+	m_pRecvBuffer(0),
+	m_nRecvSize(0),
+	m_nRecvCrcSize(0),
+	m_nRecvCrc(CRC16_INIT),
+	m_nCompress(0),
+	m_nCompressLevel(VEP_COMPRESS_LEVEL),
+	m_pZipBuffer(0),
+	m_nZipSize(0)
 {
-	m_arPacket.reserve(VEP_PACKETS_MAX);
+	m_pArena = m_arenaBuffer;
+	m_nArenaSize = sizeof(m_arenaBuffer);
+	m_nArenaLength = 0;
 	create(contType, packType);
 }
 
@@ -56,16 +101,11 @@ CVepContainer::~CVepContainer()
  */
 void CVepContainer::clear()
 {
-	size_t		i, count;
-
-	count = getPackets();
-
-	for(i=0; i<count; i++)  {
-		SAFE_DELETE(m_arPacket[i]);
-	}
-
 	m_arPacket.clear();
+	freeArena();
 	_tbzero_object(m_header);
+	resetReceive();
+	freeCompressed();
 }
 
 /*
@@ -108,16 +148,89 @@ result_t CVepContainer::create(vep_container_type_t contType, vep_packet_type_t
 CNetContainer* CVepContainer::clone()
 {
 	dec_ptr<CVepContainer>	pContainer = new CVepContainer;
-	size_t					i, count = getPackets();
 
 	pContainer->m_header = m_header;
+	pContainer->setCompress(m_nCompress, m_nCompressLevel);
+	pContainer->copyPackets(this);
+
+	pContainer->reference();
+	return pContainer;
+}
 
+/*
+ * Copy all packets of the container (the arena is copied at once)
+ *
+ * 		pContainer		source container
+ *
+ * Raise exception on memory error
+ */
+void CVepContainer::copyPackets(const CVepContainer* pContainer)
+{
+	size_t		i, count;
+
+	shell_assert(isEmpty());
+
+	if ( expandArena(pContainer->m_nArenaLength) != ESUCCESS )  {
+		throw std::bad_alloc();
+	}
+
+	UNALIGNED_MEMCPY(m_pArena, pContainer->m_pArena, pContainer->m_nArenaLength);
+	m_nArenaLength = pContainer->m_nArenaLength;
+
+	m_arPacket = pContainer->m_arPacket;
+	count = getPackets();
 	for(i=0; i<count; i++)  {
-		pContainer->m_arPacket.push_back(new CVepPacket(*m_arPacket[i]));
+		m_arPacket[i].setArena(&m_pArena);
 	}
+}
 
-	pContainer->reference();
-	return pContainer;
+/*
+ * Make sure the arena has space for the new data
+ *
+ * 		nSize			new data size, bytes
+ *
+ * Return: ESUCCESS, ENOMEM
+ */
+result_t CVepContainer::expandArena(size_t nSize)
+{
+	size_t		newSize, size;
+	uint8_t*	pArena;
+
+	newSize = m_nArenaLength+nSize;
+	if ( newSize <= m_nArenaSize )  {
+		return ESUCCESS;
+	}
+
+	size = m_nArenaSize;
+	while ( size < newSize )  {
+		size <<= 1;
+	}
+
+	pArena = (uint8_t*)memRealloc(isInlineArena() ? NULL : m_pArena, size);
+	if ( !pArena )  {
+		log_error(L_GEN, "[vep_cont] out of memory allocating %u bytes\n", size);
+		return ENOMEM;
+	}
+
+	if ( isInlineArena() )  {
+		UNALIGNED_MEMCPY(pArena, m_arenaBuffer, m_nArenaLength);
+	}
+
+	m_pArena = pArena;
+	m_nArenaSize = size;
+
+	return ESUCCESS;
+}
+
+void CVepContainer::freeArena()
+{
+	if ( !isInlineArena() )  {
+		memFree(m_pArena);
+	}
+
+	m_pArena = m_arenaBuffer;
+	m_nArenaSize = sizeof(m_arenaBuffer);
+	m_nArenaLength = 0;
 }
 
 size_t CVepContainer::getHeadSize(const vep_container_head_t* pHead) const
@@ -134,21 +247,6 @@ size_t CVepContainer::getHeadSize(const vep_container_head_t* pHead) const
 	return size;
 }
 
-size_t CVepContainer::getDataSize() const
-{
-	uint32_t	size;
-	size_t		i, count;
-
-	size = 0;
-	count = getPackets();
-
-	for(i=0; i<count; i++)  {
-		size += m_arPacket[i]->getSize();
-	}
-
-	return size;
-}
-
 /*
  * Append a empty packet
  *
@@ -158,8 +256,8 @@ size_t CVepContainer::getDataSize() const
  */
 result_t CVepContainer::insertPacket(vep_packet_type_t packType)
 {
-	CVepPacket*		pPacket;
-	result_t		nresult;
+	vep_packet_head_t*	pHead;
+	result_t			nresult;
 
 	if ( packType == VEP_PACKET_TYPE_NULL )  {
 		log_error(L_GEN, "[vep_cont] no packet type specified\n");
@@ -171,23 +269,25 @@ result_t CVepContainer::insertPacket(vep_packet_type_t packType)
 		return ENOSPC;
 	}
 
-	pPacket = 0;
-	nresult = ESUCCESS;
+	nresult = expandArena(VEP_PACKET_HEAD_SZ);
+	if ( nresult != ESUCCESS )  {
+		return nresult;
+	}
+
 	try {
-		pPacket = new CVepPacket();
-		pPacket->create(packType);
-		m_arPacket.push_back(pPacket);
+		m_arPacket.push_back(CVepPacket(&m_pArena, m_nArenaLength));
 	}
 	catch (const std::bad_alloc& exc)  {
-		nresult = ENOMEM;
 		log_error(L_GEN, "[ver_cont] out of memory\n");
+		return ENOMEM;
 	}
 
-	if ( nresult != ESUCCESS )  {
-		SAFE_DELETE(pPacket);
-	}
+	pHead = (vep_packet_head_t*)(m_pArena+m_nArenaLength);
+	pHead->type = packType;
+	pHead->length = 0;
+	m_nArenaLength += VEP_PACKET_HEAD_SZ;
 
-	return nresult;
+	return ESUCCESS;
 }
 
 /*
@@ -217,7 +317,7 @@ result_t CVepContainer::insertPacket(vep_packet_type_t packType,
 	if ( nresult == ESUCCESS )  {
 //		nresult = m_arPacket[getPackets()-1]->putData((uint8_t*)pData+VEP_PACKET_HEAD_SZ,
 //													  nSize-VEP_PACKET_HEAD_SZ);
-		nresult = m_arPacket[getPackets()-1]->putData(pData, nSize);
+		nresult = insertData(pData, nSize, getPackets()-1);
 		if ( nresult != ESUCCESS )  {
 			deletePacket(getPackets()-1);
 		}
@@ -228,9 +328,20 @@ result_t CVepContainer::insertPacket(vep_packet_type_t packType,
 
 void CVepContainer::deletePacket(size_t index)
 {
-	if ( index < getPackets() )  {
-		delete m_arPacket[index];
+	size_t		i, count, offset, size;
+
+	count = getPackets();
+	if ( index < count )  {
+		offset = m_arPacket[index].getOffset();
+		size = m_arPacket[index].getSize();
+
+		_tmemmove(m_pArena+offset, m_pArena+offset+size, m_nArenaLength-offset-size);
+		m_nArenaLength -= size;
+
 		m_arPacket.erase(m_arPacket.begin()+index);
+		for(i=index; i<count-1; i++)  {
+			m_arPacket[i].setOffset(m_arPacket[i].getOffset()-size);
+		}
 	}
 }
 
@@ -283,7 +394,7 @@ boolean_t CVepContainer::isValid() const
 	}
 
 	for(i=0; i<count; i++)  {
-		if ( !m_arPacket[i]->isValid() )  {
+		if ( !m_arPacket[i].isValid() )  {
 			log_debug(L_GEN, "[vep_cont] packet #%d is invalid\n", i);
 			bValid = FALSE;
 			break;
@@ -293,22 +404,95 @@ boolean_t CVepContainer::isValid() const
 	return bValid;
 }
 
+/*
+ * Append data to the packet
+ *
+ * 		pData			data pointer
+ * 		nSize			data size, bytes
+ * 		index			packet index
+ *
+ * Return: ESUCCESS, EINVAL, ENOSPC, ENOMEM
+ *
+ * Note: appending to a packet other than the last one moves the next packets
+ */
 result_t CVepContainer::insertData(const void* pData, size_t nSize, size_t index)
 {
-	result_t	nresult;
+	vep_packet_head_t*	pHead;
+	size_t				i, count, end;
+	result_t			nresult;
+
+	shell_assert(pData || nSize == 0);
 
-	if ( index >= getPackets() )  {
+	count = getPackets();
+	if ( index >= count )  {
 		log_error(L_GEN, "[vep_cont] packet index %d out of range\n", index);
 		return EINVAL;
 	}
 
-	nresult = m_arPacket[index]->putData(pData, nSize);
-	return nresult;
+	if ( nSize < 1 )  {
+		return ESUCCESS;
+	}
+
+	if ( (nSize+m_arPacket[index].getSize()) > VEP_PACKET_MAX_SIZE ||
+			(nSize+m_nArenaLength) > VEP_CONTAINER_MAX_SIZE )  {
+		log_error(L_GEN, "[vep_cont] packet data overflow\n");
+		return ENOSPC;
+	}
+
+	nresult = expandArena(nSize);
+	if ( nresult != ESUCCESS )  {
+		return nresult;
+	}
+
+	end = m_arPacket[index].getOffset()+m_arPacket[index].getSize();
+	if ( end < m_nArenaLength )  {
+		_tmemmove(m_pArena+end+nSize, m_pArena+end, m_nArenaLength-end);
+		for(i=index+1; i<count; i++)  {
+			m_arPacket[i].setOffset(m_arPacket[i].getOffset()+nSize);
+		}
+	}
+
+	UNALIGNED_MEMCPY(m_pArena+end, pData, nSize);
+	m_nArenaLength += nSize;
+
+	pHead = m_arPacket[index].getHead();
+	pHead->length += nSize;
+
+	return ESUCCESS;
+}
+
+/*
+ * Copy the packet data (without the packet header) out of the container
+ *
+ * 		pBuffer			output buffer
+ * 		nSize			output buffer size, bytes
+ * 		index			packet index
+ *
+ * Return: copied bytes
+ *
+ * Note: the packet data may be unaligned in the arena, the copy is aligned
+ * 		 as the caller's buffer is
+ */
+size_t CVepContainer::getPacketData(void* pBuffer, size_t nSize, size_t index) const
+{
+	const vep_packet_head_t*	pHead;
+	size_t						length;
+
+	shell_assert(index < m_arPacket.size());
+	if ( index >= m_arPacket.size() )  {
+		return 0;
+	}
+
+	pHead = m_arPacket[index].getHead();
+	length = sh_min(nSize, (size_t)pHead->length);
+	UNALIGNED_MEMCPY(pBuffer, (const uint8_t*)pHead+VEP_PACKET_HEAD_SZ, length);
+
+	return length;
 }
 
 vep_container_head_t* CVepContainer::serialise()
 {
-	size_t		size, i, count, l, headSize;
+	size_t		size, headSize;
 	uint8_t		*pBuffer, *p;
 
 	size = getFullSize();
@@ -329,16 +513,7 @@ vep_container_head_t* CVepContainer::serialise()
 
 		UNALIGNED_MEMCPY(p, &m_header, headSize);
 		p += headSize;
-
-		count = m_arPacket.size();
-
-		for(i=0; i<count; i++)  {
-			vep_packet_head_t*	pPack = *m_arPacket[i];
-
-			l = VEP_PACKET_HEAD_SZ + m_arPacket[i]->getSize();
-			UNALIGNED_MEMCPY(p, pPack, l);
-			p += l;
-		}
+		UNALIGNED_MEMCPY(p, m_pArena, m_nArenaLength);
 	}
 
 	return (vep_container_head_t*)pBuffer;
@@ -346,7 +521,6 @@ vep_container_head_t* CVepContainer::serialise()
 
 result_t CVepContainer::unserialise(const vep_container_head_t* pHead)
 {
-	const uint8_t*		p;
 	size_t				l, headSize;
 	result_t			nresult;
 
@@ -354,25 +528,54 @@ result_t CVepContainer::unserialise(const vep_container_head_t* pHead)
 	shell_assert(pHead);
 	shell_assert(pHead->length > 0);
 
+	if ( pHead->flags&VEP_CONT_COMPRESS )  {
+		vep_container_head_t*	pPlain;
+
+		nresult = decompress(pHead, &pPlain);
+		if ( nresult == ESUCCESS )  {
+			nresult = unserialise(pPlain);
+			memFree(pPlain);
+		}
+
+		return nresult;
+	}
+
 	headSize = getHeadSize(pHead);
 	UNALIGNED_MEMCPY(&m_header, pHead, headSize);
 
-	p = ((const uint8_t*)pHead) + headSize;
+	/*
+	 * The packets are copied to the arena at once and validated in place
+	 */
+	nresult = expandArena(pHead->length);
+	if ( nresult != ESUCCESS )  {
+		clear();
+		return nresult;
+	}
+
+	UNALIGNED_MEMCPY(m_pArena, ((const uint8_t*)pHead) + headSize, pHead->length);
+	m_nArenaLength = pHead->length;
+
 	l = 0;
-	nresult = ESUCCESS;
+	while ( l < m_nArenaLength && nresult == ESUCCESS )  {
+		const vep_packet_head_t*	pPack = (const vep_packet_head_t*)(m_pArena+l);
+		size_t						lpack;
 
-	while ( l < pHead->length && nresult == ESUCCESS )  {
-		const vep_packet_head_t*	pPack = (const vep_packet_head_t*)p;
-		size_t						lpack = pPack->length+VEP_PACKET_HEAD_SZ;
+		if ( (m_nArenaLength-l) < VEP_PACKET_HEAD_SZ )  {
+			log_debug(L_GEN, "[vep_cont] truncated container, l = %u\n", l);
+			nresult = EINVAL;
+			break;
+		}
 
-		if ( (pHead->length-l) >= lpack )  {
-			nresult = insertPacket(pPack->type, p+VEP_PACKET_HEAD_SZ, lpack-VEP_PACKET_HEAD_SZ);
-			if ( nresult == ESUCCESS )  {
-				p += lpack;
+		lpack = pPack->length+VEP_PACKET_HEAD_SZ;
+		if ( (m_nArenaLength-l) >= lpack && pPack->type != VEP_PACKET_TYPE_NULL &&
+				getPackets() < VEP_PACKETS_MAX )  {
+			try {
+				m_arPacket.push_back(CVepPacket(&m_pArena, l));
 				l += lpack;
 			}
-			else {
-				nresult = EINVAL;
+			catch (const std::bad_alloc& exc)  {
+				log_error(L_GEN, "[ver_cont] out of memory\n");
+				nresult = ENOMEM;
 			}
 		}
 		else {
@@ -381,12 +584,6 @@ result_t CVepContainer::unserialise(const vep_container_head_t* pHead)
 		}
 	}
 
-	if ( nresult == ESUCCESS && l != pHead->length )  {
-		log_debug(L_GEN, "[vep_cont] incorrect packet size %u, correct %u\n",
-				  pHead->length, l);
-		nresult = EINVAL;
-	}
-
 	if ( nresult != ESUCCESS )  {
 		clear();
 	}
@@ -401,6 +598,158 @@ void CVepContainer::freeSerialised(vep_container_head_t* pHead)
 	}
 }
 
+/*
+ * Compress the finalised container data to send, the arena is
+ * streamed to the per-thread compressor
+ *
+ * Return: ESUCCESS, ENOMEM, ENOSPC (data is not compressible), ...
+ *
+ * Note: the container is sent uncompressed on any error
+ */
+result_t CVepContainer::compress()
+{
+#if CARBON_ZLIB
+	CZipStream*		pZip;
+	uint8_t*		pBuffer;
+	size_t			nSize, nBound, nZipSize;
+	uint32_t		length;
+	result_t		nresult;
+
+	freeCompressed();
+
+	pZip = CZipStream::getDeflate();
+	if ( !pZip )  {
+		return ENOMEM;
+	}
+
+	nSize = m_header.length;
+	nBound = sizeof(length) + CZipStream::getBound(nSize);
+	pBuffer = (uint8_t*)memAlloc(nBound);
+	if ( !pBuffer )  {
+		log_error(L_GEN, "[vep_cont] out of memory\n");
+		return ENOMEM;
+	}
+
+	length = (uint32_t)nSize;
+	UNALIGNED_MEMCPY(pBuffer, &length, sizeof(length));
+
+	nresult = pZip->start(pBuffer+sizeof(length), nBound-sizeof(length), m_nCompressLevel);
+
+	if ( nresult == ESUCCESS )  {
+		nresult = pZip->update(m_pArena, m_nArenaLength);
+	}
+
+	if ( nresult == ESUCCESS )  {
+		nresult = pZip->finish(&nZipSize);
+	}
+
+	if ( nresult == ESUCCESS && (sizeof(length)+nZipSize) >= nSize )  {
+		nresult = ENOSPC;
+	}
+
+	if ( nresult == ESUCCESS )  {
+		m_pZipBuffer = pBuffer;
+		m_nZipSize = sizeof(length)+nZipSize;
+		m_header.flags |= VEP_CONT_COMPRESS;
+		m_header.length = (uint32_t)m_nZipSize;
+	}
+	else {
+		if ( nresult != ENOSPC )  {
+			log_error(L_GEN, "[vep_cont] compression failed, result: %d\n", nresult);
+		}
+		memFree(pBuffer);
+	}
+
+	return nresult;
+#else /* CARBON_ZLIB */
+	return ENOSYS;
+#endif /* CARBON_ZLIB */
+}
+
+/*
+ * Decompress the received container data
+ *
+ * 		pHead			received container (VEP_CONT_COMPRESS)
+ * 		ppHead			uncompressed container [out], must be freed by memFree()
+ *
+ * Return: ESUCCESS, EINVAL, EFAULT, ENOMEM, ENOSYS
+ */
+result_t CVepContainer::decompress(const vep_container_head_t* pHead, vep_container_head_t** ppHead)
+{
+#if CARBON_ZLIB
+	CZipStream*				pZip;
+	vep_container_head_t*	pPlain;
+	const uint8_t*			pData;
+	size_t					headSize, nSize;
+	uint32_t				length;
+	result_t				nresult;
+
+	headSize = getHeadSize(pHead);
+	pData = ((const uint8_t*)pHead)+headSize;
+
+	if ( pHead->length <= sizeof(length) )  {
+		log_debug(L_GEN, "[vep_cont] truncated compressed container, size %u\n", pHead->length);
+		return EINVAL;
+	}
+
+	UNALIGNED_MEMCPY(&length, pData, sizeof(length));
+	if ( length == 0 || length > VEP_CONTAINER_MAX_SIZE )  {
+		log_error(L_GEN, "[vep_cont] container too large, size %u\n", length);
+		return EINVAL;
+	}
+
+	pZip = CZipStream::getInflate();
+	pPlain = (vep_container_head_t*)memAlloc(headSize+length);
+	if ( !pZip || !pPlain )  {
+		log_error(L_GEN, "[vep_cont] out of memory\n");
+		if ( pPlain )  {
+			memFree(pPlain);
+		}
+		return ENOMEM;
+	}
+
+	UNALIGNED_MEMCPY(pPlain, pHead, headSize);
+	pPlain->flags &= ~VEP_CONT_COMPRESS;
+	pPlain->length = length;
+
+	nresult = pZip->start(((uint8_t*)pPlain)+headSize, length);
+	if ( nresult == ESUCCESS )  {
+		nresult = pZip->update(pData+sizeof(length), pHead->length-sizeof(length));
+	}
+	if ( nresult == ESUCCESS )  {
+		nresult = pZip->finish(&nSize);
+	}
+
+	if ( nresult == ESUCCESS && nSize != length )  {
+		nresult = EFAULT;
+	}
+
+	if ( nresult == ESUCCESS )  {
+		*ppHead = pPlain;
+	}
+	else {
+		log_error(L_GEN, "[vep_cont] invalid compressed container, result: %d\n", nresult);
+		memFree(pPlain);
+	}
+
+	return nresult;
+#else /* CARBON_ZLIB */
+	shell_unused(pHead);
+	shell_unused(ppHead);
+	log_error(L_GEN, "[vep_cont] compressed containers are not supported\n");
+	return ENOSYS;
+#endif /* CARBON_ZLIB */
+}
+
+void CVepContainer::freeCompressed()
+{
+	if ( m_pZipBuffer )  {
+		memFree(m_pZipBuffer);
+		m_pZipBuffer = 0;
+	}
+	m_nZipSize = 0;
+}
+
 /*
  * Finalise a vep container creation, making a valid object
  *
@@ -415,8 +764,8 @@ result_t CVepContainer::finalise()
 	nresult = ESUCCESS;
 
 	for(i=0; i<count; i++)  {
-		nresult = m_arPacket[i]->finalise();
-		if ( nresult != ESUCCESS )  {
+		if ( !m_arPacket[i].isValid() )  {
+			nresult = EFAULT;
 			break;
 		}
 	}
@@ -429,20 +778,49 @@ result_t CVepContainer::finalise()
 }
 
 /*
- * Send a container
+ * Get the container fragments for the scatter/gather send:
+ * the header followed by the packets arena (or compressed data)
  *
- * 		socket			connected socket
- * 		hrTimeout		maximum send timeout
+ * 		arVec			fragments [out]
+ * 		pCount			IN: maximum fragments, OUT: fragment count
  *
- * Return: ESUCCESS, ETIMEDOUT, ENOMEM, EINVAL, EINTR
+ * Return: ESUCCESS, ENOSPC
  */
-result_t CVepContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr)
+result_t CVepContainer::getSendIov(struct iovec* arVec, size_t* pCount)
 {
-	vep_container_head_t*	pHead;
-	size_t					fullSize;
-	result_t	nresult;
+	if ( *pCount < 2 )  {
+		log_error(L_GEN, "[vep_cont] too many fragments 2, maximum %u\n",
+				  (unsigned)(*pCount));
+		*pCount = 0;
+		return ENOSPC;
+	}
 
-	shell_assert(socket.isOpen());
+	arVec[0].iov_base = &m_header;
+	arVec[0].iov_len = getHeadSize();
+
+	if ( m_pZipBuffer )  {
+		arVec[1].iov_base = m_pZipBuffer;
+		arVec[1].iov_len = m_nZipSize;
+	}
+	else {
+		arVec[1].iov_base = m_pArena;
+		arVec[1].iov_len = m_nArenaLength;
+	}
+
+	*pCount = 2;
+	return ESUCCESS;
+}
+
+/*
+ * Finalise and validate a container, compress the data if required
+ * and calculate the CRC over the header and all packets (the data as sent)
+ *
+ * Return: ESUCCESS, EINVAL, ...
+ */
+result_t CVepContainer::prepareSend()
+{
+	uint16_t	crc;
+	result_t	nresult;
 
 	nresult = finalise();
 	if ( nresult != ESUCCESS )  {
@@ -453,18 +831,50 @@ result_t CVepContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAdd
 		return EINVAL;
 	}
 
-	pHead = serialise();
-	if ( !pHead )  {
-		return ENOMEM;
+	freeCompressed();
+	m_header.flags &= ~VEP_CONT_COMPRESS;
+#if CARBON_ZLIB
+	m_header.flags |= VEP_CONT_COMPRESS_ACCEPT;
+#endif /* CARBON_ZLIB */
+
+	if ( m_nCompress > 0 && m_header.length >= m_nCompress )  {
+		compress();
 	}
 
-	fullSize = getFullSize();
-	pHead->crc = 0;
-	pHead->crc = m_header.crc = crc16(pHead, fullSize);
+	m_header.crc = 0;
+	crc = crc16_update(CRC16_INIT, &m_header, getHeadSize());
 
-	nresult = socket.send(pHead, fullSize, hrTimeout, dstAddr);
-	freeSerialised(pHead);
+	if ( m_pZipBuffer )  {
+		crc = crc16_update(crc, m_pZipBuffer, m_nZipSize);
+	}
+	else {
+		crc = crc16_update(crc, m_pArena, m_nArenaLength);
+	}
+
+	m_header.crc = crc;
+	return ESUCCESS;
+}
 
+/*
+ * Send a container
+ *
+ * 		socket			connected socket
+ * 		hrTimeout		maximum send timeout
+ *
+ * Return: ESUCCESS, ETIMEDOUT, ENOMEM, EINVAL, EINTR
+ */
+result_t CVepContainer::send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr)
+{
+	result_t	nresult;
+
+	shell_assert(socket.isOpen());
+
+	nresult = prepareSend();
+	if ( nresult == ESUCCESS )  {
+		nresult = sendIov(socket, hrTimeout, dstAddr);
+	}
+
+	freeCompressed();
 	return nresult;
 }
 
@@ -481,7 +891,8 @@ result_t CVepContainer::receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr*
 	vep_container_head_t*	pHead;
 	uint8_t*				p;
 	hr_time_t				hrStart;
-	size_t					size, headSize;
+	size_t					size, headSize, rest;
+	uint16_t				incrc, crc;
 	result_t				nresult;
 
 	shell_assert(socket.isOpen());
@@ -526,7 +937,7 @@ result_t CVepContainer::receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr*
 		if ( size > (sizeof(m_inBuffer)-headSize) )  {
 			pHead = (vep_container_head_t*)memAlloc(size+headSize);
 			if ( pHead != NULL )  {
-				UNALIGNED_MEMCPY(pHead, &m_header, headSize);
+				UNALIGNED_MEMCPY(pHead, m_inBuffer, headSize);
 				p = ((uint8_t*)pHead)+headSize;
 			}
 			else {
@@ -545,13 +956,26 @@ result_t CVepContainer::receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr*
 		return nresult;
 	}
 
-	nresult = socket.receive(p, &size, CSocket::readFull, hr_timeout(hrStart, hrTimeout));
-	if ( nresult == ESUCCESS )  {
-		uint16_t	incrc = pHead->crc, crc;
+	incrc = pHead->crc;
+	pHead->crc = 0;
+	crc = crc16(pHead, headSize);
+	pHead->crc = incrc;
 
-		pHead->crc = 0;
-		crc = crc16(pHead, headSize+pHead->length);
-		pHead->crc = incrc;
+	/* The data CRC is calculated by the chunks just received (cached) */
+	rest = pHead->length;
+	while ( rest > 0 )  {
+		size = sh_min(rest, (size_t)VEP_CONTAINER_RECV_CHUNK);
+		nresult = socket.receive(p, &size, CSocket::readFull, hr_timeout(hrStart, hrTimeout));
+		if ( nresult != ESUCCESS )  {
+			break;
+		}
+
+		crc = crc16_update(crc, p, size);
+		p += size;
+		rest -= size;
+	}
+
+	if ( nresult == ESUCCESS )  {
 		if ( incrc == crc )  {
 			nresult = unserialise(pHead);
 		}
@@ -567,6 +991,181 @@ result_t CVepContainer::receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr*
 	return nresult;
 }
 
+/*
+ * Send container in asynchronous mode
+ *
+ * 		socket		open socket object
+ * 		pOffset		send offset [in/out], 0 - start sending
+ *
+ * Return:
+ * 		ESUCCESS	all data have been sent
+ * 		EAGAIN		can't send all data at the moment, repeat again
+ * 		...
+ */
+result_t CVepContainer::send(CSocketAsync& socket, uint32_t* pOffset)
+{
+	result_t	nresult;
+
+	shell_assert(socket.isOpen());
+
+	if ( *pOffset == 0 )  {
+		nresult = prepareSend();
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+	nresult = sendIov(socket, pOffset);
+	if ( nresult != EAGAIN )  {
+		freeCompressed();
+	}
+
+	return nresult;
+}
+
+/*
+ * Drop a partially received container
+ */
+void CVepContainer::resetReceive()
+{
+	if ( m_pRecvBuffer )  {
+		memFree(m_pRecvBuffer);
+		m_pRecvBuffer = 0;
+	}
+	m_nRecvSize = 0;
+	m_nRecvCrcSize = 0;
+}
+
+/*
+ * Receive available container bytes
+ *
+ * 		socket			open socket object
+ * 		nSize			required full received size
+ *
+ * Return: ESUCCESS (received nSize bytes), EAGAIN, ...
+ */
+result_t CVepContainer::receiveAsync(CSocketAsync& socket, size_t nSize)
+{
+	size_t		size;
+	result_t	nresult;
+
+	size = nSize - m_nRecvSize;
+	nresult = socket.receiveAsync(getRecvBuffer() + m_nRecvSize, &size);
+	m_nRecvSize += size;
+
+	return nresult;
+}
+
+/*
+ * Receive container in asynchronous mode
+ *
+ * 		socket		open socket object
+ *
+ * Return:
+ * 		ESUCCESS	a full container has been received
+ * 		EAGAIN		partial data has been received, repeat again
+ * 		EINVAL		invalid container received
+ * 		EFAULT		container CRC error
+ * 		...
+ */
+result_t CVepContainer::receive(CSocketAsync& socket)
+{
+	vep_container_head_t*	pHead;
+	uint8_t*				pBuffer;
+	size_t					headSize, size;
+	uint16_t				incrc, crc;
+	result_t				nresult;
+
+	shell_assert(socket.isOpen());
+
+	if ( m_nRecvSize == 0 )  {
+		shell_assert(isEmpty());
+		clear();
+	}
+
+	/*
+	 * Read container header
+	 */
+	if ( m_nRecvSize < VEP_CONTAINER_HEAD_CONST_SIZE )  {
+		nresult = receiveAsync(socket, VEP_CONTAINER_HEAD_CONST_SIZE);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+	headSize = getHeadSize((vep_container_head_t*)getRecvBuffer());
+	if ( m_nRecvSize < headSize )  {
+		nresult = receiveAsync(socket, headSize);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+	}
+
+	pHead = (vep_container_head_t*)getRecvBuffer();
+	if ( m_nRecvSize == headSize )  {
+		if ( !checkHeader(pHead) ) {
+			log_debug(L_GEN, "[vep_cont] invalid container header received\n");
+			resetReceive();
+			return EINVAL;
+		}
+
+		size = pHead->length;
+		if ( size == 0 || size > VEP_CONTAINER_MAX_SIZE )  {
+			log_error(L_GEN, "[vep_cont] container too large, size %d\n", size);
+			resetReceive();
+			return EINVAL;
+		}
+
+		if ( !m_pRecvBuffer && size > (sizeof(m_inBuffer)-headSize) )  {
+			pBuffer = (uint8_t*)memAlloc(size+headSize);
+			if ( !pBuffer )  {
+				log_error(L_GEN, "[vep_cont] out of memory\n");
+				resetReceive();
+				return ENOMEM;
+			}
+
+			UNALIGNED_MEMCPY(pBuffer, m_inBuffer, headSize);
+			m_pRecvBuffer = pBuffer;
+			pHead = (vep_container_head_t*)pBuffer;
+		}
+
+		incrc = pHead->crc;
+		pHead->crc = 0;
+		m_nRecvCrc = crc16(pHead, headSize);
+		m_nRecvCrcSize = headSize;
+		pHead->crc = incrc;
+	}
+
+	/*
+	 * Read container data, the CRC is updated by the just received bytes
+	 */
+	nresult = receiveAsync(socket, headSize+pHead->length);
+	if ( m_nRecvSize > m_nRecvCrcSize )  {
+		m_nRecvCrc = crc16_update(m_nRecvCrc, getRecvBuffer()+m_nRecvCrcSize,
+								  m_nRecvSize-m_nRecvCrcSize);
+		m_nRecvCrcSize = m_nRecvSize;
+	}
+
+	if ( nresult != ESUCCESS )  {
+		return nresult;
+	}
+
+	incrc = pHead->crc;
+	crc = m_nRecvCrc;
+	if ( incrc == crc )  {
+		nresult = unserialise(pHead);
+	}
+	else {
+		log_error(L_GEN, "[vep_cont] container CRC wrong (correct %04Xh, real %04Xh), dropped\n",
+				  crc, incrc);
+		nresult = EFAULT;
+	}
+
+	resetReceive();
+
+	return nresult;
+}
+
 /*******************************************************************************
  * Debugging support
  */
@@ -806,7 +1405,7 @@ void CVepContainer::dump(const char* strPref) const
 	log_dump(strTmp);
 
 	for(i=0; i<count; i++) {
-		m_arPacket[i]->dump(m_header.type, strPref);
+		m_arPacket[i].dump(m_header.type, strPref);
 	}
 }
 
@@ -818,6 +1417,6 @@ void CVepContainer::getDump(char* strBuf, size_t length) const
 	len = _tstrlen(strBuf);
 	if ( (len+2) < length && getPackets() > 0 )  {
 		strBuf[len] = '/';
-		getPacketName(getType(), m_arPacket[0]->getType(), &strBuf[len+1], length-len-1);
+		getPacketName(getType(), m_arPacket[0].getType(), &strBuf[len+1], length-len-1);
 	}
 }
@@ -10,12 +10,48 @@
  *
  *  Revision 1.0, 22.03.2015 23:38:43
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 16:52:37
+ *      Added asynchronous send/receive.
+ *
+ *  Revision 1.2, 17.10.2026 19:06:25
+ *      Send header and packets by the scatter/gather I/O.
+ *
+ *  Revision 1.3, 18.10.2026 09:02:37
+ *      The received data CRC is calculated while receiving.
+ *
+ *  Revision 1.4, 18.10.2026 09:47:05
+ *      Added the container data compression (VEP_CONT_COMPRESS).
+ *
+ *  Revision 1.5, 18.10.2026 10:16:09
+ *      Packets are stored in place in the container arena.
+ *
+ *  Revision 1.6, 18.10.2026 11:24:12
+ *      Added isReceiving().
+ *
+ *  Revision 1.7, 18.10.2026 12:38:51
+ *      Added getPacketData(), 8 bytes aligned arena.
  */
 /*
  * VEP protocol container:
  *
  * 	1) All multi-byte data in LSB;
+ * 	2) Compressed data (VEP_CONT_COMPRESS): uint32_t uncompressed data length
+ * 	   followed by the zlib stream of the packets, the header length and CRC
+ * 	   are of the compressed data;
+ * 	3) Packets follow one by one without padding;
+ *
+ * Packet access:
  *
+ * 	The packets are stored in place in the container arena, the arena is
+ * 	reallocated and the packets are moved as packets and data are inserted.
+ * 	The pointers returned by operator[] and getPacketHead() are valid up to
+ * 	the next insertPacket(), insertData(), clear() or receive().
+ *
+ * 	The arena starts at 8 bytes boundary, a packet is aligned only if the
+ * 	sizes of all preceding packets are multiple of 8. The packet data should
+ * 	be accessed by the packed structures or copied out by getPacketData()
+ * 	on the strict alignment targets.
  */
 
 #ifndef __CARBON_VEP_CONTAINER_H_INCLUDED__
@@ -76,6 +112,14 @@ static const vep_addr_t VEP_ADDR_BROADCAST = 0xffff;
 #define VEP_CONT_RESERVED3			0x00000040
 #define VEP_CONT_RESERVED4			0x00000080
 
+#define VEP_CONT_COMPRESS_ACCEPT	0x00000100		/* Sender accepts compressed containers */
+
+/*
+ * Data compression defaults
+ */
+#define VEP_COMPRESS_THRESHOLD		256				/* Compress data from the size, bytes */
+#define VEP_COMPRESS_LEVEL			9				/* zlib compression level */
+
 typedef struct {
 	uint8_t					ident[4];		/* Identification string "veri" */
 	uint32_t				version;		/* Version number */
@@ -96,14 +140,31 @@ typedef struct {
 #define VEP_CONTAINER_HEAD_CONST_SIZE	\
 	(sizeof(vep_container_head_t)-sizeof(vep_addr_t)*2-sizeof(uint32_t)*4)
 
+#define VEP_CONTAINER_ARENA_INSIZE		256			/* Inline arena size, bytes */
+
 
 class CVepContainer : public CNetContainer
 {
 	protected:
 		vep_container_head_t		m_header;				/* Container header */
-		std::vector<CVepPacket*>	m_arPacket;				/* Packets array */
+		std::vector<CVepPacket>		m_arPacket;				/* Packet handles */
+
+		uint8_t*					m_pArena;				/* Packets (header+data) one by one */
+		size_t						m_nArenaSize;			/* Arena size, bytes */
+		size_t						m_nArenaLength;			/* Arena used size, bytes */
+		uint8_t						m_arenaBuffer[VEP_CONTAINER_ARENA_INSIZE]	/* Inline arena */
+											__attribute__ ((aligned(8)));
 
 		uint8_t						m_inBuffer[PAGE_SIZE];	/* Temporary internal buffer */
+		uint8_t*					m_pRecvBuffer;			/* Async receive buffer, 0 - m_inBuffer */
+		size_t						m_nRecvSize;			/* Async received bytes */
+		size_t						m_nRecvCrcSize;			/* Async received bytes in m_nRecvCrc */
+		uint16_t					m_nRecvCrc;				/* Async received bytes CRC */
+
+		size_t						m_nCompress;			/* Compress data from the size, 0 - disabled */
+		int							m_nCompressLevel;		/* zlib compression level */
+		uint8_t*					m_pZipBuffer;			/* Compressed data to send, 0 - not compressed */
+		size_t						m_nZipSize;				/* Compressed data size, bytes */
 
 		static vep_container_names_t	m_tableName;
 		static CMutex					m_tableNameLock;
@@ -117,14 +178,16 @@ class CVepContainer : public CNetContainer
 	public:
 		CVepPacket* operator[](size_t index) {
 			shell_assert(index < m_arPacket.size());
-			return index < m_arPacket.size() ? m_arPacket[index] : NULL;
+			return index < m_arPacket.size() ? &m_arPacket[index] : NULL;
 		}
 
 		vep_packet_head_t* getPacketHead(size_t index = 0)  {
 			shell_assert(index < m_arPacket.size());
-			return index < m_arPacket.size() ? ((vep_packet_head_t*)(*m_arPacket[index])) : 0;
+			return index < m_arPacket.size() ? m_arPacket[index].getHead() : 0;
 		}
 
+		size_t getPacketData(void* pBuffer, size_t nSize, size_t index = 0) const;
+
 		virtual result_t create(vep_container_type_t contType, vep_packet_type_t packType = VEP_PACKET_TYPE_NULL);
 		virtual void clear();
 		virtual CNetContainer* clone();
@@ -137,7 +200,7 @@ class CVepContainer : public CNetContainer
 
 		int getPacketType(size_t index = 0) const {
 			shell_assert(index < m_arPacket.size());
-			return m_arPacket[index]->getType();
+			return m_arPacket[index].getType();
 		}
 
 		virtual result_t insertPacket(vep_packet_type_t packType);
@@ -147,6 +210,25 @@ class CVepContainer : public CNetContainer
 		virtual result_t send(CSocket& socket, hr_time_t hrTimeout, const CNetAddr& dstAddr = NETADDR_NULL);
 		virtual result_t receive(CSocket& socket, hr_time_t hrTimeout, CNetAddr* pSrcAddr = NULL);
 
+		virtual result_t send(CSocketAsync& socket, uint32_t* pOffset);
+		virtual result_t receive(CSocketAsync& socket);
+		virtual boolean_t isReceiving() const { return m_nRecvSize > 0; }
+
+		virtual result_t getSendIov(struct iovec* arVec, size_t* pCount);
+
+		/*
+		 * Compress the data on send when its size is nThreshold or more
+		 * (0 - do not compress), see also CVepCompressPeer
+		 */
+		void setCompress(size_t nThreshold, int nLevel = VEP_COMPRESS_LEVEL) {
+			m_nCompress = nThreshold;
+			m_nCompressLevel = nLevel;
+		}
+
+		boolean_t isCompressAccepted() const {
+			return (m_header.flags&VEP_CONT_COMPRESS_ACCEPT) != 0;
+		}
+
 		/* VEP string table management */
 
 		virtual void dump(const char* strPref = "") const;
@@ -167,19 +249,71 @@ class CVepContainer : public CNetContainer
 	protected:
 		boolean_t checkHeader(const vep_container_head_t* pHead) const;
 		size_t getHeadSize(const vep_container_head_t* pHead = 0) const;
-		size_t getDataSize() const;
+		size_t getDataSize() const { return m_nArenaLength; }
 		size_t getFullSize() const { return getHeadSize()+getDataSize(); }
 
+		result_t prepareSend();
 		vep_container_head_t* serialise();
 		result_t unserialise(const vep_container_head_t* pHead);
 		void freeSerialised(vep_container_head_t* pBuffer);
 
+		result_t compress();
+		result_t decompress(const vep_container_head_t* pHead, vep_container_head_t** ppHead);
+		void freeCompressed();
+
+		uint8_t* getRecvBuffer() { return m_pRecvBuffer ? m_pRecvBuffer : m_inBuffer; }
+		result_t receiveAsync(CSocketAsync& socket, size_t nSize);
+		void resetReceive();
+
+		void copyPackets(const CVepContainer* pContainer);
+
 	private:
 		void deletePacket(size_t index);
+		result_t expandArena(size_t nSize);
+		void freeArena();
+		boolean_t isInlineArena() const { return m_pArena == m_arenaBuffer; }
 
 		static result_t registerPacketName(vep_container_string_table_t* pTable,
 						vep_packet_type_t type, const char* strName);
 };
 
+/*
+ * Per peer compression negotiation
+ *
+ * The containers are sent compressed only after a container with
+ * VEP_CONT_COMPRESS_ACCEPT has been received from the peer, so the peers
+ * which can not decompress receive the plain containers.
+ */
+class CVepCompressPeer
+{
+	protected:
+		size_t		m_nThreshold;			/* Compress data from the size, bytes */
+		int			m_nLevel;				/* zlib compression level */
+		boolean_t	m_bAccept;				/* Peer accepts compressed containers */
+
+	public:
+		CVepCompressPeer(size_t nThreshold = VEP_COMPRESS_THRESHOLD, int nLevel = VEP_COMPRESS_LEVEL) :
+			m_nThreshold(nThreshold),
+			m_nLevel(nLevel),
+			m_bAccept(FALSE)
+		{
+		}
+
+	public:
+		boolean_t isAccepted() const { return m_bAccept; }
+		void reset() { m_bAccept = FALSE; }
+
+		/* Call for every container received from the peer */
+		void received(const CVepContainer* pContainer) {
+			if ( pContainer->isCompressAccepted() )  {
+				m_bAccept = TRUE;
+			}
+		}
+
+		/* Call for every container to send to the peer */
+		void prepare(CVepContainer* pContainer) const {
+			pContainer->setCompress(m_bAccept ? m_nThreshold : 0, m_nLevel);
+		}
+};
 
 #endif /* __CARBON_VEP_CONTAINER_H_INCLUDED__ */
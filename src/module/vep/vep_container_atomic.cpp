@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 27.09.2016 16:36:31
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:17:30
+ *      The packets are copied by the container arena in clone().
  */
 
 #include "shell/dec_ptr.h"
@@ -51,13 +54,9 @@ CVepContainerAtomic::~CVepContainerAtomic()
 CNetContainer* CVepContainerAtomic::clone()
 {
 	dec_ptr<CVepContainerAtomic>	pContainer = new CVepContainerAtomic(m_nMaxSize);
-	size_t							i, count = getPackets();
 
 	pContainer->m_header = m_header;
-
-	for(i=0; i<count; i++)  {
-		pContainer->m_arPacket.push_back(new CVepPacket(*m_arPacket[i]));
-	}
+	pContainer->copyPackets(this);
 
 	pContainer->reference();
 	return pContainer;
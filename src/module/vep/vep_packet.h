@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 04.05.2015 00:21:52
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 10:12:48
+ *      The packet is a handle of the data stored in the container arena.
  */
 
 #ifndef __CARBON_VEP_PACKET_H_INCLUDED__
@@ -23,7 +26,6 @@
 typedef uint32_t 				vep_packet_type_t;
 
 #define VEP_PACKET_TYPE_NULL			((vep_packet_type_t)0)
-#define VEP_PACKET_INSIZE				PAGE_SIZE
 #define VEP_PACKET_HEAD_SZ				sizeof(vep_packet_head_t)
 
 /*
@@ -35,47 +37,45 @@ typedef struct {
 } __attribute__ ((packed)) vep_packet_head_t;
 
 
+/*
+ * Packet handle, the packet (header and data) is stored in place
+ * in the container arena and addressed by the offset
+ */
 class CVepPacket
 {
 	protected:
-		uint8_t				m_inBuffer[VEP_PACKET_INSIZE];	/* Inline buffer */
-		uint8_t*			m_pPack;		/* Current buffer pointer */
-		size_t				m_nSize;		/* Current maximum data size, bytes */
+		uint8_t* const*		m_ppArena;		/* Container arena pointer */
+		size_t				m_nOffset;		/* Packet offset in the arena, bytes */
 
 	public:
-		CVepPacket();
-		CVepPacket(vep_packet_type_t type);
-		CVepPacket(const CVepPacket& packet);
-		virtual ~CVepPacket();
+		CVepPacket(uint8_t* const* ppArena, size_t nOffset) :
+			m_ppArena(ppArena),
+			m_nOffset(nOffset)
+		{
+		}
 
 	public:
 		operator vep_packet_head_t*() {
-			return (vep_packet_head_t*)m_pPack;
+			return getHead();
 		}
 
-		vep_packet_head_t* getHead() {
-			return (vep_packet_head_t*)m_pPack;
+		vep_packet_head_t* getHead() const {
+			return (vep_packet_head_t*)(*m_ppArena + m_nOffset);
 		}
 
-		virtual boolean_t isValid() const;
-
-		virtual void create(vep_packet_type_t type);
-		virtual void clear();
+		size_t getOffset() const { return m_nOffset; }
+		void setOffset(size_t nOffset) { m_nOffset = nOffset; }
+		void setArena(uint8_t* const* ppArena) { m_ppArena = ppArena; }
 
-		virtual result_t putData(const void* pData, size_t nSize);
-		virtual result_t finalise();
+		boolean_t isValid() const;
 
-		virtual vep_packet_type_t getType() const { return ((vep_packet_head_t*)m_pPack)->type; }
-		virtual uint32_t getSize() const {
-			return (uint32_t)VEP_PACKET_HEAD_SZ+((vep_packet_head_t*)m_pPack)->length;
+		vep_packet_type_t getType() const { return getHead()->type; }
+		uint32_t getSize() const {
+			return (uint32_t)VEP_PACKET_HEAD_SZ+getHead()->length;
 		}
 
-		virtual void dumpData(const char* strPref = "") const;
-		virtual void dump(vep_container_type_t contType, const char* strPref = "") const;
-
-	private:
-		result_t expandBuffer(size_t nSize);
-		boolean_t isInline() const { return m_pPack == m_inBuffer; }
+		void dumpData(const char* strPref = "") const;
+		void dump(vep_container_type_t contType, const char* strPref = "") const;
 };
 
 #endif /* __CARBON_VEP_PACKET_H_INCLUDED__ */
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 19.05.2015, 21:22:52
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:21:48
+ *      Added sendReply(), the reply is compressed if the client accepts it.
  */
 
 #include "shell/hr_time.h"
@@ -42,8 +45,12 @@ result_t CVepServer::processClient(CSocketRef* pSocket)
 
 	shell_assert(pSocket->isOpen());
 
+	/* Clients are processed one by one on the listen thread */
+	m_compress.reset();
+
 	nresult = containerPtr->receive(*pSocket, m_hrRecvTimeout);
 	if ( nresult == ESUCCESS ) {
+		m_compress.received(containerPtr);
 		bResult = containerPtr->isValid();
 		if ( bResult ) {
 			/*
@@ -61,3 +68,20 @@ result_t CVepServer::processClient(CSocketRef* pSocket)
 
 	return nresult;
 }
+
+/*
+ * Send a reply container to the client
+ *
+ *      pSocket         connected client socket
+ *      pContainer      container to send
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: the container is compressed if the request came from a peer
+ *       accepting the compressed containers (see CVepCompressPeer)
+ */
+result_t CVepServer::sendReply(CSocketRef* pSocket, CVepContainer* pContainer)
+{
+	m_compress.prepare(pContainer);
+	return pContainer->send(*pSocket, m_hrRecvTimeout);
+}
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 19.05.2015 02:21:25
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:21:48
+ *      Added sendReply(), compressed replies.
  */
 
 #ifndef __CARBON_VEP_SERVER_H_INCLUDED__
@@ -20,11 +23,13 @@
 
 #include "carbon/tcp_server.h"
 #include "vep/vep.h"
+#include "vep/vep_container.h"
 
 class CVepServer : public CTcpServer
 {
 	protected:
-		hr_time_t		m_hrRecvTimeout;
+		hr_time_t			m_hrRecvTimeout;
+		CVepCompressPeer	m_compress;			/* Compression accepted by the client */
 
 	public:
 		CVepServer();
@@ -38,6 +43,8 @@ class CVepServer : public CTcpServer
 	protected:
 		virtual result_t processClient(CSocketRef* pSocket);
 		virtual void processPacket(CSocketRef* pSocket, CVepContainer* pContainer) = 0;
+
+		result_t sendReply(CSocketRef* pSocket, CVepContainer* pContainer);
 };
 
 #endif /* __CARBON_VEP_SERVER_H_INCLUDED__ */
@@ -0,0 +1,384 @@
+/*
+ *  Shell library
+ *  16-bit CRC (CRC-16/MODBUS) kernels
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 09:02:37
+ *      Initial revision, moved from utils.cpp.
+ */
+/*
+ *  Polynomial x^16 + x^15 + x^2 + 1 (0x8005, reflected 0xA001), the
+ *  register is reflected (the least significant bit is the highest power).
+ *
+ *  Kernels:
+ *  	bitwise		original 8 shifts per byte
+ *  	slice8		8 bytes per step by 8 lookup tables
+ *  	slice16		16 bytes per step by 16 lookup tables
+ *  	clmul		folding of 4 x 16 bytes per step by the carry-less
+ *  				multiplication (PCLMULQDQ), the tail by slice16
+ *
+ *  The kernel is selected on the first call by the CPU features.
+ */
+
+#include "shell/shell.h"
+#include "shell/tstring.h"
+#include "shell/utils.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__embed__)
+#define CRC16_X86				1
+#include <immintrin.h>
+#endif
+
+#define CRC16_POLY				0xA001		/* Reflected 0x8005 */
+#define CRC16_CLMUL_MIN			256			/* Minimal data size for the clmul kernel */
+
+/*
+ * Lookup tables, [k][b] - CRC of the byte b followed by k zero bytes
+ */
+typedef struct
+{
+	uint16_t	arTable[16][256];
+} crc16_table_t;
+
+typedef uint16_t (*crc16_kernel_t)(uint16_t crc, const uint8_t* p, size_t nSize);
+
+static const crc16_table_t* crc16Table()
+{
+	static crc16_table_t	table;
+	static volatile int		bReady = 0;
+	uint16_t				crc;
+	int						i, j, k;
+
+	if ( !__atomic_load_n(&bReady, __ATOMIC_ACQUIRE) )  {
+		/* A concurrent initialisation writes the same values */
+		for(i=0; i<256; i++)  {
+			crc = (uint16_t)i;
+			for(j=0; j<8; j++)  {
+				crc = (crc&1) ? (uint16_t)((crc>>1)^CRC16_POLY) : (uint16_t)(crc>>1);
+			}
+			table.arTable[0][i] = crc;
+		}
+
+		for(k=1; k<16; k++)  {
+			for(i=0; i<256; i++)  {
+				crc = table.arTable[k-1][i];
+				table.arTable[k][i] = (uint16_t)((crc>>8)^table.arTable[0][crc&0xff]);
+			}
+		}
+
+		__atomic_store_n(&bReady, 1, __ATOMIC_RELEASE);
+	}
+
+	return &table;
+}
+
+static uint16_t crc16Bitwise(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	size_t	i;
+	int		j;
+
+	for(i=0; i<nSize; i++)  {
+		crc ^= p[i];
+		for(j=0; j<8; j++)  {
+			if ( crc&1 )
+				crc = (uint16_t)((crc>>1)^CRC16_POLY);
+			else
+				crc = (uint16_t)(crc>>1);
+		}
+	}
+
+	return crc;
+}
+
+static inline uint16_t crc16Bytes(const crc16_table_t* pTable, uint16_t crc,
+								  const uint8_t* p, size_t nSize)
+{
+	while ( nSize > 0 )  {
+		crc = (uint16_t)((crc>>8)^pTable->arTable[0][(crc^*p)&0xff]);
+		p++; nSize--;
+	}
+
+	return crc;
+}
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+
+#define CRC16_SLICE8(__t, __w, __k)	\
+	((__t)[(__k)+7][(__w)&0xff] ^ (__t)[(__k)+6][((__w)>>8)&0xff] ^ \
+	 (__t)[(__k)+5][((__w)>>16)&0xff] ^ (__t)[(__k)+4][((__w)>>24)&0xff] ^ \
+	 (__t)[(__k)+3][((__w)>>32)&0xff] ^ (__t)[(__k)+2][((__w)>>40)&0xff] ^ \
+	 (__t)[(__k)+1][((__w)>>48)&0xff] ^ (__t)[(__k)+0][(__w)>>56])
+
+static uint16_t crc16Slice8(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	const crc16_table_t*	pTable = crc16Table();
+	uint64_t				w;
+
+	while ( nSize >= 8 )  {
+		_tmemcpy(&w, p, sizeof(w));
+		w ^= crc;
+		crc = CRC16_SLICE8(pTable->arTable, w, 0);
+		p += 8; nSize -= 8;
+	}
+
+	return crc16Bytes(pTable, crc, p, nSize);
+}
+
+static uint16_t crc16Slice16(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	const crc16_table_t*	pTable = crc16Table();
+	uint64_t				w1, w2;
+
+	while ( nSize >= 16 )  {
+		_tmemcpy(&w1, p, sizeof(w1));
+		_tmemcpy(&w2, p+8, sizeof(w2));
+		w1 ^= crc;
+		crc = CRC16_SLICE8(pTable->arTable, w1, 8) ^ CRC16_SLICE8(pTable->arTable, w2, 0);
+		p += 16; nSize -= 16;
+	}
+
+	if ( nSize >= 8 )  {
+		_tmemcpy(&w1, p, sizeof(w1));
+		w1 ^= crc;
+		crc = CRC16_SLICE8(pTable->arTable, w1, 0);
+		p += 8; nSize -= 8;
+	}
+
+	return crc16Bytes(pTable, crc, p, nSize);
+}
+
+#else /* __BYTE_ORDER == __LITTLE_ENDIAN */
+
+static uint16_t crc16Slice8(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	return crc16Bytes(crc16Table(), crc, p, nSize);
+}
+
+#define crc16Slice16		crc16Slice8
+
+#endif /* __BYTE_ORDER == __LITTLE_ENDIAN */
+
+#if CRC16_X86
+
+/*
+ * Fold a 128-bit remainder forward over the next data block
+ *
+ * The block bits are reflected, the low qword holds x^127..x^64. The
+ * constants are x^(d+63) mod P (low qword) and x^(d-1) mod P (high qword)
+ * for the folding distance d bits, reflected in 64 bits; the extra power
+ * -1 compensates the 1 bit shift of the reflected product.
+ */
+__attribute__((target("sse2,pclmul")))
+static inline __m128i crc16Fold(__m128i x, __m128i k, __m128i data)
+{
+	return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+									   _mm_clmulepi64_si128(x, k, 0x11)), data);
+}
+
+__attribute__((target("sse2,pclmul")))
+static uint16_t crc16Clmul(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	const __m128i	k512 = _mm_set_epi64x((long long)0x8101000000000000ULL,
+										  (long long)0xc450000000000000ULL);
+	const __m128i	k128 = _mm_set_epi64x((long long)0xc100000000000000ULL,
+										  (long long)0xccd0000000000000ULL);
+	__m128i			x0, x1, x2, x3;
+	uint8_t			arRest[16];
+
+	if ( nSize < CRC16_CLMUL_MIN )  {
+		return crc16Slice16(crc, p, nSize);
+	}
+
+	/* The initial register value is added to the first message bits */
+	x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)p), _mm_cvtsi32_si128(crc));
+	x1 = _mm_loadu_si128((const __m128i*)(p+16));
+	x2 = _mm_loadu_si128((const __m128i*)(p+32));
+	x3 = _mm_loadu_si128((const __m128i*)(p+48));
+	p += 64; nSize -= 64;
+
+	while ( nSize >= 64 )  {
+		x0 = crc16Fold(x0, k512, _mm_loadu_si128((const __m128i*)p));
+		x1 = crc16Fold(x1, k512, _mm_loadu_si128((const __m128i*)(p+16)));
+		x2 = crc16Fold(x2, k512, _mm_loadu_si128((const __m128i*)(p+32)));
+		x3 = crc16Fold(x3, k512, _mm_loadu_si128((const __m128i*)(p+48)));
+		p += 64; nSize -= 64;
+	}
+
+	x0 = crc16Fold(x0, k128, x1);
+	x0 = crc16Fold(x0, k128, x2);
+	x0 = crc16Fold(x0, k128, x3);
+
+	while ( nSize >= 16 )  {
+		x0 = crc16Fold(x0, k128, _mm_loadu_si128((const __m128i*)p));
+		p += 16; nSize -= 16;
+	}
+
+	/* The remainder is congruent to the folded data, CRC it by the tables */
+	_mm_storeu_si128((__m128i*)arRest, x0);
+	crc = crc16Slice16(0, arRest, sizeof(arRest));
+
+	return crc16Slice16(crc, p, nSize);
+}
+
+#endif /* CRC16_X86 */
+
+static uint16_t crc16Resolve(uint16_t crc, const uint8_t* p, size_t nSize);
+
+static crc16_kernel_t	g_crc16Kernel = crc16Resolve;
+static crc16_isa_t		g_crc16Isa = CRC16_BITWISE;
+
+/*
+ * Select the best kernel on the first call
+ */
+static uint16_t crc16Resolve(uint16_t crc, const uint8_t* p, size_t nSize)
+{
+	if ( !crc16_set_isa(CRC16_CLMUL) )  {
+		crc16_set_isa(CRC16_SLICE16);
+	}
+
+	return g_crc16Kernel(crc, p, nSize);
+}
+
+/*
+ * Force the kernel implementation
+ *
+ * 		isa			kernel to use
+ *
+ * Return: FALSE if the CPU does not support the kernel
+ */
+boolean_t crc16_set_isa(crc16_isa_t isa)
+{
+	crc16_kernel_t	kernel;
+
+	switch ( isa )  {
+		case CRC16_BITWISE:
+			kernel = crc16Bitwise;
+			break;
+
+		case CRC16_SLICE8:
+			crc16Table();
+			kernel = crc16Slice8;
+			break;
+
+		case CRC16_SLICE16:
+			crc16Table();
+			kernel = crc16Slice16;
+			break;
+
+#if CRC16_X86
+		case CRC16_CLMUL:
+			__builtin_cpu_init();
+			if ( !__builtin_cpu_supports("pclmul") || !__builtin_cpu_supports("sse2") )  {
+				return FALSE;
+			}
+			crc16Table();
+			kernel = crc16Clmul;
+			break;
+#endif /* CRC16_X86 */
+
+		default:
+			return FALSE;
+	}
+
+	g_crc16Isa = isa;
+	g_crc16Kernel = kernel;
+	return TRUE;
+}
+
+crc16_isa_t crc16_get_isa()
+{
+	if ( g_crc16Kernel == crc16Resolve )  {
+		crc16Resolve(CRC16_INIT, NULL, 0);
+	}
+
+	return g_crc16Isa;
+}
+
+const char* crc16_isa_name(crc16_isa_t isa)
+{
+	static const char* arName[] = { "bitwise", "slice8", "slice16", "clmul" };
+
+	return (size_t)isa < ARRAY_SIZE(arName) ? arName[isa] : "*ERROR*";
+}
+
+/*
+ * Continue a 16-bit CRC calculation over the next data block
+ *
+ *      crc         crc of the previous blocks (CRC16_INIT for the first block)
+ *      pData       data pointer
+ *      nSize       data size, bytes
+ *
+ * Return: crc16
+ */
+uint16_t crc16_update(uint16_t crc, const void* pData, size_t nSize)
+{
+	return g_crc16Kernel(crc, (const uint8_t*)pData, nSize);
+}
+
+/*
+ * Calculate a 16-bit CRC
+ *
+ *      pData       data pointer
+ *      nSize       data size, bytes
+ *
+ * Return: crc16
+ */
+uint16_t crc16(const void* pData, size_t nSize)
+{
+	return crc16_update(CRC16_INIT, pData, nSize);
+}
+
+/*
+ * Multiply the reflected polynomials modulo P
+ */
+static uint16_t crc16Multiply(uint16_t a, uint16_t b)
+{
+	uint16_t	r = 0;
+	int			i;
+
+	/* Horner scheme from x^15 (bit 0) down to x^0 (bit 15) of b */
+	for(i=15; i>=0; i--)  {
+		/* r *= x */
+		r = (r&1) ? (uint16_t)((r>>1)^CRC16_POLY) : (uint16_t)(r>>1);
+		if ( b&(1U<<(15-i)) )  {
+			r ^= a;
+		}
+	}
+
+	return r;
+}
+
+/*
+ * Combine the CRCs of two adjacent data blocks
+ *
+ * 		crc1		crc16() of the first block
+ * 		crc2		crc16() of the second block
+ * 		nSize2		second block size, bytes
+ *
+ * Return: crc16() of the both blocks
+ *
+ * Note: allows the CRC of a large buffer to be calculated by the parts in parallel
+ */
+uint16_t crc16_combine(uint16_t crc1, uint16_t crc2, size_t nSize2)
+{
+	uint16_t	shift = 0x8000;			/* x^0 */
+	uint16_t	square = 0x0080;		/* x^8 */
+	size_t		n = nSize2;
+
+	/* shift = x^(8*nSize2) mod P */
+	while ( n != 0 )  {
+		if ( n&1 )  {
+			shift = crc16Multiply(shift, square);
+		}
+		square = crc16Multiply(square, square);
+		n >>= 1;
+	}
+
+	/* crc(A|B) = crc(B, init 0) + (crc(A)*x^8n) = crc2 + (crc1 + init)*x^8n */
+	return (uint16_t)(crc2 ^ crc16Multiply((uint16_t)(crc1^CRC16_INIT), shift));
+}
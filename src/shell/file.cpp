@@ -19,6 +19,9 @@
  *
  *  Revision 1.3, 27.02.2018 16:24:00
  *  	Added flag CFile::fileTruncate to the CFile::writeFile().
+ *
+ *  Revision 1.4, 17.10.2026 23:52:06
+ *  	Added scatter/gather CFileAsync::writevAsync() and CFile::writev().
  */
 
 #include <fcntl.h>
@@ -505,6 +508,82 @@ result_t CFileAsync::writeAsync(const void* pBuffer, size_t* pSize)
 	return nresult;
 }
 
+/*
+ * Write a fragmented data asynchronous (scatter/gather)
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		pOffset			IN: already written bytes of the whole data (0 - start writing),
+ * 						OUT: written bytes
+ *
+ * Return:
+ * 		ESUCCESS		all data has been written
+ * 		EAGAIN			partial data has been written, repeat with the updated offset
+ * 		EBADF			file is not open
+ * 		ENOSPC			can't write data (possible out of space)
+ * 		...
+ */
+result_t CFileAsync::writevAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset)
+{
+	struct iovec	arIov[FILE_IOV_MAX];
+	size_t			index, offset, length, n;
+	ssize_t			len;
+	result_t		nresult;
+
+	if ( !isOpen() )  {
+		return EBADF;
+	}
+
+	/* Skip written fragments */
+	index = 0;
+	offset = *pOffset;
+	while ( index < nVec && offset >= arVec[index].iov_len )  {
+		offset -= arVec[index].iov_len;
+		index++;
+	}
+
+	nresult = ESUCCESS;
+
+	while ( index < nVec )  {
+		length = 0;
+		for(n=0; n<FILE_IOV_MAX && (index+n)<nVec; n++)  {
+			arIov[n] = arVec[index+n];
+			length += arIov[n].iov_len;
+		}
+
+		/* First fragment may be written partially */
+		arIov[0].iov_base = (uint8_t*)arIov[0].iov_base + offset;
+		arIov[0].iov_len -= offset;
+		length -= offset;
+
+		len = ::writev(m_hFile, arIov, (int)n);
+		if ( len < 0 )  {
+			nresult = errno;
+			if ( errno != EAGAIN )  {
+				log_debug(L_FILE, "[file] write %d bytes failed, file: %s, result: %d\n",
+						  length, m_strFile, nresult);
+			}
+			break;
+		}
+
+		if ( len == 0 && length > 0 )  {
+			log_debug(L_FILE, "[file] write %d bytes returns ZERO, file: %s, set ENOSPC error\n",
+					  length, m_strFile);
+			nresult = ENOSPC;
+			break;
+		}
+
+		*pOffset += len;
+		offset += len;
+		while ( index < nVec && offset >= arVec[index].iov_len )  {
+			offset -= arVec[index].iov_len;
+			index++;
+		}
+	}
+
+	return nresult;
+}
+
 /*
  * Execute a control request on device
  *
@@ -1055,6 +1134,47 @@ result_t CFile::write(const void* pBuffer, size_t size)
 	return nresult;
 }
 
+/*
+ * Write a fragmented data (scatter/gather)
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		hrTimeout		maximum timeout (HR_0: write forever)
+ *
+ * Return: ESUCCESS, EINTR, ECANCELED, EBADF, ENOSPC, ...
+ */
+result_t CFile::writev(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout)
+{
+	size_t			size, offset, i;
+	result_t		nresult;
+	hr_time_t		hrStart, hrIterTimeout;
+	short			revents;
+
+	if ( !isOpen() )  {
+		return EBADF;
+	}
+
+	size = 0;
+	for(i=0; i<nVec; i++)  {
+		size += arVec[i].iov_len;
+	}
+
+	offset = 0;
+	hrStart = hr_time_now();
+	nresult = size ? EAGAIN : ESUCCESS;
+
+	while ( offset < size && nresult == EAGAIN )  {
+		hrIterTimeout = hrTimeout ? hr_timeout(hrStart, hrTimeout) : HR_FOREVER;
+
+		nresult = select(hrIterTimeout, CFile::filePollWrite, &revents);
+		if ( nresult == ESUCCESS )  {
+			nresult = writevAsync(arVec, nVec, &offset);
+		}
+	}
+
+	return nresult;
+}
+
 result_t CFile::writeLine(const char* strBuffer)
 {
 	size_t		length;
@@ -24,6 +24,9 @@
  *  Revision 1.4, 28.05.2018 11:04:18
  *  	Renamed setHandle() => attachHandle()/detachHandle(),
  *  	Added setBlocking().
+ *
+ *  Revision 1.5, 17.10.2026 23:52:06
+ *  	Added scatter/gather CFileAsync::writevAsync() and CFile::writev().
  */
 
 #ifndef __SHELL_FILE_H_INCLUDED__
@@ -31,12 +34,14 @@
 
 #include <termios.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 #include "shell/types.h"
 #include "shell/hr_time.h"
 #include "shell/breaker.h"
 
 #define PATH_SEPARATOR					'/'
+#define FILE_IOV_MAX					64			/* Maximum fragments per writev() call */
 
 /*
  * Asynchronous file I/O operations
@@ -70,6 +75,7 @@ class CFileAsync
 		result_t readLineAsync(void* pBuffer, size_t nPreSize, size_t* pSize,
 								const char* strEol);
 		result_t writeAsync(const void* pBuffer, size_t* pSize);
+		result_t writevAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset);
 
 		virtual result_t setPos(off_t offset, int options);
 		virtual result_t getPos(off_t* pOffset) const;
@@ -131,6 +137,7 @@ class CFile : public CFileAsync
 		virtual result_t readLine(void* pBuffer, size_t* pSize, const char* strEol, hr_time_t hrTimeout = HR_0);
 		virtual result_t write(const void* pBuffer, size_t* pSize, hr_time_t hrTimeout = HR_0);
 		virtual result_t write(const void* pBuffer, size_t size);
+		virtual result_t writev(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout = HR_0);
 		virtual result_t writeLine(const char* strBuffer);
 
 		virtual result_t select(hr_time_t hrTimeout, int options, short* prevents = 0);
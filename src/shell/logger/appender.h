@@ -11,12 +11,17 @@
  *  Revision 1.0, 21.01.2021 16:35:29
  *      Initial revision.
  *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added appendv() batch append.
  */
 
 #ifndef __SHELL_LOGGER_APPENDER_H_INCLUDED__
 #define __SHELL_LOGGER_APPENDER_H_INCLUDED__
 
+#include <sys/uio.h>
+
 #include "shell/types.h"
+#include "shell/error.h"
 
 class CAppender
 {
@@ -30,6 +35,28 @@ class CAppender
 		virtual result_t init() = 0;
 		virtual void terminate() = 0;
 		virtual result_t append(const void* pData, size_t nLength) = 0;
+
+		/*
+		 * Send a number of strings to the appender target
+		 *
+		 * 		arIov		strings to write
+		 * 		count		string count
+		 *
+		 * Return: ESUCCESS, ...
+		 */
+		virtual result_t appendv(const struct iovec* arIov, size_t count) {
+			result_t	nresult = ESUCCESS, nr;
+			size_t		i;
+
+			for(i=0; i<count; i++)  {
+				nr = append(arIov[i].iov_base, arIov[i].iov_len);
+				if ( nr != ESUCCESS )  {
+					nresult = nr;
+				}
+			}
+
+			return nresult;
+		}
 };
 
 #endif /* __SHELL_LOGGER_APPENDER_H_INCLUDED__ */
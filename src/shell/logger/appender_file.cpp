@@ -10,10 +10,15 @@
  *
  *  Revision 1.0, 25.08.2015 17:16:55
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added appendv(), a batch is written by a single writev().
  */
 
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 #include "shell/tstdio.h"
 #include "shell/logger/appender_file.h"
@@ -72,25 +77,16 @@ void CAppenderFile::makeFilename(char* strFilename, int index) const
 }
 
 /*
- * Send a single string to the appender
+ * Rotate the log files if the current file reaches the maximum size
  *
- * 		pData		data to write
- * 		nLength		length of data, bytes
- *
- * Return: ESUCCESS, EIO, ...
+ * Return: ESUCCESS, ...
  */
-result_t CAppenderFile::append(const void* pData, size_t nLength)
+result_t CAppenderFile::rotate()
 {
 	static boolean_t	wasError = FALSE;
-	result_t			nresult;
+	result_t			nresult = ESUCCESS;
 	int					retVal;
 
-	nresult = CLogger::appendFile(m_strFilename, pData, nLength);
-	if ( nresult != ESUCCESS ) {
-		return nresult;
-	}
-
-	m_nSize += nLength;
 	if ( m_nSize >= m_nFileSizeMax )  {
 		/* Log file reaches the maximum size */
 		char	strFilename1[APPENDER_FILENAME_MAX];
@@ -122,3 +118,66 @@ result_t CAppenderFile::append(const void* pData, size_t nLength)
 
 	return nresult;
 }
+
+/*
+ * Send a single string to the appender
+ *
+ * 		pData		data to write
+ * 		nLength		length of data, bytes
+ *
+ * Return: ESUCCESS, EIO, ...
+ */
+result_t CAppenderFile::append(const void* pData, size_t nLength)
+{
+	result_t	nresult;
+
+	nresult = CLogger::appendFile(m_strFilename, pData, nLength);
+	if ( nresult != ESUCCESS ) {
+		return nresult;
+	}
+
+	m_nSize += nLength;
+	return rotate();
+}
+
+/*
+ * Send a number of strings to the appender by a single write
+ *
+ * 		arIov		strings to write
+ * 		count		string count
+ *
+ * Return: ESUCCESS, EIO, ...
+ */
+result_t CAppenderFile::appendv(const struct iovec* arIov, size_t count)
+{
+	int			handle;
+	ssize_t		nWritten;
+	size_t		i, nLength = 0;
+	result_t	nresult = ESUCCESS;
+
+	for(i=0; i<count; i++)  {
+		nLength += arIov[i].iov_len;
+	}
+
+	if ( nLength == 0 )  {
+		return ESUCCESS;
+	}
+
+	handle = ::open(m_strFilename, O_CREAT|O_WRONLY|O_APPEND, (S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH));
+	if ( handle < 0 )  {
+		return errno;
+	}
+
+	nWritten = ::writev(handle, arIov, (int)count);
+	if ( nWritten < (ssize_t)nLength )  {
+		nresult = nWritten < 0 ? errno : EIO;
+	}
+	::close(handle);
+
+	if ( nWritten > 0 )  {
+		m_nSize += (size_t)nWritten;
+		nresult_join(nresult, rotate());
+	}
+
+	return nresult;
+}
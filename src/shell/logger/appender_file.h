@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 26.08.2015 11:29:37
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added appendv().
  */
 
 #ifndef __SHELL_LOGGER_APPENDER_FILE_H_INCLUDED__
@@ -42,11 +45,13 @@ class CAppenderFile : public CAppender
 
 	protected:
 		void makeFilename(char* strFilename, int index) const;
+		result_t rotate();
 
 	public:
 		virtual result_t init();
 		virtual void terminate();
 		virtual result_t append(const void* pData, size_t nLength);
+		virtual result_t appendv(const struct iovec* arIov, size_t count);
 };
 
 #endif /* __SHELL_LOGGER_APPENDER_FILE_H_INCLUDED__ */
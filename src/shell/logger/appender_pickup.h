@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 26.08.2015 11:37:59
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Per string appendv().
  */
 
 #ifndef __SHELL_LOGGER_APPENDER_PICKUP_H_INCLUDED__
@@ -46,6 +49,10 @@ class CAppenderPickup : public CAppenderFile
 		virtual result_t init();
 		virtual void terminate();
 		virtual result_t append(const void* pData, size_t nLength);
+		virtual result_t appendv(const struct iovec* arIov, size_t count) {
+			/* Each string is checked against the pickup file limits */
+			return CAppender::appendv(arIov, count);
+		}
 
 		result_t getBlock(void* pBuffer, size_t* pSize);
 		void getBlockConfirm(size_t nLength);
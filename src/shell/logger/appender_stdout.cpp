@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 25.08.2015 16:27:30
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added appendv(), a single flush per batch.
  */
 
 #include "shell/logger/appender_stdout.h"
@@ -34,14 +37,14 @@ void CAppenderStdout::terminate()
 }
 
 /*
- * Send a single string to the appender target
+ * Write a single string to the output stream
  *
  * 		pData		data to write
  * 		nLength		length of data, bytes
  *
  * Return: ESUCCESS, EIO
  */
-result_t CAppenderStdout::append(const void* pData, size_t nLength)
+result_t CAppenderStdout::write(const void* pData, size_t nLength)
 {
 	const char*	s = (const char*)pData;
 	size_t		len, l;
@@ -62,6 +65,44 @@ result_t CAppenderStdout::append(const void* pData, size_t nLength)
 		}
 	}
 
+	return nresult;
+}
+
+/*
+ * Send a single string to the appender target
+ *
+ * 		pData		data to write
+ * 		nLength		length of data, bytes
+ *
+ * Return: ESUCCESS, EIO
+ */
+result_t CAppenderStdout::append(const void* pData, size_t nLength)
+{
+	result_t	nresult;
+
+	nresult = write(pData, nLength);
+	flushAppender();
+
+	return nresult;
+}
+
+/*
+ * Send a number of strings to the appender target
+ *
+ * 		arIov		strings to write
+ * 		count		string count
+ *
+ * Return: ESUCCESS, EIO
+ */
+result_t CAppenderStdout::appendv(const struct iovec* arIov, size_t count)
+{
+	result_t	nresult = ESUCCESS;
+	size_t		i;
+
+	for(i=0; i<count; i++)  {
+		nresult_join(nresult, write(arIov[i].iov_base, arIov[i].iov_len));
+	}
+
 	flushAppender();
 
 	return nresult;
@@ -10,6 +10,9 @@
  *
  *  Revision 1.0, 25.08.2015 16:27:30
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added appendv(), a single flush per batch.
  */
 
 #ifndef __SHELL_LOGGER_APPENDER_STDOUT_H_INCLUDED__
@@ -39,10 +42,13 @@ class CAppenderStdout : public CAppender
 			::fflush(m_outStream);
 		}
 
+		result_t write(const void* pData, size_t nLength);
+
 	public:
 		virtual result_t init();
 		virtual void terminate();
 		virtual result_t append(const void* pData, size_t nLength);
+		virtual result_t appendv(const struct iovec* arIov, size_t count);
 };
 
 #endif /* __SHELL_LOGGER_APPENDER_STDOUT_H_INCLUDED__ */
@@ -0,0 +1,680 @@
+/*
+ *  Shell library
+ *  Logger binary flight recorder
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 07:26:44
+ *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:04:37
+ *      Rings of the finished threads are released and reused,
+ *      string arguments are recorded up to the format precision.
+ */
+
+#include <stdlib.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "shell/defines.h"
+#include "shell/tstring.h"
+#include "shell/memory.h"
+#include "shell/assert.h"
+#include "shell/logger/flight_recorder.h"
+
+/* Ring of the current thread */
+static __thread const CFlightRecorder*	t_pRecorder = nullptr;
+static __thread flr_ring_t*				t_pRing = nullptr;
+
+/*
+ * Parse the printf() format string arguments
+ *
+ * 		strFormat		format string
+ * 		arArg			argument types [out], FLR_ARG_MAX items
+ * 		arPrecision		argument precisions [out], FLR_ARG_MAX items (may be NULL):
+ * 						0..FLR_ARG_STRING_MAX, FLR_PRECISION_NONE or FLR_PRECISION_ARG
+ *
+ * Return: argument count, up to FLR_ARG_MAX
+ */
+size_t flr_parse_format(const char* strFormat, uint8_t* arArg, uint8_t* arPrecision)
+{
+	const char*		f = strFormat;
+	size_t			count = 0, nPrecision;
+	int				nLong;
+	boolean_t		bLongDouble;
+	uint8_t			precision;
+	char			c;
+
+	while ( (c=*f++) != '\0' && count < FLR_ARG_MAX )  {
+		if ( c != '%' )  {
+			continue;
+		}
+
+		if ( *f == '%' )  {
+			f++;
+			continue;
+		}
+
+		/* Flags */
+		while ( *f != '\0' && _tstrchr("-+ #0'", *f) != NULL )  {
+			f++;
+		}
+
+		/* Width */
+		if ( *f == '*' )  {
+			arArg[count++] = FLR_ARG_INT;
+			f++;
+		}
+		while ( *f >= '0' && *f <= '9' )  {
+			f++;
+		}
+
+		/* Precision */
+		precision = FLR_PRECISION_NONE;
+		if ( *f == '.' )  {
+			f++;
+			nPrecision = 0;
+			if ( *f == '*' && count < FLR_ARG_MAX )  {
+				arArg[count++] = FLR_ARG_INT;
+				precision = FLR_PRECISION_ARG;
+				f++;
+			}
+			while ( *f >= '0' && *f <= '9' )  {
+				nPrecision = sh_min(nPrecision*10 + (*f-'0'), (size_t)FLR_ARG_STRING_MAX);
+				precision = (uint8_t)nPrecision;
+				f++;
+			}
+			if ( precision == FLR_PRECISION_NONE )  {
+				/* '.' alone is zero precision */
+				precision = 0;
+			}
+		}
+
+		if ( count >= FLR_ARG_MAX )  {
+			break;
+		}
+
+		/* Length modifier */
+		nLong = 0;
+		bLongDouble = FALSE;
+		for(;;)  {
+			c = *f;
+			if ( c == 'l' )  {
+				nLong++;
+			}
+			else if ( c == 'h' )  {
+				/* Promoted to int */
+			}
+			else if ( c == 'L' )  {
+				bLongDouble = TRUE;
+			}
+			else if ( c == 'q' || c == 'j' )  {
+				nLong = 2;
+			}
+			else if ( c == 'z' || c == 't' )  {
+				nLong = sizeof(size_t) == sizeof(long long) && sizeof(long) != sizeof(long long) ? 2 : 1;
+			}
+			else {
+				break;
+			}
+			f++;
+		}
+
+		if ( arPrecision != NULL )  {
+			arPrecision[count] = precision;
+		}
+
+		/* Conversion */
+		switch ( (c=*f) )  {
+			case 'd':
+			case 'i':
+				arArg[count++] = nLong > 1 ? FLR_ARG_LLONG : (nLong > 0 ? FLR_ARG_LONG : FLR_ARG_INT);
+				break;
+
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+				arArg[count++] = nLong > 1 ? FLR_ARG_ULLONG : (nLong > 0 ? FLR_ARG_ULONG : FLR_ARG_UINT);
+				break;
+
+			case 'c':
+				arArg[count++] = FLR_ARG_INT;
+				break;
+
+			case 'e': case 'E':
+			case 'f': case 'F':
+			case 'g': case 'G':
+			case 'a': case 'A':
+				arArg[count++] = bLongDouble ? FLR_ARG_LDOUBLE : FLR_ARG_DOUBLE;
+				break;
+
+			case 's':
+				arArg[count++] = nLong > 0 ? FLR_ARG_PTR : FLR_ARG_STRING;
+				break;
+
+			case 'p':
+			case 'n':
+				arArg[count++] = FLR_ARG_PTR;
+				break;
+
+			case '\0':
+				return count;
+
+			default:
+				/* '%m' and unknown conversions have no argument */
+				break;
+		}
+
+		f++;
+	}
+
+	return count;
+}
+
+/*******************************************************************************
+ * CFlightRecorder class
+ */
+
+CFlightRecorder::CFlightRecorder() :
+	m_pMap(nullptr),
+	m_nMapSize(0),
+	m_pHeader(nullptr),
+	m_arString(nullptr),
+	m_pStrings(nullptr),
+	m_pRings(nullptr)
+{
+	m_strFilename[0] = '\0';
+}
+
+CFlightRecorder::~CFlightRecorder()
+{
+	terminate();
+}
+
+/*
+ * Create the recorder file
+ *
+ * 		strFilename		recorder full filename
+ * 		nRingSize		ring size per thread, bytes (rounded up to power of 2)
+ * 		nThreadMax		maximum recorded threads
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CFlightRecorder::init(const char* strFilename, size_t nRingSize, size_t nThreadMax)
+{
+	size_t		nSize;
+	int			handle, retVal;
+	void*		pMap;
+	result_t	nresult = ESUCCESS;
+
+	if ( m_pMap != nullptr )  {
+		return EEXIST;
+	}
+
+	nSize = 4096;
+	while ( nSize < nRingSize || nSize < FLR_RECORD_MAX*4 )  {
+		nSize <<= 1;
+	}
+	nRingSize = nSize;
+	nThreadMax = sh_max(nThreadMax, (size_t)1);
+
+	m_nMapSize = sizeof(flr_header_t) + FLR_STRING_SIZE + nThreadMax*(sizeof(flr_ring_t)+nRingSize);
+
+	m_arString = (flr_string_t*)::calloc(FLR_FORMAT_HASH_SIZE, sizeof(flr_string_t));
+	if ( m_arString == nullptr )  {
+		return ENOMEM;
+	}
+
+	handle = ::open(strFilename, O_CREAT|O_RDWR|O_TRUNC, (S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH));
+	if ( handle < 0 )  {
+		nresult = errno;
+		CLogger::syslog("[flight_recorder] failed to create '%s', result: %d\n", strFilename, nresult);
+		SAFE_FREE(m_arString);
+		return nresult;
+	}
+
+	retVal = ::ftruncate(handle, (off_t)m_nMapSize);
+	if ( retVal == 0 )  {
+		pMap = ::mmap(NULL, m_nMapSize, PROT_READ|PROT_WRITE, MAP_SHARED, handle, 0);
+		if ( pMap != MAP_FAILED )  {
+			m_pMap = (uint8_t*)pMap;
+		}
+		else {
+			nresult = errno;
+		}
+	}
+	else {
+		nresult = errno;
+	}
+	::close(handle);
+
+	if ( nresult == ESUCCESS )  {
+		retVal = pthread_key_create(&m_keyRing, releaseRing);
+		if ( retVal != 0 )  {
+			nresult = retVal;
+			::munmap(m_pMap, m_nMapSize);
+			m_pMap = nullptr;
+		}
+	}
+
+	if ( nresult != ESUCCESS )  {
+		CLogger::syslog("[flight_recorder] failed to map '%s', result: %d\n", strFilename, nresult);
+		::unlink(strFilename);
+		SAFE_FREE(m_arString);
+		return nresult;
+	}
+
+	CLogger::copyString(m_strFilename, strFilename, sizeof(m_strFilename));
+
+	m_pHeader = (flr_header_t*)m_pMap;
+	m_pStrings = m_pMap + sizeof(flr_header_t);
+	m_pRings = m_pStrings + FLR_STRING_SIZE;
+
+	m_pHeader->magic = FLR_MAGIC;
+	m_pHeader->version = FLR_VERSION;
+	m_pHeader->nThreadMax = (uint32_t)nThreadMax;
+	m_pHeader->nRingSize = (uint32_t)nRingSize;
+	m_pHeader->nStringSize = FLR_STRING_SIZE;
+	m_pHeader->nStringUsed = 8;			/* Id 0 is reserved */
+	m_pHeader->nThreadUsed = 0;
+	m_pHeader->pid = (uint32_t)getpid();
+	m_pHeader->nBufferMax = LOGGER_BUFFER_MAX;
+	m_pHeader->nDrop = 0;
+
+	return ESUCCESS;
+}
+
+/*
+ * Release the recorder file
+ *
+ * Note: no threads may record meanwhile
+ */
+void CFlightRecorder::terminate()
+{
+	if ( m_pMap != nullptr )  {
+		pthread_key_delete(m_keyRing);
+		::msync(m_pMap, m_nMapSize, MS_SYNC);
+		::munmap(m_pMap, m_nMapSize);
+		m_pMap = nullptr;
+		m_pHeader = nullptr;
+	}
+
+	SAFE_FREE(m_arString);
+}
+
+/*
+ * Save the logger formats of a log type
+ *
+ * 		type			log type index, 1..LOGGER_TYPES (0 - dump format)
+ * 		strType			log type name
+ * 		strFormat		line format
+ * 		strFormatTime	timestamp format
+ */
+void CFlightRecorder::setFormat(unsigned int type, const char* strType, const char* strFormat,
+								const char* strFormatTime)
+{
+	if ( m_pHeader != nullptr && type <= LOGGER_TYPES )  {
+		CLogger::copyString(m_pHeader->arType[type], strType, sizeof(m_pHeader->arType[type]));
+		CLogger::copyString(m_pHeader->arFormat[type], strFormat, sizeof(m_pHeader->arFormat[type]));
+		CLogger::copyString(m_pHeader->arFormatTime[type], strFormatTime,
+							sizeof(m_pHeader->arFormatTime[type]));
+	}
+}
+
+/*
+ * Find or store a string (format, filename, function name)
+ *
+ * 		strKey			constant string to find
+ *
+ * Return: string descriptor or nullptr if no space left
+ *
+ * Note: lock-free, the string is parsed and stored on the first use only.
+ * 		 Strings are identified by the address: the key must be a string
+ * 		 literal (or any static string never changed), a format built in
+ * 		 a buffer would be recorded with the first content of the buffer.
+ */
+const CFlightRecorder::flr_string_t* CFlightRecorder::getString(const char* strKey)
+{
+	flr_string_t*	pString;
+	const char*		pKey;
+	size_t			hash, i, length;
+	uint32_t		offset, id;
+
+	hash = (size_t)((((uintptr_t)strKey)>>3)*2654435761U);
+
+	for(i=0; i<FLR_FORMAT_HASH_SIZE; i++)  {
+		pString = &m_arString[(hash+i)&(FLR_FORMAT_HASH_SIZE-1)];
+		pKey = __atomic_load_n(&pString->pKey, __ATOMIC_ACQUIRE);
+
+		if ( pKey == nullptr )  {
+			if ( !__atomic_compare_exchange_n(&pString->pKey, &pKey, strKey, false,
+											  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+			{
+				if ( pKey != strKey )  {
+					continue;
+				}
+			}
+			else {
+				/* The slot is taken by the caller, store the string */
+				pString->nArgs = (uint8_t)flr_parse_format(strKey, pString->arArg,
+															pString->arPrecision);
+
+				length = _tstrlen(strKey)+1;
+				offset = __atomic_fetch_add(&m_pHeader->nStringUsed, (uint32_t)length, __ATOMIC_RELAXED);
+				if ( offset+length <= FLR_STRING_SIZE )  {
+					_tmemcpy(m_pStrings+offset, strKey, length);
+					id = offset;
+				}
+				else {
+					id = UINT32_MAX;
+				}
+
+				__atomic_store_n(&pString->id, id, __ATOMIC_RELEASE);
+				return id != UINT32_MAX ? pString : nullptr;
+			}
+		}
+
+		if ( pKey == strKey )  {
+			/* Wait the string is stored by the other thread */
+			while ( (id=__atomic_load_n(&pString->id, __ATOMIC_ACQUIRE)) == 0 ) ;
+			shell_assert_ex(id == UINT32_MAX || _tstrcmp((const char*)m_pStrings+id, strKey) == 0,
+							"flight recorder string must be a literal: '%s'\n", strKey);
+			return id != UINT32_MAX ? pString : nullptr;
+		}
+	}
+
+	return nullptr;
+}
+
+/*
+ * Release the ring of a finished thread (thread specific data destructor)
+ *
+ * 		p			thread ring
+ *
+ * Note: the ring records are kept up to the ring is taken by a new thread
+ */
+void CFlightRecorder::releaseRing(void* p)
+{
+	flr_ring_t*		pRing = (flr_ring_t*)p;
+
+	__atomic_store_n(&pRing->state, FLR_RING_FREE, __ATOMIC_RELEASE);
+}
+
+/*
+ * Get the ring of the current thread
+ *
+ * Return: ring or nullptr if all rings are in use
+ */
+flr_ring_t* CFlightRecorder::getRing()
+{
+	const size_t	nStride = sizeof(flr_ring_t)+m_pHeader->nRingSize;
+	flr_ring_t*		pRing;
+	uint32_t		index, nUsed, state;
+
+	if ( t_pRecorder == this )  {
+		return t_pRing;
+	}
+
+	/* Ring released by a finished thread */
+	pRing = nullptr;
+	nUsed = __atomic_load_n(&m_pHeader->nThreadUsed, __ATOMIC_ACQUIRE);
+	for(index=0; index<nUsed; index++)  {
+		flr_ring_t*	p = (flr_ring_t*)(m_pRings + index*nStride);
+
+		state = FLR_RING_FREE;
+		if ( __atomic_load_n(&p->state, __ATOMIC_RELAXED) == FLR_RING_FREE &&
+			 __atomic_compare_exchange_n(&p->state, &state, FLR_RING_USED, false,
+										 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) )
+		{
+			/* The previous thread records are discarded */
+			__atomic_store_n(&p->head, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&p->tail, 0, __ATOMIC_RELAXED);
+			pRing = p;
+			break;
+		}
+	}
+
+	/* Unused ring */
+	while ( pRing == nullptr && nUsed < m_pHeader->nThreadMax )  {
+		if ( __atomic_compare_exchange_n(&m_pHeader->nThreadUsed, &nUsed, nUsed+1, true,
+										 __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+		{
+			pRing = (flr_ring_t*)(m_pRings + nUsed*nStride);
+		}
+	}
+
+	if ( pRing == nullptr )  {
+		/* All rings are in use, retry on the next record */
+		return nullptr;
+	}
+
+	pRing->tid = (uint32_t)pthread_self();
+	pthread_setspecific(m_keyRing, pRing);
+
+	t_pRecorder = this;
+	t_pRing = pRing;
+
+	return pRing;
+}
+
+/*
+ * Reserve a record space in the ring, the oldest records are overwritten
+ *
+ * 		pRing			thread ring
+ * 		nSize			record size, 8 bytes aligned
+ *
+ * Return: record address
+ */
+uint8_t* CFlightRecorder::reserve(flr_ring_t* pRing, size_t nSize)
+{
+	uint8_t*		pData = (uint8_t*)(pRing+1);
+	const size_t	nRingSize = m_pHeader->nRingSize;
+	flr_record_t*	pRecord;
+	uint64_t		head = pRing->head, tail = pRing->tail;
+	size_t			pos, nPad;
+
+	pos = (size_t)(head&(nRingSize-1));
+	nPad = (pos+nSize > nRingSize) ? (nRingSize-pos) : 0;
+
+	while ( (head+nPad+nSize-tail) > nRingSize )  {
+		tail += ((flr_record_t*)(pData+(tail&(nRingSize-1))))->size;
+	}
+	pRing->tail = tail;
+
+	if ( nPad != 0 )  {
+		/* The record may not wrap, skip up to the ring end */
+		pRecord = (flr_record_t*)(pData+pos);
+		pRecord->size = (uint32_t)nPad;
+		pRecord->flags = FLR_RECORD_PAD;
+		__atomic_store_n(&pRing->head, head+nPad, __ATOMIC_RELEASE);
+		pos = 0;
+	}
+
+	return pData+pos;
+}
+
+/*
+ * Record a log message
+ *
+ * 		typeChannels		log type/channels
+ *		strFilename			source filename (may be NULL)
+ *		nLine				source line
+ *		strFunction			source function (may be NULL)
+ *		pData				user data (may be NULL)
+ * 		nLength				user data length, bytes
+ *		strMessage			user message format
+ *		args				VA arguments
+ */
+void CFlightRecorder::record(unsigned int typeChannels, const char* strFilename, int nLine,
+							 const char* strFunction, const void* pData, int nLength,
+							 const char* strMessage, va_list args)
+{
+	uint64_t				arBuffer[FLR_ALIGN(FLR_RECORD_MAX)/sizeof(uint64_t)];
+	flr_record_t*			pRecord = (flr_record_t*)arBuffer;
+	uint8_t*				p = (uint8_t*)(pRecord+1);
+	const flr_string_t		*pFormat, *pFile = nullptr, *pFunction = nullptr;
+	flr_ring_t*				pRing;
+	struct timespec			ts;
+	uint64_t				value;
+	double					dvalue;
+	const char*				s;
+	uint32_t				length;
+	int64_t					nPrecision = -1;
+	size_t					i, nSize, nMax;
+
+	if ( m_pHeader == nullptr )  {
+		return;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	pRing = getRing();
+	pFormat = getString(strMessage);
+	if ( strFilename )  {
+		pFile = getString(strFilename);
+	}
+	if ( strFunction )  {
+		pFunction = getString(strFunction);
+	}
+
+	if ( pRing == nullptr || pFormat == nullptr || (strFilename && pFile == nullptr) ||
+			(strFunction && pFunction == nullptr) )
+	{
+		__atomic_fetch_add(&m_pHeader->nDrop, 1, __ATOMIC_RELAXED);
+		return;
+	}
+
+	pRecord->flags = 0;
+	pRecord->nArgs = pFormat->nArgs;
+	pRecord->fmtId = pFormat->id;
+	pRecord->fileId = pFile ? pFile->id : 0;
+	pRecord->funcId = pFunction ? pFunction->id : 0;
+	pRecord->line = nLine;
+	pRecord->typeChannels = typeChannels;
+	pRecord->reserved = 0;
+	pRecord->time = (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+
+	for(i=0; i<pFormat->nArgs; i++)  {
+		switch ( pFormat->arArg[i] )  {
+			case FLR_ARG_INT:
+				value = (uint64_t)(int64_t)va_arg(args, int);
+				/* May be the '.*' precision of the next argument */
+				nPrecision = (int64_t)value;
+				break;
+
+			case FLR_ARG_UINT:		value = (uint64_t)va_arg(args, unsigned int); break;
+			case FLR_ARG_LONG:		value = (uint64_t)(int64_t)va_arg(args, long); break;
+			case FLR_ARG_ULONG:		value = (uint64_t)va_arg(args, unsigned long); break;
+			case FLR_ARG_LLONG:		value = (uint64_t)va_arg(args, long long); break;
+			case FLR_ARG_ULLONG:	value = (uint64_t)va_arg(args, unsigned long long); break;
+			case FLR_ARG_PTR:		value = (uint64_t)(uintptr_t)va_arg(args, void*); break;
+
+			case FLR_ARG_DOUBLE:
+			case FLR_ARG_LDOUBLE:
+				dvalue = pFormat->arArg[i] == FLR_ARG_DOUBLE ? va_arg(args, double) :
+							(double)va_arg(args, long double);
+				_tmemcpy(&value, &dvalue, sizeof(value));
+				break;
+
+			case FLR_ARG_STRING:
+				s = va_arg(args, const char*);
+				if ( s == NULL )  {
+					s = "(null)";
+				}
+				/* The string may be not terminated within the precision */
+				nMax = FLR_ARG_STRING_MAX;
+				if ( pFormat->arPrecision[i] == FLR_PRECISION_ARG )  {
+					if ( nPrecision >= 0 && nPrecision < FLR_ARG_STRING_MAX )  {
+						nMax = (size_t)nPrecision;
+					}
+				}
+				else if ( pFormat->arPrecision[i] != FLR_PRECISION_NONE )  {
+					nMax = pFormat->arPrecision[i];
+				}
+				length = (uint32_t)::strnlen(s, nMax);
+				_tmemcpy(p, &length, sizeof(length));
+				_tmemcpy(p+sizeof(length), s, length);
+				p += sizeof(length)+length;
+				continue;
+
+			default:
+				value = 0;
+				break;
+		}
+
+		_tmemcpy(p, &value, sizeof(value));
+		p += sizeof(value);
+	}
+
+	if ( pData != 0 )  {
+		length = (uint32_t)sh_min(sh_max(nLength, 0), FLR_DATA_MAX);
+		_tmemcpy(p, &length, sizeof(length));
+		_tmemcpy(p+sizeof(length), pData, length);
+		p += sizeof(length)+length;
+		pRecord->flags |= FLR_RECORD_DATA;
+	}
+
+	nSize = FLR_ALIGN(A(p)-A(pRecord));
+	pRecord->size = (uint32_t)nSize;
+
+	/* Single writer per ring, the head is published after the record */
+	_tmemcpy(reserve(pRing, nSize), pRecord, nSize);
+	__atomic_store_n(&pRing->head, pRing->head+nSize, __ATOMIC_RELEASE);
+}
+
+/*
+ * Schedule the recorded data writing to the file
+ */
+void CFlightRecorder::flush()
+{
+	if ( m_pMap != nullptr )  {
+		::msync(m_pMap, m_nMapSize, MS_ASYNC);
+	}
+}
+
+/*
+ * Save a copy of the recorder file
+ *
+ * 		strFilename		copy full filename
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: records being written meanwhile may be damaged in the copy,
+ * 		 the decoder stops the ring at the damaged record.
+ */
+result_t CFlightRecorder::dump(const char* strFilename) const
+{
+	size_t		nThreads, nSize;
+	int			handle;
+	ssize_t		count;
+	result_t	nresult = ESUCCESS;
+
+	if ( m_pHeader == nullptr )  {
+		return ENOENT;
+	}
+
+	nThreads = sh_min(m_pHeader->nThreadUsed, m_pHeader->nThreadMax);
+	nSize = A(m_pRings)-A(m_pMap) + nThreads*(sizeof(flr_ring_t)+m_pHeader->nRingSize);
+
+	handle = ::open(strFilename, O_CREAT|O_WRONLY|O_TRUNC, (S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH));
+	if ( handle < 0 )  {
+		return errno;
+	}
+
+	count = ::write(handle, m_pMap, nSize);
+	if ( count < (ssize_t)nSize )  {
+		nresult = count < 0 ? errno : EIO;
+	}
+
+	::close(handle);
+	return nresult;
+}
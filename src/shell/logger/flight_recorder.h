@@ -0,0 +1,207 @@
+/*
+ *  Shell library
+ *  Logger binary flight recorder
+ *
+ *  Copyright (c) 2026 Softland. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0
+ */
+/*
+ *  Revision history:
+ *
+ *  Revision 1.0, 18.10.2026 07:26:44
+ *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 12:04:37
+ *      Ring reuse, string argument precision.
+ */
+/*
+ * Purpose:
+ *      Binary log of the selected log types/channels. A record keeps the
+ *      format string Id, the raw arguments and a nanosecond timestamp, the
+ *      message is not formatted. Records are written to the per-thread
+ *      overwrite rings (the last records of each thread are kept).
+ *
+ *      All data lives in a single shared memory mapped file, so the recorded
+ *      data survives the process crash. A consistent copy of the file may be
+ *      taken by dump() (on EV_USR1). The file is decoded to the logger text
+ *      output by the offline tool (app/log_decode).
+ *
+ *      The ring of a finished thread is kept up to the ring is taken by a
+ *      new thread. Format strings, filenames and function names are known
+ *      by the address and must be string literals.
+ *
+ * File layout:
+ *      flr_header_t                        file header, logger formats
+ *      char[nStringSize]                   format strings, file and function names
+ *      (flr_ring_t + char[nRingSize])*     per thread rings
+ *
+ * Record layout (8 bytes aligned):
+ *      flr_record_t                        record header
+ *      arguments                           8 bytes per scalar argument,
+ *                                          uint32_t length + chars per string
+ *      [uint32_t length + data]            hex dump data (FLR_RECORD_DATA)
+ */
+
+#ifndef __SHELL_LOGGER_FLIGHT_RECORDER_H_INCLUDED__
+#define __SHELL_LOGGER_FLIGHT_RECORDER_H_INCLUDED__
+
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "shell/config.h"
+#include "shell/types.h"
+#include "shell/error.h"
+
+#include "shell/logger/logger.h"
+
+#define FLR_MAGIC					0x31524c46			/* 'FLR1' */
+#define FLR_VERSION					1
+
+#define FLR_RING_SIZE				(256*1024)			/* Default ring size per thread, bytes */
+#define FLR_THREAD_MAX				64					/* Default maximum threads */
+#define FLR_STRING_SIZE				(256*1024)			/* Strings area size, bytes */
+#define FLR_FORMAT_HASH_SIZE		4096				/* Known strings, power of 2 */
+
+#define FLR_ARG_MAX					16					/* Maximum recorded arguments */
+#define FLR_ARG_STRING_MAX			128					/* Maximum recorded string argument */
+#define FLR_DATA_MAX				256					/* Maximum recorded hex dump data */
+#define FLR_RECORD_MAX				(sizeof(flr_record_t)+FLR_ARG_MAX*(FLR_ARG_STRING_MAX+8)+ \
+										FLR_DATA_MAX+8)
+
+#define FLR_RECORD_PAD				0x0001				/* Padding up to the ring end */
+#define FLR_RECORD_DATA				0x0002				/* Hex dump data follows the arguments */
+
+#define FLR_RING_USED				0					/* Ring is owned by a thread */
+#define FLR_RING_FREE				1					/* Ring of a finished thread */
+
+#define FLR_PRECISION_NONE			0xff				/* No string precision */
+#define FLR_PRECISION_ARG			0xfe				/* Precision is the previous argument */
+
+#define FLR_ALIGN(__size)			(((__size)+7)&~(size_t)7)
+
+/*
+ * File header
+ */
+typedef struct
+{
+	uint32_t	magic;											/* FLR_MAGIC */
+	uint32_t	version;										/* FLR_VERSION */
+	uint32_t	nThreadMax;										/* Ring count */
+	uint32_t	nRingSize;										/* Ring data size, bytes */
+	uint32_t	nStringSize;									/* Strings area size, bytes */
+	uint32_t	nStringUsed;									/* Strings area used, bytes */
+	uint32_t	nThreadUsed;									/* Rings in use */
+	uint32_t	pid;											/* Process Id */
+	uint32_t	nBufferMax;										/* Logger message buffer size */
+	uint32_t	nDrop;											/* Records not recorded */
+	char		arType[LOGGER_TYPES+1][8];						/* Log type names */
+	char		arFormat[LOGGER_TYPES+1][LOGGER_FORMAT_MAX];	/* Line formats, [0]: dump format */
+	char		arFormatTime[LOGGER_TYPES+1][LOGGER_FORMAT_MAX];/* Timestamp formats */
+} __attribute__ ((aligned(8))) flr_header_t;
+
+/*
+ * Per thread ring header
+ */
+typedef struct
+{
+	uint64_t	head;						/* Total bytes written */
+	uint64_t	tail;						/* Oldest record position */
+	uint32_t	tid;						/* Owner thread Id (logger %t format) */
+	uint32_t	state;						/* FLR_RING_xxx */
+} __attribute__ ((aligned(8))) flr_ring_t;
+
+/*
+ * Record header
+ */
+typedef struct
+{
+	uint32_t	size;						/* Record size including header, bytes */
+	uint16_t	flags;						/* FLR_RECORD_xxx */
+	uint16_t	nArgs;						/* Recorded arguments */
+	uint32_t	fmtId;						/* Format string Id */
+	uint32_t	fileId;						/* Source filename Id (0 - dump format) */
+	uint32_t	funcId;						/* Source function Id */
+	int32_t		line;						/* Source line */
+	uint32_t	typeChannels;				/* Log type/channels */
+	uint32_t	reserved;
+	uint64_t	time;						/* Realtime timestamp, nanoseconds */
+} __attribute__ ((aligned(8))) flr_record_t;
+
+/*
+ * Argument types
+ */
+enum {
+	FLR_ARG_INT,							/* int, char, short */
+	FLR_ARG_UINT,							/* unsigned int, ... */
+	FLR_ARG_LONG,							/* long, ssize_t, ptrdiff_t */
+	FLR_ARG_ULONG,							/* unsigned long, size_t */
+	FLR_ARG_LLONG,							/* long long, intmax_t */
+	FLR_ARG_ULLONG,							/* unsigned long long, uintmax_t */
+	FLR_ARG_DOUBLE,							/* double */
+	FLR_ARG_LDOUBLE,						/* long double (recorded as double) */
+	FLR_ARG_PTR,							/* pointer */
+	FLR_ARG_STRING							/* string */
+};
+
+/*
+ * Parse the printf() format string arguments
+ *
+ * 		strFormat		format string
+ * 		arArg			argument types [out], FLR_ARG_MAX items
+ * 		arPrecision		argument precisions [out], FLR_ARG_MAX items (may be NULL)
+ *
+ * Return: argument count, up to FLR_ARG_MAX
+ */
+extern size_t flr_parse_format(const char* strFormat, uint8_t* arArg,
+							   uint8_t* arPrecision = NULL);
+
+
+class CFlightRecorder
+{
+	protected:
+		struct flr_string_t {
+			const char*		pKey;						/* String pointer */
+			uint32_t		id;							/* String Id, 0 - not ready */
+			uint8_t			nArgs;						/* Format arguments */
+			uint8_t			arArg[FLR_ARG_MAX];			/* Format argument types */
+			uint8_t			arPrecision[FLR_ARG_MAX];	/* String argument precisions */
+		};
+
+	protected:
+		char					m_strFilename[256];		/* Recorder file */
+		uint8_t*				m_pMap;					/* File mapping */
+		size_t					m_nMapSize;				/* File mapping size, bytes */
+		flr_header_t*			m_pHeader;				/* File header */
+		flr_string_t*			m_arString;				/* Known strings hash */
+		uint8_t*				m_pStrings;				/* Strings area */
+		uint8_t*				m_pRings;				/* First ring */
+		pthread_key_t			m_keyRing;				/* Thread ring, released on the thread exit */
+
+	public:
+		CFlightRecorder();
+		virtual ~CFlightRecorder();
+
+	public:
+		result_t init(const char* strFilename, size_t nRingSize, size_t nThreadMax);
+		void terminate();
+
+		void setFormat(unsigned int type, const char* strType, const char* strFormat,
+					   const char* strFormatTime);
+
+		void record(unsigned int typeChannels, const char* strFilename, int nLine,
+					const char* strFunction, const void* pData, int nLength,
+					const char* strMessage, va_list args);
+
+		void flush();
+		result_t dump(const char* strFilename) const;
+
+		const char* getFilename() const { return m_strFilename; }
+
+	private:
+		const flr_string_t* getString(const char* strKey);
+		flr_ring_t* getRing();
+		static void releaseRing(void* p);
+		uint8_t* reserve(flr_ring_t* pRing, size_t nSize);
+};
+
+#endif /* __SHELL_LOGGER_FLIGHT_RECORDER_H_INCLUDED__ */
@@ -25,11 +25,25 @@
  *
  *  Revision 2.1, 25.12.2019 19:18:20
  *  	Added LT_TRACE log type support.
+ *
+ *  Revision 2.2, 18.10.2026 06:02:15
+ *  	Lock-free enable checks, messages are formatted out of the lock,
+ *  	asynchronous mode with the logger thread.
+ *
+ *  Revision 2.3, 18.10.2026 08:14:52
+ *  	Binary flight recorder of the selected log types/channels.
+ *
+ *  Revision 2.4, 18.10.2026 11:53:06
+ *  	Asynchronous mode stop waits for the in-flight writers.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
+#include <signal.h>
+#include <sched.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <syslog.h>
 
@@ -39,6 +53,7 @@
 #include "shell/unaligned.h"
 #include "shell/logger/appender.h"
 #include "shell/logger/appender_stdout.h"
+#include "shell/logger/flight_recorder.h"
 #include "shell/logger/logger.h"
 
 /*
@@ -59,6 +74,16 @@
 #define LOGGER_FORMAT_TIME_DEFAULT		"%d.%m.%y %H:%M:%S"
 #define LOGGER_FORMAT_DUMP				"%T: %s"
 
+/* Last converted timestamp of the thread, localtime_r() is called once a second */
+static __thread time_t		g_timeCached = 0;
+static __thread struct tm	g_tmCached;
+
+/* Channel bitmap access, the bitmaps are checked without logger lock */
+#define LOGGER_BITMAP_GET(__p)			__atomic_load_n((__p), __ATOMIC_RELAXED)
+#define LOGGER_BITMAP_SET(__p, __v)		__atomic_store_n((__p), (__v), __ATOMIC_RELAXED)
+#define LOGGER_BITMAP_OR(__p, __v)		__atomic_fetch_or((__p), (__v), __ATOMIC_RELAXED)
+#define LOGGER_BITMAP_AND(__p, __v)		__atomic_fetch_and((__p), (__v), __ATOMIC_RELAXED)
+
 /*******************************************************************************
  * CLogger class
  */
@@ -69,9 +94,23 @@ CLogger::CLogger(boolean_t bDefaultAppender)
 
 	_tbzero_object(m_arAppender);
 	_tbzero_object(m_arType);
+	m_pRecorder = nullptr;
+	m_bRecord = false;
 
 #if !LOGGER_SINGLE_THREAD
 	pthread_mutex_init(&m_lock, nullptr);
+
+	m_arRecord = nullptr;
+	m_nHead = 0;
+	m_nTail = 0;
+	m_nDrop = 0;
+	m_nDropReported = 0;
+	m_bAsync = false;
+	m_bAsyncStop = false;
+	m_nAsyncWaiting = 0;
+	m_nAsyncWriters = 0;
+	pthread_mutex_init(&m_lockAsync, nullptr);
+	pthread_cond_init(&m_condAsync, nullptr);
 #endif /* !LOGGER_SINGLE_THREAD */
 
 	for(size_t i=1; i<=LOGGER_TYPES; i++)  {
@@ -88,6 +127,8 @@ CLogger::CLogger(boolean_t bDefaultAppender)
 
 CLogger::~CLogger() noexcept
 {
+	setAsync(false);
+
 	lock();
 	for (auto& pAppender : m_arAppender) {
 		if ( pAppender ) {
@@ -100,8 +141,18 @@ CLogger::~CLogger() noexcept
 	}
 	unlock();
 
+	m_bRecord = false;
+	if ( m_pRecorder != nullptr )  {
+		delete m_pRecorder;
+		m_pRecorder = nullptr;
+	}
+
 #if !LOGGER_SINGLE_THREAD
 	pthread_mutex_destroy(&m_lock);
+
+	pthread_cond_destroy(&m_condAsync);
+	pthread_mutex_destroy(&m_lockAsync);
+	::free(m_arRecord);
 #endif /* !LOGGER_SINGLE_THREAD */
 }
 
@@ -123,13 +174,15 @@ void CLogger::enable(unsigned int typeChannel)
 		if ( ch != 0 ) {
 			const unsigned int index = ch/8;
 			const unsigned int bit = 1U << (ch&7);
-			pType->arChannel[index] |= bit;
+			LOGGER_BITMAP_OR(&pType->arChannel[index], (uint8_t)bit);
 		}
 		else {
-			_tmemset(&pType->arChannel, 0xff, sizeof(pType->arChannel));
+			for(auto& bitmap : pType->arChannel)  {
+				LOGGER_BITMAP_SET(&bitmap, (uint8_t)0xff);
+			}
 		}
 
-		pType->arChannel[exc_index] &= ~exc_bit;
+		LOGGER_BITMAP_AND(&pType->arChannel[exc_index], (uint8_t)~exc_bit);
 	};
 
 	lock();
@@ -162,13 +215,15 @@ void CLogger::disable(unsigned int typeChannel)
 		if ( ch != 0 ) {
 			const unsigned int index = ch/8;
 			const unsigned int bit = 1U << (ch&7);
-			pType->arChannel[index] &= ~bit;
+			LOGGER_BITMAP_AND(&pType->arChannel[index], (uint8_t)~bit);
 		}
 		else {
-			_tbzero_object(pType->arChannel);
+			for(auto& bitmap : pType->arChannel)  {
+				LOGGER_BITMAP_SET(&bitmap, (uint8_t)0);
+			}
 		}
 
-		pType->arChannel[exc_index] |= exc_bit;
+		LOGGER_BITMAP_OR(&pType->arChannel[exc_index], (uint8_t)exc_bit);
 	};
 
 	lock();
@@ -191,6 +246,8 @@ void CLogger::disable(unsigned int typeChannel)
  * Return:
  * 		true			log is enabled
  * 		false			log is disabled
+ *
+ * Note: lock-free
  */
 boolean_t CLogger::isEnabled(unsigned int typeChannel)
 {
@@ -204,9 +261,7 @@ boolean_t CLogger::isEnabled(unsigned int typeChannel)
 		index = ch/8;
 		bit = (unsigned int)1 << (ch&7);
 
-		lock();
-		bEnabled = (m_arType[type].arChannel[index]&bit) != 0;
-		unlock();
+		bEnabled = (LOGGER_BITMAP_GET(&m_arType[type].arChannel[index])&bit) != 0;
 	}
 
 	return bEnabled;
@@ -234,6 +289,7 @@ void CLogger::setFormat(unsigned int type, const char* strFormat)
 									sizeof(m_arType[i].strFormat));
 			}
 		}
+		setRecorderFormat(rtype);
 		unlock();
 	}
 }
@@ -260,6 +316,7 @@ void CLogger::setFormatTime(unsigned int type, const char* strFormat)
 									sizeof(m_arType[i].strFormatTime));
 			}
 		}
+		setRecorderFormat(rtype);
 		unlock();
 	}
 }
@@ -282,12 +339,36 @@ boolean_t CLogger::isEnabledChannel(const logger_type_t* pLogger, unsigned int c
 		const unsigned int	index = ch/8;
 		const unsigned int	bit = 1U << (ch&7);
 
-		bEnabled = (pLogger->arChannel[index]&bit) != 0;
+		bEnabled = (LOGGER_BITMAP_GET(&pLogger->arChannel[index])&bit) != 0;
 	}
 
 	return bEnabled;
 }
 
+/*
+ * Check if a specified channel is recorded
+ *
+ * 		pLogger		logger channel pointer
+ * 		ch			channel bitmap to check
+ *
+ * Return:
+ * 		true		log is recorded
+ * 		false		log is not recorded
+ */
+boolean_t CLogger::isRecordChannel(const logger_type_t* pLogger, unsigned int ch) const
+{
+	boolean_t	bRecord = false;
+
+	if ( ch != 0 )  {
+		const unsigned int	index = ch/8;
+		const unsigned int	bit = 1U << (ch&7);
+
+		bRecord = (LOGGER_BITMAP_GET(&pLogger->arRecord[index])&bit) != 0;
+	}
+
+	return bRecord;
+}
+
 /*
  * Format logger string
  *
@@ -313,7 +394,6 @@ size_t CLogger::doFormat(const logger_type_t* pLogger, const char* strLoggerForm
 	size_t		len = nBufferLength-1, l;
 	char		c;
 	time_t      time_now;
-	struct tm   tm;
 
 	while ( (c=*f++) != '\0' && len > 0 )  {
 		/*
@@ -352,8 +432,11 @@ size_t CLogger::doFormat(const logger_type_t* pLogger, const char* strLoggerForm
 
 			case 'T':				/* Timestamp */
 				time_now = time(NULL);
-				localtime_r(&time_now, &tm);
-				l = strftime(s, len, pLogger->strFormatTime, &tm);
+				if ( time_now != g_timeCached )  {
+					localtime_r(&time_now, &g_tmCached);
+					g_timeCached = time_now;
+				}
+				l = strftime(s, len, pLogger->strFormatTime, &g_tmCached);
 				s += l; len -= l;
 				break;
 
@@ -473,52 +556,94 @@ void CLogger::writev(unsigned int typeChannels, const char* strFilename, int nLi
 {
 	const unsigned int		type = _LOGGER_TYPE(typeChannels);
 	const logger_type_t*	pLogger;
+	const char*				pFormat;
+	char					strBuffer[LOGGER_BUFFER_MAX];
+	size_t					nBufferLength;
 
-	if ( (type < 1 || type > LOGGER_TYPES) || m_arAppender[0] == nullptr )  {
+	if ( type < 1 || type > LOGGER_TYPES )  {
 		return;
 	}
 
 	pLogger = &m_arType[type];
 
-	lock();
-	if ( isEnabledChannel(pLogger, _LOGGER_CHANNEL0(typeChannels)) ||
-			isEnabledChannel(pLogger, _LOGGER_CHANNEL2(typeChannels)) )
+	if ( m_bRecord && (isRecordChannel(pLogger, _LOGGER_CHANNEL0(typeChannels)) ||
+			isRecordChannel(pLogger, _LOGGER_CHANNEL2(typeChannels))) )
 	{
-		const char*		pFormat;
-		char			strBuffer[LOGGER_BUFFER_MAX];
-		size_t			nBufferLength;
-
-		pFormat = strFilename ? pLogger->strFormat : LOGGER_FORMAT_DUMP;
-		nBufferLength = doFormat(pLogger, pFormat, strMessage,
-								 strFilename, nLine, strFunction,
-								 strBuffer, sizeof(strBuffer), args);
-
-		if ( pData != 0 && /* nLength > 0 &&*/ (sizeof(strBuffer)-2) > nBufferLength )  {
-			nBufferLength += doFormatHex(pLogger, pData, nLength,
-					&strBuffer[nBufferLength], sizeof(strBuffer)-nBufferLength);
-
-			if ( nBufferLength < (sizeof(strBuffer)-2) )  {
-				strBuffer[nBufferLength] = '\n';
-				nBufferLength++;
-				strBuffer[nBufferLength] = '\0';
-			}
+		va_list		argsRecord;
+
+		va_copy(argsRecord, args);
+		m_pRecorder->record(typeChannels, strFilename, nLine, strFunction,
+							pData, nLength, strMessage, argsRecord);
+		va_end(argsRecord);
+	}
+
+	if ( m_arAppender[0] == nullptr )  {
+		return;
+	}
+
+	if ( !isEnabledChannel(pLogger, _LOGGER_CHANNEL0(typeChannels)) &&
+			!isEnabledChannel(pLogger, _LOGGER_CHANNEL2(typeChannels)) )
+	{
+		return;
+	}
+
+	/* The message is formatted in the caller's buffer out of the lock */
+	pFormat = strFilename ? pLogger->strFormat : LOGGER_FORMAT_DUMP;
+	nBufferLength = doFormat(pLogger, pFormat, strMessage,
+							 strFilename, nLine, strFunction,
+							 strBuffer, sizeof(strBuffer), args);
+
+	if ( pData != 0 && /* nLength > 0 &&*/ (sizeof(strBuffer)-2) > nBufferLength )  {
+		nBufferLength += doFormatHex(pLogger, pData, nLength,
+				&strBuffer[nBufferLength], sizeof(strBuffer)-nBufferLength);
+
+		if ( nBufferLength < (sizeof(strBuffer)-2) )  {
+			strBuffer[nBufferLength] = '\n';
+			nBufferLength++;
+			strBuffer[nBufferLength] = '\0';
 		}
-		else {
-			if ( nBufferLength > 0 && nBufferLength >= (sizeof(strBuffer)-2) )  {
-				strBuffer[nBufferLength-2] = '\n';
-				strBuffer[nBufferLength-1] = '\0';
-			}
+	}
+	else {
+		if ( nBufferLength > 0 && nBufferLength >= (sizeof(strBuffer)-2) )  {
+			strBuffer[nBufferLength-2] = '\n';
+			strBuffer[nBufferLength-1] = '\0';
 		}
+	}
 
-		if ( nBufferLength > 0 )  {
-			for(auto& pAppender : m_arAppender)  {
-				if ( pAppender != nullptr ) {
-					pAppender->append(strBuffer, nBufferLength);
-				}
-				else {
-					break;
-				}
+	if ( nBufferLength > 0 )  {
+#if !LOGGER_SINGLE_THREAD
+		if ( m_bAsync )  {
+			/* Pairs with setAsync(false): either the mode is seen
+			 * turned off here, or the stopping thread sees the writer */
+			__atomic_fetch_add(&m_nAsyncWriters, 1, __ATOMIC_SEQ_CST);
+			if ( __atomic_load_n(&m_bAsync, __ATOMIC_SEQ_CST) )  {
+				pushRecord(strBuffer, nBufferLength);
+				__atomic_fetch_sub(&m_nAsyncWriters, 1, __ATOMIC_RELEASE);
+				return;
 			}
+			__atomic_fetch_sub(&m_nAsyncWriters, 1, __ATOMIC_RELEASE);
+		}
+#endif /* !LOGGER_SINGLE_THREAD */
+
+		doAppend(strBuffer, nBufferLength);
+	}
+}
+
+/*
+ * Write a formatted message to the all appenders
+ *
+ * 		strBuffer			message to write
+ * 		nLength				message length, bytes
+ */
+void CLogger::doAppend(const char* strBuffer, size_t nLength)
+{
+	lock();
+	for(auto& pAppender : m_arAppender)  {
+		if ( pAppender != nullptr ) {
+			pAppender->append(strBuffer, nLength);
+		}
+		else {
+			break;
 		}
 	}
 	unlock();
@@ -592,6 +717,442 @@ result_t CLogger::insertAppender(CAppender* pAppender)
 	return nresult;
 }
 
+/*
+ * Switch the logger to the asynchronous/synchronous mode
+ *
+ * 		bAsync			true: start the logger thread,
+ * 						false: write the queued messages and stop the logger thread
+ *
+ * Return: ESUCCESS, ENOSYS, ENOMEM, ...
+ *
+ * Note: must be called in context of the main thread
+ * 		 (in CApplication::init()/CApplication::terminate())
+ */
+result_t CLogger::setAsync(boolean_t bAsync)
+{
+#if !LOGGER_SINGLE_THREAD
+	result_t	nresult = ESUCCESS;
+	int			retVal;
+
+	if ( bAsync )  {
+		if ( m_bAsync )  {
+			return ESUCCESS;
+		}
+
+		if ( m_arRecord == nullptr )  {
+			/* Queue is never freed while logger exists, late writers may use it */
+			m_arRecord = (logger_record_t*)::malloc(sizeof(logger_record_t)*LOGGER_ASYNC_QUEUE_MAX);
+			if ( m_arRecord == nullptr )  {
+				CLogger::syslog("[shell_logger] failed to allocate async queue\n");
+				return ENOMEM;
+			}
+
+			for(size_t i=0; i<LOGGER_ASYNC_QUEUE_MAX; i++)  {
+				m_arRecord[i].seq = m_nHead+i;
+			}
+			m_nTail = m_nHead;
+		}
+
+		m_bAsyncStop = false;
+		retVal = pthread_create(&m_thAsync, nullptr, asyncThreadST, this);
+		if ( retVal == 0 )  {
+			m_bAsync = true;
+		}
+		else {
+			nresult = retVal;
+			CLogger::syslog("[shell_logger] failed to start logger thread, result: %d\n", nresult);
+		}
+	}
+	else {
+		if ( !m_bAsync )  {
+			return ESUCCESS;
+		}
+
+		__atomic_store_n(&m_bAsync, false, __ATOMIC_SEQ_CST);
+
+		pthread_mutex_lock(&m_lockAsync);
+		m_bAsyncStop = true;
+		pthread_cond_signal(&m_condAsync);
+		pthread_mutex_unlock(&m_lockAsync);
+
+		pthread_join(m_thAsync, nullptr);
+
+		/* Writers which have seen the async mode may still be pushing */
+		while ( __atomic_load_n(&m_nAsyncWriters, __ATOMIC_ACQUIRE) != 0 )  {
+			sched_yield();
+		}
+
+		/* Records pushed by the writers which have seen the async mode */
+		while ( writeRecords() > 0 ) ;
+	}
+
+	return nresult;
+#else /* !LOGGER_SINGLE_THREAD */
+	return bAsync ? ENOSYS : ESUCCESS;
+#endif /* !LOGGER_SINGLE_THREAD */
+}
+
+/*
+ * Check if the logger is in asynchronous mode
+ *
+ * Return: true if the messages are written by the logger thread
+ */
+boolean_t CLogger::isAsync() const
+{
+#if !LOGGER_SINGLE_THREAD
+	return m_bAsync;
+#else /* !LOGGER_SINGLE_THREAD */
+	return false;
+#endif /* !LOGGER_SINGLE_THREAD */
+}
+
+/*
+ * Get dropped messages count (asynchronous queue overflow)
+ *
+ * Return: dropped messages since the logger creation
+ */
+uint32_t CLogger::getDropCount() const
+{
+#if !LOGGER_SINGLE_THREAD
+	return __atomic_load_n(&m_nDrop, __ATOMIC_RELAXED);
+#else /* !LOGGER_SINGLE_THREAD */
+	return 0;
+#endif /* !LOGGER_SINGLE_THREAD */
+}
+
+/*
+ * Copy the logger formats of a log type to the recorder file
+ *
+ * 		type			log type index, 1..LOGGER_TYPES (0 - all types)
+ *
+ * Note: called under the logger lock
+ */
+void CLogger::setRecorderFormat(unsigned int type)
+{
+	size_t	i;
+
+	if ( m_pRecorder != nullptr )  {
+		for(i=1; i<=LOGGER_TYPES; i++)  {
+			if ( type == 0 || type == i )  {
+				m_pRecorder->setFormat((unsigned int)i, m_arType[i].strType,
+									   m_arType[i].strFormat, m_arType[i].strFormatTime);
+			}
+		}
+	}
+}
+
+/*
+ * Start the binary flight recorder
+ *
+ * 		strFilename		recorder file full filename
+ * 		nRingSize		ring size per thread, bytes (0 - FLR_RING_SIZE)
+ * 		nThreadMax		maximum recorded threads (0 - FLR_THREAD_MAX)
+ *
+ * Return: ESUCCESS, ...
+ *
+ * Note: the recorder file is created on the first call only,
+ * 		 the recorded types/channels are selected by enableRecord()
+ */
+result_t CLogger::startRecorder(const char* strFilename, size_t nRingSize, size_t nThreadMax)
+{
+	CFlightRecorder*	pRecorder;
+	result_t			nresult = ESUCCESS;
+
+	lock();
+	if ( m_pRecorder == nullptr )  {
+		pRecorder = new CFlightRecorder;
+		nresult = pRecorder->init(strFilename, nRingSize != 0 ? nRingSize : FLR_RING_SIZE,
+								  nThreadMax != 0 ? nThreadMax : FLR_THREAD_MAX);
+		if ( nresult == ESUCCESS )  {
+			m_pRecorder = pRecorder;
+			m_pRecorder->setFormat(0, "", LOGGER_FORMAT_DUMP, "");
+			setRecorderFormat(0);
+		}
+		else {
+			delete pRecorder;
+		}
+	}
+
+	if ( nresult == ESUCCESS )  {
+		m_bRecord = true;
+	}
+	unlock();
+
+	return nresult;
+}
+
+/*
+ * Stop the binary flight recorder
+ *
+ * Note: the recorder file is kept mapped up to the logger destruction,
+ * 		 the threads being recording meanwhile may finish safely
+ */
+void CLogger::stopRecorder()
+{
+	lock();
+	m_bRecord = false;
+	if ( m_pRecorder != nullptr )  {
+		m_pRecorder->flush();
+	}
+	unlock();
+}
+
+/*
+ * Save a copy of the flight recorder file
+ *
+ * 		strFilename		copy full filename (nullptr - '<recorder file>.dump')
+ *
+ * Return: ESUCCESS, ENOENT, ...
+ */
+result_t CLogger::dumpRecorder(const char* strFilename)
+{
+	char		strTmp[256+8];
+	result_t	nresult = ENOENT;
+
+	if ( m_pRecorder != nullptr )  {
+		if ( strFilename == nullptr )  {
+			_tsnprintf(strTmp, sizeof(strTmp), "%s.dump", m_pRecorder->getFilename());
+			strFilename = strTmp;
+		}
+
+		nresult = m_pRecorder->dump(strFilename);
+		if ( nresult != ESUCCESS )  {
+			CLogger::syslog("[logger] failed to dump flight recorder to '%s', result: %d\n",
+							strFilename, nresult);
+		}
+	}
+
+	return nresult;
+}
+
+/*
+ * Schedule the flight recorder data writing to the file
+ *
+ * Note: may be called from a fatal signal handler
+ */
+void CLogger::flushRecorder()
+{
+	if ( m_pRecorder != nullptr )  {
+		m_pRecorder->flush();
+	}
+}
+
+/*
+ * Enable the binary recording of the logger type/channel
+ *
+ * 		typeChannel		recording log types/channels
+ * 							type:		log types LT_xxx (may be LT_ALL)
+ * 							channel: 	log channels L_xxx (may be L_ALL)
+ *
+ * Note: the types/channels are recorded regardless of the text output enabling
+ */
+void CLogger::enableRecord(unsigned int typeChannel)
+{
+	const unsigned int	ch = _LOGGER_CHANNEL0(typeChannel);
+	const unsigned int 	type = _LOGGER_TYPE(typeChannel);
+	size_t				i;
+
+	lock();
+	for(i=1; i<=LOGGER_TYPES; i++) {
+		if ( type == 0 || type == i )  {
+			if ( ch != 0 )  {
+				LOGGER_BITMAP_OR(&m_arType[i].arRecord[ch/8], (uint8_t)(1U << (ch&7)));
+			}
+			else {
+				for(auto& bitmap : m_arType[i].arRecord)  {
+					LOGGER_BITMAP_SET(&bitmap, (uint8_t)0xff);
+				}
+			}
+		}
+	}
+	unlock();
+}
+
+/*
+ * Disable the binary recording of the logger type/channel
+ *
+ * 		typeChannel		log types/channels to stop recording
+ * 							type:		log types LT_xxx (may be LT_ALL)
+ * 							channel: 	log channels L_xxx (may be L_ALL)
+ */
+void CLogger::disableRecord(unsigned int typeChannel)
+{
+	const unsigned int	ch = _LOGGER_CHANNEL0(typeChannel);
+	const unsigned int 	type = _LOGGER_TYPE(typeChannel);
+	size_t				i;
+
+	lock();
+	for(i=1; i<=LOGGER_TYPES; i++) {
+		if ( type == 0 || type == i )  {
+			if ( ch != 0 )  {
+				LOGGER_BITMAP_AND(&m_arType[i].arRecord[ch/8], (uint8_t)~(1U << (ch&7)));
+			}
+			else {
+				for(auto& bitmap : m_arType[i].arRecord)  {
+					LOGGER_BITMAP_SET(&bitmap, (uint8_t)0);
+				}
+			}
+		}
+	}
+	unlock();
+}
+
+#if !LOGGER_SINGLE_THREAD
+
+/*
+ * Put a formatted message to the asynchronous queue
+ *
+ * 		strBuffer			message to write
+ * 		nLength				message length, bytes
+ *
+ * Return: true if the message has been queued, false if the queue is full
+ *
+ * Note: lock-free, multiple writers
+ */
+boolean_t CLogger::pushRecord(const char* strBuffer, size_t nLength)
+{
+	logger_record_t*	pRecord;
+	size_t				pos, seq;
+	ssize_t				diff;
+
+	pos = __atomic_load_n(&m_nHead, __ATOMIC_RELAXED);
+	for(;;)  {
+		pRecord = &m_arRecord[pos&(LOGGER_ASYNC_QUEUE_MAX-1)];
+		seq = __atomic_load_n(&pRecord->seq, __ATOMIC_ACQUIRE);
+		diff = (ssize_t)(seq - pos);
+
+		if ( diff == 0 )  {
+			/* Slot is free, take it */
+			if ( __atomic_compare_exchange_n(&m_nHead, &pos, pos+1, true,
+											 __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+			{
+				break;
+			}
+		}
+		else if ( diff < 0 )  {
+			/* Queue is full */
+			__atomic_fetch_add(&m_nDrop, 1, __ATOMIC_RELAXED);
+			return false;
+		}
+		else {
+			pos = __atomic_load_n(&m_nHead, __ATOMIC_RELAXED);
+		}
+	}
+
+	UNALIGNED_MEMCPY(pRecord->strBuffer, strBuffer, nLength);
+	pRecord->length = nLength;
+	__atomic_store_n(&pRecord->seq, pos+1, __ATOMIC_RELEASE);
+
+	/* The logger thread checks the queue after setting the flag */
+	__sync_synchronize();
+	if ( __atomic_load_n(&m_nAsyncWaiting, __ATOMIC_RELAXED) != 0 )  {
+		pthread_mutex_lock(&m_lockAsync);
+		pthread_cond_signal(&m_condAsync);
+		pthread_mutex_unlock(&m_lockAsync);
+	}
+
+	return true;
+}
+
+/*
+ * Write a batch of the queued messages to the all appenders
+ *
+ * Return: written messages count
+ *
+ * Note: single reader, the logger thread or a stopping thread
+ */
+size_t CLogger::writeRecords()
+{
+	struct iovec		arIov[LOGGER_ASYNC_BATCH_MAX+1];
+	char				strDrop[128];
+	logger_record_t*	pRecord;
+	size_t				count, nIov, i;
+	uint32_t			nDrop;
+
+	count = 0;
+	while ( count < LOGGER_ASYNC_BATCH_MAX )  {
+		pRecord = &m_arRecord[(m_nTail+count)&(LOGGER_ASYNC_QUEUE_MAX-1)];
+		if ( __atomic_load_n(&pRecord->seq, __ATOMIC_ACQUIRE) != m_nTail+count+1 )  {
+			break;
+		}
+
+		arIov[count].iov_base = pRecord->strBuffer;
+		arIov[count].iov_len = pRecord->length;
+		count++;
+	}
+
+	nIov = count;
+	nDrop = __atomic_load_n(&m_nDrop, __ATOMIC_RELAXED);
+	if ( nDrop != m_nDropReported )  {
+		arIov[nIov].iov_base = strDrop;
+		arIov[nIov].iov_len = (size_t)_tsnprintf(strDrop, sizeof(strDrop),
+							"[shell_logger] async queue overflow, %u message(s) dropped\n",
+							nDrop-m_nDropReported);
+		arIov[nIov].iov_len = sh_min(arIov[nIov].iov_len, sizeof(strDrop)-1);
+		nIov++;
+		m_nDropReported = nDrop;
+	}
+
+	if ( nIov > 0 )  {
+		lock();
+		for(auto& pAppender : m_arAppender)  {
+			if ( pAppender != nullptr ) {
+				pAppender->appendv(arIov, nIov);
+			}
+			else {
+				break;
+			}
+		}
+		unlock();
+	}
+
+	/* Release the slots to the writers */
+	for(i=0; i<count; i++)  {
+		pRecord = &m_arRecord[(m_nTail+i)&(LOGGER_ASYNC_QUEUE_MAX-1)];
+		__atomic_store_n(&pRecord->seq, m_nTail+i+LOGGER_ASYNC_QUEUE_MAX, __ATOMIC_RELEASE);
+	}
+	m_nTail += count;
+
+	return count;
+}
+
+/*
+ * Logger thread, write the queued messages until stopped
+ */
+void* CLogger::asyncThread()
+{
+	logger_record_t*	pRecord;
+	sigset_t			sigset;
+
+	/* Signals are delivered to the application threads */
+	sigfillset(&sigset);
+	pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+
+	while ( !m_bAsyncStop )  {
+		if ( writeRecords() > 0 )  {
+			continue;
+		}
+
+		pthread_mutex_lock(&m_lockAsync);
+		__atomic_store_n(&m_nAsyncWaiting, 1, __ATOMIC_RELAXED);
+		__sync_synchronize();
+
+		pRecord = &m_arRecord[m_nTail&(LOGGER_ASYNC_QUEUE_MAX-1)];
+		if ( !m_bAsyncStop && __atomic_load_n(&pRecord->seq, __ATOMIC_ACQUIRE) != m_nTail+1 )  {
+			pthread_cond_wait(&m_condAsync, &m_lockAsync);
+		}
+
+		__atomic_store_n(&m_nAsyncWaiting, 0, __ATOMIC_RELAXED);
+		pthread_mutex_unlock(&m_lockAsync);
+	}
+
+	while ( writeRecords() > 0 ) ;
+
+	return nullptr;
+}
+
+#endif /* !LOGGER_SINGLE_THREAD */
+
 /*******************************************************************************
  * Static helper functions
  */
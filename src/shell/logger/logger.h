@@ -25,6 +25,15 @@
  *
  *  Revision 2.1, 25.12.2019 19:17:47
  *  	Added LT_TRACE log type support.
+ *
+ *  Revision 2.2, 18.10.2026 06:02:15
+ *  	Lock-free enable checks, asynchronous mode.
+ *
+ *  Revision 2.3, 18.10.2026 08:14:52
+ *  	Binary flight recorder of the selected log types/channels.
+ *
+ *  Revision 2.4, 18.10.2026 11:53:06
+ *  	In-flight asynchronous writers count.
  */
 
 #ifndef __SHELL_LOGGER_H_INCLUDED__
@@ -96,10 +105,26 @@
 #define LOGGER_FORMAT_MAX		128
 #define LOGGER_BUFFER_MAX		CARBON_LOGGER_BUFFER_LENGTH
 
+#define LOGGER_ASYNC_QUEUE_MAX	4096		/* Async mode queued records, power of 2 */
+#define LOGGER_ASYNC_BATCH_MAX	64			/* Async mode records per appender write */
+
 class CAppender;
+class CFlightRecorder;
 
 /*
  * Logger base class
+ *
+ * The log type/channel enable checks are lock-free, a message is formatted
+ * in the caller's stack buffer. In synchronous mode (default) the message is
+ * written to the appenders by the caller under the logger lock.
+ *
+ * In asynchronous mode the message is copied to a bounded lock-free queue
+ * and written by the logger thread, a batch of messages per appender call.
+ * If the queue is full the message is dropped and counted, the number of
+ * dropped messages is written to the log by the logger thread.
+ *
+ * The selected log types/channels may be recorded in the binary form to the
+ * flight recorder (see flight_recorder.h) independently of the text output.
  */
 class CLogger
 {
@@ -107,6 +132,7 @@ class CLogger
 		struct logger_type_t {
 			char			strType[LOGGER_TYPES+1];			/* '', 'DBG', ... 'TRC' */
 			uint8_t			arChannel[LOGGER_CHANNEL_MAX/8];	/* Channel enabled bitmap */
+			uint8_t			arRecord[LOGGER_CHANNEL_MAX/8];		/* Channel recorded bitmap */
 			char			strFormat[LOGGER_FORMAT_MAX];		/* Logger line format */
 			char			strFormatTime[LOGGER_FORMAT_MAX];	/* Logger timestamp format */
 		};
@@ -114,9 +140,31 @@ class CLogger
 	protected:
 		CAppender*					m_arAppender[LOGGER_APPENDER_MAX];
 		logger_type_t				m_arType[LOGGER_TYPES+1];
+		CFlightRecorder*			m_pRecorder;		/* Binary recorder (created on first use) */
+		volatile boolean_t			m_bRecord;			/* TRUE: recorder is running */
 
 #if !LOGGER_SINGLE_THREAD
 		mutable pthread_mutex_t		m_lock;
+
+		/* Asynchronous mode */
+		struct logger_record_t {
+			size_t			seq;								/* Queue slot sequence */
+			size_t			length;								/* Message length, bytes */
+			char			strBuffer[LOGGER_BUFFER_MAX];		/* Formatted message */
+		};
+
+		logger_record_t*			m_arRecord;			/* Records queue (allocated on first use) */
+		size_t						m_nHead;			/* Next record to fill, atomic */
+		size_t						m_nTail;			/* Next record to write, logger thread only */
+		uint32_t					m_nDrop;			/* Dropped records, atomic */
+		uint32_t					m_nDropReported;	/* Dropped records written to log */
+		volatile boolean_t			m_bAsync;			/* TRUE: asynchronous mode */
+		volatile boolean_t			m_bAsyncStop;		/* TRUE: logger thread is stopping */
+		int							m_nAsyncWaiting;	/* Logger thread sleeps, atomic */
+		int							m_nAsyncWriters;	/* Writers pushing a record, atomic */
+		pthread_t					m_thAsync;			/* Logger thread */
+		pthread_mutex_t				m_lockAsync;		/* Logger thread sleeping lock */
+		pthread_cond_t				m_condAsync;
 #endif /* !LOGGER_SINGLE_THREAD */
 
 	public:
@@ -137,12 +185,25 @@ class CLogger
 		}
 
 		boolean_t isEnabledChannel(const logger_type_t* pLogger, unsigned int ch) const;
+		boolean_t isRecordChannel(const logger_type_t* pLogger, unsigned int ch) const;
+		void setRecorderFormat(unsigned int type);
 		size_t doFormat(const logger_type_t* pLogger, const char* strLoggerFormat,
 					 	const char* strMessage, const char* strFilename, int nLine,
 					 	const char* strFunction, char* strBuffer, size_t nBufferLength,
 					 	va_list args) const;
 		size_t doFormatHex(const logger_type_t* pLogger, const void* pData, int nLength,
 						char* strBuffer, size_t nBufferLength) const;
+		void doAppend(const char* strBuffer, size_t nLength);
+
+#if !LOGGER_SINGLE_THREAD
+		boolean_t pushRecord(const char* strBuffer, size_t nLength);
+		size_t writeRecords();
+
+		static void* asyncThreadST(void* p) {
+			return static_cast<CLogger*>(p)->asyncThread();
+		}
+		void* asyncThread();
+#endif /* !LOGGER_SINGLE_THREAD */
 
 	public:
 		/*
@@ -166,6 +227,17 @@ class CLogger
 		result_t getEnableData(unsigned int type, void* pBuffer, size_t nLength);
 		result_t insertAppender(CAppender* pAppender);
 
+		result_t setAsync(boolean_t bAsync);
+		boolean_t isAsync() const;
+		uint32_t getDropCount() const;
+
+		result_t startRecorder(const char* strFilename, size_t nRingSize = 0, size_t nThreadMax = 0);
+		void stopRecorder();
+		result_t dumpRecorder(const char* strFilename = nullptr);
+		void flushRecorder();
+		void enableRecord(unsigned int typeChannel);
+		void disableRecord(unsigned int typeChannel);
+
 	public:
 		/*
 		 * Static helper functions
@@ -10,6 +10,12 @@
  *
  *  Revision 1.0, 21.01.2021 19:51:45
  *      Initial revision.
+ *
+ *  Revision 1.1, 18.10.2026 06:02:15
+ *  	Added asynchronous mode macros.
+ *
+ *  Revision 1.2, 18.10.2026 08:14:52
+ *  	Added flight recorder macros.
  */
 
 #ifndef __SHELL_LOGGER_COMPAT_H_INCLUDED__
@@ -129,4 +135,14 @@
 #define logger_disable(__typeChannel)		g_logger.disable(__typeChannel)
 #define logger_is_enabled(__typeChannel)	g_logger.isEnabled(__typeChannel)
 
+#define logger_set_async(__bAsync)			g_logger.setAsync(__bAsync)
+#define logger_get_drop_count()				g_logger.getDropCount()
+
+#define logger_recorder_start(__strFilename)	g_logger.startRecorder(__strFilename)
+#define logger_recorder_stop()					g_logger.stopRecorder()
+#define logger_recorder_dump()					g_logger.dumpRecorder()
+#define logger_recorder_flush()					g_logger.flushRecorder()
+#define logger_record_enable(__typeChannel)		g_logger.enableRecord(__typeChannel)
+#define logger_record_disable(__typeChannel)	g_logger.disableRecord(__typeChannel)
+
 #endif /* __SHELL_LOGGER_COMPAT_H_INCLUDED__ */
@@ -25,6 +25,14 @@
  *	Revision 2.1, 07.03.2018 17:17:42
  *		Enabled and reordered option 'reuse port' in CSocket::open().
  *		(Inserted before bind())
+ *
+ *	Revision 2.2, 17.10.2026 17:52:31
+ *		CSocketAsync::receiveLineAsync() reads into the read-ahead buffer
+ *		instead of the single byte recv(), the rest of the data is returned
+ *		by the following receiveAsync()/receiveLineAsync().
+ *
+ *	Revision 2.3, 17.10.2026 18:40:12
+ *		Added scatter/gather CSocketAsync::sendvAsync() and CSocket::sendv().
  */
 /*
  * End of line:
@@ -47,6 +55,7 @@
 #include <sys/socket.h>
 
 #include "shell/shell.h"
+#include "shell/memory.h"
 #include "shell/logger.h"
 #include "shell/utils.h"
 #include "shell/socket.h"
@@ -479,9 +488,66 @@ result_t CSocketAsync::close()
 		m_hSocket = -1;
 	}
 
+	if ( m_pReadAhead != NULL )  {
+		memFree(m_pReadAhead);
+		m_pReadAhead = NULL;
+	}
+	m_nReadHead = m_nReadTail = 0;
+
 	return nresult;
 }
 
+/*
+ * Return buffered data left by the receiveLineAsync()
+ *
+ * 		pBuffer			output buffer
+ * 		size			maximum bytes to return
+ *
+ * Return: returned byte count
+ */
+size_t CSocketAsync::getReadAheadData(void* pBuffer, size_t size)
+{
+	size_t		length;
+
+	length = sh_min(m_nReadTail-m_nReadHead, size);
+	if ( length > 0 )  {
+		_tmemcpy(pBuffer, m_pReadAhead+m_nReadHead, length);
+		m_nReadHead += length;
+	}
+
+	return length;
+}
+
+/*
+ * Make a destination socket address for the non connection-mode sockets
+ *
+ * 		destAddr		destination address
+ * 		pSockAddr		socket address [out]
+ *
+ * Return: ESUCCESS, ...
+ */
+result_t CSocketAsync::getDestAddr(const CNetAddr& destAddr, struct sockaddr_in* pSockAddr) const
+{
+	int 		retVal, domain;
+	socklen_t	dlen;
+	result_t	nresult;
+
+	dlen = sizeof(domain);
+	retVal = ::getsockopt(m_hSocket, SOL_SOCKET, SO_DOMAIN, &domain, &dlen);
+	if ( retVal != 0 ) {
+		nresult = errno;
+		log_debug(L_SOCKET, "[socket] failed to get socket protocol, result: %d\n", nresult);
+		return nresult;
+	}
+
+	_tbzero(pSockAddr, sizeof(*pSockAddr));
+	pSockAddr->sin_family = (sa_family_t)domain;
+	pSockAddr->sin_addr.s_addr = destAddr;
+	pSockAddr->sin_port = htons((ip_port_t)destAddr);
+
+	return ESUCCESS;
+}
+
 /*
  * Send up to specified bytes asynchronous
  *
@@ -513,24 +579,12 @@ result_t CSocketAsync::sendAsync(const void* pBuffer, size_t* pSize, const CNetA
 	}
 
 	if ( destAddr.isValid() )  {
-		int 		retVal;
-		sa_family_t	domain;
-		socklen_t	dlen;
-
-		dlen = sizeof(domain);
-		retVal = ::getsockopt(m_hSocket, SOL_SOCKET, SO_DOMAIN, &domain, &dlen);
-		if ( retVal != 0 ) {
-			nresult = errno;
-			log_debug(L_SOCKET, "[socket] failed to get socket protocol, result: %d\n", nresult);
+		nresult = getDestAddr(destAddr, &sockaddr);
+		if ( nresult != ESUCCESS )  {
 			*pSize = 0;
 			return nresult;
 		}
 
-		_tbzero_object(sockaddr);
-		sockaddr.sin_family = domain;
-		sockaddr.sin_addr.s_addr = destAddr;
-		sockaddr.sin_port = htons((ip_port_t)destAddr);
-
 		psockaddr = (struct sockaddr*)&sockaddr;
 		sockaddrlen = sizeof(sockaddr);
 	}
@@ -565,6 +619,100 @@ result_t CSocketAsync::sendAsync(const void* pBuffer, size_t* pSize, const CNetA
 	return nresult;
 }
 
+/*
+ * Send a fragmented data asynchronous (scatter/gather)
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		pOffset			IN: already sent bytes of the whole data (0 - start sending),
+ * 						OUT: sent bytes
+ *		destAddr		destination address (for non connection-mode sockets) (optional)
+ *
+ * Return:
+ * 		ESUCCESS		all data sent
+ * 		EAGAIN			some data sent, repeat with the updated offset
+ * 		EBADF			socket is not connected
+ * 		ECONNRESET		can't send data
+ * 		EINTR			interrupted by signal
+ * 		...
+ */
+result_t CSocketAsync::sendvAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset,
+								  const CNetAddr& destAddr)
+{
+	struct iovec		arIov[SOCKET_IOV_MAX];
+	struct msghdr		msg;
+	struct sockaddr_in	sockaddr;
+	size_t				index, offset, length, n;
+	ssize_t				len;
+	result_t			nresult;
+
+	if ( !isOpen() )  {
+		return EBADF;
+	}
+
+	_tbzero_object(msg);
+	if ( destAddr.isValid() )  {
+		nresult = getDestAddr(destAddr, &sockaddr);
+		if ( nresult != ESUCCESS )  {
+			return nresult;
+		}
+
+		msg.msg_name = &sockaddr;
+		msg.msg_namelen = sizeof(sockaddr);
+	}
+
+	/* Skip sent fragments */
+	index = 0;
+	offset = *pOffset;
+	while ( index < nVec && offset >= arVec[index].iov_len )  {
+		offset -= arVec[index].iov_len;
+		index++;
+	}
+
+	nresult = ESUCCESS;
+
+	while ( index < nVec )  {
+		length = 0;
+		for(n=0; n<SOCKET_IOV_MAX && (index+n)<nVec; n++)  {
+			arIov[n] = arVec[index+n];
+			length += arIov[n].iov_len;
+		}
+
+		/* First fragment may be sent partially */
+		arIov[0].iov_base = (uint8_t*)arIov[0].iov_base + offset;
+		arIov[0].iov_len -= offset;
+		length -= offset;
+
+		msg.msg_iov = arIov;
+		msg.msg_iovlen = n;
+
+		len = ::sendmsg(m_hSocket, &msg, MSG_NOSIGNAL);
+		if ( len < 0 )  {
+			nresult = errno;
+			if ( errno != EAGAIN )  {
+				log_debug(L_SOCKET, "[socket] send %d bytes failed, result: %s(%d)\n",
+						  length, strerror(nresult), nresult);
+			}
+			break;
+		}
+
+		if ( len == 0 )  {
+			log_debug(L_SOCKET, "[socket] send %d bytes returns ZERO, set ECONNRESET error\n", length);
+			nresult = ECONNRESET;
+			break;
+		}
+
+		*pOffset += len;
+		offset += len;
+		while ( index < nVec && offset >= arVec[index].iov_len )  {
+			offset -= arVec[index].iov_len;
+			index++;
+		}
+	}
+
+	return nresult;
+}
+
 /*
  * Receive up to specified bytes asynchronous
  *
@@ -598,7 +746,7 @@ result_t CSocketAsync::receiveAsync(void* pBuffer, size_t* pSize, CNetAddr* pSrc
 	}
 
 	size = *pSize;
-	length = 0;
+	length = getReadAheadData(p, size);
 	_tbzero_object(sockaddr);
 	nresult = ESUCCESS;
 
@@ -658,14 +806,19 @@ result_t CSocketAsync::receiveAsync(void* pBuffer, size_t* pSize, CNetAddr* pSrc
  * 		EBADF			socket is not connected
  * 		ECONNRESET		connection closed by remote peer
  * 		EINTR			interrupted by signal
+ * 		ENOMEM			failed to allocate read-ahead buffer
  * 		...
+ *
+ * Note: the data after the eol is kept in the read-ahead buffer
+ * and returned by the following receiveAsync()/receiveLineAsync() calls.
  */
 result_t CSocketAsync::receiveLineAsync(void* pBuffer, size_t nPreSize, size_t* pSize,
 								   const char* strEol)
 {
-	size_t				size, length, lenEol;
+	size_t				size, length, lenEol, n;
 	ssize_t				len;
 	char*				p = (char*)pBuffer + nPreSize;
+	const uint8_t		*pData, *pEol;
 	result_t			nresult;
 
 	if ( !isOpen() )  {
@@ -674,6 +827,17 @@ result_t CSocketAsync::receiveLineAsync(void* pBuffer, size_t nPreSize, size_t*
 	}
 
 	lenEol = _tstrlen(strEol);
+	shell_assert(lenEol > 0);
+
+	if ( m_pReadAhead == NULL )  {
+		m_pReadAhead = (uint8_t*)memAlloc(SOCKET_READAHEAD_SIZE);
+		if ( m_pReadAhead == NULL )  {
+			log_error(L_SOCKET, "[socket] failed to allocate read-ahead buffer\n");
+			*pSize = 0;
+			return ENOMEM;
+		}
+	}
+
 	size = *pSize;
 	length = 0;
 	nresult = ESUCCESS;
@@ -681,30 +845,48 @@ result_t CSocketAsync::receiveLineAsync(void* pBuffer, size_t nPreSize, size_t*
 	log_trace(L_SOCKET, "[socket] receiving, presize %d, size %d\n", nPreSize, *pSize);
 
 	while ( length < size )  {
-		len = ::recv(m_hSocket, p+length, 1, MSG_NOSIGNAL);
+		if ( m_nReadHead == m_nReadTail )  {
+			/* Buffer is empty, receive as much as available */
+			len = ::recv(m_hSocket, m_pReadAhead, SOCKET_READAHEAD_SIZE, MSG_NOSIGNAL);
+
+			if ( len < 0 )  {
+				nresult = errno;
+				if ( nresult != EAGAIN )  {
+					/* Read error */
+					log_debug(L_SOCKET, "[socket] receive failed, result: %d\n", nresult);
+				}
+				break;
+			}
 
-		if ( len < 0 )  {
-			nresult = errno;
-			if ( nresult != EAGAIN )  {
-				/* Read error */
-				log_debug(L_SOCKET, "[socket] receive failed, result: %d\n", nresult);
+			if ( len == 0 )  {
+				/* Server closes the socket */
+				log_trace(L_SOCKET, "[socket] connection closed by peer\n");
+				nresult = ECONNRESET;
+				break;
 			}
-			break;
+
+			m_nReadHead = 0;
+			m_nReadTail = (size_t)len;
 		}
 
-		if ( len == 0 )  {
-			/* Server closes the socket */
-			log_trace(L_SOCKET, "[socket] connection closed by peer\n");
-			nresult = ECONNRESET;
-			break;
+		/*
+		 * Copy up to the next occurrence of the last eol character,
+		 * the rest of the buffer is left for the following calls
+		 */
+		pData = m_pReadAhead+m_nReadHead;
+		n = sh_min(m_nReadTail-m_nReadHead, size-length);
+		pEol = (const uint8_t*)_tmemchr(pData, strEol[lenEol-1], n);
+		if ( pEol != NULL )  {
+			n = (size_t)(pEol-pData)+1;
 		}
 
-		/*log_debug(L_SOCKET_FL, "[socket] received a byte '%c'\n", *(p+length));*/
+		_tmemcpy(p+length, pData, n);
+		m_nReadHead += n;
+		length += n;
 
-		length += len;
-		if ( (length+nPreSize) >= lenEol )  {
+		if ( pEol != NULL && (length+nPreSize) >= lenEol )  {
 			/* Check for eol */
-			if ( _tmemcmp((char*)pBuffer+nPreSize+length-lenEol, strEol, lenEol) == 0 )  {
+			if ( _tmemcmp(p+length-lenEol, strEol, lenEol) == 0 )  {
 				log_trace(L_SOCKET, "[socket] detected EOL\n");
 				break;	/* Done */
 			}
@@ -751,6 +933,14 @@ result_t CSocket::select(hr_time_t hrTimeout, int options, short* prevents)
 		return EINVAL;
 	}
 
+	if ( (options&CSocket::pollRead) != 0 && getReadAhead() > 0 )  {
+		/* Data is already buffered by the receiveLineAsync() */
+		if ( prevents )  {
+			*prevents = POLLIN;
+		}
+		return ESUCCESS;
+	}
+
     nresult = ETIMEDOUT;
     hrStart = hr_time_now();
 
@@ -964,6 +1154,47 @@ result_t CSocket::send(const void* pBuffer, size_t* pSize, hr_time_t hrTimeout,
 	return nresult;
 }
 
+/*
+ * Send a fragmented data (scatter/gather)
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		hrTimeout		maximum send time
+ *		destAddr		destination address (for non connection-mode sockets) (optional)
+ *
+ * Return: ESUCCESS, ETIMEDOUT, ECANCELED, ...
+ */
+result_t CSocket::sendv(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout,
+						const CNetAddr& destAddr)
+{
+	size_t			size, offset, i;
+	result_t		nresult;
+	hr_time_t		hrStart;
+	short			revents;
+
+	if ( !isOpen() )  {
+		return EBADF;
+	}
+
+	size = 0;
+	for(i=0; i<nVec; i++)  {
+		size += arVec[i].iov_len;
+	}
+
+	offset = 0;
+	hrStart = hr_time_now();
+	nresult = size ? EAGAIN : ESUCCESS;
+
+	while ( offset < size && nresult == EAGAIN )  {
+		nresult = select(hr_timeout(hrStart, hrTimeout), pollWrite, &revents);
+		if ( nresult == ESUCCESS )  {
+			nresult = sendvAsync(arVec, nVec, &offset, destAddr);
+		}
+	}
+
+	return nresult;
+}
+
 result_t CSocket::receive(void* pBuffer, size_t* pSize, int options,
 						  hr_time_t hrTimeout, CNetAddr* pSrcAddr)
 {
@@ -19,12 +19,19 @@
  *  	Renamed CSocketAsync: connect() => connectAsync(),
  *  	send() => sendAsync(), receive() => receiveAsync().
  *
+ *  Revision 1.3, 17.10.2026 17:48:10
+ *  	Added CSocketAsync read-ahead buffer for receiveLineAsync().
+ *
+ *  Revision 1.4, 17.10.2026 18:36:40
+ *  	Added scatter/gather sendvAsync() and sendv().
+ *
  */
 
 #ifndef __SHELL_SOCKET_H_INCLUDED__
 #define __SHELL_SOCKET_H_INCLUDED__
 
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 #include "shell/config.h"
 #include "shell/hr_time.h"
@@ -38,6 +45,9 @@
 
 #define INPORT_ANY			0
 
+#define SOCKET_READAHEAD_SIZE	4096		/* Line receive read-ahead buffer size */
+#define SOCKET_IOV_MAX			64			/* Maximum fragments per sendmsg() call */
+
 typedef enum {
 	SOCKET_TYPE_STREAM = SOCK_STREAM,
 	SOCKET_TYPE_UDP = SOCK_DGRAM,
@@ -57,14 +67,29 @@ class CSocketAsync
 		int				m_hSocket;				/* Socket file descriptor */
 		int				m_exOption;				/* Socket creation flags, see CSocket */
 
+		uint8_t*		m_pReadAhead;			/* Line receive read-ahead buffer (allocated on demand) */
+		size_t			m_nReadHead;			/* First unread byte offset */
+		size_t			m_nReadTail;			/* Read-ahead data end offset */
+
 	public:
-		explicit CSocketAsync(int exOption = 0) : m_hSocket(-1), m_exOption(exOption) {}
+		explicit CSocketAsync(int exOption = 0) :
+			m_hSocket(-1),
+			m_exOption(exOption),
+			m_pReadAhead(NULL),
+			m_nReadHead(0),
+			m_nReadTail(0)
+		{
+		}
+
 		virtual ~CSocketAsync() { close(); }
 
 	public:
 		int getHandle() const { return m_hSocket; }
 		boolean_t isOpen() const { return m_hSocket != -1; }
 
+		/* Bytes received from the socket but not yet returned to the caller */
+		size_t getReadAhead() const { return m_nReadTail-m_nReadHead; }
+
 		virtual result_t open(const CNetAddr& bindAddr = NETADDR_NULL,
 							  	socket_type_t sockType = SOCKET_TYPE_STREAM);
 		virtual result_t open(const char* strBindSocket = NULL,
@@ -87,6 +112,8 @@ class CSocketAsync
 
 		virtual result_t sendAsync(const void* pBuffer, size_t* pSize,
 								const CNetAddr& destAddr = NETADDR_NULL);
+		virtual result_t sendvAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset,
+								const CNetAddr& destAddr = NETADDR_NULL);
 		virtual result_t receiveAsync(void* pBuffer, size_t* pSize, CNetAddr* pSrcAddr = NULL);
 		virtual result_t receiveLineAsync(void* pBuffer, size_t nPreSize, size_t* pSize,
 								const char* strEol);
@@ -110,6 +137,8 @@ class CSocketAsync
 	protected:
 		result_t setOption(int fd, int option, int value);
 		void setHandle(int fd) { close(); m_hSocket = fd; }
+		size_t getReadAheadData(void* pBuffer, size_t size);
+		result_t getDestAddr(const CNetAddr& destAddr, struct sockaddr_in* pSockAddr) const;
 };
 
 /*
@@ -157,6 +186,8 @@ class CSocket : public CSocketAsync
 							  	const CNetAddr& destAddr = NETADDR_NULL)  {
 			return send(pBuffer, &size, hrTimeout, destAddr);
 		}
+		virtual result_t sendv(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout,
+								const CNetAddr& destAddr = NETADDR_NULL);
 
 		virtual result_t receive(void* pBuffer, size_t* pSize, int options,
 								hr_time_t hrTimeout, CNetAddr* pSrcAddr = NULL);
@@ -11,6 +11,9 @@
  *  Revision 1.0, 22.12.2021 19:51:20
  *      Initial revision.
  *
+ *  Revision 1.1, 17.10.2026 18:46:14
+ *      Added sendvAsync() and sendv().
+ *
  */
 
 #include <poll.h>
@@ -468,6 +471,56 @@ result_t CSslSocketAsync::sendAsync(const void* pBuffer, size_t* pSize, const CN
 	return nresult;
 }
 
+/*
+ * [Public API function]
+ *
+ * Send a fragmented data asynchronous
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		pOffset			IN: already sent bytes of the whole data (0 - start sending),
+ * 						OUT: sent bytes
+ * 		destAddr		must be NETADDR_NULL
+ *
+ * Return:
+ * 		ESUCCESS		all data sent
+ * 		EAGAIN			some data sent, repeat with the updated offset
+ * 		...
+ *
+ * Note: each fragment is written by a separate SSL_write() call.
+ */
+result_t CSslSocketAsync::sendvAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset,
+									 const CNetAddr& destAddr)
+{
+	size_t			index, offset, size;
+	result_t		nresult;
+
+	shell_assert(!destAddr.isValid());
+
+	index = 0;
+	offset = *pOffset;
+	while ( index < nVec && offset >= arVec[index].iov_len )  {
+		offset -= arVec[index].iov_len;
+		index++;
+	}
+
+	nresult = ESUCCESS;
+
+	while ( index < nVec )  {
+		size = arVec[index].iov_len - offset;
+		nresult = CSslSocketAsync::sendAsync((const uint8_t*)arVec[index].iov_base + offset, &size);
+		if ( nresult != ESUCCESS )  {
+			break;
+		}
+
+		*pOffset += size;
+		offset = 0;
+		index++;
+	}
+
+	return nresult;
+}
+
 /*
  * [Public API function]
  *
@@ -750,6 +803,59 @@ result_t CSslSocket::send(const void* pBuffer, size_t* pSize, hr_time_t hrTimeou
 	return nresult;
 }
 
+/*
+ * [Public API function]
+ *
+ * Send a fragmented data
+ *
+ * 		arVec			data fragments
+ * 		nVec			fragment count
+ * 		hrTimeout		maximum send time
+ * 		destAddr		must be NETADDR_NULL
+ *
+ * Return: ESUCCESS, ETIMEDOUT, ECANCELED, ...
+ */
+result_t CSslSocket::sendv(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout,
+						   const CNetAddr& destAddr)
+{
+	size_t			offset;
+	hr_time_t		hrStart, hrElapsed, hrTimeout1;
+	short			revents;
+	result_t		nresult;
+
+	shell_unused(destAddr);
+
+	offset = 0;
+	nresult = ETIMEDOUT;
+	hrStart = hr_time_now();
+
+	while ( (hrElapsed=hr_time_get_elapsed(hrStart)) < hrTimeout ) {
+		nresult = CSslSocketAsync::sendvAsync(arVec, nVec, &offset);
+		if ( nresult != EAGAIN )  {
+			break;
+		}
+
+		hrTimeout1 = hrTimeout-hrElapsed;
+
+		nresult = CSocket::select(hrTimeout1, pollRead|pollWrite, &revents);
+		if ( nresult != ESUCCESS ) {
+			break;
+		}
+
+		nresult = checkREvents(revents);
+		nresult = nresult == ECONNRESET ? ECONNREFUSED : nresult;
+		if ( nresult != ESUCCESS )  {
+			log_trace(L_SOCKET, "[socket_ssl] failed to send, revents 0x%x, result: %d\n",
+					  				revents, nresult);
+			break;
+		}
+
+		nresult = ETIMEDOUT;
+	}
+
+	return nresult;
+}
+
 /*
  * [Public API function]
  *
@@ -11,6 +11,9 @@
  *  Revision 1.0, 22.12.2021 19:46:40
  *      Initial revision.
  *
+ *  Revision 1.1, 17.10.2026 18:45:51
+ *      Added sendvAsync() and sendv().
+ *
  */
 
 #ifndef __SHELL_SSL_SOCKET_H_INCLUDED__
@@ -54,6 +57,8 @@ class CSslSocketAsync : public CSocket
 
 		virtual result_t sendAsync(const void* pBuffer, size_t* pSize,
 							   		const CNetAddr& destAddr = NETADDR_NULL);
+		virtual result_t sendvAsync(const struct iovec* arVec, size_t nVec, size_t* pOffset,
+									const CNetAddr& destAddr = NETADDR_NULL);
 
 		virtual result_t receiveAsync(void* pBuffer, size_t* pSize, CNetAddr* pSrcAddr = NULL);
 		virtual result_t receiveLineAsync(void* pBuffer, size_t nPreSize, size_t* pSize,
@@ -101,6 +106,8 @@ class CSslSocket : public CSslSocketAsync
 						  			const CNetAddr& destAddr = NETADDR_NULL)  {
 			return send(pBuffer, &size, hrTimeout, destAddr);
 		}
+		virtual result_t sendv(const struct iovec* arVec, size_t nVec, hr_time_t hrTimeout,
+						  			const CNetAddr& destAddr = NETADDR_NULL);
 
 		virtual result_t receive(void* pBuffer, size_t* pSize, int options,
 							 		hr_time_t hrTimeout, CNetAddr* pSrcAddr = NULL);
@@ -20,6 +20,10 @@
  *  Revision 1.3, 01.11.2016 16:31:15
  *      Use SIGTERM for thread termination.
  *
+ *  Revision 1.4, 17.10.2026 17:31:48
+ *      Detect the thread exit by pthread_tryjoin_np(), pthread_kill()
+ *      succeeds on the exited but not joined thread with the recent glibc.
+ *
  */
 
 #include <signal.h>
@@ -181,22 +185,29 @@ void CThread::stop()
             int     i, retVal;
             int     ms = (int)HR_TIME_TO_MILLISECONDS(m_hrStopTimeout);
             int     ms3 = ms < 3 ? 3 : (ms/3);
+            boolean_t   bJoined = FALSE;
 
             retVal = pthread_kill(m_id, SIGQUIT);
 
             for(i=0; i<ms3 && retVal == 0; i++)  {
+                if ( pthread_tryjoin_np(m_id, NULL) == 0 )  {
+                    bJoined = TRUE;
+                    break;
+                }
             	retVal = pthread_kill(m_id, SIGQUIT);
                 usleep(3000);
             }
 
-            if ( retVal != 0 )  {
-                pthread_join(m_id, NULL);
-            }
-            else  {
-            	log_debug(L_GEN, "[thread] %s: was not killed, cancel it\n", m_strName);
+            if ( !bJoined )  {
+                if ( retVal != 0 )  {
+                    pthread_join(m_id, NULL);
+                }
+                else  {
+                    log_debug(L_GEN, "[thread] %s: was not killed, cancel it\n", m_strName);
 
-                pthread_cancel(m_id);
-                pthread_join(m_id, NULL);
+                    pthread_cancel(m_id);
+                    pthread_join(m_id, NULL);
+                }
             }
         }
         else  {
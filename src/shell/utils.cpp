@@ -10,6 +10,12 @@
  *
  *  Revision 1.0, 20.05.2013 11:32:04
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 18:31:05
+ *      Added crc16_update().
+ *
+ *  Revision 1.2, 18.10.2026 09:02:37
+ *      Moved crc16() to crc16.cpp.
  */
 
 #include <stdio.h>
@@ -122,43 +128,6 @@ void lTrim(char* strSrc, const char* chars)
 }
 
 
-static uint16_t _crc16(uint16_t crc, uint8_t s)
-{
-    int i;
-
-    crc ^= s;
-
-    for (i = 0; i < 8; ++i) {
-        if (crc & 1)
-            crc = (crc >> 1) ^ 0xA001;
-        else
-            crc = (crc >> 1);
-    }
-
-    return crc;
-}
-
-/*
- * Calculate a 16-bit CRC
- *
- *      pData       data pointer
- *      nSize       data size, bytes
- *
- * Return: crc16
- */
-uint16_t crc16(const void* pData, size_t nSize)
-{
-    size_t          i;
-    uint16_t        res = 0xFFFF;
-    const uint8_t*  p = (const uint8_t*)pData;
-
-    for (i = 0; i < nSize; i++)  {
-        res = _crc16(res, p[i]);
-    }
-
-    return res;
-}
-
 /*
  * Parse version string "xx.yy.zz" from string representation
  *
@@ -10,6 +10,12 @@
  *
  *  Revision 1.0, 20.05.2013 11:33:12
  *      Initial revision.
+ *
+ *  Revision 1.1, 17.10.2026 18:31:22
+ *      Added crc16_update().
+ *
+ *  Revision 1.2, 18.10.2026 09:02:37
+ *      Added table-driven and PCLMULQDQ crc16 kernels, crc16_combine().
  */
 
 #ifndef __SHELL_UTILS_H_INCLUDED__
@@ -22,7 +28,26 @@
 extern result_t convertEncoding(const char* incode, const char* outcode,
 		 const char* inbuf, size_t insize, char* outbuf, size_t* poutsize);
 
+#define CRC16_INIT			0xFFFF
+
+typedef enum {
+	CRC16_BITWISE		= 0,
+	CRC16_SLICE8		= 1,
+	CRC16_SLICE16		= 2,
+	CRC16_CLMUL			= 3
+} crc16_isa_t;
+
 extern uint16_t crc16(const void* pData, size_t nSize);
+extern uint16_t crc16_update(uint16_t crc, const void* pData, size_t nSize);
+extern uint16_t crc16_combine(uint16_t crc1, uint16_t crc2, size_t nSize2);
+
+/*
+ * crc16 kernel selection, the best one is selected on the first call
+ */
+extern boolean_t crc16_set_isa(crc16_isa_t isa);
+extern crc16_isa_t crc16_get_isa();
+extern const char* crc16_isa_name(crc16_isa_t isa);
+
 extern void sleep_s(unsigned int nSecond);
 extern void sleep_ms(unsigned int nMillisecond);
 extern void sleep_us(unsigned int nMicrosecond);
@@ -32,6 +32,7 @@
 #   ---------------------------------------------------------------------
 #
 #   CARBON_MALLOC			e		-
+#   CARBON_SLAB_ALLOCATOR		e		-
 #   CARBON_UDNS				e		-
 #
 #   CARBON_OBJECT_NAME_LENGTH		48		16
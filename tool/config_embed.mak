@@ -10,6 +10,9 @@
 #   Revision 1.0, 15.02.2017 12:00:24
 #	Initial revision.
 #
+#   Revision 1.1, 17.10.2026 14:20:05
+#	Added CARBON_SLAB_ALLOCATOR option
+#
 #
 #   Input variables:
 #	CARBON_MACHINE="machine"
@@ -17,6 +20,7 @@
 #
 
 CARBON_MALLOC=0
+CARBON_SLAB_ALLOCATOR=0
 CARBON_UDNS=0
 
 ifndef CARBON_OBJECT_NAME_LENGTH
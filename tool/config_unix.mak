@@ -13,6 +13,9 @@
 #   Revision 1.1, 05.10.2021 16:32:57
 #	Added CARBON_DATE thparty module support
 #
+#   Revision 1.2, 17.10.2026 14:20:05
+#	Added CARBON_SLAB_ALLOCATOR option
+#
 #
 #   Input variables:
 #	CARBON_MACHINE="machine"
@@ -23,6 +26,10 @@ ifndef CARBON_MALLOC
 CARBON_MALLOC=0
 endif
 
+ifndef CARBON_SLAB_ALLOCATOR
+CARBON_SLAB_ALLOCATOR=1
+endif
+
 ifndef CARBON_UDNS
 CARBON_UDNS=1
 endif
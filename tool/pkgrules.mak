@@ -108,7 +108,7 @@ _LIBS += -lz
 endif
 
 ifeq ($(CARBON_DB),1)
-#_LIBS += -lsqlite3
+_LIBS += -lsqlite3
 endif
 
 ifeq ($(CARBON_DATE),1)